@@ -49,6 +49,8 @@ struct DeviceLimits {
     uint32_t maxUniformBufferRange;
     uint32_t maxStorageBufferRange;
     uint32_t maxPushConstantsSize;
+    uint32_t minUniformBufferOffsetAlignment;   // 常量缓冲区视图偏移/动态偏移的对齐要求
+    uint32_t minStorageBufferOffsetAlignment;   // 存储缓冲区视图偏移/动态偏移的对齐要求
     uint32_t maxMemoryAllocationCount;
     uint32_t maxSamplerAllocationCount;
     uint32_t maxBoundDescriptorSets;
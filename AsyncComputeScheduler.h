@@ -0,0 +1,386 @@
+#pragma once
+#include "CommandBuffer.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "FrameCommandAllocator.h"
+#include "Synchronization.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace RHI {
+
+// 图形与异步计算队列的重叠报告（最近一次Submit）
+// 按工作项的GPU耗时（estimatedGpuTimeNs）与实际生成的提交和等待关系模拟两个队列的执行时间线
+struct AsyncComputeReport {
+    uint64_t graphicsBusyNs = 0;       // 图形队列忙碌时间
+    uint64_t computeBusyNs = 0;        // 计算队列忙碌时间
+    uint64_t overlapNs = 0;            // 两个队列同时忙碌的时间
+    uint64_t frameNs = 0;              // 从第一个工作项开始到最后一个结束
+    uint64_t serialNs = 0;             // 所有工作项串行执行的时间
+    uint32_t submissionCount = 0;      // 队列提交次数（SubmitDesc数）
+    uint32_t submitCallCount = 0;      // SubmitBatch调用次数
+    uint32_t semaphoreWaitCount = 0;   // 跨队列信号量等待次数
+    uint32_t handoffCount = 0;         // 队列所有权转移次数
+
+    // 计算工作被图形工作隐藏的比例
+    double GetOverlapRatio() const {
+        return computeBusyNs > 0 ? static_cast<double>(overlapNs) / static_cast<double>(computeBusyNs) : 0.0;
+    }
+};
+
+// 异步计算调度器
+// 每帧Reset后按提交顺序添加已录制的工作项（标记为图形或计算队列）与它们之间的依赖，Submit时：
+// - 同一队列上相邻的工作项合并为一次提交，每次提交发出该队列时间线信号量的下一个值
+// - 工作项依赖另一个队列上的工作项时，从新的提交开始，等待生产者所在提交发出的值
+// - 资源在两个队列之间转移时，在生产者之后录制释放屏障、在消费者之前录制获取屏障（屏障命令缓冲区取自allocator）；
+//   两者在同一队列上时只在消费者之前录制一次普通转换
+// - 每个队列的全部提交通过一次SubmitBatch发出（时间线信号量允许等待尚未提交的值），并由allocator按最后的值回收
+// 设备没有独立的计算队列时（GetQueue返回同一个队列），所有工作项按顺序提交到该队列，不插入等待与所有权转移。
+// 依赖只能指向之前添加的工作项。每帧须先调用allocator.BeginFrame。
+class AsyncComputeScheduler {
+public:
+    AsyncComputeScheduler(IDevice* device, FrameCommandAllocator& allocator)
+        : m_device(device), m_allocator(allocator) {}
+
+    AsyncComputeScheduler(const AsyncComputeScheduler&) = delete;
+    AsyncComputeScheduler& operator=(const AsyncComputeScheduler&) = delete;
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_device != nullptr, ErrorCode::InvalidArgument, "异步计算调度器的设备不能为空");
+        auto graphics = m_device->GetQueue(QueueType::Graphics, 0);
+        RHI_RETURN_IF_FAILED(graphics);
+        auto compute = m_device->GetQueue(QueueType::Compute, 0);
+        RHI_RETURN_IF_FAILED(compute);
+        m_queues[kGraphics] = graphics.GetValue();
+        m_queues[kCompute] = compute.GetValue();
+
+        SemaphoreDesc semaphoreDesc;
+        semaphoreDesc.binary = false;
+        for (uint32_t q = 0; q < 2; ++q) {
+            auto semaphore = m_device->CreateSemaphore(semaphoreDesc);
+            RHI_RETURN_IF_FAILED(semaphore);
+            m_semaphores[q].reset(semaphore.GetValue());
+        }
+        return MakeSuccessResult();
+    }
+
+    // 是否有独立的计算队列（否则异步计算退化为在图形队列上顺序执行）
+    bool HasAsyncComputeQueue() const { return m_queues[kGraphics] != m_queues[kCompute]; }
+
+    // 队列的时间线信号量与最近一次提交发出的值（等待该值即等待此前提交到该队列的所有工作完成）
+    ISemaphore* GetTimeline(QueueType type) const { return m_semaphores[GetQueueIndex(type)].get(); }
+    uint64_t GetLastSignaledValue(QueueType type) const { return m_timelineValues[GetQueueIndex(type)]; }
+
+    // 开始新一帧的工作列表
+    void Reset() {
+        m_itemCount = 0;
+        m_handoffs.clear();
+        m_buildError = ErrorInfo{ErrorCode::Success, ""};
+    }
+
+    // 添加已录制完成的工作项，返回其索引
+    uint32_t AddWork(const char* name, QueueType queue, ICommandBuffer* commandBuffer, uint64_t estimatedGpuTimeNs = 0) {
+        if (queue != QueueType::Graphics && queue != QueueType::Compute) {
+            SetBuildError("工作项只能提交到图形或计算队列");
+        }
+        if (commandBuffer == nullptr) {
+            SetBuildError("工作项的命令缓冲区不能为空");
+        }
+        if (m_itemCount == m_items.size()) {
+            m_items.emplace_back();
+        }
+        WorkItem& item = m_items[m_itemCount];
+        item.name = name;
+        item.queue = queue == QueueType::Compute ? kCompute : kGraphics;
+        item.commandBuffer = commandBuffer;
+        item.gpuTimeNs = estimatedGpuTimeNs;
+        item.dependencies.clear();
+        return m_itemCount++;
+    }
+
+    // consumer在producer完成之后开始
+    void AddDependency(uint32_t consumer, uint32_t producer) {
+        if (consumer >= m_itemCount || producer >= consumer) {
+            SetBuildError("依赖只能指向之前添加的工作项");
+            return;
+        }
+        m_items[consumer].dependencies.push_back(producer);
+    }
+
+    // 资源从producer转移给consumer（同时建立依赖）；barrier描述资源与状态转换，队列字段由调度器填写，
+    // barrier.range指向的数据须在Submit之前保持有效
+    void AddHandoff(uint32_t producer, uint32_t consumer, const BarrierDesc& barrier) {
+        AddDependency(consumer, producer);
+        m_handoffs.push_back({producer, consumer, barrier});
+    }
+
+    Result<void> Submit() {
+        RHI_VALIDATE(m_queues[kGraphics] != nullptr, ErrorCode::InvalidOperation, "Submit必须在Initialize之后调用");
+        if (m_buildError.code != ErrorCode::Success) {
+            return Result<void>(m_buildError);
+        }
+        m_report = AsyncComputeReport();
+        m_batchOf.assign(m_itemCount, kNoBatch);
+        m_intervals[kGraphics].clear();
+        m_intervals[kCompute].clear();
+        m_open[kGraphics] = m_open[kCompute] = kNoBatch;
+        m_batchCount = 0;
+        m_cursorNs[kGraphics] = m_cursorNs[kCompute] = 0;
+        bool async = HasAsyncComputeQueue();
+
+        for (uint32_t i = 0; i < m_itemCount; ++i) {
+            const WorkItem& item = m_items[i];
+            uint32_t queue = async ? item.queue : kGraphics;
+            uint32_t other = 1 - queue;
+            uint32_t waitBatch = kNoBatch;     // 需要等待的另一个队列上最晚的批次
+            for (uint32_t producer : item.dependencies) {
+                uint32_t producerQueue = async ? m_items[producer].queue : kGraphics;
+                if (producerQueue == queue) {
+                    continue;
+                }
+                if (m_batchOf[producer] == m_open[other]) {
+                    CloseBatch(other);
+                }
+                if (waitBatch == kNoBatch || m_batchOf[producer] > waitBatch) {
+                    waitBatch = m_batchOf[producer];
+                }
+            }
+            if (waitBatch != kNoBatch && m_open[queue] != kNoBatch) {
+                CloseBatch(queue);
+            }
+            if (m_open[queue] == kNoBatch) {
+                OpenBatch(queue, waitBatch);
+            }
+
+            RHI_RETURN_IF_FAILED(RecordHandoffs(i, queue, false, async));
+            Batch& batch = m_batches[m_open[queue]];
+            batch.commandBuffers.push_back(item.commandBuffer);
+            batch.items.push_back(i);
+            m_batchOf[i] = m_open[queue];
+            if (async) {
+                RHI_RETURN_IF_FAILED(RecordHandoffs(i, queue, true, async));
+            }
+        }
+        for (uint32_t q = 0; q < 2; ++q) {
+            if (m_open[q] != kNoBatch) {
+                CloseBatch(q);
+            }
+        }
+        for (uint32_t q = 0; q < 2; ++q) {
+            RHI_RETURN_IF_FAILED(SubmitQueue(q));
+        }
+        ComputeOverlap();
+        return MakeSuccessResult();
+    }
+
+    const AsyncComputeReport& GetReport() const { return m_report; }
+
+private:
+    static constexpr uint32_t kGraphics = 0;
+    static constexpr uint32_t kCompute = 1;
+    static constexpr uint32_t kNoBatch = UINT32_MAX;
+
+    struct WorkItem {
+        const char* name;
+        uint32_t queue;
+        ICommandBuffer* commandBuffer;
+        uint64_t gpuTimeNs;
+        std::vector<uint32_t> dependencies;
+    };
+
+    struct Handoff {
+        uint32_t producer;
+        uint32_t consumer;
+        BarrierDesc barrier;
+    };
+
+    struct Batch {
+        uint32_t queue;
+        uint32_t waitBatch;                     // 开始前等待的另一个队列上的批次（kNoBatch表示不等待）
+        uint64_t signalValue;                   // 完成时发出的本队列时间线值
+        uint64_t endNs;                         // 模拟的完成时间
+        std::vector<ICommandBuffer*> commandBuffers;
+        std::vector<uint32_t> items;
+    };
+
+    struct Interval {
+        uint64_t begin;
+        uint64_t end;
+    };
+
+    static QueueType ToQueueType(uint32_t queue) {
+        return queue == kCompute ? QueueType::Compute : QueueType::Graphics;
+    }
+
+    uint32_t GetQueueIndex(QueueType type) const {
+        return type == QueueType::Compute && HasAsyncComputeQueue() ? kCompute : kGraphics;
+    }
+
+    void SetBuildError(const char* message) {
+        if (m_buildError.code == ErrorCode::Success) {
+            m_buildError = ErrorInfo{ErrorCode::InvalidArgument, message};
+        }
+    }
+
+    void OpenBatch(uint32_t queue, uint32_t waitBatch) {
+        if (m_batchCount == m_batches.size()) {
+            m_batches.emplace_back();
+        }
+        Batch& batch = m_batches[m_batchCount];
+        batch.queue = queue;
+        batch.waitBatch = waitBatch;
+        batch.commandBuffers.clear();
+        batch.items.clear();
+        m_open[queue] = m_batchCount++;
+    }
+
+    // 录制item的获取屏障（release为false）或释放屏障（release为true），合并为一个命令缓冲区加入当前批次
+    // 生产者与消费者在同一队列上时不转移所有权：只在消费者之前录制一次普通转换
+    Result<void> RecordHandoffs(uint32_t item, uint32_t queue, bool release, bool async) {
+        m_handoffBarriers.clear();
+        for (const Handoff& handoff : m_handoffs) {
+            if ((release ? handoff.producer : handoff.consumer) != item) {
+                continue;
+            }
+            QueueType srcQueue = async ? ToQueueType(m_items[handoff.producer].queue) : QueueType::Graphics;
+            QueueType dstQueue = async ? ToQueueType(m_items[handoff.consumer].queue) : QueueType::Graphics;
+            bool transfer = srcQueue != dstQueue;
+            if (release && !transfer) {
+                continue;
+            }
+            BarrierDesc barrier = handoff.barrier;
+            barrier.srcQueue = srcQueue;
+            barrier.dstQueue = dstQueue;
+            m_handoffBarriers.push_back(barrier);
+            m_report.handoffCount += !release && transfer ? 1 : 0;
+        }
+        if (m_handoffBarriers.empty()) {
+            return MakeSuccessResult();
+        }
+        auto commandBuffer = m_allocator.Allocate(ToQueueType(queue));
+        RHI_RETURN_IF_FAILED(commandBuffer);
+        RHI_RETURN_IF_FAILED(commandBuffer.GetValue()->Begin());
+        RHI_RETURN_IF_FAILED(commandBuffer.GetValue()->ResourceBarrier(
+            static_cast<uint32_t>(m_handoffBarriers.size()), m_handoffBarriers.data()));
+        RHI_RETURN_IF_FAILED(commandBuffer.GetValue()->End());
+        m_batches[m_open[queue]].commandBuffers.push_back(commandBuffer.GetValue());
+        return MakeSuccessResult();
+    }
+
+    // 结束批次：分配本队列的下一个时间线值，并推进模拟的时间线
+    void CloseBatch(uint32_t queue) {
+        Batch& batch = m_batches[m_open[queue]];
+        m_open[queue] = kNoBatch;
+        batch.signalValue = ++m_timelineValues[queue];
+
+        uint64_t time = std::max(m_cursorNs[queue], batch.waitBatch != kNoBatch ? m_batches[batch.waitBatch].endNs : 0);
+        for (uint32_t item : batch.items) {
+            uint64_t duration = m_items[item].gpuTimeNs;
+            if (duration > 0) {
+                m_intervals[queue].push_back({time, time + duration});
+            }
+            time += duration;
+            m_report.serialNs += duration;
+        }
+        batch.endNs = time;
+        m_cursorNs[queue] = time;
+    }
+
+    // 以一次SubmitBatch提交该队列的所有批次
+    Result<void> SubmitQueue(uint32_t queue) {
+        m_submits.clear();
+        m_waits.clear();
+        m_signals.clear();
+        for (uint32_t b = 0; b < m_batchCount; ++b) {
+            const Batch& batch = m_batches[b];
+            if (batch.queue != queue) {
+                continue;
+            }
+            if (batch.waitBatch != kNoBatch) {
+                const Batch& producer = m_batches[batch.waitBatch];
+                m_waits.push_back(SemaphoreWaitInfo(m_semaphores[producer.queue].get(), producer.signalValue));
+                ++m_report.semaphoreWaitCount;
+            }
+            m_signals.push_back(SemaphoreSignalInfo(m_semaphores[queue].get(), batch.signalValue));
+        }
+        if (m_signals.empty()) {
+            return MakeSuccessResult();
+        }
+
+        // 等待与信号数组填写完成后再引用，避免扩容使指针失效
+        size_t waitIndex = 0;
+        size_t signalIndex = 0;
+        for (uint32_t b = 0; b < m_batchCount; ++b) {
+            const Batch& batch = m_batches[b];
+            if (batch.queue != queue) {
+                continue;
+            }
+            SubmitDesc submit;
+            submit.commandBuffers = batch.commandBuffers;
+            if (batch.waitBatch != kNoBatch) {
+                submit.waitSemaphores = Span<const SemaphoreWaitInfo>(&m_waits[waitIndex++], 1);
+            }
+            submit.signalSemaphores = Span<const SemaphoreSignalInfo>(&m_signals[signalIndex++], 1);
+            m_submits.push_back(submit);
+        }
+        RHI_RETURN_IF_FAILED(m_queues[queue]->SubmitBatch(m_submits, nullptr));
+        m_allocator.TrackSubmission(ToQueueType(queue), m_semaphores[queue].get(), m_timelineValues[queue]);
+        m_report.submissionCount += static_cast<uint32_t>(m_submits.size());
+        ++m_report.submitCallCount;
+        return MakeSuccessResult();
+    }
+
+    void ComputeOverlap() {
+        for (uint32_t q = 0; q < 2; ++q) {
+            uint64_t busy = 0;
+            for (const Interval& interval : m_intervals[q]) {
+                busy += interval.end - interval.begin;
+            }
+            (q == kGraphics ? m_report.graphicsBusyNs : m_report.computeBusyNs) = busy;
+        }
+        m_report.frameNs = std::max(m_cursorNs[kGraphics], m_cursorNs[kCompute]);
+
+        // 每个队列的区间按时间有序且互不相交
+        const std::vector<Interval>& a = m_intervals[kGraphics];
+        const std::vector<Interval>& b = m_intervals[kCompute];
+        size_t i = 0;
+        size_t j = 0;
+        while (i < a.size() && j < b.size()) {
+            uint64_t begin = std::max(a[i].begin, b[j].begin);
+            uint64_t end = std::min(a[i].end, b[j].end);
+            if (end > begin) {
+                m_report.overlapNs += end - begin;
+            }
+            if (a[i].end < b[j].end) {
+                ++i;
+            } else {
+                ++j;
+            }
+        }
+    }
+
+    IDevice* m_device;
+    FrameCommandAllocator& m_allocator;
+    IQueue* m_queues[2] = {};
+    std::unique_ptr<ISemaphore> m_semaphores[2];   // 每个队列一个时间线信号量，每次提交发出下一个值
+    uint64_t m_timelineValues[2] = {};             // 每个队列最近分配的时间线值
+    std::vector<WorkItem> m_items;
+    uint32_t m_itemCount = 0;
+    std::vector<Handoff> m_handoffs;
+    std::vector<BarrierDesc> m_handoffBarriers;
+    std::vector<Batch> m_batches;
+    uint32_t m_batchCount = 0;
+    uint32_t m_open[2] = {kNoBatch, kNoBatch};     // 每个队列当前未提交的批次
+    std::vector<uint32_t> m_batchOf;               // 工作项所在的批次
+    std::vector<SubmitDesc> m_submits;
+    std::vector<SemaphoreWaitInfo> m_waits;
+    std::vector<SemaphoreSignalInfo> m_signals;
+    uint64_t m_cursorNs[2] = {};
+    std::vector<Interval> m_intervals[2];
+    AsyncComputeReport m_report;
+    ErrorInfo m_buildError = ErrorInfo{ErrorCode::Success, ""};
+};
+
+} // namespace RHI
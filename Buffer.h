@@ -1,6 +1,8 @@
 
 #pragma once
 #include "Result.h"
+#include "Memory.h"
+#include "ResourceState.h"
 #include <cstdint>
 
 namespace RHI {
@@ -38,26 +40,6 @@ inline BufferUsage operator&(BufferUsage a, BufferUsage b) {
         static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
 }
 
-// 内存属性
-enum class MemoryType {
-    Default,            // GPU本地内存
-                       // - DirectX12: D3D12_HEAP_TYPE_DEFAULT
-                       // - Vulkan: VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-                       // - Metal: MTLStorageModePrivate
-    
-    Upload,             // CPU上传内存
-                       // - DirectX12: D3D12_HEAP_TYPE_UPLOAD
-                       // - Vulkan: VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-                       // - Metal: MTLStorageModeShared
-    
-    Readback,          // CPU回读内存
-                       // - DirectX12: D3D12_HEAP_TYPE_READBACK
-                       // - Vulkan: VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT
-                       // - Metal: MTLStorageModeShared
-    
-    Custom              // 自定义内存属性
-};
-
 // 缓冲区描述
 struct BufferDesc {
     BufferType type;            // 缓冲区类型
@@ -66,6 +48,7 @@ struct BufferDesc {
     size_t size;              // 缓冲区大小（字节）
     size_t stride;            // 结构化缓冲区的步长（字节）
     bool allowCPUAccess;      // 是否允许CPU访问
+    MemoryTag tag;            // 内存标签
 
     BufferDesc() :
         type(BufferType::Vertex),
@@ -97,13 +80,20 @@ public:
     // Metal: id<MTLBuffer>
     virtual Result<void*> GetNativeHandle() = 0;
 
-    // 映射缓冲区内存
+    // 映射缓冲区内存（返回GetMappedData的地址）
     virtual Result<void*> Map() = 0;
 
-    // 解除映射
+    // 解除映射（不解除持久映射）
     virtual Result<void> Unmap() = 0;
 
-    // 更新缓冲区数据
+    // 持久映射的CPU地址：CPU可访问的缓冲区在创建时映射一次，地址在缓冲区的整个生命周期内不变，
+    // 无需Map/Unmap（CPU不可访问时为nullptr）。写入的范围交给IDevice::FlushMappedRanges
+    virtual void* GetMappedData() const = 0;
+
+    // 映射内存是否HostCoherent（CPU写入无需刷新即对GPU可见，FlushMappedRanges跳过此缓冲区）
+    virtual bool IsHostCoherent() const = 0;
+
+    // 更新缓冲区数据（主机可见的缓冲区直接写入映射地址，非HostCoherent时随即刷新该范围）
     virtual Result<void> UpdateData(
         const void* data,
         size_t size,
@@ -139,15 +129,19 @@ public:
         const BufferViewDesc& desc) = 0;
 
     // 转换缓冲区状态
-    // DirectX12: D3D12_RESOURCE_STATES
-    // Vulkan: VkAccessFlags
-    // Metal: MTLResourceUsage
-    virtual Result<void> TransitionState(uint32_t newState) = 0;
+    virtual Result<void> TransitionState(ResourceState newState) = 0;
 
 protected:
     BufferDesc m_desc;
 };
 
+// 持久映射缓冲区中CPU写入过的范围（IDevice::FlushMappedRanges）
+struct MappedRange {
+    IBuffer* buffer;               // 缓冲区
+    size_t offset;                 // 起始偏移（字节）
+    size_t size;                   // 大小（字节）
+};
+
 // 用于创建缓冲区的工厂函数声明
 using BufferCreateFunc = Result<IBuffer*> (*)(const BufferDesc& desc);
 
@@ -0,0 +1,1760 @@
+#pragma once
+#include "NullBackend.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RHI_CPU_SSE2 1
+#endif
+
+namespace RHI {
+
+// CPU参考后端（AdapterType::CPU）
+// 在工作线程池上执行命令缓冲区：
+// - CopyBuffer/CopyTexture/CopyBufferToTexture按区域并行复制
+// - Dispatch按线程组并行调用注册的C++计算内核
+// - Draw/DrawIndexed使用分块（64x64）SIMD三角形光栅化器写入ITexture渲染目标
+// - 每条命令执行完毕后所有工作线程已汇合，ResourceBarrier不需要额外工作
+//
+// 着色器以C++可调用对象的形式通过CPUDevice::Register*注册，
+// IDevice::CreateShader按ShaderDesc::entryPoint与type查找已注册的函数，
+// 因此同一份帧代码无需修改即可在CPU后端上运行。
+//
+// 限制：仅支持三角形列表；不做近平面裁剪（任一顶点w<=0的三角形被丢弃）；
+// 不支持混合与多重采样；深度附件须为D32_FLOAT。
+// 提交在IQueue::Submit返回时已执行完毕。
+
+// CPU后端常量
+constexpr uint32_t kCPUMaxVaryings = 16;           // 顶点着色器最大输出变量数（float）
+constexpr uint32_t kCPUMaxColorTargets = 8;        // 最大颜色附件数
+constexpr uint32_t kCPUMaxDescriptorSets = 8;      // 最大描述符集数
+constexpr uint32_t kCPUMaxDynamicOffsets = 8;      // 每个描述符集的最大动态偏移数
+constexpr uint32_t kCPUMaxVertexBuffers = 16;      // 最大顶点缓冲区槽位数
+constexpr uint32_t kCPUMaxPushConstantSize = 256;  // 推送常量最大字节数
+constexpr uint32_t kCPUTileSize = 64;              // 光栅化分块尺寸（像素）
+constexpr size_t kCPUParallelCopyThreshold = 64 * 1024;  // 小于此字节数的纹理复制区域在调用线程上执行
+
+// CPU缓冲区（所有内存类型都有主机存储，放置的缓冲区使用内存块的后备存储）
+class CPUBuffer : public NullBuffer {
+public:
+    explicit CPUBuffer(const BufferDesc& desc)
+        : NullBuffer(desc, true) {}
+
+    CPUBuffer(const BufferDesc& desc, NullMemory* memory, size_t offset)
+        : NullBuffer(desc, memory->GetHostStorage() + offset) {}
+};
+
+// CPU纹理
+// 子资源按层优先、mip次之的顺序紧密存储，布局与GetSubresourceLayout一致
+class CPUTexture : public NullTexture {
+public:
+    explicit CPUTexture(const TextureDesc& desc)
+        : NullTexture(desc) {
+        m_storage.resize(EstimateTextureDataSize(desc));
+        m_data = m_storage.data();
+    }
+
+    // 放置在memory的offset处，存储与重叠的放置资源共享
+    CPUTexture(const TextureDesc& desc, NullMemory* memory, size_t offset)
+        : NullTexture(desc) {
+        m_data = memory->GetHostStorage() + offset;
+    }
+
+    // 更新纹理数据
+    // layout描述源数据：offset为首个子资源的偏移，rowPitch/depthPitch为0时视为紧密排列，
+    // 范围内的各数组层之间相隔arrayPitch。一次只能更新一个mip级别。
+    Result<void> UpdateData(
+        const void* data,
+        const TextureDataLayout& layout,
+        const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(data != nullptr, ErrorCode::InvalidArgument, "数据指针不能为空");
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        RHI_VALIDATE(range.mipLevelCount == 1,
+            ErrorCode::InvalidArgument,
+            "CPU后端一次只能更新一个mip级别");
+        RHI_VALIDATE(!HasUsage(TextureUsage::Transient), ErrorCode::InvalidOperation, "瞬态附件的内容不能更新");
+
+        const uint8_t* source = static_cast<const uint8_t*>(data) + layout.offset;
+        for (uint32_t i = 0; i < range.arrayLayerCount; ++i) {
+            uint32_t mip = range.baseMipLevel;
+            uint32_t layer = range.baseArrayLayer + i;
+            TextureDataLayout dst = GetLayout(mip, layer);
+            size_t rows = GetRowCount(mip);
+            size_t depth = std::max(m_desc.depth >> mip, 1u);
+            size_t srcRowPitch = layout.rowPitch != 0 ? layout.rowPitch : dst.rowPitch;
+            size_t srcDepthPitch = layout.depthPitch != 0 ? layout.depthPitch : srcRowPitch * rows;
+            const uint8_t* layerSource = source + i * layout.arrayPitch;
+
+            for (size_t z = 0; z < depth; ++z) {
+                for (size_t row = 0; row < rows; ++row) {
+                    std::memcpy(
+                        m_data + dst.offset + z * dst.depthPitch + row * dst.rowPitch,
+                        layerSource + z * srcDepthPitch + row * srcRowPitch,
+                        dst.rowPitch);
+                }
+            }
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> GenerateMips(const TextureSubresourceRange&) override {
+        return MakeErrorResult<void>(ErrorCode::NotImplemented, "CPU后端不支持生成Mipmap");
+    }
+
+    // 子资源的存储布局
+    TextureDataLayout GetLayout(uint32_t mipLevel, uint32_t arrayLayer) const {
+        size_t layerSize = 0;
+        size_t mipOffset = 0;
+        for (uint32_t mip = 0; mip < m_desc.mipLevels; ++mip) {
+            if (mip == mipLevel) {
+                mipOffset = layerSize;
+            }
+            layerSize += GetMipSize(mip);
+        }
+
+        uint32_t block = GetFormatBlockDimension(m_desc.format);
+        uint32_t width = std::max(m_desc.width >> mipLevel, 1u);
+
+        TextureDataLayout layout = {};
+        layout.rowPitch = static_cast<size_t>((width + block - 1) / block) * GetFormatBlockSize(m_desc.format);
+        layout.depthPitch = layout.rowPitch * GetRowCount(mipLevel);
+        layout.arrayPitch = layerSize;
+        layout.offset = layerSize * arrayLayer + mipOffset;
+        return layout;
+    }
+
+    // 子资源数据指针
+    uint8_t* GetSubresourceData(uint32_t mipLevel, uint32_t arrayLayer) {
+        return m_data + GetLayout(mipLevel, arrayLayer).offset;
+    }
+
+    // 复制区域是否落在子资源内（坐标以像素计，块压缩格式按补齐到整块的尺寸比较）
+    bool IsCopyRegionValid(uint32_t mipLevel, uint32_t arrayLayer, const uint32_t offset[3], const uint32_t extent[3]) const {
+        if (mipLevel >= m_desc.mipLevels || arrayLayer >= GetTextureLayerCount(m_desc)) {
+            return false;
+        }
+        uint64_t block = GetFormatBlockDimension(m_desc.format);
+        uint64_t width = (std::max(m_desc.width >> mipLevel, 1u) + block - 1) / block * block;
+        uint64_t height = (std::max(m_desc.height >> mipLevel, 1u) + block - 1) / block * block;
+        uint64_t depth = std::max(m_desc.depth >> mipLevel, 1u);
+        return static_cast<uint64_t>(offset[0]) + extent[0] <= width &&
+            static_cast<uint64_t>(offset[1]) + extent[1] <= height &&
+            static_cast<uint64_t>(offset[2]) + std::max(extent[2], 1u) <= depth;
+    }
+
+    // mip级别的块行数
+    size_t GetRowCount(uint32_t mipLevel) const {
+        uint32_t block = GetFormatBlockDimension(m_desc.format);
+        uint32_t height = std::max(m_desc.height >> mipLevel, 1u);
+        return (height + block - 1) / block;
+    }
+
+    uint8_t* GetStorage() { return m_data; }
+
+private:
+    std::vector<uint8_t> m_storage;
+    uint8_t* m_data = nullptr;          // m_storage或内存块后备存储中的范围
+};
+
+// CPU描述符集（保存每个绑定点最近一次写入的描述符）
+class CPUDescriptorSet : public NullDescriptorSet {
+public:
+    explicit CPUDescriptorSet(IDescriptorSetLayout* layout)
+        : NullDescriptorSet(layout) {}
+
+    Result<void> UpdateDescriptor(const std::vector<DescriptorWrite>& writes) override {
+        for (const DescriptorWrite& write : writes) {
+            if (write.dstBinding >= m_bindings.size()) {
+                m_bindings.resize(write.dstBinding + 1, DescriptorWrite{});
+                m_valid.resize(write.dstBinding + 1, false);
+            }
+            m_bindings[write.dstBinding] = write;
+            m_valid[write.dstBinding] = true;
+        }
+        return MakeSuccessResult();
+    }
+
+    // 获取绑定点的描述符（未写入时返回nullptr）
+    const DescriptorWrite* GetBinding(uint32_t binding) const {
+        return binding < m_bindings.size() && m_valid[binding] ? &m_bindings[binding] : nullptr;
+    }
+
+    // 动态缓冲区绑定在动态偏移数组中的下标（按绑定号顺序计数）
+    uint32_t GetDynamicIndex(uint32_t binding) const {
+        uint32_t index = 0;
+        for (uint32_t i = 0; i < binding && i < m_bindings.size(); ++i) {
+            index += m_valid[i] && IsDynamic(m_bindings[i].type) ? 1 : 0;
+        }
+        return index;
+    }
+
+    static bool IsDynamic(DescriptorType type) {
+        return type == DescriptorType::UniformBufferDynamic || type == DescriptorType::StorageBufferDynamic;
+    }
+
+private:
+    std::vector<DescriptorWrite> m_bindings;
+    std::vector<bool> m_valid;
+};
+
+// 着色器可访问的资源（绑定的描述符集与推送常量）
+// 描述符约定：DescriptorWrite::bufferInfo为IBuffer::Get*View的返回值，
+// imageInfo为ITexture::Get*View的返回值
+class CPUResourceContext {
+public:
+    CPUResourceContext(const CPUDescriptorSet* const* sets,
+                       const uint32_t (*dynamicOffsets)[kCPUMaxDynamicOffsets],
+                       const uint8_t* pushConstants)
+        : m_sets(sets)
+        , m_dynamicOffsets(dynamicOffsets)
+        , m_pushConstants(pushConstants) {}
+
+    // 绑定的缓冲区数据（已加上视图偏移与动态偏移，未绑定时返回nullptr）
+    uint8_t* GetBufferData(uint32_t set, uint32_t binding) const {
+        const DescriptorWrite* write = GetWrite(set, binding);
+        const NullBufferView* view = write != nullptr ? static_cast<const NullBufferView*>(write->bufferInfo) : nullptr;
+        if (view == nullptr || view->buffer->GetStorage() == nullptr) {
+            return nullptr;
+        }
+        size_t offset = view->desc.offset;
+        if (CPUDescriptorSet::IsDynamic(write->type)) {
+            uint32_t index = m_sets[set]->GetDynamicIndex(binding);
+            offset += index < kCPUMaxDynamicOffsets ? m_dynamicOffsets[set][index] : 0;
+        }
+        return view->buffer->GetStorage() + offset;
+    }
+
+    // 绑定的缓冲区视图（未绑定时返回nullptr）
+    const NullBufferView* GetBufferView(uint32_t set, uint32_t binding) const {
+        const DescriptorWrite* write = GetWrite(set, binding);
+        return write != nullptr ? static_cast<const NullBufferView*>(write->bufferInfo) : nullptr;
+    }
+
+    // 绑定的纹理视图（未绑定时返回nullptr）
+    const NullTextureView* GetTextureView(uint32_t set, uint32_t binding) const {
+        const DescriptorWrite* write = GetWrite(set, binding);
+        return write != nullptr ? static_cast<const NullTextureView*>(write->imageInfo) : nullptr;
+    }
+
+    // 推送常量数据（kCPUMaxPushConstantSize字节）
+    const void* GetPushConstants() const { return m_pushConstants; }
+
+private:
+    const DescriptorWrite* GetWrite(uint32_t set, uint32_t binding) const {
+        if (set >= kCPUMaxDescriptorSets || m_sets[set] == nullptr) {
+            return nullptr;
+        }
+        return m_sets[set]->GetBinding(binding);
+    }
+
+    const CPUDescriptorSet* const* m_sets;
+    const uint32_t (*m_dynamicOffsets)[kCPUMaxDynamicOffsets];
+    const uint8_t* m_pushConstants;
+};
+
+// 顶点着色器输入
+struct CPUVertexInput {
+    const CPUResourceContext* resources;                // 绑定的资源
+    const uint8_t* vertexData[kCPUMaxVertexBuffers];    // 每个绑定点上当前顶点（或实例）的数据
+    uint32_t vertexIndex;                               // 顶点索引（已加上vertexOffset）
+    uint32_t instanceIndex;                             // 实例索引
+};
+
+// 顶点着色器输出
+struct CPUVertexOutput {
+    float position[4];                  // 裁剪空间位置
+    float varyings[kCPUMaxVaryings];    // 传递给像素着色器的变量
+};
+
+// 像素着色器输入
+struct CPUPixelInput {
+    const CPUResourceContext* resources;    // 绑定的资源
+    float position[4];                      // 像素中心的屏幕坐标x、y，深度z，1/w
+    float varyings[kCPUMaxVaryings];        // 透视校正插值后的变量
+};
+
+// 像素着色器输出
+struct CPUPixelOutput {
+    float color[kCPUMaxColorTargets][4];    // 每个颜色附件的RGBA
+};
+
+// 计算内核输入
+struct CPUComputeInput {
+    const CPUResourceContext* resources;    // 绑定的资源
+    uint32_t groupId[3];                    // 线程组索引
+    uint32_t groupCount[3];                 // 线程组数量
+};
+
+// 着色器函数（可在多个工作线程上并发调用，须线程安全）
+using CPUVertexShaderFunc = std::function<void(const CPUVertexInput&, CPUVertexOutput&)>;
+using CPUPixelShaderFunc = std::function<bool(const CPUPixelInput&, CPUPixelOutput&)>;  // 返回false丢弃像素
+using CPUComputeKernelFunc = std::function<void(const CPUComputeInput&)>;
+
+// CPU着色器
+class CPUShader : public NullShader {
+public:
+    CPUShader(const ShaderDesc& desc, CPUVertexShaderFunc vertex, CPUPixelShaderFunc pixel,
+        CPUComputeKernelFunc compute, uint32_t varyingCount)
+        : NullShader(desc)
+        , m_vertex(std::move(vertex))
+        , m_pixel(std::move(pixel))
+        , m_compute(std::move(compute))
+        , m_varyingCount(varyingCount) {}
+
+    const CPUVertexShaderFunc& GetVertexFunc() const { return m_vertex; }
+    const CPUPixelShaderFunc& GetPixelFunc() const { return m_pixel; }
+    const CPUComputeKernelFunc& GetComputeFunc() const { return m_compute; }
+    uint32_t GetVaryingCount() const { return m_varyingCount; }
+
+private:
+    CPUVertexShaderFunc m_vertex;
+    CPUPixelShaderFunc m_pixel;
+    CPUComputeKernelFunc m_compute;
+    uint32_t m_varyingCount;
+};
+
+// CPU管线状态
+class CPUPipelineState : public NullPipelineState {
+public:
+    explicit CPUPipelineState(const PipelineStateDesc& desc)
+        : NullPipelineState(desc) {
+        if (const ComputePipelineStateDesc* computeDesc = desc.AsCompute()) {
+            m_computeShader = static_cast<CPUShader*>(static_cast<IShader*>(computeDesc->computeShader));
+        } else if (const GraphicsPipelineStateDesc* graphicsDesc = desc.AsGraphics()) {
+            m_vertexShader = static_cast<CPUShader*>(static_cast<IShader*>(graphicsDesc->vertexShader));
+            m_pixelShader = static_cast<CPUShader*>(static_cast<IShader*>(graphicsDesc->pixelShader));
+            m_vertexBindings = graphicsDesc->vertexBindings;
+            m_rasterizationState = graphicsDesc->rasterizationState;
+            m_depthStencilState = graphicsDesc->depthStencilState;
+        }
+    }
+
+    const CPUShader* GetVertexShader() const { return m_vertexShader; }
+    const CPUShader* GetPixelShader() const { return m_pixelShader; }
+    const CPUShader* GetComputeShader() const { return m_computeShader; }
+    const std::vector<VertexBinding>& GetVertexBindings() const { return m_vertexBindings; }
+    const RasterizationState& GetRasterizationState() const { return m_rasterizationState; }
+    const DepthStencilState& GetDepthStencilState() const { return m_depthStencilState; }
+
+private:
+    CPUShader* m_vertexShader = nullptr;
+    CPUShader* m_pixelShader = nullptr;
+    CPUShader* m_computeShader = nullptr;
+    std::vector<VertexBinding> m_vertexBindings;
+    RasterizationState m_rasterizationState;
+    DepthStencilState m_depthStencilState;
+};
+
+// CPU命令类型
+enum class CPUCommandType : uint8_t {
+    BeginRenderPass,
+    EndRenderPass,
+    SetViewport,
+    SetScissor,
+    SetPipelineState,
+    SetDescriptorSet,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    PushConstants,
+    Draw,
+    DrawIndexed,
+    DrawIndirect,
+    Dispatch,
+    DispatchIndirect,
+    CopyBuffer,
+    CopyTexture,
+    CopyBufferToTexture,
+    ResourceBarrier,
+    ExecuteBundle,
+};
+
+// 录制的命令（变长数据保存在命令缓冲区的数据区中）
+struct CPUCommand {
+    CPUCommandType type;
+    uint32_t args[5];           // 整数参数
+    void* objects[2];           // 对象参数
+    uint32_t dataOffset;        // 变长数据在数据区中的偏移
+    uint32_t dataSize;          // 变长数据大小
+};
+
+// CPU命令缓冲区
+// 在NullCommandBuffer的状态检查之上把命令录制到连续数组中，Begin时复用已有容量
+class CPUCommandBuffer : public NullCommandBuffer {
+public:
+    explicit CPUCommandBuffer(const CommandBufferDesc& desc)
+        : NullCommandBuffer(desc) {}
+
+    Result<void> Begin() override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::Begin());
+        m_commands.clear();
+        m_data.clear();
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        m_commands.clear();
+        m_data.clear();
+        return NullCommandBuffer::Reset();
+    }
+
+    Result<void> BeginRenderPass(const RenderPassDesc& desc) override {
+        // 以下上限决定执行器中定长数组的写入范围，发布版同样检查；
+        // 附件数在基类进入渲染通道之前检查，被拒绝时不改变状态
+        RHI_RETURN_IF_FALSE(desc.colorAttachmentCount <= kCPUMaxColorTargets,
+            ErrorCode::InvalidArgument,
+            "颜色附件数量超过上限: " + std::to_string(desc.colorAttachmentCount));
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::BeginRenderPass(desc));
+        CPUCommand& command = Push(CPUCommandType::BeginRenderPass);
+        command.args[0] = desc.colorAttachmentCount;
+        command.objects[0] = desc.depthStencilAttachment;
+        StoreData(command, desc.colorAttachments, desc.colorAttachmentCount * sizeof(void*));
+        return MakeSuccessResult();
+    }
+
+    Result<void> EndRenderPass() override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::EndRenderPass());
+        Push(CPUCommandType::EndRenderPass);
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetViewport(const Viewport& viewport) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::SetViewport(viewport));
+        CPUCommand& command = Push(CPUCommandType::SetViewport);
+        StoreData(command, &viewport, sizeof(viewport));
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetScissor(const Scissor& scissor) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::SetScissor(scissor));
+        CPUCommand& command = Push(CPUCommandType::SetScissor);
+        StoreData(command, &scissor, sizeof(scissor));
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetPipelineState(void* pipelineState) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::SetPipelineState(pipelineState));
+        Push(CPUCommandType::SetPipelineState).objects[0] = pipelineState;
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetDescriptorSet(uint32_t set, void* descriptorSet) override {
+        return SetDescriptorSet(set, descriptorSet, Span<const uint32_t>());
+    }
+
+    Result<void> SetDescriptorSet(uint32_t set, void* descriptorSet, Span<const uint32_t> dynamicOffsets) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::SetDescriptorSet(set, descriptorSet, dynamicOffsets));
+        RHI_RETURN_IF_FALSE(set < kCPUMaxDescriptorSets,
+            ErrorCode::InvalidArgument,
+            "描述符集索引越界: " + std::to_string(set));
+        // 执行器把偏移复制进每个描述符集的定长行，发布版同样检查
+        RHI_RETURN_IF_FALSE(dynamicOffsets.size() <= kCPUMaxDynamicOffsets,
+            ErrorCode::InvalidArgument,
+            "动态偏移数超过上限: " + std::to_string(dynamicOffsets.size()));
+        CPUCommand& command = Push(CPUCommandType::SetDescriptorSet);
+        command.args[0] = set;
+        command.args[1] = static_cast<uint32_t>(dynamicOffsets.size());
+        command.objects[0] = descriptorSet;
+        StoreData(command, dynamicOffsets.data(), dynamicOffsets.size() * sizeof(uint32_t));
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetVertexBuffer(uint32_t slot, void* vertexBufferView) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::SetVertexBuffer(slot, vertexBufferView));
+        RHI_RETURN_IF_FALSE(slot < kCPUMaxVertexBuffers,
+            ErrorCode::InvalidArgument,
+            "顶点缓冲区槽位越界: " + std::to_string(slot));
+        CPUCommand& command = Push(CPUCommandType::SetVertexBuffer);
+        command.args[0] = slot;
+        command.objects[0] = vertexBufferView;
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetIndexBuffer(void* indexBufferView) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::SetIndexBuffer(indexBufferView));
+        Push(CPUCommandType::SetIndexBuffer).objects[0] = indexBufferView;
+        return MakeSuccessResult();
+    }
+
+    Result<void> PushConstants(void* layout, uint32_t offset, uint32_t size, const void* data) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::PushConstants(layout, offset, size, data));
+        RHI_RETURN_IF_FALSE(offset <= kCPUMaxPushConstantSize && size <= kCPUMaxPushConstantSize - offset,
+            ErrorCode::InvalidArgument,
+            "推送常量范围越界");
+        CPUCommand& command = Push(CPUCommandType::PushConstants);
+        command.args[0] = offset;
+        StoreData(command, data, size);
+        return MakeSuccessResult();
+    }
+
+    Result<void> Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex,
+        uint32_t firstInstance) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::Draw(vertexCount, instanceCount, firstVertex, firstInstance));
+        CPUCommand& command = Push(CPUCommandType::Draw);
+        command.args[0] = vertexCount;
+        command.args[1] = instanceCount;
+        command.args[2] = firstVertex;
+        command.args[3] = firstInstance;
+        return MakeSuccessResult();
+    }
+
+    Result<void> DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+        int32_t vertexOffset, uint32_t firstInstance) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::DrawIndexed(
+            indexCount, instanceCount, firstIndex, vertexOffset, firstInstance));
+        CPUCommand& command = Push(CPUCommandType::DrawIndexed);
+        command.args[0] = indexCount;
+        command.args[1] = instanceCount;
+        command.args[2] = firstIndex;
+        command.args[3] = static_cast<uint32_t>(vertexOffset);
+        command.args[4] = firstInstance;
+        return MakeSuccessResult();
+    }
+
+    Result<void> DrawIndirect(void* argumentBuffer, uint32_t offset, uint32_t drawCount,
+        uint32_t stride) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::DrawIndirect(argumentBuffer, offset, drawCount, stride));
+        CPUCommand& command = Push(CPUCommandType::DrawIndirect);
+        command.args[0] = offset;
+        command.args[1] = drawCount;
+        command.args[2] = stride;
+        command.objects[0] = argumentBuffer;
+        return MakeSuccessResult();
+    }
+
+    Result<void> Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::Dispatch(groupCountX, groupCountY, groupCountZ));
+        CPUCommand& command = Push(CPUCommandType::Dispatch);
+        command.args[0] = groupCountX;
+        command.args[1] = groupCountY;
+        command.args[2] = groupCountZ;
+        return MakeSuccessResult();
+    }
+
+    Result<void> DispatchIndirect(void* argumentBuffer, uint32_t offset) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::DispatchIndirect(argumentBuffer, offset));
+        CPUCommand& command = Push(CPUCommandType::DispatchIndirect);
+        command.args[0] = offset;
+        command.objects[0] = argumentBuffer;
+        return MakeSuccessResult();
+    }
+
+    Result<void> CopyBuffer(void* srcBuffer, void* dstBuffer, uint32_t regionCount, void* regions) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::CopyBuffer(srcBuffer, dstBuffer, regionCount, regions));
+        // 区域数组在录制时拷贝，发布版同样检查
+        RHI_RETURN_IF_FALSE(regions != nullptr || regionCount == 0, ErrorCode::InvalidArgument, "复制区域不能为空");
+        CPUCommand& command = Push(CPUCommandType::CopyBuffer);
+        command.args[0] = regionCount;
+        command.objects[0] = srcBuffer;
+        command.objects[1] = dstBuffer;
+        StoreData(command, regions, regionCount * sizeof(BufferCopyRegion));
+        return MakeSuccessResult();
+    }
+
+    Result<void> CopyTexture(void* srcTexture, void* dstTexture, uint32_t regionCount, void* regions) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::CopyTexture(srcTexture, dstTexture, regionCount, regions));
+        RHI_RETURN_IF_FALSE(regions != nullptr || regionCount == 0, ErrorCode::InvalidArgument, "复制区域不能为空");
+        CPUCommand& command = Push(CPUCommandType::CopyTexture);
+        command.args[0] = regionCount;
+        command.objects[0] = srcTexture;
+        command.objects[1] = dstTexture;
+        StoreData(command, regions, regionCount * sizeof(TextureCopyRegion));
+        return MakeSuccessResult();
+    }
+
+    Result<void> CopyBufferToTexture(void* srcBuffer, void* dstTexture, uint32_t regionCount, void* regions) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::CopyBufferToTexture(srcBuffer, dstTexture, regionCount, regions));
+        RHI_RETURN_IF_FALSE(regions != nullptr || regionCount == 0, ErrorCode::InvalidArgument, "复制区域不能为空");
+        CPUCommand& command = Push(CPUCommandType::CopyBufferToTexture);
+        command.args[0] = regionCount;
+        command.objects[0] = srcBuffer;
+        command.objects[1] = dstTexture;
+        StoreData(command, regions, regionCount * sizeof(BufferTextureCopyRegion));
+        return MakeSuccessResult();
+    }
+
+    Result<void> ResourceBarrier(uint32_t barrierCount, const BarrierDesc* barriers) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::ResourceBarrier(barrierCount, barriers));
+        Push(CPUCommandType::ResourceBarrier).args[0] = barrierCount;
+        return MakeSuccessResult();
+    }
+
+    Result<void> ExecuteBundle(ICommandBuffer* bundle) override {
+        RHI_RETURN_IF_FAILED(NullCommandBuffer::ExecuteBundle(bundle));
+        Push(CPUCommandType::ExecuteBundle).objects[0] = bundle;
+        return MakeSuccessResult();
+    }
+
+    const std::vector<CPUCommand>& GetCommands() const { return m_commands; }
+
+    // 命令的变长数据
+    const void* GetData(const CPUCommand& command) const {
+        return command.dataSize > 0 ? m_data.data() + command.dataOffset : nullptr;
+    }
+
+private:
+    CPUCommand& Push(CPUCommandType type) {
+        CPUCommand command = {};
+        command.type = type;
+        m_commands.push_back(command);
+        return m_commands.back();
+    }
+
+    // 保存变长数据（按8字节对齐，保证可直接按结构体访问）
+    void StoreData(CPUCommand& command, const void* data, size_t size) {
+        if (data == nullptr || size == 0) {
+            return;
+        }
+        size_t offset = (m_data.size() + 7) & ~static_cast<size_t>(7);
+        m_data.resize(offset + size);
+        std::memcpy(m_data.data() + offset, data, size);
+        command.dataOffset = static_cast<uint32_t>(offset);
+        command.dataSize = static_cast<uint32_t>(size);
+    }
+
+    std::vector<CPUCommand> m_commands;
+    std::vector<uint8_t> m_data;
+};
+
+// 把颜色写入指定格式的像素
+inline void CPUStoreColor(uint8_t* dst, Format format, const float* color) {
+    auto unorm8 = [](float value) {
+        value = std::min(std::max(value, 0.0f), 1.0f);
+        return static_cast<uint8_t>(value * 255.0f + 0.5f);
+    };
+    switch (format) {
+        case Format::R8_UNORM:
+            dst[0] = unorm8(color[0]);
+            break;
+        case Format::RG8_UNORM:
+            dst[0] = unorm8(color[0]);
+            dst[1] = unorm8(color[1]);
+            break;
+        case Format::RGBA8_UNORM:
+        case Format::RGBA8_SRGB:
+            for (int i = 0; i < 4; ++i) {
+                dst[i] = unorm8(color[i]);
+            }
+            break;
+        case Format::BGRA8_UNORM:
+        case Format::BGRA8_SRGB:
+            dst[0] = unorm8(color[2]);
+            dst[1] = unorm8(color[1]);
+            dst[2] = unorm8(color[0]);
+            dst[3] = unorm8(color[3]);
+            break;
+        case Format::R32_FLOAT:
+            std::memcpy(dst, color, sizeof(float));
+            break;
+        case Format::RG32_FLOAT:
+            std::memcpy(dst, color, sizeof(float) * 2);
+            break;
+        case Format::RGBA32_FLOAT:
+            std::memcpy(dst, color, sizeof(float) * 4);
+            break;
+        default:
+            break;
+    }
+}
+
+// 判断格式是否可作为CPU后端的颜色附件
+inline bool IsCPURenderTargetFormat(Format format) {
+    switch (format) {
+        case Format::R8_UNORM:
+        case Format::RG8_UNORM:
+        case Format::RGBA8_UNORM:
+        case Format::RGBA8_SRGB:
+        case Format::BGRA8_UNORM:
+        case Format::BGRA8_SRGB:
+        case Format::R32_FLOAT:
+        case Format::RG32_FLOAT:
+        case Format::RGBA32_FLOAT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// 深度比较
+inline bool CPUCompareDepth(DepthStencilState::CompareOp op, float value, float reference) {
+    switch (op) {
+        case DepthStencilState::CompareOp::Never: return false;
+        case DepthStencilState::CompareOp::Less: return value < reference;
+        case DepthStencilState::CompareOp::Equal: return value == reference;
+        case DepthStencilState::CompareOp::LessOrEqual: return value <= reference;
+        case DepthStencilState::CompareOp::Greater: return value > reference;
+        case DepthStencilState::CompareOp::NotEqual: return value != reference;
+        case DepthStencilState::CompareOp::GreaterOrEqual: return value >= reference;
+        case DepthStencilState::CompareOp::Always: return true;
+    }
+    return false;
+}
+
+// 光栅化的附件
+struct CPURenderTarget {
+    uint8_t* data;              // 子资源数据
+    size_t rowPitch;            // 行间距
+    uint32_t pixelSize;         // 每像素字节数
+    Format format;              // 格式
+};
+
+// 执行期绑定状态
+struct CPUDrawState {
+    const CPUPipelineState* pipeline = nullptr;
+    const CPUDescriptorSet* descriptorSets[kCPUMaxDescriptorSets] = {};
+    uint32_t dynamicOffsets[kCPUMaxDescriptorSets][kCPUMaxDynamicOffsets] = {};
+    const NullBufferView* vertexBuffers[kCPUMaxVertexBuffers] = {};
+    const NullBufferView* indexBuffer = nullptr;
+    uint8_t pushConstants[kCPUMaxPushConstantSize] = {};
+    Viewport viewport = {};
+    Scissor scissor = {};
+    bool hasViewport = false;
+    bool hasScissor = false;
+
+    CPURenderTarget colorTargets[kCPUMaxColorTargets] = {};
+    uint32_t colorTargetCount = 0;
+    CPURenderTarget depthTarget = {};
+    bool hasDepthTarget = false;
+    uint32_t targetWidth = 0;
+    uint32_t targetHeight = 0;
+};
+
+// 分块SIMD三角形光栅化器
+// 每次绘制：并行执行顶点着色 -> 串行三角形建立与分块 -> 按分块并行光栅化与像素着色。
+// 分块之间像素不重叠，块内按三角形提交顺序处理，因此结果是确定的。
+// 临时数组在多次绘制之间复用，稳定状态下不分配内存。
+class CPURasterizer {
+public:
+    // 执行一次绘制的一个实例
+    // indices为nullptr时顶点索引为firstVertex + i
+    void DrawInstance(
+        WorkerPool& pool,
+        const CPUDrawState& state,
+        uint32_t vertexCount,
+        uint32_t firstVertex,
+        const uint8_t* indices,
+        uint32_t indexSize,
+        int32_t vertexOffset,
+        uint32_t instanceIndex) {
+        const CPUPipelineState* pipeline = state.pipeline;
+        const CPUShader* vertexShader = pipeline->GetVertexShader();
+        CPUResourceContext resources(state.descriptorSets, state.dynamicOffsets, state.pushConstants);
+        m_varyingCount = std::min(vertexShader->GetVaryingCount(), kCPUMaxVaryings);
+
+        // 顶点着色
+        uint32_t triangleVertexCount = vertexCount - vertexCount % 3;
+        m_vertices.resize(triangleVertexCount);
+        constexpr uint32_t kVertexChunk = 256;
+        uint32_t chunkCount = (triangleVertexCount + kVertexChunk - 1) / kVertexChunk;
+        pool.ParallelFor(chunkCount, [&](uint32_t chunk) {
+            CPUVertexInput input = {};
+            input.resources = &resources;
+            input.instanceIndex = instanceIndex;
+            uint32_t end = std::min((chunk + 1) * kVertexChunk, triangleVertexCount);
+            for (uint32_t i = chunk * kVertexChunk; i < end; ++i) {
+                uint32_t index = firstVertex + i;
+                if (indices != nullptr) {
+                    index = indexSize == 2
+                        ? reinterpret_cast<const uint16_t*>(indices)[i]
+                        : reinterpret_cast<const uint32_t*>(indices)[i];
+                    index = static_cast<uint32_t>(static_cast<int64_t>(index) + vertexOffset);
+                }
+                input.vertexIndex = index;
+                FetchVertexData(state, index, instanceIndex, input);
+                vertexShader->GetVertexFunc()(input, m_vertices[i]);
+            }
+        });
+
+        // 三角形建立与分块
+        SetupTriangles(state, triangleVertexCount / 3);
+        if (m_triangles.empty()) {
+            return;
+        }
+
+        // 按分块并行光栅化
+        pool.ParallelFor(static_cast<uint32_t>(m_activeTiles.size()), [&](uint32_t i) {
+            RasterizeTile(state, resources, m_activeTiles[i]);
+        });
+    }
+
+private:
+    // 建立完成的三角形
+    struct Triangle {
+        float edgeA[3];         // 边函数x系数（对边，指向内部）
+        float edgeB[3];         // 边函数y系数
+        float edgeX[3];         // 边的参考点
+        float edgeY[3];
+        bool topLeft[3];        // 是否为上/左边（边上的像素归属此三角形）
+        float invArea;          // 1/面积
+        float z[3];             // 顶点深度
+        float invW[3];          // 顶点1/w
+        uint32_t vertex[3];     // 顶点输出索引
+        int32_t minX, minY, maxX, maxY;  // 包围盒（像素，闭区间）
+    };
+
+    void FetchVertexData(const CPUDrawState& state, uint32_t vertexIndex, uint32_t instanceIndex,
+        CPUVertexInput& input) const {
+        const std::vector<VertexBinding>& bindings = state.pipeline->GetVertexBindings();
+        for (uint32_t slot = 0; slot < kCPUMaxVertexBuffers; ++slot) {
+            const NullBufferView* view = state.vertexBuffers[slot];
+            if (view == nullptr || view->buffer->GetStorage() == nullptr) {
+                input.vertexData[slot] = nullptr;
+                continue;
+            }
+            size_t stride = view->desc.stride;
+            bool perInstance = false;
+            for (const VertexBinding& binding : bindings) {
+                if (binding.binding == slot) {
+                    stride = binding.stride;
+                    perInstance = binding.instanceDivisor;
+                    break;
+                }
+            }
+            size_t element = perInstance ? instanceIndex : vertexIndex;
+            input.vertexData[slot] = view->buffer->GetStorage() + view->desc.offset + element * stride;
+        }
+    }
+
+    void SetupTriangles(const CPUDrawState& state, uint32_t triangleCount) {
+        const RasterizationState& raster = state.pipeline->GetRasterizationState();
+
+        Viewport viewport = state.viewport;
+        if (!state.hasViewport) {
+            viewport = {0.0f, 0.0f, static_cast<float>(state.targetWidth),
+                static_cast<float>(state.targetHeight), 0.0f, 1.0f};
+        }
+
+        // 可绘制区域：渲染目标 ∩ 视口 ∩ 裁剪矩形
+        int32_t clipMinX = std::max(0, static_cast<int32_t>(std::floor(viewport.x)));
+        int32_t clipMinY = std::max(0, static_cast<int32_t>(std::floor(viewport.y)));
+        int32_t clipMaxX = std::min(static_cast<int32_t>(state.targetWidth),
+            static_cast<int32_t>(std::ceil(viewport.x + viewport.width))) - 1;
+        int32_t clipMaxY = std::min(static_cast<int32_t>(state.targetHeight),
+            static_cast<int32_t>(std::ceil(viewport.y + viewport.height))) - 1;
+        if (state.hasScissor) {
+            clipMinX = std::max(clipMinX, state.scissor.x);
+            clipMinY = std::max(clipMinY, state.scissor.y);
+            clipMaxX = std::min(clipMaxX, state.scissor.x + static_cast<int32_t>(state.scissor.width) - 1);
+            clipMaxY = std::min(clipMaxY, state.scissor.y + static_cast<int32_t>(state.scissor.height) - 1);
+        }
+
+        m_tilesX = (state.targetWidth + kCPUTileSize - 1) / kCPUTileSize;
+        m_tilesY = (state.targetHeight + kCPUTileSize - 1) / kCPUTileSize;
+        m_bins.resize(static_cast<size_t>(m_tilesX) * m_tilesY);
+        for (auto& bin : m_bins) {
+            bin.clear();
+        }
+        m_triangles.clear();
+        m_activeTiles.clear();
+        if (clipMinX > clipMaxX || clipMinY > clipMaxY) {
+            return;
+        }
+
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            Triangle triangle;
+            float x[3];
+            float y[3];
+            bool visible = true;
+            for (uint32_t k = 0; k < 3; ++k) {
+                const CPUVertexOutput& vertex = m_vertices[t * 3 + k];
+                float w = vertex.position[3];
+                if (!(w > 1e-6f)) {
+                    visible = false;
+                    break;
+                }
+                float invW = 1.0f / w;
+                float ndcX = vertex.position[0] * invW;
+                float ndcY = vertex.position[1] * invW;
+                float ndcZ = vertex.position[2] * invW;
+                x[k] = viewport.x + (ndcX + 1.0f) * 0.5f * viewport.width;
+                y[k] = viewport.y + (1.0f - ndcY) * 0.5f * viewport.height;
+                triangle.z[k] = viewport.minDepth + ndcZ * (viewport.maxDepth - viewport.minDepth);
+                triangle.invW[k] = invW;
+                triangle.vertex[k] = t * 3 + k;
+            }
+            if (!visible) {
+                continue;
+            }
+
+            // 屏幕空间（y向下）中面积为负表示NDC中逆时针
+            float area = (x[2] - x[1]) * (y[0] - y[1]) - (y[2] - y[1]) * (x[0] - x[1]);
+            if (area == 0.0f) {
+                continue;
+            }
+            bool counterClockwise = area < 0.0f;
+            bool front = raster.frontFace == RasterizationState::FrontFace::CounterClockwise
+                ? counterClockwise : !counterClockwise;
+            if ((raster.cullMode == RasterizationState::CullMode::Back && !front) ||
+                (raster.cullMode == RasterizationState::CullMode::Front && front)) {
+                continue;
+            }
+
+            // 边函数：第k条边为顶点k的对边，统一方向使内部为正
+            float sign = area > 0.0f ? 1.0f : -1.0f;
+            for (uint32_t k = 0; k < 3; ++k) {
+                uint32_t a = (k + 1) % 3;
+                uint32_t b = (k + 2) % 3;
+                triangle.edgeA[k] = (y[a] - y[b]) * sign;
+                triangle.edgeB[k] = (x[b] - x[a]) * sign;
+                triangle.edgeX[k] = x[a];
+                triangle.edgeY[k] = y[a];
+                triangle.topLeft[k] = triangle.edgeA[k] > 0.0f ||
+                    (triangle.edgeA[k] == 0.0f && triangle.edgeB[k] > 0.0f);
+            }
+            triangle.invArea = 1.0f / (area * sign);
+
+            float minX = std::min({x[0], x[1], x[2]});
+            float minY = std::min({y[0], y[1], y[2]});
+            float maxX = std::max({x[0], x[1], x[2]});
+            float maxY = std::max({y[0], y[1], y[2]});
+            triangle.minX = std::max(clipMinX, static_cast<int32_t>(std::floor(minX)));
+            triangle.minY = std::max(clipMinY, static_cast<int32_t>(std::floor(minY)));
+            triangle.maxX = std::min(clipMaxX, static_cast<int32_t>(std::ceil(maxX)));
+            triangle.maxY = std::min(clipMaxY, static_cast<int32_t>(std::ceil(maxY)));
+            if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+                continue;
+            }
+
+            uint32_t index = static_cast<uint32_t>(m_triangles.size());
+            m_triangles.push_back(triangle);
+            for (int32_t ty = triangle.minY / kCPUTileSize; ty <= triangle.maxY / static_cast<int32_t>(kCPUTileSize); ++ty) {
+                for (int32_t tx = triangle.minX / kCPUTileSize; tx <= triangle.maxX / static_cast<int32_t>(kCPUTileSize); ++tx) {
+                    auto& bin = m_bins[static_cast<size_t>(ty) * m_tilesX + tx];
+                    if (bin.empty()) {
+                        m_activeTiles.push_back(static_cast<uint32_t>(ty) * m_tilesX + tx);
+                    }
+                    bin.push_back(index);
+                }
+            }
+        }
+    }
+
+    // 计算一行中4个连续像素的覆盖掩码，edges输出每条边在4个像素上的边函数值
+    static uint32_t CoverageMask4(const Triangle& triangle, int32_t x, int32_t y, float edges[3][4]) {
+        float py = static_cast<float>(y) + 0.5f;
+#if defined(RHI_CPU_SSE2)
+        __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x) + 0.5f), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+        __m128 zero = _mm_setzero_ps();
+        uint32_t mask = 0xF;
+        for (uint32_t k = 0; k < 3; ++k) {
+            __m128 dx = _mm_sub_ps(px, _mm_set1_ps(triangle.edgeX[k]));
+            float dy = (py - triangle.edgeY[k]) * triangle.edgeB[k];
+            __m128 e = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.edgeA[k]), dx), _mm_set1_ps(dy));
+            _mm_storeu_ps(edges[k], e);
+            __m128 inside = triangle.topLeft[k] ? _mm_cmpge_ps(e, zero) : _mm_cmpgt_ps(e, zero);
+            mask &= static_cast<uint32_t>(_mm_movemask_ps(inside));
+        }
+        return mask;
+#else
+        uint32_t mask = 0;
+        for (uint32_t lane = 0; lane < 4; ++lane) {
+            float px = static_cast<float>(x + static_cast<int32_t>(lane)) + 0.5f;
+            bool inside = true;
+            for (uint32_t k = 0; k < 3; ++k) {
+                float e = triangle.edgeA[k] * (px - triangle.edgeX[k]) +
+                    triangle.edgeB[k] * (py - triangle.edgeY[k]);
+                edges[k][lane] = e;
+                inside = inside && (triangle.topLeft[k] ? e >= 0.0f : e > 0.0f);
+            }
+            mask |= inside ? (1u << lane) : 0u;
+        }
+        return mask;
+#endif
+    }
+
+    void RasterizeTile(const CPUDrawState& state, const CPUResourceContext& resources, uint32_t tile) {
+        int32_t tileMinX = static_cast<int32_t>((tile % m_tilesX) * kCPUTileSize);
+        int32_t tileMinY = static_cast<int32_t>((tile / m_tilesX) * kCPUTileSize);
+        int32_t tileMaxX = tileMinX + static_cast<int32_t>(kCPUTileSize) - 1;
+        int32_t tileMaxY = tileMinY + static_cast<int32_t>(kCPUTileSize) - 1;
+
+        for (uint32_t index : m_bins[tile]) {
+            const Triangle& triangle = m_triangles[index];
+            int32_t minX = std::max(triangle.minX, tileMinX);
+            int32_t minY = std::max(triangle.minY, tileMinY);
+            int32_t maxX = std::min(triangle.maxX, tileMaxX);
+            int32_t maxY = std::min(triangle.maxY, tileMaxY);
+
+            for (int32_t y = minY; y <= maxY; ++y) {
+                for (int32_t x = minX; x <= maxX; x += 4) {
+                    float edges[3][4];
+                    uint32_t mask = CoverageMask4(triangle, x, y, edges);
+                    int32_t remaining = maxX - x + 1;
+                    if (remaining < 4) {
+                        mask &= (1u << remaining) - 1;
+                    }
+                    while (mask != 0) {
+                        uint32_t lane = 0;
+                        while ((mask & (1u << lane)) == 0) {
+                            ++lane;
+                        }
+                        mask &= ~(1u << lane);
+                        float weights[3] = {
+                            edges[0][lane] * triangle.invArea,
+                            edges[1][lane] * triangle.invArea,
+                            edges[2][lane] * triangle.invArea,
+                        };
+                        ShadePixel(state, resources, triangle, weights, x + static_cast<int32_t>(lane), y);
+                    }
+                }
+            }
+        }
+    }
+
+    // weights为像素中心的屏幕空间重心坐标
+    void ShadePixel(const CPUDrawState& state, const CPUResourceContext& resources,
+        const Triangle& triangle, const float weights[3], int32_t x, int32_t y) {
+        float px = static_cast<float>(x) + 0.5f;
+        float py = static_cast<float>(y) + 0.5f;
+        float depth = weights[0] * triangle.z[0] + weights[1] * triangle.z[1] + weights[2] * triangle.z[2];
+
+        const DepthStencilState& depthState = state.pipeline->GetDepthStencilState();
+        float* depthPixel = nullptr;
+        if (state.hasDepthTarget) {
+            depthPixel = reinterpret_cast<float*>(
+                state.depthTarget.data + static_cast<size_t>(y) * state.depthTarget.rowPitch) + x;
+            if (depthState.depthTestEnable && !CPUCompareDepth(depthState.depthCompareOp, depth, *depthPixel)) {
+                return;
+            }
+        }
+
+        const CPUShader* pixelShader = state.pipeline->GetPixelShader();
+        if (pixelShader != nullptr && state.colorTargetCount > 0) {
+            CPUPixelInput input;
+            input.resources = &resources;
+            float invW = weights[0] * triangle.invW[0] + weights[1] * triangle.invW[1] +
+                weights[2] * triangle.invW[2];
+            float w = 1.0f / invW;
+            input.position[0] = px;
+            input.position[1] = py;
+            input.position[2] = depth;
+            input.position[3] = invW;
+
+            const CPUVertexOutput& v0 = m_vertices[triangle.vertex[0]];
+            const CPUVertexOutput& v1 = m_vertices[triangle.vertex[1]];
+            const CPUVertexOutput& v2 = m_vertices[triangle.vertex[2]];
+            float p0 = weights[0] * triangle.invW[0] * w;
+            float p1 = weights[1] * triangle.invW[1] * w;
+            float p2 = weights[2] * triangle.invW[2] * w;
+            for (uint32_t i = 0; i < m_varyingCount; ++i) {
+                input.varyings[i] = p0 * v0.varyings[i] + p1 * v1.varyings[i] + p2 * v2.varyings[i];
+            }
+
+            CPUPixelOutput output;
+            if (!pixelShader->GetPixelFunc()(input, output)) {
+                return;
+            }
+            for (uint32_t i = 0; i < state.colorTargetCount; ++i) {
+                const CPURenderTarget& target = state.colorTargets[i];
+                CPUStoreColor(target.data + static_cast<size_t>(y) * target.rowPitch +
+                    static_cast<size_t>(x) * target.pixelSize, target.format, output.color[i]);
+            }
+        }
+
+        if (depthPixel != nullptr && depthState.depthWriteEnable) {
+            *depthPixel = depth;
+        }
+    }
+
+    std::vector<CPUVertexOutput> m_vertices;
+    std::vector<Triangle> m_triangles;
+    std::vector<std::vector<uint32_t>> m_bins;
+    std::vector<uint32_t> m_activeTiles;
+    uint32_t m_tilesX = 0;
+    uint32_t m_tilesY = 0;
+    uint32_t m_varyingCount = 0;
+};
+
+// 命令执行器（每个队列一个）
+class CPUCommandExecutor {
+public:
+    explicit CPUCommandExecutor(WorkerPool& pool)
+        : m_pool(pool) {}
+
+    // 执行一级命令缓冲区（绑定状态从空开始）
+    Result<void> Execute(const CPUCommandBuffer& commandBuffer) {
+        m_state = CPUDrawState();
+        return ExecuteCommands(commandBuffer);
+    }
+
+private:
+    Result<void> ExecuteCommands(const CPUCommandBuffer& commandBuffer) {
+        for (const CPUCommand& command : commandBuffer.GetCommands()) {
+            const void* data = commandBuffer.GetData(command);
+            switch (command.type) {
+                case CPUCommandType::BeginRenderPass:
+                    RHI_RETURN_IF_FAILED(BeginRenderPass(command, static_cast<void* const*>(data)));
+                    break;
+                case CPUCommandType::EndRenderPass:
+                    m_state.colorTargetCount = 0;
+                    m_state.hasDepthTarget = false;
+                    break;
+                case CPUCommandType::SetViewport:
+                    std::memcpy(&m_state.viewport, data, sizeof(Viewport));
+                    m_state.hasViewport = true;
+                    break;
+                case CPUCommandType::SetScissor:
+                    std::memcpy(&m_state.scissor, data, sizeof(Scissor));
+                    m_state.hasScissor = true;
+                    break;
+                case CPUCommandType::SetPipelineState:
+                    m_state.pipeline = static_cast<const CPUPipelineState*>(
+                        static_cast<IPipelineState*>(command.objects[0]));
+                    break;
+                case CPUCommandType::SetDescriptorSet:
+                    m_state.descriptorSets[command.args[0]] = static_cast<const CPUDescriptorSet*>(
+                        static_cast<IDescriptorSet*>(command.objects[0]));
+                    if (data != nullptr) {
+                        std::memcpy(m_state.dynamicOffsets[command.args[0]], data, command.args[1] * sizeof(uint32_t));
+                    }
+                    break;
+                case CPUCommandType::SetVertexBuffer:
+                    m_state.vertexBuffers[command.args[0]] = static_cast<const NullBufferView*>(command.objects[0]);
+                    break;
+                case CPUCommandType::SetIndexBuffer:
+                    m_state.indexBuffer = static_cast<const NullBufferView*>(command.objects[0]);
+                    break;
+                case CPUCommandType::PushConstants:
+                    if (data != nullptr) {
+                        std::memcpy(m_state.pushConstants + command.args[0], data, command.dataSize);
+                    }
+                    break;
+                case CPUCommandType::Draw:
+                    RHI_RETURN_IF_FAILED(Draw(command.args[0], command.args[1], command.args[2], command.args[3]));
+                    break;
+                case CPUCommandType::DrawIndexed:
+                    RHI_RETURN_IF_FAILED(DrawIndexed(command.args[0], command.args[1], command.args[2],
+                        static_cast<int32_t>(command.args[3]), command.args[4]));
+                    break;
+                case CPUCommandType::DrawIndirect:
+                    RHI_RETURN_IF_FAILED(DrawIndirect(command));
+                    break;
+                case CPUCommandType::Dispatch:
+                    RHI_RETURN_IF_FAILED(Dispatch(command.args[0], command.args[1], command.args[2]));
+                    break;
+                case CPUCommandType::DispatchIndirect:
+                    RHI_RETURN_IF_FAILED(DispatchIndirect(command));
+                    break;
+                case CPUCommandType::CopyBuffer:
+                    RHI_RETURN_IF_FAILED(CopyBuffer(command, static_cast<const BufferCopyRegion*>(data)));
+                    break;
+                case CPUCommandType::CopyTexture:
+                    RHI_RETURN_IF_FAILED(CopyTexture(command, static_cast<const TextureCopyRegion*>(data)));
+                    break;
+                case CPUCommandType::CopyBufferToTexture:
+                    RHI_RETURN_IF_FAILED(CopyBufferToTexture(command, static_cast<const BufferTextureCopyRegion*>(data)));
+                    break;
+                case CPUCommandType::ResourceBarrier:
+                    // 每条命令结束时工作线程已汇合，所有写入对后续命令可见
+                    break;
+                case CPUCommandType::ExecuteBundle:
+                    RHI_RETURN_IF_FAILED(ExecuteCommands(*static_cast<const CPUCommandBuffer*>(
+                        static_cast<ICommandBuffer*>(command.objects[0]))));
+                    break;
+            }
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> BeginRenderPass(const CPUCommand& command, void* const* colorViews) {
+        m_state.colorTargetCount = command.args[0];
+        m_state.targetWidth = UINT32_MAX;
+        m_state.targetHeight = UINT32_MAX;
+        for (uint32_t i = 0; i < m_state.colorTargetCount; ++i) {
+            RHI_RETURN_IF_FAILED(ResolveTarget(static_cast<const NullTextureView*>(colorViews[i]),
+                m_state.colorTargets[i]));
+            RHI_RETURN_IF_FALSE(IsCPURenderTargetFormat(m_state.colorTargets[i].format),
+                ErrorCode::NotImplemented,
+                "CPU后端不支持此颜色附件格式: " +
+                std::to_string(static_cast<int>(m_state.colorTargets[i].format)));
+        }
+        m_state.hasDepthTarget = command.objects[0] != nullptr;
+        if (m_state.hasDepthTarget) {
+            RHI_RETURN_IF_FAILED(ResolveTarget(static_cast<const NullTextureView*>(command.objects[0]),
+                m_state.depthTarget));
+            RHI_RETURN_IF_FALSE(m_state.depthTarget.format == Format::D32_FLOAT,
+                ErrorCode::NotImplemented,
+                "CPU后端的深度附件须为D32_FLOAT");
+        }
+        if (m_state.targetWidth == UINT32_MAX) {
+            m_state.targetWidth = 0;
+            m_state.targetHeight = 0;
+        }
+        return MakeSuccessResult();
+    }
+
+    // 解析附件视图，渲染区域取所有附件的最小尺寸
+    Result<void> ResolveTarget(const NullTextureView* view, CPURenderTarget& target) {
+        RHI_RETURN_IF_FALSE(view != nullptr, ErrorCode::InvalidArgument, "附件视图不能为空");
+        CPUTexture* texture = static_cast<CPUTexture*>(view->texture);
+        const TextureDesc& desc = texture->GetDesc();
+        uint32_t mip = view->range.baseMipLevel;
+        target.data = texture->GetSubresourceData(mip, view->range.baseArrayLayer);
+        target.rowPitch = texture->GetLayout(mip, view->range.baseArrayLayer).rowPitch;
+        target.pixelSize = GetFormatBlockSize(desc.format);
+        target.format = desc.format;
+        m_state.targetWidth = std::min(m_state.targetWidth, std::max(desc.width >> mip, 1u));
+        m_state.targetHeight = std::min(m_state.targetHeight, std::max(desc.height >> mip, 1u));
+        return MakeSuccessResult();
+    }
+
+    Result<void> ValidateGraphicsState() const {
+        RHI_RETURN_IF_FALSE(m_state.pipeline != nullptr &&
+            m_state.pipeline->GetType() == PipelineType::Graphics &&
+            m_state.pipeline->GetVertexShader() != nullptr,
+            ErrorCode::InvalidOperation,
+            "绘制前须绑定带顶点着色器的图形管线");
+        RHI_RETURN_IF_FALSE(m_state.targetWidth > 0 && m_state.targetHeight > 0,
+            ErrorCode::InvalidOperation,
+            "绘制须在带附件的渲染通道内进行");
+        return MakeSuccessResult();
+    }
+
+    Result<void> Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+        RHI_RETURN_IF_FAILED(ValidateGraphicsState());
+        for (uint32_t instance = 0; instance < instanceCount; ++instance) {
+            m_rasterizer.DrawInstance(m_pool, m_state, vertexCount, firstVertex,
+                nullptr, 0, 0, firstInstance + instance);
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+        int32_t vertexOffset, uint32_t firstInstance) {
+        RHI_RETURN_IF_FAILED(ValidateGraphicsState());
+        const NullBufferView* view = m_state.indexBuffer;
+        RHI_RETURN_IF_FALSE(view != nullptr && view->buffer->GetStorage() != nullptr,
+            ErrorCode::InvalidOperation,
+            "索引绘制前须绑定索引缓冲区");
+        uint32_t indexSize = view->desc.stride == 2 ? 2 : 4;
+        RHI_RETURN_IF_FALSE((static_cast<size_t>(firstIndex) + indexCount) * indexSize <= view->desc.size,
+            ErrorCode::InvalidArgument,
+            "索引范围超出索引缓冲区视图");
+        const uint8_t* indices = view->buffer->GetStorage() + view->desc.offset +
+            static_cast<size_t>(firstIndex) * indexSize;
+        for (uint32_t instance = 0; instance < instanceCount; ++instance) {
+            m_rasterizer.DrawInstance(m_pool, m_state, indexCount, 0,
+                indices, indexSize, vertexOffset, firstInstance + instance);
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> DrawIndirect(const CPUCommand& command) {
+        NullBuffer* buffer = static_cast<NullBuffer*>(static_cast<IBuffer*>(command.objects[0]));
+        uint32_t stride = command.args[2] != 0 ? command.args[2] : sizeof(DrawIndirectArgs);
+        for (uint32_t i = 0; i < command.args[1]; ++i) {
+            size_t offset = command.args[0] + static_cast<size_t>(i) * stride;
+            RHI_RETURN_IF_FALSE(offset + sizeof(DrawIndirectArgs) <= buffer->GetDesc().size,
+                ErrorCode::InvalidArgument,
+                "间接绘制参数超出缓冲区");
+            DrawIndirectArgs args;
+            std::memcpy(&args, buffer->GetStorage() + offset, sizeof(args));
+            RHI_RETURN_IF_FAILED(Draw(args.vertexCount, args.instanceCount, args.firstVertex, args.firstInstance));
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+        RHI_RETURN_IF_FALSE(m_state.pipeline != nullptr &&
+            m_state.pipeline->GetType() == PipelineType::Compute &&
+            m_state.pipeline->GetComputeShader() != nullptr,
+            ErrorCode::InvalidOperation,
+            "调度前须绑定带计算内核的计算管线");
+
+        const CPUComputeKernelFunc& kernel = m_state.pipeline->GetComputeShader()->GetComputeFunc();
+        CPUResourceContext resources(m_state.descriptorSets, m_state.dynamicOffsets, m_state.pushConstants);
+        uint64_t total = static_cast<uint64_t>(groupCountX) * groupCountY * groupCountZ;
+        RHI_RETURN_IF_FALSE(total <= UINT32_MAX,
+            ErrorCode::InvalidArgument,
+            "线程组总数过大");
+
+        m_pool.ParallelFor(static_cast<uint32_t>(total), [&](uint32_t index) {
+            CPUComputeInput input;
+            input.resources = &resources;
+            input.groupId[0] = index % groupCountX;
+            input.groupId[1] = (index / groupCountX) % groupCountY;
+            input.groupId[2] = index / (groupCountX * groupCountY);
+            input.groupCount[0] = groupCountX;
+            input.groupCount[1] = groupCountY;
+            input.groupCount[2] = groupCountZ;
+            kernel(input);
+        });
+        return MakeSuccessResult();
+    }
+
+    Result<void> DispatchIndirect(const CPUCommand& command) {
+        NullBuffer* buffer = static_cast<NullBuffer*>(static_cast<IBuffer*>(command.objects[0]));
+        RHI_RETURN_IF_FALSE(command.args[0] + sizeof(DispatchIndirectArgs) <= buffer->GetDesc().size,
+            ErrorCode::InvalidArgument,
+            "间接调度参数超出缓冲区");
+        DispatchIndirectArgs args;
+        std::memcpy(&args, buffer->GetStorage() + command.args[0], sizeof(args));
+        return Dispatch(args.groupCountX, args.groupCountY, args.groupCountZ);
+    }
+
+    Result<void> CopyBuffer(const CPUCommand& command, const BufferCopyRegion* regions) {
+        NullBuffer* src = static_cast<NullBuffer*>(static_cast<IBuffer*>(command.objects[0]));
+        NullBuffer* dst = static_cast<NullBuffer*>(static_cast<IBuffer*>(command.objects[1]));
+        BufferCopyRegion whole = {0, 0, std::min(src->GetDesc().size, dst->GetDesc().size)};
+        uint32_t regionCount = command.args[0];
+        if (regionCount == 0) {
+            regions = &whole;
+            regionCount = 1;
+        }
+        for (uint32_t i = 0; i < regionCount; ++i) {
+            RHI_RETURN_IF_FALSE(regions[i].srcOffset + regions[i].size <= src->GetDesc().size &&
+                regions[i].dstOffset + regions[i].size <= dst->GetDesc().size,
+                ErrorCode::InvalidArgument,
+                "缓冲区复制区域越界");
+        }
+
+        // 按1MB分片并行复制
+        constexpr size_t kChunk = 1 << 20;
+        for (uint32_t i = 0; i < regionCount; ++i) {
+            const BufferCopyRegion& region = regions[i];
+            uint32_t chunkCount = static_cast<uint32_t>((region.size + kChunk - 1) / kChunk);
+            m_pool.ParallelFor(chunkCount, [&](uint32_t chunk) {
+                size_t begin = chunk * kChunk;
+                size_t size = std::min(kChunk, region.size - begin);
+                std::memmove(dst->GetStorage() + region.dstOffset + begin,
+                    src->GetStorage() + region.srcOffset + begin, size);
+            });
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> CopyTexture(const CPUCommand& command, const TextureCopyRegion* regions) {
+        CPUTexture* src = static_cast<CPUTexture*>(static_cast<ITexture*>(command.objects[0]));
+        CPUTexture* dst = static_cast<CPUTexture*>(static_cast<ITexture*>(command.objects[1]));
+        RHI_RETURN_IF_FALSE(GetFormatBlockSize(src->GetDesc().format) == GetFormatBlockSize(dst->GetDesc().format),
+            ErrorCode::InvalidArgument,
+            "纹理复制的源与目标格式大小不一致");
+
+        uint32_t blockSize = GetFormatBlockSize(src->GetDesc().format);
+        uint32_t block = GetFormatBlockDimension(src->GetDesc().format);
+        for (uint32_t i = 0; i < command.args[0]; ++i) {
+            RHI_RETURN_IF_FALSE(src->IsCopyRegionValid(regions[i].srcMipLevel, regions[i].srcArrayLayer,
+                    regions[i].srcOffset, regions[i].extent) &&
+                dst->IsCopyRegionValid(regions[i].dstMipLevel, regions[i].dstArrayLayer,
+                    regions[i].dstOffset, regions[i].extent),
+                ErrorCode::InvalidArgument,
+                "纹理复制区域越界");
+        }
+
+        for (uint32_t i = 0; i < command.args[0]; ++i) {
+            const TextureCopyRegion& region = regions[i];
+            TextureDataLayout srcLayout = src->GetLayout(region.srcMipLevel, region.srcArrayLayer);
+            TextureDataLayout dstLayout = dst->GetLayout(region.dstMipLevel, region.dstArrayLayer);
+            uint32_t rows = (region.extent[1] + block - 1) / block;
+            size_t rowBytes = static_cast<size_t>((region.extent[0] + block - 1) / block) * blockSize;
+            uint32_t depth = std::max(region.extent[2], 1u);
+
+            // 每行为一个并行任务
+            m_pool.ParallelFor(rows * depth, [&](uint32_t item) {
+                uint32_t row = item % rows;
+                uint32_t z = item / rows;
+                const uint8_t* from = src->GetStorage() + srcLayout.offset +
+                    (region.srcOffset[2] + z) * srcLayout.depthPitch +
+                    (region.srcOffset[1] / block + row) * srcLayout.rowPitch +
+                    (region.srcOffset[0] / block) * blockSize;
+                uint8_t* to = dst->GetStorage() + dstLayout.offset +
+                    (region.dstOffset[2] + z) * dstLayout.depthPitch +
+                    (region.dstOffset[1] / block + row) * dstLayout.rowPitch +
+                    (region.dstOffset[0] / block) * blockSize;
+                std::memmove(to, from, rowBytes);
+            });
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> CopyBufferToTexture(const CPUCommand& command, const BufferTextureCopyRegion* regions) {
+        NullBuffer* src = static_cast<NullBuffer*>(static_cast<IBuffer*>(command.objects[0]));
+        CPUTexture* dst = static_cast<CPUTexture*>(static_cast<ITexture*>(command.objects[1]));
+        RHI_RETURN_IF_FALSE(src->GetStorage() != nullptr,
+            ErrorCode::InvalidArgument,
+            "复制源缓冲区没有主机存储");
+
+        uint32_t blockSize = GetFormatBlockSize(dst->GetDesc().format);
+        uint32_t block = GetFormatBlockDimension(dst->GetDesc().format);
+        for (uint32_t i = 0; i < command.args[0]; ++i) {
+            const BufferTextureCopyRegion& region = regions[i];
+            RHI_RETURN_IF_FALSE(dst->IsCopyRegionValid(region.mipLevel, region.arrayLayer, region.offset, region.extent),
+                ErrorCode::InvalidArgument,
+                "缓冲区到纹理的复制区域超出目标纹理");
+            TextureDataLayout dstLayout = dst->GetLayout(region.mipLevel, region.arrayLayer);
+            uint32_t rows = (region.extent[1] + block - 1) / block;
+            size_t rowBytes = static_cast<size_t>((region.extent[0] + block - 1) / block) * blockSize;
+            uint32_t depth = std::max(region.extent[2], 1u);
+            size_t rowPitch = region.bufferRowPitch != 0 ? region.bufferRowPitch : rowBytes;
+            size_t slicePitch = region.bufferSlicePitch != 0 ? region.bufferSlicePitch : rowPitch * rows;
+            RHI_RETURN_IF_FALSE(region.bufferOffset + slicePitch * (depth - 1) + rowPitch * (rows - 1) + rowBytes <=
+                src->GetDesc().size,
+                ErrorCode::InvalidArgument,
+                "缓冲区到纹理的复制区域超出源缓冲区");
+
+            // 小区域（上传的常见情况）直接在调用线程上复制
+            auto copyRow = [&](uint32_t item) {
+                uint32_t row = item % rows;
+                uint32_t z = item / rows;
+                const uint8_t* from = src->GetStorage() + region.bufferOffset + z * slicePitch + row * rowPitch;
+                uint8_t* to = dst->GetStorage() + dstLayout.offset +
+                    (region.offset[2] + z) * dstLayout.depthPitch +
+                    (region.offset[1] / block + row) * dstLayout.rowPitch +
+                    (region.offset[0] / block) * blockSize;
+                std::memcpy(to, from, rowBytes);
+            };
+            if (rowBytes * rows * depth < kCPUParallelCopyThreshold) {
+                for (uint32_t item = 0; item < rows * depth; ++item) {
+                    copyRow(item);
+                }
+            } else {
+                m_pool.ParallelFor(rows * depth, copyRow);
+            }
+        }
+        return MakeSuccessResult();
+    }
+
+    WorkerPool& m_pool;
+    CPUDrawState m_state;
+    CPURasterizer m_rasterizer;
+};
+
+// CPU队列
+// Submit在调用线程上依次执行命令缓冲区，每条命令内部由工作线程池并行处理
+class CPUQueue : public NullQueue {
+public:
+    CPUQueue(const QueueDesc& desc, WorkerPool& pool)
+        : NullQueue(desc)
+        , m_executor(pool) {}
+
+    Result<void> Submit(
+        const std::vector<ICommandBuffer*>& commandBuffers,
+        const std::vector<ISemaphore*>& waitSemaphores,
+        const std::vector<ISemaphore*>& signalSemaphores,
+        IFence* fence) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (ICommandBuffer* commandBuffer : commandBuffers) {
+            RHI_RETURN_IF_FALSE(commandBuffer != nullptr &&
+                static_cast<CPUCommandBuffer*>(commandBuffer)->GetState() == NullCommandBufferState::Executable,
+                ErrorCode::InvalidOperation,
+                "命令缓冲区未结束录制");
+            RHI_RETURN_IF_FAILED(m_executor.Execute(*static_cast<CPUCommandBuffer*>(commandBuffer)));
+        }
+        return NullQueue::Submit(commandBuffers, waitSemaphores, signalSemaphores, fence);
+    }
+
+    Result<void> SubmitBatch(
+        Span<const SubmitDesc> submits,
+        IFence* fence) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 整批检查通过后才执行命令，执行完毕再发出信号
+        RHI_RETURN_IF_FAILED(ValidateBatch(submits, fence));
+        for (const SubmitDesc& submit : submits) {
+            for (ICommandBuffer* commandBuffer : submit.commandBuffers) {
+                RHI_RETURN_IF_FALSE(commandBuffer != nullptr &&
+                    static_cast<CPUCommandBuffer*>(commandBuffer)->GetState() == NullCommandBufferState::Executable,
+                    ErrorCode::InvalidOperation,
+                    "命令缓冲区未结束录制");
+            }
+        }
+        for (const SubmitDesc& submit : submits) {
+            for (ICommandBuffer* commandBuffer : submit.commandBuffers) {
+                RHI_RETURN_IF_FAILED(m_executor.Execute(*static_cast<CPUCommandBuffer*>(commandBuffer)));
+            }
+        }
+        return CommitBatch(submits, fence);
+    }
+
+private:
+    std::mutex m_mutex;
+    CPUCommandExecutor m_executor;
+};
+
+// CPU命令池
+class CPUCommandPool : public NullCommandPool {
+public:
+    explicit CPUCommandPool(const CommandPoolDesc& desc)
+        : NullCommandPool(desc) {}
+
+protected:
+    std::unique_ptr<NullCommandBuffer> CreateCommandBuffer(const CommandBufferDesc& desc) override {
+        return std::make_unique<CPUCommandBuffer>(desc);
+    }
+};
+
+// CPU描述符池
+class CPUDescriptorPool : public NullDescriptorPool {
+public:
+    explicit CPUDescriptorPool(const DescriptorPoolDesc& desc)
+        : NullDescriptorPool(desc) {}
+
+protected:
+    std::unique_ptr<NullDescriptorSet> CreateDescriptorSet(IDescriptorSetLayout* layout) override {
+        return std::make_unique<CPUDescriptorSet>(layout);
+    }
+};
+
+// CPU交换链（后缓冲区为带存储的CPUTexture）
+class CPUSwapChain : public NullSwapChain {
+protected:
+    std::unique_ptr<NullTexture> CreateBackBuffer(const TextureDesc& desc) override {
+        return std::make_unique<CPUTexture>(desc);
+    }
+};
+
+// CPU设备
+class CPUDevice : public IDevice {
+public:
+    // threadCount为0时使用硬件并发数
+    explicit CPUDevice(const DeviceDesc& desc, uint32_t threadCount = 0)
+        : m_pool(threadCount) {
+        m_desc = desc;
+        const QueueType types[] = {
+            QueueType::Graphics, QueueType::Compute, QueueType::Transfer, QueueType::Present
+        };
+        for (QueueType type : types) {
+            QueueDesc queueDesc = {};
+            queueDesc.type = type;
+            queueDesc.queueFamilyIndex = static_cast<uint32_t>(type);
+            m_queues.push_back(std::make_unique<CPUQueue>(queueDesc, m_pool));
+        }
+    }
+
+    // 注册着色器函数，之后CreateShader按ShaderDesc::entryPoint查找
+    void RegisterVertexShader(const std::string& name, CPUVertexShaderFunc func, uint32_t varyingCount) {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        m_registry[name] = ShaderEntry{ShaderType::Vertex, std::move(func), nullptr, nullptr, varyingCount};
+    }
+
+    void RegisterPixelShader(const std::string& name, CPUPixelShaderFunc func) {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        m_registry[name] = ShaderEntry{ShaderType::Pixel, nullptr, std::move(func), nullptr, 0};
+    }
+
+    void RegisterComputeKernel(const std::string& name, CPUComputeKernelFunc func) {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        m_registry[name] = ShaderEntry{ShaderType::Compute, nullptr, nullptr, std::move(func), 0};
+    }
+
+    WorkerPool& GetWorkerPool() { return m_pool; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<IQueue*> GetQueue(QueueType type, uint32_t index) override {
+        RHI_RETURN_IF_FALSE(index == 0,
+            ErrorCode::InvalidArgument,
+            "队列索引越界: " + std::to_string(index));
+        return MakeSuccessResult(static_cast<IQueue*>(m_queues[static_cast<size_t>(type)].get()));
+    }
+
+    Result<ICommandPool*> CreateCommandPool(QueueType type, bool transient = false) override {
+        CommandPoolDesc desc;
+        desc.queueType = type;
+        desc.flags = transient ? CommandPoolFlag::Transient : CommandPoolFlag::None;
+        desc.queueFamilyIndex = static_cast<uint32_t>(type);
+        return MakeSuccessResult(static_cast<ICommandPool*>(new CPUCommandPool(desc)));
+    }
+
+    Result<ISwapChain*> CreateSwapChain(const SwapChainDesc& desc) override {
+        auto swapChain = std::make_unique<CPUSwapChain>();
+        RHI_RETURN_IF_FAILED(swapChain->Initialize(desc));
+        return MakeSuccessResult(static_cast<ISwapChain*>(swapChain.release()));
+    }
+
+    Result<IBuffer*> CreateBuffer(const BufferDesc& desc) override {
+        RHI_VALIDATE(desc.size > 0, ErrorCode::InvalidArgument, "缓冲区大小必须大于0");
+        CPUBuffer* buffer = new CPUBuffer(desc);
+        m_memoryTracker.Track(buffer->GetMemoryTracking(), MemoryAllocationKind::Buffer,
+            buffer, desc.size, desc.memoryType, desc.tag);
+        return MakeSuccessResult(static_cast<IBuffer*>(buffer));
+    }
+
+    Result<ITexture*> CreateTexture(const TextureDesc& desc) override {
+        RHI_VALIDATE(desc.width > 0 && desc.height > 0 && desc.depth > 0,
+            ErrorCode::InvalidArgument,
+            "纹理尺寸必须大于0");
+        RHI_VALIDATE(desc.mipLevels > 0 && desc.arraySize > 0,
+            ErrorCode::InvalidArgument,
+            "纹理mip级别与数组大小必须大于0");
+        RHI_RETURN_IF_FALSE(desc.sampleCount == 1,
+            ErrorCode::NotImplemented,
+            "CPU后端不支持多重采样纹理");
+        RHI_VALIDATE(IsValidTransientUsage(desc.usage),
+            ErrorCode::InvalidArgument,
+            "瞬态附件只能与RenderTarget/DepthStencil用途组合");
+        CPUTexture* texture = new CPUTexture(desc);
+        m_memoryTracker.Track(texture->GetMemoryTracking(), MemoryAllocationKind::Texture,
+            texture, EstimateTextureDataSize(desc), MemoryType::Default, desc.tag);
+        return MakeSuccessResult(static_cast<ITexture*>(texture));
+    }
+
+    Result<void> FlushMappedRanges(Span<const MappedRange> ranges) override {
+        return m_flushCounter.Record(ranges);
+    }
+
+    uint64_t GetFlushCallCount() const { return m_flushCounter.GetCallCount(); }
+    uint64_t GetFlushedRangeCount() const { return m_flushCounter.GetRangeCount(); }
+
+    Result<ResourceAllocationInfo> GetBufferAllocationInfo(const BufferDesc& desc) override {
+        return MakeSuccessResult(GetNullBufferAllocationInfo(desc));
+    }
+
+    Result<ResourceAllocationInfo> GetTextureAllocationInfo(const TextureDesc& desc) override {
+        return MakeSuccessResult(GetNullTextureAllocationInfo(desc));
+    }
+
+    // 光栅化器直接读写纹理的主机存储，瞬态附件同样需要后备存储
+    bool SupportsLazilyAllocatedMemory() const override { return false; }
+
+    Result<IBuffer*> CreatePlacedBuffer(const BufferDesc& desc, IMemory* memory, size_t offset) override {
+        RHI_VALIDATE(desc.size > 0, ErrorCode::InvalidArgument, "缓冲区大小必须大于0");
+        RHI_RETURN_IF_FAILED(ValidateNullPlacement(memory, desc.memoryType, offset, GetNullBufferAllocationInfo(desc)));
+        CPUBuffer* buffer = new CPUBuffer(desc, static_cast<NullMemory*>(memory), offset);
+        m_memoryTracker.Track(buffer->GetMemoryTracking(), MemoryAllocationKind::Buffer,
+            buffer, desc.size, desc.memoryType, desc.tag, memory, offset);
+        return MakeSuccessResult(static_cast<IBuffer*>(buffer));
+    }
+
+    Result<ITexture*> CreatePlacedTexture(const TextureDesc& desc, IMemory* memory, size_t offset) override {
+        RHI_VALIDATE(desc.width > 0 && desc.height > 0 && desc.depth > 0,
+            ErrorCode::InvalidArgument,
+            "纹理尺寸必须大于0");
+        RHI_VALIDATE(desc.mipLevels > 0 && desc.arraySize > 0,
+            ErrorCode::InvalidArgument,
+            "纹理mip级别与数组大小必须大于0");
+        RHI_RETURN_IF_FALSE(desc.sampleCount == 1,
+            ErrorCode::NotImplemented,
+            "CPU后端不支持多重采样纹理");
+        RHI_VALIDATE(IsValidTransientUsage(desc.usage),
+            ErrorCode::InvalidArgument,
+            "瞬态附件只能与RenderTarget/DepthStencil用途组合");
+        RHI_RETURN_IF_FAILED(ValidateNullPlacement(
+            memory, MemoryType::Default, offset, GetNullTextureAllocationInfo(desc)));
+        CPUTexture* texture = new CPUTexture(desc, static_cast<NullMemory*>(memory), offset);
+        m_memoryTracker.Track(texture->GetMemoryTracking(), MemoryAllocationKind::Texture,
+            texture, EstimateTextureDataSize(desc), MemoryType::Default, desc.tag, memory, offset);
+        return MakeSuccessResult(static_cast<ITexture*>(texture));
+    }
+
+    Result<IShader*> CreateShader(const ShaderDesc& desc) override {
+        std::lock_guard<std::mutex> lock(m_registryMutex);
+        auto it = m_registry.find(desc.entryPoint);
+        RHI_RETURN_IF_FALSE(it != m_registry.end(),
+            ErrorCode::ResourceCreateFailed,
+            "未注册的CPU着色器: " + desc.entryPoint);
+        const ShaderEntry& entry = it->second;
+        RHI_RETURN_IF_FALSE(entry.type == desc.type,
+            ErrorCode::ResourceCreateFailed,
+            "CPU着色器类型不匹配: " + desc.entryPoint);
+        return MakeSuccessResult(static_cast<IShader*>(
+            new CPUShader(desc, entry.vertex, entry.pixel, entry.compute, entry.varyingCount)));
+    }
+
+    Result<IPipelineState*> CreatePipelineState(const PipelineStateDesc& desc) override {
+        RHI_RETURN_IF_FALSE(IsValidPipelineStateDesc(desc), ErrorCode::InvalidArgument,
+            "管线描述必须是与type一致的GraphicsPipelineStateDesc或ComputePipelineStateDesc");
+        return MakeSuccessResult(static_cast<IPipelineState*>(new CPUPipelineState(desc)));
+    }
+
+    Result<IDescriptorSetLayout*> CreateDescriptorSetLayout(const DescriptorSetLayoutDesc& desc) override {
+        return MakeSuccessResult(static_cast<IDescriptorSetLayout*>(new NullDescriptorSetLayout(desc)));
+    }
+
+    Result<IDescriptorPool*> CreateDescriptorPool(const DescriptorPoolDesc& desc) override {
+        return MakeSuccessResult(static_cast<IDescriptorPool*>(new CPUDescriptorPool(desc)));
+    }
+
+    Result<IFence*> CreateFence(const FenceDesc& desc) override {
+        return MakeSuccessResult(static_cast<IFence*>(new NullFence(desc)));
+    }
+
+    Result<ISemaphore*> CreateSemaphore(const SemaphoreDesc& desc) override {
+        return MakeSuccessResult(static_cast<ISemaphore*>(new NullSemaphore(desc)));
+    }
+
+    Result<IEvent*> CreateEvent(const EventDesc& desc) override {
+        return MakeSuccessResult(static_cast<IEvent*>(new NullEvent(desc)));
+    }
+
+    Result<IMemory*> AllocateMemory(const MemoryDesc& desc) override {
+        RHI_VALIDATE(desc.size > 0, ErrorCode::InvalidArgument, "内存大小必须大于0");
+        NullMemory* memory = new NullMemory(desc, &m_residentBytes);
+        m_memoryTracker.Track(memory->GetMemoryTracking(), MemoryAllocationKind::Memory,
+            memory, desc.size, desc.type, desc.tag);
+        return MakeSuccessResult(static_cast<IMemory*>(memory));
+    }
+
+    Result<MemoryBudget> GetMemoryBudget() override {
+        return MakeSuccessResult(MemoryBudget{
+            kNullDedicatedVideoMemory, m_residentBytes.load(std::memory_order_relaxed)});
+    }
+
+    MemoryTracker& GetMemoryTracker() override { return m_memoryTracker; }
+
+    Result<void> WaitMultiple(
+        Span<const SemaphoreWaitInfo> waits,
+        SemaphoreWaitMode mode,
+        uint64_t timeout) override {
+        RHI_RETURN_IF_FALSE(waits.size() <= kMaxWaitMultipleSemaphores,
+            ErrorCode::InvalidArgument,
+            "等待的信号量过多: " + std::to_string(waits.size()));
+        return WaitNullSemaphores(waits, mode, timeout);
+    }
+
+    Result<void> WaitIdle() override {
+        // 提交在返回前已执行完毕
+        return MakeSuccessResult();
+    }
+
+private:
+    struct ShaderEntry {
+        ShaderType type;
+        CPUVertexShaderFunc vertex;
+        CPUPixelShaderFunc pixel;
+        CPUComputeKernelFunc compute;
+        uint32_t varyingCount;
+    };
+
+    MemoryTracker m_memoryTracker;              // 最先声明、最后析构：报告设备销毁时仍存活的分配
+    WorkerPool m_pool;
+    std::vector<std::unique_ptr<CPUQueue>> m_queues;
+    std::atomic<uint64_t> m_residentBytes{0};   // 驻留的MemoryType::Default内存字节数
+    NullFlushCounter m_flushCounter;
+    std::mutex m_registryMutex;
+    std::unordered_map<std::string, ShaderEntry> m_registry;
+};
+
+// CPU适配器
+class CPUAdapter : public NullAdapter {
+public:
+    // threadCount为0时使用硬件并发数
+    explicit CPUAdapter(uint32_t threadCount = 0)
+        : m_threadCount(threadCount) {
+        m_info.name = "RHI CPU Adapter";
+        m_info.type = AdapterType::CPU;
+    }
+
+    Result<IDevice*> CreateDevice(const DeviceDesc& desc) override {
+        return MakeSuccessResult(static_cast<IDevice*>(new CPUDevice(desc, m_threadCount)));
+    }
+
+private:
+    uint32_t m_threadCount;
+};
+
+// 枚举CPU后端适配器（符合EnumerateAdaptersFunc签名，返回的适配器由调用者释放）
+inline Result<std::vector<IAdapter*>> EnumerateCPUAdapters() {
+    return MakeSuccessResult(std::vector<IAdapter*>{ new CPUAdapter() });
+}
+
+} // namespace RHI
@@ -1,7 +1,12 @@
 
 #pragma once
 #include "Result.h"
+#include "Adapter.h"
 #include "Format.h"
+#include "ResourceState.h"
+#include "TextureDesc.h"
+#include "Span.h"
+#include <cstddef>
 #include <cstdint>
 
 namespace RHI {
@@ -31,23 +36,82 @@ inline CommandBufferUsage operator|(CommandBufferUsage a, CommandBufferUsage b)
 enum class BarrierType {
     Transition,         // 资源状态转换
     UAV,               // UAV访问同步
-    Aliasing,          // 资源别名同步
+    Aliasing,          // 资源别名同步：resource开始使用与其他放置资源重叠的内存（nullptr表示任意资源），
+                       // 之前的写入完成后才能访问；resource的内容未定义，stateAfter为其初始状态
     Global             // 全局内存屏障
 };
 
+// 屏障资源类型
+enum class BarrierResourceType {
+    Buffer,             // resource为IBuffer*
+    Texture             // resource为ITexture*
+};
+
 // 资源屏障描述
 struct BarrierDesc {
     BarrierType type;              // 屏障类型
-    void* resource;                // 资源指针
-    uint32_t stateBefore;          // 转换前状态
-    uint32_t stateAfter;           // 转换后状态
+    void* resource;                // 资源指针（类型由resourceType决定，Global屏障为nullptr）
+    ResourceState stateBefore;     // 转换前状态
+    ResourceState stateAfter;      // 转换后状态
+    BarrierResourceType resourceType;  // 资源类型
+    const TextureSubresourceRange* range;  // 纹理子资源范围（nullptr表示整个资源，缓冲区忽略）
+    QueueType srcQueue;            // 队列所有权转移的源队列与目标队列（两者相同表示不转移）；
+    QueueType dstQueue;            // 转移时源队列与目标队列的命令缓冲区须各录制一次同一个屏障（释放与获取）
+};
+
+// 缓冲区复制区域（CopyBuffer的regions参数指向此结构数组）
+struct BufferCopyRegion {
+    size_t srcOffset;              // 源偏移（字节）
+    size_t dstOffset;              // 目标偏移（字节）
+    size_t size;                   // 复制大小（字节）
+};
+
+// 纹理复制区域（CopyTexture的regions参数指向此结构数组）
+struct TextureCopyRegion {
+    uint32_t srcMipLevel;          // 源mip级别
+    uint32_t srcArrayLayer;        // 源数组层
+    uint32_t srcOffset[3];         // 源起始坐标（像素）
+    uint32_t dstMipLevel;          // 目标mip级别
+    uint32_t dstArrayLayer;        // 目标数组层
+    uint32_t dstOffset[3];         // 目标起始坐标（像素）
+    uint32_t extent[3];            // 复制范围（像素）
+};
+
+// 缓冲区到纹理的复制区域（CopyBufferToTexture的regions参数指向此结构数组）
+// 可移植的源数据：bufferOffset按kTextureUploadOffsetAlignment对齐，行间距按kTextureUploadPitchAlignment对齐
+struct BufferTextureCopyRegion {
+    size_t bufferOffset;           // 源数据在缓冲区中的偏移（字节）
+    size_t bufferRowPitch;         // 源数据的行间距（字节，按块行计；0表示紧密排列）
+    size_t bufferSlicePitch;       // 源数据的深度切片间距（字节，0表示紧密排列）
+    uint32_t mipLevel;             // 目标mip级别
+    uint32_t arrayLayer;           // 目标数组层
+    uint32_t offset[3];            // 目标起始坐标（像素）
+    uint32_t extent[3];            // 复制范围（像素）
+};
+
+constexpr size_t kTextureUploadOffsetAlignment = 512;  // DirectX12: D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+constexpr size_t kTextureUploadPitchAlignment = 256;   // DirectX12: D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+
+// 间接绘制参数（DrawIndirect的参数缓冲区中按stride排列）
+struct DrawIndirectArgs {
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t firstInstance;
+};
+
+// 间接调度参数（DispatchIndirect的参数缓冲区中的布局）
+struct DispatchIndirectArgs {
+    uint32_t groupCountX;
+    uint32_t groupCountY;
+    uint32_t groupCountZ;
 };
 
 // 渲染通道描述
 struct RenderPassDesc {
     uint32_t colorAttachmentCount;  // 颜色附件数量
-    void* colorAttachments;         // 颜色附件数组
-    void* depthStencilAttachment;   // 深度模板附件
+    void* colorAttachments;         // 颜色附件数组（void*数组，元素为ITexture::GetRenderTargetView的返回值）
+    void* depthStencilAttachment;   // 深度模板附件（ITexture::GetDepthStencilView的返回值）
 };
 
 // 视口描述
@@ -115,20 +179,28 @@ public:
     // 设置裁剪矩形
     virtual Result<void> SetScissor(const Scissor& scissor) = 0;
 
-    // 设置管线状态
+    // 设置管线状态（pipelineState为IPipelineState*）
     virtual Result<void> SetPipelineState(void* pipelineState) = 0;
 
-    // 设置描述符集
+    // 设置描述符集（descriptorSet为IDescriptorSet*）
     virtual Result<void> SetDescriptorSet(
         uint32_t set,
         void* descriptorSet) = 0;
 
-    // 设置顶点缓冲区
+    // 设置描述符集并提供动态偏移
+    // dynamicOffsets按绑定号顺序对应集合中的UniformBufferDynamic/StorageBufferDynamic绑定，
+    // 须为DeviceLimits::minUniformBufferOffsetAlignment（或minStorageBufferOffsetAlignment）的倍数
+    virtual Result<void> SetDescriptorSet(
+        uint32_t set,
+        void* descriptorSet,
+        Span<const uint32_t> dynamicOffsets) = 0;
+
+    // 设置顶点缓冲区（vertexBufferView为IBuffer::GetVertexBufferView的返回值）
     virtual Result<void> SetVertexBuffer(
         uint32_t slot,
         void* vertexBufferView) = 0;
 
-    // 设置索引缓冲区
+    // 设置索引缓冲区（indexBufferView为IBuffer::GetIndexBufferView的返回值，视图stride为索引大小）
     virtual Result<void> SetIndexBuffer(void* indexBufferView) = 0;
 
     // 设置推送常量
@@ -153,7 +225,7 @@ public:
         int32_t vertexOffset,
         uint32_t firstInstance) = 0;
 
-    // 间接绘制
+    // 间接绘制（argumentBuffer为IBuffer*，参数布局为DrawIndirectArgs）
     virtual Result<void> DrawIndirect(
         void* argumentBuffer,
         uint32_t offset,
@@ -166,25 +238,34 @@ public:
         uint32_t groupCountY,
         uint32_t groupCountZ) = 0;
 
-    // 间接调度计算
+    // 间接调度计算（argumentBuffer为IBuffer*，参数布局为DispatchIndirectArgs）
     virtual Result<void> DispatchIndirect(
         void* argumentBuffer,
         uint32_t offset) = 0;
 
-    // 复制缓冲区
+    // 复制缓冲区（srcBuffer/dstBuffer为IBuffer*，regions为BufferCopyRegion数组）
     virtual Result<void> CopyBuffer(
         void* srcBuffer,
         void* dstBuffer,
         uint32_t regionCount,
         void* regions) = 0;
 
-    // 复制纹理
+    // 复制纹理（srcTexture/dstTexture为ITexture*，regions为TextureCopyRegion数组）
     virtual Result<void> CopyTexture(
         void* srcTexture,
         void* dstTexture,
         uint32_t regionCount,
         void* regions) = 0;
 
+    // 把缓冲区中的texel数据复制到纹理（srcBuffer为IBuffer*，dstTexture为ITexture*，regions为BufferTextureCopyRegion数组）
+    // DirectX12: CopyTextureRegion（源为placed footprint）
+    // Vulkan: vkCmdCopyBufferToImage（目标须处于TRANSFER_DST_OPTIMAL布局）
+    virtual Result<void> CopyBufferToTexture(
+        void* srcBuffer,
+        void* dstTexture,
+        uint32_t regionCount,
+        void* regions) = 0;
+
     // 资源屏障
     virtual Result<void> ResourceBarrier(
         uint32_t barrierCount,
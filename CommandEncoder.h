@@ -0,0 +1,637 @@
+#pragma once
+#include "CommandBuffer.h"
+#include "ErrorUtil.h"
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 不内联慢路径，保持热路径足够小以被内联
+#ifndef RHI_NOINLINE
+#if defined(_MSC_VER)
+#define RHI_NOINLINE __declspec(noinline)
+#else
+#define RHI_NOINLINE __attribute__((noinline))
+#endif
+#endif
+
+namespace RHI {
+
+// 命令流操作码
+enum class CommandOpcode : uint16_t {
+    BeginRenderPass,
+    EndRenderPass,
+    SetViewport,
+    SetScissor,
+    SetPipelineState,
+    SetDescriptorSet,
+    SetVertexBuffer,
+    SetIndexBuffer,
+    PushConstants,
+    Draw,
+    DrawIndexed,
+    DrawIndirect,
+    Dispatch,
+    DispatchIndirect,
+    CopyBuffer,
+    CopyTexture,
+    CopyBufferToTexture,
+    ResourceBarrier,
+    ExecuteBundle
+};
+
+// 命令包头（每个命令包以此开头，size包含包头与尾随数据，按kCommandPacketAlignment对齐）
+struct CommandPacket {
+    CommandOpcode opcode;
+    uint16_t reserved;
+    uint32_t size;
+};
+
+constexpr size_t kCommandPacketAlignment = 8;
+
+// 命令包定义（均为POD，变长数据紧跟在包之后）
+struct BeginRenderPassPacket {
+    CommandPacket header;
+    uint32_t colorAttachmentCount;     // 之后紧跟colorAttachmentCount个void*
+    void* depthStencilAttachment;
+};
+
+struct EndRenderPassPacket {
+    CommandPacket header;
+};
+
+struct SetViewportPacket {
+    CommandPacket header;
+    Viewport viewport;
+};
+
+struct SetScissorPacket {
+    CommandPacket header;
+    Scissor scissor;
+};
+
+struct SetPipelineStatePacket {
+    CommandPacket header;
+    void* pipelineState;
+};
+
+struct SetDescriptorSetPacket {
+    CommandPacket header;
+    uint32_t set;
+    uint32_t dynamicOffsetCount;       // 之后紧跟dynamicOffsetCount个uint32_t动态偏移
+    void* descriptorSet;
+};
+
+struct SetVertexBufferPacket {
+    CommandPacket header;
+    uint32_t slot;
+    void* vertexBufferView;
+};
+
+struct SetIndexBufferPacket {
+    CommandPacket header;
+    void* indexBufferView;
+};
+
+struct PushConstantsPacket {
+    CommandPacket header;
+    void* layout;
+    uint32_t offset;
+    uint32_t size;                     // 之后紧跟size字节数据
+};
+
+struct DrawPacket {
+    CommandPacket header;
+    uint32_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t firstInstance;
+};
+
+struct DrawIndexedPacket {
+    CommandPacket header;
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t firstInstance;
+};
+
+struct DrawIndirectPacket {
+    CommandPacket header;
+    void* argumentBuffer;
+    uint32_t offset;
+    uint32_t drawCount;
+    uint32_t stride;
+};
+
+struct DispatchPacket {
+    CommandPacket header;
+    uint32_t groupCountX;
+    uint32_t groupCountY;
+    uint32_t groupCountZ;
+};
+
+struct DispatchIndirectPacket {
+    CommandPacket header;
+    void* argumentBuffer;
+    uint32_t offset;
+};
+
+struct CopyBufferPacket {
+    CommandPacket header;
+    void* srcBuffer;
+    void* dstBuffer;
+    uint32_t regionCount;              // 之后紧跟regionCount个BufferCopyRegion
+};
+
+struct CopyTexturePacket {
+    CommandPacket header;
+    void* srcTexture;
+    void* dstTexture;
+    uint32_t regionCount;              // 之后紧跟regionCount个TextureCopyRegion
+};
+
+struct CopyBufferToTexturePacket {
+    CommandPacket header;
+    void* srcBuffer;
+    void* dstTexture;
+    uint32_t regionCount;              // 之后紧跟regionCount个BufferTextureCopyRegion
+};
+
+struct ResourceBarrierPacket {
+    CommandPacket header;
+    uint32_t barrierCount;             // 之后紧跟barrierCount个BarrierDesc与其中非空range的副本
+    uint32_t reserved;                 // 保持载荷按8字节对齐
+};
+
+struct ExecuteBundlePacket {
+    CommandPacket header;
+    ICommandBuffer* bundle;
+};
+
+// 命令流内存（按块线性分配）
+// Reset只回退写指针并保留所有块，稳定状态下录制不做堆分配
+class CommandArena {
+public:
+    static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit CommandArena(size_t blockSize = kDefaultBlockSize)
+        : m_blockSize(blockSize) {}
+
+    CommandArena(const CommandArena&) = delete;
+    CommandArena& operator=(const CommandArena&) = delete;
+
+    CommandArena(CommandArena&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    CommandArena& operator=(CommandArena&& other) noexcept {
+        m_blockSize = other.m_blockSize;
+        m_blocks = std::move(other.m_blocks);
+        m_current = other.m_current;
+        m_cursor = other.m_cursor;
+        m_end = other.m_end;
+        other.m_blocks.clear();
+        other.m_current = 0;
+        other.m_cursor = nullptr;
+        other.m_end = nullptr;
+        return *this;
+    }
+
+    // 分配size字节（按kCommandPacketAlignment对齐）；超过块大小的请求使用单独的块
+    void* Allocate(size_t size) {
+        size = AlignUp(size);
+        if (static_cast<size_t>(m_end - m_cursor) >= size) {
+            void* memory = m_cursor;
+            m_cursor += size;
+            return memory;
+        }
+        return AllocateSlow(size);
+    }
+
+    void Reset() {
+        for (Block& block : m_blocks) {
+            block.used = 0;
+        }
+        m_current = 0;
+        m_cursor = m_blocks.empty() ? nullptr : m_blocks[0].data.get();
+        m_end = m_blocks.empty() ? nullptr : m_cursor + m_blocks[0].capacity;
+    }
+
+    // 按顺序遍历已使用的内存区间
+    template<typename Func>
+    void ForEachRange(Func&& func) const {
+        for (size_t i = 0; i < m_blocks.size(); ++i) {
+            size_t used = GetBlockUsed(i);
+            if (used > 0) {
+                func(m_blocks[i].data.get(), used);
+            }
+        }
+    }
+
+    // 已写入的字节数
+    size_t GetUsedSize() const {
+        size_t used = 0;
+        for (size_t i = 0; i < m_blocks.size(); ++i) {
+            used += GetBlockUsed(i);
+        }
+        return used;
+    }
+
+    // 保留的总容量
+    size_t GetCapacity() const {
+        size_t capacity = 0;
+        for (const Block& block : m_blocks) {
+            capacity += block.capacity;
+        }
+        return capacity;
+    }
+
+    static size_t AlignUp(size_t size) {
+        return (size + kCommandPacketAlignment - 1) & ~(kCommandPacketAlignment - 1);
+    }
+
+private:
+    // used只记录已写满的块，当前块的用量由写指针得出
+    struct Block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t capacity;
+        size_t used;
+    };
+
+    size_t GetBlockUsed(size_t index) const {
+        if (index == m_current && m_cursor != nullptr) {
+            return static_cast<size_t>(m_cursor - m_blocks[index].data.get());
+        }
+        return m_blocks[index].used;
+    }
+
+    // 切换到下一个足够大的块（复用Reset后保留的块，找不到时新建）
+    RHI_NOINLINE void* AllocateSlow(size_t size) {
+        if (m_cursor != nullptr) {
+            m_blocks[m_current].used = GetBlockUsed(m_current);
+            ++m_current;
+        }
+        while (m_current < m_blocks.size() && m_blocks[m_current].capacity < size) {
+            ++m_current;
+        }
+        if (m_current == m_blocks.size()) {
+            size_t capacity = size > m_blockSize ? size : m_blockSize;
+            m_blocks.push_back(Block{std::unique_ptr<uint8_t[]>(new uint8_t[capacity]), capacity, 0});
+        }
+        Block& block = m_blocks[m_current];
+        m_cursor = block.data.get() + size;
+        m_end = block.data.get() + block.capacity;
+        return block.data.get();
+    }
+
+    size_t m_blockSize = kDefaultBlockSize;
+    std::vector<Block> m_blocks;
+    size_t m_current = 0;
+    uint8_t* m_cursor = nullptr;
+    uint8_t* m_end = nullptr;
+};
+
+// 与后端无关的命令编码器
+// 把命令以POD包的形式写入CommandArena，录制时没有虚调用、没有逐命令分配，也不做参数验证；
+// 参数错误在Replay时由目标命令缓冲区报告。
+// 每个线程使用自己的编码器；已录制的命令流在Reset前可以重复回放（静态命令流跨帧缓存），
+// 期间引用的资源、视图与数组内容（已复制进命令流）须保持有效。
+class CommandEncoder {
+public:
+    explicit CommandEncoder(size_t blockSize = CommandArena::kDefaultBlockSize)
+        : m_arena(blockSize) {}
+
+    CommandEncoder(CommandEncoder&& other) noexcept
+        : m_arena(std::move(other.m_arena))
+        , m_commandCount(other.m_commandCount) {
+        other.m_commandCount = 0;
+    }
+
+    CommandEncoder& operator=(CommandEncoder&& other) noexcept {
+        m_arena = std::move(other.m_arena);
+        m_commandCount = other.m_commandCount;
+        other.m_commandCount = 0;
+        return *this;
+    }
+
+    // 清空命令流（保留内存）
+    void Reset() {
+        m_arena.Reset();
+        m_commandCount = 0;
+    }
+
+    void BeginRenderPass(const RenderPassDesc& desc) {
+        size_t attachmentsSize = sizeof(void*) * desc.colorAttachmentCount;
+        auto* packet = Emplace<BeginRenderPassPacket>(CommandOpcode::BeginRenderPass, attachmentsSize);
+        packet->colorAttachmentCount = desc.colorAttachmentCount;
+        packet->depthStencilAttachment = desc.depthStencilAttachment;
+        if (attachmentsSize > 0) {
+            std::memcpy(packet + 1, desc.colorAttachments, attachmentsSize);
+        }
+    }
+
+    void EndRenderPass() {
+        Emplace<EndRenderPassPacket>(CommandOpcode::EndRenderPass);
+    }
+
+    void SetViewport(const Viewport& viewport) {
+        Emplace<SetViewportPacket>(CommandOpcode::SetViewport)->viewport = viewport;
+    }
+
+    void SetScissor(const Scissor& scissor) {
+        Emplace<SetScissorPacket>(CommandOpcode::SetScissor)->scissor = scissor;
+    }
+
+    void SetPipelineState(void* pipelineState) {
+        Emplace<SetPipelineStatePacket>(CommandOpcode::SetPipelineState)->pipelineState = pipelineState;
+    }
+
+    void SetDescriptorSet(uint32_t set, void* descriptorSet) {
+        auto* packet = Emplace<SetDescriptorSetPacket>(CommandOpcode::SetDescriptorSet);
+        packet->set = set;
+        packet->dynamicOffsetCount = 0;
+        packet->descriptorSet = descriptorSet;
+    }
+
+    // 动态偏移在录制时复制进命令流
+    void SetDescriptorSet(uint32_t set, void* descriptorSet, Span<const uint32_t> dynamicOffsets) {
+        uint32_t count = static_cast<uint32_t>(dynamicOffsets.size());
+        auto* packet = Emplace<SetDescriptorSetPacket>(CommandOpcode::SetDescriptorSet, count * sizeof(uint32_t));
+        packet->set = set;
+        packet->dynamicOffsetCount = count;
+        packet->descriptorSet = descriptorSet;
+        if (count > 0) {
+            std::memcpy(packet + 1, dynamicOffsets.data(), count * sizeof(uint32_t));
+        }
+    }
+
+    void SetVertexBuffer(uint32_t slot, void* vertexBufferView) {
+        auto* packet = Emplace<SetVertexBufferPacket>(CommandOpcode::SetVertexBuffer);
+        packet->slot = slot;
+        packet->vertexBufferView = vertexBufferView;
+    }
+
+    void SetIndexBuffer(void* indexBufferView) {
+        Emplace<SetIndexBufferPacket>(CommandOpcode::SetIndexBuffer)->indexBufferView = indexBufferView;
+    }
+
+    // data在录制时复制进命令流
+    void PushConstants(void* layout, uint32_t offset, uint32_t size, const void* data) {
+        auto* packet = Emplace<PushConstantsPacket>(CommandOpcode::PushConstants, size);
+        packet->layout = layout;
+        packet->offset = offset;
+        packet->size = size;
+        if (size > 0) {
+            std::memcpy(packet + 1, data, size);
+        }
+    }
+
+    void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+        auto* packet = Emplace<DrawPacket>(CommandOpcode::Draw);
+        packet->vertexCount = vertexCount;
+        packet->instanceCount = instanceCount;
+        packet->firstVertex = firstVertex;
+        packet->firstInstance = firstInstance;
+    }
+
+    void DrawIndexed(
+        uint32_t indexCount,
+        uint32_t instanceCount,
+        uint32_t firstIndex,
+        int32_t vertexOffset,
+        uint32_t firstInstance) {
+        auto* packet = Emplace<DrawIndexedPacket>(CommandOpcode::DrawIndexed);
+        packet->indexCount = indexCount;
+        packet->instanceCount = instanceCount;
+        packet->firstIndex = firstIndex;
+        packet->vertexOffset = vertexOffset;
+        packet->firstInstance = firstInstance;
+    }
+
+    void DrawIndirect(void* argumentBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) {
+        auto* packet = Emplace<DrawIndirectPacket>(CommandOpcode::DrawIndirect);
+        packet->argumentBuffer = argumentBuffer;
+        packet->offset = offset;
+        packet->drawCount = drawCount;
+        packet->stride = stride;
+    }
+
+    void Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) {
+        auto* packet = Emplace<DispatchPacket>(CommandOpcode::Dispatch);
+        packet->groupCountX = groupCountX;
+        packet->groupCountY = groupCountY;
+        packet->groupCountZ = groupCountZ;
+    }
+
+    void DispatchIndirect(void* argumentBuffer, uint32_t offset) {
+        auto* packet = Emplace<DispatchIndirectPacket>(CommandOpcode::DispatchIndirect);
+        packet->argumentBuffer = argumentBuffer;
+        packet->offset = offset;
+    }
+
+    // regions（BufferCopyRegion数组）在录制时复制进命令流
+    void CopyBuffer(void* srcBuffer, void* dstBuffer, uint32_t regionCount, const void* regions) {
+        size_t regionsSize = sizeof(BufferCopyRegion) * regionCount;
+        auto* packet = Emplace<CopyBufferPacket>(CommandOpcode::CopyBuffer, regionsSize);
+        packet->srcBuffer = srcBuffer;
+        packet->dstBuffer = dstBuffer;
+        packet->regionCount = regionCount;
+        if (regionsSize > 0) {
+            std::memcpy(packet + 1, regions, regionsSize);
+        }
+    }
+
+    // regions（TextureCopyRegion数组）在录制时复制进命令流
+    void CopyTexture(void* srcTexture, void* dstTexture, uint32_t regionCount, const void* regions) {
+        size_t regionsSize = sizeof(TextureCopyRegion) * regionCount;
+        auto* packet = Emplace<CopyTexturePacket>(CommandOpcode::CopyTexture, regionsSize);
+        packet->srcTexture = srcTexture;
+        packet->dstTexture = dstTexture;
+        packet->regionCount = regionCount;
+        if (regionsSize > 0) {
+            std::memcpy(packet + 1, regions, regionsSize);
+        }
+    }
+
+    // regions（BufferTextureCopyRegion数组）在录制时复制进命令流
+    void CopyBufferToTexture(void* srcBuffer, void* dstTexture, uint32_t regionCount, const void* regions) {
+        size_t regionsSize = sizeof(BufferTextureCopyRegion) * regionCount;
+        auto* packet = Emplace<CopyBufferToTexturePacket>(CommandOpcode::CopyBufferToTexture, regionsSize);
+        packet->srcBuffer = srcBuffer;
+        packet->dstTexture = dstTexture;
+        packet->regionCount = regionCount;
+        if (regionsSize > 0) {
+            std::memcpy(packet + 1, regions, regionsSize);
+        }
+    }
+
+    // 屏障数组在录制时复制进命令流；子资源范围紧跟在屏障数组之后，屏障中的range指向命令流中的副本
+    void ResourceBarrier(uint32_t barrierCount, const BarrierDesc* barriers) {
+        uint32_t rangeCount = 0;
+        for (uint32_t i = 0; i < barrierCount; ++i) {
+            rangeCount += barriers[i].range != nullptr ? 1 : 0;
+        }
+        size_t barriersSize = sizeof(BarrierDesc) * barrierCount;
+        size_t payloadSize = barriersSize + sizeof(TextureSubresourceRange) * rangeCount;
+        auto* packet = Emplace<ResourceBarrierPacket>(CommandOpcode::ResourceBarrier, payloadSize);
+        packet->barrierCount = barrierCount;
+        packet->reserved = 0;
+        if (barriersSize > 0) {
+            std::memcpy(packet + 1, barriers, barriersSize);
+        }
+        if (rangeCount > 0) {
+            auto* copies = reinterpret_cast<BarrierDesc*>(packet + 1);
+            auto* ranges = reinterpret_cast<TextureSubresourceRange*>(copies + barrierCount);
+            for (uint32_t i = 0; i < barrierCount; ++i) {
+                if (copies[i].range != nullptr) {
+                    *ranges = *copies[i].range;
+                    copies[i].range = ranges++;
+                }
+            }
+        }
+    }
+
+    void ExecuteBundle(ICommandBuffer* bundle) {
+        Emplace<ExecuteBundlePacket>(CommandOpcode::ExecuteBundle)->bundle = bundle;
+    }
+
+    // 一次遍历把命令流回放到目标命令缓冲区（不调用Begin/End，目标须处于录制状态）
+    // 遇到第一个失败的命令时停止并返回其错误
+    Result<void> Replay(ICommandBuffer* commandBuffer) const {
+        RHI_VALIDATE(commandBuffer != nullptr, ErrorCode::InvalidArgument, "命令缓冲区不能为空");
+        Result<void> result = MakeSuccessResult();
+        m_arena.ForEachRange([&](const uint8_t* begin, size_t size) {
+            const uint8_t* cursor = begin;
+            const uint8_t* end = begin + size;
+            while (result.IsSuccess() && cursor < end) {
+                const auto* packet = reinterpret_cast<const CommandPacket*>(cursor);
+                result = ReplayPacket(commandBuffer, packet);
+                cursor += packet->size;
+            }
+        });
+        return result;
+    }
+
+    bool IsEmpty() const { return m_commandCount == 0; }
+    uint32_t GetCommandCount() const { return m_commandCount; }
+    size_t GetMemoryUsage() const { return m_arena.GetUsedSize(); }
+    size_t GetMemoryCapacity() const { return m_arena.GetCapacity(); }
+
+private:
+    template<typename Packet>
+    Packet* Emplace(CommandOpcode opcode, size_t extraSize = 0) {
+        static_assert(std::is_trivially_copyable<Packet>::value, "命令包必须是POD");
+        static_assert(alignof(Packet) <= kCommandPacketAlignment, "命令包对齐超出命令流对齐");
+        size_t size = CommandArena::AlignUp(sizeof(Packet) + extraSize);
+        auto* packet = static_cast<Packet*>(m_arena.Allocate(size));
+        packet->header.opcode = opcode;
+        packet->header.reserved = 0;
+        packet->header.size = static_cast<uint32_t>(size);
+        ++m_commandCount;
+        return packet;
+    }
+
+    template<typename Packet>
+    static const Packet& As(const CommandPacket* packet) {
+        return *reinterpret_cast<const Packet*>(packet);
+    }
+
+    // 变长数据紧跟在包之后
+    template<typename Data, typename Packet>
+    static Data* Payload(const Packet& packet) {
+        return reinterpret_cast<Data*>(const_cast<Packet*>(&packet + 1));
+    }
+
+    static Result<void> ReplayPacket(ICommandBuffer* commandBuffer, const CommandPacket* header) {
+        switch (header->opcode) {
+            case CommandOpcode::BeginRenderPass: {
+                const auto& packet = As<BeginRenderPassPacket>(header);
+                RenderPassDesc desc = {};
+                desc.colorAttachmentCount = packet.colorAttachmentCount;
+                desc.colorAttachments = packet.colorAttachmentCount > 0 ? Payload<void*>(packet) : nullptr;
+                desc.depthStencilAttachment = packet.depthStencilAttachment;
+                return commandBuffer->BeginRenderPass(desc);
+            }
+            case CommandOpcode::EndRenderPass:
+                return commandBuffer->EndRenderPass();
+            case CommandOpcode::SetViewport:
+                return commandBuffer->SetViewport(As<SetViewportPacket>(header).viewport);
+            case CommandOpcode::SetScissor:
+                return commandBuffer->SetScissor(As<SetScissorPacket>(header).scissor);
+            case CommandOpcode::SetPipelineState:
+                return commandBuffer->SetPipelineState(As<SetPipelineStatePacket>(header).pipelineState);
+            case CommandOpcode::SetDescriptorSet: {
+                const auto& packet = As<SetDescriptorSetPacket>(header);
+                if (packet.dynamicOffsetCount == 0) {
+                    return commandBuffer->SetDescriptorSet(packet.set, packet.descriptorSet);
+                }
+                return commandBuffer->SetDescriptorSet(packet.set, packet.descriptorSet,
+                    Span<const uint32_t>(Payload<const uint32_t>(packet), packet.dynamicOffsetCount));
+            }
+            case CommandOpcode::SetVertexBuffer: {
+                const auto& packet = As<SetVertexBufferPacket>(header);
+                return commandBuffer->SetVertexBuffer(packet.slot, packet.vertexBufferView);
+            }
+            case CommandOpcode::SetIndexBuffer:
+                return commandBuffer->SetIndexBuffer(As<SetIndexBufferPacket>(header).indexBufferView);
+            case CommandOpcode::PushConstants: {
+                const auto& packet = As<PushConstantsPacket>(header);
+                return commandBuffer->PushConstants(packet.layout, packet.offset, packet.size,
+                    Payload<const uint8_t>(packet));
+            }
+            case CommandOpcode::Draw: {
+                const auto& packet = As<DrawPacket>(header);
+                return commandBuffer->Draw(packet.vertexCount, packet.instanceCount,
+                    packet.firstVertex, packet.firstInstance);
+            }
+            case CommandOpcode::DrawIndexed: {
+                const auto& packet = As<DrawIndexedPacket>(header);
+                return commandBuffer->DrawIndexed(packet.indexCount, packet.instanceCount,
+                    packet.firstIndex, packet.vertexOffset, packet.firstInstance);
+            }
+            case CommandOpcode::DrawIndirect: {
+                const auto& packet = As<DrawIndirectPacket>(header);
+                return commandBuffer->DrawIndirect(packet.argumentBuffer, packet.offset,
+                    packet.drawCount, packet.stride);
+            }
+            case CommandOpcode::Dispatch: {
+                const auto& packet = As<DispatchPacket>(header);
+                return commandBuffer->Dispatch(packet.groupCountX, packet.groupCountY, packet.groupCountZ);
+            }
+            case CommandOpcode::DispatchIndirect: {
+                const auto& packet = As<DispatchIndirectPacket>(header);
+                return commandBuffer->DispatchIndirect(packet.argumentBuffer, packet.offset);
+            }
+            case CommandOpcode::CopyBuffer: {
+                const auto& packet = As<CopyBufferPacket>(header);
+                return commandBuffer->CopyBuffer(packet.srcBuffer, packet.dstBuffer,
+                    packet.regionCount, Payload<BufferCopyRegion>(packet));
+            }
+            case CommandOpcode::CopyTexture: {
+                const auto& packet = As<CopyTexturePacket>(header);
+                return commandBuffer->CopyTexture(packet.srcTexture, packet.dstTexture,
+                    packet.regionCount, Payload<TextureCopyRegion>(packet));
+            }
+            case CommandOpcode::CopyBufferToTexture: {
+                const auto& packet = As<CopyBufferToTexturePacket>(header);
+                return commandBuffer->CopyBufferToTexture(packet.srcBuffer, packet.dstTexture,
+                    packet.regionCount, Payload<BufferTextureCopyRegion>(packet));
+            }
+            case CommandOpcode::ResourceBarrier: {
+                const auto& packet = As<ResourceBarrierPacket>(header);
+                return commandBuffer->ResourceBarrier(packet.barrierCount, Payload<const BarrierDesc>(packet));
+            }
+            case CommandOpcode::ExecuteBundle:
+                return commandBuffer->ExecuteBundle(As<ExecuteBundlePacket>(header).bundle);
+        }
+        return MakeErrorResult<void>(ErrorCode::InvalidOperation, "命令流中存在未知的操作码");
+    }
+
+    CommandArena m_arena;
+    uint32_t m_commandCount = 0;
+};
+
+} // namespace RHI
@@ -66,7 +66,7 @@ public:
     virtual Result<void> FreeCommandBuffers(
         const std::vector<ICommandBuffer*>& commandBuffers) = 0;
 
-    // 重置命令池（释放所有命令缓冲区）
+    // 重置命令池（所有命令缓冲区回到初始状态，可重新录制）
     virtual Result<void> Reset() = 0;
 
     // 修剪未使用的命令缓冲区内存
@@ -0,0 +1,215 @@
+#pragma once
+#include "Descriptor.h"
+#include "ErrorUtil.h"
+#include "Synchronization.h"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RHI {
+
+// 延迟释放统计
+struct DeferredReleaseStats {
+    uint64_t releaseRequests = 0;      // Release调用次数
+    uint64_t destroyedObjects = 0;     // 已销毁的对象数
+    uint64_t freeFailures = 0;         // 归还描述符集失败的次数
+    uint64_t collectCalls = 0;         // Collect调用次数
+};
+
+// 延迟释放队列
+// 对象释放时记录最后使用它的队列时间线值（或栅栏值），Collect查询各时间线的完成进度并批量销毁已完成的对象，
+// 从不等待GPU；替代在流式加载中释放资源前调用IDevice::WaitIdle。
+// 每个时间线上的对象按Release的顺序排队，Collect从队首取出值已完成的对象（值乱序时后面的对象推迟到前面的完成）。
+// 线程安全：Release可在任意线程并发调用；Collect/Drain须在同一个线程调用。
+// 时间线信号量与栅栏须在队列销毁（或Drain）之后才能销毁；两者都为nullptr表示GPU没有使用该对象，下一次Collect即销毁。
+class DeferredReleaseQueue {
+public:
+    DeferredReleaseQueue() = default;
+
+    DeferredReleaseQueue(const DeferredReleaseQueue&) = delete;
+    DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+
+    // 析构时直接销毁所有剩余对象，调用方须先确认GPU已不再使用它们（例如调用Drain或WaitIdle）
+    ~DeferredReleaseQueue() {
+        for (Timeline& timeline : m_timelines) {
+            for (const Entry& entry : timeline.entries) {
+                Destroy(entry);
+            }
+        }
+    }
+
+    // 在timeline到达value之后销毁object（接管所有权，object由delete销毁）
+    template<typename T>
+    void Release(T* object, ISemaphore* timeline, uint64_t value) {
+        Push(timeline, nullptr, value, {object, nullptr, &DeleteObject<T>});
+    }
+
+    // 在fence到达value之后销毁object
+    template<typename T>
+    void Release(T* object, IFence* fence, uint64_t value) {
+        Push(nullptr, fence, value, {object, nullptr, &DeleteObject<T>});
+    }
+
+    template<typename T>
+    void Release(std::unique_ptr<T> object, ISemaphore* timeline, uint64_t value) {
+        Release(object.release(), timeline, value);
+    }
+
+    template<typename T>
+    void Release(std::unique_ptr<T> object, IFence* fence, uint64_t value) {
+        Release(object.release(), fence, value);
+    }
+
+    // 在timeline到达value之后把描述符集归还给pool
+    void Release(IDescriptorSet* descriptorSet, IDescriptorPool* pool, ISemaphore* timeline, uint64_t value) {
+        Push(timeline, nullptr, value, {descriptorSet, pool, &FreeDescriptorSet});
+    }
+
+    void Release(IDescriptorSet* descriptorSet, IDescriptorPool* pool, IFence* fence, uint64_t value) {
+        Push(nullptr, fence, value, {descriptorSet, pool, &FreeDescriptorSet});
+    }
+
+    // 销毁所有值已完成的对象，不等待GPU；返回本次销毁的对象数
+    Result<uint32_t> Collect() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.collectCalls;
+            for (Timeline& timeline : m_timelines) {
+                if (timeline.entries.empty()) {
+                    continue;
+                }
+                uint64_t completed = UINT64_MAX;
+                if (timeline.semaphore != nullptr || timeline.fence != nullptr) {
+                    auto value = timeline.semaphore != nullptr ?
+                        timeline.semaphore->GetValue() : timeline.fence->GetValue();
+                    RHI_RETURN_IF_FAILED(value);
+                    completed = value.GetValue();
+                }
+                while (!timeline.entries.empty() && timeline.entries.front().value <= completed) {
+                    m_collected.push_back(timeline.entries.front());
+                    timeline.entries.pop_front();
+                }
+            }
+        }
+
+        // 在锁外销毁，不阻塞其他线程的Release
+        uint32_t freeFailures = 0;
+        for (const Entry& entry : m_collected) {
+            freeFailures += Destroy(entry) ? 0 : 1;
+        }
+        uint32_t destroyed = static_cast<uint32_t>(m_collected.size());
+        m_collected.clear();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.destroyedObjects += destroyed;
+        m_stats.freeFailures += freeFailures;
+        return MakeSuccessResult(destroyed);
+    }
+
+    // 等待所有时间线到达已记录的最大值后销毁全部对象（用于关闭设备或卸载关卡，会阻塞）；timeout单位为纳秒
+    Result<void> Drain(uint64_t timeout) {
+        std::vector<Timeline> timelines;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const Timeline& timeline : m_timelines) {
+                if (!timeline.entries.empty()) {
+                    timelines.push_back({timeline.semaphore, timeline.fence, timeline.maxValue, {}});
+                }
+            }
+        }
+        for (const Timeline& timeline : timelines) {
+            if (timeline.semaphore == nullptr && timeline.fence == nullptr) {
+                continue;
+            }
+            RHI_RETURN_IF_FAILED(timeline.semaphore != nullptr ?
+                timeline.semaphore->Wait(timeline.maxValue, timeout) :
+                timeline.fence->Wait(timeline.maxValue, timeout));
+        }
+        auto collected = Collect();
+        RHI_RETURN_IF_FAILED(collected);
+        return MakeSuccessResult();
+    }
+
+    // 尚未销毁的对象数
+    size_t GetPendingCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = 0;
+        for (const Timeline& timeline : m_timelines) {
+            count += timeline.entries.size();
+        }
+        return count;
+    }
+
+    DeferredReleaseStats GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+private:
+    using DestroyFunc = bool (*)(void* object, void* owner);
+
+    struct Entry {
+        void* object;
+        void* owner;                    // 描述符集所属的池（其他对象为nullptr）
+        DestroyFunc destroy;
+        uint64_t value;
+    };
+
+    struct Timeline {
+        ISemaphore* semaphore;
+        IFence* fence;
+        uint64_t maxValue;              // 已记录的最大值
+        std::deque<Entry> entries;
+    };
+
+    struct Pending {
+        void* object;
+        void* owner;
+        DestroyFunc destroy;
+    };
+
+    template<typename T>
+    static bool DeleteObject(void* object, void*) {
+        delete static_cast<T*>(object);
+        return true;
+    }
+
+    static bool FreeDescriptorSet(void* object, void* owner) {
+        return static_cast<IDescriptorPool*>(owner)->FreeDescriptorSet(static_cast<IDescriptorSet*>(object)).IsSuccess();
+    }
+
+    static bool Destroy(const Entry& entry) {
+        return entry.destroy(entry.object, entry.owner);
+    }
+
+    void Push(ISemaphore* semaphore, IFence* fence, uint64_t value, const Pending& pending) {
+        if (pending.object == nullptr) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.releaseRequests;
+        Timeline* target = nullptr;
+        for (Timeline& timeline : m_timelines) {
+            if (timeline.semaphore == semaphore && timeline.fence == fence) {
+                target = &timeline;
+                break;
+            }
+        }
+        if (target == nullptr) {
+            m_timelines.push_back({semaphore, fence, 0, {}});
+            target = &m_timelines.back();
+        }
+        target->maxValue = std::max(target->maxValue, value);
+        target->entries.push_back({pending.object, pending.owner, pending.destroy, value});
+    }
+
+    mutable std::mutex m_mutex;
+    std::vector<Timeline> m_timelines;      // 时间线数量很少（每个队列一个），线性查找
+    std::vector<Entry> m_collected;         // Collect的临时数组（只在Collect线程使用）
+    DeferredReleaseStats m_stats;
+};
+
+} // namespace RHI
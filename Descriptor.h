@@ -1,7 +1,7 @@
 
 #pragma once
 #include "Result.h"
-#include "Descriptor.h"
+#include "Pipeline.h"
 #include <cstdint>
 #include <vector>
 
@@ -14,7 +14,9 @@ enum class DescriptorType {
     Texture,                // 纹理视图
     StorageTexture,        // 存储纹理视图
     Sampler,               // 采样器
-    InputAttachment        // 输入附件
+    InputAttachment,       // 输入附件
+    UniformBufferDynamic,  // 常量缓冲区视图，绑定时附加动态偏移
+    StorageBufferDynamic   // 存储缓冲区视图，绑定时附加动态偏移
 };
 
 // 描述符标志
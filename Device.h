@@ -2,7 +2,10 @@
 #pragma once
 #include "Result.h"
 #include "Adapter.h"
+#include "Buffer.h"
 #include "CommandBuffer.h"
+#include "Synchronization.h"
+#include "Span.h"
 #include <vector>
 
 namespace RHI {
@@ -24,6 +27,14 @@ struct DeviceDesc {
     bool enableDebugMarkers;                 // 是否启用调试标记
 };
 
+// 批量提交中的一次提交（只引用调用方的数组，不复制）
+// 同一批次内的提交按顺序开始执行，后面的提交可以等待前面提交发出的信号量
+struct SubmitDesc {
+    Span<ICommandBuffer* const> commandBuffers;      // 一级命令缓冲区
+    Span<const SemaphoreWaitInfo> waitSemaphores;    // 执行前等待的信号量
+    Span<const SemaphoreSignalInfo> signalSemaphores; // 执行完成后发出的信号量
+};
+
 // 命令队列抽象基类
 class IQueue {
 public:
@@ -42,6 +53,12 @@ public:
         const std::vector<ISemaphore*>& signalSemaphores,
         IFence* fence) = 0;
 
+    // 批量提交：所有提交映射为一次原生提交调用，fence在最后一次提交完成时发出；
+    // 稳定状态下不做堆分配
+    virtual Result<void> SubmitBatch(
+        Span<const SubmitDesc> submits,
+        IFence* fence) = 0;
+
     // 等待队列空闲
     virtual Result<void> WaitIdle() = 0;
 
@@ -118,6 +135,50 @@ public:
     virtual Result<class IMemory*> AllocateMemory(
         const class MemoryDesc& desc) = 0;
 
+    // 一次刷新多个持久映射缓冲区的CPU写入，使其对GPU可见（须在读取它们的提交之前调用）
+    // HostCoherent的缓冲区被跳过，全部跳过时不调用驱动
+    // DirectX12: 无需刷新（上传堆是一致的）
+    // Vulkan: 一次vkFlushMappedMemoryRanges（范围扩展到nonCoherentAtomSize）
+    virtual Result<void> FlushMappedRanges(Span<const MappedRange> ranges) = 0;
+
+    // 查询缓冲区/纹理放置到内存块中所需的大小与对齐（不创建资源）
+    virtual Result<struct ResourceAllocationInfo> GetBufferAllocationInfo(
+        const class BufferDesc& desc) = 0;
+    virtual Result<struct ResourceAllocationInfo> GetTextureAllocationInfo(
+        const class TextureDesc& desc) = 0;
+
+    // 在memory的offset处创建缓冲区/纹理（放置资源）：不分配内存，memory须比资源存活更久。
+    // offset须按Get*AllocationInfo返回的对齐，memory的类型须与desc.memoryType一致（纹理须为MemoryType::Default）。
+    // 多个放置资源可以重叠同一范围（别名）；改用另一个资源前录制BarrierType::Aliasing屏障，之后其内容未定义
+    virtual Result<class IBuffer*> CreatePlacedBuffer(
+        const class BufferDesc& desc,
+        class IMemory* memory,
+        size_t offset) = 0;
+    virtual Result<class ITexture*> CreatePlacedTexture(
+        const class TextureDesc& desc,
+        class IMemory* memory,
+        size_t offset) = 0;
+
+    // 查询设备本地内存的预算与当前占用（开销较小，可每帧调用）
+    virtual Result<struct MemoryBudget> GetMemoryBudget() = 0;
+
+    // 是否支持延迟分配的内存（MemoryPropertyFlag::LazilyAllocated，分块渲染GPU）：支持时TextureUsage::Transient的
+    // 纹理在片上存储中完成渲染，不占用物理内存（内存跟踪中记为0字节）；不支持时按普通纹理分配
+    // DirectX12: 不支持
+    // Vulkan: 存在带VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT的内存类型
+    virtual bool SupportsLazilyAllocatedMemory() const = 0;
+
+    // 设备的内存跟踪器：每个缓冲区、纹理与内存块按desc.tag登记，销毁时移除；
+    // 设备销毁时仍存活的分配会被报告（见MemoryTracker）
+    virtual class MemoryTracker& GetMemoryTracker() = 0;
+
+    // CPU等待多个时间线信号量（waits中的stages被忽略），timeout单位为纳秒，超时返回TimeoutError
+    // waits最多kMaxWaitMultipleSemaphores（32）个，超过时返回InvalidArgument，更多的信号量须分批等待
+    virtual Result<void> WaitMultiple(
+        Span<const SemaphoreWaitInfo> waits,
+        SemaphoreWaitMode mode,
+        uint64_t timeout) = 0;
+
     // 等待设备空闲
     virtual Result<void> WaitIdle() = 0;
 
@@ -2,11 +2,30 @@
 #pragma once
 #include "Result.h"
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace RHI {
 
-// 将错误码转换为可读的字符串描述
-inline std::string GetErrorCodeString(ErrorCode code) {
+// 参数验证级别
+// - OFF:   参数验证完全编译移除（发布版热路径）
+// - CHEAP: 仅执行廉价检查，失败时返回错误码对应的静态消息，不构建字符串
+// - FULL:  执行全部检查并生成完整的诊断消息（调试版）
+// 未显式定义时，调试版使用FULL，定义了NDEBUG的版本使用OFF
+#define RHI_VALIDATION_LEVEL_OFF 0
+#define RHI_VALIDATION_LEVEL_CHEAP 1
+#define RHI_VALIDATION_LEVEL_FULL 2
+
+#ifndef RHI_VALIDATION_LEVEL
+#ifdef NDEBUG
+#define RHI_VALIDATION_LEVEL RHI_VALIDATION_LEVEL_OFF
+#else
+#define RHI_VALIDATION_LEVEL RHI_VALIDATION_LEVEL_FULL
+#endif
+#endif
+
+// 将错误码转换为静态描述（未定义的错误码返回nullptr）
+inline const char* GetErrorCodeName(ErrorCode code) {
     switch (code) {
         case ErrorCode::Success:
             return "成功";
@@ -68,35 +87,95 @@ inline std::string GetErrorCodeString(ErrorCode code) {
             return "Metal错误";
         
         default:
-            return "未定义错误码: " + std::to_string(static_cast<int>(code));
+            return nullptr;
     }
 }
 
+// 将错误码转换为可读的字符串描述
+inline std::string GetErrorCodeString(ErrorCode code) {
+    const char* name = GetErrorCodeName(code);
+    if (name != nullptr) {
+        return name;
+    }
+    return "未定义错误码: " + std::to_string(static_cast<int>(code));
+}
+
+// 构建错误信息（字符串字面量直接引用，可写字符数组与动态消息驻留）
+template<size_t N>
+inline ErrorInfo MakeErrorInfo(ErrorCode code, const char (&message)[N]) {
+    return ErrorInfo{code, message};
+}
+
+template<size_t N>
+inline ErrorInfo MakeErrorInfo(ErrorCode code, char (&message)[N]) {
+    return ErrorInfo{code, InternErrorMessage(message)};
+}
+
+inline ErrorInfo MakeErrorInfo(ErrorCode code, const std::string& message) {
+    return ErrorInfo{code, InternErrorMessage(message)};
+}
+
 // 错误处理宏
+// 错误以ErrorInfo返回，可隐式转换为任意Result<T>
 #define RHI_RETURN_IF_FAILED(result) \
     do { \
         auto&& _result = (result); \
         if (!_result.IsSuccess()) { \
-            return std::move(_result); \
+            return _result.GetError(); \
         } \
     } while (0)
 
 #define RHI_RETURN_IF_FALSE(condition, code, message) \
     do { \
         if (!(condition)) { \
-            return Result<void>::Failure(code, message); \
+            return ::RHI::MakeErrorInfo(code, message); \
+        } \
+    } while (0)
+
+// 参数验证宏
+// RHI_VALIDATE用于廉价检查（CHEAP及以上级别执行），RHI_VALIDATE_FULL用于开销较大的检查
+// （仅FULL级别执行）。只有FULL级别才会对message求值；关闭时条件也不会被求值。
+#if RHI_VALIDATION_LEVEL >= RHI_VALIDATION_LEVEL_FULL
+#define RHI_VALIDATE(condition, code, message) \
+    RHI_RETURN_IF_FALSE(condition, code, message)
+#define RHI_VALIDATE_FULL(condition, code, message) \
+    RHI_RETURN_IF_FALSE(condition, code, message)
+#elif RHI_VALIDATION_LEVEL >= RHI_VALIDATION_LEVEL_CHEAP
+#define RHI_VALIDATE(condition, code, message) \
+    do { \
+        if (!(condition)) { \
+            const char* _name = ::RHI::GetErrorCodeName(code); \
+            return ::RHI::ErrorInfo{code, _name != nullptr ? _name : ""}; \
         } \
     } while (0)
+#define RHI_VALIDATE_FULL(condition, code, message) \
+    do { (void)sizeof(condition); } while (0)
+#else
+#define RHI_VALIDATE(condition, code, message) \
+    do { (void)sizeof(condition); } while (0)
+#define RHI_VALIDATE_FULL(condition, code, message) \
+    do { (void)sizeof(condition); } while (0)
+#endif
 
 // 错误结果构建辅助函数
+template<typename T, size_t N>
+inline Result<T> MakeErrorResult(ErrorCode code, const char (&message)[N]) {
+    return Result<T>::Failure(code, message);
+}
+
+template<typename T, size_t N>
+inline Result<T> MakeErrorResult(ErrorCode code, char (&message)[N]) {
+    return Result<T>::Failure(code, message);
+}
+
 template<typename T>
 inline Result<T> MakeErrorResult(ErrorCode code, const std::string& message) {
     return Result<T>::Failure(code, message);
 }
 
 template<typename T>
-inline Result<T> MakeSuccessResult(const T& value) {
-    return Result<T>::Success(value);
+inline Result<std::decay_t<T>> MakeSuccessResult(T&& value) {
+    return Result<std::decay_t<T>>::Success(std::forward<T>(value));
 }
 
 inline Result<void> MakeSuccessResult() {
@@ -109,9 +188,7 @@ inline auto Then(const Result<T>& result, Func&& func)
     -> decltype(func(result.GetValue()))
 {
     if (!result.IsSuccess()) {
-        return Result<typename std::decay<
-            decltype(func(result.GetValue()).GetValue())
-        >::type>::Failure(result.GetErrorCode(), result.GetErrorMessage());
+        return result.GetError();
     }
     return func(result.GetValue());
 }
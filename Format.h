@@ -1,5 +1,6 @@
 
 #pragma once
+#include <cstdint>
 
 namespace RHI {
 
@@ -285,4 +286,73 @@ enum class Format {
     MAX_FORMAT          // 用于遍历的辅助值
 };
 
+/// @brief 获取格式的块尺寸（像素）
+/// 非压缩格式为1，BC和ASTC 4x4压缩格式为4
+inline uint32_t GetFormatBlockDimension(Format format) {
+    switch (format) {
+        case Format::BC1_RGBA_UNORM: case Format::BC1_RGBA_SRGB:
+        case Format::BC2_UNORM: case Format::BC2_SRGB:
+        case Format::BC3_UNORM: case Format::BC3_SRGB:
+        case Format::BC4_UNORM: case Format::BC4_SNORM:
+        case Format::BC5_UNORM: case Format::BC5_SNORM:
+        case Format::BC6H_UF16: case Format::BC6H_SF16:
+        case Format::BC7_UNORM: case Format::BC7_SRGB:
+        case Format::ASTC_4x4_UNORM: case Format::ASTC_4x4_SRGB:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+/// @brief 获取格式每个块的字节数
+/// 非压缩格式即每像素字节数，未知格式返回0
+inline uint32_t GetFormatBlockSize(Format format) {
+    switch (format) {
+        case Format::R8_UNORM: case Format::R8_SNORM:
+        case Format::R8_UINT: case Format::R8_SINT:
+            return 1;
+
+        case Format::RG8_UNORM: case Format::RG8_SNORM:
+        case Format::RG8_UINT: case Format::RG8_SINT:
+        case Format::R16_UNORM: case Format::R16_SNORM:
+        case Format::R16_UINT: case Format::R16_SINT: case Format::R16_FLOAT:
+        case Format::D16_UNORM:
+            return 2;
+
+        case Format::RGBA8_UNORM: case Format::RGBA8_SNORM:
+        case Format::RGBA8_UINT: case Format::RGBA8_SINT: case Format::RGBA8_SRGB:
+        case Format::BGRA8_UNORM: case Format::BGRA8_SRGB:
+        case Format::RG16_UNORM: case Format::RG16_SNORM:
+        case Format::RG16_UINT: case Format::RG16_SINT: case Format::RG16_FLOAT:
+        case Format::R32_UINT: case Format::R32_SINT: case Format::R32_FLOAT:
+        case Format::RGB10A2_UNORM: case Format::RGB10A2_UINT:
+        case Format::RG11B10_FLOAT: case Format::RGB9E5_FLOAT:
+        case Format::D24_UNORM_S8_UINT: case Format::D32_FLOAT:
+            return 4;
+
+        case Format::RGBA16_UNORM: case Format::RGBA16_SNORM:
+        case Format::RGBA16_UINT: case Format::RGBA16_SINT: case Format::RGBA16_FLOAT:
+        case Format::RG32_UINT: case Format::RG32_SINT: case Format::RG32_FLOAT:
+        case Format::D32_FLOAT_S8_UINT:
+        case Format::BC1_RGBA_UNORM: case Format::BC1_RGBA_SRGB:
+        case Format::BC4_UNORM: case Format::BC4_SNORM:
+            return 8;
+
+        case Format::RGB32_UINT: case Format::RGB32_SINT: case Format::RGB32_FLOAT:
+            return 12;
+
+        case Format::RGBA32_UINT: case Format::RGBA32_SINT: case Format::RGBA32_FLOAT:
+        case Format::BC2_UNORM: case Format::BC2_SRGB:
+        case Format::BC3_UNORM: case Format::BC3_SRGB:
+        case Format::BC5_UNORM: case Format::BC5_SNORM:
+        case Format::BC6H_UF16: case Format::BC6H_SF16:
+        case Format::BC7_UNORM: case Format::BC7_SRGB:
+        case Format::ASTC_4x4_UNORM: case Format::ASTC_4x4_SRGB:
+            return 16;
+
+        default:
+            return 0;
+    }
+}
+
 } // namespace RHI
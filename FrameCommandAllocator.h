@@ -0,0 +1,213 @@
+#pragma once
+#include "CommandPool.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "Synchronization.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace RHI {
+
+constexpr uint32_t kFrameAllocatorQueueTypeCount = 4;   // QueueType的取值数
+
+// 帧命令分配器描述
+struct FrameCommandAllocatorDesc {
+    uint32_t framesInFlight;       // 同时在GPU上执行的最大帧数（命令池环的长度）
+    uint32_t threadCount;          // 录制线程数（每个线程使用独立的命令池）
+
+    FrameCommandAllocatorDesc() :
+        framesInFlight(2),
+        threadCount(1) {}
+};
+
+// 帧命令分配器统计
+struct FrameCommandAllocatorStats {
+    uint64_t commandPoolCreations = 0;        // 创建的命令池数
+    uint64_t commandBufferAllocations = 0;    // 从命令池新分配的命令缓冲区数（热身后应保持不变）
+    uint64_t commandBufferReuses = 0;         // 复用已有命令缓冲区的次数
+    uint64_t poolResets = 0;                  // 命令池重置次数
+    uint64_t fenceStalls = 0;                 // BeginFrame时GPU尚未完成、需要阻塞等待的次数（栅栏或时间线信号量）
+};
+
+// 帧命令分配器
+// 为每个帧槽位、队列类型与录制线程维护一个瞬态命令池，命令池在第一次使用时创建。
+// 每个帧槽位记录其提交所发出的栅栏值或时间线信号量值；BeginFrame轮转到framesInFlight帧之前使用过的槽位，
+// 等待这些值（GPU落后时阻塞，即帧节流），重置命令池并复用其中的命令缓冲区。
+// 热身之后不再创建命令池或分配命令缓冲区，可以通过GetStats().commandBufferAllocations验证。
+// 线程安全：BeginFrame/TrackSubmission/Submit须在帧线程调用；不同threadIndex的Allocate可以并发调用。
+class FrameCommandAllocator {
+public:
+    FrameCommandAllocator(IDevice* device, const FrameCommandAllocatorDesc& desc = FrameCommandAllocatorDesc())
+        : m_device(device), m_desc(desc) {}
+
+    FrameCommandAllocator(const FrameCommandAllocator&) = delete;
+    FrameCommandAllocator& operator=(const FrameCommandAllocator&) = delete;
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_device != nullptr, ErrorCode::InvalidArgument, "帧命令分配器的设备不能为空");
+        RHI_VALIDATE(m_desc.framesInFlight > 0 && m_desc.threadCount > 0,
+            ErrorCode::InvalidArgument, "framesInFlight与threadCount必须大于0");
+        m_slots.resize(m_desc.framesInFlight);
+        for (FrameSlot& slot : m_slots) {
+            for (QueueSlot& queue : slot.queues) {
+                queue.threads.resize(m_desc.threadCount);
+            }
+        }
+        return MakeSuccessResult();
+    }
+
+    // 开始新的一帧：等待该槽位上一轮的提交完成，然后重置并回收其命令池
+    Result<void> BeginFrame() {
+        RHI_VALIDATE(!m_slots.empty(), ErrorCode::InvalidOperation, "BeginFrame必须在Initialize之后调用");
+        ++m_frameCount;
+        FrameSlot& slot = GetCurrentSlot();
+        for (QueueSlot& queue : slot.queues) {
+            for (const SyncPoint& syncPoint : queue.syncPoints) {
+                auto completed = syncPoint.fence != nullptr ? syncPoint.fence->GetValue() : syncPoint.semaphore->GetValue();
+                RHI_RETURN_IF_FAILED(completed);
+                if (completed.GetValue() < syncPoint.value) {
+                    ++m_fenceStalls;
+                    RHI_RETURN_IF_FAILED(syncPoint.fence != nullptr ?
+                        syncPoint.fence->Wait(syncPoint.value, UINT64_MAX) :
+                        syncPoint.semaphore->Wait(syncPoint.value, UINT64_MAX));
+                }
+            }
+            queue.syncPoints.clear();
+            for (ThreadPool& thread : queue.threads) {
+                if (thread.used == 0) {
+                    continue;
+                }
+                RHI_RETURN_IF_FAILED(thread.pool->Reset());
+                thread.used = 0;
+                ++m_poolResets;
+            }
+        }
+        return MakeSuccessResult();
+    }
+
+    // 获取当前帧可录制的一级命令缓冲区（已重置，尚未Begin）
+    Result<ICommandBuffer*> Allocate(QueueType type, uint32_t threadIndex = 0) {
+        RHI_VALIDATE(m_frameCount > 0, ErrorCode::InvalidOperation, "Allocate必须在BeginFrame之后调用");
+        RHI_VALIDATE(static_cast<uint32_t>(type) < kFrameAllocatorQueueTypeCount && threadIndex < m_desc.threadCount,
+            ErrorCode::InvalidArgument, "无效的队列类型或线程索引");
+        ThreadPool& thread = GetCurrentSlot().queues[static_cast<uint32_t>(type)].threads[threadIndex];
+        if (thread.used < thread.buffers.size()) {
+            m_commandBufferReuses.fetch_add(1, std::memory_order_relaxed);
+            return MakeSuccessResult(thread.buffers[thread.used++]);
+        }
+
+        if (!thread.pool) {
+            auto pool = m_device->CreateCommandPool(type, true);
+            RHI_RETURN_IF_FAILED(pool);
+            thread.pool.reset(pool.GetValue());
+            m_commandPoolCreations.fetch_add(1, std::memory_order_relaxed);
+        }
+        auto buffers = thread.pool->AllocateCommandBuffers(CommandBufferAllocateInfo());
+        RHI_RETURN_IF_FAILED(buffers);
+        m_commandBufferAllocations.fetch_add(1, std::memory_order_relaxed);
+        thread.buffers.push_back(buffers.GetValue()[0]);
+        return MakeSuccessResult(thread.buffers[thread.used++]);
+    }
+
+    // 记录当前帧在type队列上的一次提交；BeginFrame回收该槽位前会等待fence到达value
+    void TrackSubmission(QueueType type, IFence* fence, uint64_t value) {
+        TrackSyncPoint(type, fence, nullptr, value);
+    }
+
+    // 记录当前帧在type队列上的一次提交；BeginFrame回收该槽位前会等待时间线信号量到达value
+    void TrackSubmission(QueueType type, ISemaphore* semaphore, uint64_t value) {
+        TrackSyncPoint(type, nullptr, semaphore, value);
+    }
+
+    // 提交并记录栅栏值
+    Result<void> Submit(
+        QueueType type,
+        IQueue* queue,
+        const std::vector<ICommandBuffer*>& commandBuffers,
+        const std::vector<ISemaphore*>& waitSemaphores,
+        const std::vector<ISemaphore*>& signalSemaphores,
+        IFence* fence) {
+        RHI_VALIDATE(queue != nullptr && fence != nullptr, ErrorCode::InvalidArgument, "提交需要队列与栅栏");
+        RHI_RETURN_IF_FAILED(queue->Submit(commandBuffers, waitSemaphores, signalSemaphores, fence));
+        TrackSubmission(type, fence, fence->GetLastSubmittedValue());
+        return MakeSuccessResult();
+    }
+
+    // 批量提交并记录栅栏值
+    Result<void> SubmitBatch(
+        QueueType type,
+        IQueue* queue,
+        Span<const SubmitDesc> submits,
+        IFence* fence) {
+        RHI_VALIDATE(queue != nullptr && fence != nullptr, ErrorCode::InvalidArgument, "提交需要队列与栅栏");
+        RHI_RETURN_IF_FAILED(queue->SubmitBatch(submits, fence));
+        TrackSubmission(type, fence, fence->GetLastSubmittedValue());
+        return MakeSuccessResult();
+    }
+
+    // 已开始的帧数
+    uint64_t GetFrameCount() const { return m_frameCount; }
+
+    FrameCommandAllocatorStats GetStats() const {
+        FrameCommandAllocatorStats stats;
+        stats.commandPoolCreations = m_commandPoolCreations.load(std::memory_order_relaxed);
+        stats.commandBufferAllocations = m_commandBufferAllocations.load(std::memory_order_relaxed);
+        stats.commandBufferReuses = m_commandBufferReuses.load(std::memory_order_relaxed);
+        stats.poolResets = m_poolResets;
+        stats.fenceStalls = m_fenceStalls;
+        return stats;
+    }
+
+private:
+    // 栅栏或时间线信号量上的一个值
+    struct SyncPoint {
+        IFence* fence;
+        ISemaphore* semaphore;
+        uint64_t value;
+    };
+
+    struct ThreadPool {
+        std::unique_ptr<ICommandPool> pool;     // 命令池拥有其中的命令缓冲区
+        std::vector<ICommandBuffer*> buffers;
+        uint32_t used = 0;                       // 当前帧已取出的命令缓冲区数
+    };
+
+    struct QueueSlot {
+        std::vector<ThreadPool> threads;
+        std::vector<SyncPoint> syncPoints;       // 本槽位的提交发出的值
+    };
+
+    struct FrameSlot {
+        QueueSlot queues[kFrameAllocatorQueueTypeCount];
+    };
+
+    void TrackSyncPoint(QueueType type, IFence* fence, ISemaphore* semaphore, uint64_t value) {
+        std::vector<SyncPoint>& syncPoints = GetCurrentSlot().queues[static_cast<uint32_t>(type)].syncPoints;
+        for (SyncPoint& syncPoint : syncPoints) {
+            if (syncPoint.fence == fence && syncPoint.semaphore == semaphore) {
+                syncPoint.value = std::max(syncPoint.value, value);
+                return;
+            }
+        }
+        syncPoints.push_back({fence, semaphore, value});
+    }
+
+    FrameSlot& GetCurrentSlot() {
+        return m_slots[(m_frameCount - 1) % m_slots.size()];
+    }
+
+    IDevice* m_device;
+    FrameCommandAllocatorDesc m_desc;
+    std::vector<FrameSlot> m_slots;
+    uint64_t m_frameCount = 0;
+    std::atomic<uint64_t> m_commandPoolCreations{0};
+    std::atomic<uint64_t> m_commandBufferAllocations{0};
+    std::atomic<uint64_t> m_commandBufferReuses{0};
+    uint64_t m_poolResets = 0;
+    uint64_t m_fenceStalls = 0;
+};
+
+} // namespace RHI
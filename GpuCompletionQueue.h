@@ -0,0 +1,322 @@
+#pragma once
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "Synchronization.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 以C++20编译时提供co_await形式的等待
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define RHI_HAS_COROUTINES 1
+#endif
+#endif
+
+namespace RHI {
+
+// 等待完成时的回调（失败时为设备错误，或队列关闭时的InvalidOperation）
+using GpuCompletionCallback = std::function<void(Result<void>)>;
+
+// 执行器：把回调投递到用户的线程（池）上执行；为空时回调在完成线程上直接执行
+using GpuCompletionExecutor = std::function<void(std::function<void()>)>;
+
+constexpr uint64_t kGpuCompletionPollInterval = 1000000;     // 等待栅栏时的轮询间隔（纳秒）
+constexpr uint32_t kGpuCompletionMaxWaitSemaphores = 32;     // 单次WaitMultiple的信号量数
+
+// GPU完成队列统计
+struct GpuCompletionStats {
+    uint64_t watches = 0;          // WhenReached调用次数
+    uint64_t immediate = 0;        // 调用时已到达、直接投递的次数
+    uint64_t completions = 0;      // 由完成线程投递的次数
+    uint64_t wakeups = 0;          // 完成线程被唤醒的次数
+};
+
+#if RHI_HAS_COROUTINES
+class GpuWaitAwaitable;
+#endif
+
+// GPU完成队列
+// 每个设备一个后台完成线程：用IDevice::WaitMultiple(Any)同时等待所有被关注的时间线信号量与一个内部唤醒信号量，
+// 值到达后把回调投递到执行器上，等待大量GPU操作时不需要为每个操作占用一个线程。
+// 栅栏不能参与WaitMultiple，存在栅栏等待者时完成线程按kGpuCompletionPollInterval轮询。
+// 线程安全：WhenReached可在任意线程调用。析构（或Shutdown）时未完成的等待以InvalidOperation回调。
+// 以C++20编译时还可以co_await WhenReached(timeline, value)，协程在执行器上恢复。
+class GpuCompletionQueue {
+public:
+    GpuCompletionQueue(IDevice* device, GpuCompletionExecutor executor = GpuCompletionExecutor())
+        : m_device(device), m_executor(std::move(executor)) {}
+
+    GpuCompletionQueue(const GpuCompletionQueue&) = delete;
+    GpuCompletionQueue& operator=(const GpuCompletionQueue&) = delete;
+
+    ~GpuCompletionQueue() {
+        Shutdown();
+    }
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_device != nullptr, ErrorCode::InvalidArgument, "GPU完成队列需要一个设备");
+        RHI_VALIDATE(!m_thread.joinable(), ErrorCode::InvalidOperation, "完成线程已在运行，不能重复Initialize");
+        SemaphoreDesc semaphoreDesc;
+        semaphoreDesc.binary = false;
+        auto wake = m_device->CreateSemaphore(semaphoreDesc);
+        RHI_RETURN_IF_FAILED(wake);
+        m_wake.reset(wake.GetValue());
+        m_running = true;
+        m_thread = std::thread([this]() { Run(); });
+        return MakeSuccessResult();
+    }
+
+    // timeline到达value后在执行器上调用callback
+    void WhenReached(ISemaphore* timeline, uint64_t value, GpuCompletionCallback callback) {
+        Watch(timeline, nullptr, value, timeline != nullptr && IsReached(timeline, value), std::move(callback));
+    }
+
+    // fence到达value后在执行器上调用callback
+    void WhenReached(IFence* fence, uint64_t value, GpuCompletionCallback callback) {
+        Watch(nullptr, fence, value, fence != nullptr && IsReached(fence, value), std::move(callback));
+    }
+
+#if RHI_HAS_COROUTINES
+    // co_await queue.WhenReached(timeline, value)，结果为Result<void>
+    GpuWaitAwaitable WhenReached(ISemaphore* timeline, uint64_t value);
+    GpuWaitAwaitable WhenReached(IFence* fence, uint64_t value);
+#endif
+
+    // 停止完成线程，未完成的等待以InvalidOperation回调
+    void Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) {
+                return;
+            }
+            m_running = false;
+            WakeLocked();
+        }
+        m_thread.join();
+        std::vector<Waiter> abandoned;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            abandoned.swap(m_waiters);
+        }
+        for (Waiter& waiter : abandoned) {
+            Dispatch(std::move(waiter.callback),
+                Result<void>(ErrorInfo{ErrorCode::InvalidOperation, "GPU完成队列已关闭"}));
+        }
+    }
+
+    // 尚未完成的等待数
+    size_t GetPendingCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_waiters.size();
+    }
+
+    GpuCompletionStats GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+private:
+#if RHI_HAS_COROUTINES
+    friend class GpuWaitAwaitable;
+#endif
+
+    struct Waiter {
+        ISemaphore* semaphore;
+        IFence* fence;
+        uint64_t value;
+        GpuCompletionCallback callback;
+    };
+
+    static bool IsReached(ISemaphore* semaphore, uint64_t value) {
+        auto current = semaphore->GetValue();
+        return current.IsSuccess() && current.GetValue() >= value;
+    }
+
+    static bool IsReached(IFence* fence, uint64_t value) {
+        auto current = fence->GetValue();
+        return current.IsSuccess() && current.GetValue() >= value;
+    }
+
+    // 等待者恰好持有信号量与栅栏之一（Watch拒绝两者都为空的等待）
+    static bool IsReached(const Waiter& waiter) {
+        return waiter.semaphore != nullptr
+            ? IsReached(waiter.semaphore, waiter.value)
+            : IsReached(waiter.fence, waiter.value);
+    }
+
+    void Dispatch(GpuCompletionCallback callback, Result<void> result) {
+        if (m_executor) {
+            m_executor([callback = std::move(callback), result]() { callback(result); });
+        } else {
+            callback(result);
+        }
+    }
+
+    // reached由WhenReached按对象的类型检查，信号量与栅栏的路径互不经过对方的空指针
+    void Watch(ISemaphore* semaphore, IFence* fence, uint64_t value, bool reached, GpuCompletionCallback callback) {
+        if (semaphore == nullptr && fence == nullptr) {
+            Dispatch(std::move(callback), Result<void>(ErrorInfo{ErrorCode::InvalidArgument, "等待对象不能为空"}));
+            return;
+        }
+        if (reached) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_stats.watches;
+                ++m_stats.immediate;
+            }
+            Dispatch(std::move(callback), MakeSuccessResult());
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_running) {
+                ++m_stats.watches;
+                m_waiters.push_back({semaphore, fence, value, std::move(callback)});
+                WakeLocked();
+                return;
+            }
+        }
+        Dispatch(std::move(callback), Result<void>(ErrorInfo{ErrorCode::InvalidOperation, "GPU完成队列未运行"}));
+    }
+
+    // 在持有m_mutex时调用，保证唤醒值递增
+    void WakeLocked() {
+        (void)m_wake->Signal(++m_wakeValue);
+    }
+
+    void Run() {
+        std::vector<SemaphoreWaitInfo> waits;
+        std::vector<Waiter> ready;
+        uint64_t observedWake = 0;
+        while (true) {
+            bool poll = false;
+            waits.clear();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_running) {
+                    return;
+                }
+                ++m_stats.wakeups;
+                waits.push_back(SemaphoreWaitInfo(m_wake.get(), observedWake + 1));
+                for (const Waiter& waiter : m_waiters) {
+                    if (waiter.semaphore == nullptr) {
+                        poll = true;
+                        continue;
+                    }
+                    // 同一个信号量只等待最小的值
+                    bool merged = false;
+                    for (SemaphoreWaitInfo& wait : waits) {
+                        if (wait.semaphore == waiter.semaphore) {
+                            wait.value = std::min(wait.value, waiter.value);
+                            merged = true;
+                            break;
+                        }
+                    }
+                    if (!merged) {
+                        if (waits.size() < kGpuCompletionMaxWaitSemaphores) {
+                            waits.push_back(SemaphoreWaitInfo(waiter.semaphore, waiter.value));
+                        } else {
+                            poll = true;
+                        }
+                    }
+                }
+            }
+
+            Result<void> waited = m_device->WaitMultiple(waits, SemaphoreWaitMode::Any,
+                poll ? kGpuCompletionPollInterval : UINT64_MAX);
+            bool failed = !waited.IsSuccess() && waited.GetErrorCode() != ErrorCode::TimeoutError;
+            auto wakeValue = m_wake->GetValue();
+            if (wakeValue.IsSuccess()) {
+                observedWake = wakeValue.GetValue();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (size_t i = 0; i < m_waiters.size();) {
+                    Waiter& waiter = m_waiters[i];
+                    if (failed || IsReached(waiter)) {
+                        ready.push_back(std::move(waiter));
+                        waiter = std::move(m_waiters.back());
+                        m_waiters.pop_back();
+                    } else {
+                        ++i;
+                    }
+                }
+                m_stats.completions += ready.size();
+            }
+            for (Waiter& waiter : ready) {
+                Dispatch(std::move(waiter.callback), failed ? waited : MakeSuccessResult());
+            }
+            ready.clear();
+        }
+    }
+
+    IDevice* m_device;
+    GpuCompletionExecutor m_executor;
+    std::unique_ptr<ISemaphore> m_wake;    // 新的等待或关闭时由主机端发出，打断完成线程的WaitMultiple
+    uint64_t m_wakeValue = 0;
+    mutable std::mutex m_mutex;
+    std::vector<Waiter> m_waiters;
+    bool m_running = false;
+    std::thread m_thread;
+    GpuCompletionStats m_stats;
+};
+
+#if RHI_HAS_COROUTINES
+// WhenReached的可等待对象：值已到达时不挂起，否则由完成队列在执行器上恢复协程
+class GpuWaitAwaitable {
+public:
+    GpuWaitAwaitable(GpuCompletionQueue& queue, ISemaphore* semaphore, IFence* fence, uint64_t value)
+        : m_queue(queue), m_semaphore(semaphore), m_fence(fence), m_value(value) {}
+
+    bool await_ready() const {
+        if (m_semaphore != nullptr) {
+            return GpuCompletionQueue::IsReached(m_semaphore, m_value);
+        }
+        return m_fence != nullptr && GpuCompletionQueue::IsReached(m_fence, m_value);
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        auto resume = [this, handle](Result<void> result) {
+            m_error = result.IsSuccess() ? ErrorInfo{ErrorCode::Success, nullptr} : result.GetError();
+            handle.resume();
+        };
+        if (m_semaphore != nullptr) {
+            m_queue.WhenReached(m_semaphore, m_value, resume);
+        } else {
+            m_queue.WhenReached(m_fence, m_value, resume);
+        }
+    }
+
+    Result<void> await_resume() const {
+        if (m_error.code != ErrorCode::Success) {
+            return Result<void>(m_error);
+        }
+        return MakeSuccessResult();
+    }
+
+private:
+    GpuCompletionQueue& m_queue;
+    ISemaphore* m_semaphore;
+    IFence* m_fence;
+    uint64_t m_value;
+    ErrorInfo m_error = ErrorInfo{ErrorCode::Success, nullptr};
+};
+
+inline GpuWaitAwaitable GpuCompletionQueue::WhenReached(ISemaphore* timeline, uint64_t value) {
+    return GpuWaitAwaitable(*this, timeline, nullptr, value);
+}
+
+inline GpuWaitAwaitable GpuCompletionQueue::WhenReached(IFence* fence, uint64_t value) {
+    return GpuWaitAwaitable(*this, nullptr, fence, value);
+}
+#endif
+
+} // namespace RHI
@@ -0,0 +1,110 @@
+#pragma once
+#include "Buffer.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace RHI {
+
+// 脏范围批次统计
+struct MappedRangeBatchStats {
+    uint64_t added = 0;            // 累计Add的范围数
+    uint64_t skippedCoherent = 0;  // HostCoherent缓冲区上被跳过的范围数
+    uint64_t merged = 0;           // 与相邻或重叠范围合并掉的范围数
+    uint64_t flushes = 0;          // 调用IDevice::FlushMappedRanges的次数
+    uint64_t flushedRanges = 0;    // 交给FlushMappedRanges的范围数
+};
+
+// 持久映射缓冲区的脏范围批次
+// 通过IBuffer::GetMappedData写入后Add写入的范围，提交前Flush一次把整批交给IDevice::FlushMappedRanges，
+// 取代每次写入都Map/Unmap或逐个刷新：
+// - HostCoherent缓冲区上的范围在Add时即被跳过，整批都在一致内存上时Flush不调用设备
+// - 同一缓冲区相邻或重叠的范围合并为一个（流式顶点数据通常顺序写入）
+// 非线程安全：每个录制线程一个批次，或在提交线程上汇总。
+class MappedRangeBatch {
+public:
+    explicit MappedRangeBatch(IDevice* device)
+        : m_device(device) {}
+
+    MappedRangeBatch(const MappedRangeBatch&) = delete;
+    MappedRangeBatch& operator=(const MappedRangeBatch&) = delete;
+
+    // 记录buffer中CPU写入过的范围
+    void Add(IBuffer* buffer, size_t offset, size_t size) {
+        ++m_stats.added;
+        if (size == 0) {
+            return;
+        }
+        if (buffer->IsHostCoherent()) {
+            ++m_stats.skippedCoherent;
+            return;
+        }
+        if (!m_ranges.empty()) {
+            MappedRange& last = m_ranges.back();
+            if (last.buffer == buffer && offset <= last.offset + last.size && last.offset <= offset + size) {
+                size_t end = std::max(last.offset + last.size, offset + size);
+                last.offset = std::min(last.offset, offset);
+                last.size = end - last.offset;
+                ++m_stats.merged;
+                return;
+            }
+        }
+        m_ranges.push_back(MappedRange{buffer, offset, size});
+    }
+
+    // 把记录的范围合并后一次交给设备，然后清空批次
+    Result<void> Flush() {
+        if (m_ranges.empty()) {
+            return MakeSuccessResult();
+        }
+        Coalesce();
+        ++m_stats.flushes;
+        m_stats.flushedRanges += m_ranges.size();
+        Result<void> result = m_device->FlushMappedRanges(Span<const MappedRange>(m_ranges.data(), m_ranges.size()));
+        m_ranges.clear();
+        return result;
+    }
+
+    // Flush后提交（每次提交一个刷新批次）
+    Result<void> Submit(IQueue* queue, Span<const SubmitDesc> submits, IFence* fence = nullptr) {
+        RHI_RETURN_IF_FAILED(Flush());
+        return queue->SubmitBatch(submits, fence);
+    }
+
+    // 尚未刷新的范围数
+    size_t GetPendingCount() const { return m_ranges.size(); }
+
+    const MappedRangeBatchStats& GetStats() const { return m_stats; }
+
+private:
+    // 按缓冲区与偏移排序，合并同一缓冲区相邻或重叠的范围
+    void Coalesce() {
+        if (m_ranges.size() < 2) {
+            return;
+        }
+        std::sort(m_ranges.begin(), m_ranges.end(), [](const MappedRange& a, const MappedRange& b) {
+            return a.buffer != b.buffer ? std::less<IBuffer*>()(a.buffer, b.buffer) : a.offset < b.offset;
+        });
+        size_t count = 1;
+        for (size_t i = 1; i < m_ranges.size(); ++i) {
+            MappedRange& last = m_ranges[count - 1];
+            const MappedRange& range = m_ranges[i];
+            if (range.buffer == last.buffer && range.offset <= last.offset + last.size) {
+                last.size = std::max(last.offset + last.size, range.offset + range.size) - last.offset;
+                ++m_stats.merged;
+            } else {
+                m_ranges[count++] = range;
+            }
+        }
+        m_ranges.resize(count);
+    }
+
+    IDevice* m_device;
+    std::vector<MappedRange> m_ranges;
+    MappedRangeBatchStats m_stats;
+};
+
+} // namespace RHI
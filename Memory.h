@@ -2,6 +2,7 @@
 #pragma once
 #include "Result.h"
 #include <cstdint>
+#include <vector>
 
 namespace RHI {
 
@@ -25,6 +26,25 @@ enum class MemoryType {
     Custom              // 自定义内存类型（用于特殊需求）
 };
 
+// 内存标签：分配所属的子系统与创建位置，MemoryTracker按name汇总
+// name与callsite须指向静态字符串；RHI_MEMORY_TAG("shadow")同时记录调用位置
+struct MemoryTag {
+    const char* name;              // 子系统名称（nullptr表示未标记）
+    const char* callsite;          // 创建位置（"文件:行"）
+
+    MemoryTag() :
+        name(nullptr),
+        callsite(nullptr) {}
+
+    MemoryTag(const char* name, const char* callsite = nullptr) :
+        name(name),
+        callsite(callsite) {}
+};
+
+#define RHI_MEMORY_TAG_STRINGIFY_IMPL(x) #x
+#define RHI_MEMORY_TAG_STRINGIFY(x) RHI_MEMORY_TAG_STRINGIFY_IMPL(x)
+#define RHI_MEMORY_TAG(name) ::RHI::MemoryTag(name, __FILE__ ":" RHI_MEMORY_TAG_STRINGIFY(__LINE__))
+
 // 内存属性标志（可组合）
 enum class MemoryPropertyFlag : uint32_t {
     None                = 0,
@@ -53,12 +73,33 @@ struct MemoryAllocationInfo {
 // 内存统计信息
 struct MemoryStats {
     size_t totalSize;              // 总大小
-    size_t usedSize;               // 已使用大小
+    size_t usedSize;               // 已使用大小（含对齐粒度的舍入）
     size_t largestFreeBlock;       // 最大空闲块
     size_t freeCount;              // 空闲块数量
     float fragmentation;           // 碎片化程度（0-1）
 };
 
+// 内存块中的一段（IMemory::GetLayout）
+struct MemoryRegion {
+    size_t offset;                 // 在内存块中的偏移
+    size_t size;                   // 大小（字节）
+    bool free;                     // 是否空闲
+};
+
+// 放置资源的内存需求（IDevice::GetBufferAllocationInfo/GetTextureAllocationInfo）
+struct ResourceAllocationInfo {
+    size_t size;                   // 资源在内存块中占用的字节数
+    size_t alignment;              // 资源在内存块中的偏移须对齐到此值
+};
+
+// 设备本地内存的预算
+// DirectX12: DXGI_QUERY_VIDEO_MEMORY_INFO
+// Vulkan: VK_EXT_memory_budget（不支持时预算为设备本地堆的大小，占用为0）
+struct MemoryBudget {
+    uint64_t budget;               // 操作系统允许本进程使用的字节数（随系统压力变化）
+    uint64_t usage;                // 本进程当前占用的字节数
+};
+
 // 内存描述
 struct MemoryDesc {
     MemoryType type;               // 内存类型
@@ -66,6 +107,7 @@ struct MemoryDesc {
     size_t size;                  // 内存大小
     size_t alignment;             // 对齐要求
     bool dedicated;               // 是否专用内存
+    MemoryTag tag;                // 内存标签
 
     MemoryDesc() :
         type(MemoryType::Default),
@@ -120,9 +162,16 @@ public:
     virtual Result<MemoryAllocationInfo> GetAllocationInfo(
         void* allocation) const = 0;
 
+    // 获取分配在内存块中的偏移
+    virtual Result<size_t> GetAllocationOffset(
+        void* allocation) const = 0;
+
     // 获取内存统计信息
     virtual Result<MemoryStats> GetStats() const = 0;
 
+    // 按偏移顺序列出已分配与空闲的区段（内存快照用）
+    virtual Result<void> GetLayout(std::vector<MemoryRegion>& regions) const = 0;
+
     // 检查内存类型是否支持指定属性
     virtual Result<bool> IsMemoryTypeSupported(
         MemoryType type,
@@ -134,15 +183,18 @@ public:
         MemoryPropertyFlag preferredProperties) const = 0;
 
     // 合并空闲块（碎片整理）
+    // 不移动任何分配；空闲块在Free时已与相邻空闲块合并的实现可以直接返回成功。
+    // 移动分配以消除碎片见MemoryDefragmenter
     virtual Result<void> Defragment() = 0;
 
     // 设置内存优先级（影响驻留策略）
     virtual Result<void> SetPriority(uint32_t priority) = 0;
 
     // 使内存驻留（确保在GPU内存中）
+    // 何时驻留、何时逐出由ResidencyManager按预算决定
     virtual Result<void> MakeResident() = 0;
 
-    // 解除内存驻留
+    // 解除内存驻留（GPU不得再访问其中的资源，直到再次MakeResident）
     virtual Result<void> Evict() = 0;
 
 protected:
@@ -0,0 +1,288 @@
+#pragma once
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "Memory.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RHI {
+
+// 内存分配器描述
+struct MemoryAllocatorDesc {
+    size_t blockSize;              // 每次向设备申请的内存块大小
+    size_t dedicatedThreshold;     // 不小于此大小的请求使用专用内存块
+    uint32_t maxMemoryObjects;     // 设备内存对象数上限（DeviceLimits::maxMemoryAllocationCount，0表示不限制）
+
+    MemoryAllocatorDesc() :
+        blockSize(64ull * 1024 * 1024),
+        dedicatedThreshold(32ull * 1024 * 1024),
+        maxMemoryObjects(0) {}
+};
+
+// 子分配结果
+struct MemoryAllocation {
+    IMemory* memory = nullptr;     // 所在内存块（专用分配独占一个内存块）
+    void* allocation = nullptr;    // IMemory::Allocate返回的句柄
+    size_t offset = 0;             // 在内存块中的偏移
+    size_t size = 0;               // 请求大小
+    MemoryType type = MemoryType::Default;
+    bool dedicated = false;
+};
+
+// 内存分配器统计
+struct MemoryAllocatorStats {
+    uint32_t blockCount = 0;           // 共享内存块数
+    uint32_t dedicatedCount = 0;       // 专用内存块数
+    uint64_t allocationCount = 0;      // 存活的分配数
+    uint64_t blockAllocations = 0;     // 累计向设备申请内存块的次数
+};
+
+// 通用GPU内存分配器
+// 按MemoryType维护若干大内存块（IDevice::AllocateMemory），把MemoryAllocationInfo请求切分到块中；
+// 块内由IMemory实现的TLSF完成O(1)的分配与释放。请求dedicated或不小于dedicatedThreshold时独占一个内存块。
+// 块满时申请新块；每种类型最多保留一个空块，其余空块立即归还设备，避免在边界上反复申请。
+// 线程安全。
+class MemoryAllocator {
+public:
+    MemoryAllocator(IDevice* device, const MemoryAllocatorDesc& desc = MemoryAllocatorDesc())
+        : m_device(device), m_desc(desc) {}
+
+    MemoryAllocator(const MemoryAllocator&) = delete;
+    MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+    ~MemoryAllocator() = default;
+
+    Result<MemoryAllocation> Allocate(const MemoryAllocationInfo& info) {
+        RHI_VALIDATE(info.size > 0, ErrorCode::InvalidArgument, "分配大小必须大于0");
+        RHI_VALIDATE(info.alignment == 0 || (info.alignment & (info.alignment - 1)) == 0,
+            ErrorCode::InvalidArgument,
+            "对齐要求必须为2的幂: " + std::to_string(info.alignment));
+        RHI_VALIDATE(static_cast<uint32_t>(info.type) < kMemoryTypeCount,
+            ErrorCode::InvalidArgument,
+            "无效的内存类型");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Pool& pool = m_pools[static_cast<uint32_t>(info.type)];
+        if (info.dedicated || info.size >= m_desc.dedicatedThreshold || info.size > m_desc.blockSize) {
+            auto memory = CreateBlock(info, info.size, true);
+            RHI_RETURN_IF_FAILED(memory);
+            auto allocation = Carve(memory.GetValue(), info, true);
+            if (!allocation.IsSuccess()) {
+                DestroyBlock(memory.GetValue());
+                return allocation;
+            }
+            pool.dedicated.emplace_back(memory.GetValue());
+            ++m_stats.dedicatedCount;
+            ++m_stats.allocationCount;
+            return allocation;
+        }
+
+        // 先尝试最近使用的块
+        for (size_t i = pool.blocks.size(); i-- > 0;) {
+            auto allocation = Carve(pool.blocks[i].get(), info, false);
+            if (allocation.IsSuccess()) {
+                ++m_stats.allocationCount;
+                return allocation;
+            }
+        }
+
+        auto memory = CreateBlock(info, m_desc.blockSize, false);
+        RHI_RETURN_IF_FAILED(memory);
+        pool.blocks.emplace_back(memory.GetValue());
+        ++m_stats.blockCount;
+        auto allocation = Carve(memory.GetValue(), info, false);
+        if (allocation.IsSuccess()) {
+            ++m_stats.allocationCount;
+        }
+        return allocation;
+    }
+
+    // 在指定的共享内存块中分配（用于碎片整理把分配移到选定的块）；块中放不下时返回OutOfMemory
+    Result<MemoryAllocation> AllocateIn(IMemory* memory, const MemoryAllocationInfo& info) {
+        RHI_VALIDATE(memory != nullptr && info.size > 0, ErrorCode::InvalidArgument, "无效的内存块或分配大小");
+        RHI_VALIDATE(static_cast<uint32_t>(info.type) < kMemoryTypeCount,
+            ErrorCode::InvalidArgument,
+            "无效的内存类型");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const Pool& pool = m_pools[static_cast<uint32_t>(info.type)];
+        RHI_RETURN_IF_FALSE(std::any_of(pool.blocks.begin(), pool.blocks.end(),
+            [memory](const std::unique_ptr<IMemory>& block) { return block.get() == memory; }),
+            ErrorCode::InvalidArgument,
+            "内存块不属于该内存类型的共享块");
+        auto allocation = Carve(memory, info, false);
+        if (allocation.IsSuccess()) {
+            ++m_stats.allocationCount;
+        }
+        return allocation;
+    }
+
+    Result<void> Free(const MemoryAllocation& allocation) {
+        RHI_VALIDATE(allocation.memory != nullptr && allocation.allocation != nullptr,
+            ErrorCode::InvalidArgument,
+            "无效的内存分配");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        RHI_RETURN_IF_FAILED(allocation.memory->Free(allocation.allocation));
+        --m_stats.allocationCount;
+        Pool& pool = m_pools[static_cast<uint32_t>(allocation.type)];
+        if (allocation.dedicated) {
+            RemoveBlock(pool.dedicated, allocation.memory);
+            --m_stats.dedicatedCount;
+            return MakeSuccessResult();
+        }
+
+        auto stats = allocation.memory->GetStats();
+        RHI_RETURN_IF_FAILED(stats);
+        if (stats.GetValue().usedSize == 0) {
+            // 已经有其他空块时归还这一块
+            for (const auto& block : pool.blocks) {
+                if (block.get() != allocation.memory && IsEmpty(block.get())) {
+                    RemoveBlock(pool.blocks, allocation.memory);
+                    --m_stats.blockCount;
+                    break;
+                }
+            }
+        }
+        return MakeSuccessResult();
+    }
+
+    // 某一内存类型的统计（共享块与专用块合计；最大空闲块与碎片化只统计共享块）
+    Result<MemoryStats> GetStats(MemoryType type) const {
+        RHI_VALIDATE(static_cast<uint32_t>(type) < kMemoryTypeCount,
+            ErrorCode::InvalidArgument,
+            "无效的内存类型");
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MemoryStats stats = {};
+        RHI_RETURN_IF_FAILED(Accumulate(m_pools[static_cast<uint32_t>(type)], stats));
+        Finish(stats);
+        return MakeSuccessResult(stats);
+    }
+
+    // 所有内存类型的统计
+    Result<MemoryStats> GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        MemoryStats stats = {};
+        for (const Pool& pool : m_pools) {
+            RHI_RETURN_IF_FAILED(Accumulate(pool, stats));
+        }
+        Finish(stats);
+        return MakeSuccessResult(stats);
+    }
+
+    MemoryAllocatorStats GetAllocatorStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    // 某一内存类型的共享内存块
+    std::vector<IMemory*> GetBlocks(MemoryType type) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<IMemory*> blocks;
+        if (static_cast<uint32_t>(type) < kMemoryTypeCount) {
+            for (const auto& block : m_pools[static_cast<uint32_t>(type)].blocks) {
+                blocks.push_back(block.get());
+            }
+        }
+        return blocks;
+    }
+
+    // 当前持有的设备内存对象数（共享块 + 专用块）
+    uint32_t GetMemoryObjectCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats.blockCount + m_stats.dedicatedCount;
+    }
+
+private:
+    static constexpr uint32_t kMemoryTypeCount = static_cast<uint32_t>(MemoryType::Custom) + 1;
+
+    struct Pool {
+        std::vector<std::unique_ptr<IMemory>> blocks;
+        std::vector<std::unique_ptr<IMemory>> dedicated;
+    };
+
+    Result<IMemory*> CreateBlock(const MemoryAllocationInfo& info, size_t size, bool dedicated) {
+        RHI_RETURN_IF_FALSE(m_desc.maxMemoryObjects == 0 ||
+            m_stats.blockCount + m_stats.dedicatedCount < m_desc.maxMemoryObjects,
+            ErrorCode::OutOfMemory,
+            "设备内存对象数已达上限");
+        MemoryDesc desc;
+        desc.type = info.type;
+        desc.properties = info.properties;
+        desc.size = size;
+        desc.alignment = info.alignment;
+        desc.dedicated = dedicated;
+        desc.tag = MemoryTag("MemoryAllocator");
+        auto memory = m_device->AllocateMemory(desc);
+        RHI_RETURN_IF_FAILED(memory);
+        ++m_stats.blockAllocations;
+        return memory;
+    }
+
+    static void DestroyBlock(IMemory* memory) {
+        delete memory;
+    }
+
+    static Result<MemoryAllocation> Carve(IMemory* memory, const MemoryAllocationInfo& info, bool dedicated) {
+        auto handle = memory->Allocate(info);
+        RHI_RETURN_IF_FAILED(handle);
+        auto offset = memory->GetAllocationOffset(handle.GetValue());
+        RHI_RETURN_IF_FAILED(offset);
+        MemoryAllocation allocation;
+        allocation.memory = memory;
+        allocation.allocation = handle.GetValue();
+        allocation.offset = offset.GetValue();
+        allocation.size = info.size;
+        allocation.type = info.type;
+        allocation.dedicated = dedicated;
+        return MakeSuccessResult(allocation);
+    }
+
+    static bool IsEmpty(IMemory* memory) {
+        auto stats = memory->GetStats();
+        return stats.IsSuccess() && stats.GetValue().usedSize == 0;
+    }
+
+    static void RemoveBlock(std::vector<std::unique_ptr<IMemory>>& blocks, IMemory* memory) {
+        auto it = std::find_if(blocks.begin(), blocks.end(),
+            [memory](const std::unique_ptr<IMemory>& block) { return block.get() == memory; });
+        if (it != blocks.end()) {
+            std::swap(*it, blocks.back());
+            blocks.pop_back();
+        }
+    }
+
+    static Result<void> Accumulate(const Pool& pool, MemoryStats& stats) {
+        for (const auto& block : pool.blocks) {
+            auto blockStats = block->GetStats();
+            RHI_RETURN_IF_FAILED(blockStats);
+            stats.totalSize += blockStats.GetValue().totalSize;
+            stats.usedSize += blockStats.GetValue().usedSize;
+            stats.freeCount += blockStats.GetValue().freeCount;
+            stats.largestFreeBlock = std::max(stats.largestFreeBlock, blockStats.GetValue().largestFreeBlock);
+        }
+        for (const auto& block : pool.dedicated) {
+            stats.totalSize += block->GetDesc().size;
+            stats.usedSize += block->GetDesc().size;
+        }
+        return MakeSuccessResult();
+    }
+
+    static void Finish(MemoryStats& stats) {
+        size_t freeSize = stats.totalSize - stats.usedSize;
+        stats.fragmentation = freeSize > 0
+            ? 1.0f - static_cast<float>(stats.largestFreeBlock) / static_cast<float>(freeSize)
+            : 0.0f;
+    }
+
+    IDevice* m_device;
+    MemoryAllocatorDesc m_desc;
+    mutable std::mutex m_mutex;
+    Pool m_pools[kMemoryTypeCount];
+    MemoryAllocatorStats m_stats;
+};
+
+} // namespace RHI
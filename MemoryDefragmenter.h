@@ -0,0 +1,397 @@
+#pragma once
+#include "CommandPool.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "MemoryAllocator.h"
+#include "Synchronization.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace RHI {
+
+// 碎片整理描述
+struct MemoryDefragmenterDesc {
+    uint64_t bytesPerFrame;            // 每帧最多移动的字节数（超过预算的单个分配在空闲帧中单独移动）
+    float fragmentationThreshold;      // 内存类型的碎片化程度不低于此值时才整理
+    uint32_t framesInFlight;           // 旧分配在移动完成后再保留的帧数（GPU可能仍在读取旧资源）
+
+    MemoryDefragmenterDesc() :
+        bytesPerFrame(8ull * 1024 * 1024),
+        fragmentationThreshold(0.1f),
+        framesInFlight(2) {}
+};
+
+// 一次移动
+struct DefragmentationMove {
+    MemoryAllocation src;              // 原分配
+    MemoryAllocation dst;              // 新分配
+    void* userData;                    // Track时传入的用户数据
+    void* newResource;                 // RecordMove在dst处创建的新资源（由处理器填写）
+};
+
+// 碎片整理统计
+struct DefragmentationStats {
+    uint64_t passes = 0;               // 提交到传输队列的批次数
+    uint64_t allocationsMoved = 0;     // 已完成的移动数
+    uint64_t bytesMoved = 0;           // 已完成移动的字节数
+    uint64_t canceledMoves = 0;        // 移动途中被Untrack或录制失败而取消的移动数
+    float fragmentationBefore = 0.0f;  // 本轮整理开始前的碎片化程度（MemoryAllocator::GetStats）
+    float fragmentationAfter = 0.0f;   // 最近一批移动完成后的碎片化程度
+};
+
+// 资源移动的执行者
+// 碎片整理器只管理内存分配；引用分配的资源、视图与描述符由处理器负责
+class IDefragmentationHandler {
+public:
+    virtual ~IDefragmentationHandler() = default;
+
+    // 在move.dst处创建新资源（记入move.newResource），并向传输命令缓冲区录制从旧资源到新资源的
+    // CopyBuffer/CopyTexture；返回失败时放弃此次移动，须自行销毁已创建的新资源
+    virtual Result<void> RecordMove(DefragmentationMove& move, ICommandBuffer* commandBuffer) = 0;
+
+    // 复制已在GPU上完成：把引用旧资源的视图、描述符等改为引用新资源，并延迟释放旧资源
+    virtual void CompleteMove(const DefragmentationMove& move) = 0;
+
+    // 移动被取消：销毁move.newResource（分配在途中被Untrack时userData可能已失效，不能再访问）
+    virtual void CancelMove(const DefragmentationMove& move) = 0;
+};
+
+// 增量碎片整理器
+// 在MemoryAllocator之上把可移动的分配（Track登记）从较空的内存块移到较满的块，或移到同一块中更低的偏移，
+// 使空出的内存块可以归还设备、空闲空间连成大块。每帧调用一次Update：
+// 1. 上一批移动的传输提交已完成时，把登记的MemoryAllocation改为新分配并调用处理器的CompleteMove；
+//    旧分配再过framesInFlight帧后释放；
+// 2. 没有在途批次时，对碎片化程度不低于阈值的内存类型按字节预算规划下一批移动，分配目标位置，
+//    由处理器录制复制命令，一次提交到传输队列并发出时间线信号量。
+// Update从不等待GPU。被移动的资源在CompleteMove之前不能被GPU写入。
+// 非线程安全：Track/Untrack/Update须在同一个线程调用。
+class MemoryDefragmenter {
+public:
+    MemoryDefragmenter(IDevice* device, MemoryAllocator& allocator, IDefragmentationHandler* handler,
+                       const MemoryDefragmenterDesc& desc = MemoryDefragmenterDesc())
+        : m_device(device), m_allocator(allocator), m_handler(handler), m_desc(desc) {}
+
+    MemoryDefragmenter(const MemoryDefragmenter&) = delete;
+    MemoryDefragmenter& operator=(const MemoryDefragmenter&) = delete;
+
+    // 析构前须等待传输队列空闲；在途的移动按取消处理（登记的分配保持不变），待释放的旧分配立即释放
+    ~MemoryDefragmenter() {
+        for (const PendingMove& pending : m_pending) {
+            m_handler->CancelMove(pending.move);
+            (void)m_allocator.Free(pending.move.dst);
+        }
+        for (const RetiredAllocation& retired : m_retired) {
+            (void)m_allocator.Free(retired.allocation);
+        }
+    }
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_device != nullptr && m_handler != nullptr,
+            ErrorCode::InvalidArgument, "碎片整理器的设备与处理器都不能为空");
+        RHI_VALIDATE(m_desc.bytesPerFrame > 0, ErrorCode::InvalidArgument, "bytesPerFrame必须大于0");
+        auto queue = m_device->GetQueue(QueueType::Transfer, 0);
+        RHI_RETURN_IF_FAILED(queue);
+        m_queue = queue.GetValue();
+        auto pool = m_device->CreateCommandPool(QueueType::Transfer, true);
+        RHI_RETURN_IF_FAILED(pool);
+        m_commandPool.reset(pool.GetValue());
+        auto buffers = m_commandPool->AllocateCommandBuffers(CommandBufferAllocateInfo());
+        RHI_RETURN_IF_FAILED(buffers);
+        m_commandBuffer = buffers.GetValue()[0];
+        SemaphoreDesc semaphoreDesc;
+        semaphoreDesc.binary = false;
+        auto semaphore = m_device->CreateSemaphore(semaphoreDesc);
+        RHI_RETURN_IF_FAILED(semaphore);
+        m_timeline.reset(semaphore.GetValue());
+        return MakeSuccessResult();
+    }
+
+    // 登记可移动的分配；移动完成时*allocation被改为新分配，userData原样传给处理器
+    // 专用分配不会被移动
+    Result<void> Track(MemoryAllocation* allocation, void* userData) {
+        RHI_VALIDATE(allocation != nullptr && allocation->memory != nullptr,
+            ErrorCode::InvalidArgument, "无效的内存分配");
+        RHI_RETURN_IF_FALSE(m_index.find(allocation) == m_index.end(),
+            ErrorCode::InvalidArgument, "分配已登记");
+        m_index.emplace(allocation, m_entries.size());
+        m_entries.push_back({allocation, userData, false});
+        return MakeSuccessResult();
+    }
+
+    // 取消登记（释放分配之前调用）；正在移动的分配会取消移动，
+    // 此时传输队列可能仍在读取原分配，释放须延迟到GetTimeline()到达GetSubmittedValue()
+    Result<void> Untrack(MemoryAllocation* allocation) {
+        auto it = m_index.find(allocation);
+        RHI_RETURN_IF_FALSE(it != m_index.end(), ErrorCode::InvalidArgument, "分配未登记");
+        size_t index = it->second;
+        if (m_entries[index].moving) {
+            for (PendingMove& pending : m_pending) {
+                if (pending.target == allocation) {
+                    pending.target = nullptr;
+                }
+            }
+        }
+        m_index.erase(it);
+        if (index != m_entries.size() - 1) {
+            m_entries[index] = m_entries.back();
+            m_index[m_entries[index].allocation] = index;
+        }
+        m_entries.pop_back();
+        return MakeSuccessResult();
+    }
+
+    // 每帧调用一次：完成上一批移动，并在预算内提交下一批
+    Result<void> Update() {
+        RHI_VALIDATE(m_queue != nullptr, ErrorCode::InvalidOperation, "Update必须在Initialize之后调用");
+        ++m_frame;
+        RHI_RETURN_IF_FAILED(ReleaseRetired());
+        if (!m_pending.empty()) {
+            auto completed = m_timeline->GetValue();
+            RHI_RETURN_IF_FAILED(completed);
+            if (completed.GetValue() < m_submittedValue) {
+                return MakeSuccessResult();
+            }
+            RHI_RETURN_IF_FAILED(CompletePass());
+        }
+        return PlanPass();
+    }
+
+    // 没有在途批次与待释放的旧分配，且上一次规划没有找到可移动的分配
+    bool IsIdle() const { return m_pending.empty() && m_retired.empty() && !m_active; }
+
+    // 在途的移动数
+    size_t GetPendingMoveCount() const { return m_pending.size(); }
+
+    size_t GetTrackedCount() const { return m_entries.size(); }
+
+    // 传输提交发出的时间线信号量与最近一次提交的值
+    ISemaphore* GetTimeline() const { return m_timeline.get(); }
+    uint64_t GetSubmittedValue() const { return m_submittedValue; }
+
+    const DefragmentationStats& GetStats() const { return m_stats; }
+
+private:
+    struct Entry {
+        MemoryAllocation* allocation;
+        void* userData;
+        bool moving;
+    };
+
+    struct PendingMove {
+        MemoryAllocation* target;       // 登记的分配（移动途中被Untrack时为nullptr）
+        DefragmentationMove move;
+    };
+
+    struct RetiredAllocation {
+        MemoryAllocation allocation;
+        uint64_t releaseFrame;
+    };
+
+    struct BlockUsage {
+        IMemory* memory;
+        size_t usedSize;
+    };
+
+    struct Candidate {
+        size_t rank;                    // 所在块按已用大小降序的排名
+        Entry* entry;
+    };
+
+    Result<void> ReleaseRetired() {
+        size_t kept = 0;
+        for (size_t i = 0; i < m_retired.size(); ++i) {
+            if (m_retired[i].releaseFrame <= m_frame) {
+                RHI_RETURN_IF_FAILED(m_allocator.Free(m_retired[i].allocation));
+            } else {
+                m_retired[kept++] = m_retired[i];
+            }
+        }
+        m_retired.resize(kept);
+        return MakeSuccessResult();
+    }
+
+    Result<void> CompletePass() {
+        for (const PendingMove& pending : m_pending) {
+            if (pending.target == nullptr) {
+                ++m_stats.canceledMoves;
+                m_handler->CancelMove(pending.move);
+                RHI_RETURN_IF_FAILED(m_allocator.Free(pending.move.dst));
+                continue;
+            }
+            *pending.target = pending.move.dst;
+            m_entries[m_index[pending.target]].moving = false;
+            m_handler->CompleteMove(pending.move);
+            m_retired.push_back({pending.move.src, m_frame + m_desc.framesInFlight});
+            ++m_stats.allocationsMoved;
+            m_stats.bytesMoved += pending.move.src.size;
+        }
+        m_pending.clear();
+        auto stats = m_allocator.GetStats();
+        RHI_RETURN_IF_FAILED(stats);
+        m_stats.fragmentationAfter = stats.GetValue().fragmentation;
+        return MakeSuccessResult();
+    }
+
+    Result<void> PlanPass() {
+        auto totalStats = m_allocator.GetStats();
+        RHI_RETURN_IF_FAILED(totalStats);
+
+        uint64_t budget = 0;
+        bool recording = false;
+        for (uint32_t type = 0; type <= static_cast<uint32_t>(MemoryType::Custom); ++type) {
+            auto typeStats = m_allocator.GetStats(static_cast<MemoryType>(type));
+            RHI_RETURN_IF_FAILED(typeStats);
+            if (typeStats.GetValue().fragmentation < m_desc.fragmentationThreshold) {
+                continue;
+            }
+            RHI_RETURN_IF_FAILED(PlanType(static_cast<MemoryType>(type), budget, recording));
+            if (budget >= m_desc.bytesPerFrame) {
+                break;
+            }
+        }
+
+        if (m_pending.empty()) {
+            if (recording) {
+                RHI_RETURN_IF_FAILED(m_commandBuffer->End());
+            }
+            // 旧分配释放后可能出现新的移动机会，全部释放之前本轮整理不算结束
+            if (m_active && m_retired.empty()) {
+                m_stats.fragmentationAfter = totalStats.GetValue().fragmentation;
+                m_active = false;
+            }
+            return MakeSuccessResult();
+        }
+        if (!m_active) {
+            m_stats.fragmentationBefore = totalStats.GetValue().fragmentation;
+            m_active = true;
+        }
+        RHI_RETURN_IF_FAILED(m_commandBuffer->End());
+
+        ICommandBuffer* commandBuffers[] = {m_commandBuffer};
+        SemaphoreSignalInfo signal;
+        signal.semaphore = m_timeline.get();
+        signal.value = m_submittedValue + 1;
+        SubmitDesc submit;
+        submit.commandBuffers = commandBuffers;
+        submit.signalSemaphores = Span<const SemaphoreSignalInfo>(&signal, 1);
+        Result<void> result = m_queue->SubmitBatch(Span<const SubmitDesc>(&submit, 1), nullptr);
+        if (!result.IsSuccess()) {
+            // 提交失败时撤销整批移动
+            for (const PendingMove& pending : m_pending) {
+                m_handler->CancelMove(pending.move);
+                (void)m_allocator.Free(pending.move.dst);
+                if (pending.target != nullptr) {
+                    m_entries[m_index[pending.target]].moving = false;
+                }
+            }
+            m_stats.canceledMoves += m_pending.size();
+            m_pending.clear();
+            return result;
+        }
+        m_submittedValue = signal.value;
+        ++m_stats.passes;
+        return MakeSuccessResult();
+    }
+
+    // 从最空的块开始，把块中偏移最高的分配移到更满的块或同一块中更低的偏移
+    Result<void> PlanType(MemoryType type, uint64_t& budget, bool& recording) {
+        std::vector<BlockUsage> blocks;
+        for (IMemory* memory : m_allocator.GetBlocks(type)) {
+            auto stats = memory->GetStats();
+            RHI_RETURN_IF_FAILED(stats);
+            blocks.push_back({memory, stats.GetValue().usedSize});
+        }
+        std::sort(blocks.begin(), blocks.end(), [](const BlockUsage& a, const BlockUsage& b) {
+            return a.usedSize > b.usedSize;
+        });
+
+        // 候选按所在块的排名（越空越先）与偏移（越高越先）排序
+        m_candidates.clear();
+        for (Entry& entry : m_entries) {
+            if (entry.moving || entry.allocation->dedicated || entry.allocation->type != type) {
+                continue;
+            }
+            for (size_t rank = 0; rank < blocks.size(); ++rank) {
+                if (blocks[rank].memory == entry.allocation->memory) {
+                    m_candidates.push_back({rank, &entry});
+                    break;
+                }
+            }
+        }
+        std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.rank != b.rank ? a.rank > b.rank : a.entry->allocation->offset > b.entry->allocation->offset;
+        });
+
+        for (const Candidate& candidate : m_candidates) {
+            Entry* entry = candidate.entry;
+            const MemoryAllocation& src = *entry->allocation;
+            if (budget > 0 && budget + src.size > m_desc.bytesPerFrame) {
+                break;
+            }
+            auto info = src.memory->GetAllocationInfo(src.allocation);
+            RHI_RETURN_IF_FAILED(info);
+            auto dst = FindDestination(blocks, candidate.rank, src, info.GetValue());
+            RHI_RETURN_IF_FAILED(dst);
+            if (dst.GetValue().memory == nullptr) {
+                continue;
+            }
+            if (!recording) {
+                RHI_RETURN_IF_FAILED(m_commandBuffer->Begin());
+                recording = true;
+            }
+            DefragmentationMove move = {src, dst.GetValue(), entry->userData, nullptr};
+            if (!m_handler->RecordMove(move, m_commandBuffer).IsSuccess()) {
+                ++m_stats.canceledMoves;
+                RHI_RETURN_IF_FAILED(m_allocator.Free(move.dst));
+                continue;
+            }
+            entry->moving = true;
+            m_pending.push_back({entry->allocation, move});
+            budget += src.size;
+        }
+        return MakeSuccessResult();
+    }
+
+    // 依次尝试比源块更满的块，最后尝试源块中更低的偏移；找不到时返回memory为nullptr的分配
+    Result<MemoryAllocation> FindDestination(const std::vector<BlockUsage>& blocks, size_t source,
+                                             const MemoryAllocation& src, const MemoryAllocationInfo& info) {
+        for (size_t target = 0; target < source; ++target) {
+            auto dst = m_allocator.AllocateIn(blocks[target].memory, info);
+            if (dst.IsSuccess()) {
+                return dst;
+            }
+        }
+        auto dst = m_allocator.AllocateIn(src.memory, info);
+        if (dst.IsSuccess()) {
+            if (dst.GetValue().offset < src.offset) {
+                return dst;
+            }
+            RHI_RETURN_IF_FAILED(m_allocator.Free(dst.GetValue()));
+        }
+        return MakeSuccessResult(MemoryAllocation());
+    }
+
+    IDevice* m_device;
+    MemoryAllocator& m_allocator;
+    IDefragmentationHandler* m_handler;
+    MemoryDefragmenterDesc m_desc;
+    IQueue* m_queue = nullptr;
+    std::unique_ptr<ICommandPool> m_commandPool;
+    ICommandBuffer* m_commandBuffer = nullptr;
+    std::unique_ptr<ISemaphore> m_timeline;
+    uint64_t m_submittedValue = 0;
+    uint64_t m_frame = 0;
+    bool m_active = false;
+
+    std::vector<Entry> m_entries;
+    std::unordered_map<MemoryAllocation*, size_t> m_index;
+    std::vector<PendingMove> m_pending;
+    std::vector<RetiredAllocation> m_retired;
+    std::vector<Candidate> m_candidates;
+    DefragmentationStats m_stats;
+};
+
+} // namespace RHI
@@ -0,0 +1,401 @@
+#pragma once
+#include "Memory.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RHI {
+
+class MemoryTracker;
+
+// 被跟踪的分配类别
+enum class MemoryAllocationKind {
+    Buffer,             // 缓冲区
+    Texture,            // 纹理
+    Memory              // IMemory内存块
+};
+
+// 一组分配的用量
+struct MemoryUsage {
+    uint64_t bytes = 0;            // 当前字节数
+    uint64_t peakBytes = 0;        // 字节数的高水位
+    uint64_t count = 0;            // 当前分配数
+    uint64_t totalCount = 0;       // 累计分配数
+};
+
+// 存活的分配（MemoryTracker::GetLiveAllocations）
+struct MemoryAllocationRecord {
+    uint64_t id;                   // 分配序号（按创建顺序递增）
+    MemoryAllocationKind kind;     // 类别
+    const void* object;            // IBuffer*/ITexture*/IMemory*
+    uint64_t size;                 // 字节数
+    MemoryType type;               // 内存类型
+    const char* tag;               // 标签名称（未标记为"untagged"）
+    const char* callsite;          // 创建位置（未记录为nullptr）
+    const IMemory* heap;           // 放置资源所在的内存块（独立分配为nullptr）
+    uint64_t heapOffset;           // 放置资源在内存块中的偏移
+};
+
+// 资源持有的跟踪句柄：析构时从MemoryTracker中移除记录
+// 跟踪器先于资源销毁时句柄被断开，之后的析构不再访问跟踪器
+class MemoryTrackingHandle {
+public:
+    MemoryTrackingHandle() = default;
+    ~MemoryTrackingHandle();
+
+    MemoryTrackingHandle(const MemoryTrackingHandle&) = delete;
+    MemoryTrackingHandle& operator=(const MemoryTrackingHandle&) = delete;
+
+private:
+    friend class MemoryTracker;
+    MemoryTracker* m_tracker = nullptr;
+    uint32_t m_slot = 0;
+};
+
+// 按标签与内存类型的内存用量跟踪
+// 设备创建的每个缓冲区、纹理与内存块登记一条记录（标签取自desc.tag），销毁时移除：
+// - 独立分配的资源与内存块计入总量、所属标签与内存类型的用量及其高水位
+// - 放置资源的内存已计入所在内存块，只登记记录（出现在存活列表与快照中），不重复计入用量
+// ExportJson导出用量与每个内存块的区段布局；跟踪器随设备销毁时，仍存活的分配写成报告交给报告回调
+// （默认写到stderr）。线程安全。
+class MemoryTracker {
+public:
+    MemoryTracker() = default;
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+    ~MemoryTracker() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_records.size() > m_freeSlots.size()) {
+            std::string report = BuildLiveAllocationReportLocked();
+            if (m_reportCallback) {
+                m_reportCallback(report);
+            } else {
+                std::fputs(report.c_str(), stderr);
+            }
+        }
+        for (Record& record : m_records) {
+            if (record.handle != nullptr) {
+                record.handle->m_tracker = nullptr;
+            }
+        }
+    }
+
+    // 登记一个分配；heap非空表示放置在heap的heapOffset处
+    void Track(
+        MemoryTrackingHandle& handle,
+        MemoryAllocationKind kind,
+        const void* object,
+        uint64_t size,
+        MemoryType type,
+        const MemoryTag& tag,
+        const IMemory* heap = nullptr,
+        uint64_t heapOffset = 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const char* name = tag.name != nullptr ? tag.name : "untagged";
+        auto tagEntry = m_tags.find(name);
+        if (tagEntry == m_tags.end()) {
+            tagEntry = m_tags.emplace(name, MemoryUsage()).first;
+        }
+        Record record = {};
+        record.id = ++m_nextId;
+        record.kind = kind;
+        record.object = object;
+        record.size = size;
+        record.type = type;
+        record.tag = &*tagEntry;
+        record.callsite = tag.callsite;
+        record.heap = heap;
+        record.heapOffset = heapOffset;
+        record.handle = &handle;
+        if (heap == nullptr) {
+            Add(m_total, size);
+            Add(tagEntry->second, size);
+            Add(m_types[GetTypeIndex(type)], size);
+        }
+        if (m_freeSlots.empty()) {
+            handle.m_slot = static_cast<uint32_t>(m_records.size());
+            m_records.push_back(record);
+        } else {
+            handle.m_slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            m_records[handle.m_slot] = record;
+        }
+        handle.m_tracker = this;
+    }
+
+    // 总用量
+    MemoryUsage GetTotalUsage() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_total;
+    }
+
+    // 内存类型的用量
+    MemoryUsage GetTypeUsage(MemoryType type) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_types[GetTypeIndex(type)];
+    }
+
+    // 标签的用量（未出现过的标签返回全0）
+    MemoryUsage GetTagUsage(const char* name) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_tags.find(name != nullptr ? name : "untagged");
+        return it != m_tags.end() ? it->second : MemoryUsage();
+    }
+
+    // 所有出现过的标签及其用量（按名称排序）
+    std::vector<std::pair<std::string, MemoryUsage>> GetTagUsages() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::vector<std::pair<std::string, MemoryUsage>>(m_tags.begin(), m_tags.end());
+    }
+
+    // 存活的分配（按创建顺序）
+    std::vector<MemoryAllocationRecord> GetLiveAllocations() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return GetLiveAllocationsLocked();
+    }
+
+    // 存活分配的文本报告（每行一条，按字节数从大到小）
+    std::string BuildLiveAllocationReport() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return BuildLiveAllocationReportLocked();
+    }
+
+    // 设置设备销毁时存活分配报告的接收者（为空时写到stderr）
+    void SetReportCallback(std::function<void(const std::string&)> callback) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reportCallback = std::move(callback);
+    }
+
+    // 导出JSON快照：总量、各内存类型与标签的用量，以及每个内存块的区段布局与其中的放置资源
+    std::string ExportJson() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<MemoryAllocationRecord> records = GetLiveAllocationsLocked();
+        std::string json = "{\n  \"total\": ";
+        AppendUsage(json, m_total);
+        json += ",\n  \"memoryTypes\": {";
+        for (uint32_t i = 0; i < kTypeCount; ++i) {
+            json += i == 0 ? "\n    " : ",\n    ";
+            AppendString(json, GetTypeName(static_cast<MemoryType>(i)));
+            json += ": ";
+            AppendUsage(json, m_types[i]);
+        }
+        json += "\n  },\n  \"tags\": {";
+        bool first = true;
+        for (const auto& tag : m_tags) {
+            json += first ? "\n    " : ",\n    ";
+            first = false;
+            AppendString(json, tag.first.c_str());
+            json += ": ";
+            AppendUsage(json, tag.second);
+        }
+        json += "\n  },\n  \"heaps\": [";
+        first = true;
+        std::vector<MemoryRegion> regions;
+        for (const MemoryAllocationRecord& heap : records) {
+            if (heap.kind != MemoryAllocationKind::Memory) {
+                continue;
+            }
+            json += first ? "\n    {" : ",\n    {";
+            first = false;
+            AppendRecordFields(json, heap);
+            json += ",\n      \"regions\": [";
+            const IMemory* memory = static_cast<const IMemory*>(heap.object);
+            if (!memory->GetLayout(regions).IsSuccess()) {
+                regions.clear();
+            }
+            for (size_t i = 0; i < regions.size(); ++i) {
+                char buffer[96];
+                std::snprintf(buffer, sizeof(buffer), "%s{\"offset\": %zu, \"size\": %zu, \"free\": %s}",
+                              i == 0 ? "" : ", ", regions[i].offset, regions[i].size, regions[i].free ? "true" : "false");
+                json += buffer;
+            }
+            json += "],\n      \"placed\": [";
+            bool firstPlaced = true;
+            for (const MemoryAllocationRecord& placed : records) {
+                if (placed.heap != memory) {
+                    continue;
+                }
+                json += firstPlaced ? "{" : ", {";
+                firstPlaced = false;
+                AppendRecordFields(json, placed);
+                json += "}";
+            }
+            json += "]\n    }";
+        }
+        json += "\n  ]\n}\n";
+        return json;
+    }
+
+    static const char* GetKindName(MemoryAllocationKind kind) {
+        switch (kind) {
+            case MemoryAllocationKind::Buffer: return "Buffer";
+            case MemoryAllocationKind::Texture: return "Texture";
+            case MemoryAllocationKind::Memory: return "Memory";
+        }
+        return "Unknown";
+    }
+
+    static const char* GetTypeName(MemoryType type) {
+        switch (type) {
+            case MemoryType::Default: return "Default";
+            case MemoryType::Upload: return "Upload";
+            case MemoryType::Readback: return "Readback";
+            case MemoryType::Custom: return "Custom";
+        }
+        return "Unknown";
+    }
+
+private:
+    friend class MemoryTrackingHandle;
+
+    static constexpr uint32_t kTypeCount = static_cast<uint32_t>(MemoryType::Custom) + 1;
+
+    using TagMap = std::map<std::string, MemoryUsage, std::less<>>;
+
+    struct Record {
+        MemoryAllocationKind kind;
+        const void* object;
+        uint64_t size;
+        MemoryType type;
+        uint64_t id;
+        TagMap::value_type* tag;           // 指向m_tags中的条目（std::map的节点地址稳定）
+        const char* callsite;
+        const IMemory* heap;
+        uint64_t heapOffset;
+        MemoryTrackingHandle* handle;      // 空闲槽位为nullptr
+    };
+
+    void Untrack(MemoryTrackingHandle& handle) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Record& record = m_records[handle.m_slot];
+        if (record.heap == nullptr) {
+            Remove(m_total, record.size);
+            Remove(record.tag->second, record.size);
+            Remove(m_types[GetTypeIndex(record.type)], record.size);
+        }
+        record.handle = nullptr;
+        m_freeSlots.push_back(handle.m_slot);
+        handle.m_tracker = nullptr;
+    }
+
+    static uint32_t GetTypeIndex(MemoryType type) {
+        return std::min(static_cast<uint32_t>(type), kTypeCount - 1);
+    }
+
+    static void Add(MemoryUsage& usage, uint64_t size) {
+        usage.bytes += size;
+        usage.peakBytes = std::max(usage.peakBytes, usage.bytes);
+        ++usage.count;
+        ++usage.totalCount;
+    }
+
+    static void Remove(MemoryUsage& usage, uint64_t size) {
+        usage.bytes -= size;
+        --usage.count;
+    }
+
+    std::vector<MemoryAllocationRecord> GetLiveAllocationsLocked() const {
+        std::vector<MemoryAllocationRecord> records;
+        records.reserve(m_records.size() - m_freeSlots.size());
+        for (const Record& record : m_records) {
+            if (record.handle != nullptr) {
+                records.push_back(MemoryAllocationRecord{record.id, record.kind, record.object, record.size, record.type,
+                    record.tag->first.c_str(), record.callsite, record.heap, record.heapOffset});
+            }
+        }
+        std::sort(records.begin(), records.end(),
+            [](const MemoryAllocationRecord& a, const MemoryAllocationRecord& b) { return a.id < b.id; });
+        return records;
+    }
+
+    std::string BuildLiveAllocationReportLocked() const {
+        std::vector<MemoryAllocationRecord> records = GetLiveAllocationsLocked();
+        std::stable_sort(records.begin(), records.end(),
+            [](const MemoryAllocationRecord& a, const MemoryAllocationRecord& b) { return a.size > b.size; });
+        char line[512];
+        std::snprintf(line, sizeof(line), "RHI: %zu allocation(s) still live, %" PRIu64 " bytes not counting placed resources\n",
+                      records.size(), m_total.bytes);
+        std::string report = line;
+        for (const MemoryAllocationRecord& record : records) {
+            std::snprintf(line, sizeof(line), "  #%" PRIu64 " %-7s %12" PRIu64 " bytes  %-8s tag=%s%s%s%s\n",
+                          record.id, GetKindName(record.kind), record.size, GetTypeName(record.type), record.tag,
+                          record.heap != nullptr ? " (placed)" : "",
+                          record.callsite != nullptr ? " at " : "",
+                          record.callsite != nullptr ? record.callsite : "");
+            report += line;
+        }
+        return report;
+    }
+
+    static void AppendUsage(std::string& json, const MemoryUsage& usage) {
+        char buffer[160];
+        std::snprintf(buffer, sizeof(buffer),
+                      "{\"bytes\": %" PRIu64 ", \"peakBytes\": %" PRIu64 ", \"count\": %" PRIu64 ", \"totalCount\": %" PRIu64 "}",
+                      usage.bytes, usage.peakBytes, usage.count, usage.totalCount);
+        json += buffer;
+    }
+
+    static void AppendRecordFields(std::string& json, const MemoryAllocationRecord& record) {
+        char buffer[128];
+        std::snprintf(buffer, sizeof(buffer), "\"id\": %" PRIu64 ", \"kind\": \"%s\", \"type\": \"%s\", ",
+                      record.id, GetKindName(record.kind), GetTypeName(record.type));
+        json += buffer;
+        if (record.heap != nullptr) {
+            std::snprintf(buffer, sizeof(buffer), "\"offset\": %" PRIu64 ", ", record.heapOffset);
+            json += buffer;
+        }
+        std::snprintf(buffer, sizeof(buffer), "\"size\": %" PRIu64 ", \"tag\": ", record.size);
+        json += buffer;
+        AppendString(json, record.tag);
+        json += ", \"callsite\": ";
+        if (record.callsite != nullptr) {
+            AppendString(json, record.callsite);
+        } else {
+            json += "null";
+        }
+    }
+
+    // 写入带引号并转义的JSON字符串
+    static void AppendString(std::string& json, const char* text) {
+        json += '"';
+        for (const char* c = text; *c != '\0'; ++c) {
+            unsigned char ch = static_cast<unsigned char>(*c);
+            if (ch == '"' || ch == '\\') {
+                json += '\\';
+                json += static_cast<char>(ch);
+            } else if (ch < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+                json += escaped;
+            } else {
+                json += static_cast<char>(ch);
+            }
+        }
+        json += '"';
+    }
+
+    mutable std::mutex m_mutex;
+    std::vector<Record> m_records;         // MemoryTrackingHandle::m_slot索引的槽位
+    std::vector<uint32_t> m_freeSlots;
+    TagMap m_tags;
+    MemoryUsage m_total;
+    MemoryUsage m_types[kTypeCount];
+    uint64_t m_nextId = 0;
+    std::function<void(const std::string&)> m_reportCallback;
+};
+
+inline MemoryTrackingHandle::~MemoryTrackingHandle() {
+    if (m_tracker != nullptr) {
+        m_tracker->Untrack(*this);
+    }
+}
+
+} // namespace RHI
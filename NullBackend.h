@@ -0,0 +1,1674 @@
+#pragma once
+#include "Adapter.h"
+#include "Buffer.h"
+#include "CommandBuffer.h"
+#include "CommandPool.h"
+#include "Descriptor.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "Memory.h"
+#include "MemoryTracker.h"
+#include "Pipeline.h"
+#include "Shader.h"
+#include "SwapChain.h"
+#include "Synchronization.h"
+#include "Texture.h"
+#include "TlsfAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RHI {
+
+// 空后端（AdapterType::Software）
+// 实现全部RHI接口，对象具有真实的生命周期与状态检查，但不执行任何GPU工作，
+// 用于测量抽象层本身的开销（虚调用、Result构造、参数传递）。
+// 所有提交在Submit返回时即视为已完成。
+//
+// 所有权约定：
+// - Create*/Allocate(Memory)返回的对象由调用者通过delete释放
+// - 队列由设备持有；命令缓冲区由命令池持有；描述符集由描述符池持有
+// - Get*View返回的视图由所属资源持有，随资源一起释放
+
+class NullBuffer;
+class NullTexture;
+
+// 缓冲区视图（Get*View的返回值指向此结构）
+struct NullBufferView {
+    NullBuffer* buffer;         // 所属缓冲区
+    BufferViewDesc desc;        // 视图描述
+};
+
+// 纹理视图（Get*View的返回值指向此结构）
+struct NullTextureView {
+    NullTexture* texture;       // 所属纹理
+    TextureSubresourceRange range;  // 子资源范围
+};
+
+// 空适配器报告的专用显存大小（GetMemoryBudget的预算）
+constexpr uint64_t kNullDedicatedVideoMemory = 8ull * 1024 * 1024 * 1024;
+
+// 放置资源的对齐（与D3D12的缓冲区/纹理放置对齐一致）
+constexpr size_t kNullBufferPlacementAlignment = 256;
+constexpr size_t kNullTexturePlacementAlignment = 64 * 1024;
+
+// 判断内存类型是否可被CPU访问
+inline bool IsHostVisibleMemoryType(MemoryType type) {
+    return type == MemoryType::Upload || type == MemoryType::Readback;
+}
+
+// 映射内存是否HostCoherent：显式声明HostVisible而未声明HostCoherent的内存块视为非一致，其余（包括按类型选择属性的）为一致
+inline bool IsHostCoherentMemory(const MemoryDesc& desc) {
+    uint32_t properties = static_cast<uint32_t>(desc.properties);
+    return (properties & static_cast<uint32_t>(MemoryPropertyFlag::HostVisible)) == 0 ||
+        (properties & static_cast<uint32_t>(MemoryPropertyFlag::HostCoherent)) != 0;
+}
+
+// 空内存
+// 用TLSF切分内存块，Allocate返回的句柄指向TlsfAllocator::Block
+// 记录驻留状态；MemoryType::Default的驻留字节数累加到设备的计数（GetMemoryBudget的占用）
+class NullMemory : public IMemory {
+public:
+    explicit NullMemory(const MemoryDesc& desc, std::atomic<uint64_t>* residentBytes = nullptr)
+        : m_allocator(desc.size)
+        , m_residentBytes(desc.type == MemoryType::Default ? residentBytes : nullptr) {
+        m_desc = desc;
+        if (m_residentBytes != nullptr) {
+            m_residentBytes->fetch_add(m_desc.size, std::memory_order_relaxed);
+        }
+    }
+
+    ~NullMemory() override {
+        if (m_resident && m_residentBytes != nullptr) {
+            m_residentBytes->fetch_sub(m_desc.size, std::memory_order_relaxed);
+        }
+    }
+
+    const MemoryDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<void*> Allocate(const MemoryAllocationInfo& info) override {
+        RHI_VALIDATE(info.size > 0, ErrorCode::InvalidArgument, "分配大小必须大于0");
+        RHI_VALIDATE(info.alignment == 0 || (info.alignment & (info.alignment - 1)) == 0,
+            ErrorCode::InvalidArgument,
+            "对齐要求必须为2的幂: " + std::to_string(info.alignment));
+
+        TlsfAllocator::Block* block = m_allocator.Allocate(info.size, info.alignment);
+        RHI_RETURN_IF_FALSE(block != nullptr,
+            ErrorCode::OutOfMemory,
+            "内存块空间不足");
+        block->info = info;
+        return MakeSuccessResult(static_cast<void*>(block));
+    }
+
+    Result<void> Free(void* allocation) override {
+        TlsfAllocator::Block* block = static_cast<TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        m_allocator.Free(block);
+        return MakeSuccessResult();
+    }
+
+    Result<void*> Map(void* allocation, size_t offset, size_t size) override {
+        RHI_RETURN_IF_FALSE(IsHostVisible(),
+            ErrorCode::ResourceMapFailed,
+            "内存不可被CPU访问");
+        const TlsfAllocator::Block* block = static_cast<const TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        RHI_VALIDATE(offset + size <= block->info.size,
+            ErrorCode::InvalidArgument,
+            "映射范围越界");
+
+        return MakeSuccessResult(static_cast<void*>(GetHostStorage() + block->offset + offset));
+    }
+
+    Result<void> Unmap(void* allocation) override {
+        RHI_VALIDATE(m_allocator.Owns(static_cast<const TlsfAllocator::Block*>(allocation)),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        return MakeSuccessResult();
+    }
+
+    Result<void> FlushMappedRange(void*, size_t, size_t) override {
+        return MakeSuccessResult();
+    }
+
+    Result<void> InvalidateMappedRange(void*, size_t, size_t) override {
+        return MakeSuccessResult();
+    }
+
+    Result<MemoryAllocationInfo> GetAllocationInfo(void* allocation) const override {
+        const TlsfAllocator::Block* block = static_cast<const TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        return MakeSuccessResult(block->info);
+    }
+
+    Result<size_t> GetAllocationOffset(void* allocation) const override {
+        const TlsfAllocator::Block* block = static_cast<const TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        return MakeSuccessResult(static_cast<size_t>(block->offset));
+    }
+
+    Result<MemoryStats> GetStats() const override {
+        return MakeSuccessResult(m_allocator.GetStats());
+    }
+
+    Result<void> GetLayout(std::vector<MemoryRegion>& regions) const override {
+        m_allocator.GetLayout(regions);
+        return MakeSuccessResult();
+    }
+
+    Result<bool> IsMemoryTypeSupported(MemoryType type, MemoryPropertyFlag) const override {
+        return MakeSuccessResult(type != MemoryType::Custom);
+    }
+
+    Result<MemoryType> GetBestMemoryType(
+        MemoryPropertyFlag requiredProperties,
+        MemoryPropertyFlag) const override {
+        uint32_t required = static_cast<uint32_t>(requiredProperties);
+        if (required & static_cast<uint32_t>(MemoryPropertyFlag::HostCached)) {
+            return MakeSuccessResult(MemoryType::Readback);
+        }
+        if (required & static_cast<uint32_t>(MemoryPropertyFlag::HostVisible)) {
+            return MakeSuccessResult(MemoryType::Upload);
+        }
+        return MakeSuccessResult(MemoryType::Default);
+    }
+
+    Result<void> Defragment() override { return MakeSuccessResult(); }
+
+    Result<void> SetPriority(uint32_t priority) override {
+        m_priority = priority;
+        return MakeSuccessResult();
+    }
+
+    Result<void> MakeResident() override {
+        if (!m_resident && m_residentBytes != nullptr) {
+            m_residentBytes->fetch_add(m_desc.size, std::memory_order_relaxed);
+        }
+        m_resident = true;
+        return MakeSuccessResult();
+    }
+
+    Result<void> Evict() override {
+        if (m_resident && m_residentBytes != nullptr) {
+            m_residentBytes->fetch_sub(m_desc.size, std::memory_order_relaxed);
+        }
+        m_resident = false;
+        return MakeSuccessResult();
+    }
+
+    bool IsResident() const { return m_resident; }
+    uint32_t GetPriority() const { return m_priority; }
+
+    MemoryTrackingHandle& GetMemoryTracking() { return m_tracking; }
+
+    // 整个内存块的主机后备存储（首次调用时分配），放置资源指向其中
+    uint8_t* GetHostStorage() {
+        if (m_storage.empty()) {
+            m_storage.resize(m_desc.size);
+        }
+        return m_storage.data();
+    }
+
+    bool IsHostVisible() const {
+        return IsHostVisibleMemoryType(m_desc.type) ||
+            (static_cast<uint32_t>(m_desc.properties) &
+             static_cast<uint32_t>(MemoryPropertyFlag::HostVisible)) != 0;
+    }
+
+    TlsfAllocator m_allocator;
+    std::vector<uint8_t> m_storage;     // 主机后备存储（首次映射或放置CPU可访问的资源时分配）
+    std::atomic<uint64_t>* m_residentBytes;
+    uint32_t m_priority = 0;
+    bool m_resident = true;             // 新分配的内存处于驻留状态
+    MemoryTrackingHandle m_tracking;    // 最后声明：先于分配器析构，导出快照时不会访问已销毁的布局
+};
+
+// 空缓冲区
+// CPU可访问的缓冲区（Upload/Readback或allowCPUAccess）拥有主机后备存储，Map/UpdateData可用；
+// 放置的缓冲区改用内存块后备存储中的对应范围，因此别名资源之间的写入互相可见
+class NullBuffer : public IBuffer {
+public:
+    explicit NullBuffer(const BufferDesc& desc)
+        : NullBuffer(desc, IsHostVisibleBuffer(desc)) {}
+
+    // 放置在memory的offset处
+    NullBuffer(const BufferDesc& desc, NullMemory* memory, size_t offset)
+        : NullBuffer(desc, IsHostVisibleBuffer(desc) ? memory->GetHostStorage() + offset : nullptr) {
+        m_coherent = IsHostCoherentMemory(memory->GetDesc());
+    }
+
+    const BufferDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<void*> Map() override {
+        RHI_RETURN_IF_FALSE(m_data != nullptr || m_desc.size == 0,
+            ErrorCode::ResourceMapFailed,
+            "缓冲区不可被CPU访问");
+        RHI_VALIDATE(!m_mapped, ErrorCode::InvalidOperation, "缓冲区已被映射");
+        m_mapped = true;
+        return MakeSuccessResult(static_cast<void*>(m_data));
+    }
+
+    Result<void> Unmap() override {
+        RHI_VALIDATE(m_mapped, ErrorCode::ResourceUnmapFailed, "缓冲区未被映射");
+        m_mapped = false;
+        return MakeSuccessResult();
+    }
+
+    void* GetMappedData() const override { return m_data; }
+    bool IsHostCoherent() const override { return m_coherent; }
+
+    Result<void> UpdateData(const void* data, size_t size, size_t offset = 0) override {
+        RHI_VALIDATE(data != nullptr || size == 0, ErrorCode::InvalidArgument, "数据指针不能为空");
+        RHI_VALIDATE(offset + size <= m_desc.size,
+            ErrorCode::InvalidArgument,
+            "更新范围越界: " + std::to_string(offset) + "+" + std::to_string(size) +
+            " > " + std::to_string(m_desc.size));
+        if (m_data != nullptr && size > 0) {
+            std::memcpy(m_data + offset, data, size);
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetVertexBufferView(const BufferViewDesc& desc) override { return CreateView(desc); }
+    Result<void*> GetIndexBufferView(const BufferViewDesc& desc) override { return CreateView(desc); }
+    Result<void*> GetConstantBufferView(const BufferViewDesc& desc) override { return CreateView(desc); }
+    Result<void*> GetShaderResourceView(const BufferViewDesc& desc) override { return CreateView(desc); }
+    Result<void*> GetUnorderedAccessView(const BufferViewDesc& desc) override { return CreateView(desc); }
+
+    Result<void> TransitionState(ResourceState newState) override {
+        m_state = newState;
+        return MakeSuccessResult();
+    }
+
+    // 主机后备存储（GPU本地缓冲区为空）
+    uint8_t* GetStorage() { return m_data; }
+
+    ResourceState GetState() const { return m_state; }
+
+    MemoryTrackingHandle& GetMemoryTracking() { return m_tracking; }
+
+protected:
+    // hostStorage为true时无论内存类型都分配主机后备存储
+    NullBuffer(const BufferDesc& desc, bool hostStorage) {
+        m_desc = desc;
+        if (hostStorage) {
+            m_storage.resize(desc.size);
+            m_data = m_storage.data();
+        }
+    }
+
+    // 使用外部后备存储（放置资源，placedStorage为nullptr表示无主机存储）
+    NullBuffer(const BufferDesc& desc, uint8_t* placedStorage) {
+        m_desc = desc;
+        m_data = placedStorage;
+    }
+
+private:
+    static bool IsHostVisibleBuffer(const BufferDesc& desc) {
+        return IsHostVisibleMemoryType(desc.memoryType) || desc.allowCPUAccess;
+    }
+
+    Result<void*> CreateView(const BufferViewDesc& desc) {
+        RHI_VALIDATE(desc.offset + desc.size <= m_desc.size,
+            ErrorCode::InvalidArgument,
+            "视图范围越界");
+        m_views.push_back(std::make_unique<NullBufferView>(NullBufferView{this, desc}));
+        return MakeSuccessResult(static_cast<void*>(m_views.back().get()));
+    }
+
+    std::vector<uint8_t> m_storage;
+    uint8_t* m_data = nullptr;          // 主机存储：m_storage或内存块后备存储中的范围
+    bool m_coherent = true;             // 放置在非一致内存块中时为false（只影响FlushMappedRanges的统计）
+    std::vector<std::unique_ptr<NullBufferView>> m_views;
+    ResourceState m_state = ResourceState::Undefined;
+    bool m_mapped = false;
+    MemoryTrackingHandle m_tracking;
+};
+
+// 空纹理
+class NullTexture : public ITexture {
+public:
+    explicit NullTexture(const TextureDesc& desc) {
+        m_desc = desc;
+    }
+
+    const TextureDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<void> UpdateData(
+        const void* data,
+        const TextureDataLayout&,
+        const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(data != nullptr, ErrorCode::InvalidArgument, "数据指针不能为空");
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        RHI_VALIDATE(!HasUsage(TextureUsage::Transient), ErrorCode::InvalidOperation, "瞬态附件的内容不能更新");
+        return MakeSuccessResult();
+    }
+
+    Result<void> GenerateMips(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        RHI_VALIDATE(!HasUsage(TextureUsage::Transient), ErrorCode::InvalidOperation, "瞬态附件不能生成Mipmap");
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetRenderTargetView(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(HasUsage(TextureUsage::RenderTarget),
+            ErrorCode::InvalidOperation, "纹理未声明RenderTarget用途");
+        return CreateView(range);
+    }
+
+    Result<void*> GetDepthStencilView(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(HasUsage(TextureUsage::DepthStencil),
+            ErrorCode::InvalidOperation, "纹理未声明DepthStencil用途");
+        return CreateView(range);
+    }
+
+    Result<void*> GetShaderResourceView(const TextureSubresourceRange& range) override {
+        return CreateView(range);
+    }
+
+    Result<void*> GetUnorderedAccessView(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(HasUsage(TextureUsage::UnorderedAccess),
+            ErrorCode::InvalidOperation, "纹理未声明UnorderedAccess用途");
+        return CreateView(range);
+    }
+
+    Result<size_t> GetTextureSize() const override {
+        size_t size = 0;
+        for (uint32_t mip = 0; mip < m_desc.mipLevels; ++mip) {
+            size += GetMipSize(mip);
+        }
+        return MakeSuccessResult(size * GetLayerCount());
+    }
+
+    Result<TextureDataLayout> GetSubresourceLayout(uint32_t mipLevel, uint32_t arrayLayer) const override {
+        RHI_VALIDATE(mipLevel < m_desc.mipLevels && arrayLayer < GetLayerCount(),
+            ErrorCode::InvalidArgument,
+            "子资源索引越界");
+
+        // 子资源按层优先、mip次之的顺序紧密排列
+        size_t layerSize = 0;
+        size_t mipOffset = 0;
+        for (uint32_t mip = 0; mip < m_desc.mipLevels; ++mip) {
+            if (mip == mipLevel) {
+                mipOffset = layerSize;
+            }
+            layerSize += GetMipSize(mip);
+        }
+
+        uint32_t block = GetFormatBlockDimension(m_desc.format);
+        uint32_t width = std::max(m_desc.width >> mipLevel, 1u);
+        uint32_t height = std::max(m_desc.height >> mipLevel, 1u);
+
+        TextureDataLayout layout = {};
+        layout.rowPitch = static_cast<size_t>((width + block - 1) / block) * GetFormatBlockSize(m_desc.format);
+        layout.depthPitch = layout.rowPitch * ((height + block - 1) / block);
+        layout.arrayPitch = layerSize;
+        layout.offset = layerSize * arrayLayer + mipOffset;
+        return MakeSuccessResult(layout);
+    }
+
+    Result<void> TransitionLayout(ResourceState newState, const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        m_state = newState;
+        return MakeSuccessResult();
+    }
+
+    ResourceState GetState() const { return m_state; }
+
+    MemoryTrackingHandle& GetMemoryTracking() { return m_tracking; }
+
+protected:
+    uint32_t GetLayerCount() const {
+        return m_desc.type == TextureType::TextureCube || m_desc.type == TextureType::TextureCubeArray
+            ? m_desc.arraySize * 6
+            : m_desc.arraySize;
+    }
+
+    size_t GetMipSize(uint32_t mip) const {
+        uint32_t block = GetFormatBlockDimension(m_desc.format);
+        size_t width = std::max(m_desc.width >> mip, 1u);
+        size_t height = std::max(m_desc.height >> mip, 1u);
+        size_t depth = std::max(m_desc.depth >> mip, 1u);
+        return ((width + block - 1) / block) * ((height + block - 1) / block) * depth *
+            GetFormatBlockSize(m_desc.format) * m_desc.sampleCount;
+    }
+
+    bool IsRangeValid(const TextureSubresourceRange& range) const {
+        return range.baseMipLevel + range.mipLevelCount <= m_desc.mipLevels &&
+            range.baseArrayLayer + range.arrayLayerCount <= GetLayerCount();
+    }
+
+    bool HasUsage(TextureUsage usage) const {
+        return (m_desc.usage & usage) != TextureUsage::None;
+    }
+
+    Result<void*> CreateView(const TextureSubresourceRange& range) {
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        m_views.push_back(std::make_unique<NullTextureView>(NullTextureView{this, range}));
+        return MakeSuccessResult(static_cast<void*>(m_views.back().get()));
+    }
+
+    std::vector<std::unique_ptr<NullTextureView>> m_views;
+    ResourceState m_state = ResourceState::Undefined;
+    MemoryTrackingHandle m_tracking;
+};
+
+// 空着色器
+class NullShader : public IShader {
+public:
+    explicit NullShader(const ShaderDesc& desc) {
+        m_desc = desc;
+    }
+
+    const ShaderDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<ShaderReflection> GetReflection() const override {
+        return MakeSuccessResult(ShaderReflection());
+    }
+};
+
+// 空管线状态
+class NullPipelineState : public IPipelineState {
+public:
+    explicit NullPipelineState(const PipelineStateDesc& desc) {
+        m_desc = desc;
+        if (const ComputePipelineStateDesc* computeDesc = desc.AsCompute()) {
+            m_shaders[StageIndex(ShaderStageFlag::Compute)] = computeDesc->computeShader;
+        } else if (const GraphicsPipelineStateDesc* graphicsDesc = desc.AsGraphics()) {
+            m_shaders[StageIndex(ShaderStageFlag::Vertex)] = graphicsDesc->vertexShader;
+            m_shaders[StageIndex(ShaderStageFlag::Hull)] = graphicsDesc->hullShader;
+            m_shaders[StageIndex(ShaderStageFlag::Domain)] = graphicsDesc->domainShader;
+            m_shaders[StageIndex(ShaderStageFlag::Geometry)] = graphicsDesc->geometryShader;
+            m_shaders[StageIndex(ShaderStageFlag::Pixel)] = graphicsDesc->pixelShader;
+        }
+    }
+
+    PipelineType GetType() const { return m_desc.type; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<void*> GetPipelineLayout() const override {
+        return MakeSuccessResult(m_desc.pipelineLayout);
+    }
+
+    Result<void*> GetShader(ShaderStageFlag stage) const override {
+        uint32_t index = StageIndex(stage);
+        RHI_VALIDATE(index < kStageCount,
+            ErrorCode::InvalidArgument,
+            "只能查询单个着色器阶段");
+        return MakeSuccessResult(m_shaders[index]);
+    }
+
+private:
+    static constexpr uint32_t kStageCount = 6;
+
+    // 单个阶段标志对应的位索引（非单个阶段时返回kStageCount）
+    static uint32_t StageIndex(ShaderStageFlag stage) {
+        uint32_t bits = static_cast<uint32_t>(stage);
+        for (uint32_t i = 0; i < kStageCount; ++i) {
+            if (bits == (1u << i)) {
+                return i;
+            }
+        }
+        return kStageCount;
+    }
+
+    void* m_shaders[kStageCount] = {};
+};
+
+// 空描述符集布局
+class NullDescriptorSetLayout : public IDescriptorSetLayout {
+public:
+    explicit NullDescriptorSetLayout(const DescriptorSetLayoutDesc& desc) {
+        m_desc = desc;
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    const DescriptorSetLayoutDesc& GetDesc() const override { return m_desc; }
+};
+
+// 空描述符集
+class NullDescriptorSet : public IDescriptorSet {
+public:
+    explicit NullDescriptorSet(IDescriptorSetLayout* layout)
+        : m_layout(layout) {}
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<void> UpdateDescriptor(const std::vector<DescriptorWrite>&) override {
+        return MakeSuccessResult();
+    }
+
+    Result<IDescriptorSetLayout*> GetLayout() const override {
+        return MakeSuccessResult(m_layout);
+    }
+
+private:
+    IDescriptorSetLayout* m_layout;
+};
+
+// 空描述符池
+class NullDescriptorPool : public IDescriptorPool {
+public:
+    explicit NullDescriptorPool(const DescriptorPoolDesc& desc) {
+        m_desc = desc;
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<IDescriptorSet*> AllocateDescriptorSet(IDescriptorSetLayout* layout) override {
+        RHI_VALIDATE(layout != nullptr, ErrorCode::InvalidArgument, "描述符集布局不能为空");
+        RHI_RETURN_IF_FALSE(m_sets.size() < m_desc.maxSets,
+            ErrorCode::OutOfMemory,
+            "描述符池已满");
+        m_sets.push_back(CreateDescriptorSet(layout));
+        return MakeSuccessResult(static_cast<IDescriptorSet*>(m_sets.back().get()));
+    }
+
+    Result<void> FreeDescriptorSet(IDescriptorSet* descriptorSet) override {
+        RHI_VALIDATE(m_desc.freeDescriptorSet,
+            ErrorCode::InvalidOperation,
+            "描述符池不支持释放单个描述符集");
+        auto it = std::find_if(m_sets.begin(), m_sets.end(),
+            [descriptorSet](const std::unique_ptr<NullDescriptorSet>& set) {
+                return set.get() == descriptorSet;
+            });
+        RHI_RETURN_IF_FALSE(it != m_sets.end(),
+            ErrorCode::InvalidArgument,
+            "描述符集不属于此描述符池");
+        m_sets.erase(it);
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        m_sets.clear();
+        return MakeSuccessResult();
+    }
+
+protected:
+    // 创建描述符集对象（派生后端可返回携带绑定数据的描述符集）
+    virtual std::unique_ptr<NullDescriptorSet> CreateDescriptorSet(IDescriptorSetLayout* layout) {
+        return std::make_unique<NullDescriptorSet>(layout);
+    }
+
+private:
+    std::vector<std::unique_ptr<NullDescriptorSet>> m_sets;
+};
+
+// 空栅栏
+class NullFence : public IFence {
+public:
+    explicit NullFence(const FenceDesc& desc) {
+        m_desc = desc;
+        m_value = desc.signaled ? 1 : 0;
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<uint64_t> GetValue() const override {
+        return MakeSuccessResult(m_value);
+    }
+
+    Result<void> Signal(uint64_t value) override {
+        RHI_VALIDATE(value >= m_value, ErrorCode::SyncError, "栅栏值不能减小");
+        m_value = value;
+        return MakeSuccessResult();
+    }
+
+    Result<void> Wait(uint64_t value, uint64_t) override {
+        // 空后端中所有提交都已完成，未到达的值永远不会被发出信号
+        RHI_RETURN_IF_FALSE(m_value >= value, ErrorCode::TimeoutError, "等待栅栏超时");
+        return MakeSuccessResult();
+    }
+
+    uint64_t GetLastSubmittedValue() const override {
+        return m_value;
+    }
+
+    Result<void> Reset() override {
+        m_value = 0;
+        return MakeSuccessResult();
+    }
+
+private:
+    uint64_t m_value = 0;
+};
+
+class NullSemaphore;
+inline Result<void> WaitNullSemaphores(Span<const SemaphoreWaitInfo> waits, SemaphoreWaitMode mode, uint64_t timeout);
+
+// 空后端信号量等待者的唤醒状态（进程内共享）
+// 等待者在条件变量上阻塞；信号量的值变化且有等待者时唤醒全部等待者重新检查
+struct NullSemaphoreWaitState {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::atomic<uint32_t> waiters{0};
+
+    static NullSemaphoreWaitState& Get() {
+        static NullSemaphoreWaitState s_state;
+        return s_state;
+    }
+
+    void NotifyChanged() {
+        if (waiters.load() > 0) {
+            { std::lock_guard<std::mutex> lock(mutex); }
+            changed.notify_all();
+        }
+    }
+};
+
+// 空信号量
+// 提交在返回时即发出信号；等待在超时之前阻塞，由其他线程的提交或主机端Signal唤醒
+class NullSemaphore : public ISemaphore {
+public:
+    explicit NullSemaphore(const SemaphoreDesc& desc) {
+        m_desc = desc;
+        m_value = desc.binary ? 0 : desc.initialValue;
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<uint64_t> GetValue() const override {
+        return MakeSuccessResult(GetCurrentValue());
+    }
+
+    Result<void> Wait(uint64_t value, uint64_t timeout) override {
+        RHI_VALIDATE(!m_desc.binary, ErrorCode::InvalidOperation, "二进制信号量不支持CPU等待");
+        SemaphoreWaitInfo wait(this, value);
+        return WaitNullSemaphores(Span<const SemaphoreWaitInfo>(&wait, 1), SemaphoreWaitMode::All, timeout);
+    }
+
+    Result<void> Signal(uint64_t value) override {
+        RHI_VALIDATE(!m_desc.binary, ErrorCode::InvalidOperation, "二进制信号量不支持主机端发出");
+        return SignalOnSubmit(value);
+    }
+
+    uint64_t GetCurrentValue() const { return m_value.load(); }
+
+    // 由队列在提交完成时调用
+    void SignalOnSubmit() {
+        if (m_desc.binary) {
+            m_value.store(1);
+        } else {
+            m_value.fetch_add(1);
+        }
+        NullSemaphoreWaitState::Get().NotifyChanged();
+    }
+
+    // 由队列在提交完成时调用（发出显式的时间线值）
+    Result<void> SignalOnSubmit(uint64_t value) {
+        if (m_desc.binary) {
+            m_value.store(1);
+            NullSemaphoreWaitState::Get().NotifyChanged();
+            return MakeSuccessResult();
+        }
+        // 回退会让等待者错过已经到达的值，发布版同样检查
+        uint64_t current = m_value.load(std::memory_order_relaxed);
+        do {
+            RHI_RETURN_IF_FALSE(value > current, ErrorCode::SyncError, "时间线信号量的值必须递增");
+        } while (!m_value.compare_exchange_weak(current, value));
+        NullSemaphoreWaitState::Get().NotifyChanged();
+        return MakeSuccessResult();
+    }
+
+    // 由队列在等待时调用（二进制信号量被消耗）
+    void ConsumeOnWait() {
+        if (m_desc.binary) {
+            m_value.store(0, std::memory_order_release);
+        }
+    }
+
+private:
+    std::atomic<uint64_t> m_value{0};
+};
+
+// 不小于此值的超时视为无限等待（避免截止时间溢出）
+constexpr uint64_t kNullInfiniteWait = uint64_t(1) << 62;
+
+// 等待空后端的时间线信号量，timeout单位为纳秒
+inline Result<void> WaitNullSemaphores(Span<const SemaphoreWaitInfo> waits, SemaphoreWaitMode mode, uint64_t timeout) {
+    for (const SemaphoreWaitInfo& wait : waits) {
+        RHI_VALIDATE(wait.semaphore != nullptr && !wait.semaphore->IsBinary(),
+            ErrorCode::InvalidArgument, "只能等待时间线信号量");
+    }
+    auto satisfied = [&]() {
+        size_t reached = 0;
+        for (const SemaphoreWaitInfo& wait : waits) {
+            if (static_cast<const NullSemaphore*>(wait.semaphore)->GetCurrentValue() >= wait.value) {
+                ++reached;
+            }
+        }
+        return reached == waits.size() || (mode == SemaphoreWaitMode::Any && reached > 0);
+    };
+    if (satisfied()) {
+        return MakeSuccessResult();
+    }
+    RHI_RETURN_IF_FALSE(timeout > 0, ErrorCode::TimeoutError, "等待信号量超时");
+
+    // 先登记为等待者再检查，保证不会错过检查与阻塞之间发出的值
+    NullSemaphoreWaitState& state = NullSemaphoreWaitState::Get();
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.waiters.fetch_add(1);
+    bool reached = true;
+    if (timeout >= kNullInfiniteWait) {
+        state.changed.wait(lock, satisfied);
+    } else {
+        reached = state.changed.wait_for(lock, std::chrono::nanoseconds(timeout), satisfied);
+    }
+    state.waiters.fetch_sub(1);
+    RHI_RETURN_IF_FALSE(reached, ErrorCode::TimeoutError, "等待信号量超时");
+    return MakeSuccessResult();
+}
+
+// 空事件
+class NullEvent : public IEvent {
+public:
+    explicit NullEvent(const EventDesc& desc) {
+        m_desc = desc;
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<void> Set() override {
+        m_signaled = true;
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        m_signaled = false;
+        return MakeSuccessResult();
+    }
+
+    Result<bool> GetStatus() const override {
+        return MakeSuccessResult(m_signaled);
+    }
+
+private:
+    bool m_signaled = false;
+};
+
+// 命令缓冲区录制状态
+enum class NullCommandBufferState {
+    Initial,            // 初始状态
+    Recording,          // 录制中
+    Executable,         // 可执行（已结束录制）
+};
+
+// 空命令缓冲区
+// 只维护录制状态机与命令计数，不记录命令内容
+class NullCommandBuffer : public ICommandBuffer {
+public:
+    explicit NullCommandBuffer(const CommandBufferDesc& desc) {
+        m_desc = desc;
+    }
+
+    const CommandBufferDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<void> Begin() override {
+        RHI_VALIDATE(m_state != NullCommandBufferState::Recording,
+            ErrorCode::InvalidOperation,
+            "命令缓冲区已处于录制状态");
+        m_state = NullCommandBufferState::Recording;
+        m_commandCount = 0;
+        return MakeSuccessResult();
+    }
+
+    Result<void> End() override {
+        RHI_VALIDATE(m_state == NullCommandBufferState::Recording,
+            ErrorCode::InvalidOperation,
+            "命令缓冲区未处于录制状态");
+        RHI_VALIDATE(!m_insideRenderPass,
+            ErrorCode::InvalidOperation,
+            "渲染通道未结束");
+        m_state = NullCommandBufferState::Executable;
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        m_state = NullCommandBufferState::Initial;
+        m_insideRenderPass = false;
+        m_commandCount = 0;
+        return MakeSuccessResult();
+    }
+
+    Result<void> BeginRenderPass(const RenderPassDesc&) override {
+        RHI_VALIDATE(IsRecording(), ErrorCode::InvalidOperation, "命令缓冲区未处于录制状态");
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "渲染通道不能嵌套");
+        m_insideRenderPass = true;
+        return Record();
+    }
+
+    Result<void> EndRenderPass() override {
+        RHI_VALIDATE(m_insideRenderPass, ErrorCode::InvalidOperation, "没有进行中的渲染通道");
+        m_insideRenderPass = false;
+        return Record();
+    }
+
+    Result<void> SetViewport(const Viewport& viewport) override {
+        RHI_VALIDATE(viewport.width > 0.0f && viewport.height > 0.0f,
+            ErrorCode::InvalidArgument,
+            "视口尺寸必须大于0");
+        return Record();
+    }
+
+    Result<void> SetScissor(const Scissor&) override {
+        return Record();
+    }
+
+    Result<void> SetPipelineState(void* pipelineState) override {
+        RHI_VALIDATE(pipelineState != nullptr, ErrorCode::InvalidArgument, "管线状态不能为空");
+        return Record();
+    }
+
+    Result<void> SetDescriptorSet(uint32_t, void* descriptorSet) override {
+        RHI_VALIDATE(descriptorSet != nullptr, ErrorCode::InvalidArgument, "描述符集不能为空");
+        return Record();
+    }
+
+    Result<void> SetDescriptorSet(uint32_t, void* descriptorSet, Span<const uint32_t>) override {
+        RHI_VALIDATE(descriptorSet != nullptr, ErrorCode::InvalidArgument, "描述符集不能为空");
+        return Record();
+    }
+
+    Result<void> SetVertexBuffer(uint32_t, void* vertexBufferView) override {
+        RHI_VALIDATE(vertexBufferView != nullptr, ErrorCode::InvalidArgument, "顶点缓冲区视图不能为空");
+        return Record();
+    }
+
+    Result<void> SetIndexBuffer(void* indexBufferView) override {
+        RHI_VALIDATE(indexBufferView != nullptr, ErrorCode::InvalidArgument, "索引缓冲区视图不能为空");
+        return Record();
+    }
+
+    Result<void> PushConstants(void*, uint32_t, uint32_t size, const void* data) override {
+        RHI_VALIDATE(data != nullptr || size == 0, ErrorCode::InvalidArgument, "推送常量数据不能为空");
+        return Record();
+    }
+
+    Result<void> Draw(uint32_t, uint32_t, uint32_t, uint32_t) override {
+        return Record();
+    }
+
+    Result<void> DrawIndexed(uint32_t, uint32_t, uint32_t, int32_t, uint32_t) override {
+        return Record();
+    }
+
+    Result<void> DrawIndirect(void* argumentBuffer, uint32_t, uint32_t, uint32_t) override {
+        RHI_VALIDATE(argumentBuffer != nullptr, ErrorCode::InvalidArgument, "参数缓冲区不能为空");
+        return Record();
+    }
+
+    Result<void> Dispatch(uint32_t, uint32_t, uint32_t) override {
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "不能在渲染通道内调度计算");
+        return Record();
+    }
+
+    Result<void> DispatchIndirect(void* argumentBuffer, uint32_t) override {
+        RHI_VALIDATE(argumentBuffer != nullptr, ErrorCode::InvalidArgument, "参数缓冲区不能为空");
+        return Record();
+    }
+
+    Result<void> CopyBuffer(void* srcBuffer, void* dstBuffer, uint32_t, void*) override {
+        RHI_VALIDATE(srcBuffer != nullptr && dstBuffer != nullptr,
+            ErrorCode::InvalidArgument,
+            "复制的源和目标不能为空");
+        return Record();
+    }
+
+    Result<void> CopyTexture(void* srcTexture, void* dstTexture, uint32_t, void*) override {
+        RHI_VALIDATE(srcTexture != nullptr && dstTexture != nullptr,
+            ErrorCode::InvalidArgument,
+            "复制的源和目标不能为空");
+        return Record();
+    }
+
+    Result<void> CopyBufferToTexture(void* srcBuffer, void* dstTexture, uint32_t regionCount, void* regions) override {
+        RHI_VALIDATE(srcBuffer != nullptr && dstTexture != nullptr,
+            ErrorCode::InvalidArgument,
+            "复制的源和目标不能为空");
+        RHI_VALIDATE(regions != nullptr || regionCount == 0, ErrorCode::InvalidArgument, "复制区域不能为空");
+        return Record();
+    }
+
+    Result<void> ResourceBarrier(uint32_t barrierCount, const BarrierDesc* barriers) override {
+        RHI_VALIDATE(barriers != nullptr || barrierCount == 0,
+            ErrorCode::InvalidArgument,
+            "屏障数组不能为空");
+        return Record();
+    }
+
+    Result<void> ExecuteBundle(ICommandBuffer* bundle) override {
+        RHI_VALIDATE(bundle != nullptr && bundle->GetDesc().isSecondary,
+            ErrorCode::InvalidArgument,
+            "只能执行二级命令缓冲区");
+        return Record();
+    }
+
+    NullCommandBufferState GetState() const { return m_state; }
+
+    // 最近一次录制的命令数量
+    uint64_t GetCommandCount() const { return m_commandCount; }
+
+private:
+    bool IsRecording() const { return m_state == NullCommandBufferState::Recording; }
+
+    Result<void> Record() {
+        RHI_VALIDATE(IsRecording(), ErrorCode::InvalidOperation, "命令缓冲区未处于录制状态");
+        ++m_commandCount;
+        return MakeSuccessResult();
+    }
+
+    NullCommandBufferState m_state = NullCommandBufferState::Initial;
+    bool m_insideRenderPass = false;
+    uint64_t m_commandCount = 0;
+};
+
+// 空命令池
+class NullCommandPool : public ICommandPool {
+public:
+    explicit NullCommandPool(const CommandPoolDesc& desc) {
+        m_desc = desc;
+    }
+
+    const CommandPoolDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<std::vector<ICommandBuffer*>> AllocateCommandBuffers(
+        const CommandBufferAllocateInfo& allocInfo) override {
+        RHI_VALIDATE(allocInfo.count > 0, ErrorCode::InvalidArgument, "分配数量必须大于0");
+
+        CommandBufferDesc desc;
+        desc.type = allocInfo.level;
+        desc.usage = allocInfo.usage;
+        desc.isSecondary = allocInfo.level == CommandBufferType::Bundle;
+
+        std::vector<ICommandBuffer*> commandBuffers;
+        commandBuffers.reserve(allocInfo.count);
+        for (uint32_t i = 0; i < allocInfo.count; ++i) {
+            m_commandBuffers.push_back(CreateCommandBuffer(desc));
+            commandBuffers.push_back(m_commandBuffers.back().get());
+        }
+        return MakeSuccessResult(std::move(commandBuffers));
+    }
+
+    Result<void> FreeCommandBuffers(const std::vector<ICommandBuffer*>& commandBuffers) override {
+        for (ICommandBuffer* commandBuffer : commandBuffers) {
+            auto it = std::find_if(m_commandBuffers.begin(), m_commandBuffers.end(),
+                [commandBuffer](const std::unique_ptr<NullCommandBuffer>& owned) {
+                    return owned.get() == commandBuffer;
+                });
+            RHI_RETURN_IF_FALSE(it != m_commandBuffers.end(),
+                ErrorCode::InvalidArgument,
+                "命令缓冲区不属于此命令池");
+            m_commandBuffers.erase(it);
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        for (auto& commandBuffer : m_commandBuffers) {
+            RHI_RETURN_IF_FAILED(commandBuffer->Reset());
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> Trim() override {
+        return MakeSuccessResult();
+    }
+
+protected:
+    // 创建命令缓冲区对象（派生后端可返回录制命令内容的命令缓冲区）
+    virtual std::unique_ptr<NullCommandBuffer> CreateCommandBuffer(const CommandBufferDesc& desc) {
+        return std::make_unique<NullCommandBuffer>(desc);
+    }
+
+private:
+    std::vector<std::unique_ptr<NullCommandBuffer>> m_commandBuffers;
+};
+
+// 空交换链
+class NullSwapChain : public ISwapChain {
+public:
+    Result<void> Initialize(const SwapChainDesc& desc) override {
+        RHI_VALIDATE(desc.width > 0 && desc.height > 0,
+            ErrorCode::InvalidArgument,
+            "交换链尺寸必须大于0");
+        RHI_VALIDATE(desc.bufferCount > 0,
+            ErrorCode::InvalidBufferCount,
+            "缓冲数量必须大于0");
+        m_desc = desc;
+        m_currentIndex = 0;
+        return CreateBackBuffers();
+    }
+
+    Result<void> Cleanup() override {
+        m_backBuffers.clear();
+        return MakeSuccessResult();
+    }
+
+    Result<void> Resize(uint32_t width, uint32_t height) override {
+        RHI_VALIDATE(width > 0 && height > 0,
+            ErrorCode::InvalidArgument,
+            "交换链尺寸必须大于0");
+        m_desc.width = width;
+        m_desc.height = height;
+        m_currentIndex = 0;
+        return CreateBackBuffers();
+    }
+
+    Result<uint32_t> GetCurrentBackBufferIndex() const override {
+        return MakeSuccessResult(m_currentIndex);
+    }
+
+    Result<uint32_t> GetBufferCount() const override {
+        return MakeSuccessResult(m_desc.bufferCount);
+    }
+
+    const SwapChainDesc& GetDesc() const override { return m_desc; }
+
+    Result<void> Present(const PresentInfo& presentInfo) override {
+        RHI_VALIDATE(presentInfo.backBufferIndex < m_desc.bufferCount,
+            ErrorCode::InvalidArgument,
+            "无效的后缓冲区索引: " + std::to_string(presentInfo.backBufferIndex));
+        m_currentIndex = (m_currentIndex + 1) % m_desc.bufferCount;
+        return MakeSuccessResult();
+    }
+
+    Result<void> WaitForPresent() override {
+        return MakeSuccessResult();
+    }
+
+    Result<bool> IsPresentModeSupported(PresentMode) const override {
+        return MakeSuccessResult(true);
+    }
+
+    // 返回当前后缓冲区的ITexture*
+    Result<void*> GetCurrentBackBufferHandle() override {
+        RHI_RETURN_IF_FALSE(m_currentIndex < m_backBuffers.size(),
+            ErrorCode::InvalidOperation,
+            "交换链未初始化");
+        return MakeSuccessResult(static_cast<void*>(
+            static_cast<ITexture*>(m_backBuffers[m_currentIndex].get())));
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+protected:
+    // 创建后缓冲区纹理（派生后端可返回带存储的纹理）
+    virtual std::unique_ptr<NullTexture> CreateBackBuffer(const TextureDesc& desc) {
+        return std::make_unique<NullTexture>(desc);
+    }
+
+private:
+    Result<void> CreateBackBuffers() {
+        TextureDesc textureDesc;
+        textureDesc.format = m_desc.format;
+        textureDesc.width = m_desc.width;
+        textureDesc.height = m_desc.height;
+        textureDesc.usage = TextureUsage::RenderTarget | TextureUsage::TransferDst;
+
+        m_backBuffers.clear();
+        for (uint32_t i = 0; i < m_desc.bufferCount; ++i) {
+            m_backBuffers.push_back(CreateBackBuffer(textureDesc));
+        }
+        return MakeSuccessResult();
+    }
+
+    std::vector<std::unique_ptr<NullTexture>> m_backBuffers;
+    uint32_t m_currentIndex = 0;
+};
+
+// 空队列
+class NullQueue : public IQueue {
+public:
+    explicit NullQueue(const QueueDesc& desc) {
+        m_desc = desc;
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<void> Submit(
+        const std::vector<ICommandBuffer*>& commandBuffers,
+        const std::vector<ISemaphore*>& waitSemaphores,
+        const std::vector<ISemaphore*>& signalSemaphores,
+        IFence* fence) override {
+        for (ICommandBuffer* commandBuffer : commandBuffers) {
+            RHI_VALIDATE(commandBuffer != nullptr && !commandBuffer->GetDesc().isSecondary,
+                ErrorCode::InvalidArgument,
+                "只能提交一级命令缓冲区");
+            RHI_VALIDATE(static_cast<NullCommandBuffer*>(commandBuffer)->GetState() ==
+                NullCommandBufferState::Executable,
+                ErrorCode::InvalidOperation,
+                "命令缓冲区未结束录制");
+        }
+
+        RHI_VALIDATE(fence == nullptr || fence->GetLastSubmittedValue() <= m_submitCount + 1,
+            ErrorCode::SyncError,
+            "栅栏值不能减小");
+
+        // 没有GPU工作：等待立即满足，信号立即发出
+        for (ISemaphore* semaphore : waitSemaphores) {
+            static_cast<NullSemaphore*>(semaphore)->ConsumeOnWait();
+        }
+        for (ISemaphore* semaphore : signalSemaphores) {
+            static_cast<NullSemaphore*>(semaphore)->SignalOnSubmit();
+        }
+        ++m_submitCount;
+        if (fence != nullptr) {
+            RHI_RETURN_IF_FAILED(fence->Signal(m_submitCount));
+        }
+        return MakeSuccessResult();
+    }
+
+    // 每个提交计为一次提交，fence被设为最后一次提交的序号
+    // 整批通过检查后才消耗、发出信号量并推进提交序号，失败时不留下部分提交的状态
+    Result<void> SubmitBatch(
+        Span<const SubmitDesc> submits,
+        IFence* fence) override {
+        RHI_RETURN_IF_FAILED(ValidateBatch(submits, fence));
+        return CommitBatch(submits, fence);
+    }
+
+    Result<void> WaitIdle() override {
+        return MakeSuccessResult();
+    }
+
+    Result<void> Present(
+        ISwapChain* swapChain,
+        uint32_t imageIndex,
+        const std::vector<ISemaphore*>& waitSemaphores) override {
+        RHI_VALIDATE(swapChain != nullptr, ErrorCode::InvalidArgument, "交换链不能为空");
+        for (ISemaphore* semaphore : waitSemaphores) {
+            static_cast<NullSemaphore*>(semaphore)->ConsumeOnWait();
+        }
+        PresentInfo presentInfo;
+        presentInfo.backBufferIndex = imageIndex;
+        return swapChain->Present(presentInfo);
+    }
+
+    const QueueDesc& GetDesc() const { return m_desc; }
+
+    // 已提交次数（提交带栅栏时，栅栏被设为该值）
+    uint64_t GetSubmitCount() const { return m_submitCount; }
+
+protected:
+    Result<void> ValidateBatch(Span<const SubmitDesc> submits, IFence* fence) const {
+        RHI_VALIDATE(!submits.empty(), ErrorCode::InvalidArgument, "批量提交不能为空");
+        for (size_t i = 0; i < submits.size(); ++i) {
+            const SubmitDesc& submit = submits[i];
+            for (ICommandBuffer* commandBuffer : submit.commandBuffers) {
+                RHI_VALIDATE(commandBuffer != nullptr && !commandBuffer->GetDesc().isSecondary,
+                    ErrorCode::InvalidArgument,
+                    "只能提交一级命令缓冲区");
+                RHI_VALIDATE(static_cast<NullCommandBuffer*>(commandBuffer)->GetState() ==
+                    NullCommandBufferState::Executable,
+                    ErrorCode::InvalidOperation,
+                    "命令缓冲区未结束录制");
+            }
+            for (const SemaphoreWaitInfo& wait : submit.waitSemaphores) {
+                RHI_VALIDATE(wait.semaphore != nullptr, ErrorCode::InvalidArgument, "等待的信号量不能为空");
+            }
+            for (size_t s = 0; s < submit.signalSemaphores.size(); ++s) {
+                const SemaphoreSignalInfo& signal = submit.signalSemaphores[s];
+                RHI_VALIDATE(signal.semaphore != nullptr, ErrorCode::InvalidArgument, "发出的信号量不能为空");
+                // 发出时同样会检查，这里提前检查以免批次只发出一部分
+                RHI_RETURN_IF_FALSE(signal.semaphore->IsBinary() || signal.value > GetBatchSignalValue(submits, i, s),
+                    ErrorCode::SyncError,
+                    "时间线信号量的值必须递增");
+            }
+        }
+        RHI_VALIDATE(fence == nullptr || fence->GetLastSubmittedValue() <= m_submitCount + submits.size(),
+            ErrorCode::SyncError,
+            "栅栏值不能减小");
+        return MakeSuccessResult();
+    }
+
+    Result<void> CommitBatch(Span<const SubmitDesc> submits, IFence* fence) {
+        for (const SubmitDesc& submit : submits) {
+            for (const SemaphoreWaitInfo& wait : submit.waitSemaphores) {
+                static_cast<NullSemaphore*>(wait.semaphore)->ConsumeOnWait();
+            }
+            for (const SemaphoreSignalInfo& signal : submit.signalSemaphores) {
+                RHI_RETURN_IF_FAILED(static_cast<NullSemaphore*>(signal.semaphore)->SignalOnSubmit(signal.value));
+            }
+        }
+        m_submitCount += submits.size();
+        if (fence != nullptr) {
+            RHI_RETURN_IF_FAILED(fence->Signal(m_submitCount));
+        }
+        return MakeSuccessResult();
+    }
+
+private:
+    // 时间线信号量在批次中第submitIndex个提交的第signalIndex个信号之前的值（包括批次中先前发出的值）
+    static uint64_t GetBatchSignalValue(Span<const SubmitDesc> submits, size_t submitIndex, size_t signalIndex) {
+        ISemaphore* semaphore = submits[submitIndex].signalSemaphores[signalIndex].semaphore;
+        uint64_t value = static_cast<NullSemaphore*>(semaphore)->GetCurrentValue();
+        for (size_t i = 0; i <= submitIndex; ++i) {
+            size_t count = i < submitIndex ? submits[i].signalSemaphores.size() : signalIndex;
+            for (size_t s = 0; s < count; ++s) {
+                const SemaphoreSignalInfo& signal = submits[i].signalSemaphores[s];
+                value = signal.semaphore == semaphore ? std::max(value, signal.value) : value;
+            }
+        }
+        return value;
+    }
+
+    uint64_t m_submitCount = 0;
+};
+
+// 空/CPU设备的FlushMappedRanges：主机存储无需刷新，只校验范围并统计真实后端会交给驱动的刷新
+class NullFlushCounter {
+public:
+    Result<void> Record(Span<const MappedRange> ranges) {
+        uint64_t flushed = 0;
+        for (const MappedRange& range : ranges) {
+            RHI_VALIDATE(range.buffer != nullptr && range.buffer->GetMappedData() != nullptr,
+                ErrorCode::InvalidArgument,
+                "只能刷新持久映射的缓冲区");
+            RHI_VALIDATE(range.offset + range.size <= range.buffer->GetDesc().size,
+                ErrorCode::InvalidArgument,
+                "刷新范围越界");
+            flushed += range.buffer->IsHostCoherent() ? 0 : 1;
+        }
+        if (flushed > 0) {
+            m_calls.fetch_add(1, std::memory_order_relaxed);
+            m_ranges.fetch_add(flushed, std::memory_order_relaxed);
+        }
+        return MakeSuccessResult();
+    }
+
+    uint64_t GetCallCount() const { return m_calls.load(std::memory_order_relaxed); }
+    uint64_t GetRangeCount() const { return m_ranges.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_calls{0};
+    std::atomic<uint64_t> m_ranges{0};
+};
+
+// 空/CPU设备创建纹理前的描述检查
+inline Result<void> ValidateNullTextureDesc(const TextureDesc& desc) {
+    RHI_VALIDATE(desc.width > 0 && desc.height > 0 && desc.depth > 0,
+        ErrorCode::InvalidArgument,
+        "纹理尺寸必须大于0");
+    RHI_VALIDATE(desc.mipLevels > 0 && desc.arraySize > 0 && desc.sampleCount > 0,
+        ErrorCode::InvalidArgument,
+        "纹理mip级别、数组大小与采样数必须大于0");
+    RHI_VALIDATE(IsValidTransientUsage(desc.usage),
+        ErrorCode::InvalidArgument,
+        "瞬态附件只能与RenderTarget/DepthStencil用途组合");
+    return MakeSuccessResult();
+}
+
+// 空/CPU后端的放置需求：大小向上取整到对齐
+inline ResourceAllocationInfo GetNullBufferAllocationInfo(const BufferDesc& desc) {
+    size_t alignment = kNullBufferPlacementAlignment;
+    return ResourceAllocationInfo{(desc.size + alignment - 1) & ~(alignment - 1), alignment};
+}
+
+inline ResourceAllocationInfo GetNullTextureAllocationInfo(const TextureDesc& desc) {
+    size_t alignment = kNullTexturePlacementAlignment;
+    return ResourceAllocationInfo{(EstimateTextureDataSize(desc) + alignment - 1) & ~(alignment - 1), alignment};
+}
+
+// 检查放置资源的偏移对齐与范围（不检查与其他资源重叠，别名是允许的）
+inline Result<void> ValidateNullPlacement(
+    IMemory* memory,
+    MemoryType type,
+    size_t offset,
+    const ResourceAllocationInfo& info) {
+    RHI_RETURN_IF_FALSE(memory != nullptr, ErrorCode::InvalidArgument, "内存块不能为空");
+    const MemoryDesc& memoryDesc = memory->GetDesc();
+    RHI_RETURN_IF_FALSE(memoryDesc.type == type,
+        ErrorCode::InvalidArgument,
+        "资源的内存类型与内存块不一致");
+    RHI_RETURN_IF_FALSE(offset % info.alignment == 0,
+        ErrorCode::InvalidArgument,
+        "放置偏移未对齐: " + std::to_string(offset) + " % " + std::to_string(info.alignment));
+    RHI_RETURN_IF_FALSE(offset <= memoryDesc.size && info.size <= memoryDesc.size - offset,
+        ErrorCode::InvalidArgument,
+        "放置范围超出内存块: " + std::to_string(offset) + "+" + std::to_string(info.size) +
+        " > " + std::to_string(memoryDesc.size));
+    return MakeSuccessResult();
+}
+
+// 空设备
+class NullDevice : public IDevice {
+public:
+    explicit NullDevice(const DeviceDesc& desc) {
+        m_desc = desc;
+
+        // 每种队列类型至少创建一个队列，描述中同类型的多个条目对应多个队列索引
+        const QueueType types[] = {
+            QueueType::Graphics, QueueType::Compute, QueueType::Transfer, QueueType::Present
+        };
+        for (QueueType type : types) {
+            uint32_t count = 0;
+            for (const QueueDesc& queueDesc : desc.queues) {
+                if (queueDesc.type == type) {
+                    m_queues.push_back(std::make_unique<NullQueue>(queueDesc));
+                    ++count;
+                }
+            }
+            if (count == 0) {
+                QueueDesc queueDesc = {};
+                queueDesc.type = type;
+                queueDesc.queueFamilyIndex = static_cast<uint32_t>(type);
+                m_queues.push_back(std::make_unique<NullQueue>(queueDesc));
+            }
+        }
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    Result<IQueue*> GetQueue(QueueType type, uint32_t index) override {
+        uint32_t current = 0;
+        for (auto& queue : m_queues) {
+            if (queue->GetDesc().type == type && current++ == index) {
+                return MakeSuccessResult(static_cast<IQueue*>(queue.get()));
+            }
+        }
+        return MakeErrorResult<IQueue*>(
+            ErrorCode::InvalidArgument,
+            "队列索引越界: " + std::to_string(index));
+    }
+
+    Result<ICommandPool*> CreateCommandPool(QueueType type, bool transient = false) override {
+        CommandPoolDesc desc;
+        desc.queueType = type;
+        desc.flags = transient ? CommandPoolFlag::Transient : CommandPoolFlag::None;
+        desc.queueFamilyIndex = static_cast<uint32_t>(type);
+        return MakeSuccessResult(static_cast<ICommandPool*>(new NullCommandPool(desc)));
+    }
+
+    Result<ISwapChain*> CreateSwapChain(const SwapChainDesc& desc) override {
+        auto swapChain = std::make_unique<NullSwapChain>();
+        RHI_RETURN_IF_FAILED(swapChain->Initialize(desc));
+        return MakeSuccessResult(static_cast<ISwapChain*>(swapChain.release()));
+    }
+
+    Result<IBuffer*> CreateBuffer(const BufferDesc& desc) override {
+        RHI_VALIDATE(desc.size > 0, ErrorCode::InvalidArgument, "缓冲区大小必须大于0");
+        NullBuffer* buffer = new NullBuffer(desc);
+        m_memoryTracker.Track(buffer->GetMemoryTracking(), MemoryAllocationKind::Buffer,
+            buffer, desc.size, desc.memoryType, desc.tag);
+        return MakeSuccessResult(static_cast<IBuffer*>(buffer));
+    }
+
+    // 瞬态附件按延迟分配处理，不计入内存用量
+    Result<ITexture*> CreateTexture(const TextureDesc& desc) override {
+        RHI_RETURN_IF_FAILED(ValidateNullTextureDesc(desc));
+        NullTexture* texture = new NullTexture(desc);
+        bool lazy = (desc.usage & TextureUsage::Transient) != TextureUsage::None;
+        m_memoryTracker.Track(texture->GetMemoryTracking(), MemoryAllocationKind::Texture,
+            texture, lazy ? 0 : EstimateTextureDataSize(desc), MemoryType::Default, desc.tag);
+        return MakeSuccessResult(static_cast<ITexture*>(texture));
+    }
+
+    Result<void> FlushMappedRanges(Span<const MappedRange> ranges) override {
+        return m_flushCounter.Record(ranges);
+    }
+
+    // FlushMappedRanges中需要交给驱动的调用次数与范围数（HostCoherent的缓冲区不计）
+    uint64_t GetFlushCallCount() const { return m_flushCounter.GetCallCount(); }
+    uint64_t GetFlushedRangeCount() const { return m_flushCounter.GetRangeCount(); }
+
+    Result<ResourceAllocationInfo> GetBufferAllocationInfo(const BufferDesc& desc) override {
+        return MakeSuccessResult(GetNullBufferAllocationInfo(desc));
+    }
+
+    Result<ResourceAllocationInfo> GetTextureAllocationInfo(const TextureDesc& desc) override {
+        return MakeSuccessResult(GetNullTextureAllocationInfo(desc));
+    }
+
+    // 空后端没有物理内存，瞬态附件总是按延迟分配处理
+    bool SupportsLazilyAllocatedMemory() const override { return true; }
+
+    Result<IBuffer*> CreatePlacedBuffer(const BufferDesc& desc, IMemory* memory, size_t offset) override {
+        RHI_VALIDATE(desc.size > 0, ErrorCode::InvalidArgument, "缓冲区大小必须大于0");
+        RHI_RETURN_IF_FAILED(ValidateNullPlacement(memory, desc.memoryType, offset, GetNullBufferAllocationInfo(desc)));
+        NullBuffer* buffer = new NullBuffer(desc, static_cast<NullMemory*>(memory), offset);
+        m_memoryTracker.Track(buffer->GetMemoryTracking(), MemoryAllocationKind::Buffer,
+            buffer, desc.size, desc.memoryType, desc.tag, memory, offset);
+        return MakeSuccessResult(static_cast<IBuffer*>(buffer));
+    }
+
+    Result<ITexture*> CreatePlacedTexture(const TextureDesc& desc, IMemory* memory, size_t offset) override {
+        RHI_RETURN_IF_FAILED(ValidateNullTextureDesc(desc));
+        RHI_RETURN_IF_FAILED(ValidateNullPlacement(
+            memory, MemoryType::Default, offset, GetNullTextureAllocationInfo(desc)));
+        NullTexture* texture = new NullTexture(desc);
+        m_memoryTracker.Track(texture->GetMemoryTracking(), MemoryAllocationKind::Texture,
+            texture, EstimateTextureDataSize(desc), MemoryType::Default, desc.tag, memory, offset);
+        return MakeSuccessResult(static_cast<ITexture*>(texture));
+    }
+
+    Result<IShader*> CreateShader(const ShaderDesc& desc) override {
+        return MakeSuccessResult(static_cast<IShader*>(new NullShader(desc)));
+    }
+
+    Result<IPipelineState*> CreatePipelineState(const PipelineStateDesc& desc) override {
+        RHI_RETURN_IF_FALSE(IsValidPipelineStateDesc(desc), ErrorCode::InvalidArgument,
+            "管线描述必须是与type一致的GraphicsPipelineStateDesc或ComputePipelineStateDesc");
+        return MakeSuccessResult(static_cast<IPipelineState*>(new NullPipelineState(desc)));
+    }
+
+    Result<IDescriptorSetLayout*> CreateDescriptorSetLayout(const DescriptorSetLayoutDesc& desc) override {
+        return MakeSuccessResult(static_cast<IDescriptorSetLayout*>(new NullDescriptorSetLayout(desc)));
+    }
+
+    Result<IDescriptorPool*> CreateDescriptorPool(const DescriptorPoolDesc& desc) override {
+        return MakeSuccessResult(static_cast<IDescriptorPool*>(new NullDescriptorPool(desc)));
+    }
+
+    Result<IFence*> CreateFence(const FenceDesc& desc) override {
+        return MakeSuccessResult(static_cast<IFence*>(new NullFence(desc)));
+    }
+
+    Result<ISemaphore*> CreateSemaphore(const SemaphoreDesc& desc) override {
+        return MakeSuccessResult(static_cast<ISemaphore*>(new NullSemaphore(desc)));
+    }
+
+    Result<IEvent*> CreateEvent(const EventDesc& desc) override {
+        return MakeSuccessResult(static_cast<IEvent*>(new NullEvent(desc)));
+    }
+
+    Result<IMemory*> AllocateMemory(const MemoryDesc& desc) override {
+        RHI_VALIDATE(desc.size > 0, ErrorCode::InvalidArgument, "内存大小必须大于0");
+        NullMemory* memory = new NullMemory(desc, &m_residentBytes);
+        m_memoryTracker.Track(memory->GetMemoryTracking(), MemoryAllocationKind::Memory,
+            memory, desc.size, desc.type, desc.tag);
+        return MakeSuccessResult(static_cast<IMemory*>(memory));
+    }
+
+    Result<MemoryBudget> GetMemoryBudget() override {
+        return MakeSuccessResult(MemoryBudget{
+            kNullDedicatedVideoMemory, m_residentBytes.load(std::memory_order_relaxed)});
+    }
+
+    MemoryTracker& GetMemoryTracker() override { return m_memoryTracker; }
+
+    Result<void> WaitMultiple(
+        Span<const SemaphoreWaitInfo> waits,
+        SemaphoreWaitMode mode,
+        uint64_t timeout) override {
+        // 与Vulkan后端的上限一致，便于在空后端上发现超限的调用
+        RHI_RETURN_IF_FALSE(waits.size() <= kMaxWaitMultipleSemaphores,
+            ErrorCode::InvalidArgument,
+            "等待的信号量过多: " + std::to_string(waits.size()));
+        return WaitNullSemaphores(waits, mode, timeout);
+    }
+
+    Result<void> WaitIdle() override {
+        return MakeSuccessResult();
+    }
+
+private:
+    MemoryTracker m_memoryTracker;              // 最先声明、最后析构：报告设备销毁时仍存活的分配
+    std::vector<std::unique_ptr<NullQueue>> m_queues;
+    std::atomic<uint64_t> m_residentBytes{0};   // 驻留的MemoryType::Default内存字节数
+    NullFlushCounter m_flushCounter;
+};
+
+// 空适配器
+class NullAdapter : public IAdapter {
+public:
+    NullAdapter() {
+        m_info = {};
+        m_info.name = "RHI Null Adapter";
+        m_info.vendor = "RHI";
+        m_info.type = AdapterType::Software;
+        m_info.dedicatedVideoMemory = kNullDedicatedVideoMemory;
+
+        DeviceLimits& limits = m_info.limits;
+        limits.maxImageDimension1D = 16384;
+        limits.maxImageDimension2D = 16384;
+        limits.maxImageDimension3D = 2048;
+        limits.maxImageDimensionCube = 16384;
+        limits.maxImageArrayLayers = 2048;
+        limits.maxTexelBufferElements = 1u << 27;
+        limits.maxUniformBufferRange = 65536;
+        limits.maxStorageBufferRange = 0xFFFFFFFFu;
+        limits.maxPushConstantsSize = 256;
+        limits.minUniformBufferOffsetAlignment = 256;
+        limits.minStorageBufferOffsetAlignment = 256;
+        limits.maxMemoryAllocationCount = 4096;
+        limits.maxSamplerAllocationCount = 4000;
+        limits.maxBoundDescriptorSets = 8;
+        limits.maxViewports = 16;
+        limits.maxViewportDimensions[0] = 16384;
+        limits.maxViewportDimensions[1] = 16384;
+        limits.maxComputeWorkGroupInvocations = 1024;
+        for (uint32_t i = 0; i < 3; ++i) {
+            limits.maxComputeWorkGroupCount[i] = 65535;
+            limits.maxComputeWorkGroupSize[i] = 1024;
+        }
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(static_cast<void*>(this));
+    }
+
+    const AdapterInfo& GetAdapterInfo() const override { return m_info; }
+
+    // 图形、计算、传输各一个队列族，队列族索引与QueueType取值一致
+    Result<std::vector<QueueFamilyProperties>> GetQueueFamilyProperties() const override {
+        std::vector<QueueFamilyProperties> families;
+        const QueueType types[] = { QueueType::Graphics, QueueType::Compute, QueueType::Transfer };
+        for (QueueType type : types) {
+            QueueFamilyProperties properties = {};
+            properties.type = type;
+            properties.queueCount = 1;
+            properties.timestampValidBits = 64;
+            properties.minImageTransferGranularity[0] = 1;
+            properties.minImageTransferGranularity[1] = 1;
+            properties.minImageTransferGranularity[2] = 1;
+            properties.graphicsSupport = type == QueueType::Graphics;
+            properties.computeSupport = type != QueueType::Transfer;
+            properties.transferSupport = true;
+            families.push_back(properties);
+        }
+        return MakeSuccessResult(std::move(families));
+    }
+
+    Result<bool> CheckPresentSupport(uint32_t queueFamilyIndex, void*) const override {
+        return MakeSuccessResult(queueFamilyIndex == static_cast<uint32_t>(QueueType::Graphics));
+    }
+
+    Result<void> GetMemoryProperties(
+        uint32_t* memoryTypeCount,
+        void*,
+        uint32_t* memoryHeapCount,
+        void*) const override {
+        if (memoryTypeCount != nullptr) {
+            *memoryTypeCount = 0;
+        }
+        if (memoryHeapCount != nullptr) {
+            *memoryHeapCount = 0;
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> GetFormatProperties(Format format, void*) const override {
+        RHI_RETURN_IF_FALSE(GetFormatBlockSize(format) > 0,
+            ErrorCode::InvalidArgument,
+            "不支持的格式: " + std::to_string(static_cast<int>(format)));
+        return MakeSuccessResult();
+    }
+
+    bool CheckFeatureSupport(const std::string&) const override {
+        return false;
+    }
+
+    Result<IDevice*> CreateDevice(const DeviceDesc& desc) override {
+        return MakeSuccessResult(static_cast<IDevice*>(new NullDevice(desc)));
+    }
+
+protected:
+    AdapterInfo m_info;
+};
+
+// 枚举空后端适配器（符合EnumerateAdaptersFunc签名，返回的适配器由调用者释放）
+inline Result<std::vector<IAdapter*>> EnumerateNullAdapters() {
+    return MakeSuccessResult(std::vector<IAdapter*>{ new NullAdapter() });
+}
+
+} // namespace RHI
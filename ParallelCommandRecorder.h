@@ -0,0 +1,224 @@
+#pragma once
+#include "CommandPool.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace RHI {
+
+// 录制[begin, end)范围内的条目到命令包中（命令包已Begin，返回后由录制器End）
+using ParallelRecordFunc = std::function<Result<void>(ICommandBuffer* bundle, uint32_t begin, uint32_t end)>;
+
+// 命令包Begin之前的回调（如Vulkan后端需要设置继承的渲染附件格式）
+using BundlePrepareFunc = std::function<void(ICommandBuffer* bundle)>;
+
+// 并行命令录制器统计
+struct ParallelCommandRecorderStats {
+    uint64_t bundleAllocations = 0;   // 从命令池新分配的命令包数（热身后应保持不变）
+    uint64_t bundleReuses = 0;        // 复用已有命令包的次数
+    uint64_t poolResets = 0;          // 命令池重置次数
+    uint64_t fenceStalls = 0;         // BeginFrame时GPU尚未完成、需要阻塞等待的次数
+};
+
+// 多线程命令录制器
+// 条目被划分为与线程数相同的连续分块并行录制，之后按分块顺序通过ExecuteBundle拼接到主命令缓冲区，
+// 因此录制结果与线程调度无关。
+// 与FrameCommandAllocator相同，每个帧槽位为每个分块维护一个瞬态命令池，同一命令池任何时刻只被一个线程访问。
+// 每次Record从各分块的命令池取出新的命令包，同一帧内可以多次Record；BeginFrame轮转到framesInFlight帧之前
+// 使用过的槽位，等待其提交的栅栏值或时间线信号量值后才重置命令池，因此不会覆盖仍在执行的命令包。
+// 提交包含本帧命令包的主命令缓冲区后须调用TrackSubmission。
+class ParallelCommandRecorder {
+public:
+    // threadCount为0时使用硬件并发数
+    ParallelCommandRecorder(IDevice* device, QueueType queueType, uint32_t threadCount = 0, uint32_t framesInFlight = 2)
+        : m_device(device), m_queueType(queueType), m_threadCount(threadCount), m_framesInFlight(framesInFlight) {}
+
+    ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+    ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_device != nullptr, ErrorCode::InvalidArgument, "录制器的设备不能为空");
+        RHI_VALIDATE(m_framesInFlight > 0, ErrorCode::InvalidArgument, "framesInFlight必须大于0");
+        m_workerPool.reset(new WorkerPool(m_threadCount));
+        uint32_t chunkCount = m_workerPool->GetThreadCount();
+
+        m_slots.resize(m_framesInFlight);
+        for (FrameSlot& slot : m_slots) {
+            slot.chunks.resize(chunkCount);
+            for (ChunkPool& chunk : slot.chunks) {
+                auto pool = m_device->CreateCommandPool(m_queueType, true);
+                RHI_RETURN_IF_FAILED(pool);
+                chunk.pool.reset(pool.GetValue());
+            }
+        }
+        m_recorded.assign(chunkCount, nullptr);
+        m_results.assign(chunkCount, MakeSuccessResult());
+        return MakeSuccessResult();
+    }
+
+    // 开始新的一帧：等待该槽位上一轮的提交完成，然后重置其命令池
+    Result<void> BeginFrame() {
+        RHI_VALIDATE(!m_slots.empty(), ErrorCode::InvalidOperation, "BeginFrame必须在Initialize之后调用");
+        ++m_frameCount;
+        FrameSlot& slot = GetCurrentSlot();
+        for (const SyncPoint& syncPoint : slot.syncPoints) {
+            auto completed = syncPoint.fence != nullptr ? syncPoint.fence->GetValue() : syncPoint.semaphore->GetValue();
+            RHI_RETURN_IF_FAILED(completed);
+            if (completed.GetValue() < syncPoint.value) {
+                ++m_stats.fenceStalls;
+                RHI_RETURN_IF_FAILED(syncPoint.fence != nullptr ?
+                    syncPoint.fence->Wait(syncPoint.value, UINT64_MAX) :
+                    syncPoint.semaphore->Wait(syncPoint.value, UINT64_MAX));
+            }
+        }
+        slot.syncPoints.clear();
+        for (ChunkPool& chunk : slot.chunks) {
+            if (chunk.used == 0) {
+                continue;
+            }
+            RHI_RETURN_IF_FAILED(chunk.pool->Reset());
+            chunk.used = 0;
+            ++m_stats.poolResets;
+        }
+        return MakeSuccessResult();
+    }
+
+    // 并行录制itemCount个条目并按顺序拼接到primary（primary须处于录制状态）
+    // 返回按分块顺序的第一个错误；出错时不会向primary写入任何命令包
+    Result<void> Record(ICommandBuffer* primary, uint32_t itemCount,
+                        const ParallelRecordFunc& func, const BundlePrepareFunc& prepare = nullptr) {
+        RHI_VALIDATE(m_frameCount > 0, ErrorCode::InvalidOperation, "Record必须在BeginFrame之后调用");
+        RHI_VALIDATE(primary != nullptr && func, ErrorCode::InvalidArgument, "主命令缓冲区与录制函数不能为空");
+        if (itemCount == 0) {
+            return MakeSuccessResult();
+        }
+
+        uint32_t chunkCount = std::min(itemCount, static_cast<uint32_t>(m_recorded.size()));
+        m_workerPool->ParallelFor(chunkCount, [&](uint32_t chunk) {
+            uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(itemCount) * chunk / chunkCount);
+            uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(itemCount) * (chunk + 1) / chunkCount);
+            m_results[chunk] = RecordChunk(chunk, begin, end, func, prepare);
+        });
+
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+            RHI_RETURN_IF_FAILED(m_results[chunk]);
+        }
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+            RHI_RETURN_IF_FAILED(primary->ExecuteBundle(m_recorded[chunk]));
+        }
+        return MakeSuccessResult();
+    }
+
+    // 记录当前帧的一次提交；BeginFrame回收该槽位前会等待fence到达value
+    void TrackSubmission(IFence* fence, uint64_t value) {
+        TrackSyncPoint(fence, nullptr, value);
+    }
+
+    // 记录当前帧的一次提交；BeginFrame回收该槽位前会等待时间线信号量到达value
+    void TrackSubmission(ISemaphore* semaphore, uint64_t value) {
+        TrackSyncPoint(nullptr, semaphore, value);
+    }
+
+    // 参与录制的线程数（即每次Record最多产生的命令包数）
+    uint32_t GetThreadCount() const { return m_workerPool ? m_workerPool->GetThreadCount() : 0; }
+
+    // 已开始的帧数
+    uint64_t GetFrameCount() const { return m_frameCount; }
+
+    // 不能与Record并发调用
+    ParallelCommandRecorderStats GetStats() const {
+        ParallelCommandRecorderStats stats = m_stats;
+        for (const FrameSlot& slot : m_slots) {
+            for (const ChunkPool& chunk : slot.chunks) {
+                stats.bundleAllocations += chunk.allocations;
+                stats.bundleReuses += chunk.reuses;
+            }
+        }
+        return stats;
+    }
+
+private:
+    // 栅栏或时间线信号量上的一个值
+    struct SyncPoint {
+        IFence* fence;
+        ISemaphore* semaphore;
+        uint64_t value;
+    };
+
+    // 一个分块在一个帧槽位中的命令池与命令包（只由录制该分块的线程访问）
+    struct ChunkPool {
+        std::unique_ptr<ICommandPool> pool;     // 命令池拥有其中的命令包
+        std::vector<ICommandBuffer*> bundles;
+        uint32_t used = 0;                       // 当前帧已取出的命令包数
+        uint64_t allocations = 0;
+        uint64_t reuses = 0;
+    };
+
+    struct FrameSlot {
+        std::vector<ChunkPool> chunks;
+        std::vector<SyncPoint> syncPoints;      // 本槽位的提交发出的值
+    };
+
+    Result<ICommandBuffer*> AcquireBundle(ChunkPool& chunk) {
+        if (chunk.used < chunk.bundles.size()) {
+            ++chunk.reuses;
+            return MakeSuccessResult(chunk.bundles[chunk.used++]);
+        }
+        CommandBufferAllocateInfo allocInfo;
+        allocInfo.level = CommandBufferType::Bundle;
+        allocInfo.count = 1;
+        auto bundles = chunk.pool->AllocateCommandBuffers(allocInfo);
+        RHI_RETURN_IF_FAILED(bundles);
+        ++chunk.allocations;
+        chunk.bundles.push_back(bundles.GetValue()[0]);
+        return MakeSuccessResult(chunk.bundles[chunk.used++]);
+    }
+
+    Result<void> RecordChunk(uint32_t chunk, uint32_t begin, uint32_t end,
+                             const ParallelRecordFunc& func, const BundlePrepareFunc& prepare) {
+        auto acquired = AcquireBundle(GetCurrentSlot().chunks[chunk]);
+        RHI_RETURN_IF_FAILED(acquired);
+        ICommandBuffer* bundle = acquired.GetValue();
+        m_recorded[chunk] = bundle;
+        if (prepare) {
+            prepare(bundle);
+        }
+        RHI_RETURN_IF_FAILED(bundle->Begin());
+        Result<void> result = func(bundle, begin, end);
+        Result<void> endResult = bundle->End();
+        RHI_RETURN_IF_FAILED(result);
+        return endResult;
+    }
+
+    void TrackSyncPoint(IFence* fence, ISemaphore* semaphore, uint64_t value) {
+        std::vector<SyncPoint>& syncPoints = GetCurrentSlot().syncPoints;
+        for (SyncPoint& syncPoint : syncPoints) {
+            if (syncPoint.fence == fence && syncPoint.semaphore == semaphore) {
+                syncPoint.value = std::max(syncPoint.value, value);
+                return;
+            }
+        }
+        syncPoints.push_back({fence, semaphore, value});
+    }
+
+    FrameSlot& GetCurrentSlot() {
+        return m_slots[(m_frameCount - 1) % m_slots.size()];
+    }
+
+    IDevice* m_device;
+    QueueType m_queueType;
+    uint32_t m_threadCount;
+    uint32_t m_framesInFlight;
+    std::unique_ptr<WorkerPool> m_workerPool;
+    std::vector<FrameSlot> m_slots;
+    std::vector<ICommandBuffer*> m_recorded;     // 最近一次Record中各分块录制的命令包
+    std::vector<Result<void>> m_results;
+    uint64_t m_frameCount = 0;
+    ParallelCommandRecorderStats m_stats;
+};
+
+} // namespace RHI
@@ -199,17 +199,41 @@ struct BlendState {
         colorWriteMask(0xF) {}
 };
 
-// 管线布局描述
+// 管线布局描述（PipelineStateDesc::pipelineLayout指向此结构）
 struct PipelineLayoutDesc {
-    std::vector<void*> descriptorSetLayouts;  // 描述符集布局
+    std::vector<void*> descriptorSetLayouts;  // 描述符集布局（IDescriptorSetLayout*，按set索引排列）
     std::vector<void*> pushConstantRanges;    // 推送常量范围
 };
 
+// 管线类型
+enum class PipelineType {
+    Graphics,           // 图形管线（GraphicsPipelineStateDesc）
+    Compute             // 计算管线（ComputePipelineStateDesc）
+};
+
+struct GraphicsPipelineStateDesc;
+struct ComputePipelineStateDesc;
+
 // 管线状态描述基类
+// IDevice::CreatePipelineState以基类引用接收派生描述，后端通过AsGraphics/AsCompute取得派生描述：
+// 直接构造或切片复制得到的基类描述两者都返回nullptr，创建时以InvalidArgument拒绝
 struct PipelineStateDesc {
-    void* pipelineLayout;          // 管线布局
+    PipelineType type;             // 管线类型
+    void* pipelineLayout;          // 管线布局（PipelineLayoutDesc*，只在创建时读取）
     void* renderPass;              // 渲染通道（仅图形管线）
     uint32_t subpass;              // 子通道索引（仅图形管线）
+
+    PipelineStateDesc() :
+        type(PipelineType::Graphics),
+        pipelineLayout(nullptr),
+        renderPass(nullptr),
+        subpass(0) {}
+
+    virtual ~PipelineStateDesc() = default;
+
+    // 描述对象的实际类型（与type无关）
+    virtual const GraphicsPipelineStateDesc* AsGraphics() const { return nullptr; }
+    virtual const ComputePipelineStateDesc* AsCompute() const { return nullptr; }
 };
 
 // 图形管线状态描述
@@ -224,15 +248,43 @@ struct GraphicsPipelineStateDesc : public PipelineStateDesc {
     void* geometryShader;                          // 几何着色器
     void* hullShader;                              // 曲面细分控制着色器
     void* domainShader;                            // 曲面细分评估着色器
+    std::vector<Format> renderTargetFormats;       // 渲染目标格式（按附件顺序）
+    Format depthStencilFormat;                     // 深度模板格式（无深度附件时为UNKNOWN）
     uint32_t sampleCount;                          // 多重采样数
     bool alphaToCoverageEnable;                    // Alpha到覆盖率启用
+
+    GraphicsPipelineStateDesc() :
+        vertexShader(nullptr),
+        pixelShader(nullptr),
+        geometryShader(nullptr),
+        hullShader(nullptr),
+        domainShader(nullptr),
+        depthStencilFormat(Format::UNKNOWN),
+        sampleCount(1),
+        alphaToCoverageEnable(false) {
+        type = PipelineType::Graphics;
+    }
+
+    const GraphicsPipelineStateDesc* AsGraphics() const override { return this; }
 };
 
 // 计算管线状态描述
 struct ComputePipelineStateDesc : public PipelineStateDesc {
     void* computeShader;           // 计算着色器
+
+    ComputePipelineStateDesc() :
+        computeShader(nullptr) {
+        type = PipelineType::Compute;
+    }
+
+    const ComputePipelineStateDesc* AsCompute() const override { return this; }
 };
 
+// 描述对象是与type一致的派生描述（基类描述或type与实际类型不符的描述无效）
+inline bool IsValidPipelineStateDesc(const PipelineStateDesc& desc) {
+    return desc.type == PipelineType::Compute ? desc.AsCompute() != nullptr : desc.AsGraphics() != nullptr;
+}
+
 // 管线状态对象抽象基类
 class IPipelineState {
 public:
@@ -0,0 +1,913 @@
+#pragma once
+#include "Buffer.h"
+#include "CommandBuffer.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "Memory.h"
+#include "ResourceState.h"
+#include "Texture.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace RHI {
+
+constexpr uint32_t kRenderGraphInvalidIndex = UINT32_MAX;
+
+// 渲染图资源句柄（只在创建它的那一帧的图中有效）
+struct RenderGraphResource {
+    uint32_t index;
+
+    RenderGraphResource() : index(kRenderGraphInvalidIndex) {}
+    explicit RenderGraphResource(uint32_t index) : index(index) {}
+
+    bool IsValid() const { return index != kRenderGraphInvalidIndex; }
+};
+
+// 渲染图描述
+struct RenderGraphDesc {
+    size_t maxHeapSize;            // 单个瞬态堆的最大大小（字节），更大的资源单独占用一个堆
+    size_t placementAlignment;     // 瞬态资源在堆中的对齐（字节）
+
+    RenderGraphDesc() :
+        maxHeapSize(256 * 1024 * 1024),
+        placementAlignment(64 * 1024) {}
+};
+
+// 渲染图统计（最近一次Compile）
+struct RenderGraphStats {
+    uint32_t passCount = 0;                // 声明的通道数
+    uint32_t culledPassCount = 0;          // 被剔除的通道数
+    uint32_t levelCount = 0;               // 依赖层级数（每层最多一次ResourceBarrier调用）
+    uint32_t transientResourceCount = 0;   // 被使用的瞬态资源数
+    uint32_t physicalResourceCount = 0;    // 本帧使用的物理资源数
+    uint32_t createdResourceCount = 0;     // 本次Compile新创建的物理资源数
+    uint32_t barrierCount = 0;             // 每次Execute发出的屏障数
+    uint32_t barrierCallCount = 0;         // 每次Execute的ResourceBarrier调用数
+    uint32_t aliasingBarrierCount = 0;     // 其中的别名屏障数（放置资源开始使用与其他资源重叠的堆内存）
+    uint32_t heapCount = 0;                // 堆布局中的瞬态堆数
+    size_t dedicatedBytes = 0;             // 每个瞬态资源独立分配所需的内存
+    size_t physicalBytes = 0;              // 复用物理资源后所需的内存
+    size_t heapBytes = 0;                  // 按生命周期别名到瞬态堆后所需的内存
+    size_t lazilyAllocatedBytes = 0;       // 延迟分配、不占用物理内存的瞬态附件（不计入physicalBytes与heapBytes）
+};
+
+// 瞬态资源在堆布局中的位置
+struct RenderGraphPlacement {
+    uint32_t heap;      // 堆索引
+    size_t offset;      // 堆内偏移（字节）
+    size_t size;        // 估算大小（字节）
+};
+
+class RenderGraph;
+
+// 通道执行时的上下文
+class RenderGraphContext {
+public:
+    RenderGraphContext(const RenderGraph& graph, ICommandBuffer* commandBuffer)
+        : m_graph(graph), m_commandBuffer(commandBuffer) {}
+
+    ICommandBuffer* GetCommandBuffer() const { return m_commandBuffer; }
+    ITexture* GetTexture(RenderGraphResource resource) const;
+    IBuffer* GetBuffer(RenderGraphResource resource) const;
+
+private:
+    const RenderGraph& m_graph;
+    ICommandBuffer* m_commandBuffer;
+};
+
+// 通道的录制函数（通道声明的资源已处于所需状态）
+using RenderGraphExecuteFunc = std::function<Result<void>(RenderGraphContext& context)>;
+
+// 通道声明接口（由RenderGraph::AddPass返回）
+class RenderGraphPassBuilder {
+public:
+    RenderGraphPassBuilder(RenderGraph& graph, uint32_t pass)
+        : m_graph(graph), m_pass(pass) {}
+
+    // 以只读状态使用资源
+    RenderGraphPassBuilder& Read(RenderGraphResource resource, ResourceState state);
+
+    // 以可写状态使用资源（读写访问如UnorderedAccess也用Write声明）
+    RenderGraphPassBuilder& Write(RenderGraphResource resource, ResourceState state);
+
+    // 通道有图外可见的副作用（如回读、查询），不参与剔除
+    RenderGraphPassBuilder& SideEffect();
+
+private:
+    RenderGraph& m_graph;
+    uint32_t m_pass;
+};
+
+// 渲染图（帧图）
+// 每帧Reset后重新声明资源与通道，Compile之后Execute到一个命令缓冲区：
+// - 剔除：只保留有副作用、写入导入资源，或其输出被保留通道读取的通道
+// - 排序：通道按依赖层级执行，与之前的通道读写同一资源（或以不能合并的状态访问）的通道进入更后的层级，
+//   同一层级内保持声明顺序；每个层级所需的屏障合并为一次ResourceBarrier调用，同层级的只读访问合并为组合只读状态
+// - 屏障：按层级计算状态转换；瞬态资源的第一次使用从Undefined转换（内容不保留），导入资源在末尾转换到finalState
+// - 别名：描述相同且生命周期（层级区间）不重叠的瞬态资源共享同一个物理资源，物理资源在帧之间缓存复用；
+//   此外按生命周期把纹理与Default缓冲区布局到不超过maxHeapSize的瞬态堆中（GetPlacement/GetHeapSizes），
+//   堆由IDevice::AllocateMemory分配，物理资源是放置在其中的资源，即描述不同的资源也共享同一段内存；
+//   与其他资源重叠的物理资源在本帧第一次使用时以BarrierType::Aliasing屏障开始。其他内存类型的缓冲区单独分配
+// - 瞬态附件：带TextureUsage::Transient的纹理只能在一个通道内以附件状态使用；设备支持延迟分配的内存时
+//   它们不占用物理内存，不参与堆布局
+// 通道与资源名须为静态字符串。Reset不释放物理资源；ReleaseUnusedResources释放最近一次Compile未使用的物理资源，
+// 以及堆布局变化时被替换的堆与放置资源，调用者须保证使用它们的提交已经执行完毕。
+class RenderGraph {
+public:
+    explicit RenderGraph(IDevice* device, const RenderGraphDesc& desc = RenderGraphDesc())
+        : m_device(device), m_desc(desc) {}
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // 清空本帧声明的通道与资源（保留物理资源与内部存储的容量）
+    void Reset() {
+        m_resourceCount = 0;
+        m_passCount = 0;
+        m_compiled = false;
+        m_buildError = ErrorInfo{ErrorCode::Success, ""};
+    }
+
+    // 声明瞬态纹理（由图创建并管理，只在本帧内有效）
+    RenderGraphResource CreateTexture(const char* name, const TextureDesc& desc) {
+        VirtualResource& resource = AddResource(name, BarrierResourceType::Texture);
+        resource.textureDesc = desc;
+        return RenderGraphResource(m_resourceCount - 1);
+    }
+
+    // 声明瞬态缓冲区
+    RenderGraphResource CreateBuffer(const char* name, const BufferDesc& desc) {
+        VirtualResource& resource = AddResource(name, BarrierResourceType::Buffer);
+        resource.bufferDesc = desc;
+        return RenderGraphResource(m_resourceCount - 1);
+    }
+
+    // 导入外部纹理：进入图时处于initialState，Execute结束时转换到finalState
+    RenderGraphResource ImportTexture(const char* name, ITexture* texture,
+                                      ResourceState initialState, ResourceState finalState) {
+        VirtualResource& resource = AddResource(name, BarrierResourceType::Texture);
+        resource.external = texture;
+        resource.initialState = initialState;
+        resource.finalState = finalState;
+        if (texture == nullptr) {
+            SetBuildError("导入的纹理不能为空");
+        }
+        return RenderGraphResource(m_resourceCount - 1);
+    }
+
+    RenderGraphResource ImportBuffer(const char* name, IBuffer* buffer,
+                                     ResourceState initialState, ResourceState finalState) {
+        VirtualResource& resource = AddResource(name, BarrierResourceType::Buffer);
+        resource.external = buffer;
+        resource.initialState = initialState;
+        resource.finalState = finalState;
+        if (buffer == nullptr) {
+            SetBuildError("导入的缓冲区不能为空");
+        }
+        return RenderGraphResource(m_resourceCount - 1);
+    }
+
+    // 声明通道
+    RenderGraphPassBuilder AddPass(const char* name, RenderGraphExecuteFunc execute) {
+        if (m_passCount == m_passes.size()) {
+            m_passes.emplace_back();
+        }
+        Pass& pass = m_passes[m_passCount];
+        pass.name = name;
+        pass.execute = std::move(execute);
+        pass.accesses.clear();
+        pass.sideEffect = false;
+        pass.culled = false;
+        pass.level = 0;
+        m_compiled = false;
+        return RenderGraphPassBuilder(*this, m_passCount++);
+    }
+
+    // 剔除、分层、分配物理资源并预先计算屏障
+    Result<void> Compile() {
+        RHI_VALIDATE(m_device != nullptr, ErrorCode::InvalidArgument, "渲染图没有设备，无法编译");
+        if (m_buildError.code != ErrorCode::Success) {
+            return Result<void>(m_buildError);
+        }
+        m_stats = RenderGraphStats();
+        m_stats.passCount = m_passCount;
+
+        CullPasses();
+        RHI_RETURN_IF_FAILED(AssignLevels());
+        ComputeLifetimes();
+        RHI_RETURN_IF_FAILED(AssignPhysicalResources());
+        PlanHeaps();
+        RHI_RETURN_IF_FAILED(PlaceResources());
+        RHI_RETURN_IF_FAILED(ComputeBarriers());
+        m_compiled = true;
+        return MakeSuccessResult();
+    }
+
+    // 按层级录制保留的通道（commandBuffer须已Begin）
+    Result<void> Execute(ICommandBuffer* commandBuffer) {
+        RHI_VALIDATE(m_compiled, ErrorCode::InvalidOperation, "Execute之前须先Compile");
+        RHI_VALIDATE(commandBuffer != nullptr, ErrorCode::InvalidArgument, "命令缓冲区不能为空");
+        RenderGraphContext context(*this, commandBuffer);
+        for (const Level& level : m_levels) {
+            if (level.barrierEnd > level.barrierBegin) {
+                RHI_RETURN_IF_FAILED(commandBuffer->ResourceBarrier(
+                    level.barrierEnd - level.barrierBegin, m_barriers.data() + level.barrierBegin));
+            }
+            for (uint32_t i = level.passBegin; i < level.passEnd; ++i) {
+                Pass& pass = m_passes[m_order[i]];
+                if (pass.execute) {
+                    RHI_RETURN_IF_FAILED(pass.execute(context));
+                }
+            }
+        }
+        if (m_finalBarrierBegin < m_barriers.size()) {
+            RHI_RETURN_IF_FAILED(commandBuffer->ResourceBarrier(
+                static_cast<uint32_t>(m_barriers.size() - m_finalBarrierBegin), m_barriers.data() + m_finalBarrierBegin));
+        }
+        return MakeSuccessResult();
+    }
+
+    // 资源对应的后端对象（瞬态资源在Compile之后有效，被剔除的资源返回nullptr）
+    ITexture* GetTexture(RenderGraphResource resource) const {
+        return static_cast<ITexture*>(GetResourceObject(resource, BarrierResourceType::Texture));
+    }
+
+    IBuffer* GetBuffer(RenderGraphResource resource) const {
+        return static_cast<IBuffer*>(GetResourceObject(resource, BarrierResourceType::Buffer));
+    }
+
+    // 瞬态资源在堆布局中的位置（导入资源、被剔除的资源、非Default缓冲区与延迟分配的瞬态附件
+    // 返回heap == kRenderGraphInvalidIndex）
+    RenderGraphPlacement GetPlacement(RenderGraphResource resource) const {
+        RenderGraphPlacement placement = {kRenderGraphInvalidIndex, 0, 0};
+        if (resource.index < m_resourceCount && m_resources[resource.index].physical != kRenderGraphInvalidIndex) {
+            const PhysicalResource& physical = m_physical[m_resources[resource.index].physical];
+            placement.heap = physical.heap;
+            placement.offset = physical.offset;
+            placement.size = physical.size;
+        }
+        return placement;
+    }
+
+    // 堆布局中每个瞬态堆的大小
+    const std::vector<size_t>& GetHeapSizes() const { return m_heapSizes; }
+
+    // 被剔除的通道（Compile之后有效）
+    bool IsPassCulled(uint32_t pass) const { return pass < m_passCount && m_passes[pass].culled; }
+
+    const RenderGraphStats& GetStats() const { return m_stats; }
+
+    // 释放最近一次Compile没有使用的物理资源与被替换的堆（放置资源先于其所在的堆释放）
+    void ReleaseUnusedResources() {
+        m_physical.erase(std::remove_if(m_physical.begin(), m_physical.end(),
+            [](const PhysicalResource& physical) { return !physical.used; }), m_physical.end());
+        m_retiredTextures.clear();
+        m_retiredBuffers.clear();
+        m_retiredHeaps.clear();
+        m_heaps.resize(std::min(m_heaps.size(), m_heapSizes.size()));
+        for (uint32_t i = 0; i < m_resourceCount; ++i) {
+            m_resources[i].physical = kRenderGraphInvalidIndex;
+        }
+        m_compiled = false;
+    }
+
+private:
+    friend class RenderGraphPassBuilder;
+
+    struct VirtualResource {
+        const char* name;
+        BarrierResourceType type;
+        TextureDesc textureDesc;
+        BufferDesc bufferDesc;
+        void* external;                 // 导入资源的后端对象，瞬态资源为nullptr
+        ResourceState initialState;
+        ResourceState finalState;
+        uint32_t firstLevel;            // 保留的通道中第一次/最后一次使用所在的层级
+        uint32_t lastLevel;
+        uint32_t physical;              // 瞬态资源对应的物理资源
+        uint32_t slot;                  // 屏障计算使用的状态槽
+        bool needed;                    // 剔除时：被保留的通道读取
+    };
+
+    struct Access {
+        uint32_t resource;
+        ResourceState state;
+        bool write;
+    };
+
+    struct Pass {
+        const char* name;
+        RenderGraphExecuteFunc execute;
+        std::vector<Access> accesses;
+        bool sideEffect;
+        bool culled;
+        uint32_t level;
+    };
+
+    struct PhysicalResource {
+        BarrierResourceType type;
+        TextureDesc textureDesc;
+        BufferDesc bufferDesc;
+        std::unique_ptr<ITexture> texture;
+        std::unique_ptr<IBuffer> buffer;
+        size_t size;                    // 数据大小（统计用）
+        size_t allocationSize;          // 放置到堆中所需的大小与对齐（Get*AllocationInfo）
+        size_t alignment;
+        bool placed;                    // 放置在瞬态堆中（否则单独分配或延迟分配）
+        bool lazilyAllocated;           // 瞬态附件且设备支持延迟分配的内存
+        bool used;                      // 被最近一次Compile使用
+        bool aliased;                   // 与同一堆中的其他物理资源内存重叠
+        uint32_t firstLevel;
+        uint32_t lastLevel;
+        uint32_t heap;                  // 本次布局的位置
+        size_t offset;
+        IMemory* memory;                // 后端对象实际放置的堆与偏移（与布局不同时重新创建）
+        size_t memoryOffset;
+    };
+
+    struct Level {
+        uint32_t passBegin;             // m_order中的范围
+        uint32_t passEnd;
+        uint32_t barrierBegin;          // m_barriers中的范围
+        uint32_t barrierEnd;
+    };
+
+    // 屏障计算时每个物理资源或导入资源的状态
+    struct StateSlot {
+        void* resource;
+        BarrierResourceType type;
+        ResourceState state;
+        ResourceState levelState;       // 当前层级所需的状态
+        uint32_t levelMark;             // 最近一次被访问的层级 + 1
+        bool levelWrite;
+        bool discard;                   // 当前层级是瞬态资源的第一次使用
+        bool alias;                     // 当前层级是别名物理资源在本帧的第一次使用
+    };
+
+    VirtualResource& AddResource(const char* name, BarrierResourceType type) {
+        if (m_resourceCount == m_resources.size()) {
+            m_resources.emplace_back();
+        }
+        VirtualResource& resource = m_resources[m_resourceCount++];
+        resource.name = name;
+        resource.type = type;
+        resource.external = nullptr;
+        resource.initialState = ResourceState::Undefined;
+        resource.finalState = ResourceState::Undefined;
+        resource.physical = kRenderGraphInvalidIndex;
+        resource.slot = kRenderGraphInvalidIndex;
+        m_compiled = false;
+        return resource;
+    }
+
+    void SetBuildError(const char* message) {
+        if (m_buildError.code == ErrorCode::Success) {
+            m_buildError = ErrorInfo{ErrorCode::InvalidArgument, message};
+        }
+    }
+
+    void AddAccess(uint32_t pass, RenderGraphResource resource, ResourceState state, bool write) {
+        if (!resource.IsValid() || resource.index >= m_resourceCount) {
+            SetBuildError("通道使用了无效的渲染图资源");
+            return;
+        }
+        if (!write && !IsReadOnlyState(state)) {
+            SetBuildError("Read只能使用只读状态");
+            return;
+        }
+        const VirtualResource& virtualResource = m_resources[resource.index];
+        if (virtualResource.type == BarrierResourceType::Texture &&
+            (virtualResource.textureDesc.usage & TextureUsage::Transient) != TextureUsage::None &&
+            state != ResourceState::RenderTarget && state != ResourceState::DepthWrite &&
+            state != ResourceState::DepthRead) {
+            SetBuildError("瞬态附件只能以RenderTarget/DepthWrite/DepthRead状态使用");
+            return;
+        }
+        m_passes[pass].accesses.push_back({resource.index, state, write});
+    }
+
+    void* GetResourceObject(RenderGraphResource resource, BarrierResourceType type) const {
+        if (resource.index >= m_resourceCount || m_resources[resource.index].type != type) {
+            return nullptr;
+        }
+        const VirtualResource& virtualResource = m_resources[resource.index];
+        if (virtualResource.external != nullptr) {
+            return virtualResource.external;
+        }
+        if (virtualResource.physical == kRenderGraphInvalidIndex) {
+            return nullptr;
+        }
+        const PhysicalResource& physical = m_physical[virtualResource.physical];
+        return type == BarrierResourceType::Texture
+            ? static_cast<void*>(physical.texture.get())
+            : static_cast<void*>(physical.buffer.get());
+    }
+
+    // 从后往前：保留有副作用、写入导入资源或写入被需要的资源的通道，并把它读取的资源标记为被需要
+    void CullPasses() {
+        for (uint32_t i = 0; i < m_resourceCount; ++i) {
+            m_resources[i].needed = m_resources[i].external != nullptr;
+        }
+        for (uint32_t i = m_passCount; i-- > 0;) {
+            Pass& pass = m_passes[i];
+            bool keep = pass.sideEffect;
+            for (const Access& access : pass.accesses) {
+                keep = keep || (access.write && m_resources[access.resource].needed);
+            }
+            pass.culled = !keep;
+            if (!keep) {
+                ++m_stats.culledPassCount;
+                continue;
+            }
+            for (const Access& access : pass.accesses) {
+                m_resources[access.resource].needed = true;
+            }
+        }
+    }
+
+    // 两个通道访问同一资源时是否必须分在不同层级
+    static bool Conflicts(const Access& a, const Access& b) {
+        return a.resource == b.resource &&
+            (a.write || b.write || (a.state != b.state && !(IsReadOnlyState(a.state) && IsReadOnlyState(b.state))));
+    }
+
+    Result<void> AssignLevels() {
+        uint32_t levelCount = 0;
+        m_order.clear();
+        for (uint32_t i = 0; i < m_passCount; ++i) {
+            Pass& pass = m_passes[i];
+            if (pass.culled) {
+                continue;
+            }
+            for (size_t a = 0; a < pass.accesses.size(); ++a) {
+                for (size_t b = a + 1; b < pass.accesses.size(); ++b) {
+                    const Access& first = pass.accesses[a];
+                    const Access& second = pass.accesses[b];
+                    RHI_RETURN_IF_FALSE(first.resource != second.resource || first.state == second.state ||
+                        (!first.write && !second.write),
+                        ErrorCode::InvalidArgument,
+                        std::string("通道以冲突的状态访问同一资源: ") + pass.name + " / " + m_resources[first.resource].name);
+                }
+            }
+            pass.level = 0;
+            for (uint32_t earlier : m_order) {
+                const Pass& other = m_passes[earlier];
+                if (other.level + 1 <= pass.level) {
+                    continue;
+                }
+                for (const Access& access : pass.accesses) {
+                    bool conflict = false;
+                    for (const Access& otherAccess : other.accesses) {
+                        conflict = conflict || Conflicts(access, otherAccess);
+                    }
+                    if (conflict) {
+                        pass.level = other.level + 1;
+                        break;
+                    }
+                }
+            }
+            levelCount = std::max(levelCount, pass.level + 1);
+            m_order.push_back(i);
+        }
+        std::stable_sort(m_order.begin(), m_order.end(), [this](uint32_t a, uint32_t b) {
+            return m_passes[a].level < m_passes[b].level;
+        });
+
+        m_levels.assign(levelCount, Level{0, 0, 0, 0});
+        for (uint32_t i = 0; i < m_order.size(); ++i) {
+            Level& level = m_levels[m_passes[m_order[i]].level];
+            if (level.passEnd == 0) {
+                level.passBegin = i;
+            }
+            level.passEnd = i + 1;
+        }
+        m_stats.levelCount = levelCount;
+        return MakeSuccessResult();
+    }
+
+    void ComputeLifetimes() {
+        for (uint32_t i = 0; i < m_resourceCount; ++i) {
+            m_resources[i].firstLevel = kRenderGraphInvalidIndex;
+            m_resources[i].lastLevel = 0;
+        }
+        for (uint32_t index : m_order) {
+            const Pass& pass = m_passes[index];
+            for (const Access& access : pass.accesses) {
+                VirtualResource& resource = m_resources[access.resource];
+                resource.firstLevel = std::min(resource.firstLevel, pass.level);
+                resource.lastLevel = std::max(resource.lastLevel, pass.level);
+            }
+        }
+    }
+
+    static bool SameTextureDesc(const TextureDesc& a, const TextureDesc& b) {
+        return a.type == b.type && a.format == b.format && a.width == b.width && a.height == b.height &&
+            a.depth == b.depth && a.mipLevels == b.mipLevels && a.arraySize == b.arraySize &&
+            a.sampleCount == b.sampleCount && a.usage == b.usage && a.isCubeCompatible == b.isCubeCompatible;
+    }
+
+    static bool SameBufferDesc(const BufferDesc& a, const BufferDesc& b) {
+        return a.type == b.type && a.usage == b.usage && a.memoryType == b.memoryType &&
+            a.size == b.size && a.stride == b.stride && a.allowCPUAccess == b.allowCPUAccess;
+    }
+
+    // 按第一次使用的层级依次为瞬态资源选择物理资源：优先复用描述相同且本帧已空闲的，其次复用缓存中本帧未用的，最后新建
+    Result<void> AssignPhysicalResources() {
+        for (PhysicalResource& physical : m_physical) {
+            physical.used = false;
+        }
+        m_transients.clear();
+        for (uint32_t i = 0; i < m_resourceCount; ++i) {
+            VirtualResource& resource = m_resources[i];
+            resource.physical = kRenderGraphInvalidIndex;
+            if (resource.external == nullptr && resource.firstLevel != kRenderGraphInvalidIndex) {
+                m_transients.push_back(i);
+            }
+        }
+        std::stable_sort(m_transients.begin(), m_transients.end(), [this](uint32_t a, uint32_t b) {
+            return m_resources[a].firstLevel < m_resources[b].firstLevel;
+        });
+
+        bool lazyAttachments = m_device->SupportsLazilyAllocatedMemory();
+        for (uint32_t index : m_transients) {
+            VirtualResource& resource = m_resources[index];
+            bool transientAttachment = resource.type == BarrierResourceType::Texture &&
+                (resource.textureDesc.usage & TextureUsage::Transient) != TextureUsage::None;
+            RHI_RETURN_IF_FALSE(!transientAttachment || resource.firstLevel == resource.lastLevel,
+                ErrorCode::InvalidArgument,
+                std::string("瞬态附件的内容不跨通道保留，只能在一个通道内使用: ") + resource.name);
+            size_t size = resource.type == BarrierResourceType::Texture
+                ? EstimateTextureDataSize(resource.textureDesc)
+                : resource.bufferDesc.size;
+            if (transientAttachment && lazyAttachments) {
+                m_stats.lazilyAllocatedBytes += size;
+            } else {
+                m_stats.dedicatedBytes += size;
+            }
+
+            uint32_t match = kRenderGraphInvalidIndex;
+            for (uint32_t p = 0; p < m_physical.size(); ++p) {
+                PhysicalResource& physical = m_physical[p];
+                bool compatible = physical.type == resource.type &&
+                    (resource.type == BarrierResourceType::Texture
+                        ? SameTextureDesc(physical.textureDesc, resource.textureDesc)
+                        : SameBufferDesc(physical.bufferDesc, resource.bufferDesc));
+                if (compatible && (!physical.used || physical.lastLevel < resource.firstLevel)) {
+                    match = p;
+                    break;
+                }
+            }
+            if (match == kRenderGraphInvalidIndex) {
+                PhysicalResource physical;
+                physical.type = resource.type;
+                physical.textureDesc = resource.textureDesc;
+                physical.bufferDesc = resource.bufferDesc;
+                physical.size = size;
+                physical.allocationSize = 0;
+                physical.alignment = 1;
+                physical.lazilyAllocated = transientAttachment && lazyAttachments;
+                physical.placed = !physical.lazilyAllocated &&
+                    (resource.type == BarrierResourceType::Texture || resource.bufferDesc.memoryType == MemoryType::Default);
+                physical.used = false;
+                physical.aliased = false;
+                physical.firstLevel = 0;
+                physical.lastLevel = 0;
+                physical.heap = kRenderGraphInvalidIndex;
+                physical.offset = 0;
+                physical.memory = nullptr;
+                physical.memoryOffset = 0;
+                // 放置资源在布局之后由PlaceResources创建，这里只查询其大小与对齐
+                if (physical.placed) {
+                    auto info = resource.type == BarrierResourceType::Texture
+                        ? m_device->GetTextureAllocationInfo(resource.textureDesc)
+                        : m_device->GetBufferAllocationInfo(resource.bufferDesc);
+                    RHI_RETURN_IF_FAILED(info);
+                    physical.allocationSize = info.GetValue().size;
+                    physical.alignment = std::max<size_t>(info.GetValue().alignment, 1);
+                } else if (resource.type == BarrierResourceType::Texture) {
+                    auto texture = m_device->CreateTexture(TagResource(resource.textureDesc));
+                    RHI_RETURN_IF_FAILED(texture);
+                    physical.texture.reset(texture.GetValue());
+                    ++m_stats.createdResourceCount;
+                } else {
+                    auto buffer = m_device->CreateBuffer(TagResource(resource.bufferDesc));
+                    RHI_RETURN_IF_FAILED(buffer);
+                    physical.buffer.reset(buffer.GetValue());
+                    ++m_stats.createdResourceCount;
+                }
+                m_physical.push_back(std::move(physical));
+                match = static_cast<uint32_t>(m_physical.size() - 1);
+            }
+
+            PhysicalResource& physical = m_physical[match];
+            if (!physical.used) {
+                physical.used = true;
+                physical.firstLevel = resource.firstLevel;
+                m_stats.physicalBytes += physical.lazilyAllocated ? 0 : physical.size;
+                ++m_stats.physicalResourceCount;
+            }
+            physical.lastLevel = resource.lastLevel;
+            resource.physical = match;
+        }
+        m_stats.transientResourceCount = static_cast<uint32_t>(m_transients.size());
+        return MakeSuccessResult();
+    }
+
+    // 从大到小依次放置物理资源：在每个堆中寻找与生命周期重叠的已放置资源都不相交的最低偏移
+    void PlanHeaps() {
+        m_placementOrder.clear();
+        for (uint32_t p = 0; p < m_physical.size(); ++p) {
+            m_physical[p].heap = kRenderGraphInvalidIndex;
+            m_physical[p].aliased = false;
+            if (m_physical[p].used && m_physical[p].placed) {
+                m_placementOrder.push_back(p);
+            }
+        }
+        std::stable_sort(m_placementOrder.begin(), m_placementOrder.end(), [this](uint32_t a, uint32_t b) {
+            return m_physical[a].allocationSize > m_physical[b].allocationSize;
+        });
+
+        m_heapSizes.clear();
+        for (size_t i = 0; i < m_placementOrder.size(); ++i) {
+            PhysicalResource& physical = m_physical[m_placementOrder[i]];
+            size_t alignment = GetPlacementAlignment(physical);
+            size_t size = (physical.allocationSize + alignment - 1) / alignment * alignment;
+            for (uint32_t heap = 0; heap <= m_heapSizes.size() && physical.heap == kRenderGraphInvalidIndex; ++heap) {
+                if (heap == m_heapSizes.size()) {
+                    m_heapSizes.push_back(0);
+                }
+                size_t offset = FindHeapOffset(heap, size, alignment, physical.firstLevel, physical.lastLevel, i);
+                if (offset + size <= m_desc.maxHeapSize || offset == 0) {
+                    physical.heap = heap;
+                    physical.offset = offset;
+                    m_heapSizes[heap] = std::max(m_heapSizes[heap], offset + size);
+                }
+            }
+        }
+        m_stats.heapCount = static_cast<uint32_t>(m_heapSizes.size());
+        for (size_t size : m_heapSizes) {
+            m_stats.heapBytes += size;
+        }
+
+        // 内存重叠的资源生命周期必然不重叠，它们交替使用同一段内存时需要别名屏障
+        for (size_t i = 0; i < m_placementOrder.size(); ++i) {
+            PhysicalResource& physical = m_physical[m_placementOrder[i]];
+            for (size_t o = i + 1; o < m_placementOrder.size(); ++o) {
+                PhysicalResource& other = m_physical[m_placementOrder[o]];
+                if (other.heap == physical.heap && physical.offset < other.offset + other.allocationSize &&
+                    other.offset < physical.offset + physical.allocationSize) {
+                    physical.aliased = true;
+                    other.aliased = true;
+                }
+            }
+        }
+    }
+
+    // 按布局分配瞬态堆并创建放置资源：已有的堆足够大时保留，放置位置不变的资源不重新创建，
+    // 被替换的堆与资源保留到ReleaseUnusedResources（之前的提交可能仍在使用）
+    Result<void> PlaceResources() {
+        for (uint32_t heap = 0; heap < m_heapSizes.size(); ++heap) {
+            if (heap == m_heaps.size()) {
+                m_heaps.emplace_back();
+            }
+            if (m_heaps[heap] && m_heaps[heap]->GetDesc().size >= m_heapSizes[heap]) {
+                continue;
+            }
+            if (m_heaps[heap]) {
+                m_retiredHeaps.push_back(std::move(m_heaps[heap]));
+            }
+            MemoryDesc memoryDesc;
+            memoryDesc.type = MemoryType::Default;
+            memoryDesc.size = m_heapSizes[heap];
+            memoryDesc.alignment = std::max<size_t>(m_desc.placementAlignment, 1);
+            memoryDesc.tag = MemoryTag("RenderGraph");
+            auto memory = m_device->AllocateMemory(memoryDesc);
+            RHI_RETURN_IF_FAILED(memory);
+            m_heaps[heap].reset(memory.GetValue());
+        }
+
+        for (uint32_t index : m_placementOrder) {
+            PhysicalResource& physical = m_physical[index];
+            IMemory* memory = m_heaps[physical.heap].get();
+            if (physical.memory == memory && physical.memoryOffset == physical.offset) {
+                continue;
+            }
+            if (physical.texture) {
+                m_retiredTextures.push_back(std::move(physical.texture));
+            }
+            if (physical.buffer) {
+                m_retiredBuffers.push_back(std::move(physical.buffer));
+            }
+            physical.memory = nullptr;
+            if (physical.type == BarrierResourceType::Texture) {
+                auto texture = m_device->CreatePlacedTexture(TagResource(physical.textureDesc), memory, physical.offset);
+                RHI_RETURN_IF_FAILED(texture);
+                physical.texture.reset(texture.GetValue());
+            } else {
+                auto buffer = m_device->CreatePlacedBuffer(TagResource(physical.bufferDesc), memory, physical.offset);
+                RHI_RETURN_IF_FAILED(buffer);
+                physical.buffer.reset(buffer.GetValue());
+            }
+            physical.memory = memory;
+            physical.memoryOffset = physical.offset;
+            ++m_stats.createdResourceCount;
+        }
+        return MakeSuccessResult();
+    }
+
+    size_t GetPlacementAlignment(const PhysicalResource& physical) const {
+        return std::max<size_t>(std::max<size_t>(m_desc.placementAlignment, 1), physical.alignment);
+    }
+
+    // 未标记的瞬态资源在内存跟踪中归入"RenderGraph"
+    static TextureDesc TagResource(TextureDesc desc) {
+        desc.tag = desc.tag.name != nullptr ? desc.tag : MemoryTag("RenderGraph");
+        return desc;
+    }
+
+    static BufferDesc TagResource(BufferDesc desc) {
+        desc.tag = desc.tag.name != nullptr ? desc.tag : MemoryTag("RenderGraph");
+        return desc;
+    }
+
+    // 候选偏移为0与每个冲突资源的末尾，取不与任何冲突资源相交的最小者
+    size_t FindHeapOffset(uint32_t heap, size_t size, size_t alignment,
+                          uint32_t firstLevel, uint32_t lastLevel, size_t placedCount) const {
+        size_t best = SIZE_MAX;
+        for (size_t c = 0; c <= placedCount; ++c) {
+            size_t candidate = 0;
+            if (c < placedCount) {
+                const PhysicalResource& other = m_physical[m_placementOrder[c]];
+                if (other.heap != heap || other.lastLevel < firstLevel || lastLevel < other.firstLevel) {
+                    continue;
+                }
+                candidate = (other.offset + other.allocationSize + alignment - 1) / alignment * alignment;
+            }
+            if (candidate >= best) {
+                continue;
+            }
+            bool fits = true;
+            for (size_t o = 0; o < placedCount && fits; ++o) {
+                const PhysicalResource& other = m_physical[m_placementOrder[o]];
+                fits = other.heap != heap || other.lastLevel < firstLevel || lastLevel < other.firstLevel ||
+                    candidate + size <= other.offset || other.offset + other.allocationSize <= candidate;
+            }
+            if (fits) {
+                best = candidate;
+            }
+        }
+        return best;
+    }
+
+    // 逐层级计算状态转换：同一层级对同一资源的只读访问合并，写访问之间插入UAV屏障
+    Result<void> ComputeBarriers() {
+        m_slots.clear();
+        for (uint32_t i = 0; i < m_resourceCount; ++i) {
+            VirtualResource& resource = m_resources[i];
+            resource.slot = kRenderGraphInvalidIndex;
+            if (resource.firstLevel == kRenderGraphInvalidIndex) {
+                continue;
+            }
+            void* object = GetResourceObject(RenderGraphResource(i), resource.type);
+            for (uint32_t s = 0; s < m_slots.size() && resource.slot == kRenderGraphInvalidIndex; ++s) {
+                if (m_slots[s].resource == object) {
+                    resource.slot = s;
+                }
+            }
+            if (resource.slot == kRenderGraphInvalidIndex) {
+                resource.slot = static_cast<uint32_t>(m_slots.size());
+                m_slots.push_back({object, resource.type, resource.initialState,
+                    ResourceState::Undefined, 0, false, false, false});
+            }
+        }
+
+        m_barriers.clear();
+        for (uint32_t l = 0; l < m_levels.size(); ++l) {
+            Level& level = m_levels[l];
+            level.barrierBegin = static_cast<uint32_t>(m_barriers.size());
+            m_touched.clear();
+            for (uint32_t i = level.passBegin; i < level.passEnd; ++i) {
+                for (const Access& access : m_passes[m_order[i]].accesses) {
+                    const VirtualResource& resource = m_resources[access.resource];
+                    StateSlot& slot = m_slots[resource.slot];
+                    if (slot.levelMark != l + 1) {
+                        slot.levelMark = l + 1;
+                        slot.levelState = access.state;
+                        slot.levelWrite = access.write;
+                        slot.discard = resource.external == nullptr && resource.firstLevel == l;
+                        slot.alias = slot.discard && m_physical[resource.physical].aliased &&
+                            m_physical[resource.physical].firstLevel == l;
+                        m_touched.push_back(resource.slot);
+                    } else if (slot.levelState != access.state) {
+                        slot.levelState = slot.levelState | access.state;
+                    }
+                }
+            }
+            for (uint32_t index : m_touched) {
+                StateSlot& slot = m_slots[index];
+                BarrierDesc barrier = {};
+                barrier.type = BarrierType::Transition;
+                barrier.resource = slot.resource;
+                barrier.resourceType = slot.type;
+                barrier.stateAfter = slot.levelState;
+                if (slot.discard) {
+                    barrier.type = slot.alias ? BarrierType::Aliasing : BarrierType::Transition;
+                    barrier.stateBefore = ResourceState::Undefined;
+                    m_stats.aliasingBarrierCount += slot.alias ? 1 : 0;
+                } else if (slot.state == slot.levelState) {
+                    if (slot.levelState != ResourceState::UnorderedAccess) {
+                        continue;
+                    }
+                    barrier.type = BarrierType::UAV;
+                    barrier.stateBefore = ResourceState::UnorderedAccess;
+                } else if (IsReadOnlyState(slot.state) && IsReadOnlyState(slot.levelState)) {
+                    if ((slot.state & slot.levelState) == slot.levelState) {
+                        continue;
+                    }
+                    barrier.stateBefore = slot.state;
+                    barrier.stateAfter = slot.state | slot.levelState;
+                } else {
+                    barrier.stateBefore = slot.state;
+                }
+                slot.state = barrier.stateAfter;
+                m_barriers.push_back(barrier);
+            }
+            level.barrierEnd = static_cast<uint32_t>(m_barriers.size());
+            m_stats.barrierCallCount += level.barrierEnd > level.barrierBegin ? 1 : 0;
+        }
+
+        m_finalBarrierBegin = m_barriers.size();
+        for (uint32_t i = 0; i < m_resourceCount; ++i) {
+            const VirtualResource& resource = m_resources[i];
+            if (resource.external == nullptr || resource.slot == kRenderGraphInvalidIndex) {
+                continue;
+            }
+            StateSlot& slot = m_slots[resource.slot];
+            if (slot.state != resource.finalState && resource.finalState != ResourceState::Undefined) {
+                BarrierDesc barrier = {};
+                barrier.type = BarrierType::Transition;
+                barrier.resource = slot.resource;
+                barrier.resourceType = slot.type;
+                barrier.stateBefore = slot.state;
+                barrier.stateAfter = resource.finalState;
+                slot.state = resource.finalState;
+                m_barriers.push_back(barrier);
+            }
+        }
+        m_stats.barrierCallCount += m_finalBarrierBegin < m_barriers.size() ? 1 : 0;
+        m_stats.barrierCount = static_cast<uint32_t>(m_barriers.size());
+        return MakeSuccessResult();
+    }
+
+    IDevice* m_device;
+    RenderGraphDesc m_desc;
+    std::vector<VirtualResource> m_resources;
+    uint32_t m_resourceCount = 0;
+    std::vector<Pass> m_passes;
+    uint32_t m_passCount = 0;
+    std::vector<std::unique_ptr<IMemory>> m_heaps;         // 瞬态堆（跨帧保留，声明在放置资源之前以便最后析构）
+    std::vector<std::unique_ptr<IMemory>> m_retiredHeaps;
+    std::vector<PhysicalResource> m_physical;      // 物理资源缓存（跨帧保留）
+    std::vector<std::unique_ptr<ITexture>> m_retiredTextures;  // 布局变化时被替换的放置资源
+    std::vector<std::unique_ptr<IBuffer>> m_retiredBuffers;
+    std::vector<uint32_t> m_order;                 // 保留的通道按层级排序
+    std::vector<Level> m_levels;
+    std::vector<uint32_t> m_transients;
+    std::vector<uint32_t> m_placementOrder;
+    std::vector<size_t> m_heapSizes;
+    std::vector<StateSlot> m_slots;
+    std::vector<uint32_t> m_touched;
+    std::vector<BarrierDesc> m_barriers;
+    size_t m_finalBarrierBegin = 0;
+    ErrorInfo m_buildError = ErrorInfo{ErrorCode::Success, ""};
+    RenderGraphStats m_stats;
+    bool m_compiled = false;
+};
+
+inline ITexture* RenderGraphContext::GetTexture(RenderGraphResource resource) const {
+    return m_graph.GetTexture(resource);
+}
+
+inline IBuffer* RenderGraphContext::GetBuffer(RenderGraphResource resource) const {
+    return m_graph.GetBuffer(resource);
+}
+
+inline RenderGraphPassBuilder& RenderGraphPassBuilder::Read(RenderGraphResource resource, ResourceState state) {
+    m_graph.AddAccess(m_pass, resource, state, false);
+    return *this;
+}
+
+inline RenderGraphPassBuilder& RenderGraphPassBuilder::Write(RenderGraphResource resource, ResourceState state) {
+    m_graph.AddAccess(m_pass, resource, state, true);
+    return *this;
+}
+
+inline RenderGraphPassBuilder& RenderGraphPassBuilder::SideEffect() {
+    m_graph.m_passes[m_pass].sideEffect = true;
+    return *this;
+}
+
+} // namespace RHI
@@ -0,0 +1,343 @@
+#pragma once
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "Memory.h"
+#include "Synchronization.h"
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace RHI {
+
+// ResidencyManager最多跟踪的提交队列数
+constexpr uint32_t kResidencyMaxQueues = 8;
+
+// 驻留管理器描述
+struct ResidencyManagerDesc {
+    uint64_t budget;               // 驻留预算（字节），0表示使用IDevice::GetMemoryBudget报告的预算
+    float budgetScale;             // 设备报告的预算乘以此比例，给驱动与其他进程留出余量
+
+    ResidencyManagerDesc() :
+        budget(0),
+        budgetScale(0.9f) {}
+};
+
+// 驻留统计
+struct ResidencyStats {
+    uint64_t budget = 0;                   // 当前预算（已扣除未跟踪的占用）
+    uint64_t residentBytes = 0;            // 驻留的已跟踪内存字节数
+    uint64_t trackedBytes = 0;             // 已跟踪内存的字节数
+    uint32_t residentHeaps = 0;            // 驻留的内存块数
+    uint32_t trackedHeaps = 0;             // 已跟踪的内存块数
+    uint64_t submits = 0;                  // Submit调用次数
+    uint64_t evictions = 0;                // Evict次数
+    uint64_t evictedBytes = 0;             // 累计逐出字节数
+    uint64_t pageIns = 0;                  // 逐出后重新MakeResident的次数
+    uint64_t pagedInBytes = 0;             // 累计重新驻留的字节数
+    uint64_t stalls = 0;                   // 为腾出空间而等待GPU的次数
+    uint64_t oversubscribedSubmits = 0;    // 工作集超出预算、只能超额驻留的提交数
+};
+
+// 一次提交引用的内存块集合
+// 录制命令缓冲区时插入其资源所在的内存块（可以重复），随Submit交给ResidencyManager；Reset后可复用
+class ResidencySet {
+public:
+    void Insert(IMemory* memory) {
+        if (memory != nullptr) {
+            m_heaps.push_back(memory);
+        }
+    }
+
+    void Reset() { m_heaps.clear(); }
+
+    Span<IMemory* const> GetHeaps() const { return Span<IMemory* const>(m_heaps.data(), m_heaps.size()); }
+
+private:
+    std::vector<IMemory*> m_heaps;
+};
+
+// 驻留与内存预算管理器
+// 跟踪一组内存块（通常是MemoryType::Default的IMemory）的大小、驻留状态与最后一次被提交使用的位置，
+// 驻留字节数对照设备预算（IDevice::GetMemoryBudget，扣除未跟踪的占用）。
+// Submit在提交前把各ResidencySet引用的内存块重新MakeResident；空间不足时按最近最少使用的顺序Evict
+// 不属于本次提交的内存块，GPU仍在使用的内存块先等待其完成（计入stalls）。
+// 本次提交的工作集本身超出预算时不会失败：逐出其余全部内存块后超额驻留，计入oversubscribedSubmits。
+// 每个提交队列使用一个内部时间线信号量记录内存块的使用位置，Submit在最后一个SubmitDesc上追加其信号。
+// 线程安全；Submit可能阻塞（等待GPU释放被逐出的内存块）。
+// 内存块须在释放前Untrack；析构前须确认GPU已完成全部提交（内部信号量随之销毁）。
+class ResidencyManager {
+public:
+    ResidencyManager(IDevice* device, const ResidencyManagerDesc& desc = ResidencyManagerDesc())
+        : m_device(device), m_desc(desc) {}
+
+    ResidencyManager(const ResidencyManager&) = delete;
+    ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+    ~ResidencyManager() = default;
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_device != nullptr, ErrorCode::InvalidArgument, "驻留管理器没有设备");
+        RHI_VALIDATE(m_desc.budgetScale > 0.0f && m_desc.budgetScale <= 1.0f,
+            ErrorCode::InvalidArgument,
+            "budgetScale必须在(0, 1]之间");
+        return UpdateBudget();
+    }
+
+    // 重新查询设备预算（预算随系统压力变化，建议每帧调用一次）；预算缩小时立即逐出空闲的内存块
+    Result<void> UpdateBudget() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_desc.budget != 0) {
+            m_budget = m_desc.budget;
+        } else {
+            auto budget = m_device->GetMemoryBudget();
+            RHI_RETURN_IF_FAILED(budget);
+            // 设备占用中不属于已跟踪内存块的部分（其他资源、其他进程）从预算中扣除
+            uint64_t usage = budget.GetValue().usage;
+            uint64_t external = usage > m_residentBytes ? usage - m_residentBytes : 0;
+            uint64_t scaled = static_cast<uint64_t>(static_cast<double>(budget.GetValue().budget) * m_desc.budgetScale);
+            m_budget = scaled > external ? scaled - external : 0;
+        }
+        return MakeRoom(0, 0, false);
+    }
+
+    // 开始跟踪内存块（视为已驻留）；超出预算时逐出空闲的内存块
+    Result<void> Track(IMemory* memory) {
+        RHI_VALIDATE(memory != nullptr, ErrorCode::InvalidArgument, "内存块不能为空");
+        std::lock_guard<std::mutex> lock(m_mutex);
+        RHI_RETURN_IF_FALSE(m_index.find(memory) == m_index.end(),
+            ErrorCode::InvalidOperation,
+            "内存块已被跟踪");
+        Heap heap;
+        heap.memory = memory;
+        heap.size = memory->GetDesc().size;
+        // 新内存块放在最近使用的一端，避免刚分配就被逐出
+        m_index.emplace(memory, m_heaps.insert(m_heaps.end(), heap));
+        m_trackedBytes += heap.size;
+        m_residentBytes += heap.size;
+        ++m_residentHeaps;
+        return MakeRoom(0, 0, false);
+    }
+
+    // 停止跟踪内存块（释放内存块之前调用）；调用方须确认GPU已不再使用它
+    Result<void> Untrack(IMemory* memory) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(memory);
+        RHI_RETURN_IF_FALSE(it != m_index.end(),
+            ErrorCode::InvalidArgument,
+            "内存块未被跟踪");
+        const Heap& heap = *it->second;
+        m_trackedBytes -= heap.size;
+        if (heap.resident) {
+            m_residentBytes -= heap.size;
+            --m_residentHeaps;
+        }
+        m_heaps.erase(it->second);
+        m_index.erase(it);
+        return MakeSuccessResult();
+    }
+
+    // 设置内存块的优先级（转发给IMemory::SetPriority，供操作系统在换页时参考）
+    Result<void> SetPriority(IMemory* memory, uint32_t priority) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        RHI_RETURN_IF_FALSE(m_index.find(memory) != m_index.end(),
+            ErrorCode::InvalidArgument,
+            "内存块未被跟踪");
+        return memory->SetPriority(priority);
+    }
+
+    // 使sets引用的内存块驻留后提交；fence与IQueue::SubmitBatch相同
+    Result<void> Submit(
+        IQueue* queue,
+        Span<const SubmitDesc> submits,
+        Span<const ResidencySet* const> sets,
+        IFence* fence = nullptr) {
+        RHI_VALIDATE(queue != nullptr && !submits.empty(), ErrorCode::InvalidArgument, "队列与提交不能为空");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto slot = GetQueueSlot(queue);
+        RHI_RETURN_IF_FAILED(slot);
+        QueueTimeline& timeline = m_queues[slot.GetValue()];
+        uint64_t value = timeline.submitted + 1;
+        ++m_stamp;
+        ++m_stats.submits;
+
+        // 标记本次提交使用的内存块并移到最近使用的一端，收集需要重新驻留的内存块
+        uint64_t needed = 0;
+        m_used.clear();
+        for (const ResidencySet* set : sets) {
+            for (IMemory* memory : set->GetHeaps()) {
+                auto it = m_index.find(memory);
+                RHI_RETURN_IF_FALSE(it != m_index.end(),
+                    ErrorCode::InvalidArgument,
+                    "ResidencySet引用了未被跟踪的内存块");
+                Heap& heap = *it->second;
+                if (heap.stamp == m_stamp) {
+                    continue;
+                }
+                heap.stamp = m_stamp;
+                m_heaps.splice(m_heaps.end(), m_heaps, it->second);
+                m_used.push_back(&heap);
+                needed += heap.resident ? 0 : heap.size;
+            }
+        }
+
+        RHI_RETURN_IF_FAILED(MakeRoom(needed, m_stamp, true));
+        for (Heap* heap : m_used) {
+            if (heap->resident) {
+                continue;
+            }
+            RHI_RETURN_IF_FAILED(heap->memory->MakeResident());
+            heap->resident = true;
+            m_residentBytes += heap->size;
+            ++m_residentHeaps;
+            ++m_stats.pageIns;
+            m_stats.pagedInBytes += heap->size;
+        }
+
+        // 复制调用方的提交，在最后一个提交上追加本队列时间线的信号
+        m_submits.assign(submits.begin(), submits.end());
+        const SubmitDesc& last = submits[submits.size() - 1];
+        m_signals.assign(last.signalSemaphores.begin(), last.signalSemaphores.end());
+        m_signals.emplace_back(timeline.semaphore.get(), value);
+        m_submits.back().signalSemaphores = Span<const SemaphoreSignalInfo>(m_signals.data(), m_signals.size());
+        RHI_RETURN_IF_FAILED(queue->SubmitBatch(
+            Span<const SubmitDesc>(m_submits.data(), m_submits.size()), fence));
+
+        timeline.submitted = value;
+        for (Heap* heap : m_used) {
+            heap->lastUse[slot.GetValue()] = value;
+        }
+        return MakeSuccessResult();
+    }
+
+    bool IsResident(IMemory* memory) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_index.find(memory);
+        return it != m_index.end() && it->second->resident;
+    }
+
+    ResidencyStats GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ResidencyStats stats = m_stats;
+        stats.budget = m_budget;
+        stats.residentBytes = m_residentBytes;
+        stats.trackedBytes = m_trackedBytes;
+        stats.residentHeaps = m_residentHeaps;
+        stats.trackedHeaps = static_cast<uint32_t>(m_index.size());
+        return stats;
+    }
+
+private:
+    struct Heap {
+        IMemory* memory = nullptr;
+        uint64_t size = 0;
+        uint64_t stamp = 0;                            // 最后一次被Submit引用时的m_stamp
+        uint64_t lastUse[kResidencyMaxQueues] = {};    // 各队列时间线上最后一次使用的值
+        bool resident = true;
+    };
+
+    // 一个提交队列的时间线
+    struct QueueTimeline {
+        IQueue* queue = nullptr;
+        std::unique_ptr<ISemaphore> semaphore;
+        uint64_t submitted = 0;                        // 最后一次提交发出的值
+        uint64_t completed = 0;                        // 最近一次查询到的完成值
+    };
+
+    Result<uint32_t> GetQueueSlot(IQueue* queue) {
+        for (uint32_t i = 0; i < m_queues.size(); ++i) {
+            if (m_queues[i].queue == queue) {
+                return MakeSuccessResult(i);
+            }
+        }
+        RHI_RETURN_IF_FALSE(m_queues.size() < kResidencyMaxQueues,
+            ErrorCode::InvalidOperation,
+            "提交队列过多");
+        SemaphoreDesc semaphoreDesc;
+        semaphoreDesc.binary = false;
+        auto semaphore = m_device->CreateSemaphore(semaphoreDesc);
+        RHI_RETURN_IF_FAILED(semaphore);
+        QueueTimeline timeline;
+        timeline.queue = queue;
+        timeline.semaphore.reset(semaphore.GetValue());
+        m_queues.push_back(std::move(timeline));
+        return MakeSuccessResult(static_cast<uint32_t>(m_queues.size() - 1));
+    }
+
+    // GPU是否已完成对该内存块的全部使用（按需刷新各队列的完成值）
+    Result<bool> IsIdle(const Heap& heap) {
+        for (uint32_t i = 0; i < m_queues.size(); ++i) {
+            if (heap.lastUse[i] > m_queues[i].completed) {
+                auto completed = m_queues[i].semaphore->GetValue();
+                RHI_RETURN_IF_FAILED(completed);
+                m_queues[i].completed = completed.GetValue();
+                if (heap.lastUse[i] > m_queues[i].completed) {
+                    return MakeSuccessResult(false);
+                }
+            }
+        }
+        return MakeSuccessResult(true);
+    }
+
+    Result<void> WaitIdle(const Heap& heap) {
+        for (uint32_t i = 0; i < m_queues.size(); ++i) {
+            if (heap.lastUse[i] > m_queues[i].completed) {
+                RHI_RETURN_IF_FAILED(m_queues[i].semaphore->Wait(heap.lastUse[i], UINT64_MAX));
+                m_queues[i].completed = heap.lastUse[i];
+            }
+        }
+        return MakeSuccessResult();
+    }
+
+    // 从最近最少使用的一端逐出内存块，直到驻留字节数加needed不超过预算
+    // 跳过stamp标记的内存块（本次提交使用）；wait为false时遇到GPU仍在使用的内存块即停止
+    Result<void> MakeRoom(uint64_t needed, uint64_t stamp, bool wait) {
+        for (auto it = m_heaps.begin(); it != m_heaps.end() && m_residentBytes + needed > m_budget; ++it) {
+            Heap& heap = *it;
+            if (!heap.resident || (stamp != 0 && heap.stamp == stamp)) {
+                continue;
+            }
+            auto idle = IsIdle(heap);
+            RHI_RETURN_IF_FAILED(idle);
+            if (!idle.GetValue()) {
+                if (!wait) {
+                    break;
+                }
+                ++m_stats.stalls;
+                RHI_RETURN_IF_FAILED(WaitIdle(heap));
+            }
+            RHI_RETURN_IF_FAILED(heap.memory->Evict());
+            heap.resident = false;
+            m_residentBytes -= heap.size;
+            --m_residentHeaps;
+            ++m_stats.evictions;
+            m_stats.evictedBytes += heap.size;
+        }
+        if (wait && m_residentBytes + needed > m_budget) {
+            ++m_stats.oversubscribedSubmits;
+        }
+        return MakeSuccessResult();
+    }
+
+    IDevice* m_device;
+    ResidencyManagerDesc m_desc;
+    mutable std::mutex m_mutex;
+    std::list<Heap> m_heaps;                                   // 按最近使用排序，队首最久未使用
+    std::unordered_map<IMemory*, std::list<Heap>::iterator> m_index;
+    std::vector<QueueTimeline> m_queues;
+    std::vector<Heap*> m_used;                                 // 本次提交引用的内存块（去重后）
+    std::vector<SubmitDesc> m_submits;
+    std::vector<SemaphoreSignalInfo> m_signals;
+    uint64_t m_budget = 0;
+    uint64_t m_residentBytes = 0;
+    uint64_t m_trackedBytes = 0;
+    uint32_t m_residentHeaps = 0;
+    uint64_t m_stamp = 0;
+    ResidencyStats m_stats;
+};
+
+} // namespace RHI
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+
+namespace RHI {
+
+// 资源状态（可组合的只读状态位，或单个写状态）
+// 各后端把状态映射为自身的访问掩码/图像布局（DirectX12: D3D12_RESOURCE_STATES，Vulkan: VkAccessFlags + VkImageLayout）
+enum class ResourceState : uint32_t {
+    Undefined           = 0,         // 未定义（内容可丢弃，仅作为转换前状态）
+    VertexBuffer        = 1 << 0,    // 顶点缓冲区
+    IndexBuffer         = 1 << 1,    // 索引缓冲区
+    ConstantBuffer      = 1 << 2,    // 常量缓冲区
+    IndirectArgument    = 1 << 3,    // 间接绘制/调度参数
+    ShaderResource      = 1 << 4,    // 着色器只读资源
+    UnorderedAccess     = 1 << 5,    // 着色器读写（UAV）
+    RenderTarget        = 1 << 6,    // 颜色附件
+    DepthWrite          = 1 << 7,    // 深度模板附件（可写）
+    DepthRead           = 1 << 8,    // 深度模板附件（只读）
+    CopySource          = 1 << 9,    // 复制源
+    CopyDest            = 1 << 10,   // 复制目标
+    Present             = 1 << 11,   // 呈现
+    Common              = 1 << 12,   // 通用状态（任意访问，用于跨队列或主机访问）
+};
+
+inline ResourceState operator|(ResourceState a, ResourceState b) {
+    return static_cast<ResourceState>(
+        static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline ResourceState operator&(ResourceState a, ResourceState b) {
+    return static_cast<ResourceState>(
+        static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+inline ResourceState operator~(ResourceState a) {
+    return static_cast<ResourceState>(~static_cast<uint32_t>(a));
+}
+
+// 可以互相组合的只读状态
+constexpr ResourceState kReadOnlyResourceStates = static_cast<ResourceState>(
+    static_cast<uint32_t>(ResourceState::VertexBuffer) |
+    static_cast<uint32_t>(ResourceState::IndexBuffer) |
+    static_cast<uint32_t>(ResourceState::ConstantBuffer) |
+    static_cast<uint32_t>(ResourceState::IndirectArgument) |
+    static_cast<uint32_t>(ResourceState::ShaderResource) |
+    static_cast<uint32_t>(ResourceState::DepthRead) |
+    static_cast<uint32_t>(ResourceState::CopySource) |
+    static_cast<uint32_t>(ResourceState::Present));
+
+inline bool HasAnyState(ResourceState state, ResourceState flags) {
+    return (state & flags) != ResourceState::Undefined;
+}
+
+// 是否只包含只读状态（Undefined不是只读状态）
+inline bool IsReadOnlyState(ResourceState state) {
+    return state != ResourceState::Undefined && (state & ~kReadOnlyResourceStates) == ResourceState::Undefined;
+}
+
+} // namespace RHI
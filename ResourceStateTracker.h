@@ -0,0 +1,672 @@
+#pragma once
+#include "Buffer.h"
+#include "CommandBuffer.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "FrameCommandAllocator.h"
+#include "ResourceState.h"
+#include "Texture.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace RHI {
+
+// 跟踪器生成的屏障（range为子资源范围的副本，转换为BarrierDesc时才取地址）
+struct TrackedBarrier {
+    BarrierDesc desc;
+    TextureSubresourceRange range;
+    bool hasRange;
+};
+
+// 屏障跟踪统计
+struct BarrierTrackerStats {
+    uint64_t stateRequests = 0;      // 子资源状态需求数（含复制/间接命令隐含的需求）
+    uint64_t satisfiedRequests = 0;  // 状态已满足、无需屏障的需求数
+    uint64_t transitions = 0;        // 发出的转换屏障数（合并后）
+    uint64_t uavBarriers = 0;        // 发出的UAV屏障数
+    uint64_t barrierCalls = 0;       // ResourceBarrier调用次数
+};
+
+// 状态表中表示"本命令缓冲区尚未使用该子资源"
+constexpr ResourceState kUnknownResourceState = static_cast<ResourceState>(0xFFFFFFFFu);
+
+// 把逐子资源的from -> to转换合并为最少的屏障（子资源索引为layer * mipLevels + mip）
+// 所有子资源的转换相同时生成一个整资源屏障，否则每个mip级别按连续的数组层合并
+inline void AppendMergedTransitions(void* resource, BarrierResourceType resourceType,
+                                    uint32_t mipLevels, uint32_t layerCount,
+                                    const ResourceState* from, const ResourceState* to,
+                                    std::vector<TrackedBarrier>& out) {
+    TrackedBarrier barrier = {};
+    barrier.desc.type = BarrierType::Transition;
+    barrier.desc.resource = resource;
+    barrier.desc.resourceType = resourceType;
+
+    uint32_t count = mipLevels * layerCount;
+    bool uniform = true;
+    for (uint32_t i = 0; i < count && uniform; ++i) {
+        uniform = from[i] != to[i] && from[i] == from[0] && to[i] == to[0];
+    }
+    if (uniform) {
+        barrier.desc.stateBefore = from[0];
+        barrier.desc.stateAfter = to[0];
+        barrier.hasRange = false;
+        out.push_back(barrier);
+        return;
+    }
+
+    barrier.hasRange = true;
+    for (uint32_t mip = 0; mip < mipLevels; ++mip) {
+        uint32_t layer = 0;
+        while (layer < layerCount) {
+            uint32_t index = layer * mipLevels + mip;
+            if (from[index] == to[index]) {
+                ++layer;
+                continue;
+            }
+            uint32_t first = layer++;
+            while (layer < layerCount &&
+                   from[layer * mipLevels + mip] == from[index] &&
+                   to[layer * mipLevels + mip] == to[index]) {
+                ++layer;
+            }
+            barrier.desc.stateBefore = from[index];
+            barrier.desc.stateAfter = to[index];
+            barrier.range.baseMipLevel = mip;
+            barrier.range.mipLevelCount = 1;
+            barrier.range.baseArrayLayer = first;
+            barrier.range.arrayLayerCount = layer - first;
+            out.push_back(barrier);
+        }
+    }
+}
+
+// 转换为BarrierDesc数组（range指向tracked中的副本，tracked须在使用期间保持不变）
+inline void BuildBarrierDescs(const std::vector<TrackedBarrier>& tracked, std::vector<BarrierDesc>& out) {
+    out.clear();
+    for (const TrackedBarrier& barrier : tracked) {
+        out.push_back(barrier.desc);
+        out.back().range = barrier.hasRange ? &barrier.range : nullptr;
+    }
+}
+
+// 自动屏障跟踪命令缓冲区
+// 包装一个命令缓冲区，记录本命令缓冲区内每个资源每个子资源的状态。
+// RequireState声明下一次绘制/调度/复制对资源的使用，跟踪器计算最少的转换：
+// - 已处于所需状态，或已处于覆盖所需只读状态的组合只读状态时不产生屏障
+// - 两个只读状态合并为组合只读状态，而不是来回转换
+// - 连续的UnorderedAccess使用之间插入UAV屏障
+// 待定的转换在下一次绘制、调度、复制、BeginRenderPass、ExecuteBundle或End之前合并为一次ResourceBarrier调用；
+// 同一子资源在两次刷新之间的多次转换折叠为一次。CopyBuffer/CopyTexture与间接命令自动声明其隐含的状态。
+// 每个子资源在本命令缓冲区中的第一次需求记录为初始状态，由ResourceStateRegistry在提交时与队列上的已知状态对齐。
+// 包装器不拥有被包装的命令缓冲区；提交须使用GetCommandBuffer()返回的后端对象（或SubmitTracked）。
+class TrackedCommandBuffer : public ICommandBuffer {
+public:
+    explicit TrackedCommandBuffer(ICommandBuffer* commandBuffer)
+        : m_commandBuffer(commandBuffer) {
+        m_desc = commandBuffer->GetDesc();
+    }
+
+    ICommandBuffer* GetCommandBuffer() const { return m_commandBuffer; }
+
+    const BarrierTrackerStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = BarrierTrackerStats(); }
+
+    // 声明缓冲区的下一次使用
+    Result<void> RequireState(IBuffer* buffer, ResourceState state) {
+        RHI_VALIDATE(buffer != nullptr, ErrorCode::InvalidArgument, "缓冲区不能为空");
+        TrackedResource& resource = GetResource(buffer, BarrierResourceType::Buffer, 1, 1);
+        Require(resource, state, 0, 1, 0, 1);
+        return MakeSuccessResult();
+    }
+
+    // 声明纹理子资源范围的下一次使用
+    Result<void> RequireState(ITexture* texture, ResourceState state, const TextureSubresourceRange& range) {
+        RHI_VALIDATE(texture != nullptr, ErrorCode::InvalidArgument, "纹理不能为空");
+        const TextureDesc& desc = texture->GetDesc();
+        uint32_t layerCount = GetTextureLayerCount(desc);
+        // 范围直接用于索引跟踪表，发布版同样检查
+        RHI_RETURN_IF_FALSE(range.mipLevelCount > 0 && range.arrayLayerCount > 0 &&
+                            IsRangeInside(range, desc.mipLevels, layerCount),
+            ErrorCode::InvalidArgument, "子资源范围越界");
+        TrackedResource& resource = GetResource(texture, BarrierResourceType::Texture, desc.mipLevels, layerCount);
+        Require(resource, state, range.baseMipLevel, range.mipLevelCount, range.baseArrayLayer, range.arrayLayerCount);
+        return MakeSuccessResult();
+    }
+
+    // 声明整个纹理的下一次使用
+    Result<void> RequireState(ITexture* texture, ResourceState state) {
+        RHI_VALIDATE(texture != nullptr, ErrorCode::InvalidArgument, "纹理不能为空");
+        TextureSubresourceRange range;
+        range.mipLevelCount = texture->GetDesc().mipLevels;
+        range.arrayLayerCount = GetTextureLayerCount(texture->GetDesc());
+        return RequireState(texture, state, range);
+    }
+
+    // 立即发出所有待定的屏障
+    Result<void> FlushBarriers() {
+        if (m_dirty.empty()) {
+            return MakeSuccessResult();
+        }
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "资源状态须在渲染通道开始之前声明");
+
+        m_pending.clear();
+        for (uint32_t index : m_dirty) {
+            TrackedResource& resource = m_resources[index];
+            size_t before = m_pending.size();
+            if (resource.flushed != resource.current) {
+                AppendMergedTransitions(resource.resource, resource.type, resource.mipLevels, resource.layerCount,
+                    resource.flushed.data(), resource.current.data(), m_pending);
+                resource.flushed = resource.current;
+            }
+            m_stats.transitions += m_pending.size() - before;
+            if (resource.uavPending) {
+                TrackedBarrier barrier = {};
+                barrier.desc.type = BarrierType::UAV;
+                barrier.desc.resource = resource.resource;
+                barrier.desc.resourceType = resource.type;
+                barrier.desc.stateBefore = ResourceState::UnorderedAccess;
+                barrier.desc.stateAfter = ResourceState::UnorderedAccess;
+                m_pending.push_back(barrier);
+                ++m_stats.uavBarriers;
+                resource.uavPending = false;
+            }
+            resource.dirty = false;
+        }
+        m_dirty.clear();
+        if (m_pending.empty()) {
+            return MakeSuccessResult();
+        }
+        BuildBarrierDescs(m_pending, m_barriers);
+        ++m_stats.barrierCalls;
+        return m_commandBuffer->ResourceBarrier(static_cast<uint32_t>(m_barriers.size()), m_barriers.data());
+    }
+
+    const CommandBufferDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override { return m_commandBuffer->GetNativeHandle(); }
+
+    Result<void> Begin() override {
+        ClearTracking();
+        return m_commandBuffer->Begin();
+    }
+
+    Result<void> End() override {
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->End();
+    }
+
+    Result<void> Reset() override {
+        ClearTracking();
+        return m_commandBuffer->Reset();
+    }
+
+    Result<void> BeginRenderPass(const RenderPassDesc& desc) override {
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        m_insideRenderPass = true;
+        return m_commandBuffer->BeginRenderPass(desc);
+    }
+
+    Result<void> EndRenderPass() override {
+        m_insideRenderPass = false;
+        return m_commandBuffer->EndRenderPass();
+    }
+
+    Result<void> SetViewport(const Viewport& viewport) override {
+        return m_commandBuffer->SetViewport(viewport);
+    }
+
+    Result<void> SetScissor(const Scissor& scissor) override {
+        return m_commandBuffer->SetScissor(scissor);
+    }
+
+    Result<void> SetPipelineState(void* pipelineState) override {
+        return m_commandBuffer->SetPipelineState(pipelineState);
+    }
+
+    Result<void> SetDescriptorSet(uint32_t set, void* descriptorSet) override {
+        return m_commandBuffer->SetDescriptorSet(set, descriptorSet);
+    }
+
+    Result<void> SetDescriptorSet(uint32_t set, void* descriptorSet, Span<const uint32_t> dynamicOffsets) override {
+        return m_commandBuffer->SetDescriptorSet(set, descriptorSet, dynamicOffsets);
+    }
+
+    Result<void> SetVertexBuffer(uint32_t slot, void* vertexBufferView) override {
+        return m_commandBuffer->SetVertexBuffer(slot, vertexBufferView);
+    }
+
+    Result<void> SetIndexBuffer(void* indexBufferView) override {
+        return m_commandBuffer->SetIndexBuffer(indexBufferView);
+    }
+
+    Result<void> PushConstants(void* layout, uint32_t offset, uint32_t size, const void* data) override {
+        return m_commandBuffer->PushConstants(layout, offset, size, data);
+    }
+
+    Result<void> Draw(uint32_t vertexCount, uint32_t instanceCount,
+                      uint32_t firstVertex, uint32_t firstInstance) override {
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->Draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+
+    Result<void> DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+                             int32_t vertexOffset, uint32_t firstInstance) override {
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->DrawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+
+    Result<void> DrawIndirect(void* argumentBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override {
+        if (argumentBuffer != nullptr) {
+            RHI_RETURN_IF_FAILED(RequireState(static_cast<IBuffer*>(argumentBuffer), ResourceState::IndirectArgument));
+        }
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->DrawIndirect(argumentBuffer, offset, drawCount, stride);
+    }
+
+    Result<void> Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override {
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->Dispatch(groupCountX, groupCountY, groupCountZ);
+    }
+
+    Result<void> DispatchIndirect(void* argumentBuffer, uint32_t offset) override {
+        if (argumentBuffer != nullptr) {
+            RHI_RETURN_IF_FAILED(RequireState(static_cast<IBuffer*>(argumentBuffer), ResourceState::IndirectArgument));
+        }
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->DispatchIndirect(argumentBuffer, offset);
+    }
+
+    Result<void> CopyBuffer(void* srcBuffer, void* dstBuffer, uint32_t regionCount, void* regions) override {
+        if (srcBuffer != nullptr && dstBuffer != nullptr) {
+            RHI_RETURN_IF_FAILED(RequireState(static_cast<IBuffer*>(srcBuffer), ResourceState::CopySource));
+            RHI_RETURN_IF_FAILED(RequireState(static_cast<IBuffer*>(dstBuffer), ResourceState::CopyDest));
+        }
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->CopyBuffer(srcBuffer, dstBuffer, regionCount, regions);
+    }
+
+    // 只转换复制区域涉及的子资源
+    Result<void> CopyTexture(void* srcTexture, void* dstTexture, uint32_t regionCount, void* regions) override {
+        if (srcTexture != nullptr && dstTexture != nullptr && regions != nullptr) {
+            const TextureCopyRegion* copyRegions = static_cast<const TextureCopyRegion*>(regions);
+            for (uint32_t i = 0; i < regionCount; ++i) {
+                TextureSubresourceRange srcRange;
+                srcRange.baseMipLevel = copyRegions[i].srcMipLevel;
+                srcRange.baseArrayLayer = copyRegions[i].srcArrayLayer;
+                TextureSubresourceRange dstRange;
+                dstRange.baseMipLevel = copyRegions[i].dstMipLevel;
+                dstRange.baseArrayLayer = copyRegions[i].dstArrayLayer;
+                RHI_RETURN_IF_FAILED(RequireState(static_cast<ITexture*>(srcTexture), ResourceState::CopySource, srcRange));
+                RHI_RETURN_IF_FAILED(RequireState(static_cast<ITexture*>(dstTexture), ResourceState::CopyDest, dstRange));
+            }
+        }
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->CopyTexture(srcTexture, dstTexture, regionCount, regions);
+    }
+
+    Result<void> CopyBufferToTexture(void* srcBuffer, void* dstTexture, uint32_t regionCount, void* regions) override {
+        if (srcBuffer != nullptr && dstTexture != nullptr && regions != nullptr) {
+            RHI_RETURN_IF_FAILED(RequireState(static_cast<IBuffer*>(srcBuffer), ResourceState::CopySource));
+            const BufferTextureCopyRegion* copyRegions = static_cast<const BufferTextureCopyRegion*>(regions);
+            for (uint32_t i = 0; i < regionCount; ++i) {
+                TextureSubresourceRange range;
+                range.baseMipLevel = copyRegions[i].mipLevel;
+                range.baseArrayLayer = copyRegions[i].arrayLayer;
+                RHI_RETURN_IF_FAILED(RequireState(static_cast<ITexture*>(dstTexture), ResourceState::CopyDest, range));
+            }
+        }
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->CopyBufferToTexture(srcBuffer, dstTexture, regionCount, regions);
+    }
+
+    // 显式屏障原样转发（先发出待定的屏障），并把转换后的状态记入跟踪表
+    Result<void> ResourceBarrier(uint32_t barrierCount, const BarrierDesc* barriers) override {
+        // 越界的范围在转发之前拒绝，不记录任何屏障
+        RHI_RETURN_IF_FALSE(barriers != nullptr || barrierCount == 0, ErrorCode::InvalidArgument, "屏障数组不能为空");
+        for (uint32_t i = 0; i < barrierCount; ++i) {
+            const BarrierDesc& barrier = barriers[i];
+            if (barrier.resource == nullptr || barrier.resourceType == BarrierResourceType::Buffer ||
+                barrier.range == nullptr) {
+                continue;
+            }
+            const TextureDesc& desc = static_cast<ITexture*>(barrier.resource)->GetDesc();
+            RHI_RETURN_IF_FALSE(IsRangeInside(*barrier.range, desc.mipLevels, GetTextureLayerCount(desc)),
+                ErrorCode::InvalidArgument,
+                "屏障的子资源范围越界");
+        }
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        RHI_RETURN_IF_FAILED(m_commandBuffer->ResourceBarrier(barrierCount, barriers));
+        for (uint32_t i = 0; i < barrierCount; ++i) {
+            const BarrierDesc& barrier = barriers[i];
+            // 别名屏障让resource从未定义的内容开始，按从Undefined到stateAfter的转换跟踪
+            bool aliasing = barrier.type == BarrierType::Aliasing;
+            if ((barrier.type != BarrierType::Transition && !aliasing) || barrier.resource == nullptr) {
+                continue;
+            }
+            TrackedResource* resource = nullptr;
+            uint32_t baseMip = 0, mipCount = 1, baseLayer = 0, layerCount = 1;
+            if (barrier.resourceType == BarrierResourceType::Buffer) {
+                resource = &GetResource(barrier.resource, BarrierResourceType::Buffer, 1, 1);
+            } else {
+                const TextureDesc& desc = static_cast<ITexture*>(barrier.resource)->GetDesc();
+                resource = &GetResource(barrier.resource, BarrierResourceType::Texture,
+                    desc.mipLevels, GetTextureLayerCount(desc));
+                mipCount = resource->mipLevels;
+                layerCount = resource->layerCount;
+                if (barrier.range != nullptr) {
+                    baseMip = barrier.range->baseMipLevel;
+                    mipCount = barrier.range->mipLevelCount;
+                    baseLayer = barrier.range->baseArrayLayer;
+                    layerCount = barrier.range->arrayLayerCount;
+                }
+            }
+            for (uint32_t layer = baseLayer; layer < baseLayer + layerCount; ++layer) {
+                for (uint32_t mip = baseMip; mip < baseMip + mipCount; ++mip) {
+                    uint32_t index = layer * resource->mipLevels + mip;
+                    if (resource->current[index] == kUnknownResourceState) {
+                        resource->initial[index] = aliasing ? ResourceState::Undefined : barrier.stateBefore;
+                    }
+                    resource->current[index] = barrier.stateAfter;
+                    resource->flushed[index] = barrier.stateAfter;
+                }
+            }
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> ExecuteBundle(ICommandBuffer* bundle) override {
+        RHI_RETURN_IF_FAILED(FlushBarriers());
+        return m_commandBuffer->ExecuteBundle(bundle);
+    }
+
+private:
+    friend class ResourceStateRegistry;
+
+    struct TrackedResource {
+        void* resource;
+        BarrierResourceType type;
+        uint32_t mipLevels;
+        uint32_t layerCount;
+        std::vector<ResourceState> initial;   // 本命令缓冲区对每个子资源的第一次需求
+        std::vector<ResourceState> flushed;   // 已发出的屏障之后的状态
+        std::vector<ResourceState> current;   // 包含待定转换的状态
+        bool dirty;
+        bool uavPending;
+    };
+
+    // 范围是否落在mipLevels×layerCount个子资源之内（按减法比较，基数与数量相加不会溢出）
+    static bool IsRangeInside(const TextureSubresourceRange& range, uint32_t mipLevels, uint32_t layerCount) {
+        return range.baseMipLevel <= mipLevels && range.mipLevelCount <= mipLevels - range.baseMipLevel &&
+            range.baseArrayLayer <= layerCount && range.arrayLayerCount <= layerCount - range.baseArrayLayer;
+    }
+
+    // 条目在Begin/Reset后保留（连同其状态数组的容量）供下一次录制复用
+    TrackedResource& GetResource(void* handle, BarrierResourceType type, uint32_t mipLevels, uint32_t layerCount) {
+        auto it = m_lookup.find(handle);
+        if (it != m_lookup.end()) {
+            return m_resources[it->second];
+        }
+        if (m_resourceCount == m_resources.size()) {
+            m_resources.emplace_back();
+        }
+        uint32_t index = m_resourceCount++;
+        TrackedResource& resource = m_resources[index];
+        resource.resource = handle;
+        resource.type = type;
+        resource.mipLevels = mipLevels;
+        resource.layerCount = layerCount;
+        resource.initial.assign(mipLevels * layerCount, kUnknownResourceState);
+        resource.flushed.assign(mipLevels * layerCount, kUnknownResourceState);
+        resource.current.assign(mipLevels * layerCount, kUnknownResourceState);
+        resource.dirty = false;
+        resource.uavPending = false;
+        m_lookup.emplace(handle, index);
+        return resource;
+    }
+
+    void Require(TrackedResource& resource, ResourceState state,
+                 uint32_t baseMip, uint32_t mipCount, uint32_t baseLayer, uint32_t layerCount) {
+        bool changed = false;
+        for (uint32_t layer = baseLayer; layer < baseLayer + layerCount; ++layer) {
+            for (uint32_t mip = baseMip; mip < baseMip + mipCount; ++mip) {
+                uint32_t index = layer * resource.mipLevels + mip;
+                ResourceState current = resource.current[index];
+                ++m_stats.stateRequests;
+                if (current == kUnknownResourceState) {
+                    // 第一次使用：不产生屏障，提交时与队列上的已知状态对齐
+                    resource.initial[index] = state;
+                    resource.flushed[index] = state;
+                    resource.current[index] = state;
+                    ++m_stats.satisfiedRequests;
+                } else if (current == state) {
+                    if (state == ResourceState::UnorderedAccess && resource.flushed[index] == state) {
+                        resource.uavPending = true;
+                        changed = true;
+                    }
+                    ++m_stats.satisfiedRequests;
+                } else if (IsReadOnlyState(current) && IsReadOnlyState(state)) {
+                    if ((current & state) == state) {
+                        ++m_stats.satisfiedRequests;
+                    } else {
+                        resource.current[index] = current | state;
+                        changed = true;
+                    }
+                } else {
+                    resource.current[index] = state;
+                    changed = true;
+                }
+            }
+        }
+        if (changed && !resource.dirty) {
+            resource.dirty = true;
+            m_dirty.push_back(static_cast<uint32_t>(&resource - m_resources.data()));
+        }
+    }
+
+    void ClearTracking() {
+        m_lookup.clear();
+        m_resourceCount = 0;
+        m_dirty.clear();
+        m_insideRenderPass = false;
+    }
+
+    ICommandBuffer* m_commandBuffer;
+    BarrierTrackerStats m_stats;
+    std::unordered_map<void*, uint32_t> m_lookup;
+    std::vector<TrackedResource> m_resources;
+    uint32_t m_resourceCount = 0;
+    std::vector<uint32_t> m_dirty;                 // 有待定转换的资源索引
+    std::vector<TrackedBarrier> m_pending;
+    std::vector<BarrierDesc> m_barriers;
+    bool m_insideRenderPass = false;
+};
+
+// 队列上资源状态的登记表（设备级，线程安全）
+// 记录每个资源每个子资源在已提交的命令缓冲区执行完毕后的状态；未登记的资源视为Undefined。
+// SubmitTracked按提交顺序处理命令缓冲区：生成把已知状态对齐到其初始需求的修正屏障并提交，
+// 提交成功后才登记其最终状态；提交失败时登记表保持不变。
+class ResourceStateRegistry {
+public:
+    // 登记资源的当前状态（例如由TransitionLayout/UpdateData改变了状态，或资源来自外部）
+    void SetState(IBuffer* buffer, ResourceState state) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_states[buffer].assign(1, state);
+    }
+
+    void SetState(ITexture* texture, ResourceState state) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const TextureDesc& desc = texture->GetDesc();
+        m_states[texture].assign(desc.mipLevels * GetTextureLayerCount(desc), state);
+    }
+
+    // 查询子资源的已知状态（子资源索引为layer * mipLevels + mip）
+    ResourceState GetState(void* resource, uint32_t subresource = 0) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_states.find(resource);
+        return it != m_states.end() && subresource < it->second.size()
+            ? it->second[subresource]
+            : ResourceState::Undefined;
+    }
+
+    // 累计生成的修正屏障数（只计入提交成功的修正）
+    uint64_t GetFixupBarrierCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_fixupBarriers;
+    }
+
+    // 资源销毁时移除其记录
+    void Forget(void* resource) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_states.erase(resource);
+    }
+
+    // 解析commandBuffers（须已End，按提交顺序排列）的资源状态后通过allocator一次提交
+    // 需要修正状态的命令缓冲区之前插入一个从allocator取得的修正命令缓冲区（只包含一次ResourceBarrier调用）；
+    // 不需要修正时不分配任何命令缓冲区。解析与提交都在登记表的锁内进行，多个线程的提交顺序与解析顺序一致。
+    Result<void> SubmitTracked(
+        FrameCommandAllocator& allocator,
+        QueueType type,
+        IQueue* queue,
+        const std::vector<TrackedCommandBuffer*>& commandBuffers,
+        const std::vector<ISemaphore*>& waitSemaphores,
+        const std::vector<ISemaphore*>& signalSemaphores,
+        IFence* fence) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_undoCount = 0;
+        uint64_t fixupBarriers = 0;
+        Result<void> result = ResolveAndSubmit(allocator, type, queue, commandBuffers,
+            waitSemaphores, signalSemaphores, fence, fixupBarriers);
+        if (!result.IsSuccess()) {
+            Rollback();
+            return result;
+        }
+        m_fixupBarriers += fixupBarriers;
+        return MakeSuccessResult();
+    }
+
+private:
+    // 提交失败时恢复的资源状态（按修改顺序记录，逆序恢复）
+    struct UndoEntry {
+        void* resource = nullptr;
+        bool existed = false;
+        std::vector<ResourceState> states;
+    };
+
+    Result<void> ResolveAndSubmit(
+        FrameCommandAllocator& allocator,
+        QueueType type,
+        IQueue* queue,
+        const std::vector<TrackedCommandBuffer*>& commandBuffers,
+        const std::vector<ISemaphore*>& waitSemaphores,
+        const std::vector<ISemaphore*>& signalSemaphores,
+        IFence* fence,
+        uint64_t& fixupBarriers) {
+        m_submitList.clear();
+        for (TrackedCommandBuffer* commandBuffer : commandBuffers) {
+            RHI_VALIDATE(commandBuffer != nullptr, ErrorCode::InvalidArgument, "命令缓冲区不能为空");
+            m_fixups.clear();
+            Resolve(*commandBuffer, m_fixups);
+            if (!m_fixups.empty()) {
+                fixupBarriers += m_fixups.size();
+                auto fixup = allocator.Allocate(type);
+                RHI_RETURN_IF_FAILED(fixup);
+                BuildBarrierDescs(m_fixups, m_barriers);
+                RHI_RETURN_IF_FAILED(fixup.GetValue()->Begin());
+                RHI_RETURN_IF_FAILED(fixup.GetValue()->ResourceBarrier(
+                    static_cast<uint32_t>(m_barriers.size()), m_barriers.data()));
+                RHI_RETURN_IF_FAILED(fixup.GetValue()->End());
+                m_submitList.push_back(fixup.GetValue());
+            }
+            m_submitList.push_back(commandBuffer->GetCommandBuffer());
+        }
+        return allocator.Submit(type, queue, m_submitList, waitSemaphores, signalSemaphores, fence);
+    }
+
+    // 把commandBuffer的初始需求与已知状态之间的修正屏障追加到out，并暂时写入其最终状态（调用者持有锁）
+    // 缓冲区从Undefined开始的转换没有意义，不生成屏障；初始需求为Undefined（丢弃内容）时也不需要修正
+    void Resolve(const TrackedCommandBuffer& commandBuffer, std::vector<TrackedBarrier>& out) {
+        for (uint32_t i = 0; i < commandBuffer.m_resourceCount; ++i) {
+            const TrackedCommandBuffer::TrackedResource& resource = commandBuffer.m_resources[i];
+            uint32_t count = resource.mipLevels * resource.layerCount;
+            auto found = m_states.find(resource.resource);
+            SaveUndo(resource.resource, found != m_states.end() ? &found->second : nullptr);
+            std::vector<ResourceState>& known = found != m_states.end() ? found->second : m_states[resource.resource];
+            if (known.size() != count) {
+                known.assign(count, ResourceState::Undefined);
+            }
+
+            m_from.assign(count, ResourceState::Undefined);
+            m_to.assign(count, ResourceState::Undefined);
+            bool needed = false;
+            for (uint32_t index = 0; index < count; ++index) {
+                ResourceState initial = resource.initial[index];
+                if (initial == kUnknownResourceState) {
+                    continue;
+                }
+                bool skip = known[index] == initial || initial == ResourceState::Undefined ||
+                    (resource.type == BarrierResourceType::Buffer && known[index] == ResourceState::Undefined);
+                if (!skip) {
+                    m_from[index] = known[index];
+                    m_to[index] = initial;
+                    needed = true;
+                }
+                known[index] = resource.current[index];
+            }
+            if (needed) {
+                AppendMergedTransitions(resource.resource, resource.type, resource.mipLevels, resource.layerCount,
+                    m_from.data(), m_to.data(), out);
+            }
+        }
+    }
+
+    void SaveUndo(void* resource, const std::vector<ResourceState>* states) {
+        if (m_undoCount == m_undo.size()) {
+            m_undo.emplace_back();
+        }
+        UndoEntry& entry = m_undo[m_undoCount++];
+        entry.resource = resource;
+        entry.existed = states != nullptr;
+        if (states != nullptr) {
+            entry.states.assign(states->begin(), states->end());
+        }
+    }
+
+    void Rollback() {
+        while (m_undoCount > 0) {
+            UndoEntry& entry = m_undo[--m_undoCount];
+            if (entry.existed) {
+                m_states[entry.resource].assign(entry.states.begin(), entry.states.end());
+            } else {
+                m_states.erase(entry.resource);
+            }
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<void*, std::vector<ResourceState>> m_states;
+    uint64_t m_fixupBarriers = 0;
+    // 提交期间复用的暂存空间（在锁内使用）
+    std::vector<ResourceState> m_from;
+    std::vector<ResourceState> m_to;
+    std::vector<ICommandBuffer*> m_submitList;
+    std::vector<TrackedBarrier> m_fixups;
+    std::vector<BarrierDesc> m_barriers;
+    std::vector<UndoEntry> m_undo;
+    size_t m_undoCount = 0;
+};
+
+// 解析跨命令缓冲区的资源状态后一次性提交（见ResourceStateRegistry::SubmitTracked）
+inline Result<void> SubmitTracked(
+    ResourceStateRegistry& registry,
+    FrameCommandAllocator& allocator,
+    QueueType type,
+    IQueue* queue,
+    const std::vector<TrackedCommandBuffer*>& commandBuffers,
+    const std::vector<ISemaphore*>& waitSemaphores,
+    const std::vector<ISemaphore*>& signalSemaphores,
+    IFence* fence) {
+    return registry.SubmitTracked(allocator, type, queue, commandBuffers, waitSemaphores, signalSemaphores, fence);
+}
+
+} // namespace RHI
@@ -1,6 +1,13 @@
 
 #pragma once
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <mutex>
 #include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
 
 namespace RHI {
 
@@ -44,84 +51,245 @@ enum class ErrorCode {
     MetalError = 30000             // Metal特定错误
 };
 
+// 错误消息驻留
+// 动态拼接的错误消息只在失败路径上驻留一次，之后Result只保存指向驻留字符串的指针，
+// 驻留字符串在进程生命周期内有效，因此Result无需持有std::string。
+// 驻留表只保存有限数量的不同消息：消息中拼接了句柄、索引等取值时不同消息的数量没有上限，
+// 超过kMaxInternedErrorMessages后新消息不再驻留，返回固定的占位消息（错误码仍然准确）。
+constexpr size_t kMaxInternedErrorMessages = 4096;
+
+inline const char* InternErrorMessage(const std::string& message) {
+    static std::mutex s_mutex;
+    static std::unordered_set<std::string> s_messages;
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_messages.find(message);
+    if (it != s_messages.end()) {
+        return it->c_str();
+    }
+    if (s_messages.size() >= kMaxInternedErrorMessages) {
+        return "错误消息驻留表已满，消息已省略";
+    }
+    return s_messages.insert(message).first->c_str();
+}
+
+// 错误信息（错误码 + 静态或驻留的消息指针），可平凡复制
+struct ErrorInfo {
+    ErrorCode code;
+    const char* message;
+};
+
+namespace Detail {
+
+// Result的值存储：只在成功时构造值，值类型无需可默认构造
+// 值可平凡复制时使用平凡的联合体存储，保持整个Result可平凡复制
+template<typename T, bool = std::is_trivially_copyable<T>::value>
+struct ResultStorage {
+    explicit ResultStorage(const ErrorInfo& error)
+        : m_errorCode(error.code)
+        , m_errorMessage(error.message)
+        , m_empty() {}
+
+    template<typename... Args>
+    explicit ResultStorage(std::in_place_t, Args&&... args)
+        : m_errorCode(ErrorCode::Success)
+        , m_value(std::forward<Args>(args)...) {}
+
+    ErrorCode m_errorCode = ErrorCode::Success;
+    const char* m_errorMessage = "";
+    union {
+        char m_empty;
+        T m_value;
+    };
+};
+
+// 不可平凡复制的值：按错误码判断值是否已构造，手动复制、移动和析构
+template<typename T>
+struct ResultStorage<T, false> {
+    explicit ResultStorage(const ErrorInfo& error)
+        : m_errorCode(error.code)
+        , m_errorMessage(error.message)
+        , m_empty() {}
+
+    template<typename... Args>
+    explicit ResultStorage(std::in_place_t, Args&&... args)
+        : m_errorCode(ErrorCode::Success)
+        , m_value(std::forward<Args>(args)...) {}
+
+    ResultStorage(const ResultStorage& other)
+        : m_errorCode(other.m_errorCode)
+        , m_errorMessage(other.m_errorMessage)
+        , m_empty() {
+        if (m_errorCode == ErrorCode::Success) {
+            new (&m_value) T(other.m_value);
+        }
+    }
+
+    ResultStorage(ResultStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : m_errorCode(other.m_errorCode)
+        , m_errorMessage(other.m_errorMessage)
+        , m_empty() {
+        if (m_errorCode == ErrorCode::Success) {
+            new (&m_value) T(std::move(other.m_value));
+        }
+    }
+
+    ResultStorage& operator=(const ResultStorage& other) {
+        if (this != &other) {
+            Destroy();
+            m_errorCode = other.m_errorCode;
+            m_errorMessage = other.m_errorMessage;
+            if (m_errorCode == ErrorCode::Success) {
+                new (&m_value) T(other.m_value);
+            }
+        }
+        return *this;
+    }
+
+    ResultStorage& operator=(ResultStorage&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            Destroy();
+            m_errorCode = other.m_errorCode;
+            m_errorMessage = other.m_errorMessage;
+            if (m_errorCode == ErrorCode::Success) {
+                new (&m_value) T(std::move(other.m_value));
+            }
+        }
+        return *this;
+    }
+
+    ~ResultStorage() {
+        Destroy();
+    }
+
+    void Destroy() {
+        if (m_errorCode == ErrorCode::Success) {
+            m_value.~T();
+        }
+        // 析构后按失败状态处理，避免重复析构
+        m_errorCode = ErrorCode::Unknown;
+    }
+
+    ErrorCode m_errorCode = ErrorCode::Success;
+    const char* m_errorMessage = "";
+    union {
+        char m_empty;
+        T m_value;
+    };
+};
+
+} // namespace Detail
+
 // 结果包装类
+// 成功路径只包含错误码、空消息指针和值本身：值可平凡复制时整个Result也可平凡复制，
+// 只可移动或较大的值通过移动构造传入和取出。值只在成功时构造，失败时不得调用GetValue。
 template<typename T>
-class Result {
+class [[nodiscard]] Result : private Detail::ResultStorage<T> {
+    using Storage = Detail::ResultStorage<T>;
+
 public:
+    using ValueType = T;
+
     // 构造成功结果
     static Result<T> Success(const T& value) {
-        return Result<T>(value);
+        return Result<T>(std::in_place, value);
     }
-    
-    // 构造成功结果（void特化）
-    static Result<void> Success() {
-        return Result<void>();
+
+    static Result<T> Success(T&& value) {
+        return Result<T>(std::in_place, std::move(value));
     }
-    
-    // 构造错误结果
+
+    // 构造错误结果（字符串字面量，不驻留）
+    // 只用于字符串字面量等静态存储的常量数组：Result只保存指针，不复制内容
+    template<size_t N>
+    static Result<T> Failure(ErrorCode code, const char (&message)[N]) {
+        return Result<T>(ErrorInfo{code, message});
+    }
+
+    // 构造错误结果（可写字符数组，例如snprintf的局部缓冲区，驻留后保存指针）
+    template<size_t N>
+    static Result<T> Failure(ErrorCode code, char (&message)[N]) {
+        return Result<T>(ErrorInfo{code, InternErrorMessage(message)});
+    }
+
+    // 构造错误结果（动态消息，驻留后保存指针）
     static Result<T> Failure(ErrorCode code, const std::string& message) {
-        return Result<T>(code, message);
+        return Result<T>(ErrorInfo{code, InternErrorMessage(message)});
     }
-    
+
+    // 从错误信息构造（用于在不同Result类型之间传递错误）
+    Result(const ErrorInfo& error)
+        : Storage(error) {}
+
+    // 从可转换值类型的Result构造（例如Result<std::nullptr_t>到Result<void*>）
+    template<typename U, typename = std::enable_if_t<
+        !std::is_same<U, T>::value && !std::is_void<U>::value &&
+        std::is_constructible<T, U&&>::value>>
+    Result(Result<U>&& other)
+        : Storage(other.IsSuccess() ? Storage(std::in_place, std::move(other).GetValue()) : Storage(other.GetError())) {}
+
     // 检查是否成功
-    bool IsSuccess() const { return m_errorCode == ErrorCode::Success; }
-    
+    bool IsSuccess() const { return this->m_errorCode == ErrorCode::Success; }
+
     // 获取错误码
-    ErrorCode GetErrorCode() const { return m_errorCode; }
-    
-    // 获取错误信息
-    const std::string& GetErrorMessage() const { return m_errorMessage; }
-    
-    // 获取结果值（非void类型）
-    const T& GetValue() const { return m_value; }
-    T& GetValue() { return m_value; }
+    ErrorCode GetErrorCode() const { return this->m_errorCode; }
 
-private:
-    // 成功结果构造函数
-    Result(const T& value) 
-        : m_errorCode(ErrorCode::Success)
-        , m_value(value) {}
-    
-    // void特化的成功结果构造函数
-    Result() 
-        : m_errorCode(ErrorCode::Success) {}
-    
-    // 错误结果构造函数
-    Result(ErrorCode code, const std::string& message)
-        : m_errorCode(code)
-        , m_errorMessage(message) {}
+    // 获取错误信息（成功时为空字符串）
+    const char* GetErrorMessage() const { return this->m_errorMessage; }
+
+    // 获取错误码与消息
+    ErrorInfo GetError() const { return ErrorInfo{this->m_errorCode, this->m_errorMessage}; }
+
+    // 获取结果值（仅成功时）
+    const T& GetValue() const & { assert(IsSuccess()); return this->m_value; }
+    T& GetValue() & { assert(IsSuccess()); return this->m_value; }
+    T&& GetValue() && { assert(IsSuccess()); return std::move(this->m_value); }
 
 private:
-    ErrorCode m_errorCode = ErrorCode::Success;
-    std::string m_errorMessage;
-    T m_value;
+    // 成功结果构造函数
+    template<typename... Args>
+    explicit Result(std::in_place_t, Args&&... args)
+        : Storage(std::in_place, std::forward<Args>(args)...) {}
 };
 
 // void特化
 template<>
-class Result<void> {
+class [[nodiscard]] Result<void> {
 public:
+    using ValueType = void;
+
     static Result<void> Success() {
         return Result<void>();
     }
-    
+
+    template<size_t N>
+    static Result<void> Failure(ErrorCode code, const char (&message)[N]) {
+        return Result<void>(ErrorInfo{code, message});
+    }
+
+    template<size_t N>
+    static Result<void> Failure(ErrorCode code, char (&message)[N]) {
+        return Result<void>(ErrorInfo{code, InternErrorMessage(message)});
+    }
+
     static Result<void> Failure(ErrorCode code, const std::string& message) {
-        return Result<void>(code, message);
+        return Result<void>(ErrorInfo{code, InternErrorMessage(message)});
     }
-    
+
+    Result(const ErrorInfo& error)
+        : m_errorCode(error.code)
+        , m_errorMessage(error.message) {}
+
     bool IsSuccess() const { return m_errorCode == ErrorCode::Success; }
     ErrorCode GetErrorCode() const { return m_errorCode; }
-    const std::string& GetErrorMessage() const { return m_errorMessage; }
+    const char* GetErrorMessage() const { return m_errorMessage; }
+    ErrorInfo GetError() const { return ErrorInfo{m_errorCode, m_errorMessage}; }
 
 private:
     Result() : m_errorCode(ErrorCode::Success) {}
-    Result(ErrorCode code, const std::string& message)
-        : m_errorCode(code)
-        , m_errorMessage(message) {}
 
 private:
     ErrorCode m_errorCode = ErrorCode::Success;
-    std::string m_errorMessage;
+    const char* m_errorMessage = "";
 };
 
 } // namespace RHI
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace RHI {
+
+// 非拥有的连续元素视图（指针 + 数量）
+// 可由指针与数量、C数组或任何提供data()/size()的容器（std::vector、std::array、Span）隐式构造，
+// 调用方须保证元素在使用期间有效
+template<typename T>
+class Span {
+public:
+    constexpr Span() : m_data(nullptr), m_size(0) {}
+    constexpr Span(T* data, size_t size) : m_data(data), m_size(size) {}
+
+    template<size_t N>
+    constexpr Span(T (&array)[N]) : m_data(array), m_size(N) {}
+
+    template<typename Container, typename = std::enable_if_t<
+        !std::is_array<Container>::value &&
+        std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>>
+    constexpr Span(Container& container) : m_data(container.data()), m_size(container.size()) {}
+
+    constexpr T* data() const { return m_data; }
+    constexpr size_t size() const { return m_size; }
+    constexpr bool empty() const { return m_size == 0; }
+    constexpr T* begin() const { return m_data; }
+    constexpr T* end() const { return m_data + m_size; }
+    constexpr T& operator[](size_t index) const { return m_data[index]; }
+
+private:
+    T* m_data;
+    size_t m_size;
+};
+
+} // namespace RHI
@@ -0,0 +1,294 @@
+#pragma once
+#include "CommandBuffer.h"
+#include "ErrorUtil.h"
+#include <cstring>
+
+namespace RHI {
+
+// 状态过滤器可缓存的最大描述符集/顶点缓冲区槽位数与推送常量字节数，超出范围的调用直接转发
+constexpr uint32_t kStateFilterMaxDescriptorSets = 8;
+constexpr uint32_t kStateFilterMaxVertexBuffers = 16;
+constexpr uint32_t kStateFilterMaxPushConstantSize = 256;
+
+// 按状态类别统计的调用数
+struct StateFilterCounters {
+    uint64_t pipelineState = 0;
+    uint64_t descriptorSet = 0;
+    uint64_t vertexBuffer = 0;
+    uint64_t indexBuffer = 0;
+    uint64_t viewport = 0;
+    uint64_t scissor = 0;
+    uint64_t pushConstants = 0;
+
+    uint64_t Total() const {
+        return pipelineState + descriptorSet + vertexBuffer + indexBuffer + viewport + scissor + pushConstants;
+    }
+};
+
+// 状态过滤统计
+struct StateFilterStats {
+    StateFilterCounters forwarded;  // 转发给后端的调用数
+    StateFilterCounters filtered;   // 因状态未改变而丢弃的调用数
+};
+
+// 冗余状态过滤包装器
+// 记录当前绑定的管线、各描述符集、各顶点缓冲区槽位、索引缓冲区、视口、裁剪矩形与推送常量，
+// 丢弃不会改变任何状态的调用，其余命令原样转发给被包装的命令缓冲区。
+// 以下情况下缓存失效（保守处理，保证在所有后端上语义一致）：
+// - Begin/End/Reset：全部失效
+// - SetPipelineState（管线改变时）：描述符集与推送常量失效（管线布局可能不兼容）
+// - ExecuteBundle：全部失效（二级命令缓冲区执行后主命令缓冲区的绑定状态未定义）
+// 包装器不拥有被包装的命令缓冲区；提交与ExecuteBundle须使用GetCommandBuffer()返回的后端对象。
+class StateFilteringCommandBuffer : public ICommandBuffer {
+public:
+    explicit StateFilteringCommandBuffer(ICommandBuffer* commandBuffer)
+        : m_commandBuffer(commandBuffer) {
+        m_desc = commandBuffer->GetDesc();
+    }
+
+    ICommandBuffer* GetCommandBuffer() const { return m_commandBuffer; }
+
+    const StateFilterStats& GetStats() const { return m_stats; }
+    void ResetStats() { m_stats = StateFilterStats(); }
+
+    // 丢弃全部缓存状态，下一次状态设置一定会被转发（例如外部直接操作了被包装的命令缓冲区之后）
+    void InvalidateState() {
+        m_pipelineState = nullptr;
+        m_pipelineValid = false;
+        InvalidateBindings();
+        m_vertexBufferMask = 0;
+        m_indexBufferValid = false;
+        m_viewportValid = false;
+        m_scissorValid = false;
+    }
+
+    const CommandBufferDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override { return m_commandBuffer->GetNativeHandle(); }
+
+    Result<void> Begin() override {
+        InvalidateState();
+        return m_commandBuffer->Begin();
+    }
+
+    Result<void> End() override {
+        InvalidateState();
+        return m_commandBuffer->End();
+    }
+
+    Result<void> Reset() override {
+        InvalidateState();
+        return m_commandBuffer->Reset();
+    }
+
+    Result<void> BeginRenderPass(const RenderPassDesc& desc) override {
+        return m_commandBuffer->BeginRenderPass(desc);
+    }
+
+    Result<void> EndRenderPass() override {
+        return m_commandBuffer->EndRenderPass();
+    }
+
+    Result<void> SetViewport(const Viewport& viewport) override {
+        if (m_viewportValid && std::memcmp(&viewport, &m_viewport, sizeof(Viewport)) == 0) {
+            ++m_stats.filtered.viewport;
+            return MakeSuccessResult();
+        }
+        ++m_stats.forwarded.viewport;
+        Result<void> result = m_commandBuffer->SetViewport(viewport);
+        m_viewport = viewport;
+        m_viewportValid = result.IsSuccess();
+        return result;
+    }
+
+    Result<void> SetScissor(const Scissor& scissor) override {
+        if (m_scissorValid && std::memcmp(&scissor, &m_scissor, sizeof(Scissor)) == 0) {
+            ++m_stats.filtered.scissor;
+            return MakeSuccessResult();
+        }
+        ++m_stats.forwarded.scissor;
+        Result<void> result = m_commandBuffer->SetScissor(scissor);
+        m_scissor = scissor;
+        m_scissorValid = result.IsSuccess();
+        return result;
+    }
+
+    Result<void> SetPipelineState(void* pipelineState) override {
+        if (m_pipelineValid && pipelineState == m_pipelineState) {
+            ++m_stats.filtered.pipelineState;
+            return MakeSuccessResult();
+        }
+        ++m_stats.forwarded.pipelineState;
+        InvalidateBindings();
+        Result<void> result = m_commandBuffer->SetPipelineState(pipelineState);
+        m_pipelineState = pipelineState;
+        m_pipelineValid = result.IsSuccess();
+        return result;
+    }
+
+    Result<void> SetDescriptorSet(uint32_t set, void* descriptorSet) override {
+        if (set >= kStateFilterMaxDescriptorSets) {
+            ++m_stats.forwarded.descriptorSet;
+            return m_commandBuffer->SetDescriptorSet(set, descriptorSet);
+        }
+        uint32_t bit = 1u << set;
+        if ((m_descriptorSetMask & bit) != 0 && m_descriptorSets[set] == descriptorSet) {
+            ++m_stats.filtered.descriptorSet;
+            return MakeSuccessResult();
+        }
+        ++m_stats.forwarded.descriptorSet;
+        Result<void> result = m_commandBuffer->SetDescriptorSet(set, descriptorSet);
+        m_descriptorSets[set] = descriptorSet;
+        m_descriptorSetMask = result.IsSuccess() ? (m_descriptorSetMask | bit) : (m_descriptorSetMask & ~bit);
+        return result;
+    }
+
+    // 带动态偏移的绑定总是转发（偏移通常逐次绘制变化），并使该槽位的缓存失效
+    Result<void> SetDescriptorSet(uint32_t set, void* descriptorSet, Span<const uint32_t> dynamicOffsets) override {
+        ++m_stats.forwarded.descriptorSet;
+        if (set < kStateFilterMaxDescriptorSets) {
+            m_descriptorSetMask &= ~(1u << set);
+        }
+        return m_commandBuffer->SetDescriptorSet(set, descriptorSet, dynamicOffsets);
+    }
+
+    Result<void> SetVertexBuffer(uint32_t slot, void* vertexBufferView) override {
+        if (slot >= kStateFilterMaxVertexBuffers) {
+            ++m_stats.forwarded.vertexBuffer;
+            return m_commandBuffer->SetVertexBuffer(slot, vertexBufferView);
+        }
+        uint32_t bit = 1u << slot;
+        if ((m_vertexBufferMask & bit) != 0 && m_vertexBuffers[slot] == vertexBufferView) {
+            ++m_stats.filtered.vertexBuffer;
+            return MakeSuccessResult();
+        }
+        ++m_stats.forwarded.vertexBuffer;
+        Result<void> result = m_commandBuffer->SetVertexBuffer(slot, vertexBufferView);
+        m_vertexBuffers[slot] = vertexBufferView;
+        m_vertexBufferMask = result.IsSuccess() ? (m_vertexBufferMask | bit) : (m_vertexBufferMask & ~bit);
+        return result;
+    }
+
+    Result<void> SetIndexBuffer(void* indexBufferView) override {
+        if (m_indexBufferValid && indexBufferView == m_indexBuffer) {
+            ++m_stats.filtered.indexBuffer;
+            return MakeSuccessResult();
+        }
+        ++m_stats.forwarded.indexBuffer;
+        Result<void> result = m_commandBuffer->SetIndexBuffer(indexBufferView);
+        m_indexBuffer = indexBufferView;
+        m_indexBufferValid = result.IsSuccess();
+        return result;
+    }
+
+    // 推送常量按4字节字缓存：布局相同且范围内每个字都已知且相等时丢弃
+    Result<void> PushConstants(void* layout, uint32_t offset, uint32_t size, const void* data) override {
+        uint64_t mask = PushConstantMask(offset, size);
+        if (mask == 0 || data == nullptr) {
+            ++m_stats.forwarded.pushConstants;
+            m_pushConstantMask = 0;
+            return m_commandBuffer->PushConstants(layout, offset, size, data);
+        }
+        if (layout == m_pushConstantLayout && (m_pushConstantMask & mask) == mask &&
+            std::memcmp(m_pushConstants + offset, data, size) == 0) {
+            ++m_stats.filtered.pushConstants;
+            return MakeSuccessResult();
+        }
+        ++m_stats.forwarded.pushConstants;
+        Result<void> result = m_commandBuffer->PushConstants(layout, offset, size, data);
+        if (layout != m_pushConstantLayout) {
+            m_pushConstantLayout = layout;
+            m_pushConstantMask = 0;
+        }
+        if (result.IsSuccess()) {
+            std::memcpy(m_pushConstants + offset, data, size);
+            m_pushConstantMask |= mask;
+        } else {
+            m_pushConstantMask &= ~mask;
+        }
+        return result;
+    }
+
+    Result<void> Draw(uint32_t vertexCount, uint32_t instanceCount,
+                      uint32_t firstVertex, uint32_t firstInstance) override {
+        return m_commandBuffer->Draw(vertexCount, instanceCount, firstVertex, firstInstance);
+    }
+
+    Result<void> DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+                             int32_t vertexOffset, uint32_t firstInstance) override {
+        return m_commandBuffer->DrawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    }
+
+    Result<void> DrawIndirect(void* argumentBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override {
+        return m_commandBuffer->DrawIndirect(argumentBuffer, offset, drawCount, stride);
+    }
+
+    Result<void> Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override {
+        return m_commandBuffer->Dispatch(groupCountX, groupCountY, groupCountZ);
+    }
+
+    Result<void> DispatchIndirect(void* argumentBuffer, uint32_t offset) override {
+        return m_commandBuffer->DispatchIndirect(argumentBuffer, offset);
+    }
+
+    Result<void> CopyBuffer(void* srcBuffer, void* dstBuffer, uint32_t regionCount, void* regions) override {
+        return m_commandBuffer->CopyBuffer(srcBuffer, dstBuffer, regionCount, regions);
+    }
+
+    Result<void> CopyTexture(void* srcTexture, void* dstTexture, uint32_t regionCount, void* regions) override {
+        return m_commandBuffer->CopyTexture(srcTexture, dstTexture, regionCount, regions);
+    }
+
+    Result<void> CopyBufferToTexture(void* srcBuffer, void* dstTexture, uint32_t regionCount, void* regions) override {
+        return m_commandBuffer->CopyBufferToTexture(srcBuffer, dstTexture, regionCount, regions);
+    }
+
+    Result<void> ResourceBarrier(uint32_t barrierCount, const BarrierDesc* barriers) override {
+        return m_commandBuffer->ResourceBarrier(barrierCount, barriers);
+    }
+
+    Result<void> ExecuteBundle(ICommandBuffer* bundle) override {
+        InvalidateState();
+        return m_commandBuffer->ExecuteBundle(bundle);
+    }
+
+private:
+    void InvalidateBindings() {
+        m_descriptorSetMask = 0;
+        m_pushConstantLayout = nullptr;
+        m_pushConstantMask = 0;
+    }
+
+    // [offset, offset + size)覆盖的4字节字掩码；未对齐或越界时返回0（不缓存）
+    static uint64_t PushConstantMask(uint32_t offset, uint32_t size) {
+        if (size == 0 || (offset & 3) != 0 || (size & 3) != 0 ||
+            offset >= kStateFilterMaxPushConstantSize || size > kStateFilterMaxPushConstantSize - offset) {
+            return 0;
+        }
+        uint32_t firstWord = offset / 4;
+        uint32_t wordCount = size / 4;
+        uint64_t mask = wordCount == 64 ? ~0ull : ((1ull << wordCount) - 1);
+        return mask << firstWord;
+    }
+
+    ICommandBuffer* m_commandBuffer;
+    StateFilterStats m_stats;
+
+    void* m_pipelineState = nullptr;
+    bool m_pipelineValid = false;
+    void* m_descriptorSets[kStateFilterMaxDescriptorSets] = {};
+    uint32_t m_descriptorSetMask = 0;              // 已知绑定的描述符集位掩码
+    void* m_vertexBuffers[kStateFilterMaxVertexBuffers] = {};
+    uint32_t m_vertexBufferMask = 0;               // 已知绑定的顶点缓冲区槽位位掩码
+    void* m_indexBuffer = nullptr;
+    bool m_indexBufferValid = false;
+    Viewport m_viewport = {};
+    bool m_viewportValid = false;
+    Scissor m_scissor = {};
+    bool m_scissorValid = false;
+    void* m_pushConstantLayout = nullptr;
+    uint64_t m_pushConstantMask = 0;               // 已知内容的推送常量字位掩码
+    uint8_t m_pushConstants[kStateFilterMaxPushConstantSize] = {};
+};
+
+} // namespace RHI
@@ -10,14 +10,15 @@ class SwapChainExample : public ISwapChain {
 public:
     Result<void> Initialize(const SwapChainDesc& desc) override {
         // 参数验证
-        RHI_RETURN_IF_FALSE(desc.width > 0 && desc.height > 0,
+        RHI_VALIDATE(desc.width > 0 && desc.height > 0,
             ErrorCode::InvalidArgument,
             "交换链尺寸必须大于0");
 
-        RHI_RETURN_IF_FALSE(desc.bufferCount >= 2 && desc.bufferCount <= 3,
+        RHI_VALIDATE(desc.bufferCount >= 2 && desc.bufferCount <= 3,
             ErrorCode::InvalidBufferCount,
             "缓冲数量必须为2或3");
 
+#if RHI_VALIDATION_LEVEL >= RHI_VALIDATION_LEVEL_FULL
         // 验证格式支持
         auto formatResult = ValidateFormat(desc.format);
         RHI_RETURN_IF_FAILED(formatResult);
@@ -25,6 +26,7 @@ public:
         // 验证呈现模式
         auto presentModeResult = ValidatePresentMode(desc.presentMode);
         RHI_RETURN_IF_FAILED(presentModeResult);
+#endif
 
         // 尝试创建交换链
         try {
@@ -42,9 +44,9 @@ public:
 
     Result<void> Present(const PresentInfo& presentInfo) override {
         // 验证后缓冲区索引
-        RHI_RETURN_IF_FALSE(presentInfo.backBufferIndex < m_desc.bufferCount,
+        RHI_VALIDATE(presentInfo.backBufferIndex < m_desc.bufferCount,
             ErrorCode::InvalidArgument,
-            "无效的后缓冲区索引");
+            "无效的后缓冲区索引: " + std::to_string(presentInfo.backBufferIndex));
 
         try {
             // 这里是实际的呈现代码
@@ -60,7 +62,7 @@ public:
 
     Result<void> Resize(uint32_t width, uint32_t height) override {
         // 参数验证
-        RHI_RETURN_IF_FALSE(width > 0 && height > 0,
+        RHI_VALIDATE(width > 0 && height > 0,
             ErrorCode::InvalidArgument,
             "交换链尺寸必须大于0");
 
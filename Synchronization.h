@@ -22,15 +22,40 @@ struct FenceDesc {
 };
 
 // 信号量描述
+// 默认创建时间线信号量；二进制信号量只用于交换链的获取与呈现
 struct SemaphoreDesc {
     bool binary;        // 是否为二进制信号量
     uint64_t initialValue;  // 初始值（仅用于时间线信号量）
 
     SemaphoreDesc() :
-        binary(true),
+        binary(false),
         initialValue(0) {}
 };
 
+// 管线阶段（信号量等待在这些阶段之前阻塞，之前的阶段可以提前执行）
+enum class PipelineStage : uint32_t {
+    None                = 0,
+    DrawIndirect        = 1 << 0,    // 间接参数读取
+    VertexInput         = 1 << 1,    // 顶点与索引读取
+    VertexShader        = 1 << 2,    // 顶点着色器
+    PixelShader         = 1 << 3,    // 像素着色器
+    DepthStencil        = 1 << 4,    // 深度模板测试
+    RenderTarget        = 1 << 5,    // 颜色附件输出
+    ComputeShader       = 1 << 6,    // 计算着色器
+    Copy                = 1 << 7,    // 复制
+    AllCommands         = 1 << 8,    // 所有阶段
+};
+
+inline PipelineStage operator|(PipelineStage a, PipelineStage b) {
+    return static_cast<PipelineStage>(
+        static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline PipelineStage operator&(PipelineStage a, PipelineStage b) {
+    return static_cast<PipelineStage>(
+        static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
 // 事件描述
 struct EventDesc {
     bool manualReset;   // 是否为手动重置事件
@@ -59,6 +84,10 @@ public:
     // 等待特定值
     virtual Result<void> Wait(uint64_t value, uint64_t timeout) = 0;
 
+    // 获取最近一次提交（或Signal）将要发出的值（GPU可能尚未到达）
+    // 等待该值即等待此前所有使用此栅栏的提交完成
+    virtual uint64_t GetLastSubmittedValue() const = 0;
+
     // 重置栅栏
     virtual Result<void> Reset() = 0;
 
@@ -67,6 +96,9 @@ protected:
 };
 
 // 信号量抽象基类
+// 时间线信号量是首选的同步原语：每个队列维护一个单调递增的时间线，提交通过SubmitBatch等待与发出(信号量, 值)，
+// CPU通过GetValue查询进度、通过Wait/IDevice::WaitMultiple等待、通过Signal在主机端发出。
+// 二进制信号量只用于交换链获取与呈现。
 class ISemaphore {
 public:
     virtual ~ISemaphore() = default;
@@ -80,13 +112,60 @@ public:
     // 获取当前值（仅用于时间线信号量）
     virtual Result<uint64_t> GetValue() const = 0;
 
-    // 等待特定值（仅用于时间线信号量）
+    // 等待特定值（仅用于时间线信号量，timeout单位为纳秒）
     virtual Result<void> Wait(uint64_t value, uint64_t timeout) = 0;
 
+    // 在主机端发出特定值（仅用于时间线信号量，值必须递增）
+    virtual Result<void> Signal(uint64_t value) = 0;
+
+    bool IsBinary() const { return m_desc.binary; }
+
 protected:
     SemaphoreDesc m_desc;
 };
 
+// IDevice::WaitMultiple一次最多等待的信号量数
+constexpr uint32_t kMaxWaitMultipleSemaphores = 32;
+
+// CPU等待多个信号量的方式
+enum class SemaphoreWaitMode {
+    All,                // 所有信号量都到达各自的值
+    Any                 // 任一信号量到达其值
+};
+
+// 提交等待的信号量
+// 时间线信号量等待到达value，二进制信号量忽略value；stages之前的阶段不受等待阻塞
+struct SemaphoreWaitInfo {
+    ISemaphore* semaphore;
+    uint64_t value;
+    PipelineStage stages;
+
+    SemaphoreWaitInfo() :
+        semaphore(nullptr),
+        value(0),
+        stages(PipelineStage::AllCommands) {}
+
+    SemaphoreWaitInfo(ISemaphore* semaphore, uint64_t value, PipelineStage stages = PipelineStage::AllCommands) :
+        semaphore(semaphore),
+        value(value),
+        stages(stages) {}
+};
+
+// 提交发出的信号量
+// 时间线信号量发出value（须大于此前发出的值），二进制信号量忽略value
+struct SemaphoreSignalInfo {
+    ISemaphore* semaphore;
+    uint64_t value;
+
+    SemaphoreSignalInfo() :
+        semaphore(nullptr),
+        value(0) {}
+
+    SemaphoreSignalInfo(ISemaphore* semaphore, uint64_t value) :
+        semaphore(semaphore),
+        value(value) {}
+};
+
 // 事件抽象基类
 class IEvent {
 public:
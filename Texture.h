@@ -1,5 +1,6 @@
 #pragma once
 #include "TextureDesc.h"
+#include "ResourceState.h"
 #include "Result.h"
 #include <vector>
 
@@ -65,11 +66,8 @@ public:
         uint32_t arrayLayer) const = 0;
 
     // 转换纹理布局/状态
-    // DirectX12: D3D12_RESOURCE_STATES
-    // Vulkan: VkImageLayout
-    // Metal: MTLResourceUsage
     virtual Result<void> TransitionLayout(
-        uint32_t newState,
+        ResourceState newState,
         const TextureSubresourceRange& range) = 0;
 
 protected:
@@ -1,6 +1,8 @@
 
 #pragma once
 #include "Format.h"
+#include "Memory.h"
+#include <cstddef>
 #include <cstdint>
 
 namespace RHI {
@@ -25,6 +27,8 @@ enum class TextureUsage : uint32_t {
     UnorderedAccess     = 1 << 3,    // UAV访问
     TransferSrc         = 1 << 4,    // 传输源
     TransferDst         = 1 << 5,    // 传输目标
+    Transient           = 1 << 6,    // 瞬态附件：内容只在一个渲染通道内有效（不加载、不存储），
+                                     // 设备支持时使用延迟分配的内存（见IDevice::SupportsLazilyAllocatedMemory）
 };
 
 inline TextureUsage operator|(TextureUsage a, TextureUsage b) {
@@ -97,6 +101,7 @@ struct TextureDesc {
     TextureUsage usage;           // 使用标志
     bool isCubeCompatible;        // 是否可用作立方体纹理
     SamplerDesc samplerDesc;      // 采样器描述
+    MemoryTag tag;                // 内存标签
 
     TextureDesc() :
         type(TextureType::Texture2D),
@@ -111,6 +116,35 @@ struct TextureDesc {
         isCubeCompatible(false) {}
 };
 
+// 瞬态附件只能用作渲染目标或深度模板（不能采样、UAV访问或复制）
+inline bool IsValidTransientUsage(TextureUsage usage) {
+    const TextureUsage attachment = TextureUsage::RenderTarget | TextureUsage::DepthStencil;
+    const TextureUsage allowed = attachment | TextureUsage::Transient;
+    return (usage & TextureUsage::Transient) == TextureUsage::None ||
+        ((usage & attachment) != TextureUsage::None &&
+         static_cast<uint32_t>(usage) == static_cast<uint32_t>(usage & allowed));
+}
+
+// 纹理的数组层数（立方体纹理每个元素6层）
+inline uint32_t GetTextureLayerCount(const TextureDesc& desc) {
+    return desc.type == TextureType::TextureCube || desc.type == TextureType::TextureCubeArray
+        ? desc.arraySize * 6
+        : desc.arraySize;
+}
+
+// 估算纹理所有子资源的数据大小（字节，不含后端的对齐与元数据）
+inline size_t EstimateTextureDataSize(const TextureDesc& desc) {
+    uint32_t block = GetFormatBlockDimension(desc.format);
+    size_t size = 0;
+    for (uint32_t mip = 0; mip < desc.mipLevels; ++mip) {
+        size_t width = desc.width >> mip ? desc.width >> mip : 1;
+        size_t height = desc.height >> mip ? desc.height >> mip : 1;
+        size_t depth = desc.depth >> mip ? desc.depth >> mip : 1;
+        size += ((width + block - 1) / block) * ((height + block - 1) / block) * depth * GetFormatBlockSize(desc.format);
+    }
+    return size * GetTextureLayerCount(desc) * desc.sampleCount;
+}
+
 // 纹理子资源范围
 struct TextureSubresourceRange {
     uint32_t baseMipLevel;        // 基础mip级别
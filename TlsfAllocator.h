@@ -0,0 +1,370 @@
+#pragma once
+#include "Memory.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace RHI {
+
+// TLSF（两级隔离适配）偏移分配器
+// 在[0, size)的偏移空间上分配，不接触实际内存；IMemory的实现用它把一个内存块切分成多个分配。
+// 空闲块按大小放入两级链表（一级为2的幂区间，二级把区间等分为32份），用位图查找，
+// 分配与释放都是O(1)；释放时与物理相邻的空闲块立即合并。
+// 块节点从分块的节点池中分配，指针在分配器销毁前保持有效，可直接作为分配句柄。
+// 非线程安全。
+class TlsfAllocator {
+public:
+    static constexpr uint64_t kGranularity = 16;               // 偏移的最小粒度，分配大小按它向上取整
+    static constexpr uint32_t kSecondLevelBits = 5;
+    static constexpr uint32_t kSecondLevelCount = 1u << kSecondLevelBits;
+    static constexpr uint32_t kFirstLevelShift = kSecondLevelBits + 4;      // 小于512字节的块都在第0级
+    static constexpr uint64_t kSmallBlockSize = uint64_t(1) << kFirstLevelShift;
+    static constexpr uint32_t kFirstLevelCount = 64 - kFirstLevelShift + 1;
+
+    // 块节点（已分配的块即分配句柄）
+    struct Block {
+        uint64_t offset;                // 在内存块中的偏移
+        uint64_t size;                  // 块大小（不小于请求大小，按粒度对齐）
+        MemoryAllocationInfo info;      // 分配时的请求（由调用方填写）
+        const TlsfAllocator* owner;
+        Block* prevPhysical;
+        Block* nextPhysical;
+        Block* prevFree;
+        Block* nextFree;                // 也用于节点池的空闲链表
+        bool free;
+    };
+
+    TlsfAllocator() = default;
+
+    explicit TlsfAllocator(uint64_t size) {
+        Reset(size);
+    }
+
+    TlsfAllocator(const TlsfAllocator&) = delete;
+    TlsfAllocator& operator=(const TlsfAllocator&) = delete;
+
+    // 丢弃所有分配并重新管理[0, size)
+    void Reset(uint64_t size) {
+        m_firstLevelBitmap = 0;
+        for (uint32_t fl = 0; fl < kFirstLevelCount; ++fl) {
+            m_secondLevelBitmaps[fl] = 0;
+            for (uint32_t sl = 0; sl < kSecondLevelCount; ++sl) {
+                m_freeLists[fl][sl] = nullptr;
+            }
+        }
+        m_nodeFreeList = nullptr;
+        m_firstBlock = nullptr;
+        for (auto& chunk : m_nodeChunks) {
+            for (uint32_t i = 0; i < kNodeChunkSize; ++i) {
+                ReleaseNode(&chunk[i]);
+            }
+        }
+
+        m_size = size;
+        m_usedSize = 0;
+        m_allocationCount = 0;
+        m_freeBlockCount = 0;
+        if (m_size > 0) {
+            Block* block = AcquireNode();
+            block->offset = 0;
+            block->size = m_size;
+            block->prevPhysical = nullptr;
+            block->nextPhysical = nullptr;
+            InsertFree(block);
+            m_firstBlock = block;
+        }
+    }
+
+    // 分配size字节，偏移按alignment（2的幂）对齐；空间不足时返回nullptr
+    Block* Allocate(uint64_t size, uint64_t alignment) {
+        if (size == 0 || size > m_size) {
+            return nullptr;
+        }
+        alignment = alignment > kGranularity ? alignment : kGranularity;
+        Block* block = FindFree(size, alignment);
+        if (block == nullptr) {
+            return nullptr;
+        }
+        RemoveFree(block);
+
+        uint64_t padding = AlignUp(block->offset, alignment) - block->offset;
+        if (padding > 0) {
+            // 对齐填充作为独立的空闲块留在前面
+            Block* head = AcquireNode();
+            head->offset = block->offset;
+            head->size = padding;
+            head->prevPhysical = block->prevPhysical;
+            head->nextPhysical = block;
+            if (head->prevPhysical != nullptr) {
+                head->prevPhysical->nextPhysical = head;
+            } else {
+                m_firstBlock = head;
+            }
+            block->prevPhysical = head;
+            block->offset += padding;
+            block->size -= padding;
+            InsertFree(head);
+        }
+        // 剩余部分从下一个粒度边界起拆分为空闲块（只有末尾的块大小可能不是粒度的整数倍）
+        size = AlignUp(size, kGranularity);
+        if (block->size > size && block->size - size >= kGranularity) {
+            Block* tail = AcquireNode();
+            tail->offset = block->offset + size;
+            tail->size = block->size - size;
+            tail->prevPhysical = block;
+            tail->nextPhysical = block->nextPhysical;
+            if (tail->nextPhysical != nullptr) {
+                tail->nextPhysical->prevPhysical = tail;
+            }
+            block->nextPhysical = tail;
+            block->size = size;
+            InsertFree(tail);
+        }
+
+        block->free = false;
+        block->info = MemoryAllocationInfo{};
+        m_usedSize += block->size;
+        ++m_allocationCount;
+        return block;
+    }
+
+    // 释放Allocate返回的块，并与相邻空闲块合并
+    void Free(Block* block) {
+        m_usedSize -= block->size;
+        --m_allocationCount;
+        Block* prev = block->prevPhysical;
+        if (prev != nullptr && prev->free) {
+            RemoveFree(prev);
+            prev->size += block->size;
+            prev->nextPhysical = block->nextPhysical;
+            if (prev->nextPhysical != nullptr) {
+                prev->nextPhysical->prevPhysical = prev;
+            }
+            ReleaseNode(block);
+            block = prev;
+        }
+        Block* next = block->nextPhysical;
+        if (next != nullptr && next->free) {
+            RemoveFree(next);
+            block->size += next->size;
+            block->nextPhysical = next->nextPhysical;
+            if (block->nextPhysical != nullptr) {
+                block->nextPhysical->prevPhysical = block;
+            }
+            ReleaseNode(next);
+        }
+        InsertFree(block);
+    }
+
+    // 判断block是否是本分配器中尚未释放的分配（block须来自某个TlsfAllocator）
+    bool Owns(const Block* block) const {
+        return block != nullptr && block->owner == this && !block->free;
+    }
+
+    uint64_t GetSize() const { return m_size; }
+    uint64_t GetUsedSize() const { return m_usedSize; }
+    uint64_t GetFreeSize() const { return m_size - m_usedSize; }
+    uint32_t GetAllocationCount() const { return m_allocationCount; }
+    uint32_t GetFreeBlockCount() const { return m_freeBlockCount; }
+
+    // 最大空闲块：只需查看最高的非空链表
+    uint64_t GetLargestFreeBlock() const {
+        if (m_firstLevelBitmap == 0) {
+            return 0;
+        }
+        uint32_t fl = 63 - CountLeadingZeros(m_firstLevelBitmap);
+        uint32_t sl = 31 - CountLeadingZeros32(m_secondLevelBitmaps[fl]);
+        uint64_t largest = 0;
+        for (const Block* block = m_freeLists[fl][sl]; block != nullptr; block = block->nextFree) {
+            largest = block->size > largest ? block->size : largest;
+        }
+        return largest;
+    }
+
+    // 碎片化程度：1 - 最大空闲块 / 空闲总量
+    float GetFragmentation() const {
+        uint64_t freeSize = GetFreeSize();
+        return freeSize > 0
+            ? 1.0f - static_cast<float>(GetLargestFreeBlock()) / static_cast<float>(freeSize)
+            : 0.0f;
+    }
+
+    MemoryStats GetStats() const {
+        MemoryStats stats = {};
+        stats.totalSize = static_cast<size_t>(m_size);
+        stats.usedSize = static_cast<size_t>(m_usedSize);
+        stats.largestFreeBlock = static_cast<size_t>(GetLargestFreeBlock());
+        stats.freeCount = m_freeBlockCount;
+        stats.fragmentation = GetFragmentation();
+        return stats;
+    }
+
+    // 按偏移顺序遍历所有块（含空闲块）
+    template<typename Func>
+    void ForEachBlock(Func&& func) const {
+        for (const Block* block = m_firstBlock; block != nullptr; block = block->nextPhysical) {
+            func(*block);
+        }
+    }
+
+    // 按偏移顺序输出所有块（IMemory::GetLayout）
+    void GetLayout(std::vector<MemoryRegion>& regions) const {
+        regions.clear();
+        ForEachBlock([&regions](const Block& block) {
+            regions.push_back(MemoryRegion{
+                static_cast<size_t>(block.offset), static_cast<size_t>(block.size), block.free});
+        });
+    }
+
+private:
+    static constexpr uint32_t kNodeChunkSize = 256;
+
+    static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    static uint32_t CountLeadingZeros(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return 63 - index;
+#else
+        return static_cast<uint32_t>(__builtin_clzll(value));
+#endif
+    }
+
+    static uint32_t CountLeadingZeros32(uint32_t value) {
+        return CountLeadingZeros(value) - 32;
+    }
+
+    static uint32_t CountTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return index;
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+    }
+
+    // 大小对应的链表
+    static void Mapping(uint64_t size, uint32_t& fl, uint32_t& sl) {
+        if (size < kSmallBlockSize) {
+            fl = 0;
+            sl = static_cast<uint32_t>(size / (kSmallBlockSize / kSecondLevelCount));
+        } else {
+            uint32_t bit = 63 - CountLeadingZeros(size);
+            sl = static_cast<uint32_t>(size >> (bit - kSecondLevelBits)) ^ kSecondLevelCount;
+            fl = bit - kFirstLevelShift + 1;
+        }
+    }
+
+    // 找一个对齐后放得下size的空闲块。块的偏移都按粒度对齐，先按size + alignment - 粒度向上取整到链表的下界，
+    // 在更大的链表中取任一块（O(1)）；找不到时再在size所在的链表中逐个检查，
+    // 避免大小正好合适的块（例如专用内存块）被漏掉
+    Block* FindFree(uint64_t size, uint64_t alignment) const {
+        uint64_t rounded = AlignUp(size, kGranularity) + (alignment - kGranularity);
+        if (rounded >= kSmallBlockSize) {
+            uint64_t round = (uint64_t(1) << (63 - CountLeadingZeros(rounded) - kSecondLevelBits)) - 1;
+            rounded = rounded > UINT64_MAX - round ? UINT64_MAX : rounded + round;
+        }
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping(rounded, fl, sl);
+        if (fl < kFirstLevelCount) {
+            uint32_t secondLevelMap = m_secondLevelBitmaps[fl] & (~0u << sl);
+            uint64_t firstLevelMap = fl + 1 < kFirstLevelCount ? m_firstLevelBitmap & (~uint64_t(0) << (fl + 1)) : 0;
+            if (secondLevelMap != 0 || firstLevelMap != 0) {
+                if (secondLevelMap == 0) {
+                    fl = CountTrailingZeros(firstLevelMap);
+                    secondLevelMap = m_secondLevelBitmaps[fl];
+                }
+                return m_freeLists[fl][CountTrailingZeros(secondLevelMap)];
+            }
+        }
+
+        Mapping(size, fl, sl);
+        for (Block* block = m_freeLists[fl][sl]; block != nullptr; block = block->nextFree) {
+            uint64_t padding = AlignUp(block->offset, alignment) - block->offset;
+            if (block->size >= padding && block->size - padding >= size) {
+                return block;
+            }
+        }
+        return nullptr;
+    }
+
+    void InsertFree(Block* block) {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping(block->size, fl, sl);
+        block->free = true;
+        block->prevFree = nullptr;
+        block->nextFree = m_freeLists[fl][sl];
+        if (block->nextFree != nullptr) {
+            block->nextFree->prevFree = block;
+        }
+        m_freeLists[fl][sl] = block;
+        m_firstLevelBitmap |= uint64_t(1) << fl;
+        m_secondLevelBitmaps[fl] |= 1u << sl;
+        ++m_freeBlockCount;
+    }
+
+    void RemoveFree(Block* block) {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        Mapping(block->size, fl, sl);
+        if (block->prevFree != nullptr) {
+            block->prevFree->nextFree = block->nextFree;
+        } else {
+            m_freeLists[fl][sl] = block->nextFree;
+            if (m_freeLists[fl][sl] == nullptr) {
+                m_secondLevelBitmaps[fl] &= ~(1u << sl);
+                if (m_secondLevelBitmaps[fl] == 0) {
+                    m_firstLevelBitmap &= ~(uint64_t(1) << fl);
+                }
+            }
+        }
+        if (block->nextFree != nullptr) {
+            block->nextFree->prevFree = block->prevFree;
+        }
+        block->free = false;
+        --m_freeBlockCount;
+    }
+
+    Block* AcquireNode() {
+        if (m_nodeFreeList == nullptr) {
+            m_nodeChunks.push_back(std::make_unique<Block[]>(kNodeChunkSize));
+            for (uint32_t i = 0; i < kNodeChunkSize; ++i) {
+                ReleaseNode(&m_nodeChunks.back()[i]);
+            }
+        }
+        Block* node = m_nodeFreeList;
+        m_nodeFreeList = node->nextFree;
+        node->owner = this;
+        return node;
+    }
+
+    // 回收的节点owner为空，过期句柄不会被Owns接受
+    void ReleaseNode(Block* node) {
+        node->owner = nullptr;
+        node->free = true;
+        node->nextFree = m_nodeFreeList;
+        m_nodeFreeList = node;
+    }
+
+    uint64_t m_size = 0;
+    uint64_t m_usedSize = 0;
+    uint32_t m_allocationCount = 0;
+    uint32_t m_freeBlockCount = 0;
+    uint64_t m_firstLevelBitmap = 0;
+    uint32_t m_secondLevelBitmaps[kFirstLevelCount] = {};
+    Block* m_freeLists[kFirstLevelCount][kSecondLevelCount] = {};
+    std::vector<std::unique_ptr<Block[]>> m_nodeChunks;
+    Block* m_nodeFreeList = nullptr;
+    Block* m_firstBlock = nullptr;          // 偏移为0的块
+};
+
+} // namespace RHI
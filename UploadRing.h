@@ -0,0 +1,232 @@
+#pragma once
+#include "Buffer.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "Synchronization.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace RHI {
+
+// 上传环描述
+struct UploadRingDesc {
+    size_t size;                   // 环形缓冲区大小（字节），须能容纳framesInFlight帧的数据
+    size_t alignment;              // 默认对齐（取DeviceLimits::minUniformBufferOffsetAlignment）
+    uint32_t framesInFlight;       // 同时在GPU上执行的最大帧数
+    BufferUsage usage;             // 环形缓冲区的用途
+
+    UploadRingDesc() :
+        size(16ull * 1024 * 1024),
+        alignment(256),
+        framesInFlight(2),
+        usage(BufferUsage::ConstantBuffer | BufferUsage::VertexBuffer |
+              BufferUsage::IndexBuffer | BufferUsage::ShaderResource) {}
+};
+
+// 环中的一段子范围（仅在分配它的帧内有效）
+struct UploadAllocation {
+    IBuffer* buffer = nullptr;     // 环形缓冲区
+    size_t offset = 0;             // 在缓冲区中的偏移
+    size_t size = 0;               // 请求大小
+    void* cpuAddress = nullptr;    // 持久映射的写入地址
+
+    // 以该子范围为视图范围的BufferViewDesc
+    BufferViewDesc GetViewDesc(size_t stride = 0) const {
+        return BufferViewDesc{offset, size, stride};
+    }
+
+    // 作为ICommandBuffer::SetDescriptorSet动态偏移使用（视图须从缓冲区起始处开始）
+    uint32_t GetDynamicOffset() const {
+        return static_cast<uint32_t>(offset);
+    }
+};
+
+// 上传环统计
+struct UploadRingStats {
+    uint64_t allocations = 0;      // 累计分配次数
+    uint64_t bytesAllocated = 0;   // 累计分配字节数（不含对齐填充）
+    uint64_t wraps = 0;            // 回绕到缓冲区起始处的次数
+    uint64_t fenceStalls = 0;      // BeginFrame时GPU尚未完成、需要阻塞等待的次数
+    uint64_t failures = 0;         // 空间不足导致的分配失败次数
+    size_t peakUsed = 0;           // 在途数据的峰值（字节，含填充）
+};
+
+// 每帧线性上传环
+// 在一个持久映射的MemoryType::Upload缓冲区上按帧线性分配对齐的子范围，用于逐次绘制的常量与临时顶点数据，
+// 取代每个对象一个缓冲区、每次UpdateData都映射/复制/解除映射的做法。
+// 每个帧槽位记录本帧写到的位置与提交发出的栅栏值或时间线信号量值；BeginFrame轮转到framesInFlight帧之前
+// 使用过的槽位，等待这些值（GPU落后时阻塞），然后把该帧及更早的数据一起回收。
+// Allocate不分配堆内存，也不调用后端；缓冲区在创建时持久映射，上传内存是HostCoherent的，写入无需刷新。
+// 绑定方式：GetViewDesc()创建覆盖子范围的视图，或者在缓冲区起始处创建一次常量缓冲区视图，
+// 以DescriptorType::UniformBufferDynamic写入描述符集，再用GetDynamicOffset()作为动态偏移。
+// 非线程安全：多个录制线程各自使用一个UploadRing（与FrameCommandAllocator的每线程命令池相同）。
+class UploadRing {
+public:
+    UploadRing(IDevice* device, const UploadRingDesc& desc = UploadRingDesc())
+        : m_device(device), m_desc(desc) {}
+
+    UploadRing(const UploadRing&) = delete;
+    UploadRing& operator=(const UploadRing&) = delete;
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_device != nullptr, ErrorCode::InvalidArgument, "上传环形缓冲区的设备不能为空");
+        RHI_VALIDATE(m_desc.size > 0 && m_desc.framesInFlight > 0,
+            ErrorCode::InvalidArgument, "size与framesInFlight必须大于0");
+        RHI_VALIDATE(m_desc.alignment > 0 && (m_desc.alignment & (m_desc.alignment - 1)) == 0,
+            ErrorCode::InvalidArgument,
+            "对齐要求必须为2的幂: " + std::to_string(m_desc.alignment));
+
+        BufferDesc bufferDesc;
+        bufferDesc.type = BufferType::Constant;
+        bufferDesc.usage = m_desc.usage;
+        bufferDesc.memoryType = MemoryType::Upload;
+        bufferDesc.size = m_desc.size;
+        bufferDesc.allowCPUAccess = true;
+        bufferDesc.tag = MemoryTag("UploadRing");
+        auto buffer = m_device->CreateBuffer(bufferDesc);
+        RHI_RETURN_IF_FAILED(buffer);
+        m_buffer.reset(buffer.GetValue());
+        m_mapped = static_cast<uint8_t*>(m_buffer->GetMappedData());
+        RHI_RETURN_IF_FALSE(m_mapped != nullptr, ErrorCode::ResourceMapFailed, "上传缓冲区不可被CPU访问");
+        m_slots.resize(m_desc.framesInFlight);
+        return MakeSuccessResult();
+    }
+
+    // 开始新的一帧：等待该槽位上一轮的提交完成，然后回收该帧之前写入的数据
+    Result<void> BeginFrame() {
+        RHI_VALIDATE(m_buffer != nullptr, ErrorCode::InvalidOperation, "上传环形缓冲区尚未初始化");
+        if (m_frameCount > 0) {
+            GetCurrentSlot().end = m_head;
+        }
+        ++m_frameCount;
+        FrameSlot& slot = GetCurrentSlot();
+        for (const SyncPoint& syncPoint : slot.syncPoints) {
+            auto completed = syncPoint.fence != nullptr ? syncPoint.fence->GetValue() : syncPoint.semaphore->GetValue();
+            RHI_RETURN_IF_FAILED(completed);
+            if (completed.GetValue() < syncPoint.value) {
+                ++m_stats.fenceStalls;
+                RHI_RETURN_IF_FAILED(syncPoint.fence != nullptr ?
+                    syncPoint.fence->Wait(syncPoint.value, UINT64_MAX) :
+                    syncPoint.semaphore->Wait(syncPoint.value, UINT64_MAX));
+            }
+        }
+        slot.syncPoints.clear();
+        // 槽位按帧顺序轮转，更早的帧已在之前回收
+        m_tail = std::max(m_tail, slot.end);
+        slot.end = m_head;
+        return MakeSuccessResult();
+    }
+
+    // 分配size字节的子范围；alignment为0时使用desc.alignment
+    // 环中放不下时返回OutOfMemory（说明desc.size不足以容纳framesInFlight帧的数据）
+    Result<UploadAllocation> Allocate(size_t size, size_t alignment = 0) {
+        alignment = alignment != 0 ? alignment : m_desc.alignment;
+        RHI_VALIDATE(size > 0, ErrorCode::InvalidArgument, "分配大小必须大于0");
+        RHI_VALIDATE((alignment & (alignment - 1)) == 0,
+            ErrorCode::InvalidArgument,
+            "对齐要求必须为2的幂: " + std::to_string(alignment));
+        RHI_VALIDATE(m_frameCount > 0, ErrorCode::InvalidOperation, "Allocate必须在BeginFrame之后调用");
+
+        // m_head与m_tail是单调递增的逻辑位置，对缓冲区大小取模得到偏移
+        size_t capacity = m_desc.size;
+        size_t offset = m_head % capacity;
+        size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+        uint64_t head = m_head + (aligned - offset);
+        if (aligned + size > capacity) {
+            // 尾部放不下：跳过剩余部分，从缓冲区起始处开始
+            head = m_head + (capacity - offset);
+            aligned = 0;
+        }
+        if (head + size - m_tail > capacity) {
+            ++m_stats.failures;
+            return Result<UploadAllocation>(ErrorInfo{ErrorCode::OutOfMemory, "上传环空间不足"});
+        }
+        // 起点与上一次分配的末字节不在同一轮时记为一次回绕
+        m_stats.wraps += m_head != 0 && head / capacity != (m_head - 1) / capacity ? 1 : 0;
+        m_head = head + size;
+        ++m_stats.allocations;
+        m_stats.bytesAllocated += size;
+        m_stats.peakUsed = std::max(m_stats.peakUsed, static_cast<size_t>(m_head - m_tail));
+
+        UploadAllocation allocation;
+        allocation.buffer = m_buffer.get();
+        allocation.offset = aligned;
+        allocation.size = size;
+        allocation.cpuAddress = m_mapped + aligned;
+        return MakeSuccessResult(allocation);
+    }
+
+    // 分配并复制数据
+    Result<UploadAllocation> Upload(const void* data, size_t size, size_t alignment = 0) {
+        auto allocation = Allocate(size, alignment);
+        RHI_RETURN_IF_FAILED(allocation);
+        std::memcpy(allocation.GetValue().cpuAddress, data, size);
+        return allocation;
+    }
+
+    // 记录当前帧的一次提交；BeginFrame回收该帧数据前会等待fence到达value
+    void TrackSubmission(IFence* fence, uint64_t value) {
+        TrackSyncPoint(fence, nullptr, value);
+    }
+
+    // 记录当前帧的一次提交；BeginFrame回收该帧数据前会等待时间线信号量到达value
+    void TrackSubmission(ISemaphore* semaphore, uint64_t value) {
+        TrackSyncPoint(nullptr, semaphore, value);
+    }
+
+    IBuffer* GetBuffer() const { return m_buffer.get(); }
+
+    // 在途数据（含对齐与回绕填充）的字节数
+    size_t GetUsedSize() const {
+        return static_cast<size_t>(m_head - m_tail);
+    }
+
+    uint64_t GetFrameCount() const { return m_frameCount; }
+
+    UploadRingStats GetStats() const {
+        return m_stats;
+    }
+
+private:
+    // 栅栏或时间线信号量上的一个值
+    struct SyncPoint {
+        IFence* fence;
+        ISemaphore* semaphore;
+        uint64_t value;
+    };
+
+    struct FrameSlot {
+        std::vector<SyncPoint> syncPoints;   // 本槽位的提交发出的值
+        uint64_t end = 0;                    // 本槽位的帧写到的逻辑位置
+    };
+
+    void TrackSyncPoint(IFence* fence, ISemaphore* semaphore, uint64_t value) {
+        std::vector<SyncPoint>& syncPoints = GetCurrentSlot().syncPoints;
+        for (SyncPoint& syncPoint : syncPoints) {
+            if (syncPoint.fence == fence && syncPoint.semaphore == semaphore) {
+                syncPoint.value = std::max(syncPoint.value, value);
+                return;
+            }
+        }
+        syncPoints.push_back({fence, semaphore, value});
+    }
+
+    FrameSlot& GetCurrentSlot() {
+        return m_slots[(m_frameCount - 1) % m_slots.size()];
+    }
+
+    IDevice* m_device;
+    UploadRingDesc m_desc;
+    std::unique_ptr<IBuffer> m_buffer;
+    uint8_t* m_mapped = nullptr;
+    std::vector<FrameSlot> m_slots;
+    uint64_t m_head = 0;
+    uint64_t m_tail = 0;
+    uint64_t m_frameCount = 0;
+    UploadRingStats m_stats;
+};
+
+} // namespace RHI
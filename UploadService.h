@@ -0,0 +1,482 @@
+#pragma once
+#include "Buffer.h"
+#include "CommandBuffer.h"
+#include "CommandPool.h"
+#include "Device.h"
+#include "ErrorUtil.h"
+#include "Synchronization.h"
+#include "Texture.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace RHI {
+
+constexpr size_t kUploadBufferAlignment = 16;      // 缓冲区上传在暂存缓冲区中的对齐
+
+// 上传服务描述
+struct UploadServiceDesc {
+    size_t stagingBufferSize;      // 每个批次的暂存缓冲区大小（更大的单次上传使用专用暂存缓冲区）
+    size_t maxBytesInFlight;       // 已提交但GPU尚未完成的暂存字节数上限（超出时阻塞等待最早的批次）
+    QueueType dstQueue;            // 使用上传结果的队列（与传输队列不同时转移队列所有权）
+
+    UploadServiceDesc() :
+        stagingBufferSize(4ull * 1024 * 1024),
+        maxBytesInFlight(64ull * 1024 * 1024),
+        dstQueue(QueueType::Graphics) {}
+};
+
+// 上传服务统计
+struct UploadServiceStats {
+    uint64_t uploads = 0;              // 上传次数
+    uint64_t bytesUploaded = 0;        // 上传的数据字节数（不含对齐填充）
+    uint64_t batches = 0;              // 提交到传输队列的批次数
+    uint64_t copyCommands = 0;         // 录制的CopyBuffer/CopyBufferToTexture命令数
+    uint64_t throttleWaits = 0;        // 在途字节数超出上限、阻塞等待GPU的次数
+    uint64_t stagingBuffersCreated = 0;    // 创建的暂存缓冲区数（热身后只有专用暂存缓冲区会增加）
+    size_t bytesInFlight = 0;          // 当前在途的暂存字节数
+    size_t peakBytesInFlight = 0;      // 在途暂存字节数的峰值
+};
+
+// 异步暂存上传服务
+// 把CPU数据写入持久映射的MemoryType::Upload暂存缓冲区，累积成批次后在QueueType::Transfer队列上一次提交：
+// - 批次内每个目标缓冲区一条CopyBuffer、每个目标纹理一条CopyBufferToTexture，区域数不限
+// - 每个批次使用一个暂存缓冲区，写满时自动提交；超过stagingBufferSize的单次上传使用专用暂存缓冲区
+// - 每次上传返回完成令牌：其所在批次在服务的时间线信号量上发出的值；IsComplete/Wait在CPU端查询或等待，
+//   使用方的提交等待GetTimeline()到达该值即可在GPU端排序（时间线信号量允许等待尚未提交的值）
+// - 已提交、尚未完成的批次占用的暂存字节数超出maxBytesInFlight时，开始新批次前阻塞等待最早的批次，
+//   完成的批次回收暂存缓冲区与命令池
+// 目标在复制前从Undefined转换为CopyDest（纹理只转换上传的子资源），因此用于新建资源的初始数据；
+// 复制后转换到finalState。传输队列与dstQueue不同时，该转换作为释放屏障录制，使用方须在dstQueue上
+// 通过RecordAcquireBarriers录制对应的获取屏障。
+// 非线程安全：由一个加载线程使用。
+class UploadService {
+public:
+    UploadService(IDevice* device, const UploadServiceDesc& desc = UploadServiceDesc())
+        : m_device(device), m_desc(desc) {}
+
+    UploadService(const UploadService&) = delete;
+    UploadService& operator=(const UploadService&) = delete;
+
+    // 等待已提交的批次完成后才释放暂存缓冲区
+    ~UploadService() {
+        if (m_timeline && m_submittedValue > 0) {
+            (void)m_timeline->Wait(m_submittedValue, UINT64_MAX);
+        }
+    }
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_device != nullptr, ErrorCode::InvalidArgument, "上传服务的设备为空，无法初始化");
+        RHI_VALIDATE(m_desc.stagingBufferSize > 0 && m_desc.maxBytesInFlight > 0,
+            ErrorCode::InvalidArgument, "stagingBufferSize与maxBytesInFlight必须大于0");
+        auto transfer = m_device->GetQueue(QueueType::Transfer, 0);
+        RHI_RETURN_IF_FAILED(transfer);
+        auto consumer = m_device->GetQueue(m_desc.dstQueue, 0);
+        RHI_RETURN_IF_FAILED(consumer);
+        m_queue = transfer.GetValue();
+        m_ownershipTransfer = transfer.GetValue() != consumer.GetValue();
+
+        SemaphoreDesc semaphoreDesc;
+        semaphoreDesc.binary = false;
+        auto timeline = m_device->CreateSemaphore(semaphoreDesc);
+        RHI_RETURN_IF_FAILED(timeline);
+        m_timeline.reset(timeline.GetValue());
+        return MakeSuccessResult();
+    }
+
+    // 上传size字节到dst的dstOffset处，复制后转换到finalState；返回完成令牌
+    Result<uint64_t> UploadBuffer(
+        IBuffer* dst,
+        size_t dstOffset,
+        const void* data,
+        size_t size,
+        ResourceState finalState = ResourceState::ShaderResource) {
+        RHI_VALIDATE(dst != nullptr && (data != nullptr || size == 0), ErrorCode::InvalidArgument, "上传的目标与数据不能为空");
+        RHI_VALIDATE(dstOffset + size <= dst->GetDesc().size,
+            ErrorCode::InvalidArgument,
+            "上传范围越界: " + std::to_string(dstOffset) + "+" + std::to_string(size) +
+            " > " + std::to_string(dst->GetDesc().size));
+        RHI_VALIDATE((dst->GetDesc().usage & BufferUsage::TransferDst) != BufferUsage::None,
+            ErrorCode::InvalidArgument, "目标缓冲区未声明TransferDst用途");
+        if (size == 0) {
+            return MakeSuccessResult(m_submittedValue);
+        }
+
+        auto offset = Reserve(size, kUploadBufferAlignment);
+        RHI_RETURN_IF_FAILED(offset);
+        std::memcpy(m_current->data + offset.GetValue(), data, size);
+        m_bufferCopies.push_back(PendingBufferCopy{dst, BufferCopyRegion{offset.GetValue(), dstOffset, size}});
+        AddTransition(dst, BarrierResourceType::Buffer, 0, 0, finalState);
+        ++m_stats.uploads;
+        m_stats.bytesUploaded += size;
+        return MakeSuccessResult(m_submittedValue + 1);
+    }
+
+    // 上传dst的一个完整子资源，data的行间距为rowPitch（0表示紧密排列），深度切片紧接排列；返回完成令牌
+    Result<uint64_t> UploadTexture(
+        ITexture* dst,
+        uint32_t mipLevel,
+        uint32_t arrayLayer,
+        const void* data,
+        size_t rowPitch = 0,
+        ResourceState finalState = ResourceState::ShaderResource) {
+        RHI_VALIDATE(dst != nullptr && data != nullptr, ErrorCode::InvalidArgument, "上传的目标与数据不能为空");
+        const TextureDesc& desc = dst->GetDesc();
+        // 子资源决定复制写入的位置，发布版同样检查
+        RHI_RETURN_IF_FALSE(mipLevel < desc.mipLevels, ErrorCode::InvalidArgument, "mip级别越界");
+        RHI_RETURN_IF_FALSE(arrayLayer < GetTextureLayerCount(desc), ErrorCode::InvalidArgument,
+            "数组层越界: " + std::to_string(arrayLayer));
+        RHI_VALIDATE((desc.usage & TextureUsage::TransferDst) != TextureUsage::None,
+            ErrorCode::InvalidArgument, "目标纹理未声明TransferDst用途");
+
+        uint32_t block = GetFormatBlockDimension(desc.format);
+        size_t blockSize = GetFormatBlockSize(desc.format);
+        uint32_t width = std::max(desc.width >> mipLevel, 1u);
+        uint32_t height = std::max(desc.height >> mipLevel, 1u);
+        uint32_t depth = std::max(desc.depth >> mipLevel, 1u);
+        uint32_t rows = (height + block - 1) / block;
+        size_t rowBytes = (width + block - 1) / block * blockSize;
+        size_t srcPitch = rowPitch != 0 ? rowPitch : rowBytes;
+        RHI_VALIDATE(srcPitch >= rowBytes, ErrorCode::InvalidArgument, "行间距小于一行数据的大小");
+
+        // 暂存数据的偏移与行间距按可移植的要求对齐，并且是texel块大小的整数倍
+        size_t pitchAlignment = std::lcm(kTextureUploadPitchAlignment, blockSize);
+        size_t stagingPitch = (rowBytes + pitchAlignment - 1) / pitchAlignment * pitchAlignment;
+        size_t size = stagingPitch * rows * depth;
+        auto offset = Reserve(size, std::lcm(kTextureUploadOffsetAlignment, blockSize));
+        RHI_RETURN_IF_FAILED(offset);
+        const uint8_t* src = static_cast<const uint8_t*>(data);
+        uint8_t* staging = m_current->data + offset.GetValue();
+        for (uint32_t row = 0; row < rows * depth; ++row) {
+            std::memcpy(staging + row * stagingPitch, src + row * srcPitch, rowBytes);
+        }
+
+        BufferTextureCopyRegion region = {};
+        region.bufferOffset = offset.GetValue();
+        region.bufferRowPitch = stagingPitch;
+        region.bufferSlicePitch = stagingPitch * rows;
+        region.mipLevel = mipLevel;
+        region.arrayLayer = arrayLayer;
+        region.extent[0] = width;
+        region.extent[1] = height;
+        region.extent[2] = depth;
+        m_textureCopies.push_back(PendingTextureCopy{dst, region});
+        AddTransition(dst, BarrierResourceType::Texture, mipLevel, arrayLayer, finalState);
+        ++m_stats.uploads;
+        m_stats.bytesUploaded += rowBytes * rows * depth;
+        return MakeSuccessResult(m_submittedValue + 1);
+    }
+
+    // 提交当前批次（为空时不提交）；返回此前所有上传的完成令牌
+    Result<uint64_t> Flush() {
+        if (m_current == nullptr || m_current->used == 0) {
+            return MakeSuccessResult(m_submittedValue);
+        }
+        Batch& batch = *m_current;
+        ICommandBuffer* commandBuffer = batch.commandBuffer;
+        RHI_RETURN_IF_FAILED(commandBuffer->Begin());
+
+        // 复制前：目标转换为CopyDest（内容可丢弃）
+        BuildBarriers(ResourceState::Undefined, false);
+        RHI_RETURN_IF_FAILED(commandBuffer->ResourceBarrier(
+            static_cast<uint32_t>(m_barriers.size()), m_barriers.data()));
+
+        // 同一目标的区域合并为一条复制命令
+        std::stable_sort(m_bufferCopies.begin(), m_bufferCopies.end(),
+            [](const PendingBufferCopy& a, const PendingBufferCopy& b) { return std::less<IBuffer*>()(a.dst, b.dst); });
+        for (size_t first = 0; first < m_bufferCopies.size();) {
+            size_t last = first;
+            m_bufferRegions.clear();
+            while (last < m_bufferCopies.size() && m_bufferCopies[last].dst == m_bufferCopies[first].dst) {
+                m_bufferRegions.push_back(m_bufferCopies[last++].region);
+            }
+            RHI_RETURN_IF_FAILED(commandBuffer->CopyBuffer(batch.staging.get(), m_bufferCopies[first].dst,
+                static_cast<uint32_t>(m_bufferRegions.size()), m_bufferRegions.data()));
+            ++m_stats.copyCommands;
+            first = last;
+        }
+        std::stable_sort(m_textureCopies.begin(), m_textureCopies.end(),
+            [](const PendingTextureCopy& a, const PendingTextureCopy& b) { return std::less<ITexture*>()(a.dst, b.dst); });
+        for (size_t first = 0; first < m_textureCopies.size();) {
+            size_t last = first;
+            m_textureRegions.clear();
+            while (last < m_textureCopies.size() && m_textureCopies[last].dst == m_textureCopies[first].dst) {
+                m_textureRegions.push_back(m_textureCopies[last++].region);
+            }
+            RHI_RETURN_IF_FAILED(commandBuffer->CopyBufferToTexture(batch.staging.get(), m_textureCopies[first].dst,
+                static_cast<uint32_t>(m_textureRegions.size()), m_textureRegions.data()));
+            ++m_stats.copyCommands;
+            first = last;
+        }
+
+        // 复制后：转换到finalState（队列不同时为释放屏障）
+        BuildBarriers(ResourceState::CopyDest, m_ownershipTransfer);
+        RHI_RETURN_IF_FAILED(commandBuffer->ResourceBarrier(
+            static_cast<uint32_t>(m_barriers.size()), m_barriers.data()));
+        RHI_RETURN_IF_FAILED(commandBuffer->End());
+
+        uint64_t value = m_submittedValue + 1;
+        ICommandBuffer* commandBuffers[] = {commandBuffer};
+        SemaphoreSignalInfo signal(m_timeline.get(), value);
+        SubmitDesc submit;
+        submit.commandBuffers = commandBuffers;
+        submit.signalSemaphores = Span<const SemaphoreSignalInfo>(&signal, 1);
+        RHI_RETURN_IF_FAILED(m_queue->SubmitBatch(Span<const SubmitDesc>(&submit, 1), nullptr));
+        m_submittedValue = value;
+        ++m_stats.batches;
+
+        if (m_ownershipTransfer) {
+            for (const Transition& transition : m_transitions) {
+                m_acquires.push_back(Acquire{transition, value});
+            }
+        }
+        m_bufferCopies.clear();
+        m_textureCopies.clear();
+        m_transitions.clear();
+        batch.value = value;
+        m_inFlight.push_back(std::move(m_current));
+        return MakeSuccessResult(value);
+    }
+
+    // 令牌对应的上传是否已在GPU上完成
+    bool IsComplete(uint64_t token) const {
+        if (token > m_submittedValue) {
+            return false;
+        }
+        auto value = m_timeline->GetValue();
+        return value.IsSuccess() && value.GetValue() >= token;
+    }
+
+    // CPU等待令牌对应的上传完成（令牌所在批次尚未提交时先提交）
+    Result<void> Wait(uint64_t token) {
+        if (token > m_submittedValue) {
+            RHI_RETURN_IF_FAILED(Flush());
+        }
+        RHI_RETURN_IF_FAILED(m_timeline->Wait(token, UINT64_MAX));
+        Retire();
+        return MakeSuccessResult();
+    }
+
+    // 在dstQueue的命令缓冲区中录制已提交批次的获取屏障，返回该命令缓冲区的提交须等待的时间线值
+    // （SemaphoreWaitInfo{GetTimeline(), value}，为0时无需等待）。传输队列与dstQueue相同时不录制屏障。
+    Result<uint64_t> RecordAcquireBarriers(ICommandBuffer* commandBuffer) {
+        RHI_VALIDATE(commandBuffer != nullptr, ErrorCode::InvalidArgument, "命令缓冲区不能为空");
+        uint64_t value = m_acquiredValue < m_submittedValue ? m_submittedValue : 0;
+        m_acquiredValue = m_submittedValue;
+        if (m_acquires.empty()) {
+            return MakeSuccessResult(value);
+        }
+        m_barriers.clear();
+        m_ranges.clear();
+        m_ranges.reserve(m_acquires.size());
+        for (const Acquire& acquire : m_acquires) {
+            AppendBarrier(acquire.transition, ResourceState::CopyDest, true);
+        }
+        m_acquires.clear();
+        RHI_RETURN_IF_FAILED(commandBuffer->ResourceBarrier(
+            static_cast<uint32_t>(m_barriers.size()), m_barriers.data()));
+        return MakeSuccessResult(value);
+    }
+
+    // 时间线信号量（使用方的提交等待令牌值）
+    ISemaphore* GetTimeline() const { return m_timeline.get(); }
+
+    // 最近提交的批次发出的值
+    uint64_t GetSubmittedValue() const { return m_submittedValue; }
+
+    // 是否在两个队列之间转移所有权（设备没有独立的传输队列时为false）
+    bool HasOwnershipTransfer() const { return m_ownershipTransfer; }
+
+    const UploadServiceStats& GetStats() const { return m_stats; }
+
+private:
+    struct Batch {
+        std::unique_ptr<IBuffer> staging;
+        uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t used = 0;
+        std::unique_ptr<ICommandPool> pool;
+        ICommandBuffer* commandBuffer = nullptr;
+        uint64_t value = 0;
+    };
+
+    struct PendingBufferCopy {
+        IBuffer* dst;
+        BufferCopyRegion region;
+    };
+
+    struct PendingTextureCopy {
+        ITexture* dst;
+        BufferTextureCopyRegion region;
+    };
+
+    // 批次内一个目标（缓冲区或纹理的一个子资源）的状态转换
+    struct Transition {
+        void* resource;
+        BarrierResourceType type;
+        uint32_t mipLevel;
+        uint32_t arrayLayer;
+        ResourceState finalState;
+    };
+
+    struct Acquire {
+        Transition transition;
+        uint64_t value;
+    };
+
+    // 在当前批次的暂存缓冲区中分配size字节；空间不足时提交当前批次并开始新批次
+    Result<size_t> Reserve(size_t size, size_t alignment) {
+        if (m_current != nullptr) {
+            size_t offset = (m_current->used + alignment - 1) / alignment * alignment;
+            if (offset + size <= m_current->size) {
+                m_current->used = offset + size;
+                return MakeSuccessResult(offset);
+            }
+            RHI_RETURN_IF_FAILED(Flush());
+            if (m_current != nullptr) {
+                // 空批次的暂存缓冲区放不下专用大小的上传：直接回收
+                m_stats.bytesInFlight -= m_current->size;
+                if (m_current->size == m_desc.stagingBufferSize) {
+                    m_free.push_back(std::move(m_current));
+                }
+                m_current.reset();
+            }
+        }
+        RHI_RETURN_IF_FAILED(BeginBatch(std::max(size, m_desc.stagingBufferSize)));
+        m_current->used = size;
+        return MakeSuccessResult(static_cast<size_t>(0));
+    }
+
+    // 开始新批次：在途字节数超出上限时等待最早的批次，优先复用已完成批次的暂存缓冲区与命令池
+    Result<void> BeginBatch(size_t stagingSize) {
+        Retire();
+        while (!m_inFlight.empty() && m_stats.bytesInFlight + stagingSize > m_desc.maxBytesInFlight) {
+            ++m_stats.throttleWaits;
+            RHI_RETURN_IF_FAILED(m_timeline->Wait(m_inFlight.front()->value, UINT64_MAX));
+            Retire();
+        }
+
+        if (!m_free.empty() && stagingSize == m_desc.stagingBufferSize) {
+            m_current = std::move(m_free.back());
+            m_free.pop_back();
+            RHI_RETURN_IF_FAILED(m_current->pool->Reset());
+        } else {
+            auto batch = std::make_unique<Batch>();
+            BufferDesc stagingDesc;
+            stagingDesc.type = BufferType::Staging;
+            stagingDesc.usage = BufferUsage::TransferSrc;
+            stagingDesc.memoryType = MemoryType::Upload;
+            stagingDesc.size = stagingSize;
+            stagingDesc.allowCPUAccess = true;
+            stagingDesc.tag = MemoryTag("UploadService");
+            auto staging = m_device->CreateBuffer(stagingDesc);
+            RHI_RETURN_IF_FAILED(staging);
+            batch->staging.reset(staging.GetValue());
+            batch->data = static_cast<uint8_t*>(batch->staging->GetMappedData());
+            RHI_RETURN_IF_FALSE(batch->data != nullptr, ErrorCode::ResourceMapFailed, "暂存缓冲区不可被CPU访问");
+            batch->size = stagingSize;
+
+            auto pool = m_device->CreateCommandPool(QueueType::Transfer, true);
+            RHI_RETURN_IF_FAILED(pool);
+            batch->pool.reset(pool.GetValue());
+            CommandBufferAllocateInfo allocateInfo;
+            allocateInfo.level = CommandBufferType::Transfer;
+            auto commandBuffers = batch->pool->AllocateCommandBuffers(allocateInfo);
+            RHI_RETURN_IF_FAILED(commandBuffers);
+            batch->commandBuffer = commandBuffers.GetValue()[0];
+            m_current = std::move(batch);
+            ++m_stats.stagingBuffersCreated;
+        }
+        m_current->used = 0;
+        m_stats.bytesInFlight += m_current->size;
+        m_stats.peakBytesInFlight = std::max(m_stats.peakBytesInFlight, m_stats.bytesInFlight);
+        return MakeSuccessResult();
+    }
+
+    // 回收GPU已完成的批次（专用暂存缓冲区直接释放）
+    void Retire() {
+        if (m_inFlight.empty()) {
+            return;
+        }
+        auto current = m_timeline->GetValue();
+        if (!current.IsSuccess()) {
+            return;
+        }
+        size_t count = 0;
+        while (count < m_inFlight.size() && m_inFlight[count]->value <= current.GetValue()) {
+            std::unique_ptr<Batch>& batch = m_inFlight[count++];
+            m_stats.bytesInFlight -= batch->size;
+            if (batch->size == m_desc.stagingBufferSize) {
+                m_free.push_back(std::move(batch));
+            }
+        }
+        m_inFlight.erase(m_inFlight.begin(), m_inFlight.begin() + count);
+    }
+
+    // 同一目标在批次内只转换一次（以最后一次上传的finalState为准）
+    void AddTransition(void* resource, BarrierResourceType type, uint32_t mipLevel, uint32_t arrayLayer,
+                       ResourceState finalState) {
+        for (auto it = m_transitions.rbegin(); it != m_transitions.rend(); ++it) {
+            if (it->resource == resource && it->mipLevel == mipLevel && it->arrayLayer == arrayLayer) {
+                it->finalState = finalState;
+                return;
+            }
+        }
+        m_transitions.push_back(Transition{resource, type, mipLevel, arrayLayer, finalState});
+    }
+
+    // stateBefore为Undefined时转换到CopyDest，为CopyDest时转换到finalState；
+    // handoff为true时是传输队列到dstQueue的所有权转移。纹理屏障只作用于上传的子资源（m_ranges须已预留容量）
+    void AppendBarrier(const Transition& transition, ResourceState stateBefore, bool handoff) {
+        BarrierDesc barrier = {};
+        barrier.type = BarrierType::Transition;
+        barrier.resource = transition.resource;
+        barrier.resourceType = transition.type;
+        barrier.stateBefore = stateBefore;
+        barrier.stateAfter = stateBefore == ResourceState::Undefined ? ResourceState::CopyDest : transition.finalState;
+        barrier.srcQueue = handoff ? QueueType::Transfer : m_desc.dstQueue;
+        barrier.dstQueue = m_desc.dstQueue;
+        if (transition.type == BarrierResourceType::Texture) {
+            TextureSubresourceRange range;
+            range.baseMipLevel = transition.mipLevel;
+            range.baseArrayLayer = transition.arrayLayer;
+            m_ranges.push_back(range);
+            barrier.range = &m_ranges.back();
+        }
+        m_barriers.push_back(barrier);
+    }
+
+    void BuildBarriers(ResourceState stateBefore, bool handoff) {
+        m_barriers.clear();
+        m_ranges.clear();
+        m_ranges.reserve(m_transitions.size());
+        for (const Transition& transition : m_transitions) {
+            AppendBarrier(transition, stateBefore, handoff);
+        }
+    }
+
+    IDevice* m_device;
+    UploadServiceDesc m_desc;
+    IQueue* m_queue = nullptr;
+    bool m_ownershipTransfer = false;
+    std::unique_ptr<ISemaphore> m_timeline;
+    uint64_t m_submittedValue = 0;
+    uint64_t m_acquiredValue = 0;
+    std::unique_ptr<Batch> m_current;
+    std::vector<std::unique_ptr<Batch>> m_inFlight;    // 按提交顺序
+    std::vector<std::unique_ptr<Batch>> m_free;
+    std::vector<PendingBufferCopy> m_bufferCopies;
+    std::vector<PendingTextureCopy> m_textureCopies;
+    std::vector<Transition> m_transitions;
+    std::vector<Acquire> m_acquires;
+    std::vector<BufferCopyRegion> m_bufferRegions;
+    std::vector<BufferTextureCopyRegion> m_textureRegions;
+    std::vector<BarrierDesc> m_barriers;
+    std::vector<TextureSubresourceRange> m_ranges;
+    UploadServiceStats m_stats;
+};
+
+} // namespace RHI
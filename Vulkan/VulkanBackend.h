@@ -0,0 +1,1295 @@
+#pragma once
+#include "VulkanCommandBuffer.h"
+#include "VulkanSync.h"
+#include "Device.h"
+#include "SwapChain.h"
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Vulkan后端
+// 需要Vulkan 1.3（动态渲染、时间线信号量）。所有对象遵循与其他后端相同的所有权规则：
+// Create*返回的对象由调用者释放，队列由设备拥有，命令缓冲区与描述符集由各自的池拥有，视图由资源拥有。
+
+namespace RHI {
+
+// Vulkan实例（由适配器与设备共享，最后一个引用释放时销毁）
+class VulkanInstance {
+public:
+    VulkanInstance() = default;
+
+    ~VulkanInstance() {
+        if (m_instance != VK_NULL_HANDLE) {
+            vkDestroyInstance(m_instance, nullptr);
+        }
+    }
+
+    VulkanInstance(const VulkanInstance&) = delete;
+    VulkanInstance& operator=(const VulkanInstance&) = delete;
+
+    // 创建实例，启用所有可用的表面扩展；enableValidation为true时尝试启用验证层
+    Result<void> Initialize(bool enableValidation) {
+        uint32_t extensionCount = 0;
+        RHI_VK_RETURN_IF_FAILED(vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr));
+        std::vector<VkExtensionProperties> available(extensionCount);
+        RHI_VK_RETURN_IF_FAILED(vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, available.data()));
+
+        std::vector<const char*> extensions;
+        bool portability = false;
+        for (const VkExtensionProperties& extension : available) {
+            std::string name = extension.extensionName;
+            if (name.size() >= 7 && name.compare(name.size() - 7, 7, "surface") == 0) {
+                extensions.push_back(extension.extensionName);
+            } else if (name == "VK_KHR_portability_enumeration") {
+                extensions.push_back(extension.extensionName);
+                portability = true;
+            }
+        }
+
+        std::vector<const char*> layers;
+        if (enableValidation) {
+            uint32_t layerCount = 0;
+            RHI_VK_RETURN_IF_FAILED(vkEnumerateInstanceLayerProperties(&layerCount, nullptr));
+            std::vector<VkLayerProperties> availableLayers(layerCount);
+            RHI_VK_RETURN_IF_FAILED(vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data()));
+            for (const VkLayerProperties& layer : availableLayers) {
+                if (std::strcmp(layer.layerName, "VK_LAYER_KHRONOS_validation") == 0) {
+                    layers.push_back("VK_LAYER_KHRONOS_validation");
+                }
+            }
+        }
+
+        VkApplicationInfo applicationInfo = {};
+        applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        applicationInfo.pEngineName = "RHI";
+        applicationInfo.apiVersion = kVulkanApiVersion;
+
+        VkInstanceCreateInfo instanceInfo = {};
+        instanceInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        instanceInfo.flags = portability ? VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR : 0;
+        instanceInfo.pApplicationInfo = &applicationInfo;
+        instanceInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        instanceInfo.ppEnabledExtensionNames = extensions.data();
+        instanceInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
+        instanceInfo.ppEnabledLayerNames = layers.data();
+        RHI_VK_RETURN_IF_FAILED(vkCreateInstance(&instanceInfo, nullptr, &m_instance));
+        return MakeSuccessResult();
+    }
+
+    VkInstance GetVkInstance() const { return m_instance; }
+
+private:
+    VkInstance m_instance = VK_NULL_HANDLE;
+};
+
+// Vulkan交换链
+// 需要调用者创建的VkSurfaceKHR（由调用者在交换链销毁后释放）。
+// 下一张图像在初始化与每次呈现后以栅栏同步获取，因此提交无需等待获取信号量。
+class VulkanSwapChain : public ISwapChain {
+public:
+    VulkanSwapChain(VulkanContext& context, VkSurfaceKHR surface, VkQueue presentQueue, std::mutex& queueMutex)
+        : m_context(context)
+        , m_surface(surface)
+        , m_presentQueue(presentQueue)
+        , m_queueMutex(queueMutex) {}
+
+    ~VulkanSwapChain() override {
+        (void)Cleanup();
+        if (m_acquireFence != VK_NULL_HANDLE) {
+            vkDestroyFence(m_context.GetDevice(), m_acquireFence, nullptr);
+        }
+    }
+
+    Result<void> Initialize(const SwapChainDesc& desc) override {
+        RHI_VALIDATE(desc.width > 0 && desc.height > 0,
+            ErrorCode::InvalidArgument,
+            "交换链尺寸必须大于0");
+        RHI_VALIDATE(desc.bufferCount > 0,
+            ErrorCode::InvalidBufferCount,
+            "缓冲数量必须大于0");
+        m_desc = desc;
+        if (m_acquireFence == VK_NULL_HANDLE) {
+            VkFenceCreateInfo fenceInfo = {};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            RHI_VK_RETURN_IF_FAILED(vkCreateFence(m_context.GetDevice(), &fenceInfo, nullptr, &m_acquireFence));
+        }
+        return CreateSwapChain();
+    }
+
+    Result<void> Cleanup() override {
+        m_backBuffers.clear();
+        if (m_swapChain != VK_NULL_HANDLE) {
+            vkDestroySwapchainKHR(m_context.GetDevice(), m_swapChain, nullptr);
+            m_swapChain = VK_NULL_HANDLE;
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> Resize(uint32_t width, uint32_t height) override {
+        RHI_VALIDATE(width > 0 && height > 0,
+            ErrorCode::InvalidArgument,
+            "交换链尺寸必须大于0");
+        RHI_VK_RETURN_IF_FAILED(vkDeviceWaitIdle(m_context.GetDevice()));
+        m_desc.width = width;
+        m_desc.height = height;
+        return CreateSwapChain();
+    }
+
+    Result<uint32_t> GetCurrentBackBufferIndex() const override {
+        return MakeSuccessResult(m_currentIndex);
+    }
+
+    Result<uint32_t> GetBufferCount() const override {
+        return MakeSuccessResult(static_cast<uint32_t>(m_backBuffers.size()));
+    }
+
+    const SwapChainDesc& GetDesc() const override { return m_desc; }
+
+    // 不等待信号量直接呈现（调用者须保证渲染已完成且图像处于PRESENT_SRC布局）
+    Result<void> Present(const PresentInfo& presentInfo) override {
+        RHI_VALIDATE(presentInfo.backBufferIndex == m_currentIndex,
+            ErrorCode::InvalidArgument,
+            "只能呈现当前后缓冲区: " + std::to_string(presentInfo.backBufferIndex));
+        return QueuePresent(m_presentQueue, nullptr, 0);
+    }
+
+    Result<void> WaitForPresent() override {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        RHI_VK_RETURN_IF_FAILED(vkQueueWaitIdle(m_presentQueue));
+        return MakeSuccessResult();
+    }
+
+    Result<bool> IsPresentModeSupported(PresentMode mode) const override {
+        uint32_t count = 0;
+        RHI_VK_RETURN_IF_FAILED(vkGetPhysicalDeviceSurfacePresentModesKHR(
+            m_context.GetPhysicalDevice(), m_surface, &count, nullptr));
+        std::vector<VkPresentModeKHR> modes(count);
+        RHI_VK_RETURN_IF_FAILED(vkGetPhysicalDeviceSurfacePresentModesKHR(
+            m_context.GetPhysicalDevice(), m_surface, &count, modes.data()));
+        VkPresentModeKHR wanted = ToVkPresentMode(mode);
+        return MakeSuccessResult(std::find(modes.begin(), modes.end(), wanted) != modes.end());
+    }
+
+    // 返回当前后缓冲区的ITexture*
+    Result<void*> GetCurrentBackBufferHandle() override {
+        RHI_RETURN_IF_FALSE(m_currentIndex < m_backBuffers.size(),
+            ErrorCode::InvalidOperation,
+            "交换链未初始化");
+        return MakeSuccessResult(static_cast<void*>(
+            static_cast<ITexture*>(m_backBuffers[m_currentIndex].get())));
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_swapChain));
+    }
+
+    // 在指定队列上呈现当前图像，随后获取下一张图像
+    Result<void> QueuePresent(VkQueue queue, const VkSemaphore* waitSemaphores, uint32_t waitCount) {
+        RHI_RETURN_IF_FALSE(m_swapChain != VK_NULL_HANDLE,
+            ErrorCode::InvalidOperation,
+            "交换链未初始化");
+        VkPresentInfoKHR presentInfo = {};
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = waitCount;
+        presentInfo.pWaitSemaphores = waitSemaphores;
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = &m_swapChain;
+        presentInfo.pImageIndices = &m_currentIndex;
+
+        VkResult result = VK_SUCCESS;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            result = vkQueuePresentKHR(queue, &presentInfo);
+        }
+        RHI_RETURN_IF_FALSE(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR,
+            result == VK_ERROR_OUT_OF_DATE_KHR ? ErrorCode::PresentFailed : GetVkErrorCode(result),
+            std::string("vkQueuePresentKHR失败: ") + GetVkResultName(result));
+        return AcquireNextImage();
+    }
+
+private:
+    static VkPresentModeKHR ToVkPresentMode(PresentMode mode) {
+        switch (mode) {
+            case PresentMode::Immediate: return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            case PresentMode::Mailbox: return VK_PRESENT_MODE_MAILBOX_KHR;
+            case PresentMode::FifoRelaxed: return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+            default: return VK_PRESENT_MODE_FIFO_KHR;
+        }
+    }
+
+    Result<void> CreateSwapChain() {
+        VkPhysicalDevice physicalDevice = m_context.GetPhysicalDevice();
+        VkSurfaceCapabilitiesKHR capabilities = {};
+        RHI_VK_RETURN_IF_FAILED(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, m_surface, &capabilities));
+
+        // 格式
+        VkFormat format = ToVkFormat(m_desc.format);
+        uint32_t formatCount = 0;
+        RHI_VK_RETURN_IF_FAILED(vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, m_surface, &formatCount, nullptr));
+        std::vector<VkSurfaceFormatKHR> formats(formatCount);
+        RHI_VK_RETURN_IF_FAILED(vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, m_surface, &formatCount, formats.data()));
+        auto surfaceFormat = std::find_if(formats.begin(), formats.end(),
+            [format](const VkSurfaceFormatKHR& candidate) { return candidate.format == format; });
+        RHI_RETURN_IF_FALSE(surfaceFormat != formats.end(),
+            ErrorCode::InvalidSurfaceFormat,
+            "表面不支持请求的交换链格式");
+
+        // 呈现模式（关闭垂直同步时优先IMMEDIATE）
+        PresentMode presentMode = m_desc.isVSync ? m_desc.presentMode : PresentMode::Immediate;
+        auto supported = IsPresentModeSupported(presentMode);
+        RHI_RETURN_IF_FAILED(supported);
+        RHI_RETURN_IF_FALSE(supported.GetValue(),
+            ErrorCode::InvalidPresentMode,
+            "表面不支持请求的呈现模式");
+
+        uint32_t imageCount = std::max(m_desc.bufferCount, capabilities.minImageCount);
+        if (capabilities.maxImageCount > 0) {
+            imageCount = std::min(imageCount, capabilities.maxImageCount);
+        }
+        VkExtent2D extent = capabilities.currentExtent;
+        if (extent.width == UINT32_MAX) {
+            extent.width = std::min(std::max(m_desc.width, capabilities.minImageExtent.width), capabilities.maxImageExtent.width);
+            extent.height = std::min(std::max(m_desc.height, capabilities.minImageExtent.height), capabilities.maxImageExtent.height);
+        }
+
+        VkSwapchainKHR oldSwapChain = m_swapChain;
+        VkSwapchainCreateInfoKHR swapChainInfo = {};
+        swapChainInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+        swapChainInfo.surface = m_surface;
+        swapChainInfo.minImageCount = imageCount;
+        swapChainInfo.imageFormat = surfaceFormat->format;
+        swapChainInfo.imageColorSpace = surfaceFormat->colorSpace;
+        swapChainInfo.imageExtent = extent;
+        swapChainInfo.imageArrayLayers = 1;
+        swapChainInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        swapChainInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        swapChainInfo.preTransform = capabilities.currentTransform;
+        swapChainInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+        swapChainInfo.presentMode = ToVkPresentMode(presentMode);
+        swapChainInfo.clipped = VK_TRUE;
+        swapChainInfo.oldSwapchain = oldSwapChain;
+
+        VkSwapchainKHR swapChain = VK_NULL_HANDLE;
+        RHI_VK_RETURN_IF_FAILED(vkCreateSwapchainKHR(m_context.GetDevice(), &swapChainInfo, nullptr, &swapChain));
+        RHI_RETURN_IF_FAILED(Cleanup());
+        m_swapChain = swapChain;
+
+        uint32_t count = 0;
+        RHI_VK_RETURN_IF_FAILED(vkGetSwapchainImagesKHR(m_context.GetDevice(), m_swapChain, &count, nullptr));
+        std::vector<VkImage> images(count);
+        RHI_VK_RETURN_IF_FAILED(vkGetSwapchainImagesKHR(m_context.GetDevice(), m_swapChain, &count, images.data()));
+
+        TextureDesc textureDesc;
+        textureDesc.format = m_desc.format;
+        textureDesc.width = extent.width;
+        textureDesc.height = extent.height;
+        textureDesc.usage = TextureUsage::RenderTarget | TextureUsage::TransferDst;
+        for (VkImage image : images) {
+            auto texture = std::make_unique<VulkanTexture>(m_context, textureDesc, image);
+            RHI_RETURN_IF_FAILED(texture->Initialize());
+            m_backBuffers.push_back(std::move(texture));
+        }
+        m_desc.width = extent.width;
+        m_desc.height = extent.height;
+        m_desc.bufferCount = count;
+        return AcquireNextImage();
+    }
+
+    Result<void> AcquireNextImage() {
+        VkDevice device = m_context.GetDevice();
+        VkResult result = vkAcquireNextImageKHR(device, m_swapChain, UINT64_MAX,
+            VK_NULL_HANDLE, m_acquireFence, &m_currentIndex);
+        RHI_RETURN_IF_FALSE(result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR,
+            result == VK_ERROR_OUT_OF_DATE_KHR ? ErrorCode::ResizeBuffersFailed : GetVkErrorCode(result),
+            std::string("vkAcquireNextImageKHR失败: ") + GetVkResultName(result));
+        RHI_VK_RETURN_IF_FAILED(vkWaitForFences(device, 1, &m_acquireFence, VK_TRUE, UINT64_MAX));
+        RHI_VK_RETURN_IF_FAILED(vkResetFences(device, 1, &m_acquireFence));
+        return MakeSuccessResult();
+    }
+
+    VulkanContext& m_context;
+    VkSurfaceKHR m_surface;
+    VkQueue m_presentQueue;
+    std::mutex& m_queueMutex;
+    VkSwapchainKHR m_swapChain = VK_NULL_HANDLE;
+    VkFence m_acquireFence = VK_NULL_HANDLE;
+    std::vector<std::unique_ptr<VulkanTexture>> m_backBuffers;
+    uint32_t m_currentIndex = 0;
+};
+
+// Vulkan队列
+// 提交时复用成员中的临时数组，稳定状态下不做堆分配
+class VulkanQueue : public IQueue {
+public:
+    VulkanQueue(const QueueDesc& desc, VkQueue queue)
+        : m_queue(queue) {
+        m_desc = desc;
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_queue));
+    }
+
+    // 等待信号量在所有阶段前等待；fence为VulkanFence时发出本队列的提交序号
+    // 提交序号与信号量、栅栏的值在vkQueueSubmit成功之后才更新
+    Result<void> Submit(
+        const std::vector<ICommandBuffer*>& commandBuffers,
+        const std::vector<ISemaphore*>& waitSemaphores,
+        const std::vector<ISemaphore*>& signalSemaphores,
+        IFence* fence) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_commandBuffers.clear();
+        for (ICommandBuffer* commandBuffer : commandBuffers) {
+            RHI_VALIDATE(commandBuffer != nullptr && !commandBuffer->GetDesc().isSecondary,
+                ErrorCode::InvalidArgument,
+                "只能提交一级命令缓冲区");
+            auto* vulkanCommandBuffer = static_cast<VulkanCommandBuffer*>(commandBuffer);
+            RHI_VALIDATE(vulkanCommandBuffer->GetState() == VulkanCommandBufferState::Executable,
+                ErrorCode::InvalidOperation,
+                "命令缓冲区未结束录制");
+            m_commandBuffers.push_back(vulkanCommandBuffer->GetVkCommandBuffer());
+        }
+
+        m_waitSemaphores.clear();
+        m_waitValues.clear();
+        m_waitStages.clear();
+        for (ISemaphore* semaphore : waitSemaphores) {
+            auto* vulkanSemaphore = static_cast<VulkanSemaphore*>(semaphore);
+            m_waitSemaphores.push_back(vulkanSemaphore->GetVkSemaphore());
+            m_waitValues.push_back(vulkanSemaphore->GetWaitValue());
+            m_waitStages.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+        }
+
+        m_signalSemaphores.clear();
+        m_signalValues.clear();
+        for (ISemaphore* semaphore : signalSemaphores) {
+            auto* vulkanSemaphore = static_cast<VulkanSemaphore*>(semaphore);
+            m_signalSemaphores.push_back(vulkanSemaphore->GetVkSemaphore());
+            m_signalValues.push_back(vulkanSemaphore->GetNextSignalValue());
+        }
+        auto* vulkanFence = static_cast<VulkanFence*>(fence);
+        if (vulkanFence != nullptr) {
+            m_signalSemaphores.push_back(vulkanFence->GetVkSemaphore());
+            m_signalValues.push_back(vulkanFence->GetSubmitValue(m_submitCount + 1));
+        }
+
+        VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(m_waitValues.size());
+        timelineInfo.pWaitSemaphoreValues = m_waitValues.data();
+        timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(m_signalValues.size());
+        timelineInfo.pSignalSemaphoreValues = m_signalValues.data();
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = static_cast<uint32_t>(m_waitSemaphores.size());
+        submitInfo.pWaitSemaphores = m_waitSemaphores.data();
+        submitInfo.pWaitDstStageMask = m_waitStages.data();
+        submitInfo.commandBufferCount = static_cast<uint32_t>(m_commandBuffers.size());
+        submitInfo.pCommandBuffers = m_commandBuffers.data();
+        submitInfo.signalSemaphoreCount = static_cast<uint32_t>(m_signalSemaphores.size());
+        submitInfo.pSignalSemaphores = m_signalSemaphores.data();
+        RHI_VK_RETURN_IF_FAILED(vkQueueSubmit(m_queue, 1, &submitInfo, VK_NULL_HANDLE));
+
+        ++m_submitCount;
+        for (size_t i = 0; i < signalSemaphores.size(); ++i) {
+            static_cast<VulkanSemaphore*>(signalSemaphores[i])->CommitSignalValue(m_signalValues[i]);
+        }
+        if (vulkanFence != nullptr) {
+            vulkanFence->CommitSubmitValue(m_signalValues.back());
+        }
+        return MakeSuccessResult();
+    }
+
+    // 先统计总数再一次性调整临时数组的大小，之后按偏移填写，保证各VkSubmitInfo引用的指针稳定；
+    // fence的时间线值附加在最后一次提交的信号中。
+    // 整批通过检查并且vkQueueSubmit成功之后才更新提交序号与信号量、栅栏的值，失败时不留下部分提交的状态
+    Result<void> SubmitBatch(
+        Span<const SubmitDesc> submits,
+        IFence* fence) override {
+        RHI_VALIDATE(!submits.empty(), ErrorCode::InvalidArgument, "批量提交不能为空");
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        size_t commandBufferCount = 0;
+        size_t waitCount = 0;
+        size_t signalCount = fence != nullptr ? 1 : 0;
+        for (const SubmitDesc& submit : submits) {
+            commandBufferCount += submit.commandBuffers.size();
+            waitCount += submit.waitSemaphores.size();
+            signalCount += submit.signalSemaphores.size();
+        }
+        m_commandBuffers.resize(commandBufferCount);
+        m_waitSemaphores.resize(waitCount);
+        m_waitValues.resize(waitCount);
+        m_waitStages.resize(waitCount);
+        m_signalSemaphores.resize(signalCount);
+        m_signalValues.resize(signalCount);
+        m_submitInfos.resize(submits.size());
+        m_timelineInfos.resize(submits.size());
+
+        size_t commandBufferIndex = 0;
+        size_t waitIndex = 0;
+        size_t signalIndex = 0;
+        for (size_t i = 0; i < submits.size(); ++i) {
+            const SubmitDesc& submit = submits[i];
+            size_t firstCommandBuffer = commandBufferIndex;
+            for (ICommandBuffer* commandBuffer : submit.commandBuffers) {
+                RHI_VALIDATE(commandBuffer != nullptr && !commandBuffer->GetDesc().isSecondary,
+                    ErrorCode::InvalidArgument,
+                    "只能提交一级命令缓冲区");
+                auto* vulkanCommandBuffer = static_cast<VulkanCommandBuffer*>(commandBuffer);
+                RHI_VALIDATE(vulkanCommandBuffer->GetState() == VulkanCommandBufferState::Executable,
+                    ErrorCode::InvalidOperation,
+                    "命令缓冲区未结束录制");
+                m_commandBuffers[commandBufferIndex++] = vulkanCommandBuffer->GetVkCommandBuffer();
+            }
+
+            size_t firstWait = waitIndex;
+            for (const SemaphoreWaitInfo& wait : submit.waitSemaphores) {
+                RHI_VALIDATE(wait.semaphore != nullptr, ErrorCode::InvalidArgument, "等待的信号量不能为空");
+                auto* vulkanSemaphore = static_cast<VulkanSemaphore*>(wait.semaphore);
+                m_waitSemaphores[waitIndex] = vulkanSemaphore->GetVkSemaphore();
+                m_waitValues[waitIndex] = vulkanSemaphore->IsBinary() ? 0 : wait.value;
+                m_waitStages[waitIndex] = ToVkPipelineStageFlags(wait.stages);
+                ++waitIndex;
+            }
+
+            size_t firstSignal = signalIndex;
+            for (const SemaphoreSignalInfo& signal : submit.signalSemaphores) {
+                RHI_VALIDATE(signal.semaphore != nullptr, ErrorCode::InvalidArgument, "发出的信号量不能为空");
+                auto* vulkanSemaphore = static_cast<VulkanSemaphore*>(signal.semaphore);
+                RHI_VALIDATE(vulkanSemaphore->IsBinary() ||
+                    signal.value > GetBatchSignalValue(vulkanSemaphore, signalIndex),
+                    ErrorCode::SyncError,
+                    "时间线信号量的值必须递增");
+                m_signalSemaphores[signalIndex] = vulkanSemaphore->GetVkSemaphore();
+                m_signalValues[signalIndex] = vulkanSemaphore->IsBinary() ? 0 : signal.value;
+                ++signalIndex;
+            }
+            if (fence != nullptr && i + 1 == submits.size()) {
+                auto* vulkanFence = static_cast<VulkanFence*>(fence);
+                m_signalSemaphores[signalIndex] = vulkanFence->GetVkSemaphore();
+                m_signalValues[signalIndex] = vulkanFence->GetSubmitValue(m_submitCount + submits.size());
+                ++signalIndex;
+            }
+
+            VkTimelineSemaphoreSubmitInfo& timelineInfo = m_timelineInfos[i];
+            timelineInfo = {};
+            timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfo.waitSemaphoreValueCount = static_cast<uint32_t>(waitIndex - firstWait);
+            timelineInfo.pWaitSemaphoreValues = m_waitValues.data() + firstWait;
+            timelineInfo.signalSemaphoreValueCount = static_cast<uint32_t>(signalIndex - firstSignal);
+            timelineInfo.pSignalSemaphoreValues = m_signalValues.data() + firstSignal;
+
+            VkSubmitInfo& submitInfo = m_submitInfos[i];
+            submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext = &timelineInfo;
+            submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitIndex - firstWait);
+            submitInfo.pWaitSemaphores = m_waitSemaphores.data() + firstWait;
+            submitInfo.pWaitDstStageMask = m_waitStages.data() + firstWait;
+            submitInfo.commandBufferCount = static_cast<uint32_t>(commandBufferIndex - firstCommandBuffer);
+            submitInfo.pCommandBuffers = m_commandBuffers.data() + firstCommandBuffer;
+            submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalIndex - firstSignal);
+            submitInfo.pSignalSemaphores = m_signalSemaphores.data() + firstSignal;
+        }
+        RHI_VK_RETURN_IF_FAILED(vkQueueSubmit(m_queue, static_cast<uint32_t>(m_submitInfos.size()),
+            m_submitInfos.data(), VK_NULL_HANDLE));
+
+        m_submitCount += submits.size();
+        signalIndex = 0;
+        for (const SubmitDesc& submit : submits) {
+            for (const SemaphoreSignalInfo& signal : submit.signalSemaphores) {
+                static_cast<VulkanSemaphore*>(signal.semaphore)->CommitSignalValue(m_signalValues[signalIndex++]);
+            }
+        }
+        if (fence != nullptr) {
+            static_cast<VulkanFence*>(fence)->CommitSubmitValue(m_signalValues[signalIndex]);
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> WaitIdle() override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        RHI_VK_RETURN_IF_FAILED(vkQueueWaitIdle(m_queue));
+        return MakeSuccessResult();
+    }
+
+    // 等待信号量须为二进制信号量
+    Result<void> Present(
+        ISwapChain* swapChain,
+        uint32_t imageIndex,
+        const std::vector<ISemaphore*>& waitSemaphores) override {
+        RHI_VALIDATE(swapChain != nullptr, ErrorCode::InvalidArgument, "交换链不能为空");
+        auto* vulkanSwapChain = static_cast<VulkanSwapChain*>(swapChain);
+        auto currentIndex = vulkanSwapChain->GetCurrentBackBufferIndex();
+        RHI_VALIDATE(currentIndex.GetValue() == imageIndex,
+            ErrorCode::InvalidArgument,
+            "只能呈现当前后缓冲区: " + std::to_string(imageIndex));
+
+        // 等待数决定栈上数组的写入范围，发布版同样检查
+        RHI_RETURN_IF_FALSE(waitSemaphores.size() <= kVulkanMaxPresentWaitSemaphores,
+            ErrorCode::InvalidArgument,
+            "呈现等待的信号量过多");
+        VkSemaphore semaphores[kVulkanMaxPresentWaitSemaphores];
+        uint32_t waitCount = 0;
+        for (ISemaphore* semaphore : waitSemaphores) {
+            auto* vulkanSemaphore = static_cast<VulkanSemaphore*>(semaphore);
+            RHI_VALIDATE(vulkanSemaphore->IsBinary(),
+                ErrorCode::InvalidArgument,
+                "呈现只能等待二进制信号量");
+            semaphores[waitCount++] = vulkanSemaphore->GetVkSemaphore();
+        }
+        return vulkanSwapChain->QueuePresent(m_queue, semaphores, waitCount);
+    }
+
+    std::mutex& GetMutex() { return m_mutex; }
+    VkQueue GetVkQueue() const { return m_queue; }
+    uint32_t GetQueueFamilyIndex() const { return m_desc.queueFamilyIndex; }
+
+private:
+    // 信号量在本批次前signalCount个信号之后的值（尚未提交的值也计入）
+    uint64_t GetBatchSignalValue(const VulkanSemaphore* semaphore, size_t signalCount) const {
+        uint64_t value = semaphore->GetWaitValue();
+        for (size_t i = 0; i < signalCount; ++i) {
+            if (m_signalSemaphores[i] == semaphore->GetVkSemaphore()) {
+                value = std::max(value, m_signalValues[i]);
+            }
+        }
+        return value;
+    }
+
+    VkQueue m_queue;
+    std::mutex m_mutex;
+    uint64_t m_submitCount = 0;
+    std::vector<VkCommandBuffer> m_commandBuffers;
+    std::vector<VkSemaphore> m_waitSemaphores;
+    std::vector<uint64_t> m_waitValues;
+    std::vector<VkPipelineStageFlags> m_waitStages;
+    std::vector<VkSemaphore> m_signalSemaphores;
+    std::vector<uint64_t> m_signalValues;
+    std::vector<VkSubmitInfo> m_submitInfos;
+    std::vector<VkTimelineSemaphoreSubmitInfo> m_timelineInfos;
+};
+
+// Vulkan设备
+// 图形/呈现共用一个通用队列族；计算与传输优先使用专用队列族，没有时回退到通用队列族（共享同一个队列）。
+class VulkanDevice : public IDevice {
+public:
+    VulkanDevice(std::shared_ptr<VulkanInstance> instance, VkPhysicalDevice physicalDevice, const DeviceDesc& desc)
+        : m_instance(std::move(instance))
+        , m_physicalDevice(physicalDevice) {
+        m_desc = desc;
+    }
+
+    ~VulkanDevice() override {
+        if (m_device != VK_NULL_HANDLE) {
+            vkDeviceWaitIdle(m_device);
+            m_context.reset();
+            m_queues.clear();
+            vkDestroyDevice(m_device, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        VkPhysicalDeviceProperties properties = {};
+        vkGetPhysicalDeviceProperties(m_physicalDevice, &properties);
+        RHI_RETURN_IF_FALSE(properties.apiVersion >= kVulkanApiVersion,
+            ErrorCode::DeviceNotCompatible,
+            "Vulkan后端需要Vulkan 1.3");
+        m_bufferImageGranularity = properties.limits.bufferImageGranularity;
+
+        RHI_RETURN_IF_FAILED(SelectQueueFamilies());
+
+        // 队列
+        float priority = 1.0f;
+        uint32_t families[] = {m_graphicsFamily, m_computeFamily, m_transferFamily};
+        std::vector<uint32_t> uniqueFamilies;
+        std::vector<VkDeviceQueueCreateInfo> queueInfos;
+        for (uint32_t family : families) {
+            if (std::find(uniqueFamilies.begin(), uniqueFamilies.end(), family) != uniqueFamilies.end()) {
+                continue;
+            }
+            uniqueFamilies.push_back(family);
+            VkDeviceQueueCreateInfo queueInfo = {};
+            queueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueInfo.queueFamilyIndex = family;
+            queueInfo.queueCount = 1;
+            queueInfo.pQueuePriorities = &priority;
+            queueInfos.push_back(queueInfo);
+        }
+
+        // 扩展：请求的扩展加上可用时的交换链扩展
+        uint32_t extensionCount = 0;
+        RHI_VK_RETURN_IF_FAILED(vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &extensionCount, nullptr));
+        std::vector<VkExtensionProperties> available(extensionCount);
+        RHI_VK_RETURN_IF_FAILED(vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &extensionCount, available.data()));
+        auto isAvailable = [&available](const char* name) {
+            return std::any_of(available.begin(), available.end(),
+                [name](const VkExtensionProperties& extension) { return std::strcmp(extension.extensionName, name) == 0; });
+        };
+        std::vector<const char*> extensions;
+        for (const std::string& extension : m_desc.extensions) {
+            RHI_RETURN_IF_FALSE(isAvailable(extension.c_str()),
+                ErrorCode::DeviceNotCompatible,
+                "设备不支持扩展: " + extension);
+            extensions.push_back(extension.c_str());
+        }
+        if (isAvailable(VK_KHR_SWAPCHAIN_EXTENSION_NAME)) {
+            extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
+        // 内存预算扩展：GetMemoryBudget报告操作系统给出的预算与占用
+        m_memoryBudgetSupported = isAvailable(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        if (m_memoryBudgetSupported &&
+            std::find(m_desc.extensions.begin(), m_desc.extensions.end(),
+                VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == m_desc.extensions.end()) {
+            extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        }
+        if (isAvailable("VK_KHR_portability_subset")) {
+            extensions.push_back("VK_KHR_portability_subset");
+        }
+
+        // 特性：请求的核心特性与设备支持的特性取交集
+        VkPhysicalDeviceFeatures supported = {};
+        vkGetPhysicalDeviceFeatures(m_physicalDevice, &supported);
+        const DeviceFeatures& requested = m_desc.enabledFeatures;
+        VkPhysicalDeviceFeatures2 features = {};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        VkPhysicalDeviceFeatures& core = features.features;
+        core.robustBufferAccess = requested.robustBufferAccess ? supported.robustBufferAccess : VK_FALSE;
+        core.fullDrawIndexUint32 = requested.fullDrawIndexUint32 ? supported.fullDrawIndexUint32 : VK_FALSE;
+        core.imageCubeArray = requested.imageCubeArray ? supported.imageCubeArray : VK_FALSE;
+        core.independentBlend = requested.independentBlend ? supported.independentBlend : VK_FALSE;
+        core.geometryShader = requested.geometryShader ? supported.geometryShader : VK_FALSE;
+        core.tessellationShader = requested.tessellationShader ? supported.tessellationShader : VK_FALSE;
+        core.sampleRateShading = requested.sampleRateShading ? supported.sampleRateShading : VK_FALSE;
+        core.dualSrcBlend = requested.dualSrcBlend ? supported.dualSrcBlend : VK_FALSE;
+        core.logicOp = requested.logicOp ? supported.logicOp : VK_FALSE;
+        core.multiDrawIndirect = requested.multiDrawIndirect ? supported.multiDrawIndirect : VK_FALSE;
+        core.drawIndirectFirstInstance = requested.drawIndirectFirstInstance ? supported.drawIndirectFirstInstance : VK_FALSE;
+        core.depthClamp = requested.depthClamp ? supported.depthClamp : VK_FALSE;
+        core.depthBiasClamp = requested.depthBiasClamp ? supported.depthBiasClamp : VK_FALSE;
+        core.fillModeNonSolid = requested.fillModeNonSolid ? supported.fillModeNonSolid : VK_FALSE;
+        core.depthBounds = requested.depthBounds ? supported.depthBounds : VK_FALSE;
+        core.wideLines = requested.wideLines ? supported.wideLines : VK_FALSE;
+        core.largePoints = requested.largePoints ? supported.largePoints : VK_FALSE;
+        core.multiViewport = requested.multiViewport ? supported.multiViewport : VK_FALSE;
+        core.samplerAnisotropy = requested.samplerAnisotropy ? supported.samplerAnisotropy : VK_FALSE;
+        core.textureCompressionBC = requested.textureCompressionBC ? supported.textureCompressionBC : VK_FALSE;
+        core.textureCompressionETC2 = requested.textureCompressionETC2 ? supported.textureCompressionETC2 : VK_FALSE;
+        core.textureCompressionASTC_LDR = requested.textureCompressionASTC_LDR ? supported.textureCompressionASTC_LDR : VK_FALSE;
+        core.vertexPipelineStoresAndAtomics = requested.vertexPipelineStoresAndAtomics ? supported.vertexPipelineStoresAndAtomics : VK_FALSE;
+        core.fragmentStoresAndAtomics = requested.fragmentStoresAndAtomics ? supported.fragmentStoresAndAtomics : VK_FALSE;
+
+        VkPhysicalDeviceVulkan12Features features12 = {};
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features12.timelineSemaphore = VK_TRUE;
+        VkPhysicalDeviceVulkan13Features features13 = {};
+        features13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        features13.dynamicRendering = VK_TRUE;
+        features.pNext = &features12;
+        features12.pNext = &features13;
+
+        VkDeviceCreateInfo deviceInfo = {};
+        deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        deviceInfo.pNext = &features;
+        deviceInfo.queueCreateInfoCount = static_cast<uint32_t>(queueInfos.size());
+        deviceInfo.pQueueCreateInfos = queueInfos.data();
+        deviceInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+        deviceInfo.ppEnabledExtensionNames = extensions.data();
+        RHI_VK_RETURN_IF_FAILED(vkCreateDevice(m_physicalDevice, &deviceInfo, nullptr, &m_device));
+
+        // 每个队列族一个VulkanQueue，按QueueType映射
+        for (uint32_t family : uniqueFamilies) {
+            VkQueue queue = VK_NULL_HANDLE;
+            vkGetDeviceQueue(m_device, family, 0, &queue);
+            QueueDesc queueDesc = {};
+            queueDesc.type = family == m_graphicsFamily ? QueueType::Graphics
+                : family == m_computeFamily ? QueueType::Compute
+                : QueueType::Transfer;
+            queueDesc.queueFamilyIndex = family;
+            m_queues.push_back(std::make_unique<VulkanQueue>(queueDesc, queue));
+        }
+
+        VulkanQueue* graphicsQueue = FindQueue(m_graphicsFamily);
+        m_context = std::make_unique<VulkanContext>(
+            m_physicalDevice, m_device, m_graphicsFamily, graphicsQueue->GetVkQueue());
+        m_context->SetQueueMutex(&graphicsQueue->GetMutex());
+        m_context->SetQueueFamilies(m_graphicsFamily, m_computeFamily, m_transferFamily);
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_device));
+    }
+
+    Result<IQueue*> GetQueue(QueueType type, uint32_t index) override {
+        RHI_RETURN_IF_FALSE(index == 0,
+            ErrorCode::InvalidArgument,
+            "队列索引越界: " + std::to_string(index));
+        return MakeSuccessResult(static_cast<IQueue*>(FindQueue(GetQueueFamily(type))));
+    }
+
+    Result<ICommandPool*> CreateCommandPool(QueueType type, bool transient = false) override {
+        CommandPoolDesc desc;
+        desc.queueType = type;
+        desc.flags = transient ? CommandPoolFlag::Transient : CommandPoolFlag::None;
+        desc.queueFamilyIndex = GetQueueFamily(type);
+        return CreateObject<ICommandPool>(std::make_unique<VulkanCommandPool>(*m_context, desc));
+    }
+
+    Result<ISwapChain*> CreateSwapChain(const SwapChainDesc&) override {
+        return MakeErrorResult<ISwapChain*>(
+            ErrorCode::SwapChainCreateFailed,
+            "Vulkan交换链需要表面，请使用VulkanDevice::CreateSwapChainForSurface");
+    }
+
+    // 为调用者创建的表面创建交换链（表面须在交换链销毁后由调用者释放）
+    Result<ISwapChain*> CreateSwapChainForSurface(const SwapChainDesc& desc, VkSurfaceKHR surface) {
+        RHI_VALIDATE(surface != VK_NULL_HANDLE, ErrorCode::InvalidArgument, "表面不能为空");
+        VkBool32 supported = VK_FALSE;
+        RHI_VK_RETURN_IF_FAILED(vkGetPhysicalDeviceSurfaceSupportKHR(m_physicalDevice, m_graphicsFamily, surface, &supported));
+        RHI_RETURN_IF_FALSE(supported == VK_TRUE,
+            ErrorCode::SwapChainCreateFailed,
+            "图形队列族不支持在该表面上呈现");
+
+        VulkanQueue* queue = FindQueue(m_graphicsFamily);
+        auto swapChain = std::make_unique<VulkanSwapChain>(*m_context, surface, queue->GetVkQueue(), queue->GetMutex());
+        RHI_RETURN_IF_FAILED(swapChain->Initialize(desc));
+        return MakeSuccessResult(static_cast<ISwapChain*>(swapChain.release()));
+    }
+
+    Result<IBuffer*> CreateBuffer(const BufferDesc& desc) override {
+        auto buffer = std::make_unique<VulkanBuffer>(*m_context, desc);
+        RHI_RETURN_IF_FAILED(buffer->Initialize());
+        m_memoryTracker.Track(buffer->GetMemoryTracking(), MemoryAllocationKind::Buffer,
+            buffer.get(), buffer->GetMemoryRequirements().size, desc.memoryType, desc.tag);
+        return MakeSuccessResult(static_cast<IBuffer*>(buffer.release()));
+    }
+
+    Result<ITexture*> CreateTexture(const TextureDesc& desc) override {
+        auto texture = std::make_unique<VulkanTexture>(*m_context, desc);
+        RHI_RETURN_IF_FAILED(texture->Initialize());
+        // 延迟分配的瞬态附件不提交物理内存，不计入用量
+        m_memoryTracker.Track(texture->GetMemoryTracking(), MemoryAllocationKind::Texture, texture.get(),
+            texture->IsLazilyAllocated() ? 0 : texture->GetMemoryRequirements().size, MemoryType::Default, desc.tag);
+        return MakeSuccessResult(static_cast<ITexture*>(texture.release()));
+    }
+
+    // 跳过HostCoherent的缓冲区，每kVulkanFlushBatchSize个范围调用一次驱动
+    Result<void> FlushMappedRanges(Span<const MappedRange> ranges) override {
+        VkMappedMemoryRange batch[kVulkanFlushBatchSize];
+        uint32_t count = 0;
+        for (const MappedRange& range : ranges) {
+            RHI_VALIDATE(range.buffer != nullptr && range.buffer->GetMappedData() != nullptr,
+                ErrorCode::InvalidArgument,
+                "只能刷新持久映射的缓冲区");
+            RHI_VALIDATE(range.offset + range.size <= range.buffer->GetDesc().size,
+                ErrorCode::InvalidArgument,
+                "刷新范围越界");
+            if (range.buffer->IsHostCoherent() || range.size == 0) {
+                continue;
+            }
+            batch[count++] = static_cast<VulkanBuffer*>(range.buffer)->GetFlushRange(range.offset, range.size);
+            if (count == kVulkanFlushBatchSize) {
+                RHI_VK_RETURN_IF_FAILED(vkFlushMappedMemoryRanges(m_device, count, batch));
+                count = 0;
+            }
+        }
+        if (count > 0) {
+            RHI_VK_RETURN_IF_FAILED(vkFlushMappedMemoryRanges(m_device, count, batch));
+        }
+        return MakeSuccessResult();
+    }
+
+    // 创建不绑定内存的临时对象查询内存需求
+    Result<ResourceAllocationInfo> GetBufferAllocationInfo(const BufferDesc& desc) override {
+        VulkanBuffer probe(*m_context, desc);
+        RHI_RETURN_IF_FAILED(probe.CreateBuffer());
+        return MakeSuccessResult(GetPlacementInfo(probe.GetMemoryRequirements()));
+    }
+
+    Result<ResourceAllocationInfo> GetTextureAllocationInfo(const TextureDesc& desc) override {
+        VulkanTexture probe(*m_context, desc);
+        RHI_RETURN_IF_FAILED(probe.CreateImage());
+        return MakeSuccessResult(GetPlacementInfo(probe.GetMemoryRequirements()));
+    }
+
+    Result<IBuffer*> CreatePlacedBuffer(const BufferDesc& desc, IMemory* memory, size_t offset) override {
+        RHI_RETURN_IF_FALSE(memory != nullptr, ErrorCode::InvalidArgument, "内存块不能为空");
+        RHI_RETURN_IF_FALSE(memory->GetDesc().type == desc.memoryType,
+            ErrorCode::InvalidArgument,
+            "资源的内存类型与内存块不一致");
+        auto buffer = std::make_unique<VulkanBuffer>(*m_context, desc);
+        RHI_RETURN_IF_FAILED(buffer->Initialize(static_cast<VulkanMemory*>(memory), offset));
+        m_memoryTracker.Track(buffer->GetMemoryTracking(), MemoryAllocationKind::Buffer,
+            buffer.get(), buffer->GetMemoryRequirements().size, desc.memoryType, desc.tag, memory, offset);
+        return MakeSuccessResult(static_cast<IBuffer*>(buffer.release()));
+    }
+
+    Result<ITexture*> CreatePlacedTexture(const TextureDesc& desc, IMemory* memory, size_t offset) override {
+        RHI_RETURN_IF_FALSE(memory != nullptr, ErrorCode::InvalidArgument, "内存块不能为空");
+        RHI_RETURN_IF_FALSE(memory->GetDesc().type == MemoryType::Default,
+            ErrorCode::InvalidArgument,
+            "纹理只能放置在MemoryType::Default内存中");
+        auto texture = std::make_unique<VulkanTexture>(*m_context, desc);
+        RHI_RETURN_IF_FAILED(texture->Initialize(static_cast<VulkanMemory*>(memory), offset));
+        m_memoryTracker.Track(texture->GetMemoryTracking(), MemoryAllocationKind::Texture,
+            texture.get(), texture->GetMemoryRequirements().size, MemoryType::Default, desc.tag, memory, offset);
+        return MakeSuccessResult(static_cast<ITexture*>(texture.release()));
+    }
+
+    Result<IShader*> CreateShader(const ShaderDesc& desc) override {
+        return CreateObject<IShader>(std::make_unique<VulkanShader>(*m_context, desc));
+    }
+
+    Result<IPipelineState*> CreatePipelineState(const PipelineStateDesc& desc) override {
+        RHI_RETURN_IF_FALSE(IsValidPipelineStateDesc(desc), ErrorCode::InvalidArgument,
+            "管线描述必须是与type一致的GraphicsPipelineStateDesc或ComputePipelineStateDesc");
+        auto pipeline = std::make_unique<VulkanPipelineState>(*m_context, desc);
+        RHI_RETURN_IF_FAILED(pipeline->Initialize(desc));
+        return MakeSuccessResult(static_cast<IPipelineState*>(pipeline.release()));
+    }
+
+    Result<IDescriptorSetLayout*> CreateDescriptorSetLayout(const DescriptorSetLayoutDesc& desc) override {
+        return CreateObject<IDescriptorSetLayout>(std::make_unique<VulkanDescriptorSetLayout>(*m_context, desc));
+    }
+
+    Result<IDescriptorPool*> CreateDescriptorPool(const DescriptorPoolDesc& desc) override {
+        return CreateObject<IDescriptorPool>(std::make_unique<VulkanDescriptorPool>(*m_context, desc));
+    }
+
+    Result<IFence*> CreateFence(const FenceDesc& desc) override {
+        return CreateObject<IFence>(std::make_unique<VulkanFence>(*m_context, desc));
+    }
+
+    Result<ISemaphore*> CreateSemaphore(const SemaphoreDesc& desc) override {
+        return CreateObject<ISemaphore>(std::make_unique<VulkanSemaphore>(*m_context, desc));
+    }
+
+    Result<IEvent*> CreateEvent(const EventDesc& desc) override {
+        return CreateObject<IEvent>(std::make_unique<VulkanEvent>(*m_context, desc));
+    }
+
+    Result<IMemory*> AllocateMemory(const MemoryDesc& desc) override {
+        auto memory = std::make_unique<VulkanMemory>(*m_context, desc);
+        RHI_RETURN_IF_FAILED(memory->Initialize());
+        m_memoryTracker.Track(memory->GetMemoryTracking(), MemoryAllocationKind::Memory,
+            memory.get(), desc.size, desc.type, desc.tag);
+        return MakeSuccessResult(static_cast<IMemory*>(memory.release()));
+    }
+
+    // 累加所有DEVICE_LOCAL堆；不支持VK_EXT_memory_budget时以堆大小为预算、占用为0
+    bool SupportsLazilyAllocatedMemory() const override {
+        const VkPhysicalDeviceMemoryProperties& properties = m_context->GetMemoryProperties();
+        for (uint32_t i = 0; i < properties.memoryTypeCount; ++i) {
+            if (properties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Result<MemoryBudget> GetMemoryBudget() override {
+        const VkPhysicalDeviceMemoryProperties& properties = m_context->GetMemoryProperties();
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT heapBudget = {};
+        heapBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        if (m_memoryBudgetSupported) {
+            VkPhysicalDeviceMemoryProperties2 properties2 = {};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+            properties2.pNext = &heapBudget;
+            vkGetPhysicalDeviceMemoryProperties2(m_physicalDevice, &properties2);
+        }
+
+        MemoryBudget budget = {};
+        for (uint32_t i = 0; i < properties.memoryHeapCount; ++i) {
+            if (properties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                budget.budget += m_memoryBudgetSupported ? heapBudget.heapBudget[i] : properties.memoryHeaps[i].size;
+                budget.usage += m_memoryBudgetSupported ? heapBudget.heapUsage[i] : 0;
+            }
+        }
+        return MakeSuccessResult(budget);
+    }
+
+    MemoryTracker& GetMemoryTracker() override { return m_memoryTracker; }
+
+    // 一次最多等待kVulkanMaxHostWaitSemaphores个信号量
+    Result<void> WaitMultiple(
+        Span<const SemaphoreWaitInfo> waits,
+        SemaphoreWaitMode mode,
+        uint64_t timeout) override {
+        // 等待数决定栈上数组的写入范围，发布版同样检查
+        RHI_RETURN_IF_FALSE(waits.size() <= kVulkanMaxHostWaitSemaphores,
+            ErrorCode::InvalidArgument,
+            "等待的信号量过多: " + std::to_string(waits.size()));
+        if (waits.empty()) {
+            return MakeSuccessResult();
+        }
+        VkSemaphore semaphores[kVulkanMaxHostWaitSemaphores];
+        uint64_t values[kVulkanMaxHostWaitSemaphores];
+        for (size_t i = 0; i < waits.size(); ++i) {
+            RHI_VALIDATE(waits[i].semaphore != nullptr && !waits[i].semaphore->IsBinary(),
+                ErrorCode::InvalidArgument, "只能等待时间线信号量");
+            semaphores[i] = static_cast<VulkanSemaphore*>(waits[i].semaphore)->GetVkSemaphore();
+            values[i] = waits[i].value;
+        }
+        VkSemaphoreWaitInfo waitInfo = {};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.flags = mode == SemaphoreWaitMode::Any ? VK_SEMAPHORE_WAIT_ANY_BIT : 0;
+        waitInfo.semaphoreCount = static_cast<uint32_t>(waits.size());
+        waitInfo.pSemaphores = semaphores;
+        waitInfo.pValues = values;
+        VkResult result = vkWaitSemaphores(m_device, &waitInfo, timeout);
+        RHI_RETURN_IF_FALSE(result != VK_TIMEOUT, ErrorCode::TimeoutError, "等待信号量超时");
+        RHI_VK_RETURN_IF_FAILED(result);
+        return MakeSuccessResult();
+    }
+
+    Result<void> WaitIdle() override {
+        RHI_VK_RETURN_IF_FAILED(vkDeviceWaitIdle(m_device));
+        return MakeSuccessResult();
+    }
+
+    VulkanContext& GetContext() { return *m_context; }
+    VkInstance GetVkInstance() const { return m_instance->GetVkInstance(); }
+
+private:
+    // 两阶段创建：初始化失败时对象在此销毁
+    template<typename Interface, typename Object>
+    static Result<Interface*> CreateObject(std::unique_ptr<Object> object) {
+        RHI_RETURN_IF_FAILED(object->Initialize());
+        return MakeSuccessResult(static_cast<Interface*>(object.release()));
+    }
+
+    // 大小与对齐向上取整到bufferImageGranularity，线性与最优平铺的资源可以任意混放在同一内存块中
+    ResourceAllocationInfo GetPlacementInfo(const VkMemoryRequirements& requirements) const {
+        VkDeviceSize alignment = std::max(requirements.alignment, m_bufferImageGranularity);
+        VkDeviceSize size = (requirements.size + alignment - 1) / alignment * alignment;
+        return ResourceAllocationInfo{static_cast<size_t>(size), static_cast<size_t>(alignment)};
+    }
+
+    Result<void> SelectQueueFamilies() {
+        uint32_t count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &count, nullptr);
+        std::vector<VkQueueFamilyProperties> families(count);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &count, families.data());
+
+        const uint32_t none = UINT32_MAX;
+        m_graphicsFamily = none;
+        m_computeFamily = none;
+        m_transferFamily = none;
+        for (uint32_t i = 0; i < count; ++i) {
+            VkQueueFlags flags = families[i].queueFlags;
+            bool graphics = (flags & VK_QUEUE_GRAPHICS_BIT) != 0;
+            bool compute = (flags & VK_QUEUE_COMPUTE_BIT) != 0;
+            if (graphics && compute && m_graphicsFamily == none) {
+                m_graphicsFamily = i;
+            } else if (!graphics && compute && m_computeFamily == none) {
+                m_computeFamily = i;
+            } else if (!graphics && !compute && (flags & VK_QUEUE_TRANSFER_BIT) != 0 && m_transferFamily == none) {
+                m_transferFamily = i;
+            }
+        }
+        RHI_RETURN_IF_FALSE(m_graphicsFamily != none,
+            ErrorCode::DeviceNotCompatible,
+            "设备没有同时支持图形与计算的队列族");
+        if (m_computeFamily == none) {
+            m_computeFamily = m_graphicsFamily;
+        }
+        if (m_transferFamily == none) {
+            m_transferFamily = m_computeFamily;
+        }
+        return MakeSuccessResult();
+    }
+
+    uint32_t GetQueueFamily(QueueType type) const {
+        switch (type) {
+            case QueueType::Compute: return m_computeFamily;
+            case QueueType::Transfer: return m_transferFamily;
+            default: return m_graphicsFamily;
+        }
+    }
+
+    VulkanQueue* FindQueue(uint32_t family) const {
+        for (const auto& queue : m_queues) {
+            if (queue->GetQueueFamilyIndex() == family) {
+                return queue.get();
+            }
+        }
+        return nullptr;
+    }
+
+    MemoryTracker m_memoryTracker;              // 最先声明、最后析构：报告设备销毁时仍存活的分配
+    std::shared_ptr<VulkanInstance> m_instance;
+    VkPhysicalDevice m_physicalDevice;
+    VkDevice m_device = VK_NULL_HANDLE;
+    uint32_t m_graphicsFamily = 0;
+    uint32_t m_computeFamily = 0;
+    uint32_t m_transferFamily = 0;
+    bool m_memoryBudgetSupported = false;
+    VkDeviceSize m_bufferImageGranularity = 1;
+    std::vector<std::unique_ptr<VulkanQueue>> m_queues;
+    std::unique_ptr<VulkanContext> m_context;
+};
+
+// Vulkan适配器
+class VulkanAdapter : public IAdapter {
+public:
+    VulkanAdapter(std::shared_ptr<VulkanInstance> instance, VkPhysicalDevice physicalDevice)
+        : m_instance(std::move(instance))
+        , m_physicalDevice(physicalDevice) {
+        VkPhysicalDeviceProperties properties = {};
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        VkPhysicalDeviceMemoryProperties memory = {};
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memory);
+        VkPhysicalDeviceFeatures features = {};
+        vkGetPhysicalDeviceFeatures(physicalDevice, &features);
+
+        m_info = {};
+        m_info.name = properties.deviceName;
+        m_info.vendor = GetVendorName(properties.vendorID);
+        m_info.vendorId = properties.vendorID;
+        m_info.deviceId = properties.deviceID;
+        switch (properties.deviceType) {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: m_info.type = AdapterType::Discrete; break;
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: m_info.type = AdapterType::Integrated; break;
+            case VK_PHYSICAL_DEVICE_TYPE_CPU: m_info.type = AdapterType::CPU; break;
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: m_info.type = AdapterType::Software; break;
+            default: m_info.type = AdapterType::Unknown; break;
+        }
+        for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+            if (memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                m_info.dedicatedVideoMemory += memory.memoryHeaps[i].size;
+            } else {
+                m_info.sharedSystemMemory += memory.memoryHeaps[i].size;
+            }
+        }
+
+        const VkPhysicalDeviceLimits& vkLimits = properties.limits;
+        DeviceLimits& limits = m_info.limits;
+        limits.maxImageDimension1D = vkLimits.maxImageDimension1D;
+        limits.maxImageDimension2D = vkLimits.maxImageDimension2D;
+        limits.maxImageDimension3D = vkLimits.maxImageDimension3D;
+        limits.maxImageDimensionCube = vkLimits.maxImageDimensionCube;
+        limits.maxImageArrayLayers = vkLimits.maxImageArrayLayers;
+        limits.maxTexelBufferElements = vkLimits.maxTexelBufferElements;
+        limits.maxUniformBufferRange = vkLimits.maxUniformBufferRange;
+        limits.maxStorageBufferRange = vkLimits.maxStorageBufferRange;
+        // 后端的推送常量范围固定为kVulkanPushConstantSize
+        limits.maxPushConstantsSize = std::min(vkLimits.maxPushConstantsSize, kVulkanPushConstantSize);
+        limits.minUniformBufferOffsetAlignment = static_cast<uint32_t>(vkLimits.minUniformBufferOffsetAlignment);
+        limits.minStorageBufferOffsetAlignment = static_cast<uint32_t>(vkLimits.minStorageBufferOffsetAlignment);
+        limits.maxMemoryAllocationCount = vkLimits.maxMemoryAllocationCount;
+        limits.maxSamplerAllocationCount = vkLimits.maxSamplerAllocationCount;
+        limits.maxBoundDescriptorSets = std::min(vkLimits.maxBoundDescriptorSets, kVulkanMaxDescriptorSets);
+        limits.maxPerStageDescriptorSamplers = vkLimits.maxPerStageDescriptorSamplers;
+        limits.maxPerStageDescriptorUniformBuffers = vkLimits.maxPerStageDescriptorUniformBuffers;
+        limits.maxPerStageDescriptorStorageBuffers = vkLimits.maxPerStageDescriptorStorageBuffers;
+        limits.maxPerStageDescriptorSampledImages = vkLimits.maxPerStageDescriptorSampledImages;
+        limits.maxPerStageDescriptorStorageImages = vkLimits.maxPerStageDescriptorStorageImages;
+        limits.maxPerStageResources = vkLimits.maxPerStageResources;
+        limits.maxDescriptorSetSamplers = vkLimits.maxDescriptorSetSamplers;
+        limits.maxDescriptorSetUniformBuffers = vkLimits.maxDescriptorSetUniformBuffers;
+        limits.maxDescriptorSetStorageBuffers = vkLimits.maxDescriptorSetStorageBuffers;
+        limits.maxDescriptorSetSampledImages = vkLimits.maxDescriptorSetSampledImages;
+        limits.maxDescriptorSetStorageImages = vkLimits.maxDescriptorSetStorageImages;
+        limits.maxGeometryShaderInvocations = vkLimits.maxGeometryShaderInvocations;
+        limits.maxGeometryInputComponents = vkLimits.maxGeometryInputComponents;
+        limits.maxGeometryOutputComponents = vkLimits.maxGeometryOutputComponents;
+        limits.maxGeometryOutputVertices = vkLimits.maxGeometryOutputVertices;
+        limits.maxGeometryTotalOutputComponents = vkLimits.maxGeometryTotalOutputComponents;
+        limits.maxFragmentInputComponents = vkLimits.maxFragmentInputComponents;
+        limits.maxFragmentOutputAttachments = vkLimits.maxFragmentOutputAttachments;
+        limits.maxComputeSharedMemorySize = vkLimits.maxComputeSharedMemorySize;
+        limits.maxComputeWorkGroupInvocations = vkLimits.maxComputeWorkGroupInvocations;
+        for (uint32_t i = 0; i < 3; ++i) {
+            limits.maxComputeWorkGroupCount[i] = vkLimits.maxComputeWorkGroupCount[i];
+            limits.maxComputeWorkGroupSize[i] = vkLimits.maxComputeWorkGroupSize[i];
+        }
+        limits.maxViewports = vkLimits.maxViewports;
+        limits.maxViewportDimensions[0] = vkLimits.maxViewportDimensions[0];
+        limits.maxViewportDimensions[1] = vkLimits.maxViewportDimensions[1];
+
+        DeviceFeatures& supported = m_info.features;
+        supported.robustBufferAccess = features.robustBufferAccess == VK_TRUE;
+        supported.fullDrawIndexUint32 = features.fullDrawIndexUint32 == VK_TRUE;
+        supported.imageCubeArray = features.imageCubeArray == VK_TRUE;
+        supported.independentBlend = features.independentBlend == VK_TRUE;
+        supported.geometryShader = features.geometryShader == VK_TRUE;
+        supported.tessellationShader = features.tessellationShader == VK_TRUE;
+        supported.sampleRateShading = features.sampleRateShading == VK_TRUE;
+        supported.dualSrcBlend = features.dualSrcBlend == VK_TRUE;
+        supported.logicOp = features.logicOp == VK_TRUE;
+        supported.multiDrawIndirect = features.multiDrawIndirect == VK_TRUE;
+        supported.drawIndirectFirstInstance = features.drawIndirectFirstInstance == VK_TRUE;
+        supported.depthClamp = features.depthClamp == VK_TRUE;
+        supported.depthBiasClamp = features.depthBiasClamp == VK_TRUE;
+        supported.fillModeNonSolid = features.fillModeNonSolid == VK_TRUE;
+        supported.depthBounds = features.depthBounds == VK_TRUE;
+        supported.wideLines = features.wideLines == VK_TRUE;
+        supported.largePoints = features.largePoints == VK_TRUE;
+        supported.alphaToOne = features.alphaToOne == VK_TRUE;
+        supported.multiViewport = features.multiViewport == VK_TRUE;
+        supported.samplerAnisotropy = features.samplerAnisotropy == VK_TRUE;
+        supported.textureCompressionBC = features.textureCompressionBC == VK_TRUE;
+        supported.textureCompressionETC2 = features.textureCompressionETC2 == VK_TRUE;
+        supported.textureCompressionASTC_LDR = features.textureCompressionASTC_LDR == VK_TRUE;
+        supported.occlusionQueryPrecise = features.occlusionQueryPrecise == VK_TRUE;
+        supported.pipelineStatisticsQuery = features.pipelineStatisticsQuery == VK_TRUE;
+        supported.vertexPipelineStoresAndAtomics = features.vertexPipelineStoresAndAtomics == VK_TRUE;
+        supported.fragmentStoresAndAtomics = features.fragmentStoresAndAtomics == VK_TRUE;
+        supported.shaderTessellationAndGeometryPointSize = features.shaderTessellationAndGeometryPointSize == VK_TRUE;
+        supported.shaderImageGatherExtended = features.shaderImageGatherExtended == VK_TRUE;
+        supported.shaderStorageImageExtendedFormats = features.shaderStorageImageExtendedFormats == VK_TRUE;
+        supported.shaderStorageImageMultisample = features.shaderStorageImageMultisample == VK_TRUE;
+        supported.shaderUniformBufferArrayDynamicIndexing = features.shaderUniformBufferArrayDynamicIndexing == VK_TRUE;
+        supported.shaderSampledImageArrayDynamicIndexing = features.shaderSampledImageArrayDynamicIndexing == VK_TRUE;
+        supported.shaderStorageBufferArrayDynamicIndexing = features.shaderStorageBufferArrayDynamicIndexing == VK_TRUE;
+        supported.shaderStorageImageArrayDynamicIndexing = features.shaderStorageImageArrayDynamicIndexing == VK_TRUE;
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_physicalDevice));
+    }
+
+    const AdapterInfo& GetAdapterInfo() const override { return m_info; }
+
+    Result<std::vector<QueueFamilyProperties>> GetQueueFamilyProperties() const override {
+        uint32_t count = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &count, nullptr);
+        std::vector<VkQueueFamilyProperties> vkFamilies(count);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_physicalDevice, &count, vkFamilies.data());
+
+        std::vector<QueueFamilyProperties> families;
+        for (const VkQueueFamilyProperties& vkFamily : vkFamilies) {
+            QueueFamilyProperties properties = {};
+            properties.graphicsSupport = (vkFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+            properties.computeSupport = (vkFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) != 0;
+            // 图形与计算队列隐式支持传输
+            properties.transferSupport = (vkFamily.queueFlags &
+                (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) != 0;
+            properties.sparseSupport = (vkFamily.queueFlags & VK_QUEUE_SPARSE_BINDING_BIT) != 0;
+            properties.protectedSupport = (vkFamily.queueFlags & VK_QUEUE_PROTECTED_BIT) != 0;
+            properties.type = properties.graphicsSupport ? QueueType::Graphics
+                : properties.computeSupport ? QueueType::Compute
+                : QueueType::Transfer;
+            properties.queueCount = vkFamily.queueCount;
+            properties.timestampValidBits = vkFamily.timestampValidBits;
+            properties.minImageTransferGranularity[0] = vkFamily.minImageTransferGranularity.width;
+            properties.minImageTransferGranularity[1] = vkFamily.minImageTransferGranularity.height;
+            properties.minImageTransferGranularity[2] = vkFamily.minImageTransferGranularity.depth;
+            families.push_back(properties);
+        }
+        return MakeSuccessResult(std::move(families));
+    }
+
+    // surface为VkSurfaceKHR
+    Result<bool> CheckPresentSupport(uint32_t queueFamilyIndex, void* surface) const override {
+        VkBool32 supported = VK_FALSE;
+        RHI_VK_RETURN_IF_FAILED(vkGetPhysicalDeviceSurfaceSupportKHR(
+            m_physicalDevice, queueFamilyIndex, reinterpret_cast<VkSurfaceKHR>(surface), &supported));
+        return MakeSuccessResult(supported == VK_TRUE);
+    }
+
+    // memoryTypes为VkMemoryType数组，memoryHeaps为VkMemoryHeap数组（可为空，只查询数量）
+    Result<void> GetMemoryProperties(
+        uint32_t* memoryTypeCount,
+        void* memoryTypes,
+        uint32_t* memoryHeapCount,
+        void* memoryHeaps) const override {
+        VkPhysicalDeviceMemoryProperties memory = {};
+        vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memory);
+        if (memoryTypeCount != nullptr) {
+            *memoryTypeCount = memory.memoryTypeCount;
+        }
+        if (memoryTypes != nullptr) {
+            std::memcpy(memoryTypes, memory.memoryTypes, sizeof(VkMemoryType) * memory.memoryTypeCount);
+        }
+        if (memoryHeapCount != nullptr) {
+            *memoryHeapCount = memory.memoryHeapCount;
+        }
+        if (memoryHeaps != nullptr) {
+            std::memcpy(memoryHeaps, memory.memoryHeaps, sizeof(VkMemoryHeap) * memory.memoryHeapCount);
+        }
+        return MakeSuccessResult();
+    }
+
+    // formatProperties为VkFormatProperties*
+    Result<void> GetFormatProperties(Format format, void* formatProperties) const override {
+        VkFormat vkFormat = ToVkFormat(format);
+        RHI_RETURN_IF_FALSE(vkFormat != VK_FORMAT_UNDEFINED,
+            ErrorCode::InvalidArgument,
+            "不支持的格式: " + std::to_string(static_cast<int>(format)));
+        RHI_VALIDATE(formatProperties != nullptr, ErrorCode::InvalidArgument, "格式属性输出不能为空");
+        vkGetPhysicalDeviceFormatProperties(m_physicalDevice, vkFormat,
+            static_cast<VkFormatProperties*>(formatProperties));
+        return MakeSuccessResult();
+    }
+
+    // featureName为设备扩展名
+    bool CheckFeatureSupport(const std::string& featureName) const override {
+        uint32_t count = 0;
+        if (vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &count, nullptr) != VK_SUCCESS) {
+            return false;
+        }
+        std::vector<VkExtensionProperties> extensions(count);
+        if (vkEnumerateDeviceExtensionProperties(m_physicalDevice, nullptr, &count, extensions.data()) != VK_SUCCESS) {
+            return false;
+        }
+        return std::any_of(extensions.begin(), extensions.end(),
+            [&featureName](const VkExtensionProperties& extension) { return featureName == extension.extensionName; });
+    }
+
+    Result<IDevice*> CreateDevice(const DeviceDesc& desc) override {
+        auto device = std::make_unique<VulkanDevice>(m_instance, m_physicalDevice, desc);
+        RHI_RETURN_IF_FAILED(device->Initialize());
+        return MakeSuccessResult(static_cast<IDevice*>(device.release()));
+    }
+
+private:
+    static const char* GetVendorName(uint32_t vendorId) {
+        switch (vendorId) {
+            case 0x1002: return "AMD";
+            case 0x10DE: return "NVIDIA";
+            case 0x8086: return "Intel";
+            case 0x13B5: return "ARM";
+            case 0x5143: return "Qualcomm";
+            case 0x106B: return "Apple";
+            case 0x10005: return "Mesa";
+            default: return "Unknown";
+        }
+    }
+
+    std::shared_ptr<VulkanInstance> m_instance;
+    VkPhysicalDevice m_physicalDevice;
+    AdapterInfo m_info;
+};
+
+// 枚举Vulkan适配器（符合EnumerateAdaptersFunc签名，返回的适配器由调用者释放）
+// 定义RHI_VULKAN_VALIDATION时尝试启用验证层
+inline Result<std::vector<IAdapter*>> EnumerateVulkanAdapters() {
+    auto instance = std::make_shared<VulkanInstance>();
+#ifdef RHI_VULKAN_VALIDATION
+    RHI_RETURN_IF_FAILED(instance->Initialize(true));
+#else
+    RHI_RETURN_IF_FAILED(instance->Initialize(false));
+#endif
+
+    uint32_t count = 0;
+    RHI_VK_RETURN_IF_FAILED(vkEnumeratePhysicalDevices(instance->GetVkInstance(), &count, nullptr));
+    RHI_RETURN_IF_FALSE(count > 0, ErrorCode::AdapterNotFound, "没有可用的Vulkan物理设备");
+    std::vector<VkPhysicalDevice> physicalDevices(count);
+    RHI_VK_RETURN_IF_FAILED(vkEnumeratePhysicalDevices(instance->GetVkInstance(), &count, physicalDevices.data()));
+
+    std::vector<IAdapter*> adapters;
+    for (VkPhysicalDevice physicalDevice : physicalDevices) {
+        adapters.push_back(new VulkanAdapter(instance, physicalDevice));
+    }
+    return MakeSuccessResult(std::move(adapters));
+}
+
+} // namespace RHI
@@ -0,0 +1,916 @@
+#pragma once
+#include "VulkanPipeline.h"
+#include "CommandPool.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace RHI {
+
+// Vulkan命令缓冲区状态
+enum class VulkanCommandBufferState {
+    Initial,            // 初始（未录制或已重置）
+    Recording,          // 录制中
+    Executable          // 录制完成，可提交
+};
+
+// Vulkan命令缓冲区
+// 录制路径不做堆分配：
+// - 顶点缓冲区与描述符集先记录在槽位中，在Draw/Dispatch前按脏范围一次性绑定
+// - 管线、视口、裁剪矩形与索引缓冲区重复设置相同值时跳过
+// - 屏障与复制区域在栈上的固定数组中批量提交
+// 渲染通道使用动态渲染：BeginRenderPass只记录附件，首次Draw时以内联方式开始渲染，
+// 首次ExecuteBundle时以二级命令缓冲区方式开始渲染，两者切换时重新开始（附件使用LOAD/STORE）。
+// 纹理布局在录制时更新，多个命令缓冲区并行录制同一纹理的屏障时须由调用方同步。
+// 屏障的管线阶段按命令池所在队列族支持的阶段裁剪（专用计算/传输队列族不支持图形阶段）。
+class VulkanCommandBuffer : public ICommandBuffer {
+public:
+    VulkanCommandBuffer(const CommandBufferDesc& desc, VkCommandBuffer commandBuffer,
+                        const VulkanContext& context, QueueType queueType)
+        : m_commandBuffer(commandBuffer)
+        , m_context(context)
+        , m_queueFamily(context.GetQueueFamily(queueType)) {
+        m_desc = desc;
+        const VkPipelineStageFlags common = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT |
+            VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+        if (m_queueFamily == context.GetQueueFamily(QueueType::Graphics)) {
+            m_supportedStages = ~VkPipelineStageFlags(0);
+        } else if (m_queueFamily == context.GetQueueFamily(QueueType::Compute)) {
+            m_supportedStages = common | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        } else {
+            m_supportedStages = common;
+        }
+    }
+
+    const CommandBufferDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_commandBuffer));
+    }
+
+    // 设置二级命令缓冲区继承的附件格式（须在Begin前调用；设置后在渲染通道内执行）
+    void SetInheritedRendering(const Format* colorFormats, uint32_t colorCount, Format depthStencilFormat) {
+        m_inheritedColorCount = std::min(colorCount, kVulkanMaxColorAttachments);
+        for (uint32_t i = 0; i < m_inheritedColorCount; ++i) {
+            m_inheritedColorFormats[i] = ToVkFormat(colorFormats[i]);
+        }
+        m_inheritedDepthFormat = IsDepthFormat(depthStencilFormat) ? ToVkFormat(depthStencilFormat) : VK_FORMAT_UNDEFINED;
+        m_inheritedStencilFormat = IsStencilFormat(depthStencilFormat) ? ToVkFormat(depthStencilFormat) : VK_FORMAT_UNDEFINED;
+        m_inheritRendering = true;
+    }
+
+    Result<void> Begin() override {
+        RHI_VALIDATE(m_state != VulkanCommandBufferState::Recording,
+            ErrorCode::InvalidOperation,
+            "命令缓冲区已处于录制状态");
+
+        uint32_t usage = static_cast<uint32_t>(m_desc.usage);
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        if (usage & static_cast<uint32_t>(CommandBufferUsage::OneTimeSubmit)) {
+            beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        }
+        if (usage & static_cast<uint32_t>(CommandBufferUsage::SimultaneousUse)) {
+            beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        }
+
+        VkCommandBufferInheritanceRenderingInfo inheritanceRendering = {};
+        VkCommandBufferInheritanceInfo inheritance = {};
+        if (m_desc.isSecondary) {
+            inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+            if (m_inheritRendering) {
+                inheritanceRendering.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+                inheritanceRendering.colorAttachmentCount = m_inheritedColorCount;
+                inheritanceRendering.pColorAttachmentFormats = m_inheritedColorFormats;
+                inheritanceRendering.depthAttachmentFormat = m_inheritedDepthFormat;
+                inheritanceRendering.stencilAttachmentFormat = m_inheritedStencilFormat;
+                inheritanceRendering.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+                inheritance.pNext = &inheritanceRendering;
+                beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            }
+            beginInfo.pInheritanceInfo = &inheritance;
+        }
+
+        RHI_VK_RETURN_IF_FAILED(vkBeginCommandBuffer(m_commandBuffer, &beginInfo));
+        ResetRecordingState();
+        m_state = VulkanCommandBufferState::Recording;
+        return MakeSuccessResult();
+    }
+
+    Result<void> End() override {
+        RHI_VALIDATE(m_state == VulkanCommandBufferState::Recording,
+            ErrorCode::InvalidOperation,
+            "命令缓冲区未处于录制状态");
+        RHI_VALIDATE(!m_insideRenderPass,
+            ErrorCode::InvalidOperation,
+            "渲染通道未结束");
+        RHI_VK_RETURN_IF_FAILED(vkEndCommandBuffer(m_commandBuffer));
+        m_state = VulkanCommandBufferState::Executable;
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        RHI_VK_RETURN_IF_FAILED(vkResetCommandBuffer(m_commandBuffer, 0));
+        ResetRecordingState();
+        m_state = VulkanCommandBufferState::Initial;
+        return MakeSuccessResult();
+    }
+
+    Result<void> BeginRenderPass(const RenderPassDesc& desc) override {
+        RHI_VALIDATE(IsRecording(), ErrorCode::InvalidOperation, "命令缓冲区未处于录制状态");
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "渲染通道不能嵌套");
+        // 附件数决定固定大小数组的写入范围，发布版同样检查
+        RHI_RETURN_IF_FALSE(desc.colorAttachmentCount <= kVulkanMaxColorAttachments,
+            ErrorCode::InvalidArgument,
+            "颜色附件数量超过上限");
+        RHI_VALIDATE(desc.colorAttachmentCount == 0 || desc.colorAttachments != nullptr,
+            ErrorCode::InvalidArgument,
+            "颜色附件数组不能为空");
+
+        m_colorAttachmentCount = desc.colorAttachmentCount;
+        void* const* colorViews = static_cast<void* const*>(desc.colorAttachments);
+        for (uint32_t i = 0; i < m_colorAttachmentCount; ++i) {
+            m_colorAttachments[i] = static_cast<VulkanTextureView*>(colorViews[i]);
+        }
+        m_depthAttachment = static_cast<VulkanTextureView*>(desc.depthStencilAttachment);
+
+        // 附件转换到附件布局（批量为一次屏障）
+        BarrierBatch batch;
+        for (uint32_t i = 0; i < m_colorAttachmentCount; ++i) {
+            AddLayoutTransition(batch, m_colorAttachments[i], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+        }
+        if (m_depthAttachment != nullptr) {
+            AddLayoutTransition(batch, m_depthAttachment, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+        }
+        FlushBarriers(batch);
+
+        m_insideRenderPass = true;
+        m_rendering = RenderingMode::None;
+        return MakeSuccessResult();
+    }
+
+    Result<void> EndRenderPass() override {
+        RHI_VALIDATE(m_insideRenderPass, ErrorCode::InvalidOperation, "没有进行中的渲染通道");
+        if (m_rendering != RenderingMode::None) {
+            vkCmdEndRendering(m_commandBuffer);
+            m_rendering = RenderingMode::None;
+        }
+        m_insideRenderPass = false;
+        return MakeSuccessResult();
+    }
+
+    // 视口按D3D约定（原点在左上角）给出，通过负高度翻转
+    Result<void> SetViewport(const Viewport& viewport) override {
+        RHI_VALIDATE(viewport.width > 0.0f && viewport.height > 0.0f,
+            ErrorCode::InvalidArgument,
+            "视口尺寸必须大于0");
+        if (m_viewportValid && std::memcmp(&viewport, &m_viewport, sizeof(Viewport)) == 0) {
+            return MakeSuccessResult();
+        }
+        m_viewport = viewport;
+        m_viewportValid = true;
+
+        VkViewport vkViewport = {};
+        vkViewport.x = viewport.x;
+        vkViewport.y = viewport.y + viewport.height;
+        vkViewport.width = viewport.width;
+        vkViewport.height = -viewport.height;
+        vkViewport.minDepth = viewport.minDepth;
+        vkViewport.maxDepth = viewport.maxDepth;
+        vkCmdSetViewport(m_commandBuffer, 0, 1, &vkViewport);
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetScissor(const Scissor& scissor) override {
+        if (m_scissorValid && std::memcmp(&scissor, &m_scissor, sizeof(Scissor)) == 0) {
+            return MakeSuccessResult();
+        }
+        m_scissor = scissor;
+        m_scissorValid = true;
+
+        VkRect2D rect = {};
+        rect.offset = {scissor.x, scissor.y};
+        rect.extent = {scissor.width, scissor.height};
+        vkCmdSetScissor(m_commandBuffer, 0, 1, &rect);
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetPipelineState(void* pipelineState) override {
+        RHI_VALIDATE(pipelineState != nullptr, ErrorCode::InvalidArgument, "管线状态不能为空");
+        auto* pipeline = static_cast<VulkanPipelineState*>(static_cast<IPipelineState*>(pipelineState));
+        BindPointState& bindPoint = GetBindPoint(pipeline->GetBindPoint());
+        m_lastPipeline = pipeline;
+        if (bindPoint.pipeline == pipeline) {
+            return MakeSuccessResult();
+        }
+        vkCmdBindPipeline(m_commandBuffer, pipeline->GetBindPoint(), pipeline->GetVkPipeline());
+        if (bindPoint.layout != pipeline->GetVkLayout()) {
+            // 管线布局变化后已绑定的描述符集需要重新绑定
+            bindPoint.layout = pipeline->GetVkLayout();
+            bindPoint.dirtySets = m_boundSetMask;
+        }
+        bindPoint.pipeline = pipeline;
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetDescriptorSet(uint32_t set, void* descriptorSet) override {
+        return SetDescriptorSet(set, descriptorSet, Span<const uint32_t>());
+    }
+
+    Result<void> SetDescriptorSet(uint32_t set, void* descriptorSet, Span<const uint32_t> dynamicOffsets) override {
+        RHI_VALIDATE(descriptorSet != nullptr, ErrorCode::InvalidArgument, "描述符集不能为空");
+        RHI_RETURN_IF_FALSE(set < kVulkanMaxDescriptorSets,
+            ErrorCode::InvalidArgument,
+            "描述符集索引超过上限: " + std::to_string(set));
+        RHI_RETURN_IF_FALSE(dynamicOffsets.size() <= kVulkanMaxDynamicOffsets,
+            ErrorCode::InvalidArgument,
+            "动态偏移数超过上限: " + std::to_string(dynamicOffsets.size()));
+        VkDescriptorSet handle = static_cast<VulkanDescriptorSet*>(
+            static_cast<IDescriptorSet*>(descriptorSet))->GetVkSet();
+        uint32_t count = static_cast<uint32_t>(dynamicOffsets.size());
+        if (m_sets[set] == handle && m_dynamicOffsetCounts[set] == count &&
+            std::equal(dynamicOffsets.begin(), dynamicOffsets.end(), m_dynamicOffsets[set])) {
+            return MakeSuccessResult();
+        }
+        m_sets[set] = handle;
+        m_dynamicOffsetCounts[set] = count;
+        std::copy(dynamicOffsets.begin(), dynamicOffsets.end(), m_dynamicOffsets[set]);
+        m_boundSetMask |= 1u << set;
+        m_graphics.dirtySets |= 1u << set;
+        m_compute.dirtySets |= 1u << set;
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetVertexBuffer(uint32_t slot, void* vertexBufferView) override {
+        RHI_VALIDATE(vertexBufferView != nullptr, ErrorCode::InvalidArgument, "顶点缓冲区视图不能为空");
+        RHI_RETURN_IF_FALSE(slot < kVulkanMaxVertexBuffers,
+            ErrorCode::InvalidArgument,
+            "顶点缓冲区槽位超过上限: " + std::to_string(slot));
+        auto* view = static_cast<const VulkanBufferView*>(vertexBufferView);
+        VkDeviceSize offset = view->desc.offset;
+        if (m_vertexBuffers[slot] == view->handle && m_vertexOffsets[slot] == offset) {
+            return MakeSuccessResult();
+        }
+        m_vertexBuffers[slot] = view->handle;
+        m_vertexOffsets[slot] = offset;
+        m_vertexDirtyMin = std::min(m_vertexDirtyMin, slot);
+        m_vertexDirtyMax = std::max(m_vertexDirtyMax, slot + 1);
+        return MakeSuccessResult();
+    }
+
+    Result<void> SetIndexBuffer(void* indexBufferView) override {
+        RHI_VALIDATE(indexBufferView != nullptr, ErrorCode::InvalidArgument, "索引缓冲区视图不能为空");
+        auto* view = static_cast<const VulkanBufferView*>(indexBufferView);
+        RHI_VALIDATE(view->desc.stride == 2 || view->desc.stride == 4,
+            ErrorCode::InvalidArgument,
+            "索引大小必须为2或4字节");
+        VkIndexType indexType = view->desc.stride == 2 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+        if (m_indexBuffer == view->handle && m_indexOffset == view->desc.offset && m_indexType == indexType) {
+            return MakeSuccessResult();
+        }
+        m_indexBuffer = view->handle;
+        m_indexOffset = view->desc.offset;
+        m_indexType = indexType;
+        vkCmdBindIndexBuffer(m_commandBuffer, m_indexBuffer, m_indexOffset, m_indexType);
+        return MakeSuccessResult();
+    }
+
+    // layout为IPipelineState::GetPipelineLayout的返回值，为空时使用最近设置的管线的布局
+    Result<void> PushConstants(void* layout, uint32_t offset, uint32_t size, const void* data) override {
+        RHI_VALIDATE(data != nullptr || size == 0, ErrorCode::InvalidArgument, "推送常量数据不能为空");
+        RHI_VALIDATE(offset + size <= kVulkanPushConstantSize,
+            ErrorCode::InvalidArgument,
+            "推送常量超过" + std::to_string(kVulkanPushConstantSize) + "字节");
+        VkPipelineLayout pipelineLayout = layout != nullptr
+            ? reinterpret_cast<VkPipelineLayout>(layout)
+            : (m_lastPipeline != nullptr ? m_lastPipeline->GetVkLayout() : VK_NULL_HANDLE);
+        RHI_VALIDATE(pipelineLayout != VK_NULL_HANDLE,
+            ErrorCode::InvalidOperation,
+            "未指定管线布局且未设置管线");
+        vkCmdPushConstants(m_commandBuffer, pipelineLayout, VK_SHADER_STAGE_ALL, offset, size, data);
+        return MakeSuccessResult();
+    }
+
+    Result<void> Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override {
+        RHI_RETURN_IF_FAILED(FlushGraphicsState());
+        vkCmdDraw(m_commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+        return MakeSuccessResult();
+    }
+
+    Result<void> DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+        int32_t vertexOffset, uint32_t firstInstance) override {
+        RHI_VALIDATE(m_indexBuffer != VK_NULL_HANDLE, ErrorCode::InvalidOperation, "未设置索引缓冲区");
+        RHI_RETURN_IF_FAILED(FlushGraphicsState());
+        vkCmdDrawIndexed(m_commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+        return MakeSuccessResult();
+    }
+
+    Result<void> DrawIndirect(void* argumentBuffer, uint32_t offset, uint32_t drawCount, uint32_t stride) override {
+        RHI_VALIDATE(argumentBuffer != nullptr, ErrorCode::InvalidArgument, "参数缓冲区不能为空");
+        RHI_RETURN_IF_FAILED(FlushGraphicsState());
+        VkBuffer buffer = static_cast<VulkanBuffer*>(static_cast<IBuffer*>(argumentBuffer))->GetVkBuffer();
+        vkCmdDrawIndirect(m_commandBuffer, buffer, offset, drawCount,
+            stride != 0 ? stride : static_cast<uint32_t>(sizeof(DrawIndirectArgs)));
+        return MakeSuccessResult();
+    }
+
+    Result<void> Dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ) override {
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "不能在渲染通道内调度计算");
+        RHI_RETURN_IF_FAILED(FlushComputeState());
+        vkCmdDispatch(m_commandBuffer, groupCountX, groupCountY, groupCountZ);
+        return MakeSuccessResult();
+    }
+
+    Result<void> DispatchIndirect(void* argumentBuffer, uint32_t offset) override {
+        RHI_VALIDATE(argumentBuffer != nullptr, ErrorCode::InvalidArgument, "参数缓冲区不能为空");
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "不能在渲染通道内调度计算");
+        RHI_RETURN_IF_FAILED(FlushComputeState());
+        VkBuffer buffer = static_cast<VulkanBuffer*>(static_cast<IBuffer*>(argumentBuffer))->GetVkBuffer();
+        vkCmdDispatchIndirect(m_commandBuffer, buffer, offset);
+        return MakeSuccessResult();
+    }
+
+    Result<void> CopyBuffer(void* srcBuffer, void* dstBuffer, uint32_t regionCount, void* regions) override {
+        RHI_VALIDATE(srcBuffer != nullptr && dstBuffer != nullptr,
+            ErrorCode::InvalidArgument,
+            "复制的源和目标不能为空");
+        RHI_VALIDATE(regions != nullptr || regionCount == 0, ErrorCode::InvalidArgument, "复制区域不能为空");
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "不能在渲染通道内复制");
+
+        VkBuffer src = static_cast<VulkanBuffer*>(static_cast<IBuffer*>(srcBuffer))->GetVkBuffer();
+        VkBuffer dst = static_cast<VulkanBuffer*>(static_cast<IBuffer*>(dstBuffer))->GetVkBuffer();
+        const BufferCopyRegion* copyRegions = static_cast<const BufferCopyRegion*>(regions);
+        VkBufferCopy batch[kVulkanCopyBatchSize];
+        for (uint32_t first = 0; first < regionCount; first += kVulkanCopyBatchSize) {
+            uint32_t count = std::min(regionCount - first, kVulkanCopyBatchSize);
+            for (uint32_t i = 0; i < count; ++i) {
+                const BufferCopyRegion& region = copyRegions[first + i];
+                batch[i] = {region.srcOffset, region.dstOffset, region.size};
+            }
+            vkCmdCopyBuffer(m_commandBuffer, src, dst, count, batch);
+        }
+        return MakeSuccessResult();
+    }
+
+    // 源纹理须处于TRANSFER_SRC_OPTIMAL布局，目标纹理须处于TRANSFER_DST_OPTIMAL布局
+    Result<void> CopyTexture(void* srcTexture, void* dstTexture, uint32_t regionCount, void* regions) override {
+        RHI_VALIDATE(srcTexture != nullptr && dstTexture != nullptr,
+            ErrorCode::InvalidArgument,
+            "复制的源和目标不能为空");
+        RHI_VALIDATE(regions != nullptr || regionCount == 0, ErrorCode::InvalidArgument, "复制区域不能为空");
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "不能在渲染通道内复制");
+
+        auto* src = static_cast<VulkanTexture*>(static_cast<ITexture*>(srcTexture));
+        auto* dst = static_cast<VulkanTexture*>(static_cast<ITexture*>(dstTexture));
+        VkImageAspectFlags srcAspect = GetVkImageAspect(src->GetDesc().format);
+        VkImageAspectFlags dstAspect = GetVkImageAspect(dst->GetDesc().format);
+        const TextureCopyRegion* copyRegions = static_cast<const TextureCopyRegion*>(regions);
+        VkImageCopy batch[kVulkanCopyBatchSize];
+        for (uint32_t first = 0; first < regionCount; first += kVulkanCopyBatchSize) {
+            uint32_t count = std::min(regionCount - first, kVulkanCopyBatchSize);
+            for (uint32_t i = 0; i < count; ++i) {
+                const TextureCopyRegion& region = copyRegions[first + i];
+                VkImageCopy& copy = batch[i];
+                copy.srcSubresource = {srcAspect, region.srcMipLevel, region.srcArrayLayer, 1};
+                copy.srcOffset = {static_cast<int32_t>(region.srcOffset[0]),
+                    static_cast<int32_t>(region.srcOffset[1]),
+                    static_cast<int32_t>(region.srcOffset[2])};
+                copy.dstSubresource = {dstAspect, region.dstMipLevel, region.dstArrayLayer, 1};
+                copy.dstOffset = {static_cast<int32_t>(region.dstOffset[0]),
+                    static_cast<int32_t>(region.dstOffset[1]),
+                    static_cast<int32_t>(region.dstOffset[2])};
+                copy.extent = {region.extent[0], region.extent[1], region.extent[2]};
+            }
+            vkCmdCopyImage(m_commandBuffer,
+                src->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                dst->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                count, batch);
+        }
+        return MakeSuccessResult();
+    }
+
+    // 目标纹理须处于TRANSFER_DST_OPTIMAL布局；行间距换算为以texel计的bufferRowLength
+    Result<void> CopyBufferToTexture(void* srcBuffer, void* dstTexture, uint32_t regionCount, void* regions) override {
+        RHI_VALIDATE(srcBuffer != nullptr && dstTexture != nullptr,
+            ErrorCode::InvalidArgument,
+            "复制的源和目标不能为空");
+        RHI_VALIDATE(regions != nullptr || regionCount == 0, ErrorCode::InvalidArgument, "复制区域不能为空");
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "不能在渲染通道内复制");
+
+        VkBuffer src = static_cast<VulkanBuffer*>(static_cast<IBuffer*>(srcBuffer))->GetVkBuffer();
+        auto* dst = static_cast<VulkanTexture*>(static_cast<ITexture*>(dstTexture));
+        Format format = dst->GetDesc().format;
+        VkImageAspectFlags aspect = GetVkImageAspect(format);
+        uint32_t blockSize = GetFormatBlockSize(format);
+        uint32_t block = GetFormatBlockDimension(format);
+        const BufferTextureCopyRegion* copyRegions = static_cast<const BufferTextureCopyRegion*>(regions);
+        VkBufferImageCopy batch[kVulkanCopyBatchSize];
+        for (uint32_t first = 0; first < regionCount; first += kVulkanCopyBatchSize) {
+            uint32_t count = std::min(regionCount - first, kVulkanCopyBatchSize);
+            for (uint32_t i = 0; i < count; ++i) {
+                const BufferTextureCopyRegion& region = copyRegions[first + i];
+                VkBufferImageCopy& copy = batch[i];
+                copy.bufferOffset = region.bufferOffset;
+                copy.bufferRowLength = static_cast<uint32_t>(region.bufferRowPitch / blockSize * block);
+                copy.bufferImageHeight = region.bufferRowPitch != 0
+                    ? static_cast<uint32_t>(region.bufferSlicePitch / region.bufferRowPitch * block)
+                    : 0;
+                copy.imageSubresource = {aspect, region.mipLevel, region.arrayLayer, 1};
+                copy.imageOffset = {static_cast<int32_t>(region.offset[0]),
+                    static_cast<int32_t>(region.offset[1]),
+                    static_cast<int32_t>(region.offset[2])};
+                copy.imageExtent = {region.extent[0], region.extent[1], std::max(region.extent[2], 1u)};
+            }
+            vkCmdCopyBufferToImage(m_commandBuffer, src,
+                dst->GetVkImage(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                count, batch);
+        }
+        return MakeSuccessResult();
+    }
+
+    // 状态映射为缓冲区的访问掩码与纹理的图像布局；纹理记录的布局按整个资源更新。
+    // 队列所有权转移时本命令缓冲区所在的队列族为源队列族则录制释放一侧（不含目标访问），
+    // 为目标队列族则录制获取一侧（不含源访问）；源与目标映射到同一队列族时按普通屏障处理。
+    Result<void> ResourceBarrier(uint32_t barrierCount, const BarrierDesc* barriers) override {
+        RHI_VALIDATE(barriers != nullptr || barrierCount == 0,
+            ErrorCode::InvalidArgument,
+            "屏障数组不能为空");
+        RHI_VALIDATE(!m_insideRenderPass, ErrorCode::InvalidOperation, "不能在渲染通道内插入屏障");
+
+        BarrierBatch batch;
+        for (uint32_t i = 0; i < barrierCount; ++i) {
+            const BarrierDesc& barrier = barriers[i];
+            if (barrier.type != BarrierType::Transition || barrier.resource == nullptr) {
+                // UAV/别名/全局屏障合并为一个内存屏障
+                VkAccessFlags srcAccess = barrier.type == BarrierType::UAV
+                    ? VK_ACCESS_SHADER_WRITE_BIT
+                    : VK_ACCESS_MEMORY_WRITE_BIT;
+                VkAccessFlags dstAccess = barrier.type == BarrierType::UAV
+                    ? VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+                    : VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+                batch.memorySrcAccess |= srcAccess;
+                batch.memoryDstAccess |= dstAccess;
+                batch.srcStages |= GetVkAccessStages(srcAccess);
+                batch.dstStages |= GetVkAccessStages(dstAccess);
+                // 别名屏障的resource从未定义的内容开始，再转换到stateAfter（图像需要初始布局）
+                if (barrier.type != BarrierType::Aliasing || barrier.resource == nullptr) {
+                    continue;
+                }
+            }
+
+            ResourceState stateBefore = barrier.type == BarrierType::Aliasing
+                ? ResourceState::Undefined
+                : barrier.stateBefore;
+            QueueTransfer transfer = GetQueueTransfer(barrier);
+            if (barrier.resourceType == BarrierResourceType::Buffer) {
+                if (batch.bufferCount == kVulkanBarrierBatchSize) {
+                    FlushBarriers(batch);
+                }
+                auto* buffer = static_cast<VulkanBuffer*>(static_cast<IBuffer*>(barrier.resource));
+                VkBufferMemoryBarrier& bufferBarrier = batch.buffers[batch.bufferCount++];
+                bufferBarrier = {};
+                bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+                bufferBarrier.srcAccessMask = transfer.acquire ? 0 : ToVkAccessFlags(stateBefore);
+                bufferBarrier.dstAccessMask = transfer.release ? 0 : ToVkAccessFlags(barrier.stateAfter);
+                bufferBarrier.srcQueueFamilyIndex = transfer.srcFamily;
+                bufferBarrier.dstQueueFamilyIndex = transfer.dstFamily;
+                bufferBarrier.buffer = buffer->GetVkBuffer();
+                bufferBarrier.offset = 0;
+                bufferBarrier.size = VK_WHOLE_SIZE;
+                batch.srcStages |= GetVkAccessStages(bufferBarrier.srcAccessMask);
+                batch.dstStages |= GetVkAccessStages(bufferBarrier.dstAccessMask);
+                RHI_RETURN_IF_FAILED(buffer->TransitionState(barrier.stateAfter));
+            } else {
+                if (batch.imageCount == kVulkanBarrierBatchSize) {
+                    FlushBarriers(batch);
+                }
+                auto* texture = static_cast<VulkanTexture*>(static_cast<ITexture*>(barrier.resource));
+                VkImageLayout oldLayout = ToVkImageLayout(stateBefore);
+                VkImageLayout newLayout = ToVkImageLayout(barrier.stateAfter);
+                TextureSubresourceRange range;
+                if (barrier.range != nullptr) {
+                    range = *barrier.range;
+                } else {
+                    range.mipLevelCount = texture->GetDesc().mipLevels;
+                    range.arrayLayerCount = texture->GetLayerCount();
+                }
+                AddImageBarrier(batch, texture, oldLayout, newLayout, range, transfer);
+                texture->SetLayout(newLayout);
+            }
+        }
+        FlushBarriers(batch);
+        return MakeSuccessResult();
+    }
+
+    Result<void> ExecuteBundle(ICommandBuffer* bundle) override {
+        RHI_VALIDATE(bundle != nullptr && bundle->GetDesc().isSecondary,
+            ErrorCode::InvalidArgument,
+            "只能执行二级命令缓冲区");
+        if (m_insideRenderPass) {
+            BeginRendering(RenderingMode::SecondaryBuffers);
+        }
+        VkCommandBuffer secondary = static_cast<VulkanCommandBuffer*>(bundle)->m_commandBuffer;
+        vkCmdExecuteCommands(m_commandBuffer, 1, &secondary);
+
+        // 执行二级命令缓冲区后一级命令缓冲区的绑定状态未定义
+        InvalidateBindings();
+        return MakeSuccessResult();
+    }
+
+    VulkanCommandBufferState GetState() const { return m_state; }
+    VkCommandBuffer GetVkCommandBuffer() const { return m_commandBuffer; }
+
+    // 由命令池在vkResetCommandPool后调用
+    void OnPoolReset() {
+        ResetRecordingState();
+        m_state = VulkanCommandBufferState::Initial;
+    }
+
+private:
+    enum class RenderingMode {
+        None,               // 未开始渲染
+        Inline,             // 内联录制绘制命令
+        SecondaryBuffers    // 通过二级命令缓冲区执行
+    };
+
+    // 队列所有权转移的队列族与本命令缓冲区录制的一侧
+    struct QueueTransfer {
+        uint32_t srcFamily = VK_QUEUE_FAMILY_IGNORED;
+        uint32_t dstFamily = VK_QUEUE_FAMILY_IGNORED;
+        bool release = false;
+        bool acquire = false;
+    };
+
+    struct BindPointState {
+        VulkanPipelineState* pipeline = nullptr;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        uint32_t dirtySets = 0;
+    };
+
+    // 栈上的屏障批次
+    struct BarrierBatch {
+        VkBufferMemoryBarrier buffers[kVulkanBarrierBatchSize];
+        VkImageMemoryBarrier images[kVulkanBarrierBatchSize];
+        uint32_t bufferCount = 0;
+        uint32_t imageCount = 0;
+        VkAccessFlags memorySrcAccess = 0;
+        VkAccessFlags memoryDstAccess = 0;
+        VkPipelineStageFlags srcStages = 0;
+        VkPipelineStageFlags dstStages = 0;
+    };
+
+    bool IsRecording() const {
+        return m_state == VulkanCommandBufferState::Recording;
+    }
+
+    BindPointState& GetBindPoint(VkPipelineBindPoint bindPoint) {
+        return bindPoint == VK_PIPELINE_BIND_POINT_COMPUTE ? m_compute : m_graphics;
+    }
+
+    void ResetRecordingState() {
+        m_insideRenderPass = false;
+        m_rendering = RenderingMode::None;
+        m_colorAttachmentCount = 0;
+        m_depthAttachment = nullptr;
+        m_lastPipeline = nullptr;
+        std::fill(std::begin(m_sets), std::end(m_sets), VkDescriptorSet(VK_NULL_HANDLE));
+        std::fill(std::begin(m_dynamicOffsetCounts), std::end(m_dynamicOffsetCounts), 0u);
+        m_boundSetMask = 0;
+        std::fill(std::begin(m_vertexBuffers), std::end(m_vertexBuffers), VkBuffer(VK_NULL_HANDLE));
+        InvalidateBindings();
+    }
+
+    // 使所有已记录的绑定失效，下次使用前重新绑定
+    void InvalidateBindings() {
+        m_graphics = BindPointState();
+        m_compute = BindPointState();
+        m_graphics.dirtySets = m_boundSetMask;
+        m_compute.dirtySets = m_boundSetMask;
+        m_viewportValid = false;
+        m_scissorValid = false;
+        m_indexBuffer = VK_NULL_HANDLE;
+        m_vertexDirtyMin = 0;
+        m_vertexDirtyMax = kVulkanMaxVertexBuffers;
+    }
+
+    QueueTransfer GetQueueTransfer(const BarrierDesc& barrier) const {
+        QueueTransfer transfer;
+        if (barrier.srcQueue == barrier.dstQueue) {
+            return transfer;
+        }
+        uint32_t srcFamily = m_context.GetQueueFamily(barrier.srcQueue);
+        uint32_t dstFamily = m_context.GetQueueFamily(barrier.dstQueue);
+        if (srcFamily == dstFamily) {
+            return transfer;
+        }
+        transfer.srcFamily = srcFamily;
+        transfer.dstFamily = dstFamily;
+        transfer.release = m_queueFamily == srcFamily;
+        transfer.acquire = m_queueFamily == dstFamily;
+        return transfer;
+    }
+
+    void AddImageBarrier(BarrierBatch& batch, VulkanTexture* texture,
+        VkImageLayout oldLayout, VkImageLayout newLayout, const TextureSubresourceRange& range,
+        const QueueTransfer& transfer) {
+        if (batch.imageCount == kVulkanBarrierBatchSize) {
+            FlushBarriers(batch);
+        }
+        VkImageMemoryBarrier& imageBarrier = batch.images[batch.imageCount++];
+        imageBarrier = {};
+        imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        imageBarrier.srcAccessMask = transfer.acquire ? 0 : GetVkLayoutAccess(oldLayout);
+        imageBarrier.dstAccessMask = transfer.release ? 0 : GetVkLayoutAccess(newLayout);
+        imageBarrier.oldLayout = oldLayout;
+        imageBarrier.newLayout = newLayout;
+        imageBarrier.srcQueueFamilyIndex = transfer.srcFamily;
+        imageBarrier.dstQueueFamilyIndex = transfer.dstFamily;
+        imageBarrier.image = texture->GetVkImage();
+        imageBarrier.subresourceRange = ToVkSubresourceRange(range, texture->GetDesc().format);
+        batch.srcStages |= GetVkAccessStages(imageBarrier.srcAccessMask);
+        batch.dstStages |= GetVkAccessStages(imageBarrier.dstAccessMask);
+    }
+
+    // 附件的记录布局与目标布局不同时加入转换屏障
+    void AddLayoutTransition(BarrierBatch& batch, VulkanTextureView* view, VkImageLayout layout) {
+        if (view == nullptr || view->texture->GetLayout() == layout) {
+            return;
+        }
+        TextureSubresourceRange range;
+        range.mipLevelCount = view->texture->GetDesc().mipLevels;
+        range.arrayLayerCount = view->texture->GetLayerCount();
+        AddImageBarrier(batch, view->texture, view->texture->GetLayout(), layout, range, QueueTransfer());
+        view->texture->SetLayout(layout);
+    }
+
+    void FlushBarriers(BarrierBatch& batch) {
+        bool hasMemoryBarrier = batch.memorySrcAccess != 0 || batch.memoryDstAccess != 0;
+        if (batch.bufferCount == 0 && batch.imageCount == 0 && !hasMemoryBarrier) {
+            return;
+        }
+        VkMemoryBarrier memoryBarrier = {};
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask = batch.memorySrcAccess;
+        memoryBarrier.dstAccessMask = batch.memoryDstAccess;
+        VkPipelineStageFlags srcStages = batch.srcStages & m_supportedStages;
+        VkPipelineStageFlags dstStages = batch.dstStages & m_supportedStages;
+        vkCmdPipelineBarrier(m_commandBuffer,
+            srcStages != 0 ? srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            dstStages != 0 ? dstStages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0,
+            hasMemoryBarrier ? 1 : 0, &memoryBarrier,
+            batch.bufferCount, batch.buffers,
+            batch.imageCount, batch.images);
+        batch.bufferCount = 0;
+        batch.imageCount = 0;
+        batch.memorySrcAccess = 0;
+        batch.memoryDstAccess = 0;
+        batch.srcStages = 0;
+        batch.dstStages = 0;
+    }
+
+    void BeginRendering(RenderingMode mode) {
+        if (m_rendering == mode) {
+            return;
+        }
+        if (m_rendering != RenderingMode::None) {
+            vkCmdEndRendering(m_commandBuffer);
+        }
+
+        VkRenderingAttachmentInfo colorInfos[kVulkanMaxColorAttachments] = {};
+        VkExtent2D extent = {0, 0};
+        for (uint32_t i = 0; i < m_colorAttachmentCount; ++i) {
+            VkRenderingAttachmentInfo& info = colorInfos[i];
+            info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            info.imageView = m_colorAttachments[i]->handle;
+            info.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            info.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+            info.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            extent = {m_colorAttachments[i]->width, m_colorAttachments[i]->height};
+        }
+
+        VkRenderingAttachmentInfo depthInfo = {};
+        Format depthFormat = Format::UNKNOWN;
+        if (m_depthAttachment != nullptr) {
+            depthInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            depthInfo.imageView = m_depthAttachment->handle;
+            depthInfo.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+            depthInfo.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+            depthInfo.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            depthFormat = m_depthAttachment->texture->GetDesc().format;
+            if (m_colorAttachmentCount == 0) {
+                extent = {m_depthAttachment->width, m_depthAttachment->height};
+            }
+        }
+
+        VkRenderingInfo renderingInfo = {};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        renderingInfo.flags = mode == RenderingMode::SecondaryBuffers
+            ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT
+            : 0;
+        renderingInfo.renderArea.extent = extent;
+        renderingInfo.layerCount = 1;
+        renderingInfo.colorAttachmentCount = m_colorAttachmentCount;
+        renderingInfo.pColorAttachments = colorInfos;
+        renderingInfo.pDepthAttachment = IsDepthFormat(depthFormat) ? &depthInfo : nullptr;
+        renderingInfo.pStencilAttachment = IsStencilFormat(depthFormat) ? &depthInfo : nullptr;
+        vkCmdBeginRendering(m_commandBuffer, &renderingInfo);
+        m_rendering = mode;
+    }
+
+    // 按位掩码中的连续区间绑定描述符集，区间内各集合的动态偏移按集合顺序拼接
+    void FlushDescriptorSets(BindPointState& bindPoint, VkPipelineBindPoint point) {
+        uint32_t offsets[kVulkanMaxDescriptorSets * kVulkanMaxDynamicOffsets];
+        uint32_t dirty = bindPoint.dirtySets & m_boundSetMask;
+        bindPoint.dirtySets = 0;
+        while (dirty != 0) {
+            uint32_t first = 0;
+            while ((dirty & (1u << first)) == 0) {
+                ++first;
+            }
+            uint32_t count = 0;
+            uint32_t offsetCount = 0;
+            while (first + count < kVulkanMaxDescriptorSets && (dirty & (1u << (first + count))) != 0) {
+                uint32_t set = first + count;
+                dirty &= ~(1u << set);
+                std::copy_n(m_dynamicOffsets[set], m_dynamicOffsetCounts[set], offsets + offsetCount);
+                offsetCount += m_dynamicOffsetCounts[set];
+                ++count;
+            }
+            vkCmdBindDescriptorSets(m_commandBuffer, point, bindPoint.layout,
+                first, count, &m_sets[first], offsetCount, offsets);
+        }
+    }
+
+    Result<void> FlushGraphicsState() {
+        RHI_VALIDATE(IsRecording(), ErrorCode::InvalidOperation, "命令缓冲区未处于录制状态");
+        RHI_VALIDATE(m_graphics.pipeline != nullptr, ErrorCode::InvalidOperation, "未设置图形管线");
+        if (m_insideRenderPass) {
+            BeginRendering(RenderingMode::Inline);
+        }
+
+        // 顶点缓冲区：脏范围内的连续非空槽位各绑定一次
+        uint32_t slot = m_vertexDirtyMin;
+        while (slot < m_vertexDirtyMax) {
+            if (m_vertexBuffers[slot] == VK_NULL_HANDLE) {
+                ++slot;
+                continue;
+            }
+            uint32_t first = slot;
+            while (slot < m_vertexDirtyMax && m_vertexBuffers[slot] != VK_NULL_HANDLE) {
+                ++slot;
+            }
+            vkCmdBindVertexBuffers(m_commandBuffer, first, slot - first, &m_vertexBuffers[first], &m_vertexOffsets[first]);
+        }
+        m_vertexDirtyMin = kVulkanMaxVertexBuffers;
+        m_vertexDirtyMax = 0;
+
+        FlushDescriptorSets(m_graphics, VK_PIPELINE_BIND_POINT_GRAPHICS);
+        return MakeSuccessResult();
+    }
+
+    Result<void> FlushComputeState() {
+        RHI_VALIDATE(IsRecording(), ErrorCode::InvalidOperation, "命令缓冲区未处于录制状态");
+        RHI_VALIDATE(m_compute.pipeline != nullptr, ErrorCode::InvalidOperation, "未设置计算管线");
+        FlushDescriptorSets(m_compute, VK_PIPELINE_BIND_POINT_COMPUTE);
+        return MakeSuccessResult();
+    }
+
+    VkCommandBuffer m_commandBuffer;
+    const VulkanContext& m_context;
+    uint32_t m_queueFamily;                  // 命令池所在的队列族
+    VkPipelineStageFlags m_supportedStages;  // 该队列族支持的管线阶段
+    VulkanCommandBufferState m_state = VulkanCommandBufferState::Initial;
+
+    // 二级命令缓冲区继承的渲染信息
+    bool m_inheritRendering = false;
+    uint32_t m_inheritedColorCount = 0;
+    VkFormat m_inheritedColorFormats[kVulkanMaxColorAttachments] = {};
+    VkFormat m_inheritedDepthFormat = VK_FORMAT_UNDEFINED;
+    VkFormat m_inheritedStencilFormat = VK_FORMAT_UNDEFINED;
+
+    // 渲染通道
+    bool m_insideRenderPass = false;
+    RenderingMode m_rendering = RenderingMode::None;
+    uint32_t m_colorAttachmentCount = 0;
+    VulkanTextureView* m_colorAttachments[kVulkanMaxColorAttachments] = {};
+    VulkanTextureView* m_depthAttachment = nullptr;
+
+    // 绑定状态
+    BindPointState m_graphics;
+    BindPointState m_compute;
+    VulkanPipelineState* m_lastPipeline = nullptr;
+    VkDescriptorSet m_sets[kVulkanMaxDescriptorSets] = {};
+    uint32_t m_dynamicOffsets[kVulkanMaxDescriptorSets][kVulkanMaxDynamicOffsets] = {};
+    uint32_t m_dynamicOffsetCounts[kVulkanMaxDescriptorSets] = {};
+    uint32_t m_boundSetMask = 0;
+    VkBuffer m_vertexBuffers[kVulkanMaxVertexBuffers] = {};
+    VkDeviceSize m_vertexOffsets[kVulkanMaxVertexBuffers] = {};
+    uint32_t m_vertexDirtyMin = kVulkanMaxVertexBuffers;
+    uint32_t m_vertexDirtyMax = 0;
+    VkBuffer m_indexBuffer = VK_NULL_HANDLE;
+    VkDeviceSize m_indexOffset = 0;
+    VkIndexType m_indexType = VK_INDEX_TYPE_UINT16;
+    Viewport m_viewport = {};
+    bool m_viewportValid = false;
+    Scissor m_scissor = {};
+    bool m_scissorValid = false;
+};
+
+// Vulkan命令池
+// 始终带RESET_COMMAND_BUFFER标志创建，以支持ICommandBuffer::Reset
+class VulkanCommandPool : public ICommandPool {
+public:
+    VulkanCommandPool(VulkanContext& context, const CommandPoolDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    ~VulkanCommandPool() override {
+        m_commandBuffers.clear();
+        if (m_pool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_context.GetDevice(), m_pool, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        VkCommandPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        if (static_cast<uint32_t>(m_desc.flags) & static_cast<uint32_t>(CommandPoolFlag::Transient)) {
+            poolInfo.flags |= VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        }
+        poolInfo.queueFamilyIndex = m_desc.queueFamilyIndex;
+        RHI_VK_RETURN_IF_FAILED(vkCreateCommandPool(m_context.GetDevice(), &poolInfo, nullptr, &m_pool));
+        return MakeSuccessResult();
+    }
+
+    const CommandPoolDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_pool));
+    }
+
+    Result<std::vector<ICommandBuffer*>> AllocateCommandBuffers(
+        const CommandBufferAllocateInfo& allocInfo) override {
+        RHI_VALIDATE(allocInfo.count > 0, ErrorCode::InvalidArgument, "分配数量必须大于0");
+
+        CommandBufferDesc desc;
+        desc.type = allocInfo.level;
+        desc.usage = allocInfo.usage;
+        desc.isSecondary = allocInfo.level == CommandBufferType::Bundle;
+
+        VkCommandBufferAllocateInfo vkAllocInfo = {};
+        vkAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        vkAllocInfo.commandPool = m_pool;
+        vkAllocInfo.level = desc.isSecondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        vkAllocInfo.commandBufferCount = allocInfo.count;
+        std::vector<VkCommandBuffer> handles(allocInfo.count);
+        RHI_VK_RETURN_IF_FAILED(vkAllocateCommandBuffers(m_context.GetDevice(), &vkAllocInfo, handles.data()));
+
+        std::vector<ICommandBuffer*> commandBuffers;
+        commandBuffers.reserve(allocInfo.count);
+        for (VkCommandBuffer handle : handles) {
+            m_commandBuffers.push_back(std::make_unique<VulkanCommandBuffer>(desc, handle, m_context, m_desc.queueType));
+            commandBuffers.push_back(m_commandBuffers.back().get());
+        }
+        return MakeSuccessResult(std::move(commandBuffers));
+    }
+
+    Result<void> FreeCommandBuffers(const std::vector<ICommandBuffer*>& commandBuffers) override {
+        for (ICommandBuffer* commandBuffer : commandBuffers) {
+            auto it = std::find_if(m_commandBuffers.begin(), m_commandBuffers.end(),
+                [commandBuffer](const std::unique_ptr<VulkanCommandBuffer>& owned) {
+                    return owned.get() == commandBuffer;
+                });
+            RHI_RETURN_IF_FALSE(it != m_commandBuffers.end(),
+                ErrorCode::InvalidArgument,
+                "命令缓冲区不属于此命令池");
+            VkCommandBuffer handle = (*it)->GetVkCommandBuffer();
+            vkFreeCommandBuffers(m_context.GetDevice(), m_pool, 1, &handle);
+            m_commandBuffers.erase(it);
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        RHI_VK_RETURN_IF_FAILED(vkResetCommandPool(m_context.GetDevice(), m_pool, 0));
+        for (auto& commandBuffer : m_commandBuffers) {
+            commandBuffer->OnPoolReset();
+        }
+        return MakeSuccessResult();
+    }
+
+    Result<void> Trim() override {
+        vkTrimCommandPool(m_context.GetDevice(), m_pool, 0);
+        return MakeSuccessResult();
+    }
+
+private:
+    VulkanContext& m_context;
+    VkCommandPool m_pool = VK_NULL_HANDLE;
+    std::vector<std::unique_ptr<VulkanCommandBuffer>> m_commandBuffers;
+};
+
+} // namespace RHI
@@ -0,0 +1,589 @@
+#pragma once
+#include "ErrorUtil.h"
+#include "Format.h"
+#include "Pipeline.h"
+#include "Descriptor.h"
+#include "TextureDesc.h"
+#include "Buffer.h"
+#include "Memory.h"
+#include "ResourceState.h"
+#include "Synchronization.h"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+
+namespace RHI {
+
+// Vulkan后端要求Vulkan 1.3（动态渲染、时间线信号量）
+constexpr uint32_t kVulkanApiVersion = VK_API_VERSION_1_3;
+
+// Vulkan后端常量
+constexpr uint32_t kVulkanMaxColorAttachments = 8;     // 最大颜色附件数
+constexpr uint32_t kVulkanMaxVertexBuffers = 16;       // 最大顶点缓冲区槽位数
+constexpr uint32_t kVulkanMaxDescriptorSets = 8;       // 最大描述符集数
+constexpr uint32_t kVulkanMaxDynamicOffsets = 8;       // 每个描述符集的最大动态偏移数
+constexpr uint32_t kVulkanMaxPresentWaitSemaphores = 8; // Present单次等待的信号量数
+constexpr uint32_t kVulkanPushConstantSize = 128;      // 推送常量大小（Vulkan保证的最小值）
+constexpr uint32_t kVulkanBarrierBatchSize = 32;       // 单次vkCmdPipelineBarrier的屏障数
+constexpr uint32_t kVulkanCopyBatchSize = 32;          // 单次复制命令的区域数
+constexpr uint32_t kVulkanMaxHostWaitSemaphores = kMaxWaitMultipleSemaphores;  // WaitMultiple单次等待的信号量数
+constexpr uint32_t kVulkanFlushBatchSize = 64;         // 单次vkFlushMappedMemoryRanges的范围数
+
+// 获取VkResult的名称
+inline const char* GetVkResultName(VkResult result) {
+    switch (result) {
+        case VK_SUCCESS: return "VK_SUCCESS";
+        case VK_NOT_READY: return "VK_NOT_READY";
+        case VK_TIMEOUT: return "VK_TIMEOUT";
+        case VK_INCOMPLETE: return "VK_INCOMPLETE";
+        case VK_ERROR_OUT_OF_HOST_MEMORY: return "VK_ERROR_OUT_OF_HOST_MEMORY";
+        case VK_ERROR_OUT_OF_DEVICE_MEMORY: return "VK_ERROR_OUT_OF_DEVICE_MEMORY";
+        case VK_ERROR_INITIALIZATION_FAILED: return "VK_ERROR_INITIALIZATION_FAILED";
+        case VK_ERROR_DEVICE_LOST: return "VK_ERROR_DEVICE_LOST";
+        case VK_ERROR_MEMORY_MAP_FAILED: return "VK_ERROR_MEMORY_MAP_FAILED";
+        case VK_ERROR_LAYER_NOT_PRESENT: return "VK_ERROR_LAYER_NOT_PRESENT";
+        case VK_ERROR_EXTENSION_NOT_PRESENT: return "VK_ERROR_EXTENSION_NOT_PRESENT";
+        case VK_ERROR_FEATURE_NOT_PRESENT: return "VK_ERROR_FEATURE_NOT_PRESENT";
+        case VK_ERROR_INCOMPATIBLE_DRIVER: return "VK_ERROR_INCOMPATIBLE_DRIVER";
+        case VK_ERROR_TOO_MANY_OBJECTS: return "VK_ERROR_TOO_MANY_OBJECTS";
+        case VK_ERROR_FORMAT_NOT_SUPPORTED: return "VK_ERROR_FORMAT_NOT_SUPPORTED";
+        case VK_ERROR_FRAGMENTED_POOL: return "VK_ERROR_FRAGMENTED_POOL";
+        case VK_ERROR_OUT_OF_POOL_MEMORY: return "VK_ERROR_OUT_OF_POOL_MEMORY";
+        case VK_ERROR_SURFACE_LOST_KHR: return "VK_ERROR_SURFACE_LOST_KHR";
+        case VK_SUBOPTIMAL_KHR: return "VK_SUBOPTIMAL_KHR";
+        case VK_ERROR_OUT_OF_DATE_KHR: return "VK_ERROR_OUT_OF_DATE_KHR";
+        default: return "VK_ERROR_UNKNOWN";
+    }
+}
+
+// 把VkResult转换为错误码
+inline ErrorCode GetVkErrorCode(VkResult result) {
+    switch (result) {
+        case VK_TIMEOUT:
+        case VK_NOT_READY:
+            return ErrorCode::TimeoutError;
+        case VK_ERROR_OUT_OF_HOST_MEMORY:
+        case VK_ERROR_OUT_OF_DEVICE_MEMORY:
+        case VK_ERROR_OUT_OF_POOL_MEMORY:
+        case VK_ERROR_FRAGMENTED_POOL:
+            return ErrorCode::OutOfMemory;
+        case VK_ERROR_DEVICE_LOST:
+            return ErrorCode::DeviceLost;
+        default:
+            return ErrorCode::VulkanError;
+    }
+}
+
+// 检查VkResult，失败时返回带调用名与VkResult名称的错误
+// 错误消息只在失败路径上构造
+#define RHI_VK_RETURN_IF_FAILED(expr) \
+    do { \
+        VkResult _vkResult = (expr); \
+        if (_vkResult != VK_SUCCESS) { \
+            return ::RHI::MakeErrorInfo(::RHI::GetVkErrorCode(_vkResult), \
+                std::string(#expr) + " 失败: " + ::RHI::GetVkResultName(_vkResult)); \
+        } \
+    } while (0)
+
+// 格式转换
+inline VkFormat ToVkFormat(Format format) {
+    switch (format) {
+        case Format::R8_UNORM: return VK_FORMAT_R8_UNORM;
+        case Format::R8_SNORM: return VK_FORMAT_R8_SNORM;
+        case Format::R8_UINT: return VK_FORMAT_R8_UINT;
+        case Format::R8_SINT: return VK_FORMAT_R8_SINT;
+        case Format::RG8_UNORM: return VK_FORMAT_R8G8_UNORM;
+        case Format::RG8_SNORM: return VK_FORMAT_R8G8_SNORM;
+        case Format::RG8_UINT: return VK_FORMAT_R8G8_UINT;
+        case Format::RG8_SINT: return VK_FORMAT_R8G8_SINT;
+        case Format::RGBA8_UNORM: return VK_FORMAT_R8G8B8A8_UNORM;
+        case Format::RGBA8_SNORM: return VK_FORMAT_R8G8B8A8_SNORM;
+        case Format::RGBA8_UINT: return VK_FORMAT_R8G8B8A8_UINT;
+        case Format::RGBA8_SINT: return VK_FORMAT_R8G8B8A8_SINT;
+        case Format::RGBA8_SRGB: return VK_FORMAT_R8G8B8A8_SRGB;
+        case Format::BGRA8_UNORM: return VK_FORMAT_B8G8R8A8_UNORM;
+        case Format::BGRA8_SRGB: return VK_FORMAT_B8G8R8A8_SRGB;
+        case Format::R16_UNORM: return VK_FORMAT_R16_UNORM;
+        case Format::R16_SNORM: return VK_FORMAT_R16_SNORM;
+        case Format::R16_UINT: return VK_FORMAT_R16_UINT;
+        case Format::R16_SINT: return VK_FORMAT_R16_SINT;
+        case Format::R16_FLOAT: return VK_FORMAT_R16_SFLOAT;
+        case Format::RG16_UNORM: return VK_FORMAT_R16G16_UNORM;
+        case Format::RG16_SNORM: return VK_FORMAT_R16G16_SNORM;
+        case Format::RG16_UINT: return VK_FORMAT_R16G16_UINT;
+        case Format::RG16_SINT: return VK_FORMAT_R16G16_SINT;
+        case Format::RG16_FLOAT: return VK_FORMAT_R16G16_SFLOAT;
+        case Format::RGBA16_UNORM: return VK_FORMAT_R16G16B16A16_UNORM;
+        case Format::RGBA16_SNORM: return VK_FORMAT_R16G16B16A16_SNORM;
+        case Format::RGBA16_UINT: return VK_FORMAT_R16G16B16A16_UINT;
+        case Format::RGBA16_SINT: return VK_FORMAT_R16G16B16A16_SINT;
+        case Format::RGBA16_FLOAT: return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case Format::R32_UINT: return VK_FORMAT_R32_UINT;
+        case Format::R32_SINT: return VK_FORMAT_R32_SINT;
+        case Format::R32_FLOAT: return VK_FORMAT_R32_SFLOAT;
+        case Format::RG32_UINT: return VK_FORMAT_R32G32_UINT;
+        case Format::RG32_SINT: return VK_FORMAT_R32G32_SINT;
+        case Format::RG32_FLOAT: return VK_FORMAT_R32G32_SFLOAT;
+        case Format::RGB32_UINT: return VK_FORMAT_R32G32B32_UINT;
+        case Format::RGB32_SINT: return VK_FORMAT_R32G32B32_SINT;
+        case Format::RGB32_FLOAT: return VK_FORMAT_R32G32B32_SFLOAT;
+        case Format::RGBA32_UINT: return VK_FORMAT_R32G32B32A32_UINT;
+        case Format::RGBA32_SINT: return VK_FORMAT_R32G32B32A32_SINT;
+        case Format::RGBA32_FLOAT: return VK_FORMAT_R32G32B32A32_SFLOAT;
+        case Format::RGB10A2_UNORM: return VK_FORMAT_A2B10G10R10_UNORM_PACK32;
+        case Format::RGB10A2_UINT: return VK_FORMAT_A2B10G10R10_UINT_PACK32;
+        case Format::RG11B10_FLOAT: return VK_FORMAT_B10G11R11_UFLOAT_PACK32;
+        case Format::RGB9E5_FLOAT: return VK_FORMAT_E5B9G9R9_UFLOAT_PACK32;
+        case Format::D16_UNORM: return VK_FORMAT_D16_UNORM;
+        case Format::D24_UNORM_S8_UINT: return VK_FORMAT_D24_UNORM_S8_UINT;
+        case Format::D32_FLOAT: return VK_FORMAT_D32_SFLOAT;
+        case Format::D32_FLOAT_S8_UINT: return VK_FORMAT_D32_SFLOAT_S8_UINT;
+        case Format::BC1_RGBA_UNORM: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case Format::BC1_RGBA_SRGB: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+        case Format::BC2_UNORM: return VK_FORMAT_BC2_UNORM_BLOCK;
+        case Format::BC2_SRGB: return VK_FORMAT_BC2_SRGB_BLOCK;
+        case Format::BC3_UNORM: return VK_FORMAT_BC3_UNORM_BLOCK;
+        case Format::BC3_SRGB: return VK_FORMAT_BC3_SRGB_BLOCK;
+        case Format::BC4_UNORM: return VK_FORMAT_BC4_UNORM_BLOCK;
+        case Format::BC4_SNORM: return VK_FORMAT_BC4_SNORM_BLOCK;
+        case Format::BC5_UNORM: return VK_FORMAT_BC5_UNORM_BLOCK;
+        case Format::BC5_SNORM: return VK_FORMAT_BC5_SNORM_BLOCK;
+        case Format::BC6H_UF16: return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+        case Format::BC6H_SF16: return VK_FORMAT_BC6H_SFLOAT_BLOCK;
+        case Format::BC7_UNORM: return VK_FORMAT_BC7_UNORM_BLOCK;
+        case Format::BC7_SRGB: return VK_FORMAT_BC7_SRGB_BLOCK;
+        case Format::ASTC_4x4_UNORM: return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+        case Format::ASTC_4x4_SRGB: return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
+        default: return VK_FORMAT_UNDEFINED;
+    }
+}
+
+// 判断格式是否为深度（或深度模板）格式
+inline bool IsDepthFormat(Format format) {
+    return format == Format::D16_UNORM || format == Format::D24_UNORM_S8_UINT ||
+        format == Format::D32_FLOAT || format == Format::D32_FLOAT_S8_UINT;
+}
+
+// 判断格式是否带模板分量
+inline bool IsStencilFormat(Format format) {
+    return format == Format::D24_UNORM_S8_UINT || format == Format::D32_FLOAT_S8_UINT;
+}
+
+// 格式的图像方面
+inline VkImageAspectFlags GetVkImageAspect(Format format) {
+    if (!IsDepthFormat(format)) {
+        return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+    return IsStencilFormat(format)
+        ? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT
+        : VK_IMAGE_ASPECT_DEPTH_BIT;
+}
+
+// 子资源范围转换
+inline VkImageSubresourceRange ToVkSubresourceRange(const TextureSubresourceRange& range, Format format) {
+    VkImageSubresourceRange result = {};
+    result.aspectMask = GetVkImageAspect(format);
+    result.baseMipLevel = range.baseMipLevel;
+    result.levelCount = range.mipLevelCount;
+    result.baseArrayLayer = range.baseArrayLayer;
+    result.layerCount = range.arrayLayerCount;
+    return result;
+}
+
+// 图像布局对应的访问掩码
+inline VkAccessFlags GetVkLayoutAccess(VkImageLayout layout) {
+    switch (layout) {
+        case VK_IMAGE_LAYOUT_UNDEFINED:
+        case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
+            return 0;
+        case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+            return VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+            return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+            return VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+            return VK_ACCESS_SHADER_READ_BIT;
+        case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+            return VK_ACCESS_TRANSFER_READ_BIT;
+        case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+            return VK_ACCESS_TRANSFER_WRITE_BIT;
+        default:
+            return VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    }
+}
+
+// 资源状态对应的访问掩码（用于缓冲区屏障）
+inline VkAccessFlags ToVkAccessFlags(ResourceState state) {
+    VkAccessFlags access = 0;
+    if (HasAnyState(state, ResourceState::VertexBuffer)) {
+        access |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+    }
+    if (HasAnyState(state, ResourceState::IndexBuffer)) {
+        access |= VK_ACCESS_INDEX_READ_BIT;
+    }
+    if (HasAnyState(state, ResourceState::ConstantBuffer)) {
+        access |= VK_ACCESS_UNIFORM_READ_BIT;
+    }
+    if (HasAnyState(state, ResourceState::IndirectArgument)) {
+        access |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    }
+    if (HasAnyState(state, ResourceState::ShaderResource)) {
+        access |= VK_ACCESS_SHADER_READ_BIT;
+    }
+    if (HasAnyState(state, ResourceState::UnorderedAccess)) {
+        access |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    }
+    if (HasAnyState(state, ResourceState::RenderTarget)) {
+        access |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    }
+    if (HasAnyState(state, ResourceState::DepthWrite)) {
+        access |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    }
+    if (HasAnyState(state, ResourceState::DepthRead)) {
+        access |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+    }
+    if (HasAnyState(state, ResourceState::CopySource)) {
+        access |= VK_ACCESS_TRANSFER_READ_BIT;
+    }
+    if (HasAnyState(state, ResourceState::CopyDest)) {
+        access |= VK_ACCESS_TRANSFER_WRITE_BIT;
+    }
+    if (HasAnyState(state, ResourceState::Common)) {
+        access |= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    }
+    return access;
+}
+
+// 资源状态对应的图像布局（组合的只读状态除深度+着色器只读外使用GENERAL）
+inline VkImageLayout ToVkImageLayout(ResourceState state) {
+    switch (state) {
+        case ResourceState::Undefined:
+            return VK_IMAGE_LAYOUT_UNDEFINED;
+        case ResourceState::RenderTarget:
+            return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        case ResourceState::DepthWrite:
+            return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        case ResourceState::DepthRead:
+            return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        case ResourceState::ShaderResource:
+            return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        case ResourceState::CopySource:
+            return VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        case ResourceState::CopyDest:
+            return VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        case ResourceState::Present:
+            return VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        default:
+            if (state == (ResourceState::DepthRead | ResourceState::ShaderResource)) {
+                return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+            }
+            return VK_IMAGE_LAYOUT_GENERAL;
+    }
+}
+
+// 管线阶段对应的阶段掩码（None视为所有阶段）
+inline VkPipelineStageFlags ToVkPipelineStageFlags(PipelineStage stages) {
+    if (stages == PipelineStage::None || (stages & PipelineStage::AllCommands) != PipelineStage::None) {
+        return VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+    VkPipelineStageFlags flags = 0;
+    if ((stages & PipelineStage::DrawIndirect) != PipelineStage::None) {
+        flags |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    }
+    if ((stages & PipelineStage::VertexInput) != PipelineStage::None) {
+        flags |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    }
+    if ((stages & PipelineStage::VertexShader) != PipelineStage::None) {
+        flags |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+    }
+    if ((stages & PipelineStage::PixelShader) != PipelineStage::None) {
+        flags |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    }
+    if ((stages & PipelineStage::DepthStencil) != PipelineStage::None) {
+        flags |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    }
+    if ((stages & PipelineStage::RenderTarget) != PipelineStage::None) {
+        flags |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
+    if ((stages & PipelineStage::ComputeShader) != PipelineStage::None) {
+        flags |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    }
+    if ((stages & PipelineStage::Copy) != PipelineStage::None) {
+        flags |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
+    return flags;
+}
+
+// 访问掩码对应的管线阶段（access为0时返回srcStage约定的TOP_OF_PIPE）
+inline VkPipelineStageFlags GetVkAccessStages(VkAccessFlags access) {
+    if (access == 0) {
+        return VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    }
+    VkPipelineStageFlags stages = 0;
+    if (access & VK_ACCESS_INDIRECT_COMMAND_READ_BIT) {
+        stages |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+    }
+    if (access & (VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT)) {
+        stages |= VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    }
+    if (access & (VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT)) {
+        stages |= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    }
+    if (access & VK_ACCESS_INPUT_ATTACHMENT_READ_BIT) {
+        stages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    }
+    if (access & (VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT)) {
+        stages |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    }
+    if (access & (VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT)) {
+        stages |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    }
+    if (access & (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT)) {
+        stages |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+    }
+    if (access & (VK_ACCESS_HOST_READ_BIT | VK_ACCESS_HOST_WRITE_BIT)) {
+        stages |= VK_PIPELINE_STAGE_HOST_BIT;
+    }
+    if (access & (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)) {
+        stages |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
+    return stages != 0 ? stages : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+}
+
+// 缓冲区用途转换
+inline VkBufferUsageFlags ToVkBufferUsage(BufferUsage usage) {
+    // 复制总是允许，UpdateData与回读依赖传输用途
+    VkBufferUsageFlags flags = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    auto has = [usage](BufferUsage bit) { return (usage & bit) != BufferUsage::None; };
+    if (has(BufferUsage::VertexBuffer)) flags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    if (has(BufferUsage::IndexBuffer)) flags |= VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    if (has(BufferUsage::ConstantBuffer)) flags |= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    if (has(BufferUsage::ShaderResource) || has(BufferUsage::UnorderedAccess)) {
+        flags |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
+    if (has(BufferUsage::IndirectArgs)) flags |= VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    return flags;
+}
+
+// 纹理用途转换
+inline VkImageUsageFlags ToVkImageUsage(TextureUsage usage) {
+    auto has = [usage](TextureUsage bit) { return (usage & bit) != TextureUsage::None; };
+    // 复制总是允许，UpdateData与GenerateMips依赖传输用途；瞬态附件只能带附件用途
+    VkImageUsageFlags flags = has(TextureUsage::Transient)
+        ? VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT
+        : VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    if (has(TextureUsage::ShaderResource)) flags |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    if (has(TextureUsage::RenderTarget)) flags |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    if (has(TextureUsage::DepthStencil)) flags |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    if (has(TextureUsage::UnorderedAccess)) flags |= VK_IMAGE_USAGE_STORAGE_BIT;
+    return flags;
+}
+
+// 着色器阶段转换
+inline VkShaderStageFlags ToVkShaderStages(ShaderStageFlag stages) {
+    uint32_t bits = static_cast<uint32_t>(stages);
+    if (bits == static_cast<uint32_t>(ShaderStageFlag::All)) {
+        return VK_SHADER_STAGE_ALL;
+    }
+    VkShaderStageFlags flags = 0;
+    if (bits & static_cast<uint32_t>(ShaderStageFlag::Vertex)) flags |= VK_SHADER_STAGE_VERTEX_BIT;
+    if (bits & static_cast<uint32_t>(ShaderStageFlag::Hull)) flags |= VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+    if (bits & static_cast<uint32_t>(ShaderStageFlag::Domain)) flags |= VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+    if (bits & static_cast<uint32_t>(ShaderStageFlag::Geometry)) flags |= VK_SHADER_STAGE_GEOMETRY_BIT;
+    if (bits & static_cast<uint32_t>(ShaderStageFlag::Pixel)) flags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+    if (bits & static_cast<uint32_t>(ShaderStageFlag::Compute)) flags |= VK_SHADER_STAGE_COMPUTE_BIT;
+    return flags;
+}
+
+// 描述符类型转换
+inline VkDescriptorType ToVkDescriptorType(DescriptorType type) {
+    switch (type) {
+        case DescriptorType::UniformBuffer: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        case DescriptorType::StorageBuffer: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        case DescriptorType::Texture: return VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        case DescriptorType::StorageTexture: return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        case DescriptorType::Sampler: return VK_DESCRIPTOR_TYPE_SAMPLER;
+        case DescriptorType::InputAttachment: return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        case DescriptorType::UniformBufferDynamic: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        case DescriptorType::StorageBufferDynamic: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+    }
+    return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+}
+
+// 比较操作转换
+inline VkCompareOp ToVkCompareOp(DepthStencilState::CompareOp op) {
+    switch (op) {
+        case DepthStencilState::CompareOp::Never: return VK_COMPARE_OP_NEVER;
+        case DepthStencilState::CompareOp::Less: return VK_COMPARE_OP_LESS;
+        case DepthStencilState::CompareOp::Equal: return VK_COMPARE_OP_EQUAL;
+        case DepthStencilState::CompareOp::LessOrEqual: return VK_COMPARE_OP_LESS_OR_EQUAL;
+        case DepthStencilState::CompareOp::Greater: return VK_COMPARE_OP_GREATER;
+        case DepthStencilState::CompareOp::NotEqual: return VK_COMPARE_OP_NOT_EQUAL;
+        case DepthStencilState::CompareOp::GreaterOrEqual: return VK_COMPARE_OP_GREATER_OR_EQUAL;
+        case DepthStencilState::CompareOp::Always: return VK_COMPARE_OP_ALWAYS;
+    }
+    return VK_COMPARE_OP_ALWAYS;
+}
+
+// 模板操作转换
+inline VkStencilOp ToVkStencilOp(DepthStencilState::StencilOpState::Op op) {
+    using Op = DepthStencilState::StencilOpState::Op;
+    switch (op) {
+        case Op::Keep: return VK_STENCIL_OP_KEEP;
+        case Op::Zero: return VK_STENCIL_OP_ZERO;
+        case Op::Replace: return VK_STENCIL_OP_REPLACE;
+        case Op::IncrementClamp: return VK_STENCIL_OP_INCREMENT_AND_CLAMP;
+        case Op::DecrementClamp: return VK_STENCIL_OP_DECREMENT_AND_CLAMP;
+        case Op::Invert: return VK_STENCIL_OP_INVERT;
+        case Op::IncrementWrap: return VK_STENCIL_OP_INCREMENT_AND_WRAP;
+        case Op::DecrementWrap: return VK_STENCIL_OP_DECREMENT_AND_WRAP;
+    }
+    return VK_STENCIL_OP_KEEP;
+}
+
+inline VkStencilOpState ToVkStencilOpState(const DepthStencilState::StencilOpState& state) {
+    VkStencilOpState result = {};
+    result.failOp = ToVkStencilOp(state.failOp);
+    result.passOp = ToVkStencilOp(state.passOp);
+    result.depthFailOp = ToVkStencilOp(state.depthFailOp);
+    result.compareOp = ToVkCompareOp(state.compareOp);
+    result.compareMask = state.compareMask;
+    result.writeMask = state.writeMask;
+    result.reference = state.reference;
+    return result;
+}
+
+// 混合因子转换
+inline VkBlendFactor ToVkBlendFactor(BlendState::BlendFactor factor) {
+    using Factor = BlendState::BlendFactor;
+    switch (factor) {
+        case Factor::Zero: return VK_BLEND_FACTOR_ZERO;
+        case Factor::One: return VK_BLEND_FACTOR_ONE;
+        case Factor::SrcColor: return VK_BLEND_FACTOR_SRC_COLOR;
+        case Factor::OneMinusSrcColor: return VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR;
+        case Factor::DstColor: return VK_BLEND_FACTOR_DST_COLOR;
+        case Factor::OneMinusDstColor: return VK_BLEND_FACTOR_ONE_MINUS_DST_COLOR;
+        case Factor::SrcAlpha: return VK_BLEND_FACTOR_SRC_ALPHA;
+        case Factor::OneMinusSrcAlpha: return VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        case Factor::DstAlpha: return VK_BLEND_FACTOR_DST_ALPHA;
+        case Factor::OneMinusDstAlpha: return VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA;
+        case Factor::ConstantColor: return VK_BLEND_FACTOR_CONSTANT_COLOR;
+        case Factor::OneMinusConstantColor: return VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_COLOR;
+        case Factor::ConstantAlpha: return VK_BLEND_FACTOR_CONSTANT_ALPHA;
+        case Factor::OneMinusConstantAlpha: return VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_ALPHA;
+        case Factor::SrcAlphaSaturate: return VK_BLEND_FACTOR_SRC_ALPHA_SATURATE;
+    }
+    return VK_BLEND_FACTOR_ONE;
+}
+
+// 混合操作转换
+inline VkBlendOp ToVkBlendOp(BlendState::BlendOp op) {
+    switch (op) {
+        case BlendState::BlendOp::Add: return VK_BLEND_OP_ADD;
+        case BlendState::BlendOp::Subtract: return VK_BLEND_OP_SUBTRACT;
+        case BlendState::BlendOp::ReverseSubtract: return VK_BLEND_OP_REVERSE_SUBTRACT;
+        case BlendState::BlendOp::Min: return VK_BLEND_OP_MIN;
+        case BlendState::BlendOp::Max: return VK_BLEND_OP_MAX;
+    }
+    return VK_BLEND_OP_ADD;
+}
+
+// 逻辑操作转换（枚举顺序与VkLogicOp一致）
+inline VkLogicOp ToVkLogicOp(BlendState::LogicOp op) {
+    return static_cast<VkLogicOp>(static_cast<uint32_t>(op));
+}
+
+// 过滤模式转换
+inline VkFilter ToVkFilter(FilterMode mode) {
+    switch (mode) {
+        case FilterMode::Nearest:
+        case FilterMode::NearestMipmapNearest:
+        case FilterMode::NearestMipmapLinear:
+            return VK_FILTER_NEAREST;
+        default:
+            return VK_FILTER_LINEAR;
+    }
+}
+
+inline VkSamplerMipmapMode ToVkMipmapMode(FilterMode mode) {
+    switch (mode) {
+        case FilterMode::Nearest:
+        case FilterMode::NearestMipmapNearest:
+        case FilterMode::LinearMipmapNearest:
+            return VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        default:
+            return VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    }
+}
+
+// 寻址模式转换
+inline VkSamplerAddressMode ToVkAddressMode(AddressMode mode) {
+    switch (mode) {
+        case AddressMode::Repeat: return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        case AddressMode::MirrorRepeat: return VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+        case AddressMode::ClampToEdge: return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        case AddressMode::ClampToBorder: return VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+        case AddressMode::MirrorClampToEdge: return VK_SAMPLER_ADDRESS_MODE_MIRROR_CLAMP_TO_EDGE;
+    }
+    return VK_SAMPLER_ADDRESS_MODE_REPEAT;
+}
+
+// 内存类型对应的必需与优先内存属性
+inline void GetVkMemoryProperties(MemoryType type, bool allowCPUAccess,
+    VkMemoryPropertyFlags& required, VkMemoryPropertyFlags& preferred) {
+    switch (type) {
+        case MemoryType::Upload:
+            required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            preferred = 0;
+            break;
+        case MemoryType::Readback:
+            required = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+            preferred = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+            break;
+        default:
+            required = allowCPUAccess
+                ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+                : 0;
+            preferred = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            break;
+    }
+}
+
+// 内存属性标志转换
+inline VkMemoryPropertyFlags ToVkMemoryProperties(MemoryPropertyFlag flags) {
+    uint32_t bits = static_cast<uint32_t>(flags);
+    VkMemoryPropertyFlags result = 0;
+    if (bits & static_cast<uint32_t>(MemoryPropertyFlag::DeviceLocal)) result |= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    if (bits & static_cast<uint32_t>(MemoryPropertyFlag::HostVisible)) result |= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    if (bits & static_cast<uint32_t>(MemoryPropertyFlag::HostCoherent)) result |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    if (bits & static_cast<uint32_t>(MemoryPropertyFlag::HostCached)) result |= VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+    if (bits & static_cast<uint32_t>(MemoryPropertyFlag::LazilyAllocated)) result |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+    if (bits & static_cast<uint32_t>(MemoryPropertyFlag::Protected)) result |= VK_MEMORY_PROPERTY_PROTECTED_BIT;
+    return result;
+}
+
+// 在memoryTypeBits中查找满足属性的内存类型（优先同时满足preferred），找不到时返回UINT32_MAX
+inline uint32_t FindVkMemoryType(const VkPhysicalDeviceMemoryProperties& properties, uint32_t memoryTypeBits,
+    VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred) {
+    uint32_t fallback = UINT32_MAX;
+    for (uint32_t i = 0; i < properties.memoryTypeCount; ++i) {
+        if ((memoryTypeBits & (1u << i)) == 0) {
+            continue;
+        }
+        VkMemoryPropertyFlags flags = properties.memoryTypes[i].propertyFlags;
+        if ((flags & required) != required) {
+            continue;
+        }
+        if ((flags & preferred) == preferred) {
+            return i;
+        }
+        if (fallback == UINT32_MAX) {
+            fallback = i;
+        }
+    }
+    return fallback;
+}
+
+} // namespace RHI
@@ -0,0 +1,152 @@
+#pragma once
+#include "VulkanCommon.h"
+#include "Adapter.h"
+#include <functional>
+#include <mutex>
+
+namespace RHI {
+
+// Vulkan设备共享上下文
+// 由VulkanDevice拥有，资源对象通过它访问设备句柄、内存属性与即时提交。
+// 即时提交只用于UpdateData/GenerateMips/TransitionLayout等资源级操作，不在录制路径上。
+class VulkanContext {
+public:
+    VulkanContext(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t queueFamily, VkQueue queue)
+        : m_physicalDevice(physicalDevice)
+        , m_device(device)
+        , m_queueFamily(queueFamily)
+        , m_queue(queue) {
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_memoryProperties);
+        vkGetPhysicalDeviceProperties(physicalDevice, &m_properties);
+    }
+
+    ~VulkanContext() {
+        if (m_immediateFence != VK_NULL_HANDLE) {
+            vkDestroyFence(m_device, m_immediateFence, nullptr);
+        }
+        if (m_immediatePool != VK_NULL_HANDLE) {
+            vkDestroyCommandPool(m_device, m_immediatePool, nullptr);
+        }
+    }
+
+    VulkanContext(const VulkanContext&) = delete;
+    VulkanContext& operator=(const VulkanContext&) = delete;
+
+    VkPhysicalDevice GetPhysicalDevice() const { return m_physicalDevice; }
+    VkDevice GetDevice() const { return m_device; }
+    const VkPhysicalDeviceMemoryProperties& GetMemoryProperties() const { return m_memoryProperties; }
+    const VkPhysicalDeviceProperties& GetProperties() const { return m_properties; }
+
+    // 设置各队列类型使用的队列族（队列所有权转移时查询）
+    void SetQueueFamilies(uint32_t graphics, uint32_t compute, uint32_t transfer) {
+        m_graphicsFamily = graphics;
+        m_computeFamily = compute;
+        m_transferFamily = transfer;
+    }
+
+    uint32_t GetQueueFamily(QueueType type) const {
+        switch (type) {
+            case QueueType::Compute: return m_computeFamily;
+            case QueueType::Transfer: return m_transferFamily;
+            default: return m_graphicsFamily;
+        }
+    }
+
+    // 设置即时提交所用队列的互斥量（与该队列的VulkanQueue共享，保证vkQueueSubmit的外部同步）
+    void SetQueueMutex(std::mutex* queueMutex) { m_queueMutex = queueMutex; }
+
+    // 分配满足要求的设备内存
+    Result<VkDeviceMemory> AllocateMemory(
+        const VkMemoryRequirements& requirements,
+        VkMemoryPropertyFlags required,
+        VkMemoryPropertyFlags preferred,
+        uint32_t* memoryTypeIndex = nullptr) {
+        uint32_t typeIndex = FindVkMemoryType(m_memoryProperties, requirements.memoryTypeBits, required, preferred);
+        RHI_RETURN_IF_FALSE(typeIndex != UINT32_MAX,
+            ErrorCode::OutOfMemory,
+            "找不到满足要求的Vulkan内存类型");
+
+        VkMemoryAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.allocationSize = requirements.size;
+        allocateInfo.memoryTypeIndex = typeIndex;
+
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        RHI_VK_RETURN_IF_FAILED(vkAllocateMemory(m_device, &allocateInfo, nullptr, &memory));
+        if (memoryTypeIndex != nullptr) {
+            *memoryTypeIndex = typeIndex;
+        }
+        return MakeSuccessResult(memory);
+    }
+
+    // 判断内存类型是否主机可见
+    bool IsHostVisible(uint32_t memoryTypeIndex) const {
+        return (m_memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags &
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    }
+
+    // 录制并同步执行一段命令
+    Result<void> ImmediateSubmit(const std::function<void(VkCommandBuffer)>& record) {
+        std::lock_guard<std::mutex> lock(m_immediateMutex);
+        if (m_immediatePool == VK_NULL_HANDLE) {
+            VkCommandPoolCreateInfo poolInfo = {};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = m_queueFamily;
+            RHI_VK_RETURN_IF_FAILED(vkCreateCommandPool(m_device, &poolInfo, nullptr, &m_immediatePool));
+
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.commandPool = m_immediatePool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+            RHI_VK_RETURN_IF_FAILED(vkAllocateCommandBuffers(m_device, &allocateInfo, &m_immediateCommandBuffer));
+
+            VkFenceCreateInfo fenceInfo = {};
+            fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            RHI_VK_RETURN_IF_FAILED(vkCreateFence(m_device, &fenceInfo, nullptr, &m_immediateFence));
+        }
+
+        RHI_VK_RETURN_IF_FAILED(vkResetCommandPool(m_device, m_immediatePool, 0));
+        VkCommandBufferBeginInfo beginInfo = {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        RHI_VK_RETURN_IF_FAILED(vkBeginCommandBuffer(m_immediateCommandBuffer, &beginInfo));
+        record(m_immediateCommandBuffer);
+        RHI_VK_RETURN_IF_FAILED(vkEndCommandBuffer(m_immediateCommandBuffer));
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &m_immediateCommandBuffer;
+        {
+            std::unique_lock<std::mutex> queueLock;
+            if (m_queueMutex != nullptr) {
+                queueLock = std::unique_lock<std::mutex>(*m_queueMutex);
+            }
+            RHI_VK_RETURN_IF_FAILED(vkQueueSubmit(m_queue, 1, &submitInfo, m_immediateFence));
+        }
+        RHI_VK_RETURN_IF_FAILED(vkWaitForFences(m_device, 1, &m_immediateFence, VK_TRUE, UINT64_MAX));
+        RHI_VK_RETURN_IF_FAILED(vkResetFences(m_device, 1, &m_immediateFence));
+        return MakeSuccessResult();
+    }
+
+private:
+    VkPhysicalDevice m_physicalDevice;
+    VkDevice m_device;
+    uint32_t m_queueFamily;
+    VkQueue m_queue;
+    uint32_t m_graphicsFamily = 0;
+    uint32_t m_computeFamily = 0;
+    uint32_t m_transferFamily = 0;
+    VkPhysicalDeviceMemoryProperties m_memoryProperties = {};
+    VkPhysicalDeviceProperties m_properties = {};
+
+    std::mutex m_immediateMutex;
+    std::mutex* m_queueMutex = nullptr;
+    VkCommandPool m_immediatePool = VK_NULL_HANDLE;
+    VkCommandBuffer m_immediateCommandBuffer = VK_NULL_HANDLE;
+    VkFence m_immediateFence = VK_NULL_HANDLE;
+};
+
+} // namespace RHI
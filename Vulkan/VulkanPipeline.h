@@ -0,0 +1,587 @@
+#pragma once
+#include "VulkanResources.h"
+#include "Shader.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace RHI {
+
+// Vulkan着色器（仅接受SPIR-V字节码）
+class VulkanShader : public IShader {
+public:
+    VulkanShader(VulkanContext& context, const ShaderDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    ~VulkanShader() override {
+        if (m_module != VK_NULL_HANDLE) {
+            vkDestroyShaderModule(m_context.GetDevice(), m_module, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        RHI_RETURN_IF_FALSE(m_desc.language == ShaderLanguage::SPIR_V,
+            ErrorCode::NotImplemented,
+            "Vulkan后端只接受SPIR-V字节码");
+        RHI_VALIDATE(!m_desc.code.empty() && m_desc.code.size() % 4 == 0,
+            ErrorCode::InvalidArgument,
+            "SPIR-V字节码大小必须为4的倍数且不为0");
+
+        VkShaderModuleCreateInfo moduleInfo = {};
+        moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = m_desc.code.size();
+        moduleInfo.pCode = reinterpret_cast<const uint32_t*>(m_desc.code.data());
+        RHI_VK_RETURN_IF_FAILED(vkCreateShaderModule(m_context.GetDevice(), &moduleInfo, nullptr, &m_module));
+        return MakeSuccessResult();
+    }
+
+    const ShaderDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_module));
+    }
+
+    Result<ShaderReflection> GetReflection() const override {
+        return MakeErrorResult<ShaderReflection>(
+            ErrorCode::NotImplemented,
+            "Vulkan后端未实现SPIR-V反射");
+    }
+
+    VkShaderModule GetVkModule() const { return m_module; }
+
+    VkShaderStageFlagBits GetVkStage() const {
+        switch (m_desc.type) {
+            case ShaderType::Vertex: return VK_SHADER_STAGE_VERTEX_BIT;
+            case ShaderType::Pixel: return VK_SHADER_STAGE_FRAGMENT_BIT;
+            case ShaderType::Geometry: return VK_SHADER_STAGE_GEOMETRY_BIT;
+            case ShaderType::Hull: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+            case ShaderType::Domain: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+            case ShaderType::Compute: return VK_SHADER_STAGE_COMPUTE_BIT;
+            default: return VK_SHADER_STAGE_VERTEX_BIT;
+        }
+    }
+
+private:
+    VulkanContext& m_context;
+    VkShaderModule m_module = VK_NULL_HANDLE;
+};
+
+// Vulkan描述符集布局
+// 每个DescriptorRange对应一个绑定：binding为baseRegister，数量为count
+class VulkanDescriptorSetLayout : public IDescriptorSetLayout {
+public:
+    VulkanDescriptorSetLayout(VulkanContext& context, const DescriptorSetLayoutDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    ~VulkanDescriptorSetLayout() override {
+        if (m_layout != VK_NULL_HANDLE) {
+            vkDestroyDescriptorSetLayout(m_context.GetDevice(), m_layout, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        RHI_RETURN_IF_FALSE(!m_desc.pushDescriptor,
+            ErrorCode::NotImplemented,
+            "Vulkan后端未实现推送描述符");
+
+        std::vector<VkDescriptorSetLayoutBinding> bindings(m_desc.ranges.size());
+        for (size_t i = 0; i < m_desc.ranges.size(); ++i) {
+            const DescriptorRange& range = m_desc.ranges[i];
+            bindings[i] = {};
+            bindings[i].binding = range.baseRegister;
+            bindings[i].descriptorType = ToVkDescriptorType(range.type);
+            bindings[i].descriptorCount = range.count;
+            bindings[i].stageFlags = ToVkShaderStages(range.stages);
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+        RHI_VK_RETURN_IF_FAILED(vkCreateDescriptorSetLayout(m_context.GetDevice(), &layoutInfo, nullptr, &m_layout));
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_layout));
+    }
+
+    const DescriptorSetLayoutDesc& GetDesc() const override { return m_desc; }
+
+    VkDescriptorSetLayout GetVkLayout() const { return m_layout; }
+
+private:
+    VulkanContext& m_context;
+    VkDescriptorSetLayout m_layout = VK_NULL_HANDLE;
+};
+
+// Vulkan描述符集（由描述符池拥有）
+// 描述符约定：DescriptorWrite::bufferInfo为VulkanBufferView*，imageInfo为VulkanTextureView*；
+// Sampler类型使用纹理视图所属纹理的采样器
+class VulkanDescriptorSet : public IDescriptorSet {
+public:
+    VulkanDescriptorSet(VulkanContext& context, VulkanDescriptorSetLayout* layout, VkDescriptorSet set)
+        : m_context(context)
+        , m_layout(layout)
+        , m_set(set) {}
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_set));
+    }
+
+    Result<void> UpdateDescriptor(const std::vector<DescriptorWrite>& writes) override {
+        // 信息数组先整体扩容，避免写入结构中的指针失效
+        m_writes.resize(writes.size());
+        m_bufferInfos.resize(writes.size());
+        m_imageInfos.resize(writes.size());
+
+        for (size_t i = 0; i < writes.size(); ++i) {
+            const DescriptorWrite& write = writes[i];
+            VkWriteDescriptorSet& vkWrite = m_writes[i];
+            vkWrite = {};
+            vkWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            vkWrite.dstSet = m_set;
+            vkWrite.dstBinding = write.dstBinding;
+            vkWrite.dstArrayElement = write.dstArrayElement;
+            vkWrite.descriptorCount = 1;
+            vkWrite.descriptorType = ToVkDescriptorType(write.type);
+
+            switch (write.type) {
+                case DescriptorType::UniformBuffer:
+                case DescriptorType::StorageBuffer:
+                case DescriptorType::UniformBufferDynamic:
+                case DescriptorType::StorageBufferDynamic: {
+                    auto* view = static_cast<const VulkanBufferView*>(write.bufferInfo);
+                    RHI_VALIDATE(view != nullptr, ErrorCode::InvalidArgument, "缓冲区描述符缺少bufferInfo");
+                    m_bufferInfos[i] = {view->handle, view->desc.offset, view->desc.size};
+                    vkWrite.pBufferInfo = &m_bufferInfos[i];
+                    break;
+                }
+                default: {
+                    auto* view = static_cast<const VulkanTextureView*>(write.imageInfo);
+                    RHI_VALIDATE(view != nullptr, ErrorCode::InvalidArgument, "图像描述符缺少imageInfo");
+                    VkDescriptorImageInfo& imageInfo = m_imageInfos[i];
+                    imageInfo = {};
+                    if (write.type == DescriptorType::Sampler) {
+                        RHI_VALIDATE(view->sampler != VK_NULL_HANDLE,
+                            ErrorCode::InvalidArgument,
+                            "纹理没有采样器（需要ShaderResource用途）");
+                        imageInfo.sampler = view->sampler;
+                    } else {
+                        imageInfo.imageView = view->handle;
+                        imageInfo.imageLayout = write.type == DescriptorType::StorageTexture
+                            ? VK_IMAGE_LAYOUT_GENERAL
+                            : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                    }
+                    vkWrite.pImageInfo = &imageInfo;
+                    break;
+                }
+            }
+        }
+
+        vkUpdateDescriptorSets(m_context.GetDevice(),
+            static_cast<uint32_t>(m_writes.size()), m_writes.data(), 0, nullptr);
+        return MakeSuccessResult();
+    }
+
+    Result<IDescriptorSetLayout*> GetLayout() const override {
+        return MakeSuccessResult(static_cast<IDescriptorSetLayout*>(m_layout));
+    }
+
+    VkDescriptorSet GetVkSet() const { return m_set; }
+
+private:
+    VulkanContext& m_context;
+    VulkanDescriptorSetLayout* m_layout;
+    VkDescriptorSet m_set;
+    std::vector<VkWriteDescriptorSet> m_writes;
+    std::vector<VkDescriptorBufferInfo> m_bufferInfos;
+    std::vector<VkDescriptorImageInfo> m_imageInfos;
+};
+
+// Vulkan描述符池
+class VulkanDescriptorPool : public IDescriptorPool {
+public:
+    VulkanDescriptorPool(VulkanContext& context, const DescriptorPoolDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    ~VulkanDescriptorPool() override {
+        m_sets.clear();
+        if (m_pool != VK_NULL_HANDLE) {
+            vkDestroyDescriptorPool(m_context.GetDevice(), m_pool, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_desc.maxSets > 0, ErrorCode::InvalidArgument, "描述符池的maxSets必须大于0");
+
+        std::vector<VkDescriptorPoolSize> poolSizes;
+        for (const DescriptorPoolSize& size : m_desc.poolSizes) {
+            poolSizes.push_back({ToVkDescriptorType(size.type), size.count});
+        }
+        if (poolSizes.empty()) {
+            // 未指定时为每种常用类型各预留maxSets个
+            poolSizes.push_back({VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, m_desc.maxSets});
+            poolSizes.push_back({VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, m_desc.maxSets});
+            poolSizes.push_back({VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, m_desc.maxSets});
+            poolSizes.push_back({VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, m_desc.maxSets});
+            poolSizes.push_back({VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, m_desc.maxSets});
+            poolSizes.push_back({VK_DESCRIPTOR_TYPE_SAMPLER, m_desc.maxSets});
+        }
+
+        VkDescriptorPoolCreateInfo poolInfo = {};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = m_desc.freeDescriptorSet ? VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT : 0;
+        poolInfo.maxSets = m_desc.maxSets;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        RHI_VK_RETURN_IF_FAILED(vkCreateDescriptorPool(m_context.GetDevice(), &poolInfo, nullptr, &m_pool));
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_pool));
+    }
+
+    Result<IDescriptorSet*> AllocateDescriptorSet(IDescriptorSetLayout* layout) override {
+        RHI_VALIDATE(layout != nullptr, ErrorCode::InvalidArgument, "描述符集布局不能为空");
+        auto* vulkanLayout = static_cast<VulkanDescriptorSetLayout*>(layout);
+        VkDescriptorSetLayout setLayout = vulkanLayout->GetVkLayout();
+
+        VkDescriptorSetAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorPool = m_pool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &setLayout;
+
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        RHI_VK_RETURN_IF_FAILED(vkAllocateDescriptorSets(m_context.GetDevice(), &allocateInfo, &set));
+        m_sets.push_back(std::make_unique<VulkanDescriptorSet>(m_context, vulkanLayout, set));
+        return MakeSuccessResult(static_cast<IDescriptorSet*>(m_sets.back().get()));
+    }
+
+    Result<void> FreeDescriptorSet(IDescriptorSet* descriptorSet) override {
+        RHI_VALIDATE(m_desc.freeDescriptorSet,
+            ErrorCode::InvalidOperation,
+            "描述符池不支持释放单个描述符集");
+        auto it = std::find_if(m_sets.begin(), m_sets.end(),
+            [descriptorSet](const std::unique_ptr<VulkanDescriptorSet>& set) {
+                return set.get() == descriptorSet;
+            });
+        RHI_RETURN_IF_FALSE(it != m_sets.end(),
+            ErrorCode::InvalidArgument,
+            "描述符集不属于此描述符池");
+        VkDescriptorSet set = (*it)->GetVkSet();
+        RHI_VK_RETURN_IF_FAILED(vkFreeDescriptorSets(m_context.GetDevice(), m_pool, 1, &set));
+        m_sets.erase(it);
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        m_sets.clear();
+        RHI_VK_RETURN_IF_FAILED(vkResetDescriptorPool(m_context.GetDevice(), m_pool, 0));
+        return MakeSuccessResult();
+    }
+
+private:
+    VulkanContext& m_context;
+    VkDescriptorPool m_pool = VK_NULL_HANDLE;
+    std::vector<std::unique_ptr<VulkanDescriptorSet>> m_sets;
+};
+
+// Vulkan管线状态
+// 每个管线从PipelineLayoutDesc创建自己的VkPipelineLayout，并附带一个对所有阶段可见的
+// kVulkanPushConstantSize字节推送常量范围。图形管线使用动态渲染（不需要VkRenderPass），
+// 视口与裁剪矩形为动态状态；PipelineStateDesc::renderPass/subpass被忽略。
+class VulkanPipelineState : public IPipelineState {
+public:
+    VulkanPipelineState(VulkanContext& context, const PipelineStateDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+        m_desc.pipelineLayout = nullptr;
+    }
+
+    ~VulkanPipelineState() override {
+        VkDevice device = m_context.GetDevice();
+        if (m_pipeline != VK_NULL_HANDLE) {
+            vkDestroyPipeline(device, m_pipeline, nullptr);
+        }
+        if (m_layout != VK_NULL_HANDLE) {
+            vkDestroyPipelineLayout(device, m_layout, nullptr);
+        }
+    }
+
+    Result<void> Initialize(const PipelineStateDesc& desc) {
+        RHI_RETURN_IF_FAILED(CreateLayout(static_cast<const PipelineLayoutDesc*>(desc.pipelineLayout)));
+        if (const ComputePipelineStateDesc* computeDesc = desc.AsCompute()) {
+            return CreateComputePipeline(*computeDesc);
+        }
+        const GraphicsPipelineStateDesc* graphicsDesc = desc.AsGraphics();
+        RHI_RETURN_IF_FALSE(graphicsDesc != nullptr, ErrorCode::InvalidArgument, "管线描述不是派生的管线描述类型");
+        return CreateGraphicsPipeline(*graphicsDesc);
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_pipeline));
+    }
+
+    // 返回VkPipelineLayout
+    Result<void*> GetPipelineLayout() const override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_layout));
+    }
+
+    Result<void*> GetShader(ShaderStageFlag stage) const override {
+        for (const auto& entry : m_shaders) {
+            if (entry.first == stage) {
+                return MakeSuccessResult(static_cast<void*>(entry.second));
+            }
+        }
+        return MakeErrorResult<void*>(
+            ErrorCode::InvalidArgument,
+            "管线不包含该阶段的着色器");
+    }
+
+    VkPipeline GetVkPipeline() const { return m_pipeline; }
+    VkPipelineLayout GetVkLayout() const { return m_layout; }
+    VkPipelineBindPoint GetBindPoint() const {
+        return m_desc.type == PipelineType::Compute
+            ? VK_PIPELINE_BIND_POINT_COMPUTE
+            : VK_PIPELINE_BIND_POINT_GRAPHICS;
+    }
+
+private:
+    Result<void> CreateLayout(const PipelineLayoutDesc* layoutDesc) {
+        VkDescriptorSetLayout setLayouts[kVulkanMaxDescriptorSets] = {};
+        uint32_t setLayoutCount = 0;
+        if (layoutDesc != nullptr) {
+            RHI_RETURN_IF_FALSE(layoutDesc->descriptorSetLayouts.size() <= kVulkanMaxDescriptorSets,
+                ErrorCode::InvalidArgument,
+                "描述符集布局数量超过上限");
+            for (void* layout : layoutDesc->descriptorSetLayouts) {
+                RHI_VALIDATE(layout != nullptr, ErrorCode::InvalidArgument, "描述符集布局不能为空");
+                setLayouts[setLayoutCount++] = static_cast<VulkanDescriptorSetLayout*>(
+                    static_cast<IDescriptorSetLayout*>(layout))->GetVkLayout();
+            }
+        }
+
+        VkPushConstantRange pushConstantRange = {};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_ALL;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = kVulkanPushConstantSize;
+
+        VkPipelineLayoutCreateInfo layoutInfo = {};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = setLayoutCount;
+        layoutInfo.pSetLayouts = setLayouts;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+        RHI_VK_RETURN_IF_FAILED(vkCreatePipelineLayout(m_context.GetDevice(), &layoutInfo, nullptr, &m_layout));
+        return MakeSuccessResult();
+    }
+
+    static VkPipelineShaderStageCreateInfo MakeStageInfo(const VulkanShader* shader) {
+        VkPipelineShaderStageCreateInfo stageInfo = {};
+        stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage = shader->GetVkStage();
+        stageInfo.module = shader->GetVkModule();
+        stageInfo.pName = shader->GetDesc().entryPoint.c_str();
+        return stageInfo;
+    }
+
+    Result<void> CreateComputePipeline(const ComputePipelineStateDesc& desc) {
+        RHI_VALIDATE(desc.computeShader != nullptr, ErrorCode::InvalidArgument, "计算着色器不能为空");
+        auto* shader = static_cast<VulkanShader*>(static_cast<IShader*>(desc.computeShader));
+        m_shaders.emplace_back(ShaderStageFlag::Compute, static_cast<IShader*>(shader));
+
+        VkComputePipelineCreateInfo pipelineInfo = {};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage = MakeStageInfo(shader);
+        pipelineInfo.layout = m_layout;
+        RHI_VK_RETURN_IF_FAILED(vkCreateComputePipelines(
+            m_context.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+        return MakeSuccessResult();
+    }
+
+    Result<void> CreateGraphicsPipeline(const GraphicsPipelineStateDesc& desc) {
+        RHI_VALIDATE(desc.vertexShader != nullptr, ErrorCode::InvalidArgument, "顶点着色器不能为空");
+        RHI_RETURN_IF_FALSE(desc.renderTargetFormats.size() <= kVulkanMaxColorAttachments,
+            ErrorCode::InvalidArgument,
+            "渲染目标数量超过上限");
+
+        // 着色器阶段
+        const std::pair<ShaderStageFlag, void*> shaders[] = {
+            {ShaderStageFlag::Vertex, desc.vertexShader},
+            {ShaderStageFlag::Hull, desc.hullShader},
+            {ShaderStageFlag::Domain, desc.domainShader},
+            {ShaderStageFlag::Geometry, desc.geometryShader},
+            {ShaderStageFlag::Pixel, desc.pixelShader},
+        };
+        VkPipelineShaderStageCreateInfo stages[5] = {};
+        uint32_t stageCount = 0;
+        for (const auto& entry : shaders) {
+            if (entry.second != nullptr) {
+                auto* shader = static_cast<VulkanShader*>(static_cast<IShader*>(entry.second));
+                stages[stageCount++] = MakeStageInfo(shader);
+                m_shaders.emplace_back(entry.first, static_cast<IShader*>(shader));
+            }
+        }
+
+        // 顶点输入
+        std::vector<VkVertexInputBindingDescription> bindings(desc.vertexBindings.size());
+        for (size_t i = 0; i < desc.vertexBindings.size(); ++i) {
+            const VertexBinding& binding = desc.vertexBindings[i];
+            bindings[i].binding = binding.binding;
+            bindings[i].stride = binding.stride;
+            bindings[i].inputRate = binding.instanceDivisor
+                ? VK_VERTEX_INPUT_RATE_INSTANCE
+                : VK_VERTEX_INPUT_RATE_VERTEX;
+        }
+        std::vector<VkVertexInputAttributeDescription> attributes(desc.vertexAttributes.size());
+        for (size_t i = 0; i < desc.vertexAttributes.size(); ++i) {
+            const VertexAttribute& attribute = desc.vertexAttributes[i];
+            attributes[i].location = attribute.location;
+            attributes[i].binding = attribute.binding;
+            attributes[i].format = ToVkFormat(attribute.format);
+            attributes[i].offset = attribute.offset;
+        }
+        VkPipelineVertexInputStateCreateInfo vertexInput = {};
+        vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInput.vertexBindingDescriptionCount = static_cast<uint32_t>(bindings.size());
+        vertexInput.pVertexBindingDescriptions = bindings.data();
+        vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
+        vertexInput.pVertexAttributeDescriptions = attributes.data();
+
+        // 描述中没有图元拓扑，固定为三角形列表（与其他后端一致）
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        VkPipelineViewportStateCreateInfo viewportState = {};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount = 1;
+
+        // 光栅化
+        const RasterizationState& raster = desc.rasterizationState;
+        VkPipelineRasterizationStateCreateInfo rasterization = {};
+        rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterization.depthClampEnable = raster.depthClampEnable ? VK_TRUE : VK_FALSE;
+        rasterization.rasterizerDiscardEnable = raster.rasterizerDiscardEnable ? VK_TRUE : VK_FALSE;
+        switch (raster.fillMode) {
+            case RasterizationState::FillMode::Wireframe: rasterization.polygonMode = VK_POLYGON_MODE_LINE; break;
+            case RasterizationState::FillMode::Point: rasterization.polygonMode = VK_POLYGON_MODE_POINT; break;
+            default: rasterization.polygonMode = VK_POLYGON_MODE_FILL; break;
+        }
+        switch (raster.cullMode) {
+            case RasterizationState::CullMode::Front: rasterization.cullMode = VK_CULL_MODE_FRONT_BIT; break;
+            case RasterizationState::CullMode::Back: rasterization.cullMode = VK_CULL_MODE_BACK_BIT; break;
+            default: rasterization.cullMode = VK_CULL_MODE_NONE; break;
+        }
+        rasterization.frontFace = raster.frontFace == RasterizationState::FrontFace::Clockwise
+            ? VK_FRONT_FACE_CLOCKWISE
+            : VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        rasterization.depthBiasEnable = raster.depthBiasEnable ? VK_TRUE : VK_FALSE;
+        rasterization.depthBiasConstantFactor = raster.depthBiasConstant;
+        rasterization.depthBiasClamp = raster.depthBiasClamp;
+        rasterization.depthBiasSlopeFactor = raster.depthBiasSlope;
+        rasterization.lineWidth = raster.lineWidth;
+
+        VkPipelineMultisampleStateCreateInfo multisample = {};
+        multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisample.rasterizationSamples = static_cast<VkSampleCountFlagBits>(desc.sampleCount);
+        multisample.alphaToCoverageEnable = desc.alphaToCoverageEnable ? VK_TRUE : VK_FALSE;
+
+        // 深度模板
+        const DepthStencilState& depthStencil = desc.depthStencilState;
+        VkPipelineDepthStencilStateCreateInfo depthStencilInfo = {};
+        depthStencilInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        bool hasDepth = desc.depthStencilFormat != Format::UNKNOWN;
+        depthStencilInfo.depthTestEnable = hasDepth && depthStencil.depthTestEnable ? VK_TRUE : VK_FALSE;
+        depthStencilInfo.depthWriteEnable = hasDepth && depthStencil.depthWriteEnable ? VK_TRUE : VK_FALSE;
+        depthStencilInfo.depthCompareOp = ToVkCompareOp(depthStencil.depthCompareOp);
+        depthStencilInfo.stencilTestEnable = hasDepth && depthStencil.stencilTestEnable ? VK_TRUE : VK_FALSE;
+        if (depthStencil.stencilTestEnable) {
+            depthStencilInfo.front = ToVkStencilOpState(depthStencil.front);
+            depthStencilInfo.back = ToVkStencilOpState(depthStencil.back);
+        }
+        depthStencilInfo.maxDepthBounds = 1.0f;
+
+        // 混合（blendStates少于渲染目标数时其余目标使用默认状态）
+        VkPipelineColorBlendAttachmentState blendAttachments[kVulkanMaxColorAttachments] = {};
+        BlendState defaultBlend;
+        for (size_t i = 0; i < desc.renderTargetFormats.size(); ++i) {
+            const BlendState& blend = i < desc.blendStates.size() ? desc.blendStates[i] : defaultBlend;
+            VkPipelineColorBlendAttachmentState& attachment = blendAttachments[i];
+            attachment.blendEnable = blend.blendEnable ? VK_TRUE : VK_FALSE;
+            attachment.srcColorBlendFactor = ToVkBlendFactor(blend.srcColorBlendFactor);
+            attachment.dstColorBlendFactor = ToVkBlendFactor(blend.dstColorBlendFactor);
+            attachment.colorBlendOp = ToVkBlendOp(blend.colorBlendOp);
+            attachment.srcAlphaBlendFactor = ToVkBlendFactor(blend.srcAlphaBlendFactor);
+            attachment.dstAlphaBlendFactor = ToVkBlendFactor(blend.dstAlphaBlendFactor);
+            attachment.alphaBlendOp = ToVkBlendOp(blend.alphaBlendOp);
+            attachment.colorWriteMask = blend.colorWriteMask;
+        }
+        const BlendState& firstBlend = desc.blendStates.empty() ? defaultBlend : desc.blendStates[0];
+        VkPipelineColorBlendStateCreateInfo colorBlend = {};
+        colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlend.logicOpEnable = firstBlend.logicOpEnable ? VK_TRUE : VK_FALSE;
+        colorBlend.logicOp = ToVkLogicOp(firstBlend.logicOp);
+        colorBlend.attachmentCount = static_cast<uint32_t>(desc.renderTargetFormats.size());
+        colorBlend.pAttachments = blendAttachments;
+
+        const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        VkPipelineDynamicStateCreateInfo dynamicState = {};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates = dynamicStates;
+
+        // 动态渲染的附件格式
+        VkFormat colorFormats[kVulkanMaxColorAttachments] = {};
+        for (size_t i = 0; i < desc.renderTargetFormats.size(); ++i) {
+            colorFormats[i] = ToVkFormat(desc.renderTargetFormats[i]);
+        }
+        VkPipelineRenderingCreateInfo renderingInfo = {};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        renderingInfo.colorAttachmentCount = static_cast<uint32_t>(desc.renderTargetFormats.size());
+        renderingInfo.pColorAttachmentFormats = colorFormats;
+        if (hasDepth) {
+            renderingInfo.depthAttachmentFormat = IsDepthFormat(desc.depthStencilFormat)
+                ? ToVkFormat(desc.depthStencilFormat)
+                : VK_FORMAT_UNDEFINED;
+            renderingInfo.stencilAttachmentFormat = IsStencilFormat(desc.depthStencilFormat)
+                ? ToVkFormat(desc.depthStencilFormat)
+                : VK_FORMAT_UNDEFINED;
+        }
+
+        VkGraphicsPipelineCreateInfo pipelineInfo = {};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.pNext = &renderingInfo;
+        pipelineInfo.stageCount = stageCount;
+        pipelineInfo.pStages = stages;
+        pipelineInfo.pVertexInputState = &vertexInput;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterization;
+        pipelineInfo.pMultisampleState = &multisample;
+        pipelineInfo.pDepthStencilState = &depthStencilInfo;
+        pipelineInfo.pColorBlendState = &colorBlend;
+        pipelineInfo.pDynamicState = &dynamicState;
+        pipelineInfo.layout = m_layout;
+        RHI_VK_RETURN_IF_FAILED(vkCreateGraphicsPipelines(
+            m_context.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_pipeline));
+        return MakeSuccessResult();
+    }
+
+    VulkanContext& m_context;
+    VkPipelineLayout m_layout = VK_NULL_HANDLE;
+    VkPipeline m_pipeline = VK_NULL_HANDLE;
+    std::vector<std::pair<ShaderStageFlag, IShader*>> m_shaders;
+};
+
+} // namespace RHI
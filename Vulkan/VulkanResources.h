@@ -0,0 +1,960 @@
+#pragma once
+#include "VulkanContext.h"
+#include "MemoryTracker.h"
+#include "Texture.h"
+#include "TlsfAllocator.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace RHI {
+
+// Vulkan内存块
+// 用TLSF切分一个VkDeviceMemory，Allocate返回的句柄指向TlsfAllocator::Block；主机可见内存在创建时持久映射
+class VulkanMemory : public IMemory {
+public:
+    VulkanMemory(VulkanContext& context, const MemoryDesc& desc)
+        : m_context(context), m_allocator(desc.size) {
+        m_desc = desc;
+    }
+
+    ~VulkanMemory() override {
+        if (m_memory != VK_NULL_HANDLE) {
+            if (m_mapped != nullptr) {
+                vkUnmapMemory(m_context.GetDevice(), m_memory);
+            }
+            vkFreeMemory(m_context.GetDevice(), m_memory, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        RHI_VALIDATE(m_desc.size > 0, ErrorCode::InvalidArgument, "内存大小必须大于0");
+
+        VkMemoryPropertyFlags required = 0;
+        VkMemoryPropertyFlags preferred = 0;
+        GetVkMemoryProperties(m_desc.type, false, required, preferred);
+        required |= ToVkMemoryProperties(m_desc.properties);
+
+        VkMemoryRequirements requirements = {};
+        requirements.size = m_desc.size;
+        requirements.alignment = std::max<size_t>(m_desc.alignment, 1);
+        requirements.memoryTypeBits = UINT32_MAX;
+        auto memory = m_context.AllocateMemory(requirements, required, preferred, &m_memoryTypeIndex);
+        RHI_RETURN_IF_FAILED(memory);
+        m_memory = memory.GetValue();
+
+        if (m_context.IsHostVisible(m_memoryTypeIndex)) {
+            RHI_VK_RETURN_IF_FAILED(vkMapMemory(m_context.GetDevice(), m_memory, 0, VK_WHOLE_SIZE, 0, &m_mapped));
+        }
+        return MakeSuccessResult();
+    }
+
+    const MemoryDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_memory));
+    }
+
+    Result<void*> Allocate(const MemoryAllocationInfo& info) override {
+        RHI_VALIDATE(info.size > 0, ErrorCode::InvalidArgument, "分配大小必须大于0");
+        RHI_VALIDATE(info.alignment == 0 || (info.alignment & (info.alignment - 1)) == 0,
+            ErrorCode::InvalidArgument,
+            "对齐要求必须为2的幂: " + std::to_string(info.alignment));
+
+        TlsfAllocator::Block* block = m_allocator.Allocate(info.size, info.alignment);
+        RHI_RETURN_IF_FALSE(block != nullptr,
+            ErrorCode::OutOfMemory,
+            "内存块空间不足");
+        block->info = info;
+        return MakeSuccessResult(static_cast<void*>(block));
+    }
+
+    Result<void> Free(void* allocation) override {
+        TlsfAllocator::Block* block = static_cast<TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        m_allocator.Free(block);
+        return MakeSuccessResult();
+    }
+
+    Result<void*> Map(void* allocation, size_t offset, size_t size) override {
+        RHI_RETURN_IF_FALSE(m_mapped != nullptr,
+            ErrorCode::ResourceMapFailed,
+            "内存不可被CPU访问");
+        const TlsfAllocator::Block* block = static_cast<const TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        RHI_VALIDATE(offset + size <= block->info.size,
+            ErrorCode::InvalidArgument,
+            "映射范围越界");
+        return MakeSuccessResult(static_cast<void*>(static_cast<uint8_t*>(m_mapped) + block->offset + offset));
+    }
+
+    Result<void> Unmap(void* allocation) override {
+        // 内存保持持久映射
+        RHI_VALIDATE(m_allocator.Owns(static_cast<const TlsfAllocator::Block*>(allocation)),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        return MakeSuccessResult();
+    }
+
+    Result<void> FlushMappedRange(void* allocation, size_t offset, size_t size) override {
+        VkMappedMemoryRange range = {};
+        RHI_RETURN_IF_FAILED(GetMappedRange(allocation, offset, size, range));
+        RHI_VK_RETURN_IF_FAILED(vkFlushMappedMemoryRanges(m_context.GetDevice(), 1, &range));
+        return MakeSuccessResult();
+    }
+
+    Result<void> InvalidateMappedRange(void* allocation, size_t offset, size_t size) override {
+        VkMappedMemoryRange range = {};
+        RHI_RETURN_IF_FAILED(GetMappedRange(allocation, offset, size, range));
+        RHI_VK_RETURN_IF_FAILED(vkInvalidateMappedMemoryRanges(m_context.GetDevice(), 1, &range));
+        return MakeSuccessResult();
+    }
+
+    Result<MemoryAllocationInfo> GetAllocationInfo(void* allocation) const override {
+        const TlsfAllocator::Block* block = static_cast<const TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        return MakeSuccessResult(block->info);
+    }
+
+    Result<size_t> GetAllocationOffset(void* allocation) const override {
+        const TlsfAllocator::Block* block = static_cast<const TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+        return MakeSuccessResult(static_cast<size_t>(block->offset));
+    }
+
+    Result<MemoryStats> GetStats() const override {
+        return MakeSuccessResult(m_allocator.GetStats());
+    }
+
+    Result<void> GetLayout(std::vector<MemoryRegion>& regions) const override {
+        m_allocator.GetLayout(regions);
+        return MakeSuccessResult();
+    }
+
+    Result<bool> IsMemoryTypeSupported(MemoryType type, MemoryPropertyFlag properties) const override {
+        VkMemoryPropertyFlags required = 0;
+        VkMemoryPropertyFlags preferred = 0;
+        GetVkMemoryProperties(type, false, required, preferred);
+        required |= ToVkMemoryProperties(properties);
+        return MakeSuccessResult(
+            FindVkMemoryType(m_context.GetMemoryProperties(), UINT32_MAX, required, 0) != UINT32_MAX);
+    }
+
+    Result<MemoryType> GetBestMemoryType(
+        MemoryPropertyFlag requiredProperties,
+        MemoryPropertyFlag) const override {
+        uint32_t required = static_cast<uint32_t>(requiredProperties);
+        if (required & static_cast<uint32_t>(MemoryPropertyFlag::HostCached)) {
+            return MakeSuccessResult(MemoryType::Readback);
+        }
+        if (required & static_cast<uint32_t>(MemoryPropertyFlag::HostVisible)) {
+            return MakeSuccessResult(MemoryType::Upload);
+        }
+        return MakeSuccessResult(MemoryType::Default);
+    }
+
+    // 分配器不移动分配，碎片整理与驻留控制不适用
+    Result<void> Defragment() override { return MakeSuccessResult(); }
+    Result<void> SetPriority(uint32_t) override { return MakeSuccessResult(); }
+    Result<void> MakeResident() override { return MakeSuccessResult(); }
+    Result<void> Evict() override { return MakeSuccessResult(); }
+
+    VkDeviceMemory GetVkMemory() const { return m_memory; }
+    MemoryTrackingHandle& GetMemoryTracking() { return m_tracking; }
+
+    // 持久映射的地址（主机不可见时为nullptr）
+    void* GetMappedData() const { return m_mapped; }
+
+    bool IsHostCoherent() const {
+        return (m_context.GetMemoryProperties().memoryTypes[m_memoryTypeIndex].propertyFlags &
+                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+    }
+
+    // 检查资源能否放置在offset处：内存类型、对齐与范围（不检查重叠，别名是允许的）
+    Result<void> CheckPlacement(const VkMemoryRequirements& requirements, VkDeviceSize offset) const {
+        RHI_RETURN_IF_FALSE((requirements.memoryTypeBits & (1u << m_memoryTypeIndex)) != 0,
+            ErrorCode::InvalidArgument,
+            "资源不能放置在此内存类型中");
+        RHI_RETURN_IF_FALSE(offset % requirements.alignment == 0,
+            ErrorCode::InvalidArgument,
+            "放置偏移未对齐: " + std::to_string(offset) + " % " + std::to_string(requirements.alignment));
+        RHI_RETURN_IF_FALSE(offset <= m_desc.size && requirements.size <= m_desc.size - offset,
+            ErrorCode::InvalidArgument,
+            "放置范围超出内存块: " + std::to_string(offset) + "+" + std::to_string(requirements.size) +
+            " > " + std::to_string(m_desc.size));
+        return MakeSuccessResult();
+    }
+
+private:
+    // 计算按nonCoherentAtomSize对齐的映射范围
+    Result<void> GetMappedRange(void* allocation, size_t offset, size_t size, VkMappedMemoryRange& range) {
+        RHI_RETURN_IF_FALSE(m_mapped != nullptr,
+            ErrorCode::ResourceMapFailed,
+            "内存不可被CPU访问");
+        const TlsfAllocator::Block* block = static_cast<const TlsfAllocator::Block*>(allocation);
+        RHI_RETURN_IF_FALSE(m_allocator.Owns(block),
+            ErrorCode::InvalidArgument,
+            "分配不属于此内存块");
+
+        VkDeviceSize atom = std::max<VkDeviceSize>(m_context.GetProperties().limits.nonCoherentAtomSize, 1);
+        VkDeviceSize begin = block->offset + offset;
+        VkDeviceSize end = begin + size;
+        begin = begin / atom * atom;
+        end = std::min<VkDeviceSize>((end + atom - 1) / atom * atom, m_desc.size);
+
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = m_memory;
+        range.offset = begin;
+        range.size = end - begin;
+        return MakeSuccessResult();
+    }
+
+    VulkanContext& m_context;
+    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+    uint32_t m_memoryTypeIndex = 0;
+    void* m_mapped = nullptr;
+    TlsfAllocator m_allocator;
+    MemoryTrackingHandle m_tracking;    // 最后声明：先于分配器析构，导出快照时不会访问已销毁的布局
+};
+
+// 暂存缓冲区（主机可见，用于非主机可见资源的上传）
+class VulkanStagingBuffer {
+public:
+    explicit VulkanStagingBuffer(VulkanContext& context)
+        : m_context(context) {}
+
+    ~VulkanStagingBuffer() {
+        if (m_buffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(m_context.GetDevice(), m_buffer, nullptr);
+        }
+        if (m_memory != VK_NULL_HANDLE) {
+            vkFreeMemory(m_context.GetDevice(), m_memory, nullptr);
+        }
+    }
+
+    VulkanStagingBuffer(const VulkanStagingBuffer&) = delete;
+    VulkanStagingBuffer& operator=(const VulkanStagingBuffer&) = delete;
+
+    // 创建缓冲区并写入数据
+    Result<void> Initialize(const void* data, VkDeviceSize size) {
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        RHI_VK_RETURN_IF_FAILED(vkCreateBuffer(m_context.GetDevice(), &bufferInfo, nullptr, &m_buffer));
+
+        VkMemoryRequirements requirements = {};
+        vkGetBufferMemoryRequirements(m_context.GetDevice(), m_buffer, &requirements);
+        auto memory = m_context.AllocateMemory(requirements,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 0);
+        RHI_RETURN_IF_FAILED(memory);
+        m_memory = memory.GetValue();
+        RHI_VK_RETURN_IF_FAILED(vkBindBufferMemory(m_context.GetDevice(), m_buffer, m_memory, 0));
+
+        void* mapped = nullptr;
+        RHI_VK_RETURN_IF_FAILED(vkMapMemory(m_context.GetDevice(), m_memory, 0, VK_WHOLE_SIZE, 0, &mapped));
+        std::memcpy(mapped, data, static_cast<size_t>(size));
+        vkUnmapMemory(m_context.GetDevice(), m_memory);
+        return MakeSuccessResult();
+    }
+
+    VkBuffer GetVkBuffer() const { return m_buffer; }
+
+private:
+    VulkanContext& m_context;
+    VkBuffer m_buffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+};
+
+class VulkanBuffer;
+class VulkanTexture;
+
+// 缓冲区视图（IBuffer::Get*View返回的句柄指向此结构，由缓冲区拥有）
+struct VulkanBufferView {
+    VulkanBuffer* buffer;       // 所属缓冲区
+    VkBuffer handle;            // 缓冲区句柄
+    BufferViewDesc desc;        // 视图范围
+};
+
+// 纹理视图（ITexture::Get*View返回的句柄指向此结构，由纹理拥有）
+struct VulkanTextureView {
+    VulkanTexture* texture;             // 所属纹理
+    VkImageView handle;                 // 图像视图
+    VkSampler sampler;                  // 纹理的采样器（用于DescriptorType::Sampler）
+    TextureSubresourceRange range;      // 子资源范围
+    uint32_t width;                     // 基础mip的宽度
+    uint32_t height;                    // 基础mip的高度
+};
+
+// Vulkan缓冲区
+// 每个缓冲区独占一块VkDeviceMemory，放置的缓冲区绑定到VulkanMemory的偏移处；
+// 主机可见的缓冲区持久映射，Map/Unmap不调用驱动，非HostCoherent内存上的写入经FlushMappedRanges刷新
+class VulkanBuffer : public IBuffer {
+public:
+    VulkanBuffer(VulkanContext& context, const BufferDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    ~VulkanBuffer() override {
+        VkDevice device = m_context.GetDevice();
+        if (m_buffer != VK_NULL_HANDLE) {
+            vkDestroyBuffer(device, m_buffer, nullptr);
+        }
+        if (m_memory != VK_NULL_HANDLE) {
+            if (m_mapped != nullptr) {
+                vkUnmapMemory(device, m_memory);
+            }
+            vkFreeMemory(device, m_memory, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        RHI_RETURN_IF_FAILED(CreateBuffer());
+        VkDevice device = m_context.GetDevice();
+
+        VkMemoryPropertyFlags required = 0;
+        VkMemoryPropertyFlags preferred = 0;
+        GetVkMemoryProperties(m_desc.memoryType, m_desc.allowCPUAccess, required, preferred);
+        uint32_t memoryTypeIndex = 0;
+        auto memory = m_context.AllocateMemory(m_requirements, required, preferred, &memoryTypeIndex);
+        RHI_RETURN_IF_FAILED(memory);
+        m_memory = memory.GetValue();
+        RHI_VK_RETURN_IF_FAILED(vkBindBufferMemory(device, m_buffer, m_memory, 0));
+        m_boundMemory = m_memory;
+        m_boundSize = m_requirements.size;
+        m_coherent = (m_context.GetMemoryProperties().memoryTypes[memoryTypeIndex].propertyFlags &
+                      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+        if (m_context.IsHostVisible(memoryTypeIndex)) {
+            RHI_VK_RETURN_IF_FAILED(vkMapMemory(device, m_memory, 0, VK_WHOLE_SIZE, 0, &m_mapped));
+        }
+        return MakeSuccessResult();
+    }
+
+    // 放置在placement的offset处，内存由placement拥有
+    Result<void> Initialize(VulkanMemory* placement, VkDeviceSize offset) {
+        RHI_RETURN_IF_FAILED(CreateBuffer());
+        RHI_RETURN_IF_FAILED(placement->CheckPlacement(m_requirements, offset));
+        RHI_VK_RETURN_IF_FAILED(vkBindBufferMemory(m_context.GetDevice(), m_buffer, placement->GetVkMemory(), offset));
+        m_boundMemory = placement->GetVkMemory();
+        m_boundOffset = offset;
+        m_boundSize = placement->GetDesc().size;
+        m_coherent = placement->IsHostCoherent();
+        if (placement->GetMappedData() != nullptr) {
+            m_mapped = static_cast<uint8_t*>(placement->GetMappedData()) + offset;
+        }
+        return MakeSuccessResult();
+    }
+
+    // 创建VkBuffer并查询内存需求（不绑定内存）
+    Result<void> CreateBuffer() {
+        RHI_VALIDATE(m_desc.size > 0, ErrorCode::InvalidArgument, "缓冲区大小必须大于0");
+        VkBufferCreateInfo bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = m_desc.size;
+        bufferInfo.usage = ToVkBufferUsage(m_desc.usage);
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        RHI_VK_RETURN_IF_FAILED(vkCreateBuffer(m_context.GetDevice(), &bufferInfo, nullptr, &m_buffer));
+        vkGetBufferMemoryRequirements(m_context.GetDevice(), m_buffer, &m_requirements);
+        return MakeSuccessResult();
+    }
+
+    const BufferDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_buffer));
+    }
+
+    Result<void*> Map() override {
+        RHI_RETURN_IF_FALSE(m_mapped != nullptr,
+            ErrorCode::ResourceMapFailed,
+            "缓冲区不可被CPU访问");
+        return MakeSuccessResult(m_mapped);
+    }
+
+    Result<void> Unmap() override {
+        // 保持持久映射
+        return MakeSuccessResult();
+    }
+
+    Result<void> UpdateData(const void* data, size_t size, size_t offset = 0) override {
+        RHI_VALIDATE(data != nullptr || size == 0, ErrorCode::InvalidArgument, "数据指针不能为空");
+        RHI_VALIDATE(offset + size <= m_desc.size,
+            ErrorCode::InvalidArgument,
+            "更新范围越界: " + std::to_string(offset) + "+" + std::to_string(size) +
+            " > " + std::to_string(m_desc.size));
+        if (size == 0) {
+            return MakeSuccessResult();
+        }
+        if (m_mapped != nullptr) {
+            std::memcpy(static_cast<uint8_t*>(m_mapped) + offset, data, size);
+            if (!m_coherent) {
+                VkMappedMemoryRange range = GetFlushRange(offset, size);
+                RHI_VK_RETURN_IF_FAILED(vkFlushMappedMemoryRanges(m_context.GetDevice(), 1, &range));
+            }
+            return MakeSuccessResult();
+        }
+
+        // 设备本地缓冲区经暂存缓冲区同步上传
+        VulkanStagingBuffer staging(m_context);
+        RHI_RETURN_IF_FAILED(staging.Initialize(data, size));
+        VkBuffer src = staging.GetVkBuffer();
+        VkBuffer dst = m_buffer;
+        return m_context.ImmediateSubmit([=](VkCommandBuffer commandBuffer) {
+            VkBufferCopy region = {0, offset, size};
+            vkCmdCopyBuffer(commandBuffer, src, dst, 1, &region);
+        });
+    }
+
+    Result<void*> GetVertexBufferView(const BufferViewDesc& desc) override { return CreateView(desc); }
+    Result<void*> GetIndexBufferView(const BufferViewDesc& desc) override { return CreateView(desc); }
+    Result<void*> GetConstantBufferView(const BufferViewDesc& desc) override { return CreateView(desc); }
+    Result<void*> GetShaderResourceView(const BufferViewDesc& desc) override { return CreateView(desc); }
+    Result<void*> GetUnorderedAccessView(const BufferViewDesc& desc) override { return CreateView(desc); }
+
+    // newState为VkAccessFlags，记录供屏障推导使用
+    Result<void> TransitionState(ResourceState newState) override {
+        m_state = newState;
+        return MakeSuccessResult();
+    }
+
+    void* GetMappedData() const override { return m_mapped; }
+    bool IsHostCoherent() const override { return m_coherent; }
+
+    // 缓冲区范围对应的VkDeviceMemory范围（扩展到nonCoherentAtomSize）
+    VkMappedMemoryRange GetFlushRange(size_t offset, size_t size) const {
+        VkDeviceSize atom = std::max<VkDeviceSize>(m_context.GetProperties().limits.nonCoherentAtomSize, 1);
+        VkDeviceSize begin = m_boundOffset + offset;
+        VkDeviceSize end = begin + size;
+        begin = begin / atom * atom;
+        end = std::min<VkDeviceSize>((end + atom - 1) / atom * atom, m_boundSize);
+
+        VkMappedMemoryRange range = {};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = m_boundMemory;
+        range.offset = begin;
+        range.size = end - begin;
+        return range;
+    }
+
+    VkBuffer GetVkBuffer() const { return m_buffer; }
+    ResourceState GetState() const { return m_state; }
+    const VkMemoryRequirements& GetMemoryRequirements() const { return m_requirements; }
+    MemoryTrackingHandle& GetMemoryTracking() { return m_tracking; }
+
+private:
+    // 相同范围的视图复用同一个对象
+    Result<void*> CreateView(const BufferViewDesc& desc) {
+        RHI_VALIDATE(desc.offset + desc.size <= m_desc.size,
+            ErrorCode::InvalidArgument,
+            "视图范围越界");
+        for (const auto& view : m_views) {
+            if (view->desc.offset == desc.offset && view->desc.size == desc.size &&
+                view->desc.stride == desc.stride) {
+                return MakeSuccessResult(static_cast<void*>(view.get()));
+            }
+        }
+        m_views.push_back(std::make_unique<VulkanBufferView>(VulkanBufferView{this, m_buffer, desc}));
+        return MakeSuccessResult(static_cast<void*>(m_views.back().get()));
+    }
+
+    VulkanContext& m_context;
+    VkBuffer m_buffer = VK_NULL_HANDLE;
+    VkMemoryRequirements m_requirements = {};
+    VkDeviceMemory m_memory = VK_NULL_HANDLE;   // 放置的缓冲区为VK_NULL_HANDLE
+    VkDeviceMemory m_boundMemory = VK_NULL_HANDLE;  // 绑定的内存（自有或放置的内存块）
+    VkDeviceSize m_boundOffset = 0;
+    VkDeviceSize m_boundSize = 0;               // 绑定的VkDeviceMemory的大小
+    bool m_coherent = true;
+    void* m_mapped = nullptr;
+    ResourceState m_state = ResourceState::Undefined;
+    std::vector<std::unique_ptr<VulkanBufferView>> m_views;
+    MemoryTrackingHandle m_tracking;
+};
+
+// Vulkan纹理
+// 布局按整个资源跟踪：TransitionLayout立即执行转换，命令缓冲区中的屏障在录制时更新记录的布局
+class VulkanTexture : public ITexture {
+public:
+    VulkanTexture(VulkanContext& context, const TextureDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    // 包装外部拥有的图像（交换链图像），不负责销毁
+    VulkanTexture(VulkanContext& context, const TextureDesc& desc, VkImage image)
+        : m_context(context)
+        , m_image(image)
+        , m_ownsImage(false) {
+        m_desc = desc;
+    }
+
+    ~VulkanTexture() override {
+        VkDevice device = m_context.GetDevice();
+        for (const ViewRecord& record : m_views) {
+            vkDestroyImageView(device, record.view->handle, nullptr);
+        }
+        if (m_sampler != VK_NULL_HANDLE) {
+            vkDestroySampler(device, m_sampler, nullptr);
+        }
+        if (m_ownsImage && m_image != VK_NULL_HANDLE) {
+            vkDestroyImage(device, m_image, nullptr);
+        }
+        if (m_memory != VK_NULL_HANDLE) {
+            vkFreeMemory(device, m_memory, nullptr);
+        }
+    }
+
+    // 瞬态附件优先使用延迟分配的内存类型，没有时退回普通的设备本地内存
+    Result<void> Initialize() {
+        if (m_ownsImage) {
+            RHI_RETURN_IF_FAILED(CreateImage());
+            VkMemoryPropertyFlags preferred = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            if (HasUsage(TextureUsage::Transient)) {
+                preferred |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+            }
+            uint32_t memoryTypeIndex = 0;
+            auto memory = m_context.AllocateMemory(m_requirements, 0, preferred, &memoryTypeIndex);
+            RHI_RETURN_IF_FAILED(memory);
+            m_memory = memory.GetValue();
+            m_lazilyAllocated = (m_context.GetMemoryProperties().memoryTypes[memoryTypeIndex].propertyFlags &
+                VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0;
+            RHI_VK_RETURN_IF_FAILED(vkBindImageMemory(m_context.GetDevice(), m_image, m_memory, 0));
+        }
+        return CreateSampler();
+    }
+
+    // 放置在placement的offset处，内存由placement拥有
+    Result<void> Initialize(VulkanMemory* placement, VkDeviceSize offset) {
+        RHI_RETURN_IF_FAILED(CreateImage());
+        RHI_RETURN_IF_FAILED(placement->CheckPlacement(m_requirements, offset));
+        RHI_VK_RETURN_IF_FAILED(vkBindImageMemory(m_context.GetDevice(), m_image, placement->GetVkMemory(), offset));
+        return CreateSampler();
+    }
+
+    // 创建VkImage并查询内存需求（不绑定内存）
+    Result<void> CreateImage() {
+        RHI_VALIDATE(m_desc.width > 0 && m_desc.height > 0 && m_desc.depth > 0,
+            ErrorCode::InvalidArgument,
+            "纹理尺寸必须大于0");
+        RHI_VALIDATE(m_desc.mipLevels > 0 && m_desc.arraySize > 0,
+            ErrorCode::InvalidArgument,
+            "纹理mip级别与数组大小必须大于0");
+        RHI_VALIDATE(IsValidTransientUsage(m_desc.usage),
+            ErrorCode::InvalidArgument,
+            "瞬态附件只能与RenderTarget/DepthStencil用途组合");
+        VkFormat format = ToVkFormat(m_desc.format);
+        RHI_RETURN_IF_FALSE(format != VK_FORMAT_UNDEFINED,
+            ErrorCode::InvalidArgument,
+            "不支持的纹理格式");
+        VkDevice device = m_context.GetDevice();
+
+        bool isCube = m_desc.type == TextureType::TextureCube || m_desc.type == TextureType::TextureCubeArray;
+        VkImageCreateInfo imageInfo = {};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.flags = isCube || m_desc.isCubeCompatible ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
+        imageInfo.imageType = GetImageType();
+        imageInfo.format = format;
+        imageInfo.extent = {m_desc.width, m_desc.height, m_desc.type == TextureType::Texture3D ? m_desc.depth : 1};
+        imageInfo.mipLevels = m_desc.mipLevels;
+        imageInfo.arrayLayers = GetLayerCount();
+        imageInfo.samples = static_cast<VkSampleCountFlagBits>(m_desc.sampleCount);
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = ToVkImageUsage(m_desc.usage);
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        RHI_VK_RETURN_IF_FAILED(vkCreateImage(device, &imageInfo, nullptr, &m_image));
+
+        vkGetImageMemoryRequirements(device, m_image, &m_requirements);
+        return MakeSuccessResult();
+    }
+
+    const VkMemoryRequirements& GetMemoryRequirements() const { return m_requirements; }
+
+    // 独占的内存是否为延迟分配（物理内存按需提交，分块渲染时通常为0）
+    bool IsLazilyAllocated() const { return m_lazilyAllocated; }
+
+    const TextureDesc& GetDesc() const override { return m_desc; }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_image));
+    }
+
+    // layout描述源数据：offset为首个子资源的偏移，rowPitch/depthPitch为0时视为紧密排列，
+    // 范围内的各数组层之间相隔arrayPitch。一次只能更新一个mip级别。
+    Result<void> UpdateData(
+        const void* data,
+        const TextureDataLayout& layout,
+        const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(data != nullptr, ErrorCode::InvalidArgument, "数据指针不能为空");
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        RHI_VALIDATE(range.mipLevelCount == 1,
+            ErrorCode::InvalidArgument,
+            "一次只能更新一个mip级别");
+        RHI_VALIDATE(!HasUsage(TextureUsage::Transient), ErrorCode::InvalidOperation, "瞬态附件的内容不能更新");
+
+        uint32_t mip = range.baseMipLevel;
+        uint32_t block = GetFormatBlockDimension(m_desc.format);
+        uint32_t blockSize = GetFormatBlockSize(m_desc.format);
+        uint32_t width = std::max(m_desc.width >> mip, 1u);
+        uint32_t height = std::max(m_desc.height >> mip, 1u);
+        uint32_t depth = m_desc.type == TextureType::Texture3D ? std::max(m_desc.depth >> mip, 1u) : 1;
+        size_t rows = (height + block - 1) / block;
+        size_t rowPitch = layout.rowPitch != 0
+            ? layout.rowPitch
+            : static_cast<size_t>((width + block - 1) / block) * blockSize;
+        size_t depthPitch = layout.depthPitch != 0 ? layout.depthPitch : rowPitch * rows;
+        size_t layerSpan = depthPitch * depth;
+        size_t arrayPitch = layout.arrayPitch != 0 ? layout.arrayPitch : layerSpan;
+        size_t totalSize = arrayPitch * (range.arrayLayerCount - 1) + layerSpan;
+
+        VulkanStagingBuffer staging(m_context);
+        RHI_RETURN_IF_FAILED(staging.Initialize(static_cast<const uint8_t*>(data) + layout.offset, totalSize));
+
+        std::vector<VkBufferImageCopy> regions(range.arrayLayerCount);
+        for (uint32_t i = 0; i < range.arrayLayerCount; ++i) {
+            VkBufferImageCopy& region = regions[i];
+            region = {};
+            region.bufferOffset = arrayPitch * i;
+            region.bufferRowLength = static_cast<uint32_t>(rowPitch / blockSize * block);
+            region.bufferImageHeight = static_cast<uint32_t>(depthPitch / rowPitch * block);
+            region.imageSubresource.aspectMask = GetVkImageAspect(m_desc.format) & ~VK_IMAGE_ASPECT_STENCIL_BIT;
+            region.imageSubresource.mipLevel = mip;
+            region.imageSubresource.baseArrayLayer = range.baseArrayLayer + i;
+            region.imageSubresource.layerCount = 1;
+            region.imageExtent = {width, height, depth};
+        }
+
+        // 上传后回到原布局；原布局未定义时转换为着色器只读布局（若可采样）
+        VkImageLayout finalLayout = m_layout;
+        if (finalLayout == VK_IMAGE_LAYOUT_UNDEFINED) {
+            finalLayout = HasUsage(TextureUsage::ShaderResource)
+                ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        }
+        VkImageLayout oldLayout = m_layout;
+        VkBuffer src = staging.GetVkBuffer();
+        RHI_RETURN_IF_FAILED(m_context.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+            RecordTransition(commandBuffer, oldLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, range);
+            vkCmdCopyBufferToImage(commandBuffer, src, m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                static_cast<uint32_t>(regions.size()), regions.data());
+            RecordTransition(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, finalLayout, range);
+        }));
+        m_layout = finalLayout;
+        return MakeSuccessResult();
+    }
+
+    // 以线性过滤的vkCmdBlitImage逐级生成，range.baseMipLevel为源级别
+    Result<void> GenerateMips(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        RHI_VALIDATE(!HasUsage(TextureUsage::Transient), ErrorCode::InvalidOperation, "瞬态附件不能生成Mipmap");
+        VkFormatProperties formatProperties = {};
+        vkGetPhysicalDeviceFormatProperties(m_context.GetPhysicalDevice(), ToVkFormat(m_desc.format), &formatProperties);
+        RHI_RETURN_IF_FALSE(
+            (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0,
+            ErrorCode::NotImplemented,
+            "该格式不支持线性过滤的Blit，无法生成Mipmap");
+        if (range.mipLevelCount <= 1) {
+            return MakeSuccessResult();
+        }
+
+        VkImageLayout oldLayout = m_layout;
+        VkImageLayout finalLayout = oldLayout != VK_IMAGE_LAYOUT_UNDEFINED
+            ? oldLayout
+            : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        RHI_RETURN_IF_FAILED(m_context.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+            RecordTransition(commandBuffer, oldLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, range);
+            for (uint32_t i = 1; i < range.mipLevelCount; ++i) {
+                uint32_t srcMip = range.baseMipLevel + i - 1;
+                TextureSubresourceRange srcRange = range;
+                srcRange.baseMipLevel = srcMip;
+                srcRange.mipLevelCount = 1;
+                RecordTransition(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, srcRange);
+
+                VkImageBlit blit = {};
+                blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                blit.srcSubresource.mipLevel = srcMip;
+                blit.srcSubresource.baseArrayLayer = range.baseArrayLayer;
+                blit.srcSubresource.layerCount = range.arrayLayerCount;
+                blit.srcOffsets[1] = {
+                    static_cast<int32_t>(std::max(m_desc.width >> srcMip, 1u)),
+                    static_cast<int32_t>(std::max(m_desc.height >> srcMip, 1u)),
+                    static_cast<int32_t>(GetMipDepth(srcMip))};
+                blit.dstSubresource = blit.srcSubresource;
+                blit.dstSubresource.mipLevel = srcMip + 1;
+                blit.dstOffsets[1] = {
+                    static_cast<int32_t>(std::max(m_desc.width >> (srcMip + 1), 1u)),
+                    static_cast<int32_t>(std::max(m_desc.height >> (srcMip + 1), 1u)),
+                    static_cast<int32_t>(GetMipDepth(srcMip + 1))};
+                vkCmdBlitImage(commandBuffer,
+                    m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                    m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                    1, &blit, VK_FILTER_LINEAR);
+
+                RecordTransition(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, finalLayout, srcRange);
+            }
+            TextureSubresourceRange lastRange = range;
+            lastRange.baseMipLevel = range.baseMipLevel + range.mipLevelCount - 1;
+            lastRange.mipLevelCount = 1;
+            RecordTransition(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, finalLayout, lastRange);
+        }));
+        m_layout = finalLayout;
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetRenderTargetView(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(HasUsage(TextureUsage::RenderTarget),
+            ErrorCode::InvalidOperation,
+            "纹理未声明RenderTarget用途");
+        return GetView(range, ViewKind::Attachment);
+    }
+
+    Result<void*> GetDepthStencilView(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(HasUsage(TextureUsage::DepthStencil),
+            ErrorCode::InvalidOperation,
+            "纹理未声明DepthStencil用途");
+        return GetView(range, ViewKind::Attachment);
+    }
+
+    Result<void*> GetShaderResourceView(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(HasUsage(TextureUsage::ShaderResource),
+            ErrorCode::InvalidOperation,
+            "纹理未声明ShaderResource用途");
+        return GetView(range, ViewKind::Shader);
+    }
+
+    Result<void*> GetUnorderedAccessView(const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(HasUsage(TextureUsage::UnorderedAccess),
+            ErrorCode::InvalidOperation,
+            "纹理未声明UnorderedAccess用途");
+        return GetView(range, ViewKind::Shader);
+    }
+
+    Result<size_t> GetTextureSize() const override {
+        RHI_RETURN_IF_FALSE(m_ownsImage,
+            ErrorCode::InvalidOperation,
+            "外部图像的内存大小未知");
+        return MakeSuccessResult(static_cast<size_t>(m_requirements.size));
+    }
+
+    // 返回UpdateData紧密排列时的源数据布局（层优先、mip次之）
+    Result<TextureDataLayout> GetSubresourceLayout(uint32_t mipLevel, uint32_t arrayLayer) const override {
+        RHI_VALIDATE(mipLevel < m_desc.mipLevels && arrayLayer < GetLayerCount(),
+            ErrorCode::InvalidArgument,
+            "子资源索引越界");
+
+        uint32_t block = GetFormatBlockDimension(m_desc.format);
+        uint32_t blockSize = GetFormatBlockSize(m_desc.format);
+        size_t layerSize = 0;
+        size_t mipOffset = 0;
+        for (uint32_t mip = 0; mip < m_desc.mipLevels; ++mip) {
+            if (mip == mipLevel) {
+                mipOffset = layerSize;
+            }
+            size_t width = std::max(m_desc.width >> mip, 1u);
+            size_t height = std::max(m_desc.height >> mip, 1u);
+            layerSize += ((width + block - 1) / block) * ((height + block - 1) / block) * GetMipDepth(mip) * blockSize;
+        }
+
+        uint32_t width = std::max(m_desc.width >> mipLevel, 1u);
+        uint32_t height = std::max(m_desc.height >> mipLevel, 1u);
+        TextureDataLayout layout = {};
+        layout.rowPitch = static_cast<size_t>((width + block - 1) / block) * blockSize;
+        layout.depthPitch = layout.rowPitch * ((height + block - 1) / block);
+        layout.arrayPitch = layerSize;
+        layout.offset = layerSize * arrayLayer + mipOffset;
+        return MakeSuccessResult(layout);
+    }
+
+    // 立即执行转换
+    Result<void> TransitionLayout(ResourceState newState, const TextureSubresourceRange& range) override {
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        VkImageLayout newLayout = ToVkImageLayout(newState);
+        if (newLayout == m_layout) {
+            return MakeSuccessResult();
+        }
+        VkImageLayout oldLayout = m_layout;
+        RHI_RETURN_IF_FAILED(m_context.ImmediateSubmit([&](VkCommandBuffer commandBuffer) {
+            RecordTransition(commandBuffer, oldLayout, newLayout, range);
+        }));
+        m_layout = newLayout;
+        return MakeSuccessResult();
+    }
+
+    // 录制一次布局转换屏障（不更新记录的布局）
+    void RecordTransition(VkCommandBuffer commandBuffer, VkImageLayout oldLayout, VkImageLayout newLayout,
+        const TextureSubresourceRange& range) const {
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = GetVkLayoutAccess(oldLayout);
+        barrier.dstAccessMask = GetVkLayoutAccess(newLayout);
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_image;
+        barrier.subresourceRange = ToVkSubresourceRange(range, m_desc.format);
+        vkCmdPipelineBarrier(commandBuffer,
+            GetVkAccessStages(barrier.srcAccessMask),
+            barrier.dstAccessMask != 0 ? GetVkAccessStages(barrier.dstAccessMask) : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+
+    VkImage GetVkImage() const { return m_image; }
+    VkImageLayout GetLayout() const { return m_layout; }
+    void SetLayout(VkImageLayout layout) { m_layout = layout; }
+    MemoryTrackingHandle& GetMemoryTracking() { return m_tracking; }
+
+    uint32_t GetLayerCount() const {
+        return m_desc.type == TextureType::TextureCube || m_desc.type == TextureType::TextureCubeArray
+            ? m_desc.arraySize * 6
+            : m_desc.arraySize;
+    }
+
+private:
+    // 可采样的纹理创建自己的采样器
+    Result<void> CreateSampler() {
+        if (HasUsage(TextureUsage::ShaderResource)) {
+            const SamplerDesc& sampler = m_desc.samplerDesc;
+            VkSamplerCreateInfo samplerInfo = {};
+            samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+            samplerInfo.magFilter = ToVkFilter(sampler.magFilter);
+            samplerInfo.minFilter = ToVkFilter(sampler.minFilter);
+            samplerInfo.mipmapMode = ToVkMipmapMode(sampler.mipmapMode);
+            samplerInfo.addressModeU = ToVkAddressMode(sampler.addressU);
+            samplerInfo.addressModeV = ToVkAddressMode(sampler.addressV);
+            samplerInfo.addressModeW = ToVkAddressMode(sampler.addressW);
+            samplerInfo.mipLodBias = sampler.mipLodBias;
+            samplerInfo.anisotropyEnable = sampler.maxAnisotropy > 1.0f ? VK_TRUE : VK_FALSE;
+            samplerInfo.maxAnisotropy = sampler.maxAnisotropy;
+            samplerInfo.minLod = sampler.minLod;
+            samplerInfo.maxLod = sampler.maxLod;
+            samplerInfo.borderColor = sampler.borderColor[3] > 0.0f
+                ? VK_BORDER_COLOR_FLOAT_OPAQUE_BLACK
+                : VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+            if (sampler.borderColor[0] > 0.0f && sampler.borderColor[3] > 0.0f) {
+                samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+            }
+            RHI_VK_RETURN_IF_FAILED(vkCreateSampler(m_context.GetDevice(), &samplerInfo, nullptr, &m_sampler));
+        }
+        return MakeSuccessResult();
+    }
+
+    enum class ViewKind {
+        Attachment,         // 渲染目标/深度模板（单层为2D，多层为2D数组）
+        Shader              // 着色器资源/UAV（视图类型与纹理类型一致）
+    };
+
+    struct ViewRecord {
+        std::unique_ptr<VulkanTextureView> view;
+        ViewKind kind;
+    };
+
+    VkImageType GetImageType() const {
+        switch (m_desc.type) {
+            case TextureType::Texture1D:
+            case TextureType::Texture1DArray:
+                return VK_IMAGE_TYPE_1D;
+            case TextureType::Texture3D:
+                return VK_IMAGE_TYPE_3D;
+            default:
+                return VK_IMAGE_TYPE_2D;
+        }
+    }
+
+    VkImageViewType GetViewType(const TextureSubresourceRange& range, ViewKind kind) const {
+        bool array = range.arrayLayerCount > 1;
+        switch (m_desc.type) {
+            case TextureType::Texture1D:
+            case TextureType::Texture1DArray:
+                return array ? VK_IMAGE_VIEW_TYPE_1D_ARRAY : VK_IMAGE_VIEW_TYPE_1D;
+            case TextureType::Texture3D:
+                return VK_IMAGE_VIEW_TYPE_3D;
+            case TextureType::TextureCube:
+            case TextureType::TextureCubeArray:
+                if (kind == ViewKind::Shader && range.arrayLayerCount % 6 == 0) {
+                    return range.arrayLayerCount > 6 ? VK_IMAGE_VIEW_TYPE_CUBE_ARRAY : VK_IMAGE_VIEW_TYPE_CUBE;
+                }
+                return array ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+            default:
+                return array ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+        }
+    }
+
+    uint32_t GetMipDepth(uint32_t mip) const {
+        return m_desc.type == TextureType::Texture3D ? std::max(m_desc.depth >> mip, 1u) : 1;
+    }
+
+    bool IsRangeValid(const TextureSubresourceRange& range) const {
+        return range.mipLevelCount > 0 && range.arrayLayerCount > 0 &&
+            range.baseMipLevel + range.mipLevelCount <= m_desc.mipLevels &&
+            range.baseArrayLayer + range.arrayLayerCount <= GetLayerCount();
+    }
+
+    bool HasUsage(TextureUsage usage) const {
+        return (m_desc.usage & usage) != TextureUsage::None;
+    }
+
+    // 相同范围与种类的视图复用同一个对象
+    Result<void*> GetView(const TextureSubresourceRange& range, ViewKind kind) {
+        RHI_VALIDATE(IsRangeValid(range), ErrorCode::InvalidArgument, "子资源范围越界");
+        for (const ViewRecord& record : m_views) {
+            const TextureSubresourceRange& existing = record.view->range;
+            if (record.kind == kind &&
+                existing.baseMipLevel == range.baseMipLevel && existing.mipLevelCount == range.mipLevelCount &&
+                existing.baseArrayLayer == range.baseArrayLayer && existing.arrayLayerCount == range.arrayLayerCount) {
+                return MakeSuccessResult(static_cast<void*>(record.view.get()));
+            }
+        }
+
+        VkImageViewCreateInfo viewInfo = {};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_image;
+        viewInfo.viewType = GetViewType(range, kind);
+        viewInfo.format = ToVkFormat(m_desc.format);
+        viewInfo.subresourceRange = ToVkSubresourceRange(range, m_desc.format);
+        if (kind == ViewKind::Shader) {
+            // 采样视图只能包含一个方面
+            viewInfo.subresourceRange.aspectMask &= ~VK_IMAGE_ASPECT_STENCIL_BIT;
+        }
+
+        VkImageView handle = VK_NULL_HANDLE;
+        RHI_VK_RETURN_IF_FAILED(vkCreateImageView(m_context.GetDevice(), &viewInfo, nullptr, &handle));
+
+        auto view = std::make_unique<VulkanTextureView>();
+        view->texture = this;
+        view->handle = handle;
+        view->sampler = m_sampler;
+        view->range = range;
+        view->width = std::max(m_desc.width >> range.baseMipLevel, 1u);
+        view->height = std::max(m_desc.height >> range.baseMipLevel, 1u);
+        void* result = view.get();
+        m_views.push_back(ViewRecord{std::move(view), kind});
+        return MakeSuccessResult(result);
+    }
+
+    VulkanContext& m_context;
+    VkImage m_image = VK_NULL_HANDLE;
+    bool m_ownsImage = true;
+    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+    bool m_lazilyAllocated = false;
+    VkMemoryRequirements m_requirements = {};
+    VkSampler m_sampler = VK_NULL_HANDLE;
+    VkImageLayout m_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    std::vector<ViewRecord> m_views;
+    MemoryTrackingHandle m_tracking;
+};
+
+} // namespace RHI
@@ -0,0 +1,234 @@
+#pragma once
+#include "VulkanContext.h"
+#include "Synchronization.h"
+#include <algorithm>
+
+namespace RHI {
+
+// 创建时间线信号量
+inline Result<VkSemaphore> CreateVkTimelineSemaphore(VkDevice device, uint64_t initialValue) {
+    VkSemaphoreTypeCreateInfo typeInfo = {};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = initialValue;
+
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &typeInfo;
+
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    RHI_VK_RETURN_IF_FAILED(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore));
+    return MakeSuccessResult(semaphore);
+}
+
+// 等待时间线信号量到达指定值（timeout单位为纳秒）
+inline Result<void> WaitVkTimelineSemaphore(VkDevice device, VkSemaphore semaphore, uint64_t value, uint64_t timeout) {
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &semaphore;
+    waitInfo.pValues = &value;
+    VkResult result = vkWaitSemaphores(device, &waitInfo, timeout);
+    RHI_RETURN_IF_FALSE(result != VK_TIMEOUT, ErrorCode::TimeoutError, "等待超时");
+    RHI_VK_RETURN_IF_FAILED(result);
+    return MakeSuccessResult();
+}
+
+// Vulkan栅栏
+// 以时间线信号量实现：队列提交时发出提交序号（按栅栏保持单调递增），Wait的timeout单位为纳秒
+class VulkanFence : public IFence {
+public:
+    VulkanFence(VulkanContext& context, const FenceDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    ~VulkanFence() override {
+        if (m_semaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(m_context.GetDevice(), m_semaphore, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        m_lastSignaled = m_desc.signaled ? 1 : 0;
+        auto semaphore = CreateVkTimelineSemaphore(m_context.GetDevice(), m_lastSignaled);
+        RHI_RETURN_IF_FAILED(semaphore);
+        m_semaphore = semaphore.GetValue();
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_semaphore));
+    }
+
+    Result<uint64_t> GetValue() const override {
+        uint64_t value = 0;
+        RHI_VK_RETURN_IF_FAILED(vkGetSemaphoreCounterValue(m_context.GetDevice(), m_semaphore, &value));
+        return MakeSuccessResult(value);
+    }
+
+    Result<void> Signal(uint64_t value) override {
+        RHI_VALIDATE(value > m_lastSignaled, ErrorCode::SyncError, "栅栏值必须递增");
+        VkSemaphoreSignalInfo signalInfo = {};
+        signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+        signalInfo.semaphore = m_semaphore;
+        signalInfo.value = value;
+        RHI_VK_RETURN_IF_FAILED(vkSignalSemaphore(m_context.GetDevice(), &signalInfo));
+        m_lastSignaled = value;
+        return MakeSuccessResult();
+    }
+
+    Result<void> Wait(uint64_t value, uint64_t timeout) override {
+        return WaitVkTimelineSemaphore(m_context.GetDevice(), m_semaphore, value, timeout);
+    }
+
+    uint64_t GetLastSubmittedValue() const override {
+        return m_lastSignaled;
+    }
+
+    // 时间线信号量不能回退，重置时重新创建（调用方须保证没有未完成的提交引用它）
+    Result<void> Reset() override {
+        auto semaphore = CreateVkTimelineSemaphore(m_context.GetDevice(), 0);
+        RHI_RETURN_IF_FAILED(semaphore);
+        vkDestroySemaphore(m_context.GetDevice(), m_semaphore, nullptr);
+        m_semaphore = semaphore.GetValue();
+        m_lastSignaled = 0;
+        return MakeSuccessResult();
+    }
+
+    // 由队列在提交时调用：GetSubmitValue返回本次提交要发出的值，提交成功后CommitSubmitValue记录它
+    uint64_t GetSubmitValue(uint64_t submitIndex) const {
+        return std::max(submitIndex, m_lastSignaled + 1);
+    }
+    void CommitSubmitValue(uint64_t value) { m_lastSignaled = value; }
+
+    VkSemaphore GetVkSemaphore() const { return m_semaphore; }
+
+private:
+    VulkanContext& m_context;
+    VkSemaphore m_semaphore = VK_NULL_HANDLE;
+    uint64_t m_lastSignaled = 0;
+};
+
+// Vulkan信号量
+// 时间线信号量在Submit中作为信号时发出++value、作为等待时等待最近一次发出的值；SubmitBatch使用显式的值
+class VulkanSemaphore : public ISemaphore {
+public:
+    VulkanSemaphore(VulkanContext& context, const SemaphoreDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    ~VulkanSemaphore() override {
+        if (m_semaphore != VK_NULL_HANDLE) {
+            vkDestroySemaphore(m_context.GetDevice(), m_semaphore, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        if (!m_desc.binary) {
+            m_signalValue = m_desc.initialValue;
+            auto semaphore = CreateVkTimelineSemaphore(m_context.GetDevice(), m_desc.initialValue);
+            RHI_RETURN_IF_FAILED(semaphore);
+            m_semaphore = semaphore.GetValue();
+            return MakeSuccessResult();
+        }
+
+        VkSemaphoreCreateInfo semaphoreInfo = {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        RHI_VK_RETURN_IF_FAILED(vkCreateSemaphore(m_context.GetDevice(), &semaphoreInfo, nullptr, &m_semaphore));
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_semaphore));
+    }
+
+    Result<uint64_t> GetValue() const override {
+        if (m_desc.binary) {
+            return MakeSuccessResult(uint64_t(0));
+        }
+        uint64_t value = 0;
+        RHI_VK_RETURN_IF_FAILED(vkGetSemaphoreCounterValue(m_context.GetDevice(), m_semaphore, &value));
+        return MakeSuccessResult(value);
+    }
+
+    // timeout单位为纳秒
+    Result<void> Wait(uint64_t value, uint64_t timeout) override {
+        RHI_VALIDATE(!m_desc.binary, ErrorCode::InvalidOperation, "二进制信号量不支持CPU等待");
+        return WaitVkTimelineSemaphore(m_context.GetDevice(), m_semaphore, value, timeout);
+    }
+
+    Result<void> Signal(uint64_t value) override {
+        RHI_VALIDATE(!m_desc.binary, ErrorCode::InvalidOperation, "二进制信号量不支持主机端发出");
+        VkSemaphoreSignalInfo signalInfo = {};
+        signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+        signalInfo.semaphore = m_semaphore;
+        signalInfo.value = value;
+        RHI_VK_RETURN_IF_FAILED(vkSignalSemaphore(m_context.GetDevice(), &signalInfo));
+        m_signalValue = std::max(m_signalValue, value);
+        return MakeSuccessResult();
+    }
+
+    VkSemaphore GetVkSemaphore() const { return m_semaphore; }
+
+    // 由队列在提交时调用（二进制信号量的值被忽略）：提交成功后CommitSignalValue记录发出的值
+    uint64_t GetNextSignalValue() const { return m_desc.binary ? 0 : m_signalValue + 1; }
+    void CommitSignalValue(uint64_t value) { m_signalValue = std::max(m_signalValue, value); }
+    uint64_t GetWaitValue() const { return m_desc.binary ? 0 : m_signalValue; }
+
+private:
+    VulkanContext& m_context;
+    VkSemaphore m_semaphore = VK_NULL_HANDLE;
+    uint64_t m_signalValue = 0;
+};
+
+// Vulkan事件
+class VulkanEvent : public IEvent {
+public:
+    VulkanEvent(VulkanContext& context, const EventDesc& desc)
+        : m_context(context) {
+        m_desc = desc;
+    }
+
+    ~VulkanEvent() override {
+        if (m_event != VK_NULL_HANDLE) {
+            vkDestroyEvent(m_context.GetDevice(), m_event, nullptr);
+        }
+    }
+
+    Result<void> Initialize() {
+        VkEventCreateInfo eventInfo = {};
+        eventInfo.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+        RHI_VK_RETURN_IF_FAILED(vkCreateEvent(m_context.GetDevice(), &eventInfo, nullptr, &m_event));
+        return MakeSuccessResult();
+    }
+
+    Result<void*> GetNativeHandle() override {
+        return MakeSuccessResult(reinterpret_cast<void*>(m_event));
+    }
+
+    Result<void> Set() override {
+        RHI_VK_RETURN_IF_FAILED(vkSetEvent(m_context.GetDevice(), m_event));
+        return MakeSuccessResult();
+    }
+
+    Result<void> Reset() override {
+        RHI_VK_RETURN_IF_FAILED(vkResetEvent(m_context.GetDevice(), m_event));
+        return MakeSuccessResult();
+    }
+
+    Result<bool> GetStatus() const override {
+        VkResult result = vkGetEventStatus(m_context.GetDevice(), m_event);
+        RHI_RETURN_IF_FALSE(result == VK_EVENT_SET || result == VK_EVENT_RESET,
+            GetVkErrorCode(result),
+            std::string("vkGetEventStatus失败: ") + GetVkResultName(result));
+        return MakeSuccessResult(result == VK_EVENT_SET);
+    }
+
+private:
+    VulkanContext& m_context;
+    VkEvent m_event = VK_NULL_HANDLE;
+};
+
+} // namespace RHI
@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RHI {
+
+// 工作线程池
+// ParallelFor把[0, count)分发给所有工作线程与调用线程，返回时全部任务已完成。
+// 来自多个调用者（如多个队列）的任务被串行化；任务内部不能再次调用ParallelFor。
+class WorkerPool {
+public:
+    // threadCount为0时使用硬件并发数
+    explicit WorkerPool(uint32_t threadCount = 0) {
+        if (threadCount == 0) {
+            threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        // 调用线程也参与执行，因此只需额外创建threadCount - 1个线程
+        for (uint32_t i = 1; i < threadCount; ++i) {
+            m_workers.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // 参与执行的线程总数（含调用线程）
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& func) {
+        if (count == 0) {
+            return;
+        }
+        if (m_workers.empty() || count == 1) {
+            for (uint32_t i = 0; i < count; ++i) {
+                func(i);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> jobLock(m_jobMutex);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_func = &func;
+            m_count = count;
+            m_next.store(0, std::memory_order_relaxed);
+            m_pending = static_cast<uint32_t>(m_workers.size());
+            ++m_generation;
+        }
+        m_wake.notify_all();
+
+        RunItems();
+
+        // 等待所有工作线程离开本次任务，之后func才可以被销毁
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_done.wait(lock, [this]() { return m_pending == 0; });
+        m_func = nullptr;
+    }
+
+private:
+    void WorkerLoop() {
+        uint64_t seenGeneration = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [&]() { return m_stop || m_generation != seenGeneration; });
+                if (m_stop) {
+                    return;
+                }
+                seenGeneration = m_generation;
+            }
+
+            RunItems();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0) {
+                m_done.notify_one();
+            }
+        }
+    }
+
+    void RunItems() {
+        for (;;) {
+            uint32_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= m_count) {
+                return;
+            }
+            (*m_func)(index);
+        }
+    }
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_jobMutex;                      // 串行化来自多个调用者的任务
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(uint32_t)>* m_func = nullptr;
+    uint32_t m_count = 0;
+    std::atomic<uint32_t> m_next{0};
+    uint64_t m_generation = 0;
+    uint32_t m_pending = 0;
+    bool m_stop = false;
+};
+
+} // namespace RHI
@@ -0,0 +1,178 @@
+// 异步计算调度的队列重叠
+// 每帧9个工作项：阴影、G缓冲、光照、合成与UI在图形队列；光源剔除、SSAO、粒子模拟与后处理在计算队列，
+// 光源列表、深度、SSAO结果与场景颜色在两个队列之间转移所有权。
+// 按给定的每项GPU耗时打印两个队列的忙碌与重叠时间，并与全部提交到图形队列的串行版本对比；
+// 同时打印每帧录制+调度+提交的CPU耗时（空后端）。重叠为零或提交失败时返回非零退出码。
+#include "NullBackend.h"
+#include "AsyncComputeScheduler.h"
+#include "BenchUtil.h"
+#include <memory>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint64_t kMs = 1000000;
+
+struct Work {
+    const char* name;
+    QueueType queue;
+    uint64_t gpuTimeNs;
+};
+
+// 工作项按提交顺序排列
+constexpr Work kWork[] = {
+    {"Shadows", QueueType::Graphics, 2 * kMs},
+    {"LightCulling", QueueType::Compute, 1 * kMs},
+    {"GBuffer", QueueType::Graphics, 3 * kMs},
+    {"SSAO", QueueType::Compute, 3 * kMs / 2},
+    {"Lighting", QueueType::Graphics, 5 * kMs / 2},
+    {"Particles", QueueType::Compute, 1 * kMs},
+    {"Composite", QueueType::Graphics, kMs / 2},
+    {"PostProcess", QueueType::Compute, 2 * kMs},
+    {"UI", QueueType::Graphics, kMs / 2},
+};
+constexpr uint32_t kWorkCount = sizeof(kWork) / sizeof(kWork[0]);
+
+struct Scene {
+    std::unique_ptr<IBuffer> lightList;
+    std::unique_ptr<ITexture> depth;
+    std::unique_ptr<ITexture> ssao;
+    std::unique_ptr<ITexture> sceneColor;
+    std::unique_ptr<ITexture> output;
+};
+
+BarrierDesc MakeTransition(void* resource, BarrierResourceType type, ResourceState before, ResourceState after) {
+    BarrierDesc barrier = {};
+    barrier.type = BarrierType::Transition;
+    barrier.resource = resource;
+    barrier.resourceType = type;
+    barrier.stateBefore = before;
+    barrier.stateAfter = after;
+    return barrier;
+}
+
+double ToMs(uint64_t ns) {
+    return static_cast<double>(ns) / static_cast<double>(kMs);
+}
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kFrames = 20000;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+
+    Scene scene;
+    BufferDesc bufferDesc;
+    bufferDesc.type = BufferType::Storage;
+    bufferDesc.usage = BufferUsage::UnorderedAccess | BufferUsage::ShaderResource;
+    bufferDesc.size = 256 * 1024;
+    bufferDesc.stride = 16;
+    scene.lightList.reset(device->CreateBuffer(bufferDesc).GetValue());
+    TextureDesc textureDesc;
+    textureDesc.width = 1920;
+    textureDesc.height = 1080;
+    textureDesc.format = Format::D32_FLOAT;
+    textureDesc.usage = TextureUsage::DepthStencil | TextureUsage::ShaderResource;
+    scene.depth.reset(device->CreateTexture(textureDesc).GetValue());
+    textureDesc.format = Format::R8_UNORM;
+    textureDesc.usage = TextureUsage::UnorderedAccess | TextureUsage::ShaderResource;
+    scene.ssao.reset(device->CreateTexture(textureDesc).GetValue());
+    textureDesc.format = Format::RGBA16_FLOAT;
+    textureDesc.usage = TextureUsage::RenderTarget | TextureUsage::ShaderResource;
+    scene.sceneColor.reset(device->CreateTexture(textureDesc).GetValue());
+    textureDesc.usage = TextureUsage::UnorderedAccess | TextureUsage::ShaderResource;
+    scene.output.reset(device->CreateTexture(textureDesc).GetValue());
+
+    const BarrierResourceType buffer = BarrierResourceType::Buffer;
+    const BarrierResourceType texture = BarrierResourceType::Texture;
+    const BarrierDesc lightListHandoff = MakeTransition(scene.lightList.get(), buffer,
+        ResourceState::UnorderedAccess, ResourceState::ShaderResource);
+    const BarrierDesc depthHandoff = MakeTransition(scene.depth.get(), texture,
+        ResourceState::DepthWrite, ResourceState::ShaderResource);
+    const BarrierDesc ssaoHandoff = MakeTransition(scene.ssao.get(), texture,
+        ResourceState::UnorderedAccess, ResourceState::ShaderResource);
+    const BarrierDesc sceneColorHandoff = MakeTransition(scene.sceneColor.get(), texture,
+        ResourceState::RenderTarget, ResourceState::ShaderResource);
+    const BarrierDesc outputHandoff = MakeTransition(scene.output.get(), texture,
+        ResourceState::UnorderedAccess, ResourceState::RenderTarget);
+
+    FrameCommandAllocatorDesc allocatorDesc;
+    allocatorDesc.framesInFlight = 3;
+    FrameCommandAllocator allocator(device.get(), allocatorDesc);
+    AsyncComputeScheduler scheduler(device.get(), allocator);
+    bool ok = allocator.Initialize().IsSuccess();
+    ok &= scheduler.Initialize().IsSuccess();
+
+    auto frame = [&](bool async) {
+        ok &= allocator.BeginFrame().IsSuccess();
+        scheduler.Reset();
+        uint32_t items[kWorkCount];
+        for (uint32_t i = 0; i < kWorkCount; ++i) {
+            QueueType queue = async ? kWork[i].queue : QueueType::Graphics;
+            auto commandBuffer = allocator.Allocate(queue);
+            ok &= commandBuffer.IsSuccess();
+            ok &= commandBuffer.GetValue()->Begin().IsSuccess();
+            ok &= commandBuffer.GetValue()->Dispatch(240, 135, 1).IsSuccess();
+            ok &= commandBuffer.GetValue()->End().IsSuccess();
+            items[i] = scheduler.AddWork(kWork[i].name, queue, commandBuffer.GetValue(), kWork[i].gpuTimeNs);
+        }
+        scheduler.AddHandoff(items[1], items[2], lightListHandoff);     // LightCulling -> GBuffer
+        scheduler.AddHandoff(items[2], items[3], depthHandoff);         // GBuffer -> SSAO
+        scheduler.AddHandoff(items[3], items[6], ssaoHandoff);          // SSAO -> Composite
+        scheduler.AddDependency(items[6], items[4]);                    // Lighting -> Composite
+        scheduler.AddHandoff(items[6], items[7], sceneColorHandoff);    // Composite -> PostProcess
+        scheduler.AddHandoff(items[7], items[8], outputHandoff);        // PostProcess -> UI
+        ok &= scheduler.Submit().IsSuccess();
+    };
+
+    frame(false);
+    AsyncComputeReport serial = scheduler.GetReport();
+    Bench::Run("Frame (all work on graphics queue)", kFrames, [&](uint64_t) { frame(false); });
+    Bench::Run("Frame (async compute)", kFrames, [&](uint64_t) { frame(true); });
+    AsyncComputeReport report = scheduler.GetReport();
+
+    std::printf("graphics only: frame %.2f ms, %u submission(s)\n", ToMs(serial.frameNs), serial.submissionCount);
+    std::printf("async compute: frame %.2f ms (serial %.2f ms), graphics busy %.2f ms, compute busy %.2f ms\n",
+                ToMs(report.frameNs), ToMs(report.serialNs), ToMs(report.graphicsBusyNs), ToMs(report.computeBusyNs));
+    std::printf("overlap: %.2f ms (%.0f%% of compute work hidden behind graphics)\n",
+                ToMs(report.overlapNs), report.GetOverlapRatio() * 100.0);
+    std::printf("per frame: %u submissions in %u SubmitBatch calls, %u cross-queue waits, %u ownership handoffs\n",
+                report.submissionCount, report.submitCallCount, report.semaphoreWaitCount, report.handoffCount);
+
+    ok &= serial.handoffCount == 0 && report.handoffCount == 5;
+
+    // 异步模式下同一队列上的生产者与消费者之间只录制一次普通转换（一个屏障命令缓冲区，没有所有权转移）
+    {
+        ok &= allocator.BeginFrame().IsSuccess();
+        scheduler.Reset();
+        uint32_t items[2];
+        for (uint32_t i = 0; i < 2; ++i) {
+            auto commandBuffer = allocator.Allocate(QueueType::Graphics);
+            ok &= commandBuffer.IsSuccess();
+            ok &= commandBuffer.GetValue()->Begin().IsSuccess();
+            ok &= commandBuffer.GetValue()->End().IsSuccess();
+            items[i] = scheduler.AddWork(kWork[i].name, QueueType::Graphics, commandBuffer.GetValue(), kMs);
+        }
+        scheduler.AddHandoff(items[0], items[1], sceneColorHandoff);
+        FrameCommandAllocatorStats before = allocator.GetStats();
+        ok &= scheduler.Submit().IsSuccess();
+        FrameCommandAllocatorStats after = allocator.GetStats();
+        uint64_t barrierBuffers = (after.commandBufferAllocations + after.commandBufferReuses) -
+            (before.commandBufferAllocations + before.commandBufferReuses);
+        ok &= barrierBuffers == 1 && scheduler.GetReport().handoffCount == 0;
+    }
+
+    if (!ok) {
+        std::printf("frame submission failed\n");
+        return 1;
+    }
+    if (report.overlapNs == 0 || report.frameNs >= serial.frameNs) {
+        std::printf("async compute did not overlap graphics work\n");
+        return 1;
+    }
+    return 0;
+}
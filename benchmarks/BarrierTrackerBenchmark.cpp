@@ -0,0 +1,315 @@
+// 自动屏障跟踪与手写屏障的对比
+// 每帧录制一条后处理链：深度预通道 -> 光源剔除（两次写入同一缓冲区）-> 主通道 ->
+// 6级mip的泛光降采样/升采样（逐mip读写同一纹理）-> 合成。
+// 手写版本按常见的防御式写法：每个通道之前把用到的资源从Common转换到所需状态，之后再转换回Common。
+// 跟踪版本只声明每个通道需要的状态，由TrackedCommandBuffer合并屏障，跨帧状态由ResourceStateRegistry在提交时对齐。
+// 打印每帧的屏障数、ResourceBarrier调用数与录制+提交耗时（空后端，不含驱动开销）。
+#include "NullBackend.h"
+#include "ResourceStateTracker.h"
+#include "BenchUtil.h"
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kBloomMips = 6;
+
+struct Use {
+    void* resource;
+    BarrierResourceType type;
+    ResourceState state;
+    uint32_t mip;                // kAllMips表示整个资源
+};
+
+constexpr uint32_t kAllMips = ~0u;
+
+struct Scene {
+    std::unique_ptr<ITexture> depth;
+    std::unique_ptr<ITexture> sceneColor;
+    std::unique_ptr<ITexture> bloom;
+    std::unique_ptr<ITexture> output;
+    std::unique_ptr<IBuffer> lights;
+    std::unique_ptr<IBuffer> indirectArgs;
+};
+
+// 手写屏障：每个通道前后各一次ResourceBarrier调用
+struct NaiveRecorder {
+    ICommandBuffer* commandBuffer;
+    uint64_t barriers = 0;
+    uint64_t barrierCalls = 0;
+    std::vector<BarrierDesc> descs;
+    std::vector<TextureSubresourceRange> ranges;
+
+    bool Transition(const std::vector<Use>& uses, bool enter) {
+        descs.clear();
+        ranges.resize(uses.size());
+        for (size_t i = 0; i < uses.size(); ++i) {
+            BarrierDesc barrier = {};
+            barrier.type = BarrierType::Transition;
+            barrier.resource = uses[i].resource;
+            barrier.resourceType = uses[i].type;
+            barrier.stateBefore = enter ? ResourceState::Common : uses[i].state;
+            barrier.stateAfter = enter ? uses[i].state : ResourceState::Common;
+            if (uses[i].mip != kAllMips) {
+                ranges[i].baseMipLevel = uses[i].mip;
+                barrier.range = &ranges[i];
+            }
+            descs.push_back(barrier);
+        }
+        barriers += descs.size();
+        ++barrierCalls;
+        return commandBuffer->ResourceBarrier(static_cast<uint32_t>(descs.size()), descs.data()).IsSuccess();
+    }
+
+    template<typename Work>
+    bool Pass(const std::vector<Use>& uses, Work&& work) {
+        bool ok = Transition(uses, true);
+        ok &= work(commandBuffer);
+        ok &= Transition(uses, false);
+        return ok;
+    }
+};
+
+// 自动跟踪：只声明所需状态
+struct TrackedRecorder {
+    TrackedCommandBuffer* commandBuffer;
+
+    template<typename Work>
+    bool Pass(const std::vector<Use>& uses, Work&& work) {
+        bool ok = true;
+        for (const Use& use : uses) {
+            if (use.type == BarrierResourceType::Buffer) {
+                ok &= commandBuffer->RequireState(static_cast<IBuffer*>(use.resource), use.state).IsSuccess();
+            } else if (use.mip == kAllMips) {
+                ok &= commandBuffer->RequireState(static_cast<ITexture*>(use.resource), use.state).IsSuccess();
+            } else {
+                TextureSubresourceRange range;
+                range.baseMipLevel = use.mip;
+                ok &= commandBuffer->RequireState(static_cast<ITexture*>(use.resource), use.state, range).IsSuccess();
+            }
+        }
+        return ok && work(commandBuffer);
+    }
+};
+
+Use TextureUse(const std::unique_ptr<ITexture>& texture, ResourceState state, uint32_t mip = kAllMips) {
+    return {texture.get(), BarrierResourceType::Texture, state, mip};
+}
+
+Use BufferUse(const std::unique_ptr<IBuffer>& buffer, ResourceState state) {
+    return {buffer.get(), BarrierResourceType::Buffer, state, kAllMips};
+}
+
+// 录制一帧后处理链（两种记录器共用）
+template<typename Recorder>
+bool RecordFrame(Recorder& recorder, const Scene& scene) {
+    auto draw = [](ICommandBuffer* commandBuffer) {
+        bool ok = true;
+        for (uint32_t i = 0; i < 4; ++i) {
+            ok &= commandBuffer->Draw(3, 1, 0, 0).IsSuccess();
+        }
+        return ok;
+    };
+    auto dispatch = [](ICommandBuffer* commandBuffer) {
+        return commandBuffer->Dispatch(8, 8, 1).IsSuccess();
+    };
+
+    bool ok = recorder.Pass({TextureUse(scene.depth, ResourceState::DepthWrite)}, draw);
+    for (uint32_t i = 0; i < 2; ++i) {
+        ok &= recorder.Pass({TextureUse(scene.depth, ResourceState::ShaderResource),
+                             BufferUse(scene.lights, ResourceState::UnorderedAccess)}, dispatch);
+    }
+    ok &= recorder.Pass({TextureUse(scene.sceneColor, ResourceState::RenderTarget),
+                         TextureUse(scene.depth, ResourceState::DepthRead),
+                         BufferUse(scene.lights, ResourceState::ShaderResource)}, draw);
+
+    ok &= recorder.Pass({TextureUse(scene.sceneColor, ResourceState::ShaderResource),
+                         TextureUse(scene.bloom, ResourceState::UnorderedAccess, 0)}, dispatch);
+    for (uint32_t mip = 1; mip < kBloomMips; ++mip) {
+        ok &= recorder.Pass({TextureUse(scene.bloom, ResourceState::ShaderResource, mip - 1),
+                             TextureUse(scene.bloom, ResourceState::UnorderedAccess, mip)}, dispatch);
+    }
+    for (uint32_t mip = kBloomMips - 1; mip-- > 0;) {
+        ok &= recorder.Pass({TextureUse(scene.bloom, ResourceState::ShaderResource, mip + 1),
+                             TextureUse(scene.bloom, ResourceState::UnorderedAccess, mip)}, dispatch);
+    }
+
+    ok &= recorder.Pass({TextureUse(scene.sceneColor, ResourceState::ShaderResource),
+                         TextureUse(scene.bloom, ResourceState::ShaderResource),
+                         TextureUse(scene.depth, ResourceState::ShaderResource),
+                         TextureUse(scene.output, ResourceState::RenderTarget),
+                         BufferUse(scene.indirectArgs, ResourceState::IndirectArgument)},
+        [&](ICommandBuffer* commandBuffer) {
+            return commandBuffer->DrawIndirect(scene.indirectArgs.get(), 0, 1, sizeof(DrawIndirectArgs)).IsSuccess();
+        });
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kFrames = 20000;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    std::unique_ptr<IFence> fence(device->CreateFence(FenceDesc()).GetValue());
+    IQueue* queue = device->GetQueue(QueueType::Graphics, 0).GetValue();
+
+    Scene scene;
+    TextureDesc textureDesc;
+    textureDesc.width = 1920;
+    textureDesc.height = 1080;
+    textureDesc.format = Format::D32_FLOAT;
+    textureDesc.usage = TextureUsage::DepthStencil | TextureUsage::ShaderResource;
+    scene.depth.reset(device->CreateTexture(textureDesc).GetValue());
+    textureDesc.format = Format::RGBA16_FLOAT;
+    textureDesc.usage = TextureUsage::RenderTarget | TextureUsage::ShaderResource;
+    scene.sceneColor.reset(device->CreateTexture(textureDesc).GetValue());
+    scene.output.reset(device->CreateTexture(textureDesc).GetValue());
+    textureDesc.mipLevels = kBloomMips;
+    textureDesc.usage = TextureUsage::UnorderedAccess | TextureUsage::ShaderResource;
+    scene.bloom.reset(device->CreateTexture(textureDesc).GetValue());
+    BufferDesc bufferDesc;
+    bufferDesc.type = BufferType::Storage;
+    bufferDesc.usage = BufferUsage::UnorderedAccess | BufferUsage::ShaderResource;
+    bufferDesc.size = 64 * 1024;
+    bufferDesc.stride = 16;
+    scene.lights.reset(device->CreateBuffer(bufferDesc).GetValue());
+    bufferDesc.type = BufferType::Indirect;
+    bufferDesc.usage = BufferUsage::IndirectArgs;
+    bufferDesc.size = sizeof(DrawIndirectArgs);
+    scene.indirectArgs.reset(device->CreateBuffer(bufferDesc).GetValue());
+
+    FrameCommandAllocator allocator(device.get());
+    bool ok = allocator.Initialize().IsSuccess();
+    ResourceStateRegistry registry;
+
+    std::vector<ICommandBuffer*> submitList(1);
+    NaiveRecorder naive = {};
+    auto naiveFrame = [&]() {
+        ok &= allocator.BeginFrame().IsSuccess();
+        auto commandBuffer = allocator.Allocate(QueueType::Graphics);
+        ok &= commandBuffer.IsSuccess();
+        naive.commandBuffer = commandBuffer.GetValue();
+        ok &= naive.commandBuffer->Begin().IsSuccess();
+        ok &= RecordFrame(naive, scene);
+        ok &= naive.commandBuffer->End().IsSuccess();
+        submitList[0] = naive.commandBuffer;
+        ok &= allocator.Submit(QueueType::Graphics, queue, submitList, {}, {}, fence.get()).IsSuccess();
+    };
+
+    // 每个帧槽位一个包装器，包装器在Begin时清空跟踪状态并复用其存储
+    std::vector<std::unique_ptr<TrackedCommandBuffer>> wrappers;
+    std::vector<TrackedCommandBuffer*> trackedList(1);
+    auto trackedFrame = [&]() {
+        ok &= allocator.BeginFrame().IsSuccess();
+        auto commandBuffer = allocator.Allocate(QueueType::Graphics);
+        ok &= commandBuffer.IsSuccess();
+        TrackedCommandBuffer* tracked = nullptr;
+        for (const auto& wrapper : wrappers) {
+            if (wrapper->GetCommandBuffer() == commandBuffer.GetValue()) {
+                tracked = wrapper.get();
+            }
+        }
+        if (tracked == nullptr) {
+            wrappers.emplace_back(new TrackedCommandBuffer(commandBuffer.GetValue()));
+            tracked = wrappers.back().get();
+        }
+        TrackedRecorder recorder = {tracked};
+        ok &= tracked->Begin().IsSuccess();
+        ok &= RecordFrame(recorder, scene);
+        ok &= tracked->End().IsSuccess();
+        trackedList[0] = tracked;
+        ok &= SubmitTracked(registry, allocator, QueueType::Graphics, queue, trackedList, {}, {}, fence.get()).IsSuccess();
+    };
+
+    Bench::Run("Frame (hand-written barriers)", kFrames, [&](uint64_t) { naiveFrame(); });
+    Bench::Run("Frame (TrackedCommandBuffer)", kFrames, [&](uint64_t) { trackedFrame(); });
+
+    // 稳定状态下单帧的屏障统计
+    naive.barriers = 0;
+    naive.barrierCalls = 0;
+    naiveFrame();
+    for (const auto& wrapper : wrappers) {
+        wrapper->ResetStats();
+    }
+    uint64_t fixupsBefore = registry.GetFixupBarrierCount();
+    trackedFrame();
+    BarrierTrackerStats stats;
+    for (const auto& wrapper : wrappers) {
+        const BarrierTrackerStats& wrapperStats = wrapper->GetStats();
+        stats.stateRequests += wrapperStats.stateRequests;
+        stats.satisfiedRequests += wrapperStats.satisfiedRequests;
+        stats.transitions += wrapperStats.transitions;
+        stats.uavBarriers += wrapperStats.uavBarriers;
+        stats.barrierCalls += wrapperStats.barrierCalls;
+    }
+    uint64_t fixups = registry.GetFixupBarrierCount() - fixupsBefore;
+
+    std::printf("hand-written: %llu barriers in %llu ResourceBarrier calls per frame\n",
+                static_cast<unsigned long long>(naive.barriers),
+                static_cast<unsigned long long>(naive.barrierCalls));
+    std::printf("tracked:      %llu barriers (%llu transitions, %llu UAV, %llu submit-time fix-ups) "
+                "in %llu ResourceBarrier calls per frame\n",
+                static_cast<unsigned long long>(stats.transitions + stats.uavBarriers + fixups),
+                static_cast<unsigned long long>(stats.transitions),
+                static_cast<unsigned long long>(stats.uavBarriers),
+                static_cast<unsigned long long>(fixups),
+                static_cast<unsigned long long>(stats.barrierCalls + (fixups > 0 ? 1 : 0)));
+    std::printf("              %llu of %llu subresource requests needed no barrier\n",
+                static_cast<unsigned long long>(stats.satisfiedRequests),
+                static_cast<unsigned long long>(stats.stateRequests));
+
+    // 超出纹理mip与层数的范围在任何构建下都被拒绝
+    {
+        ok &= allocator.BeginFrame().IsSuccess();
+        TrackedCommandBuffer outOfRange(allocator.Allocate(QueueType::Graphics).GetValue());
+        ok &= outOfRange.Begin().IsSuccess();
+        TextureSubresourceRange range;
+        range.baseMipLevel = kBloomMips;
+        ok &= !outOfRange.RequireState(scene.bloom.get(), ResourceState::ShaderResource, range).IsSuccess();
+        BarrierDesc barrier = {};
+        barrier.type = BarrierType::Transition;
+        barrier.resource = scene.bloom.get();
+        barrier.resourceType = BarrierResourceType::Texture;
+        barrier.stateBefore = ResourceState::ShaderResource;
+        barrier.stateAfter = ResourceState::UnorderedAccess;
+        barrier.range = &range;
+        ok &= !outOfRange.ResourceBarrier(1, &barrier).IsSuccess();
+        range.baseMipLevel = 0;
+        range.baseArrayLayer = 1;
+        ok &= !outOfRange.ResourceBarrier(1, &barrier).IsSuccess();
+        range.baseArrayLayer = 0;
+        range.mipLevelCount = UINT32_MAX;
+        ok &= !outOfRange.ResourceBarrier(1, &barrier).IsSuccess();
+        range.mipLevelCount = 1;
+        ok &= outOfRange.ResourceBarrier(1, &barrier).IsSuccess();
+        ok &= outOfRange.End().IsSuccess();
+    }
+
+#if RHI_VALIDATION_LEVEL != RHI_VALIDATION_LEVEL_OFF
+    // 提交失败（缺少栅栏）时登记表保持不变
+    {
+        ok &= allocator.BeginFrame().IsSuccess();
+        TrackedCommandBuffer failing(allocator.Allocate(QueueType::Graphics).GetValue());
+        ResourceState before = registry.GetState(scene.depth.get());
+        uint64_t fixupsBeforeFailure = registry.GetFixupBarrierCount();
+        ok &= before != ResourceState::CopySource;
+        ok &= failing.Begin().IsSuccess();
+        ok &= failing.RequireState(scene.depth.get(), ResourceState::CopySource).IsSuccess();
+        ok &= failing.End().IsSuccess();
+        trackedList[0] = &failing;
+        ok &= !SubmitTracked(registry, allocator, QueueType::Graphics, queue, trackedList, {}, {}, nullptr).IsSuccess();
+        ok &= registry.GetState(scene.depth.get()) == before && registry.GetFixupBarrierCount() == fixupsBeforeFailure;
+    }
+#endif
+
+    if (!ok) {
+        std::printf("frame recording failed\n");
+        return 1;
+    }
+    return 0;
+}
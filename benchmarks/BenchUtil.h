@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// 阻止内联，保证被测函数以真实调用的形式执行
+#if defined(_MSC_VER)
+#define RHI_BENCH_NOINLINE __declspec(noinline)
+#else
+#define RHI_BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace RHI {
+namespace Bench {
+
+// 防止编译器优化掉基准测试结果
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile s_sink;
+    s_sink = &value;
+#endif
+}
+
+// 运行基准测试并打印每次迭代的平均耗时（纳秒）
+template<typename Func>
+inline double Run(const char* name, uint64_t iterations, Func&& func) {
+    // 预热
+    for (uint64_t i = 0; i < iterations / 10 + 1; ++i) {
+        func(i);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        func(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - begin).count()
+        / static_cast<double>(iterations);
+    std::printf("%-48s %10.2f ns/op\n", name, ns);
+    return ns;
+}
+
+} // namespace Bench
+} // namespace RHI
@@ -0,0 +1,244 @@
+// CPU后端在不同工作线程数下的吞吐量
+// 每帧：1080p渲染目标上的全屏三角形网格绘制 + 一次计算调度，
+// 依次以1、2、4……直到硬件并发数个线程运行，打印每帧耗时与相对单线程的加速比。
+#include "CPUBackend.h"
+#include "BenchUtil.h"
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kWidth = 1920;
+constexpr uint32_t kHeight = 1080;
+constexpr uint32_t kGridSize = 32;                  // 全屏网格每边的四边形数
+constexpr uint32_t kComputeGroups = 4096;
+constexpr uint32_t kComputeGroupSize = 256;
+
+double RunFrames(uint32_t threadCount, uint64_t frames) {
+    CPUAdapter adapter(threadCount);
+    std::unique_ptr<CPUDevice> device(static_cast<CPUDevice*>(adapter.CreateDevice(DeviceDesc()).GetValue()));
+
+    device->RegisterVertexShader("FullscreenVS", [](const CPUVertexInput& input, CPUVertexOutput& output) {
+        const float* position = reinterpret_cast<const float*>(input.vertexData[0]);
+        output.position[0] = position[0];
+        output.position[1] = position[1];
+        output.position[2] = 0.5f;
+        output.position[3] = 1.0f;
+        output.varyings[0] = position[0] * 0.5f + 0.5f;
+        output.varyings[1] = position[1] * 0.5f + 0.5f;
+    }, 2);
+    device->RegisterPixelShader("GradientPS", [](const CPUPixelInput& input, CPUPixelOutput& output) {
+        output.color[0][0] = input.varyings[0];
+        output.color[0][1] = input.varyings[1];
+        output.color[0][2] = 0.5f;
+        output.color[0][3] = 1.0f;
+        return true;
+    });
+    device->RegisterComputeKernel("ScaleCS", [](const CPUComputeInput& input) {
+        float* data = reinterpret_cast<float*>(input.resources->GetBufferData(0, 0));
+        uint32_t begin = input.groupId[0] * kComputeGroupSize;
+        for (uint32_t i = begin; i < begin + kComputeGroupSize; ++i) {
+            data[i] = data[i] * 0.5f + 1.0f;
+        }
+    });
+
+    ShaderDesc shaderDesc;
+    shaderDesc.type = ShaderType::Vertex;
+    shaderDesc.entryPoint = "FullscreenVS";
+    std::unique_ptr<IShader> vertexShader(device->CreateShader(shaderDesc).GetValue());
+    shaderDesc.type = ShaderType::Pixel;
+    shaderDesc.entryPoint = "GradientPS";
+    std::unique_ptr<IShader> pixelShader(device->CreateShader(shaderDesc).GetValue());
+    shaderDesc.type = ShaderType::Compute;
+    shaderDesc.entryPoint = "ScaleCS";
+    std::unique_ptr<IShader> computeShader(device->CreateShader(shaderDesc).GetValue());
+
+    GraphicsPipelineStateDesc graphicsDesc;
+    graphicsDesc.vertexShader = vertexShader.get();
+    graphicsDesc.pixelShader = pixelShader.get();
+    graphicsDesc.rasterizationState.cullMode = RasterizationState::CullMode::None;
+    std::unique_ptr<IPipelineState> graphicsPipeline(device->CreatePipelineState(graphicsDesc).GetValue());
+    ComputePipelineStateDesc computeDesc;
+    computeDesc.computeShader = computeShader.get();
+    std::unique_ptr<IPipelineState> computePipeline(device->CreatePipelineState(computeDesc).GetValue());
+
+    TextureDesc textureDesc;
+    textureDesc.width = kWidth;
+    textureDesc.height = kHeight;
+    textureDesc.usage = TextureUsage::RenderTarget;
+    std::unique_ptr<ITexture> renderTarget(device->CreateTexture(textureDesc).GetValue());
+    TextureSubresourceRange range = {};
+    range.mipLevelCount = 1;
+    range.arrayLayerCount = 1;
+    void* renderTargetView = renderTarget->GetRenderTargetView(range).GetValue();
+
+    // 全屏网格（每个四边形两个三角形）
+    std::vector<float> vertices;
+    for (uint32_t y = 0; y < kGridSize; ++y) {
+        for (uint32_t x = 0; x < kGridSize; ++x) {
+            float x0 = -1.0f + 2.0f * x / kGridSize;
+            float y0 = -1.0f + 2.0f * y / kGridSize;
+            float x1 = -1.0f + 2.0f * (x + 1) / kGridSize;
+            float y1 = -1.0f + 2.0f * (y + 1) / kGridSize;
+            vertices.insert(vertices.end(), {x0, y0, x1, y0, x0, y1, x1, y0, x1, y1, x0, y1});
+        }
+    }
+    BufferDesc vertexDesc;
+    vertexDesc.size = vertices.size() * sizeof(float);
+    std::unique_ptr<IBuffer> vertexBuffer(device->CreateBuffer(vertexDesc).GetValue());
+    bool ok = vertexBuffer->UpdateData(vertices.data(), vertexDesc.size, 0).IsSuccess();
+    // 基类描述或type与实际类型不符的描述被拒绝
+    ok &= !device->CreatePipelineState(PipelineStateDesc()).IsSuccess();
+    ComputePipelineStateDesc mislabeledDesc;
+    mislabeledDesc.type = PipelineType::Graphics;
+    ok &= !device->CreatePipelineState(mislabeledDesc).IsSuccess();
+    BufferViewDesc vertexViewDesc = {0, vertexDesc.size, sizeof(float) * 2};
+    void* vertexBufferView = vertexBuffer->GetVertexBufferView(vertexViewDesc).GetValue();
+
+    BufferDesc dataDesc;
+    dataDesc.type = BufferType::Storage;
+    dataDesc.usage = BufferUsage::UnorderedAccess;
+    dataDesc.size = static_cast<size_t>(kComputeGroups) * kComputeGroupSize * sizeof(float);
+    std::unique_ptr<IBuffer> dataBuffer(device->CreateBuffer(dataDesc).GetValue());
+    BufferViewDesc dataViewDesc = {0, dataDesc.size, sizeof(float)};
+    void* dataView = dataBuffer->GetUnorderedAccessView(dataViewDesc).GetValue();
+
+    DescriptorSetLayoutDesc layoutDesc = {};
+    std::unique_ptr<IDescriptorSetLayout> layout(device->CreateDescriptorSetLayout(layoutDesc).GetValue());
+    DescriptorPoolDesc poolDesc = {};
+    poolDesc.maxSets = 1;
+    std::unique_ptr<IDescriptorPool> descriptorPool(device->CreateDescriptorPool(poolDesc).GetValue());
+    IDescriptorSet* descriptorSet = descriptorPool->AllocateDescriptorSet(layout.get()).GetValue();
+    DescriptorWrite write = {};
+    write.dstBinding = 0;
+    write.type = DescriptorType::StorageBuffer;
+    write.bufferInfo = dataView;
+    ok &= descriptorSet->UpdateDescriptor({write}).IsSuccess();
+
+    std::unique_ptr<ICommandPool> commandPool(device->CreateCommandPool(QueueType::Graphics).GetValue());
+    ICommandBuffer* commandBuffer = commandPool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+    void* colorAttachments[] = {renderTargetView};
+    RenderPassDesc renderPass = {1, colorAttachments, nullptr};
+
+    ok &= commandBuffer->Begin().IsSuccess();
+    ok &= commandBuffer->BeginRenderPass(renderPass).IsSuccess();
+    ok &= commandBuffer->SetPipelineState(graphicsPipeline.get()).IsSuccess();
+    ok &= commandBuffer->SetVertexBuffer(0, vertexBufferView).IsSuccess();
+    ok &= commandBuffer->Draw(static_cast<uint32_t>(vertices.size() / 2), 1, 0, 0).IsSuccess();
+    ok &= commandBuffer->EndRenderPass().IsSuccess();
+    ok &= commandBuffer->SetPipelineState(computePipeline.get()).IsSuccess();
+    ok &= commandBuffer->SetDescriptorSet(0, descriptorSet).IsSuccess();
+    ok &= commandBuffer->Dispatch(kComputeGroups, 1, 1).IsSuccess();
+    ok &= commandBuffer->End().IsSuccess();
+
+    IQueue* queue = device->GetQueue(QueueType::Graphics, 0).GetValue();
+    std::vector<ICommandBuffer*> commandBuffers = {commandBuffer};
+    char name[64];
+    std::snprintf(name, sizeof(name), "Frame (%u threads)", threadCount);
+    double frameNs = Bench::Run(name, frames, [&](uint64_t) {
+        Bench::DoNotOptimize(queue->Submit(commandBuffers, {}, {}, nullptr).IsSuccess());
+    });
+    if (!ok) {
+        std::printf("setup failed\n");
+    }
+    return frameNs;
+}
+
+// 越过执行器定长数组或纹理子资源的录制在任何构建下都被拒绝
+bool CheckLimits() {
+    CPUAdapter adapter(1);
+    std::unique_ptr<CPUDevice> device(static_cast<CPUDevice*>(adapter.CreateDevice(DeviceDesc()).GetValue()));
+    std::unique_ptr<ICommandPool> commandPool(device->CreateCommandPool(QueueType::Graphics).GetValue());
+    ICommandBuffer* commandBuffer = commandPool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+    IQueue* queue = device->GetQueue(QueueType::Graphics, 0).GetValue();
+
+    DescriptorSetLayoutDesc layoutDesc = {};
+    std::unique_ptr<IDescriptorSetLayout> layout(device->CreateDescriptorSetLayout(layoutDesc).GetValue());
+    DescriptorPoolDesc poolDesc = {};
+    poolDesc.maxSets = 1;
+    std::unique_ptr<IDescriptorPool> descriptorPool(device->CreateDescriptorPool(poolDesc).GetValue());
+    IDescriptorSet* descriptorSet = descriptorPool->AllocateDescriptorSet(layout.get()).GetValue();
+
+    BufferDesc bufferDesc;
+    bufferDesc.size = 256;
+    std::unique_ptr<IBuffer> buffer(device->CreateBuffer(bufferDesc).GetValue());
+    BufferViewDesc viewDesc = {0, bufferDesc.size, sizeof(float)};
+    void* vertexBufferView = buffer->GetVertexBufferView(viewDesc).GetValue();
+
+    TextureDesc textureDesc;
+    textureDesc.width = 4;
+    textureDesc.height = 4;
+    std::unique_ptr<ITexture> src(device->CreateTexture(textureDesc).GetValue());
+    std::unique_ptr<ITexture> dst(device->CreateTexture(textureDesc).GetValue());
+
+    bool ok = commandBuffer->Begin().IsSuccess();
+    void* colorAttachments[kCPUMaxColorTargets + 1] = {};
+    RenderPassDesc renderPass = {kCPUMaxColorTargets + 1, colorAttachments, nullptr};
+    ok &= !commandBuffer->BeginRenderPass(renderPass).IsSuccess();
+    ok &= !commandBuffer->SetDescriptorSet(kCPUMaxDescriptorSets, descriptorSet).IsSuccess();
+    uint32_t dynamicOffsets[kCPUMaxDynamicOffsets + 1] = {};
+    ok &= !commandBuffer->SetDescriptorSet(0, descriptorSet,
+        Span<const uint32_t>(dynamicOffsets, kCPUMaxDynamicOffsets + 1)).IsSuccess();
+    ok &= !commandBuffer->SetVertexBuffer(kCPUMaxVertexBuffers, vertexBufferView).IsSuccess();
+    uint8_t constants[16] = {};
+    ok &= !commandBuffer->PushConstants(nullptr, kCPUMaxPushConstantSize - 8, sizeof(constants), constants).IsSuccess();
+    ok &= !commandBuffer->PushConstants(nullptr, 16, UINT32_MAX - 8, constants).IsSuccess();
+    ok &= !commandBuffer->CopyTexture(src.get(), dst.get(), 1, nullptr).IsSuccess();
+    ok &= commandBuffer->End().IsSuccess();
+
+    // 子资源与坐标在执行时检查，越界的复制使Submit失败
+    std::vector<ICommandBuffer*> commandBuffers = {commandBuffer};
+    auto submitCopy = [&](const TextureCopyRegion& region) {
+        bool recorded = commandBuffer->Reset().IsSuccess() && commandBuffer->Begin().IsSuccess() &&
+            commandBuffer->CopyTexture(src.get(), dst.get(), 1, const_cast<TextureCopyRegion*>(&region)).IsSuccess() &&
+            commandBuffer->End().IsSuccess();
+        return recorded && queue->Submit(commandBuffers, {}, {}, nullptr).IsSuccess();
+    };
+    TextureCopyRegion region = {0, 0, {0, 0, 0}, 0, 0, {0, 0, 0}, {4, 4, 1}};
+    ok &= submitCopy(region);
+    TextureCopyRegion badLayer = region;
+    badLayer.srcArrayLayer = 7;
+    ok &= !submitCopy(badLayer);
+    TextureCopyRegion badMip = region;
+    badMip.dstMipLevel = 1;
+    ok &= !submitCopy(badMip);
+    TextureCopyRegion badOffset = region;
+    badOffset.dstOffset[0] = 2;
+    ok &= !submitCopy(badOffset);
+    TextureCopyRegion badDepth = region;
+    badDepth.srcOffset[2] = 1;
+    ok &= !submitCopy(badDepth);
+
+    BufferTextureCopyRegion upload = {0, 0, 0, 0, 7, {0, 0, 0}, {4, 4, 1}};
+    ok &= commandBuffer->Reset().IsSuccess() && commandBuffer->Begin().IsSuccess();
+    ok &= commandBuffer->CopyBufferToTexture(buffer.get(), dst.get(), 1, &upload).IsSuccess();
+    ok &= commandBuffer->End().IsSuccess();
+    ok &= !queue->Submit(commandBuffers, {}, {}, nullptr).IsSuccess();
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    if (!CheckLimits()) {
+        std::printf("limits: FAILED\n");
+        return 1;
+    }
+
+    constexpr uint64_t kFrames = 20;
+    uint32_t maxThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    double baseline = RunFrames(1, kFrames);
+    for (uint32_t threads = 2; threads <= maxThreads; threads *= 2) {
+        double frameNs = RunFrames(threads, kFrames);
+        std::printf("  speedup x%.2f\n", baseline / frameNs);
+    }
+    if (maxThreads > 1 && (maxThreads & (maxThreads - 1)) != 0) {
+        double frameNs = RunFrames(maxThreads, kFrames);
+        std::printf("  speedup x%.2f\n", baseline / frameNs);
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+// CommandEncoder录制与回放的每条命令耗时
+// 对比直接在空后端命令缓冲区上录制、录制到CommandEncoder、以及把已录制的命令流回放到命令缓冲区，
+// 每帧为kDrawsPerFrame组“设置顶点缓冲区+设置描述符集+绘制”。
+#include "CommandEncoder.h"
+#include "NullBackend.h"
+#include "BenchUtil.h"
+#include <memory>
+
+using namespace RHI;
+
+int main() {
+    constexpr uint64_t kDrawsPerFrame = 10000;
+    constexpr uint64_t kFrames = 100;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics).GetValue());
+    ICommandBuffer* commandBuffer = pool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+
+    BufferDesc bufferDesc;
+    bufferDesc.size = 65536;
+    std::unique_ptr<IBuffer> vertexBuffer(device->CreateBuffer(bufferDesc).GetValue());
+    BufferViewDesc viewDesc = {0, bufferDesc.size, 16};
+    void* vertexBufferView = vertexBuffer->GetVertexBufferView(viewDesc).GetValue();
+
+    std::unique_ptr<IPipelineState> pipeline(device->CreatePipelineState(GraphicsPipelineStateDesc()).GetValue());
+    DescriptorSetLayoutDesc layoutDesc = {};
+    std::unique_ptr<IDescriptorSetLayout> layout(device->CreateDescriptorSetLayout(layoutDesc).GetValue());
+    DescriptorPoolDesc poolDesc = {};
+    poolDesc.maxSets = 1;
+    std::unique_ptr<IDescriptorPool> descriptorPool(device->CreateDescriptorPool(poolDesc).GetValue());
+    IDescriptorSet* descriptorSet = descriptorPool->AllocateDescriptorSet(layout.get()).GetValue();
+
+    bool ok = true;
+    Bench::Run("ICommandBuffer frame (direct)", kFrames, [&](uint64_t) {
+        ok &= commandBuffer->Begin().IsSuccess();
+        ok &= commandBuffer->SetPipelineState(pipeline.get()).IsSuccess();
+        for (uint32_t i = 0; i < kDrawsPerFrame; ++i) {
+            ok &= commandBuffer->SetVertexBuffer(0, vertexBufferView).IsSuccess();
+            ok &= commandBuffer->SetDescriptorSet(0, descriptorSet).IsSuccess();
+            ok &= commandBuffer->Draw(3 + (i & 0xFF), 1, 0, 0).IsSuccess();
+        }
+        ok &= commandBuffer->End().IsSuccess();
+    });
+
+    CommandEncoder encoder;
+    Bench::Run("CommandEncoder frame (record)", kFrames, [&](uint64_t) {
+        encoder.Reset();
+        encoder.SetPipelineState(pipeline.get());
+        for (uint32_t i = 0; i < kDrawsPerFrame; ++i) {
+            encoder.SetVertexBuffer(0, vertexBufferView);
+            encoder.SetDescriptorSet(0, descriptorSet);
+            encoder.Draw(3 + (i & 0xFF), 1, 0, 0);
+        }
+        Bench::DoNotOptimize(encoder.GetCommandCount());
+    });
+
+    // 静态命令流：录制一次，每帧回放
+    Bench::Run("CommandEncoder frame (replay)", kFrames, [&](uint64_t) {
+        ok &= commandBuffer->Begin().IsSuccess();
+        ok &= encoder.Replay(commandBuffer).IsSuccess();
+        ok &= commandBuffer->End().IsSuccess();
+    });
+
+    std::printf("%u commands, %zu bytes of stream, %zu bytes reserved\n",
+        encoder.GetCommandCount(), encoder.GetMemoryUsage(), encoder.GetMemoryCapacity());
+
+    if (!ok) {
+        std::printf("command recording failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+// 延迟释放队列的流式加载场景
+// 每帧4个生产者线程各创建并释放16个缓冲区与1个哨兵对象，释放时记录本帧的时间线值；
+// 主机端模拟GPU落后3帧发出时间线值，帧线程每帧调用Collect。
+// 哨兵对象在析构时检查时间线是否已到达其值。打印每帧耗时、平均待释放对象数与Collect耗时（空后端）；
+// 出现提前销毁或Drain后仍有对象未销毁时返回非零退出码。
+#include "NullBackend.h"
+#include "DeferredReleaseQueue.h"
+#include "WorkerPool.h"
+#include "BenchUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kProducers = 4;
+constexpr uint32_t kBuffersPerProducer = 16;
+constexpr uint64_t kGpuLag = 3;
+
+std::atomic<uint64_t> g_sentinelsDestroyed{0};
+std::atomic<uint64_t> g_prematureDestroys{0};
+
+// 析构时检查GPU是否已经用完它
+struct Sentinel {
+    ISemaphore* timeline;
+    uint64_t value;
+
+    ~Sentinel() {
+        if (timeline->GetValue().GetValue() < value) {
+            g_prematureDestroys.fetch_add(1, std::memory_order_relaxed);
+        }
+        g_sentinelsDestroyed.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kFrames = 5000;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    SemaphoreDesc semaphoreDesc;
+    semaphoreDesc.binary = false;
+    std::unique_ptr<ISemaphore> timeline(device->CreateSemaphore(semaphoreDesc).GetValue());
+
+    BufferDesc bufferDesc;
+    bufferDesc.type = BufferType::Storage;
+    bufferDesc.usage = BufferUsage::ShaderResource;
+    bufferDesc.size = 64 * 1024;
+    bufferDesc.stride = 16;
+
+    WorkerPool workers(kProducers);
+    DeferredReleaseQueue releaseQueue;
+    uint64_t frameValue = 0;
+    uint64_t sentinelsReleased = 0;
+    uint64_t pendingSum = 0;
+    double collectNs = 0.0;
+    double maxCollectNs = 0.0;
+    std::atomic<bool> ok{true};
+
+    Bench::Run("Frame (4 producers x 17 releases + Collect)", kFrames, [&](uint64_t) {
+        ++frameValue;
+        // 本帧的提交将发出frameValue，生产者在录制之后释放本帧用过的对象
+        workers.ParallelFor(kProducers, [&](uint32_t) {
+            for (uint32_t i = 0; i < kBuffersPerProducer; ++i) {
+                auto buffer = device->CreateBuffer(bufferDesc);
+                if (!buffer.IsSuccess()) {
+                    ok = false;
+                    return;
+                }
+                releaseQueue.Release(buffer.GetValue(), timeline.get(), frameValue);
+            }
+            releaseQueue.Release(new Sentinel{timeline.get(), frameValue}, timeline.get(), frameValue);
+        });
+        sentinelsReleased += kProducers;
+
+        // GPU落后kGpuLag帧
+        if (frameValue > kGpuLag) {
+            ok = ok && timeline->Signal(frameValue - kGpuLag).IsSuccess();
+        }
+        pendingSum += releaseQueue.GetPendingCount();
+        auto begin = std::chrono::steady_clock::now();
+        ok = ok && releaseQueue.Collect().IsSuccess();
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+        collectNs += elapsed;
+        maxCollectNs = std::max(maxCollectNs, elapsed);
+    });
+
+    uint64_t pendingBeforeDrain = releaseQueue.GetPendingCount();
+    // 模拟GPU完成全部工作后排空
+    ok = ok && timeline->Signal(frameValue).IsSuccess();
+    ok = ok && releaseQueue.Drain(0).IsSuccess();
+    DeferredReleaseStats stats = releaseQueue.GetStats();
+
+    std::printf("released %llu objects, destroyed %llu; %.1f pending on average (GPU %llu frames behind), "
+                "%llu pending before drain\n",
+                static_cast<unsigned long long>(stats.releaseRequests),
+                static_cast<unsigned long long>(stats.destroyedObjects),
+                static_cast<double>(pendingSum) / static_cast<double>(frameValue),
+                static_cast<unsigned long long>(kGpuLag),
+                static_cast<unsigned long long>(pendingBeforeDrain));
+    std::printf("Collect: %.0f ns average, %.0f ns max per frame; premature destroys: %llu\n",
+                collectNs / static_cast<double>(frameValue), maxCollectNs,
+                static_cast<unsigned long long>(g_prematureDestroys.load()));
+
+    if (!ok) {
+        std::printf("release or collect failed\n");
+        return 1;
+    }
+    if (g_prematureDestroys.load() != 0 || g_sentinelsDestroyed.load() != sentinelsReleased ||
+        stats.destroyedObjects != stats.releaseRequests || releaseQueue.GetPendingCount() != 0) {
+        std::printf("objects were destroyed early or leaked\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,290 @@
+// 增量碎片整理
+// CPU后端上用MemoryAllocator（16MB内存块）分配3000个4KB~256KB的缓冲区，每个缓冲区有自己的视图与描述符集，
+// 随机释放60%后逐帧调用MemoryDefragmenter::Update（每帧4MB预算）直到空闲，第一批移动途中再释放一部分。
+// 打印每帧耗时、移动的字节数、碎片化程度与内存块数的前后对比；
+// 之后用计算内核经描述符集读取每个缓冲区并校验内容。
+// 某帧移动超过预算、碎片化没有降低、存活分配重叠或内容不正确时返回非零退出码。
+#include "CPUBackend.h"
+#include "MemoryDefragmenter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kObjects = 3000;
+constexpr uint64_t kBudget = 4ull * 1024 * 1024;
+
+uint32_t Word(uint32_t id, uint32_t index) {
+    return id * 2654435761u + index;
+}
+
+// 一个可移动的资源：缓冲区、视图与引用它的描述符集
+struct Resource {
+    uint32_t id = 0;
+    bool live = false;
+    MemoryAllocation allocation;
+    std::unique_ptr<IBuffer> buffer;
+    IDescriptorSet* descriptorSet = nullptr;
+};
+
+// 移动处理器：在新位置创建缓冲区并复制，完成后改写视图与描述符
+class ResourceMover : public IDefragmentationHandler {
+public:
+    ResourceMover(IDevice* device, void* outputView) : m_device(device), m_outputView(outputView) {}
+
+    Result<void> RecordMove(DefragmentationMove& move, ICommandBuffer* commandBuffer) override {
+        auto* resource = static_cast<Resource*>(move.userData);
+        auto buffer = m_device->CreateBuffer(resource->buffer->GetDesc());
+        RHI_RETURN_IF_FAILED(buffer);
+        move.newResource = buffer.GetValue();
+        BufferCopyRegion region = {0, 0, resource->buffer->GetDesc().size};
+        Result<void> result = commandBuffer->CopyBuffer(resource->buffer.get(), buffer.GetValue(), 1, &region);
+        if (!result.IsSuccess()) {
+            delete buffer.GetValue();
+        }
+        return result;
+    }
+
+    void CompleteMove(const DefragmentationMove& move) override {
+        auto* resource = static_cast<Resource*>(move.userData);
+        // 没有图形工作在途，旧缓冲区可以直接销毁
+        resource->buffer.reset(static_cast<IBuffer*>(move.newResource));
+        m_ok &= WriteDescriptors(*resource).IsSuccess();
+    }
+
+    void CancelMove(const DefragmentationMove& move) override {
+        delete static_cast<IBuffer*>(move.newResource);
+    }
+
+    Result<void> WriteDescriptors(const Resource& resource) {
+        const BufferDesc& desc = resource.buffer->GetDesc();
+        auto view = resource.buffer->GetShaderResourceView(BufferViewDesc{0, desc.size, sizeof(uint32_t)});
+        RHI_RETURN_IF_FAILED(view);
+        DescriptorWrite writes[2] = {};
+        writes[0].dstBinding = 0;
+        writes[0].type = DescriptorType::StorageBuffer;
+        writes[0].bufferInfo = view.GetValue();
+        writes[1].dstBinding = 1;
+        writes[1].type = DescriptorType::StorageBuffer;
+        writes[1].bufferInfo = m_outputView;
+        return resource.descriptorSet->UpdateDescriptor({writes[0], writes[1]});
+    }
+
+    bool IsOk() const { return m_ok; }
+
+private:
+    IDevice* m_device;
+    void* m_outputView;
+    bool m_ok = true;
+};
+
+struct Random {
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+
+    uint64_t Next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // 4KB~256KB，按对数均匀分布，4字节对齐
+    size_t NextSize() {
+        uint32_t shift = 12 + static_cast<uint32_t>(Next() % 6);
+        size_t base = size_t(1) << shift;
+        return (base + Next() % base) & ~size_t(3);
+    }
+};
+
+} // namespace
+
+int main() {
+    CPUAdapter adapter(1);
+    std::unique_ptr<CPUDevice> device(static_cast<CPUDevice*>(adapter.CreateDevice(DeviceDesc()).GetValue()));
+    bool ok = true;
+
+    // 校验内核：对绑定的缓冲区求和，写到输出缓冲区的id处
+    device->RegisterComputeKernel("ChecksumCS", [](const CPUComputeInput& input) {
+        const uint32_t* push = static_cast<const uint32_t*>(input.resources->GetPushConstants());
+        const uint32_t* data = reinterpret_cast<const uint32_t*>(input.resources->GetBufferData(0, 0));
+        uint32_t* output = reinterpret_cast<uint32_t*>(input.resources->GetBufferData(0, 1));
+        uint32_t sum = 0;
+        for (uint32_t i = 0; i < push[1]; ++i) {
+            sum += data[i];
+        }
+        output[push[0]] = sum;
+    });
+    ShaderDesc shaderDesc;
+    shaderDesc.type = ShaderType::Compute;
+    shaderDesc.entryPoint = "ChecksumCS";
+    std::unique_ptr<IShader> shader(device->CreateShader(shaderDesc).GetValue());
+    ComputePipelineStateDesc pipelineDesc;
+    pipelineDesc.computeShader = shader.get();
+    std::unique_ptr<IPipelineState> pipeline(device->CreatePipelineState(pipelineDesc).GetValue());
+
+    BufferDesc outputDesc;
+    outputDesc.type = BufferType::Storage;
+    outputDesc.usage = BufferUsage::UnorderedAccess;
+    outputDesc.size = kObjects * sizeof(uint32_t);
+    std::unique_ptr<IBuffer> output(device->CreateBuffer(outputDesc).GetValue());
+    void* outputView = output->GetUnorderedAccessView(BufferViewDesc{0, outputDesc.size, sizeof(uint32_t)}).GetValue();
+
+    std::unique_ptr<IDescriptorSetLayout> layout(
+        device->CreateDescriptorSetLayout(DescriptorSetLayoutDesc{}).GetValue());
+    DescriptorPoolDesc poolDesc = {};
+    poolDesc.maxSets = kObjects;
+    std::unique_ptr<IDescriptorPool> descriptorPool(device->CreateDescriptorPool(poolDesc).GetValue());
+
+    MemoryAllocatorDesc allocatorDesc;
+    allocatorDesc.blockSize = 16ull * 1024 * 1024;
+    MemoryAllocator allocator(device.get(), allocatorDesc);
+    ResourceMover mover(device.get(), outputView);
+    MemoryDefragmenterDesc defragDesc;
+    defragDesc.bytesPerFrame = kBudget;
+    MemoryDefragmenter defragmenter(device.get(), allocator, &mover, defragDesc);
+    ok &= defragmenter.Initialize().IsSuccess();
+
+    // 分配并填充，然后随机释放60%
+    std::vector<Resource> resources(kObjects);
+    std::vector<uint32_t> expected(kObjects, 0);
+    Random random;
+    std::vector<uint32_t> words;
+    for (uint32_t i = 0; i < kObjects; ++i) {
+        Resource& resource = resources[i];
+        resource.id = i;
+        resource.live = true;
+        size_t size = random.NextSize();
+        auto allocation = allocator.Allocate(MemoryAllocationInfo{size, 256, MemoryType::Default,
+            MemoryPropertyFlag::DeviceLocal, false});
+        ok &= allocation.IsSuccess();
+        resource.allocation = allocation.GetValue();
+        BufferDesc desc;
+        desc.type = BufferType::Storage;
+        desc.usage = BufferUsage::ShaderResource | BufferUsage::TransferSrc | BufferUsage::TransferDst;
+        desc.size = size;
+        resource.buffer.reset(device->CreateBuffer(desc).GetValue());
+        words.resize(size / sizeof(uint32_t));
+        for (uint32_t w = 0; w < words.size(); ++w) {
+            words[w] = Word(i, w);
+            expected[i] += words[w];
+        }
+        ok &= resource.buffer->UpdateData(words.data(), size, 0).IsSuccess();
+        resource.descriptorSet = descriptorPool->AllocateDescriptorSet(layout.get()).GetValue();
+        ok &= mover.WriteDescriptors(resource).IsSuccess();
+        ok &= defragmenter.Track(&resource.allocation, &resource).IsSuccess();
+    }
+    for (Resource& resource : resources) {
+        if (random.Next() % 10 < 6) {
+            ok &= defragmenter.Untrack(&resource.allocation).IsSuccess();
+            ok &= allocator.Free(resource.allocation).IsSuccess();
+            resource.buffer.reset();
+            resource.live = false;
+        }
+    }
+
+    MemoryStats before = allocator.GetStats(MemoryType::Default).GetValue();
+    uint32_t blocksBefore = allocator.GetAllocatorStats().blockCount;
+
+    // 逐帧整理直到空闲
+    uint64_t frames = 0;
+    uint64_t maxFrameBytes = 0;
+    uint64_t movedBefore = 0;
+    auto begin = std::chrono::steady_clock::now();
+    do {
+        ok &= defragmenter.Update().IsSuccess();
+        ++frames;
+        // 本帧完成的移动字节数（每帧最多完成一批）
+        uint64_t moved = defragmenter.GetStats().bytesMoved;
+        uint64_t frameBytes = moved - movedBefore;
+        movedBefore = moved;
+        maxFrameBytes = std::max(maxFrameBytes, frameBytes);
+        // 第一批移动途中释放一部分资源（CPU后端的提交同步执行，原分配可以立即释放）
+        if (frames == 1) {
+            for (Resource& resource : resources) {
+                if (resource.live && random.Next() % 20 == 0) {
+                    ok &= defragmenter.Untrack(&resource.allocation).IsSuccess();
+                    ok &= allocator.Free(resource.allocation).IsSuccess();
+                    resource.buffer.reset();
+                    resource.live = false;
+                }
+            }
+        }
+    } while (ok && !defragmenter.IsIdle() && frames < 100000);
+    auto end = std::chrono::steady_clock::now();
+    double frameUs = std::chrono::duration<double, std::micro>(end - begin).count() / static_cast<double>(frames);
+
+    MemoryStats after = allocator.GetStats(MemoryType::Default).GetValue();
+    uint32_t blocksAfter = allocator.GetAllocatorStats().blockCount;
+    const DefragmentationStats& stats = defragmenter.GetStats();
+    std::printf("Defragmentation: %llu frames (%.1f us/frame), %llu passes, %llu allocations / %.1f MB moved, "
+                "%llu canceled, max %.2f MB per frame (budget %.1f MB)\n",
+                static_cast<unsigned long long>(frames), frameUs,
+                static_cast<unsigned long long>(stats.passes),
+                static_cast<unsigned long long>(stats.allocationsMoved), stats.bytesMoved / 1048576.0,
+                static_cast<unsigned long long>(stats.canceledMoves),
+                maxFrameBytes / 1048576.0, kBudget / 1048576.0);
+    std::printf("Fragmentation %.2f -> %.2f (reported %.2f -> %.2f), %u -> %u blocks, "
+                "%.1f of %.1f MB used -> %.1f of %.1f MB\n",
+                before.fragmentation, after.fragmentation, stats.fragmentationBefore, stats.fragmentationAfter,
+                blocksBefore, blocksAfter, before.usedSize / 1048576.0, before.totalSize / 1048576.0,
+                after.usedSize / 1048576.0, after.totalSize / 1048576.0);
+
+    // 存活分配不能重叠
+    std::vector<const MemoryAllocation*> sorted;
+    for (const Resource& resource : resources) {
+        if (resource.live) {
+            sorted.push_back(&resource.allocation);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const MemoryAllocation* a, const MemoryAllocation* b) {
+        return a->memory != b->memory ? a->memory < b->memory : a->offset < b->offset;
+    });
+    bool overlap = false;
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        overlap |= sorted[i]->memory == sorted[i - 1]->memory &&
+            sorted[i]->offset < sorted[i - 1]->offset + sorted[i - 1]->size;
+    }
+
+    // 经描述符集读取每个存活的缓冲区
+    std::unique_ptr<ICommandPool> commandPool(device->CreateCommandPool(QueueType::Compute).GetValue());
+    ICommandBuffer* commandBuffer = commandPool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+    ok &= commandBuffer->Begin().IsSuccess();
+    ok &= commandBuffer->SetPipelineState(pipeline.get()).IsSuccess();
+    for (const Resource& resource : resources) {
+        if (!resource.live) {
+            continue;
+        }
+        uint32_t push[2] = {resource.id, static_cast<uint32_t>(resource.buffer->GetDesc().size / sizeof(uint32_t))};
+        ok &= commandBuffer->PushConstants(nullptr, 0, sizeof(push), push).IsSuccess();
+        ok &= commandBuffer->SetDescriptorSet(0, resource.descriptorSet).IsSuccess();
+        ok &= commandBuffer->Dispatch(1, 1, 1).IsSuccess();
+    }
+    ok &= commandBuffer->End().IsSuccess();
+    IQueue* queue = device->GetQueue(QueueType::Compute, 0).GetValue();
+    ok &= queue->Submit({commandBuffer}, {}, {}, nullptr).IsSuccess();
+    const uint32_t* sums = static_cast<const uint32_t*>(output->Map().GetValue());
+    bool contentOk = true;
+    for (const Resource& resource : resources) {
+        contentOk &= !resource.live || sums[resource.id] == expected[resource.id];
+    }
+    ok &= output->Unmap().IsSuccess();
+
+    if (!ok || !mover.IsOk()) {
+        std::printf("defragmentation failed\n");
+        return 1;
+    }
+    if (maxFrameBytes > kBudget || after.fragmentation >= before.fragmentation || overlap) {
+        std::printf("defragmentation exceeded the budget, did not reduce fragmentation or overlapped allocations\n");
+        return 1;
+    }
+    if (!contentOk) {
+        std::printf("moved buffers do not match their original contents\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+// 帧命令分配器的复用效果
+// 每帧在图形与计算队列上为4个录制线程各取2个命令缓冲区并提交，共3帧在途。
+// 对比每帧新建命令池并分配命令缓冲区的做法，打印每帧耗时；
+// 热身后若仍有命令池创建或命令缓冲区分配，返回非零退出码。
+#include "NullBackend.h"
+#include "FrameCommandAllocator.h"
+#include "BenchUtil.h"
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kThreads = 4;
+constexpr uint32_t kBuffersPerThread = 2;
+constexpr QueueType kQueueTypes[] = {QueueType::Graphics, QueueType::Compute};
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kWarmupFrames = 10;
+    constexpr uint64_t kFrames = 2000;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    std::unique_ptr<IFence> fences[2] = {
+        std::unique_ptr<IFence>(device->CreateFence(FenceDesc()).GetValue()),
+        std::unique_ptr<IFence>(device->CreateFence(FenceDesc()).GetValue()),
+    };
+    IQueue* queues[2] = {
+        device->GetQueue(QueueType::Graphics, 0).GetValue(),
+        device->GetQueue(QueueType::Compute, 0).GetValue(),
+    };
+
+    FrameCommandAllocatorDesc desc;
+    desc.framesInFlight = 3;
+    desc.threadCount = kThreads;
+    FrameCommandAllocator allocator(device.get(), desc);
+    bool ok = allocator.Initialize().IsSuccess();
+
+    std::vector<ICommandBuffer*> commandBuffers;
+    commandBuffers.reserve(kThreads * kBuffersPerThread);
+    auto recordFrame = [&]() {
+        ok &= allocator.BeginFrame().IsSuccess();
+        for (uint32_t q = 0; q < 2; ++q) {
+            commandBuffers.clear();
+            for (uint32_t thread = 0; thread < kThreads; ++thread) {
+                for (uint32_t i = 0; i < kBuffersPerThread; ++i) {
+                    auto commandBuffer = allocator.Allocate(kQueueTypes[q], thread);
+                    ok &= commandBuffer.IsSuccess();
+                    ok &= commandBuffer.GetValue()->Begin().IsSuccess();
+                    ok &= commandBuffer.GetValue()->Dispatch(1, 1, 1).IsSuccess();
+                    ok &= commandBuffer.GetValue()->End().IsSuccess();
+                    commandBuffers.push_back(commandBuffer.GetValue());
+                }
+            }
+            ok &= allocator.Submit(kQueueTypes[q], queues[q], commandBuffers, {}, {}, fences[q].get()).IsSuccess();
+        }
+    };
+
+    for (uint64_t i = 0; i < kWarmupFrames; ++i) {
+        recordFrame();
+    }
+    FrameCommandAllocatorStats warm = allocator.GetStats();
+    Bench::Run("Frame (FrameCommandAllocator)", kFrames, [&](uint64_t) { recordFrame(); });
+    FrameCommandAllocatorStats stats = allocator.GetStats();
+
+    // 对照：每帧新建命令池并分配命令缓冲区
+    Bench::Run("Frame (new pools every frame)", kFrames, [&](uint64_t) {
+        for (uint32_t q = 0; q < 2; ++q) {
+            std::vector<std::unique_ptr<ICommandPool>> pools;
+            commandBuffers.clear();
+            for (uint32_t thread = 0; thread < kThreads; ++thread) {
+                pools.emplace_back(device->CreateCommandPool(kQueueTypes[q], true).GetValue());
+                CommandBufferAllocateInfo allocInfo;
+                allocInfo.count = kBuffersPerThread;
+                auto allocated = pools.back()->AllocateCommandBuffers(allocInfo);
+                for (ICommandBuffer* commandBuffer : allocated.GetValue()) {
+                    ok &= commandBuffer->Begin().IsSuccess();
+                    ok &= commandBuffer->Dispatch(1, 1, 1).IsSuccess();
+                    ok &= commandBuffer->End().IsSuccess();
+                    commandBuffers.push_back(commandBuffer);
+                }
+            }
+            ok &= queues[q]->Submit(commandBuffers, {}, {}, fences[q].get()).IsSuccess();
+        }
+    });
+
+    std::printf("after warm-up: %llu pools, %llu command buffers allocated\n",
+                static_cast<unsigned long long>(warm.commandPoolCreations),
+                static_cast<unsigned long long>(warm.commandBufferAllocations));
+    std::printf("steady state (%llu frames): %llu pools created, %llu command buffers allocated, "
+                "%llu reused, %llu pool resets, %llu fence stalls\n",
+                static_cast<unsigned long long>(allocator.GetFrameCount() - kWarmupFrames),
+                static_cast<unsigned long long>(stats.commandPoolCreations - warm.commandPoolCreations),
+                static_cast<unsigned long long>(stats.commandBufferAllocations - warm.commandBufferAllocations),
+                static_cast<unsigned long long>(stats.commandBufferReuses - warm.commandBufferReuses),
+                static_cast<unsigned long long>(stats.poolResets - warm.poolResets),
+                static_cast<unsigned long long>(stats.fenceStalls - warm.fenceStalls));
+
+    if (!ok) {
+        std::printf("frame recording failed\n");
+        return 1;
+    }
+    if (stats.commandPoolCreations != warm.commandPoolCreations ||
+        stats.commandBufferAllocations != warm.commandBufferAllocations) {
+        std::printf("steady state created new command pools or command buffers\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,231 @@
+// GPU完成队列的大量并发等待
+// 每轮256个未完成的等待（例如流式上传），各自等待时间线上的一个值；模拟GPU的线程依次主机端Signal这些值。
+// 1. 每个等待占用一个线程，阻塞在ISemaphore::Wait
+// 2. GpuCompletionQueue：一个完成线程，回调投递到主线程的任务队列（执行器）上执行
+// 打印每轮耗时、使用的线程数与Signal到回调的平均延迟；以C++20编译时另外用co_await跑一轮
+// （CMake另外生成C++20的GpuCompletionBenchmarkCxx20，其中co_await路径必须可用）。
+// 关闭队列时未完成的等待须以InvalidOperation回调。任一回调丢失或失败时返回非零退出码。
+#include "NullBackend.h"
+#include "GpuCompletionQueue.h"
+#include "BenchUtil.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(RHI_BENCH_REQUIRE_COROUTINES) && !RHI_HAS_COROUTINES
+#error "以C++20编译时GpuCompletionQueue.h应提供co_await接口（RHI_HAS_COROUTINES）"
+#endif
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kOutstanding = 256;
+constexpr uint32_t kRounds = 20;
+
+int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 主线程的任务队列，作为完成队列的执行器
+class MainThreadExecutor {
+public:
+    void Post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+        m_changed.notify_one();
+    }
+
+    // 执行任务直到done返回true
+    template<typename Pred>
+    void RunUntil(Pred done) {
+        std::vector<std::function<void()>> tasks;
+        while (!done()) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_changed.wait(lock, [this]() { return !m_tasks.empty(); });
+                tasks.swap(m_tasks);
+            }
+            for (auto& task : tasks) {
+                task();
+            }
+            tasks.clear();
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::vector<std::function<void()>> m_tasks;
+};
+
+// 依次发出base+1..base+kOutstanding，记录每个值的发出时间
+std::thread StartGpu(ISemaphore* timeline, uint64_t base, std::vector<int64_t>& signalTimes, std::atomic<bool>& ok) {
+    return std::thread([timeline, base, &signalTimes, &ok]() {
+        for (uint32_t i = 0; i < kOutstanding; ++i) {
+            signalTimes[i] = NowNs();
+            ok = ok && timeline->Signal(base + i + 1).IsSuccess();
+            std::this_thread::yield();
+        }
+    });
+}
+
+#if RHI_HAS_COROUTINES
+// 立即开始、结束时自行销毁的协程
+struct FireAndForget {
+    struct promise_type {
+        FireAndForget get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+FireAndForget AwaitUpload(GpuCompletionQueue& completion, ISemaphore* timeline, uint64_t value,
+                          int64_t& completedAt, std::atomic<uint32_t>& done, std::atomic<bool>& ok) {
+    Result<void> result = co_await completion.WhenReached(timeline, value);
+    ok = ok && result.IsSuccess();
+    completedAt = NowNs();
+    done.fetch_add(1);
+}
+#endif
+
+struct RoundResult {
+    double roundNs = 0.0;
+    double latencyNs = 0.0;
+};
+
+void Accumulate(RoundResult& total, int64_t begin, const std::vector<int64_t>& signalTimes,
+                const std::vector<int64_t>& completeTimes) {
+    total.roundNs += static_cast<double>(NowNs() - begin);
+    for (uint32_t i = 0; i < kOutstanding; ++i) {
+        total.latencyNs += static_cast<double>(completeTimes[i] - signalTimes[i]);
+    }
+}
+
+void Print(const char* name, const RoundResult& total, uint32_t threads) {
+    std::printf("%-44s %9.1f us/round, %4u thread(s), %8.1f us signal->callback\n", name,
+                total.roundNs / kRounds / 1000.0, threads,
+                total.latencyNs / (static_cast<double>(kRounds) * kOutstanding) / 1000.0);
+}
+
+} // namespace
+
+int main() {
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    SemaphoreDesc semaphoreDesc;
+    semaphoreDesc.binary = false;
+    std::unique_ptr<ISemaphore> timeline(device->CreateSemaphore(semaphoreDesc).GetValue());
+
+    std::atomic<bool> ok{true};
+    std::vector<int64_t> signalTimes(kOutstanding);
+    std::vector<int64_t> completeTimes(kOutstanding);
+    uint64_t base = 0;
+
+    // 1. 每个等待一个线程
+    RoundResult threadPerWait;
+    for (uint32_t round = 0; round < kRounds; ++round) {
+        int64_t begin = NowNs();
+        std::vector<std::thread> waiters;
+        waiters.reserve(kOutstanding);
+        for (uint32_t i = 0; i < kOutstanding; ++i) {
+            waiters.emplace_back([&, i]() {
+                ok = ok && timeline->Wait(base + i + 1, UINT64_MAX).IsSuccess();
+                completeTimes[i] = NowNs();
+            });
+        }
+        std::thread gpu = StartGpu(timeline.get(), base, signalTimes, ok);
+        for (std::thread& waiter : waiters) {
+            waiter.join();
+        }
+        gpu.join();
+        Accumulate(threadPerWait, begin, signalTimes, completeTimes);
+        base += kOutstanding;
+    }
+    Print("Thread per wait (ISemaphore::Wait)", threadPerWait, kOutstanding);
+
+    // 2. 完成队列，回调在主线程上执行
+    MainThreadExecutor executor;
+    GpuCompletionQueue completion(device.get(),
+        [&executor](std::function<void()> task) { executor.Post(std::move(task)); });
+    ok = ok && completion.Initialize().IsSuccess();
+    RoundResult completionQueue;
+    uint64_t callbacks = 0;
+    for (uint32_t round = 0; round < kRounds; ++round) {
+        int64_t begin = NowNs();
+        uint32_t done = 0;
+        for (uint32_t i = 0; i < kOutstanding; ++i) {
+            completion.WhenReached(timeline.get(), base + i + 1, [&, i](Result<void> result) {
+                ok = ok && result.IsSuccess();
+                completeTimes[i] = NowNs();
+                ++done;
+            });
+        }
+        std::thread gpu = StartGpu(timeline.get(), base, signalTimes, ok);
+        executor.RunUntil([&]() { return done == kOutstanding; });
+        gpu.join();
+        Accumulate(completionQueue, begin, signalTimes, completeTimes);
+        callbacks += done;
+        base += kOutstanding;
+    }
+    Print("GpuCompletionQueue (main thread executor)", completionQueue, 1);
+
+#if RHI_HAS_COROUTINES
+    // 3. co_await，协程在主线程上恢复
+    RoundResult coroutines;
+    for (uint32_t round = 0; round < kRounds; ++round) {
+        int64_t begin = NowNs();
+        std::atomic<uint32_t> done{0};
+        for (uint32_t i = 0; i < kOutstanding; ++i) {
+            AwaitUpload(completion, timeline.get(), base + i + 1, completeTimes[i], done, ok);
+        }
+        std::thread gpu = StartGpu(timeline.get(), base, signalTimes, ok);
+        executor.RunUntil([&]() { return done.load() == kOutstanding; });
+        gpu.join();
+        Accumulate(coroutines, begin, signalTimes, completeTimes);
+        callbacks += done.load();
+        base += kOutstanding;
+    }
+    Print("co_await GpuCompletionQueue::WhenReached", coroutines, 1);
+#endif
+
+    GpuCompletionStats stats = completion.GetStats();
+    std::printf("completion thread: %llu watches, %llu already reached, %llu completed in %llu wakeups\n",
+                static_cast<unsigned long long>(stats.watches), static_cast<unsigned long long>(stats.immediate),
+                static_cast<unsigned long long>(stats.completions), static_cast<unsigned long long>(stats.wakeups));
+
+    // 关闭时未完成的等待以InvalidOperation回调（没有执行器时在调用线程上执行）
+    GpuCompletionQueue abandoned(device.get());
+    ok = ok && abandoned.Initialize().IsSuccess();
+    ErrorCode abandonedCode = ErrorCode::Success;
+    abandoned.WhenReached(timeline.get(), UINT64_MAX, [&](Result<void> result) {
+        abandonedCode = result.GetErrorCode();
+    });
+    abandoned.Shutdown();
+
+    if (!ok) {
+        std::printf("a wait or signal failed\n");
+        return 1;
+    }
+    if (stats.watches != callbacks || stats.immediate + stats.completions != callbacks ||
+        completion.GetPendingCount() != 0) {
+        std::printf("callbacks were lost\n");
+        return 1;
+    }
+    if (abandonedCode != ErrorCode::InvalidOperation) {
+        std::printf("pending wait was not cancelled on shutdown\n");
+        return 1;
+    }
+    return 0;
+}
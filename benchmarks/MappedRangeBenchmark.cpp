@@ -0,0 +1,161 @@
+// 持久映射与批量刷新
+// 每帧向256个64KB流式顶点缓冲区各顺序写入4段1KB顶点数据（每帧1024次写入）。
+// 1. Map/写入/Unmap：每次写入一对映射调用
+// 2. 持久映射：写入GetMappedData返回的固定地址，MappedRangeBatch收集写入的范围
+// 3. 刷新次数：非HostCoherent内存上逐次刷新与每次提交一个批次的对比；HostCoherent内存上批次不调用设备
+// 打印每帧耗时与设备收到的刷新调用数、范围数。持久映射的地址变化、写入的数据读不回来、
+// 批次的调用数或合并结果不符合预期时返回非零退出码。
+#include "NullBackend.h"
+#include "MappedRangeBatch.h"
+#include "BenchUtil.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kBuffers = 256;
+constexpr size_t kBufferSize = 64 * 1024;
+constexpr uint32_t kWritesPerBuffer = 4;
+constexpr size_t kWriteSize = 1024;
+constexpr uint32_t kFrames = 2000;
+
+BufferDesc MakeStreamingDesc() {
+    BufferDesc desc;
+    desc.type = BufferType::Vertex;
+    desc.usage = BufferUsage::VertexBuffer;
+    desc.memoryType = MemoryType::Upload;
+    desc.size = kBufferSize;
+    return desc;
+}
+
+// 第frame帧第write次写入在缓冲区中的偏移（每帧顺序写入，帧间轮转）
+size_t GetWriteOffset(uint32_t frame, uint32_t write) {
+    return ((frame % (kBufferSize / (kWriteSize * kWritesPerBuffer))) * kWritesPerBuffer + write) * kWriteSize;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    NullDevice* nullDevice = static_cast<NullDevice*>(device.get());
+
+    std::vector<uint8_t> vertices(kWriteSize);
+    for (size_t i = 0; i < kWriteSize; ++i) {
+        vertices[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    // 一致内存：独立创建的Upload缓冲区
+    std::vector<std::unique_ptr<IBuffer>> coherent;
+    for (uint32_t i = 0; i < kBuffers; ++i) {
+        coherent.emplace_back(device->CreateBuffer(MakeStreamingDesc()).GetValue());
+    }
+
+    // 非一致内存：放置在只声明HostVisible的内存块中
+    MemoryDesc memoryDesc;
+    memoryDesc.type = MemoryType::Upload;
+    memoryDesc.properties = MemoryPropertyFlag::HostVisible;
+    memoryDesc.size = kBuffers * kBufferSize;
+    std::unique_ptr<IMemory> memory(device->AllocateMemory(memoryDesc).GetValue());
+    std::vector<std::unique_ptr<IBuffer>> nonCoherent;
+    for (uint32_t i = 0; i < kBuffers; ++i) {
+        nonCoherent.emplace_back(device->CreatePlacedBuffer(MakeStreamingDesc(), memory.get(), i * kBufferSize).GetValue());
+    }
+    ok &= coherent[0]->IsHostCoherent() && !nonCoherent[0]->IsHostCoherent();
+
+    // 1. Map/写入/Unmap
+    uint32_t frame = 0;
+    double mapNs = Bench::Run("Map/memcpy/Unmap (1024 writes)", kFrames, [&](uint64_t) {
+        for (uint32_t write = 0; write < kWritesPerBuffer; ++write) {
+            for (const auto& buffer : coherent) {
+                auto mapped = buffer->Map();
+                std::memcpy(static_cast<uint8_t*>(mapped.GetValue()) + GetWriteOffset(frame, write),
+                            vertices.data(), kWriteSize);
+                ok &= buffer->Unmap().IsSuccess();
+            }
+        }
+        ++frame;
+    });
+
+    // 2. 持久映射：地址只取一次
+    std::vector<uint8_t*> mapped;
+    for (const auto& buffer : coherent) {
+        mapped.push_back(static_cast<uint8_t*>(buffer->GetMappedData()));
+    }
+    MappedRangeBatch coherentBatch(device.get());
+    uint64_t coherentCalls = nullDevice->GetFlushCallCount();
+    frame = 0;
+    double persistentNs = Bench::Run("Persistent pointer + MappedRangeBatch", kFrames, [&](uint64_t) {
+        for (uint32_t write = 0; write < kWritesPerBuffer; ++write) {
+            for (uint32_t i = 0; i < kBuffers; ++i) {
+                size_t offset = GetWriteOffset(frame, write);
+                std::memcpy(mapped[i] + offset, vertices.data(), kWriteSize);
+                coherentBatch.Add(coherent[i].get(), offset, kWriteSize);
+            }
+        }
+        ok &= coherentBatch.Flush().IsSuccess();
+        ++frame;
+    });
+    std::printf("Persistent mapping: %.2f us/frame vs %.2f us/frame with Map/Unmap\n",
+                persistentNs / 1000.0, mapNs / 1000.0);
+    for (uint32_t i = 0; i < kBuffers; ++i) {
+        ok &= coherent[i]->GetMappedData() == mapped[i];
+        ok &= std::memcmp(mapped[i] + GetWriteOffset(frame - 1, 0), vertices.data(), kWriteSize) == 0;
+    }
+    // 一致内存上的范围全部跳过，设备没有收到刷新
+    ok &= nullDevice->GetFlushCallCount() == coherentCalls;
+    ok &= coherentBatch.GetStats().flushes == 0 &&
+        coherentBatch.GetStats().skippedCoherent == coherentBatch.GetStats().added;
+    std::printf("HostCoherent: %llu ranges skipped, %llu device flush calls\n",
+                static_cast<unsigned long long>(coherentBatch.GetStats().skippedCoherent),
+                static_cast<unsigned long long>(nullDevice->GetFlushCallCount() - coherentCalls));
+
+    // 3. 非一致内存：逐次刷新与批量刷新
+    uint64_t callsBefore = nullDevice->GetFlushCallCount();
+    uint64_t rangesBefore = nullDevice->GetFlushedRangeCount();
+    constexpr uint32_t kFlushFrames = 100;
+    for (frame = 0; frame < kFlushFrames; ++frame) {
+        for (uint32_t write = 0; write < kWritesPerBuffer; ++write) {
+            for (const auto& buffer : nonCoherent) {
+                size_t offset = GetWriteOffset(frame, write);
+                std::memcpy(static_cast<uint8_t*>(buffer->GetMappedData()) + offset, vertices.data(), kWriteSize);
+                MappedRange range = {buffer.get(), offset, kWriteSize};
+                ok &= device->FlushMappedRanges(Span<const MappedRange>(&range, 1)).IsSuccess();
+            }
+        }
+    }
+    uint64_t perWriteCalls = nullDevice->GetFlushCallCount() - callsBefore;
+    uint64_t perWriteRanges = nullDevice->GetFlushedRangeCount() - rangesBefore;
+
+    MappedRangeBatch batch(device.get());
+    callsBefore = nullDevice->GetFlushCallCount();
+    rangesBefore = nullDevice->GetFlushedRangeCount();
+    for (frame = 0; frame < kFlushFrames; ++frame) {
+        for (uint32_t write = 0; write < kWritesPerBuffer; ++write) {
+            for (const auto& buffer : nonCoherent) {
+                size_t offset = GetWriteOffset(frame, write);
+                std::memcpy(static_cast<uint8_t*>(buffer->GetMappedData()) + offset, vertices.data(), kWriteSize);
+                batch.Add(buffer.get(), offset, kWriteSize);
+            }
+        }
+        ok &= batch.Flush().IsSuccess();
+    }
+    uint64_t batchedCalls = nullDevice->GetFlushCallCount() - callsBefore;
+    uint64_t batchedRanges = nullDevice->GetFlushedRangeCount() - rangesBefore;
+    // 每帧一次调用，每个缓冲区的4段顺序写入合并为一个范围
+    ok &= batchedCalls == kFlushFrames && batchedRanges == static_cast<uint64_t>(kFlushFrames) * kBuffers;
+    ok &= perWriteCalls == static_cast<uint64_t>(kFlushFrames) * kBuffers * kWritesPerBuffer;
+    std::printf("Non-coherent per frame: per-write flush %llu calls / %llu ranges, batched %llu call / %llu ranges\n",
+                static_cast<unsigned long long>(perWriteCalls / kFlushFrames),
+                static_cast<unsigned long long>(perWriteRanges / kFlushFrames),
+                static_cast<unsigned long long>(batchedCalls / kFlushFrames),
+                static_cast<unsigned long long>(batchedRanges / kFlushFrames));
+
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+// GPU内存子分配的压力测试
+// 4096个槽位上随机交替分配与释放：大小在256B~1MB之间按对数均匀分布，对齐随机取16B/256B/4KB/64KB。
+// 1. TlsfAllocator在1GB偏移空间上的分配+释放
+// 2. MemoryAllocator（空后端，64MB内存块），偶尔夹杂专用分配
+// 3. 对照：每个资源单独调用IDevice::AllocateMemory
+// 打印每次操作的耗时、设备内存对象数与碎片化程度。分配的偏移未对齐、存活分配重叠、
+// 相邻空闲块未合并或统计与实际不符时返回非零退出码。
+#include "NullBackend.h"
+#include "MemoryAllocator.h"
+#include "TlsfAllocator.h"
+#include "BenchUtil.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kSlots = 4096;
+constexpr uint64_t kAlignments[] = {16, 256, 4096, 65536};
+
+struct Random {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    uint64_t Next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // 256B~1MB，按对数均匀分布
+    uint64_t NextSize() {
+        uint32_t shift = 8 + static_cast<uint32_t>(Next() % 12);
+        uint64_t base = uint64_t(1) << shift;
+        return base + Next() % base;
+    }
+
+    uint64_t NextAlignment() {
+        return kAlignments[Next() % 4];
+    }
+};
+
+// 按偏移顺序检查块链：连续、无重叠、无相邻空闲块，已用大小与统计一致
+bool ValidateTlsf(const TlsfAllocator& allocator) {
+    uint64_t expectedOffset = 0;
+    uint64_t used = 0;
+    uint32_t freeBlocks = 0;
+    bool previousFree = false;
+    bool ok = true;
+    allocator.ForEachBlock([&](const TlsfAllocator::Block& block) {
+        ok &= block.offset == expectedOffset;
+        ok &= !(previousFree && block.free);
+        expectedOffset = block.offset + block.size;
+        previousFree = block.free;
+        if (block.free) {
+            ++freeBlocks;
+        } else {
+            used += block.size;
+        }
+    });
+    return ok && expectedOffset == allocator.GetSize() && used == allocator.GetUsedSize() &&
+        freeBlocks == allocator.GetFreeBlockCount();
+}
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kTlsfOps = 4000000;
+    constexpr uint64_t kAllocatorOps = 2000000;
+    constexpr uint64_t kDeviceOps = 200000;
+    bool ok = true;
+
+    // 1. TLSF
+    TlsfAllocator tlsf(1024ull * 1024 * 1024);
+    std::vector<TlsfAllocator::Block*> blocks(kSlots, nullptr);
+    Random random;
+    uint64_t tlsfFailures = 0;
+    Bench::Run("TlsfAllocator allocate/free (mixed sizes)", kTlsfOps, [&](uint64_t) {
+        uint32_t slot = static_cast<uint32_t>(random.Next() % kSlots);
+        if (blocks[slot] != nullptr) {
+            tlsf.Free(blocks[slot]);
+            blocks[slot] = nullptr;
+            return;
+        }
+        uint64_t alignment = random.NextAlignment();
+        blocks[slot] = tlsf.Allocate(random.NextSize(), alignment);
+        if (blocks[slot] == nullptr) {
+            ++tlsfFailures;
+        } else {
+            ok &= blocks[slot]->offset % alignment == 0;
+        }
+    });
+    bool tlsfValid = ValidateTlsf(tlsf);
+    MemoryStats tlsfStats = tlsf.GetStats();
+    std::printf("TLSF: %u live allocations, %.1f of %.1f MB used, largest free %.1f MB in %zu free blocks, "
+                "fragmentation %.2f, %llu failed\n",
+                tlsf.GetAllocationCount(), tlsfStats.usedSize / 1048576.0, tlsfStats.totalSize / 1048576.0,
+                tlsfStats.largestFreeBlock / 1048576.0, tlsfStats.freeCount, tlsfStats.fragmentation,
+                static_cast<unsigned long long>(tlsfFailures));
+    for (TlsfAllocator::Block*& block : blocks) {
+        if (block != nullptr) {
+            tlsf.Free(block);
+            block = nullptr;
+        }
+    }
+    tlsfValid &= ValidateTlsf(tlsf) && tlsf.GetFreeBlockCount() == 1 && tlsf.GetUsedSize() == 0;
+
+    // 2. MemoryAllocator
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+
+    MemoryAllocatorDesc allocatorDesc;
+    allocatorDesc.maxMemoryObjects = adapter->GetAdapterInfo().limits.maxMemoryAllocationCount;
+    MemoryAllocator allocator(device.get(), allocatorDesc);
+    std::vector<MemoryAllocation> allocations(kSlots);
+    std::vector<bool> live(kSlots, false);
+    uint32_t peakObjects = 0;
+    uint32_t peakLive = 0;
+    uint32_t liveCount = 0;
+    uint64_t dedicatedRequests = 0;
+    Bench::Run("MemoryAllocator allocate/free (mixed sizes)", kAllocatorOps, [&](uint64_t) {
+        uint32_t slot = static_cast<uint32_t>(random.Next() % kSlots);
+        if (live[slot]) {
+            ok &= allocator.Free(allocations[slot]).IsSuccess();
+            live[slot] = false;
+            --liveCount;
+            return;
+        }
+        MemoryAllocationInfo info = {};
+        info.size = static_cast<size_t>(random.NextSize());
+        info.alignment = static_cast<size_t>(random.NextAlignment());
+        info.type = (slot & 3) == 0 ? MemoryType::Upload : MemoryType::Default;
+        info.dedicated = random.Next() % 1024 == 0;
+        dedicatedRequests += info.dedicated ? 1 : 0;
+        auto allocation = allocator.Allocate(info);
+        ok &= allocation.IsSuccess();
+        if (allocation.IsSuccess()) {
+            allocations[slot] = allocation.GetValue();
+            ok &= allocations[slot].offset % info.alignment == 0;
+            live[slot] = true;
+            ++liveCount;
+            peakLive = std::max(peakLive, liveCount);
+            peakObjects = std::max(peakObjects, allocator.GetMemoryObjectCount());
+        }
+    });
+
+    // 同一内存块中的存活分配不能重叠
+    std::vector<const MemoryAllocation*> sorted;
+    for (uint32_t i = 0; i < kSlots; ++i) {
+        if (live[i]) {
+            sorted.push_back(&allocations[i]);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const MemoryAllocation* a, const MemoryAllocation* b) {
+        return a->memory != b->memory ? a->memory < b->memory : a->offset < b->offset;
+    });
+    bool overlap = false;
+    for (size_t i = 1; i < sorted.size(); ++i) {
+        overlap |= sorted[i]->memory == sorted[i - 1]->memory &&
+            sorted[i]->offset < sorted[i - 1]->offset + sorted[i - 1]->size;
+    }
+
+    MemoryStats defaultStats = allocator.GetStats(MemoryType::Default).GetValue();
+    MemoryAllocatorStats allocatorStats = allocator.GetAllocatorStats();
+    std::printf("MemoryAllocator: peak %u live allocations in %u device memory objects (limit %u), "
+                "%llu blocks created, %llu dedicated requests\n",
+                peakLive, peakObjects, allocatorDesc.maxMemoryObjects,
+                static_cast<unsigned long long>(allocatorStats.blockAllocations),
+                static_cast<unsigned long long>(dedicatedRequests));
+    std::printf("Default heap: %.1f of %.1f MB used, largest free %.1f MB, fragmentation %.2f\n",
+                defaultStats.usedSize / 1048576.0, defaultStats.totalSize / 1048576.0,
+                defaultStats.largestFreeBlock / 1048576.0, defaultStats.fragmentation);
+    for (uint32_t i = 0; i < kSlots; ++i) {
+        if (live[i]) {
+            ok &= allocator.Free(allocations[i]).IsSuccess();
+        }
+    }
+    MemoryStats drained = allocator.GetStats().GetValue();
+    bool drainedOk = drained.usedSize == 0 && allocator.GetAllocatorStats().allocationCount == 0 &&
+        allocator.GetMemoryObjectCount() <= 2;
+
+    // 3. 每个资源一个设备内存对象
+    MemoryDesc memoryDesc;
+    Bench::Run("IDevice::AllocateMemory per resource", kDeviceOps, [&](uint64_t) {
+        memoryDesc.size = static_cast<size_t>(random.NextSize());
+        auto memory = device->AllocateMemory(memoryDesc);
+        ok &= memory.IsSuccess();
+        auto allocation = memory.GetValue()->Allocate(MemoryAllocationInfo{memoryDesc.size, 0,
+            MemoryType::Default, MemoryPropertyFlag::None, true});
+        ok &= allocation.IsSuccess();
+        delete memory.GetValue();
+    });
+
+    if (!ok) {
+        std::printf("allocation failed or returned a misaligned offset\n");
+        return 1;
+    }
+    if (!tlsfValid || overlap || !drainedOk) {
+        std::printf("allocator state is inconsistent\n");
+        return 1;
+    }
+    return 0;
+}
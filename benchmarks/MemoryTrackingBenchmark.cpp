@@ -0,0 +1,155 @@
+// 按标签的内存跟踪
+// 1. 用量：按标签创建阴影贴图、网格缓冲区、上传缓冲区与放置在流式内存块中的缓冲区，
+//    检查各标签与内存类型的字节数、释放后的高水位，放置资源不重复计入用量
+// 2. 快照：导出JSON，内存块带有区段布局与其中的放置资源
+// 3. 泄漏报告：设备销毁时仍存活的缓冲区连同标签与创建位置交给报告回调
+// 4. 开销：CreateBuffer/delete与单独登记/移除一条记录的耗时
+// 任一检查不通过时返回非零退出码。
+#include "NullBackend.h"
+#include "BenchUtil.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kShadowMaps = 4;
+constexpr uint32_t kMeshBuffers = 8;
+constexpr size_t kMeshBufferSize = 4 * 1024 * 1024;
+constexpr size_t kStreamingHeapSize = 16 * 1024 * 1024;
+constexpr size_t kStreamingBufferSize = 1024 * 1024;
+
+BufferDesc MakeBufferDesc(size_t size, MemoryType type, const MemoryTag& tag) {
+    BufferDesc desc;
+    desc.type = type == MemoryType::Upload ? BufferType::Staging : BufferType::Vertex;
+    desc.usage = type == MemoryType::Upload ? BufferUsage::TransferSrc : BufferUsage::VertexBuffer;
+    desc.memoryType = type;
+    desc.size = size;
+    desc.tag = tag;
+    return desc;
+}
+
+bool Contains(const std::string& text, const char* pattern) {
+    return text.find(pattern) != std::string::npos;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    MemoryTracker& tracker = device->GetMemoryTracker();
+
+    // 1. 用量
+    TextureDesc shadowDesc;
+    shadowDesc.format = Format::D32_FLOAT;
+    shadowDesc.width = 2048;
+    shadowDesc.height = 2048;
+    shadowDesc.usage = TextureUsage::DepthStencil | TextureUsage::ShaderResource;
+    shadowDesc.tag = RHI_MEMORY_TAG("Shadow");
+    std::vector<std::unique_ptr<ITexture>> shadowMaps;
+    for (uint32_t i = 0; i < kShadowMaps; ++i) {
+        shadowMaps.emplace_back(device->CreateTexture(shadowDesc).GetValue());
+    }
+    std::vector<std::unique_ptr<IBuffer>> meshes;
+    for (uint32_t i = 0; i < kMeshBuffers; ++i) {
+        meshes.emplace_back(device->CreateBuffer(
+            MakeBufferDesc(kMeshBufferSize, MemoryType::Default, RHI_MEMORY_TAG("Mesh"))).GetValue());
+    }
+    std::unique_ptr<IBuffer> staging(device->CreateBuffer(
+        MakeBufferDesc(kMeshBufferSize, MemoryType::Upload, MemoryTag("Staging"))).GetValue());
+    std::unique_ptr<IBuffer> untagged(device->CreateBuffer(
+        MakeBufferDesc(kStreamingBufferSize, MemoryType::Default, MemoryTag())).GetValue());
+
+    MemoryDesc heapDesc;
+    heapDesc.size = kStreamingHeapSize;
+    heapDesc.tag = RHI_MEMORY_TAG("Streaming");
+    std::unique_ptr<IMemory> heap(device->AllocateMemory(heapDesc).GetValue());
+    MemoryAllocationInfo chunk = {};
+    chunk.size = 3 * kStreamingBufferSize;
+    chunk.alignment = kNullBufferPlacementAlignment;
+    void* suballocation = heap->Allocate(chunk).GetValue();
+    std::vector<std::unique_ptr<IBuffer>> placed;
+    for (uint32_t i = 0; i < 3; ++i) {
+        placed.emplace_back(device->CreatePlacedBuffer(
+            MakeBufferDesc(kStreamingBufferSize, MemoryType::Default, RHI_MEMORY_TAG("Streaming")),
+            heap.get(), i * kStreamingBufferSize).GetValue());
+    }
+
+    uint64_t shadowBytes = EstimateTextureDataSize(shadowDesc) * kShadowMaps;
+    MemoryUsage shadow = tracker.GetTagUsage("Shadow");
+    MemoryUsage mesh = tracker.GetTagUsage("Mesh");
+    MemoryUsage streaming = tracker.GetTagUsage("Streaming");
+    ok &= shadow.bytes == shadowBytes && shadow.count == kShadowMaps;
+    ok &= mesh.bytes == static_cast<uint64_t>(kMeshBufferSize) * kMeshBuffers;
+    // 放置的缓冲区只登记记录，字节数只来自内存块本身
+    ok &= streaming.bytes == kStreamingHeapSize && streaming.count == 1;
+    ok &= tracker.GetTagUsage(nullptr).bytes == kStreamingBufferSize;
+    ok &= tracker.GetTypeUsage(MemoryType::Upload).bytes == kMeshBufferSize;
+    ok &= tracker.GetTotalUsage().bytes ==
+        shadowBytes + static_cast<uint64_t>(kMeshBufferSize) * (kMeshBuffers + 1) + kStreamingBufferSize + kStreamingHeapSize;
+    ok &= tracker.GetLiveAllocations().size() == kShadowMaps + kMeshBuffers + 2 + 1 + 3;
+
+    // 释放阴影贴图：当前字节数归零，高水位保留
+    shadowMaps.clear();
+    shadow = tracker.GetTagUsage("Shadow");
+    ok &= shadow.bytes == 0 && shadow.count == 0 && shadow.peakBytes == shadowBytes && shadow.totalCount == kShadowMaps;
+    for (const auto& usage : tracker.GetTagUsages()) {
+        std::printf("  %-10s %8.2f MB live (%llu), peak %8.2f MB\n", usage.first.c_str(),
+                    usage.second.bytes / 1048576.0, static_cast<unsigned long long>(usage.second.count),
+                    usage.second.peakBytes / 1048576.0);
+    }
+    MemoryUsage total = tracker.GetTotalUsage();
+    std::printf("Total: %.2f MB live, peak %.2f MB; Default %.2f MB, Upload %.2f MB\n",
+                total.bytes / 1048576.0, total.peakBytes / 1048576.0,
+                tracker.GetTypeUsage(MemoryType::Default).bytes / 1048576.0,
+                tracker.GetTypeUsage(MemoryType::Upload).bytes / 1048576.0);
+
+    // 2. 快照
+    std::string json = tracker.ExportJson();
+    ok &= Contains(json, "\"heaps\"") && Contains(json, "\"regions\": [{\"offset\": 0, \"size\": 3145728, \"free\": false}");
+    ok &= Contains(json, "\"placed\": [{") && Contains(json, "\"offset\": 2097152");
+    ok &= Contains(json, "MemoryTrackingBenchmark.cpp:");
+    std::printf("%s", json.c_str());
+    ok &= heap->Free(suballocation).IsSuccess();
+
+    // 3. 泄漏报告：第二个设备销毁时仍有一个缓冲区存活
+    std::string report;
+    IBuffer* leaked = nullptr;
+    {
+        std::unique_ptr<IDevice> leakyDevice(adapter->CreateDevice(DeviceDesc()).GetValue());
+        leakyDevice->GetMemoryTracker().SetReportCallback([&report](const std::string& text) { report = text; });
+        std::unique_ptr<IBuffer> released(leakyDevice->CreateBuffer(
+            MakeBufferDesc(kMeshBufferSize, MemoryType::Default, RHI_MEMORY_TAG("Released"))).GetValue());
+        leaked = leakyDevice->CreateBuffer(
+            MakeBufferDesc(kMeshBufferSize, MemoryType::Default, RHI_MEMORY_TAG("Particles"))).GetValue();
+    }
+    ok &= Contains(report, "1 allocation(s) still live") && Contains(report, "tag=Particles") &&
+        Contains(report, "MemoryTrackingBenchmark.cpp:") && !Contains(report, "Released");
+    std::printf("Live allocation report at device destruction:\n%s", report.c_str());
+    // 跟踪器销毁后释放泄漏的对象不再访问它
+    delete leaked;
+
+    // 4. 开销
+    BufferDesc createDesc = MakeBufferDesc(256, MemoryType::Default, RHI_MEMORY_TAG("Bench"));
+    double createNs = Bench::Run("CreateBuffer + delete (tracked)", 1000000, [&](uint64_t) {
+        auto buffer = device->CreateBuffer(createDesc);
+        ok &= buffer.IsSuccess();
+        delete buffer.GetValue();
+    });
+    MemoryTracker standalone;
+    double trackNs = Bench::Run("MemoryTracker Track + Untrack", 1000000, [&](uint64_t) {
+        MemoryTrackingHandle handle;
+        standalone.Track(handle, MemoryAllocationKind::Buffer, &handle, 256, MemoryType::Default, createDesc.tag);
+    });
+    std::printf("Tracking overhead: %.1f ns per allocation (%.0f%% of CreateBuffer + delete)\n",
+                trackNs, 100.0 * trackNs / createNs);
+    ok &= standalone.GetLiveAllocations().empty() && standalone.GetTagUsage("Bench").totalCount > 0;
+
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
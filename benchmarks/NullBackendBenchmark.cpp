@@ -0,0 +1,83 @@
+// 空后端上的每次调用开销
+// 空后端不执行GPU工作，测得的耗时即抽象层本身的开销（虚调用、Result构造、参数传递）。
+// 可选参数：每次绘制调用允许的最大纳秒数，超出时返回非零退出码，用于CI中捕获开销回归。
+#include "NullBackend.h"
+#include "BenchUtil.h"
+#include <cstdlib>
+#include <memory>
+
+using namespace RHI;
+
+int main(int argc, char** argv) {
+    constexpr uint64_t kDrawsPerFrame = 50000;
+    constexpr uint64_t kFrames = 100;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    IQueue* queue = device->GetQueue(QueueType::Graphics, 0).GetValue();
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics).GetValue());
+    ICommandBuffer* commandBuffer = pool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+
+    BufferDesc bufferDesc;
+    bufferDesc.size = 65536;
+    std::unique_ptr<IBuffer> vertexBuffer(device->CreateBuffer(bufferDesc).GetValue());
+    BufferViewDesc viewDesc = {0, bufferDesc.size, 16};
+    void* vertexBufferView = vertexBuffer->GetVertexBufferView(viewDesc).GetValue();
+
+    std::unique_ptr<IPipelineState> pipeline(device->CreatePipelineState(GraphicsPipelineStateDesc()).GetValue());
+    DescriptorSetLayoutDesc layoutDesc = {};
+    std::unique_ptr<IDescriptorSetLayout> layout(device->CreateDescriptorSetLayout(layoutDesc).GetValue());
+    DescriptorPoolDesc poolDesc = {};
+    poolDesc.maxSets = 1;
+    std::unique_ptr<IDescriptorPool> descriptorPool(device->CreateDescriptorPool(poolDesc).GetValue());
+    IDescriptorSet* descriptorSet = descriptorPool->AllocateDescriptorSet(layout.get()).GetValue();
+
+    Viewport viewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+    Scissor scissor = {0, 0, 1920, 1080};
+
+    bool ok = commandBuffer->Begin().IsSuccess();
+
+    Bench::Run("SetViewport", kDrawsPerFrame * kFrames, [&](uint64_t) {
+        Bench::DoNotOptimize(commandBuffer->SetViewport(viewport).IsSuccess());
+    });
+    Bench::Run("SetScissor", kDrawsPerFrame * kFrames, [&](uint64_t) {
+        Bench::DoNotOptimize(commandBuffer->SetScissor(scissor).IsSuccess());
+    });
+    Bench::Run("SetPipelineState", kDrawsPerFrame * kFrames, [&](uint64_t) {
+        Bench::DoNotOptimize(commandBuffer->SetPipelineState(pipeline.get()).IsSuccess());
+    });
+    Bench::Run("SetDescriptorSet", kDrawsPerFrame * kFrames, [&](uint64_t i) {
+        Bench::DoNotOptimize(commandBuffer->SetDescriptorSet(
+            static_cast<uint32_t>(i & 3), descriptorSet).IsSuccess());
+    });
+    Bench::Run("SetVertexBuffer", kDrawsPerFrame * kFrames, [&](uint64_t) {
+        Bench::DoNotOptimize(commandBuffer->SetVertexBuffer(0, vertexBufferView).IsSuccess());
+    });
+    double drawNs = Bench::Run("Draw", kDrawsPerFrame * kFrames, [&](uint64_t i) {
+        Bench::DoNotOptimize(commandBuffer->Draw(
+            static_cast<uint32_t>(i & 0xFF) + 3, 1, 0, 0).IsSuccess());
+    });
+    Bench::Run("DrawIndexed", kDrawsPerFrame * kFrames, [&](uint64_t i) {
+        Bench::DoNotOptimize(commandBuffer->DrawIndexed(
+            static_cast<uint32_t>(i & 0xFF) + 3, 1, 0, 0, 0).IsSuccess());
+    });
+
+    ok &= commandBuffer->End().IsSuccess();
+
+    std::vector<ICommandBuffer*> commandBuffers = { commandBuffer };
+    std::vector<ISemaphore*> noSemaphores;
+    Bench::Run("IQueue::Submit (1 command buffer)", kDrawsPerFrame, [&](uint64_t) {
+        Bench::DoNotOptimize(queue->Submit(commandBuffers, noSemaphores, noSemaphores, nullptr).IsSuccess());
+    });
+
+    if (!ok) {
+        std::printf("command buffer recording failed\n");
+        return 1;
+    }
+    if (argc > 1 && drawNs > std::atof(argv[1])) {
+        std::printf("Draw overhead %.2f ns exceeds budget %s ns\n", drawNs, argv[1]);
+        return 1;
+    }
+    return 0;
+}
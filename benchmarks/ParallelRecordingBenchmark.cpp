@@ -0,0 +1,178 @@
+// 多线程命令录制的扩展性
+// 空后端上每帧录制20000个绘制，每个绘制先计算一次4x4矩阵乘法（模拟剔除/常量准备等逐绘制CPU工作），
+// 再录制PushConstants + SetDescriptorSet + Draw。
+// 依次以1、2、4……直到硬件并发数（最多16）个线程录制，打印每帧耗时与相对单线程的加速比。
+// 另外检查同一帧内多次Record以及在途的帧使用不同的命令包，帧槽位轮转后复用命令包而不再分配。
+// 可选参数：最大线程数下允许的最低加速比，低于该值时返回非零退出码。
+#include "NullBackend.h"
+#include "ParallelCommandRecorder.h"
+#include "BenchUtil.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kDrawsPerFrame = 20000;
+constexpr uint32_t kMaxThreads = 16;
+
+struct Matrix {
+    float m[16];
+};
+
+inline Matrix Multiply(const Matrix& a, const Matrix& b) {
+    Matrix result;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                sum += a.m[row * 4 + k] * b.m[k * 4 + col];
+            }
+            result.m[row * 4 + col] = sum;
+        }
+    }
+    return result;
+}
+
+double RunFrames(uint32_t threadCount, uint64_t frames, bool& ok) {
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics).GetValue());
+    ICommandBuffer* primary = pool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+
+    DescriptorSetLayoutDesc layoutDesc = {};
+    std::unique_ptr<IDescriptorSetLayout> layout(device->CreateDescriptorSetLayout(layoutDesc).GetValue());
+    DescriptorPoolDesc poolDesc = {};
+    poolDesc.maxSets = 1;
+    std::unique_ptr<IDescriptorPool> descriptorPool(device->CreateDescriptorPool(poolDesc).GetValue());
+    IDescriptorSet* descriptorSet = descriptorPool->AllocateDescriptorSet(layout.get()).GetValue();
+
+    std::vector<Matrix> objects(kDrawsPerFrame);
+    for (uint32_t i = 0; i < kDrawsPerFrame; ++i) {
+        for (int j = 0; j < 16; ++j) {
+            objects[i].m[j] = static_cast<float>((i + j) % 7) * 0.25f;
+        }
+    }
+    Matrix viewProjection = objects[kDrawsPerFrame / 2];
+
+    IQueue* queue = device->GetQueue(QueueType::Graphics, 0).GetValue();
+    std::unique_ptr<IFence> fence(device->CreateFence(FenceDesc()).GetValue());
+    ParallelCommandRecorder recorder(device.get(), QueueType::Graphics, threadCount);
+    ok &= recorder.Initialize().IsSuccess();
+
+    ParallelRecordFunc recordDraws = [&](ICommandBuffer* bundle, uint32_t begin, uint32_t end) -> Result<void> {
+        for (uint32_t i = begin; i < end; ++i) {
+            Matrix mvp = Multiply(viewProjection, objects[i]);
+            RHI_RETURN_IF_FAILED(bundle->PushConstants(layout.get(), 0, sizeof(mvp), &mvp));
+            RHI_RETURN_IF_FAILED(bundle->SetDescriptorSet(0, descriptorSet));
+            RHI_RETURN_IF_FAILED(bundle->Draw(36, 1, 0, i));
+        }
+        return MakeSuccessResult();
+    };
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "Record %u draws (%u threads)", kDrawsPerFrame, recorder.GetThreadCount());
+    return Bench::Run(name, frames, [&](uint64_t) {
+        ok &= recorder.BeginFrame().IsSuccess();
+        ok &= pool->Reset().IsSuccess();
+        ok &= primary->Begin().IsSuccess();
+        ok &= recorder.Record(primary, kDrawsPerFrame, recordDraws).IsSuccess();
+        ok &= primary->End().IsSuccess();
+        ok &= queue->Submit({primary}, {}, {}, fence.get()).IsSuccess();
+        recorder.TrackSubmission(fence.get(), fence->GetLastSubmittedValue());
+    });
+}
+
+// 录制一次并返回使用的命令包
+std::set<ICommandBuffer*> RecordOnce(ParallelCommandRecorder& recorder, ICommandBuffer* primary, bool& ok) {
+    constexpr uint32_t kItems = 64;
+    std::vector<ICommandBuffer*> bundles(kItems, nullptr);
+    ok &= recorder.Record(primary, kItems, [&](ICommandBuffer* bundle, uint32_t begin, uint32_t end) -> Result<void> {
+        bundles[begin] = bundle;
+        return bundle->Draw(3, end - begin, 0, 0);
+    }).IsSuccess();
+    std::set<ICommandBuffer*> used(bundles.begin(), bundles.end());
+    used.erase(nullptr);
+    return used;
+}
+
+bool Disjoint(const std::set<ICommandBuffer*>& a, const std::set<ICommandBuffer*>& b) {
+    for (ICommandBuffer* bundle : a) {
+        if (b.count(bundle) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 每帧两次Record，两帧在途：第三帧才复用第一帧的命令包
+bool CheckBundleLifetime() {
+    bool ok = true;
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics).GetValue());
+    ICommandBuffer* primary = pool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+    ParallelCommandRecorder recorder(device.get(), QueueType::Graphics, 2, 2);
+#if RHI_VALIDATION_LEVEL != RHI_VALIDATION_LEVEL_OFF
+    ok &= !recorder.BeginFrame().IsSuccess();
+#endif
+    ok &= recorder.Initialize().IsSuccess();
+
+    std::set<ICommandBuffer*> frames[3][2];
+    for (uint32_t frame = 0; frame < 3; ++frame) {
+        ok &= recorder.BeginFrame().IsSuccess();
+        ok &= pool->Reset().IsSuccess();
+        ok &= primary->Begin().IsSuccess();
+        frames[frame][0] = RecordOnce(recorder, primary, ok);
+        frames[frame][1] = RecordOnce(recorder, primary, ok);
+        ok &= primary->End().IsSuccess();
+    }
+    ok &= frames[0][0].size() == 2 && Disjoint(frames[0][0], frames[0][1]);
+    ok &= Disjoint(frames[1][0], frames[0][0]) && Disjoint(frames[1][0], frames[0][1]) &&
+        Disjoint(frames[1][1], frames[0][0]) && Disjoint(frames[1][1], frames[0][1]);
+    ok &= frames[2][0] == frames[0][0] && frames[2][1] == frames[0][1];
+    ParallelCommandRecorderStats stats = recorder.GetStats();
+    ok &= stats.bundleAllocations == 8 && stats.bundleReuses == 4;
+    std::printf("bundle lifetime: %llu bundles allocated, %llu reused, %llu pool resets\n",
+                static_cast<unsigned long long>(stats.bundleAllocations),
+                static_cast<unsigned long long>(stats.bundleReuses),
+                static_cast<unsigned long long>(stats.poolResets));
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    constexpr uint64_t kFrames = 50;
+    uint32_t maxThreads = std::min(std::max(std::thread::hardware_concurrency(), 1u), kMaxThreads);
+    bool ok = CheckBundleLifetime();
+
+    double baseline = RunFrames(1, kFrames, ok);
+    double speedup = 1.0;
+    for (uint32_t threads = 2; threads <= maxThreads; threads *= 2) {
+        speedup = baseline / RunFrames(threads, kFrames, ok);
+        std::printf("  speedup x%.2f\n", speedup);
+    }
+    if (maxThreads > 1 && (maxThreads & (maxThreads - 1)) != 0) {
+        speedup = baseline / RunFrames(maxThreads, kFrames, ok);
+        std::printf("  speedup x%.2f\n", speedup);
+    }
+
+    if (!ok) {
+        std::printf("parallel recording failed\n");
+        return 1;
+    }
+    if (argc > 1 && speedup < std::atof(argv[1])) {
+        std::printf("speedup x%.2f at %u threads is below x%s\n", speedup, maxThreads, argv[1]);
+        return 1;
+    }
+    return 0;
+}
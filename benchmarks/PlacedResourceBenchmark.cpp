@@ -0,0 +1,173 @@
+// 放置资源与显式内存别名（CPU后端）
+// 1. 别名正确性：两个缓冲区与一个纹理放置在同一内存块的同一范围，切换使用前录制Aliasing屏障，
+//    通过一个资源写入的数据可以从其他资源读到
+// 2. 放置检查：偏移未对齐、超出内存块、内存类型不一致时创建失败
+// 3. 显存占用：8个依次读取上一个结果的1920x1080 RGBA16F后处理目标，独立分配与两段范围交替别名的对比
+// 4. 创建开销：1024x1024 RGBA8纹理独立创建（分配后备存储）与放置创建的对比
+// 任一检查不通过时返回非零退出码。
+#include "CPUBackend.h"
+#include "BenchUtil.h"
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr size_t kAliasSize = 1024 * 1024;
+constexpr uint32_t kChainPasses = 8;
+
+BarrierDesc MakeAliasingBarrier(void* resource, BarrierResourceType type, ResourceState stateAfter) {
+    BarrierDesc barrier = {};
+    barrier.type = BarrierType::Aliasing;
+    barrier.resource = resource;
+    barrier.stateBefore = ResourceState::Undefined;
+    barrier.stateAfter = stateAfter;
+    barrier.resourceType = type;
+    return barrier;
+}
+
+bool IsFilled(const uint8_t* data, size_t size, uint8_t value) {
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    CPUAdapter adapter(1);
+    std::unique_ptr<IDevice> device(adapter.CreateDevice(DeviceDesc()).GetValue());
+    IQueue* queue = device->GetQueue(QueueType::Graphics, 0).GetValue();
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics).GetValue());
+    ICommandBuffer* commandBuffer = pool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+    ICommandBuffer* commandBuffers[] = {commandBuffer};
+    SubmitDesc submit;
+    submit.commandBuffers = commandBuffers;
+
+    MemoryDesc memoryDesc;
+    memoryDesc.size = 64ull * 1024 * 1024;
+    std::unique_ptr<IMemory> memory(device->AllocateMemory(memoryDesc).GetValue());
+
+    // 1. 别名正确性
+    BufferDesc bufferDesc;
+    bufferDesc.type = BufferType::Storage;
+    bufferDesc.usage = BufferUsage::TransferDst | BufferUsage::UnorderedAccess;
+    bufferDesc.size = kAliasSize;
+    ResourceAllocationInfo bufferInfo = device->GetBufferAllocationInfo(bufferDesc).GetValue();
+    std::unique_ptr<IBuffer> a(device->CreatePlacedBuffer(bufferDesc, memory.get(), 0).GetValue());
+    std::unique_ptr<IBuffer> b(device->CreatePlacedBuffer(bufferDesc, memory.get(), 0).GetValue());
+
+    BufferDesc uploadDesc;
+    uploadDesc.type = BufferType::Staging;
+    uploadDesc.usage = BufferUsage::TransferSrc;
+    uploadDesc.memoryType = MemoryType::Upload;
+    uploadDesc.size = 2 * kAliasSize;
+    std::unique_ptr<IBuffer> upload(device->CreateBuffer(uploadDesc).GetValue());
+    uint8_t* uploadData = static_cast<uint8_t*>(upload->Map().GetValue());
+    std::memset(uploadData, 0x11, kAliasSize);
+    std::memset(uploadData + kAliasSize, 0x22, kAliasSize);
+    ok &= upload->Unmap().IsSuccess();
+
+    BufferCopyRegion toA = {0, 0, kAliasSize};
+    BufferCopyRegion toB = {kAliasSize, 0, kAliasSize};
+    BarrierDesc aliasB = MakeAliasingBarrier(b.get(), BarrierResourceType::Buffer, ResourceState::CopyDest);
+    ok &= commandBuffer->Begin().IsSuccess();
+    ok &= commandBuffer->CopyBuffer(upload.get(), a.get(), 1, &toA).IsSuccess();
+    ok &= commandBuffer->ResourceBarrier(1, &aliasB).IsSuccess();
+    ok &= commandBuffer->CopyBuffer(upload.get(), b.get(), 1, &toB).IsSuccess();
+    ok &= commandBuffer->End().IsSuccess();
+    ok &= queue->SubmitBatch(Span<const SubmitDesc>(&submit, 1), nullptr).IsSuccess();
+
+    uint8_t* aData = static_cast<NullBuffer*>(a.get())->GetStorage();
+    uint8_t* bData = static_cast<NullBuffer*>(b.get())->GetStorage();
+    bool buffersAlias = aData == bData && IsFilled(aData, kAliasSize, 0x22);
+    ok &= buffersAlias;
+
+    // 纹理接管同一范围：UpdateData写入的texel从缓冲区读到
+    TextureDesc aliasTextureDesc;
+    aliasTextureDesc.width = 512;
+    aliasTextureDesc.height = 512;
+    aliasTextureDesc.usage = TextureUsage::ShaderResource | TextureUsage::TransferDst;
+    std::unique_ptr<ITexture> texture(device->CreatePlacedTexture(aliasTextureDesc, memory.get(), 0).GetValue());
+    BarrierDesc aliasTexture = MakeAliasingBarrier(texture.get(), BarrierResourceType::Texture, ResourceState::CopyDest);
+    ok &= pool->Reset().IsSuccess();
+    ok &= commandBuffer->Begin().IsSuccess();
+    ok &= commandBuffer->ResourceBarrier(1, &aliasTexture).IsSuccess();
+    ok &= commandBuffer->End().IsSuccess();
+    ok &= queue->SubmitBatch(Span<const SubmitDesc>(&submit, 1), nullptr).IsSuccess();
+    std::vector<uint8_t> texels(kAliasSize, 0x33);
+    TextureDataLayout texelLayout = {};
+    ok &= texture->UpdateData(texels.data(), texelLayout, TextureSubresourceRange()).IsSuccess();
+    bool textureAliases = IsFilled(aData, kAliasSize, 0x33);
+    ok &= textureAliases;
+    std::printf("Aliasing: buffer->buffer %s, texture->buffer %s (buffer alignment %zu, texture alignment %zu)\n",
+                buffersAlias ? "visible" : "NOT visible", textureAliases ? "visible" : "NOT visible",
+                bufferInfo.alignment, device->GetTextureAllocationInfo(aliasTextureDesc).GetValue().alignment);
+
+    // 2. 放置检查
+    bool misaligned = device->CreatePlacedBuffer(bufferDesc, memory.get(), bufferInfo.alignment / 2).IsSuccess();
+    bool outOfRange = device->CreatePlacedBuffer(bufferDesc, memory.get(), memoryDesc.size - bufferInfo.alignment).IsSuccess();
+    BufferDesc readbackDesc = bufferDesc;
+    readbackDesc.memoryType = MemoryType::Readback;
+    bool wrongType = device->CreatePlacedBuffer(readbackDesc, memory.get(), 0).IsSuccess();
+    bool textureMisaligned = device->CreatePlacedTexture(aliasTextureDesc, memory.get(), bufferInfo.alignment).IsSuccess();
+    ok &= !misaligned && !outOfRange && !wrongType && !textureMisaligned;
+    std::printf("Placement checks: misaligned %s, out of range %s, memory type mismatch %s, texture misaligned %s\n",
+                misaligned ? "accepted" : "rejected", outOfRange ? "accepted" : "rejected",
+                wrongType ? "accepted" : "rejected", textureMisaligned ? "accepted" : "rejected");
+
+    // 3. 显存占用：第i个目标只被第i+1个读取，相隔一个的目标可以共用同一范围
+    TextureDesc targetDesc;
+    targetDesc.format = Format::RGBA16_FLOAT;
+    targetDesc.width = 1920;
+    targetDesc.height = 1080;
+    targetDesc.usage = TextureUsage::RenderTarget | TextureUsage::ShaderResource;
+    ResourceAllocationInfo targetInfo = device->GetTextureAllocationInfo(targetDesc).GetValue();
+    uint64_t committedBytes = static_cast<uint64_t>(targetInfo.size) * kChainPasses;
+    uint64_t placedBytes = static_cast<uint64_t>(targetInfo.size) * 2;
+    MemoryDesc chainDesc;
+    chainDesc.size = static_cast<size_t>(placedBytes);
+    chainDesc.alignment = targetInfo.alignment;
+    std::unique_ptr<IMemory> chainMemory(device->AllocateMemory(chainDesc).GetValue());
+    std::vector<std::unique_ptr<ITexture>> targets;
+    for (uint32_t i = 0; i < kChainPasses; ++i) {
+        auto target = device->CreatePlacedTexture(targetDesc, chainMemory.get(), (i % 2) * targetInfo.size);
+        ok &= target.IsSuccess();
+        if (target.IsSuccess()) {
+            targets.emplace_back(target.GetValue());
+        }
+    }
+    ok &= targets.size() == kChainPasses &&
+        static_cast<CPUTexture*>(targets[0].get())->GetStorage() ==
+        static_cast<CPUTexture*>(targets[kChainPasses - 2].get())->GetStorage();
+    std::printf("%u post-process targets: committed %.1f MB, placed with aliasing %.1f MB (%.0f%% saved)\n",
+                kChainPasses, committedBytes / 1048576.0, placedBytes / 1048576.0,
+                100.0 * (1.0 - static_cast<double>(placedBytes) / committedBytes));
+    targets.clear();
+
+    // 4. 创建开销
+    TextureDesc createDesc;
+    createDesc.width = 1024;
+    createDesc.height = 1024;
+    createDesc.usage = TextureUsage::RenderTarget | TextureUsage::ShaderResource;
+    double committedNs = Bench::Run("CreateTexture (1024x1024 RGBA8)", 2000, [&](uint64_t) {
+        auto created = device->CreateTexture(createDesc);
+        ok &= created.IsSuccess();
+        delete created.GetValue();
+    });
+    double placedNs = Bench::Run("CreatePlacedTexture (1024x1024 RGBA8)", 2000, [&](uint64_t) {
+        auto created = device->CreatePlacedTexture(createDesc, memory.get(), 0);
+        ok &= created.IsSuccess();
+        delete created.GetValue();
+    });
+    std::printf("Placed creation speedup: %.1fx\n", committedNs / placedNs);
+
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+// 渲染图在4K延迟渲染管线上的内存与屏障统计
+// 管线：阴影图 -> G缓冲（5个目标）-> SSAO与模糊 -> 光照 -> 5级泛光降采样 -> TAA -> 色调映射到导入的后备缓冲区，
+// 外加一个无人读取的调试通道（应被剔除）。
+// 打印中间目标独立分配、物理资源复用与按生命周期别名到瞬态堆三种方式所需的内存，
+// 以及每帧声明+Compile+Execute的耗时（空后端）；热身后若仍创建物理资源，或瞬态堆没有实际分配、
+// 共享内存的资源没有别名屏障，返回非零退出码。
+#include "NullBackend.h"
+#include "RenderGraph.h"
+#include "BenchUtil.h"
+#include <memory>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kWidth = 3840;
+constexpr uint32_t kHeight = 2160;
+constexpr uint32_t kBloomLevels = 5;
+
+TextureDesc MakeTarget(Format format, uint32_t width, uint32_t height, TextureUsage usage) {
+    TextureDesc desc;
+    desc.format = format;
+    desc.width = width;
+    desc.height = height;
+    desc.usage = usage | TextureUsage::ShaderResource;
+    return desc;
+}
+
+Result<void> DrawFullscreen(RenderGraphContext& context) {
+    return context.GetCommandBuffer()->Draw(3, 1, 0, 0);
+}
+
+Result<void> DispatchTiles(RenderGraphContext& context) {
+    return context.GetCommandBuffer()->Dispatch(kWidth / 8, kHeight / 8, 1);
+}
+
+// 声明一帧的延迟渲染管线
+void BuildFrame(RenderGraph& graph, ITexture* backBuffer) {
+    const TextureUsage rt = TextureUsage::RenderTarget;
+    const TextureUsage ds = TextureUsage::DepthStencil;
+    const TextureUsage uav = TextureUsage::UnorderedAccess;
+
+    RenderGraphResource shadowMap = graph.CreateTexture("ShadowMap", MakeTarget(Format::D32_FLOAT, 4096, 4096, ds));
+    graph.AddPass("Shadows", DrawFullscreen)
+        .Write(shadowMap, ResourceState::DepthWrite);
+
+    RenderGraphResource albedo = graph.CreateTexture("GBufferAlbedo", MakeTarget(Format::RGBA8_UNORM, kWidth, kHeight, rt));
+    RenderGraphResource normal = graph.CreateTexture("GBufferNormal", MakeTarget(Format::RGBA16_FLOAT, kWidth, kHeight, rt));
+    RenderGraphResource material = graph.CreateTexture("GBufferMaterial", MakeTarget(Format::RGBA8_UNORM, kWidth, kHeight, rt));
+    RenderGraphResource motion = graph.CreateTexture("GBufferMotion", MakeTarget(Format::RG16_FLOAT, kWidth, kHeight, rt));
+    RenderGraphResource depth = graph.CreateTexture("Depth", MakeTarget(Format::D32_FLOAT, kWidth, kHeight, ds));
+    graph.AddPass("GBuffer", DrawFullscreen)
+        .Write(albedo, ResourceState::RenderTarget)
+        .Write(normal, ResourceState::RenderTarget)
+        .Write(material, ResourceState::RenderTarget)
+        .Write(motion, ResourceState::RenderTarget)
+        .Write(depth, ResourceState::DepthWrite);
+
+    RenderGraphResource debugView = graph.CreateTexture("DebugView", MakeTarget(Format::RGBA16_FLOAT, kWidth, kHeight, rt));
+    graph.AddPass("DebugView", DrawFullscreen)
+        .Read(normal, ResourceState::ShaderResource)
+        .Write(debugView, ResourceState::RenderTarget);
+
+    RenderGraphResource ssao = graph.CreateTexture("SSAO", MakeTarget(Format::R8_UNORM, kWidth, kHeight, uav));
+    graph.AddPass("SSAO", DispatchTiles)
+        .Read(depth, ResourceState::ShaderResource)
+        .Read(normal, ResourceState::ShaderResource)
+        .Write(ssao, ResourceState::UnorderedAccess);
+    RenderGraphResource ssaoBlur = graph.CreateTexture("SSAOBlur", MakeTarget(Format::R8_UNORM, kWidth, kHeight, uav));
+    graph.AddPass("SSAOBlur", DispatchTiles)
+        .Read(ssao, ResourceState::ShaderResource)
+        .Write(ssaoBlur, ResourceState::UnorderedAccess);
+
+    RenderGraphResource lighting = graph.CreateTexture("Lighting", MakeTarget(Format::RGBA16_FLOAT, kWidth, kHeight, uav));
+    graph.AddPass("Lighting", DispatchTiles)
+        .Read(albedo, ResourceState::ShaderResource)
+        .Read(normal, ResourceState::ShaderResource)
+        .Read(material, ResourceState::ShaderResource)
+        .Read(depth, ResourceState::ShaderResource)
+        .Read(shadowMap, ResourceState::ShaderResource)
+        .Read(ssaoBlur, ResourceState::ShaderResource)
+        .Write(lighting, ResourceState::UnorderedAccess);
+
+    RenderGraphResource bloom[kBloomLevels];
+    RenderGraphResource source = lighting;
+    for (uint32_t i = 0; i < kBloomLevels; ++i) {
+        bloom[i] = graph.CreateTexture("Bloom",
+            MakeTarget(Format::RGBA16_FLOAT, kWidth >> (i + 1), kHeight >> (i + 1), uav));
+        graph.AddPass("BloomDownsample", DispatchTiles)
+            .Read(source, ResourceState::ShaderResource)
+            .Write(bloom[i], ResourceState::UnorderedAccess);
+        source = bloom[i];
+    }
+
+    RenderGraphResource taa = graph.CreateTexture("TAA", MakeTarget(Format::RGBA16_FLOAT, kWidth, kHeight, uav));
+    graph.AddPass("TAA", DispatchTiles)
+        .Read(lighting, ResourceState::ShaderResource)
+        .Read(motion, ResourceState::ShaderResource)
+        .Read(depth, ResourceState::ShaderResource)
+        .Write(taa, ResourceState::UnorderedAccess);
+
+    RenderGraphResource output = graph.ImportTexture("BackBuffer", backBuffer,
+        ResourceState::Present, ResourceState::Present);
+    RenderGraphPassBuilder tonemap = graph.AddPass("Tonemap", DrawFullscreen);
+    tonemap.Read(taa, ResourceState::ShaderResource)
+        .Write(output, ResourceState::RenderTarget);
+    for (uint32_t i = 0; i < kBloomLevels; ++i) {
+        tonemap.Read(bloom[i], ResourceState::ShaderResource);
+    }
+}
+
+double ToMiB(size_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kFrames = 20000;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics, true).GetValue());
+    auto allocated = pool->AllocateCommandBuffers(CommandBufferAllocateInfo());
+    ICommandBuffer* commandBuffer = allocated.GetValue()[0];
+    std::unique_ptr<ITexture> backBuffer(device->CreateTexture(
+        MakeTarget(Format::BGRA8_UNORM, kWidth, kHeight, TextureUsage::RenderTarget)).GetValue());
+
+    RenderGraph graph(device.get());
+    bool ok = true;
+    auto frame = [&]() {
+        graph.Reset();
+        BuildFrame(graph, backBuffer.get());
+        Result<void> compiled = graph.Compile();
+        if (!compiled.IsSuccess()) {
+            std::printf("compile failed: %s\n", compiled.GetErrorMessage());
+            ok = false;
+            return;
+        }
+        ok &= commandBuffer->Reset().IsSuccess();
+        ok &= commandBuffer->Begin().IsSuccess();
+        ok &= graph.Execute(commandBuffer).IsSuccess();
+        ok &= commandBuffer->End().IsSuccess();
+    };
+
+    frame();
+    RenderGraphStats first = graph.GetStats();
+    Bench::Run("Frame (declare + compile + execute)", kFrames, [&](uint64_t) { frame(); });
+    RenderGraphStats stats = graph.GetStats();
+
+    std::printf("passes: %u declared, %u culled, %u levels\n",
+                stats.passCount, stats.culledPassCount, stats.levelCount);
+    std::printf("barriers: %u (%u aliasing) in %u ResourceBarrier calls per frame\n",
+                stats.barrierCount, stats.aliasingBarrierCount, stats.barrierCallCount);
+    std::printf("transient resources: %u -> %u physical (first frame created %u, steady state %u)\n",
+                stats.transientResourceCount, stats.physicalResourceCount,
+                first.createdResourceCount, stats.createdResourceCount);
+    std::printf("intermediate memory: %.1f MiB dedicated, %.1f MiB with physical reuse, "
+                "%.1f MiB aliased into %u heap(s)\n",
+                ToMiB(stats.dedicatedBytes), ToMiB(stats.physicalBytes), ToMiB(stats.heapBytes), stats.heapCount);
+
+    if (!ok) {
+        std::printf("frame recording failed\n");
+        return 1;
+    }
+    if (stats.createdResourceCount != 0) {
+        std::printf("steady state created new physical resources\n");
+        return 1;
+    }
+    if (device->GetMemoryTracker().GetTagUsage("RenderGraph").bytes != stats.heapBytes ||
+        stats.heapBytes >= stats.physicalBytes || stats.aliasingBarrierCount == 0) {
+        std::printf("transient heaps were not allocated or aliased\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,226 @@
+// 显存超额订阅时的驻留管理
+// 96个64MB内存块（共6GB）对2GB预算：每帧引用4个常驻块、相机附近24个块中隔帧交替的一半，每16帧再引用一个随机块；
+// 相机来回移动，每8帧移动一个内存块。相邻两帧的工作集约1.75GB；每200帧出现一帧引用40个块（2.5GB，超出预算）。
+// 1. ResidencyManager（最近最少使用逐出）
+// 2. 对照：空间不足时随机逐出不在本帧工作集中的内存块
+// 打印每帧重新驻留的字节数与Submit的开销。提交时工作集中有内存块未驻留、未超额的帧驻留量超出预算、
+// 超额帧提交失败，或设备预算扣除未跟踪占用的结果不正确时返回非零退出码。
+#include "NullBackend.h"
+#include "ResidencyManager.h"
+#include "BenchUtil.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kHeaps = 96;
+constexpr uint64_t kHeapSize = 64ull * 1024 * 1024;
+constexpr uint64_t kBudget = 2048ull * 1024 * 1024;
+constexpr uint32_t kFrames = 2400;
+constexpr uint32_t kGlobalHeaps = 4;
+constexpr uint32_t kWindowHeaps = 24;
+constexpr uint32_t kRandomInterval = 16;
+constexpr uint32_t kOversubscribedHeaps = 40;
+constexpr uint32_t kOversubscribeInterval = 200;
+
+struct Random {
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+
+    uint64_t Next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// 第frame帧引用的内存块下标（可能重复）
+void BuildWorkingSet(uint32_t frame, Random& random, std::vector<uint32_t>& heaps) {
+    heaps.clear();
+    if (frame % kOversubscribeInterval == kOversubscribeInterval - 1) {
+        for (uint32_t i = 0; i < kOversubscribedHeaps; ++i) {
+            heaps.push_back(static_cast<uint32_t>((frame + i * 7) % kHeaps));
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < kGlobalHeaps; ++i) {
+        heaps.push_back(i);
+    }
+    // 相机每8帧移动一个内存块，到达两端后折返
+    uint32_t streamed = kHeaps - kGlobalHeaps;
+    uint32_t range = streamed - kWindowHeaps;
+    uint32_t step = (frame / 8) % (2 * range);
+    uint32_t position = step < range ? step : 2 * range - step;
+    for (uint32_t i = frame % 2; i < kWindowHeaps; i += 2) {
+        heaps.push_back(kGlobalHeaps + position + i);
+    }
+    if (frame % kRandomInterval == 0) {
+        heaps.push_back(kGlobalHeaps + static_cast<uint32_t>(random.Next() % streamed));
+    }
+}
+
+bool IsOversubscribedFrame(uint32_t frame) {
+    return frame % kOversubscribeInterval == kOversubscribeInterval - 1;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+    IQueue* queue = device->GetQueue(QueueType::Graphics, 0).GetValue();
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics).GetValue());
+    ICommandBuffer* commandBuffer = pool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+
+    // 设备预算：未跟踪的1GB内存从预算中扣除
+    MemoryDesc untrackedDesc;
+    untrackedDesc.size = 1024ull * 1024 * 1024;
+    std::unique_ptr<IMemory> untracked(device->AllocateMemory(untrackedDesc).GetValue());
+    {
+        ResidencyManager probe(device.get());
+        ok &= probe.Initialize().IsSuccess();
+        uint64_t expected = static_cast<uint64_t>(
+            static_cast<double>(kNullDedicatedVideoMemory) * ResidencyManagerDesc().budgetScale) - untrackedDesc.size;
+        ok &= probe.GetStats().budget == expected;
+        std::printf("Device budget: %.0f MB (adapter %.0f MB x 0.9 - %.0f MB untracked)\n",
+                    probe.GetStats().budget / 1048576.0, kNullDedicatedVideoMemory / 1048576.0,
+                    untrackedDesc.size / 1048576.0);
+    }
+    untracked.reset();
+
+    std::vector<std::unique_ptr<IMemory>> heaps;
+    for (uint32_t i = 0; i < kHeaps; ++i) {
+        MemoryDesc memoryDesc;
+        memoryDesc.size = kHeapSize;
+        heaps.emplace_back(device->AllocateMemory(memoryDesc).GetValue());
+    }
+    auto isResident = [&heaps](uint32_t index) {
+        return static_cast<NullMemory*>(heaps[index].get())->IsResident();
+    };
+
+    auto recordFrame = [&]() {
+        ok &= pool->Reset().IsSuccess();
+        ok &= commandBuffer->Begin().IsSuccess();
+        ok &= commandBuffer->End().IsSuccess();
+    };
+
+    // 1. ResidencyManager
+    ResidencyManagerDesc residencyDesc;
+    residencyDesc.budget = kBudget;
+    ResidencyManager residency(device.get(), residencyDesc);
+    ok &= residency.Initialize().IsSuccess();
+    for (const auto& heap : heaps) {
+        ok &= residency.Track(heap.get()).IsSuccess();
+    }
+    ok &= residency.GetStats().residentBytes <= kBudget;
+
+    Random random;
+    std::vector<uint32_t> workingSet;
+    ResidencySet set;
+    const ResidencySet* sets[] = {&set};
+    ICommandBuffer* commandBuffers[] = {commandBuffer};
+    SubmitDesc submit;
+    submit.commandBuffers = commandBuffers;
+    uint32_t missingHeaps = 0;
+    uint32_t overBudgetFrames = 0;
+    ResidencyStats before = residency.GetStats();
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < kFrames; ++frame) {
+        BuildWorkingSet(frame, random, workingSet);
+        set.Reset();
+        for (uint32_t index : workingSet) {
+            set.Insert(heaps[index].get());
+        }
+        recordFrame();
+        ok &= residency.Submit(queue, Span<const SubmitDesc>(&submit, 1),
+            Span<const ResidencySet* const>(sets, 1)).IsSuccess();
+        for (uint32_t index : workingSet) {
+            missingHeaps += isResident(index) ? 0 : 1;
+        }
+        if (!IsOversubscribedFrame(frame) && residency.GetStats().residentBytes > kBudget) {
+            ++overBudgetFrames;
+        }
+    }
+    double managedUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+    ResidencyStats stats = residency.GetStats();
+    ok &= missingHeaps == 0 && overBudgetFrames == 0;
+    ok &= stats.oversubscribedSubmits == kFrames / kOversubscribeInterval;
+    std::printf("ResidencyManager (LRU):  %7.1f MB paged in per frame, %llu evictions, %llu oversubscribed submits, "
+                "%.2f us/frame\n",
+                (stats.pagedInBytes - before.pagedInBytes) / 1048576.0 / kFrames,
+                static_cast<unsigned long long>(stats.evictions - before.evictions),
+                static_cast<unsigned long long>(stats.oversubscribedSubmits),
+                managedUs / kFrames);
+
+    // 提交开销：工作集全部驻留时与直接SubmitBatch对比
+    set.Reset();
+    for (uint32_t i = 0; i < kGlobalHeaps + kWindowHeaps / 2; ++i) {
+        set.Insert(heaps[i].get());
+    }
+    recordFrame();
+    double managedNs = Bench::Run("ResidencyManager::Submit (16 heaps resident)", 200000, [&](uint64_t) {
+        ok &= residency.Submit(queue, Span<const SubmitDesc>(&submit, 1),
+            Span<const ResidencySet* const>(sets, 1)).IsSuccess();
+    });
+    double rawNs = Bench::Run("IQueue::SubmitBatch", 200000, [&](uint64_t) {
+        ok &= queue->SubmitBatch(Span<const SubmitDesc>(&submit, 1), nullptr).IsSuccess();
+    });
+    std::printf("Residency overhead per submit: %.2f ns\n", managedNs - rawNs);
+    for (const auto& heap : heaps) {
+        ok &= residency.Untrack(heap.get()).IsSuccess();
+        ok &= heap->MakeResident().IsSuccess();
+    }
+
+    // 2. 对照：随机逐出
+    Random evictRandom;
+    random = Random();
+    uint64_t residentBytes = kHeaps * kHeapSize;
+    uint64_t pagedIn = 0;
+    std::vector<uint8_t> used(kHeaps);
+    for (uint32_t frame = 0; frame < kFrames; ++frame) {
+        BuildWorkingSet(frame, random, workingSet);
+        std::fill(used.begin(), used.end(), 0);
+        uint64_t needed = 0;
+        for (uint32_t index : workingSet) {
+            if (!used[index]) {
+                used[index] = 1;
+                needed += isResident(index) ? 0 : kHeapSize;
+            }
+        }
+        while (residentBytes + needed > kBudget) {
+            uint32_t candidates = 0;
+            for (uint32_t i = 0; i < kHeaps; ++i) {
+                candidates += isResident(i) && !used[i] ? 1 : 0;
+            }
+            if (candidates == 0) {
+                break;
+            }
+            uint32_t pick = static_cast<uint32_t>(evictRandom.Next() % candidates);
+            for (uint32_t i = 0; i < kHeaps; ++i) {
+                if (isResident(i) && !used[i] && pick-- == 0) {
+                    ok &= heaps[i]->Evict().IsSuccess();
+                    residentBytes -= kHeapSize;
+                    break;
+                }
+            }
+        }
+        for (uint32_t i = 0; i < kHeaps; ++i) {
+            if (used[i] && !isResident(i)) {
+                ok &= heaps[i]->MakeResident().IsSuccess();
+                residentBytes += kHeapSize;
+                pagedIn += kHeapSize;
+            }
+        }
+    }
+    std::printf("Random eviction:         %7.1f MB paged in per frame\n", pagedIn / 1048576.0 / kFrames);
+    std::printf("Without residency: %.0f MB resident against a %.0f MB budget\n",
+                kHeaps * kHeapSize / 1048576.0, kBudget / 1048576.0);
+
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
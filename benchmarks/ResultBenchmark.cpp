@@ -0,0 +1,182 @@
+// Result<T>每次调用开销的微基准测试
+// 对比旧版Result（携带std::string错误消息、按值复制结果）与当前Result的开销：
+// - 热路径命令（Draw等）通过虚函数返回Result<void>
+// - 返回std::vector的查询（GetQueueFamilyProperties等）
+// 另外检查局部缓冲区中的错误消息被驻留、值类型无需可默认构造；检查不通过时返回非零退出码。
+#include "Result.h"
+#include "ErrorUtil.h"
+#include "BenchUtil.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace RHI;
+
+// 旧版Result的等价实现（仅用于对比）
+template<typename T>
+class LegacyResult {
+public:
+    static LegacyResult Success(const T& value) { return LegacyResult(value); }
+    static LegacyResult Failure(ErrorCode code, const std::string& message) {
+        return LegacyResult(code, message);
+    }
+    bool IsSuccess() const { return m_errorCode == ErrorCode::Success; }
+    const T& GetValue() const { return m_value; }
+
+private:
+    LegacyResult(const T& value) : m_errorCode(ErrorCode::Success), m_value(value) {}
+    LegacyResult(ErrorCode code, const std::string& message)
+        : m_errorCode(code), m_errorMessage(message) {}
+
+    ErrorCode m_errorCode = ErrorCode::Success;
+    std::string m_errorMessage;
+    T m_value;
+};
+
+class LegacyVoidResult {
+public:
+    static LegacyVoidResult Success() { return LegacyVoidResult(); }
+    static LegacyVoidResult Failure(ErrorCode code, const std::string& message) {
+        return LegacyVoidResult(code, message);
+    }
+    bool IsSuccess() const { return m_errorCode == ErrorCode::Success; }
+
+private:
+    LegacyVoidResult() : m_errorCode(ErrorCode::Success) {}
+    LegacyVoidResult(ErrorCode code, const std::string& message)
+        : m_errorCode(code), m_errorMessage(message) {}
+
+    ErrorCode m_errorCode = ErrorCode::Success;
+    std::string m_errorMessage;
+};
+
+// 模拟ICommandBuffer的虚调用形态
+class ILegacyCommands {
+public:
+    virtual ~ILegacyCommands() = default;
+    virtual LegacyVoidResult Draw(uint32_t vertexCount, uint32_t instanceCount) = 0;
+    virtual LegacyResult<std::vector<uint32_t>> Query() const = 0;
+};
+
+class ICommands {
+public:
+    virtual ~ICommands() = default;
+    virtual Result<void> Draw(uint32_t vertexCount, uint32_t instanceCount) = 0;
+    virtual Result<std::vector<uint32_t>> Query() const = 0;
+};
+
+class LegacyCommands : public ILegacyCommands {
+public:
+    LegacyVoidResult Draw(uint32_t vertexCount, uint32_t instanceCount) override {
+        if (vertexCount == 0 || instanceCount == 0) {
+            return LegacyVoidResult::Failure(ErrorCode::InvalidArgument, "绘制数量必须大于0");
+        }
+        m_drawCount += vertexCount;
+        return LegacyVoidResult::Success();
+    }
+
+    LegacyResult<std::vector<uint32_t>> Query() const override {
+        return LegacyResult<std::vector<uint32_t>>::Success(m_data);
+    }
+
+    uint64_t m_drawCount = 0;
+    std::vector<uint32_t> m_data = std::vector<uint32_t>(64, 1);
+};
+
+class Commands : public ICommands {
+public:
+    Result<void> Draw(uint32_t vertexCount, uint32_t instanceCount) override {
+        RHI_RETURN_IF_FALSE(vertexCount > 0 && instanceCount > 0,
+            ErrorCode::InvalidArgument,
+            "绘制数量必须大于0");
+        m_drawCount += vertexCount;
+        return MakeSuccessResult();
+    }
+
+    Result<std::vector<uint32_t>> Query() const override {
+        return MakeSuccessResult(std::vector<uint32_t>(m_data));
+    }
+
+    uint64_t m_drawCount = 0;
+    std::vector<uint32_t> m_data = std::vector<uint32_t>(64, 1);
+};
+
+// 没有默认构造函数的值类型
+struct Handle {
+    explicit Handle(uint32_t value) : value(value) {}
+    uint32_t value;
+};
+
+// 消息写入局部缓冲区后返回
+Result<Handle> FailWithLocalBuffer(uint32_t index) {
+    char message[64];
+    std::snprintf(message, sizeof(message), "句柄索引越界: %u", index);
+    return MakeErrorResult<Handle>(ErrorCode::InvalidArgument, message);
+}
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kDrawsPerFrame = 50000;
+    constexpr uint64_t kFrames = 200;
+
+    std::printf("sizeof(LegacyVoidResult) = %zu, sizeof(Result<void>) = %zu\n",
+        sizeof(LegacyVoidResult), sizeof(Result<void>));
+    std::printf("Result<void> trivially copyable: %s\n\n",
+        std::is_trivially_copyable<Result<void>>::value ? "yes" : "no");
+
+    LegacyCommands legacyImpl;
+    Commands impl;
+    ILegacyCommands* legacy = &legacyImpl;
+    ICommands* current = &impl;
+
+    Bench::Run("Legacy Result<void> Draw (virtual)", kDrawsPerFrame * kFrames, [&](uint64_t i) {
+        auto result = legacy->Draw(static_cast<uint32_t>(i & 0xFF) + 3, 1);
+        Bench::DoNotOptimize(result.IsSuccess());
+    });
+    Bench::Run("Result<void> Draw (virtual)", kDrawsPerFrame * kFrames, [&](uint64_t i) {
+        auto result = current->Draw(static_cast<uint32_t>(i & 0xFF) + 3, 1);
+        Bench::DoNotOptimize(result.IsSuccess());
+    });
+
+    Bench::Run("Legacy Result<vector> Query + GetValue copy", kDrawsPerFrame, [&](uint64_t) {
+        auto result = legacy->Query();
+        std::vector<uint32_t> value = result.GetValue();
+        Bench::DoNotOptimize(value.data());
+    });
+    Bench::Run("Result<vector> Query + GetValue move", kDrawsPerFrame, [&](uint64_t) {
+        auto result = current->Query();
+        std::vector<uint32_t> value = std::move(result).GetValue();
+        Bench::DoNotOptimize(value.data());
+    });
+
+    Bench::Run("Legacy failure path", kDrawsPerFrame, [&](uint64_t) {
+        auto result = legacy->Draw(0, 1);
+        Bench::DoNotOptimize(result.IsSuccess());
+    });
+    Bench::Run("Result failure path", kDrawsPerFrame, [&](uint64_t) {
+        auto result = current->Draw(0, 1);
+        Bench::DoNotOptimize(result.IsSuccess());
+    });
+
+    bool ok = std::is_trivially_copyable<Result<Handle>>::value;
+    Result<Handle> handle = MakeSuccessResult(Handle(7));
+    ok &= handle.IsSuccess() && handle.GetValue().value == 7;
+    Result<Handle> failed = FailWithLocalBuffer(42);
+    // 覆盖同一段栈空间后消息仍然有效
+    Result<Handle> other = FailWithLocalBuffer(43);
+    ok &= !failed.IsSuccess() && std::strcmp(failed.GetErrorMessage(), "句柄索引越界: 42") == 0;
+    ok &= std::strcmp(other.GetErrorMessage(), "句柄索引越界: 43") == 0;
+    Result<std::vector<uint32_t>> copied = current->Query();
+    Result<std::vector<uint32_t>> assigned = Result<std::vector<uint32_t>>(ErrorInfo{ErrorCode::Unknown, ""});
+    assigned = copied;
+    ok &= assigned.IsSuccess() && assigned.GetValue().size() == 64 && copied.GetValue().size() == 64;
+    assigned = Result<std::vector<uint32_t>>(ErrorInfo{ErrorCode::Unknown, ""});
+    ok &= !assigned.IsSuccess();
+
+    std::printf("\n%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+// 批量提交与逐次提交的对比
+// 每帧在图形队列上提交32次、计算队列上提交16次，每次提交1个命令缓冲区、等待另一个队列的时间线信号量并发出本队列的信号量。
+// 逐次提交按常见写法用初始化列表构造三个vector调用IQueue::Submit；批量提交每个队列调用一次SubmitBatch，
+// 描述符数组在帧间复用。打印每帧耗时、原生提交调用次数与堆分配次数（空后端，不含驱动开销）；
+// 热身后SubmitBatch仍有堆分配，或值不递增的批次被拒绝后留下部分提交的状态时返回非零退出码。
+#include "NullBackend.h"
+#include "BenchUtil.h"
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+} // namespace
+
+// 替换的分配函数不内联：内联后GCC把free与调用方的operator new配对，误报-Wmismatched-new-delete
+RHI_BENCH_NOINLINE void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size != 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+RHI_BENCH_NOINLINE void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+RHI_BENCH_NOINLINE void operator delete(void* pointer, size_t) noexcept {
+    std::free(pointer);
+}
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kSubmitsPerQueue[2] = {32, 16};
+constexpr QueueType kQueueTypes[2] = {QueueType::Graphics, QueueType::Compute};
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kFrames = 20000;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+
+    IQueue* queues[2];
+    std::unique_ptr<ICommandPool> pools[2];
+    std::vector<ICommandBuffer*> commandBuffers[2];
+    std::unique_ptr<ISemaphore> semaphores[2];
+    std::unique_ptr<IFence> fences[2];
+    SemaphoreDesc semaphoreDesc;
+    semaphoreDesc.binary = false;
+    bool ok = true;
+    for (uint32_t q = 0; q < 2; ++q) {
+        queues[q] = device->GetQueue(kQueueTypes[q], 0).GetValue();
+        pools[q].reset(device->CreateCommandPool(kQueueTypes[q], true).GetValue());
+        CommandBufferAllocateInfo allocInfo;
+        allocInfo.count = kSubmitsPerQueue[q];
+        commandBuffers[q] = pools[q]->AllocateCommandBuffers(allocInfo).GetValue();
+        for (ICommandBuffer* commandBuffer : commandBuffers[q]) {
+            ok &= commandBuffer->Begin().IsSuccess();
+            ok &= commandBuffer->Dispatch(1, 1, 1).IsSuccess();
+            ok &= commandBuffer->End().IsSuccess();
+        }
+        semaphores[q].reset(device->CreateSemaphore(semaphoreDesc).GetValue());
+        fences[q].reset(device->CreateFence(FenceDesc()).GetValue());
+    }
+
+    // 逐次提交
+    uint64_t nativeSubmits = 0;
+    uint64_t before = g_allocations.load();
+    Bench::Run("Frame (48 x IQueue::Submit)", kFrames, [&](uint64_t) {
+        for (uint32_t q = 0; q < 2; ++q) {
+            for (ICommandBuffer* commandBuffer : commandBuffers[q]) {
+                ok &= queues[q]->Submit({commandBuffer}, {semaphores[1 - q].get()}, {semaphores[q].get()},
+                    fences[q].get()).IsSuccess();
+                ++nativeSubmits;
+            }
+        }
+    });
+    uint64_t frames = kFrames + kFrames / 10 + 1;
+    uint64_t submitAllocations = g_allocations.load() - before;
+    uint64_t submitCalls = nativeSubmits;
+
+    // 批量提交：描述符数组在帧间复用，只更新时间线值
+    uint64_t values[2] = {semaphores[0]->GetValue().GetValue(), semaphores[1]->GetValue().GetValue()};
+    std::vector<SubmitDesc> submits[2];
+    std::vector<SemaphoreWaitInfo> waits[2];
+    std::vector<SemaphoreSignalInfo> signals[2];
+    for (uint32_t q = 0; q < 2; ++q) {
+        submits[q].resize(kSubmitsPerQueue[q]);
+        waits[q].resize(kSubmitsPerQueue[q]);
+        signals[q].resize(kSubmitsPerQueue[q]);
+        for (uint32_t i = 0; i < kSubmitsPerQueue[q]; ++i) {
+            waits[q][i] = SemaphoreWaitInfo(semaphores[1 - q].get(), 0, PipelineStage::ComputeShader);
+            signals[q][i] = SemaphoreSignalInfo(semaphores[q].get(), 0);
+            submits[q][i].commandBuffers = Span<ICommandBuffer* const>(&commandBuffers[q][i], 1);
+            submits[q][i].waitSemaphores = Span<const SemaphoreWaitInfo>(&waits[q][i], 1);
+            submits[q][i].signalSemaphores = Span<const SemaphoreSignalInfo>(&signals[q][i], 1);
+        }
+    }
+    nativeSubmits = 0;
+    before = g_allocations.load();
+    Bench::Run("Frame (2 x IQueue::SubmitBatch)", kFrames, [&](uint64_t) {
+        for (uint32_t q = 0; q < 2; ++q) {
+            for (uint32_t i = 0; i < kSubmitsPerQueue[q]; ++i) {
+                waits[q][i].value = values[1 - q];
+                signals[q][i].value = ++values[q];
+            }
+            ok &= queues[q]->SubmitBatch(submits[q], fences[q].get()).IsSuccess();
+            ++nativeSubmits;
+        }
+    });
+    uint64_t batchAllocations = g_allocations.load() - before;
+
+    // 最后一个信号的值不递增：整批被拒绝，信号量、栅栏与提交序号都保持不变
+    for (uint32_t i = 0; i < kSubmitsPerQueue[0]; ++i) {
+        waits[0][i].value = values[1];
+        signals[0][i].value = values[0] + 1 + i;
+    }
+    signals[0][kSubmitsPerQueue[0] - 1].value = values[0] + 1;
+    uint64_t submitCount = static_cast<NullQueue*>(queues[0])->GetSubmitCount();
+    uint64_t fenceValue = fences[0]->GetLastSubmittedValue();
+    bool rejected = !queues[0]->SubmitBatch(submits[0], fences[0].get()).IsSuccess();
+    bool unchanged = semaphores[0]->GetValue().GetValue() == values[0] &&
+        static_cast<NullQueue*>(queues[0])->GetSubmitCount() == submitCount &&
+        fences[0]->GetLastSubmittedValue() == fenceValue;
+    std::printf("non-increasing batch: %s, state %s\n",
+                rejected ? "rejected" : "accepted", unchanged ? "unchanged" : "partially submitted");
+
+    std::printf("IQueue::Submit: %.1f native submit calls, %.1f heap allocations per frame\n",
+                static_cast<double>(submitCalls) / frames, static_cast<double>(submitAllocations) / frames);
+    std::printf("IQueue::SubmitBatch: %.1f native submit calls, %.1f heap allocations per frame\n",
+                static_cast<double>(nativeSubmits) / frames, static_cast<double>(batchAllocations) / frames);
+
+    if (!ok) {
+        std::printf("submission failed\n");
+        return 1;
+    }
+    if (batchAllocations != 0) {
+        std::printf("SubmitBatch allocated in steady state\n");
+        return 1;
+    }
+    return rejected && unchanged ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// 时间线信号量的主机端同步
+// 1. 主机端Signal与GetValue的开销
+// 2. WaitMultiple(All)在值已到达时的开销
+// 3. 另一个线程依次在4个信号量上主机端Signal，主线程用WaitMultiple(Any)等待任一信号量前进，打印每次往返的耗时
+// 4. 等待永远不会到达的值时，WaitMultiple须在超时后返回TimeoutError
+// 5. 默认的SemaphoreDesc创建时间线信号量；值回退的Signal与超过kMaxWaitMultipleSemaphores的WaitMultiple
+//    在任何验证级别下都被拒绝
+// 任一步骤失败时返回非零退出码。
+#include "NullBackend.h"
+#include "BenchUtil.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kSemaphoreCount = 4;
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kIterations = 200000;
+    constexpr uint64_t kRoundTrips = 2000;
+
+    auto adapters = EnumerateNullAdapters();
+    std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+    std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+
+    SemaphoreDesc semaphoreDesc;
+    std::unique_ptr<ISemaphore> semaphores[kSemaphoreCount];
+    for (auto& semaphore : semaphores) {
+        semaphore.reset(device->CreateSemaphore(semaphoreDesc).GetValue());
+    }
+    bool ok = true;
+
+    uint64_t value = 0;
+    Bench::Run("ISemaphore::Signal + GetValue", kIterations, [&](uint64_t) {
+        ok &= semaphores[0]->Signal(++value).IsSuccess();
+        Bench::DoNotOptimize(semaphores[0]->GetValue().GetValue());
+    });
+
+    SemaphoreWaitInfo reached[kSemaphoreCount];
+    for (uint32_t i = 0; i < kSemaphoreCount; ++i) {
+        reached[i] = SemaphoreWaitInfo(semaphores[i].get(), semaphores[i]->GetValue().GetValue());
+    }
+    Bench::Run("IDevice::WaitMultiple (all, already reached)", kIterations, [&](uint64_t) {
+        ok &= device->WaitMultiple(reached, SemaphoreWaitMode::All, 0).IsSuccess();
+    });
+
+    // 往返：工作线程在第(i % 4)个信号量上发出下一个值，主线程等待任一信号量前进后回应
+    std::unique_ptr<ISemaphore> ack(device->CreateSemaphore(semaphoreDesc).GetValue());
+    uint64_t base[kSemaphoreCount];
+    for (uint32_t i = 0; i < kSemaphoreCount; ++i) {
+        base[i] = semaphores[i]->GetValue().GetValue();
+    }
+    std::atomic<bool> workerOk{true};
+    std::thread worker([&]() {
+        for (uint64_t i = 0; i < kRoundTrips; ++i) {
+            uint32_t index = static_cast<uint32_t>(i % kSemaphoreCount);
+            workerOk = workerOk && semaphores[index]->Signal(base[index] + i / kSemaphoreCount + 1).IsSuccess();
+            workerOk = workerOk && ack->Wait(i + 1, UINT64_MAX).IsSuccess();
+        }
+    });
+    auto begin = std::chrono::steady_clock::now();
+    SemaphoreWaitInfo next[kSemaphoreCount];
+    for (uint64_t i = 0; i < kRoundTrips; ++i) {
+        for (uint32_t s = 0; s < kSemaphoreCount; ++s) {
+            uint64_t signaled = (i + kSemaphoreCount - 1 - s) / kSemaphoreCount;
+            next[s] = SemaphoreWaitInfo(semaphores[s].get(), base[s] + signaled + 1);
+        }
+        ok &= device->WaitMultiple(next, SemaphoreWaitMode::Any, UINT64_MAX).IsSuccess();
+        uint32_t expected = static_cast<uint32_t>(i % kSemaphoreCount);
+        ok &= semaphores[expected]->GetValue().GetValue() == base[expected] + i / kSemaphoreCount + 1;
+        ok &= ack->Signal(i + 1).IsSuccess();
+    }
+    auto end = std::chrono::steady_clock::now();
+    worker.join();
+    ok &= workerOk;
+    double roundTripNs = std::chrono::duration<double, std::nano>(end - begin).count() / kRoundTrips;
+    std::printf("%-50s %10.2f ns/op\n", "Host signal -> WaitMultiple (any) round trip", roundTripNs);
+
+    // 超时
+    SemaphoreWaitInfo unreachable(semaphores[0].get(), UINT64_MAX);
+    auto timeoutBegin = std::chrono::steady_clock::now();
+    Result<void> timedOut = device->WaitMultiple(Span<const SemaphoreWaitInfo>(&unreachable, 1),
+        SemaphoreWaitMode::All, 1000000);
+    double timeoutMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - timeoutBegin).count();
+    bool timeoutOk = !timedOut.IsSuccess() && timedOut.GetErrorCode() == ErrorCode::TimeoutError;
+    std::printf("WaitMultiple with 1 ms timeout returned %s after %.2f ms\n",
+                timeoutOk ? "TimeoutError" : "an unexpected result", timeoutMs);
+
+    // 默认时间线信号量、值回退与等待数上限
+    ok &= !semaphores[0]->IsBinary();
+    ok &= !semaphores[0]->Signal(semaphores[0]->GetValue().GetValue()).IsSuccess();
+    std::vector<SemaphoreWaitInfo> tooMany(kMaxWaitMultipleSemaphores + 1, reached[0]);
+    Result<void> rejected = device->WaitMultiple(tooMany, SemaphoreWaitMode::All, 0);
+    ok &= !rejected.IsSuccess() && rejected.GetErrorCode() == ErrorCode::InvalidArgument;
+    tooMany.pop_back();
+    ok &= device->WaitMultiple(tooMany, SemaphoreWaitMode::All, 0).IsSuccess();
+
+    if (!ok || !timeoutOk) {
+        std::printf("timeline synchronization failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+// 延迟分配的瞬态附件
+// 4K前向渲染：4xMSAA颜色与深度附件只在Forward通道内使用（标记为TextureUsage::Transient），解析到SceneColor后色调映射。
+// 1. 空后端（报告支持延迟分配的内存）：瞬态附件在内存跟踪中为0字节、不参与渲染图的堆布局，
+//    与不标记Transient时的物理内存对比（普通附件是放置在渲染图堆中的资源，用量只记在堆的"RenderGraph"标签下）
+// 2. CPU后端（不支持）：瞬态附件退回普通分配，有主机存储，渲染图照常复用物理资源
+// 3. 用法检查：瞬态附件不能采样、不能在其他通道中使用；验证开启时不能与非附件用途组合、不能更新内容
+// 任一检查不通过时返回非零退出码。
+#include "CPUBackend.h"
+#include "RenderGraph.h"
+#include "BenchUtil.h"
+#include <memory>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kWidth = 3840;
+constexpr uint32_t kHeight = 2160;
+
+TextureDesc MakeTarget(Format format, uint32_t sampleCount, TextureUsage usage, const MemoryTag& tag) {
+    TextureDesc desc;
+    desc.format = format;
+    desc.width = kWidth;
+    desc.height = kHeight;
+    desc.sampleCount = sampleCount;
+    desc.usage = usage;
+    desc.tag = tag;
+    return desc;
+}
+
+struct Frame {
+    RenderGraphResource msaaColor;
+    RenderGraphResource msaaDepth;
+    RenderGraphResource sceneColor;
+};
+
+// 声明一帧：transient为false时MSAA附件按普通渲染目标声明
+Frame BuildFrame(RenderGraph& graph, ITexture* backBuffer, uint32_t sampleCount, bool transient) {
+    TextureUsage lazy = transient ? TextureUsage::Transient : TextureUsage::None;
+    Frame frame;
+    frame.msaaColor = graph.CreateTexture("MSAAColor", MakeTarget(Format::RGBA16_FLOAT, sampleCount,
+        TextureUsage::RenderTarget | lazy, RHI_MEMORY_TAG("MSAA")));
+    frame.msaaDepth = graph.CreateTexture("MSAADepth", MakeTarget(Format::D32_FLOAT, sampleCount,
+        TextureUsage::DepthStencil | lazy, RHI_MEMORY_TAG("MSAA")));
+    frame.sceneColor = graph.CreateTexture("SceneColor", MakeTarget(Format::RGBA16_FLOAT, 1,
+        TextureUsage::RenderTarget | TextureUsage::ShaderResource, RHI_MEMORY_TAG("SceneColor")));
+    // 前向着色与解析在同一个通道内完成
+    graph.AddPass("Forward", nullptr)
+        .Write(frame.msaaColor, ResourceState::RenderTarget)
+        .Write(frame.msaaDepth, ResourceState::DepthWrite)
+        .Write(frame.sceneColor, ResourceState::RenderTarget);
+
+    RenderGraphResource output = graph.ImportTexture("BackBuffer", backBuffer,
+        ResourceState::Present, ResourceState::Present);
+    graph.AddPass("Tonemap", nullptr)
+        .Read(frame.sceneColor, ResourceState::ShaderResource)
+        .Write(output, ResourceState::RenderTarget);
+    return frame;
+}
+
+double ToMiB(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+// 编译并录制一帧，返回统计
+bool RunFrame(IDevice* device, RenderGraph& graph, ITexture* backBuffer, uint32_t sampleCount, bool transient,
+              Frame& frame, RenderGraphStats& stats) {
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics, true).GetValue());
+    ICommandBuffer* commandBuffer = pool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+    graph.Reset();
+    frame = BuildFrame(graph, backBuffer, sampleCount, transient);
+    Result<void> compiled = graph.Compile();
+    if (!compiled.IsSuccess()) {
+        std::printf("compile failed: %s\n", compiled.GetErrorMessage());
+        return false;
+    }
+    stats = graph.GetStats();
+    return commandBuffer->Begin().IsSuccess() && graph.Execute(commandBuffer).IsSuccess() &&
+        commandBuffer->End().IsSuccess();
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    TextureDesc backBufferDesc = MakeTarget(Format::BGRA8_UNORM, 1, TextureUsage::RenderTarget, MemoryTag("BackBuffer"));
+    uint64_t msaaBytes = EstimateTextureDataSize(MakeTarget(Format::RGBA16_FLOAT, 4, TextureUsage::RenderTarget, MemoryTag())) +
+        EstimateTextureDataSize(MakeTarget(Format::D32_FLOAT, 4, TextureUsage::DepthStencil, MemoryTag()));
+
+    // 1. 空后端
+    {
+        auto adapters = EnumerateNullAdapters();
+        std::unique_ptr<IAdapter> adapter(adapters.GetValue()[0]);
+        std::unique_ptr<IDevice> device(adapter->CreateDevice(DeviceDesc()).GetValue());
+        MemoryTracker& tracker = device->GetMemoryTracker();
+        std::unique_ptr<ITexture> backBuffer(device->CreateTexture(backBufferDesc).GetValue());
+        ok &= device->SupportsLazilyAllocatedMemory();
+
+        Frame frame;
+        RenderGraphStats stats;
+        {
+            RenderGraph graph(device.get());
+            ok &= RunFrame(device.get(), graph, backBuffer.get(), 4, false, frame, stats);
+            ok &= tracker.GetTagUsage("MSAA").bytes == 0 && stats.lazilyAllocatedBytes == 0;
+            ok &= tracker.GetTagUsage("RenderGraph").bytes == stats.heapBytes && stats.heapBytes >= msaaBytes;
+            std::printf("%-28s physical %8.2f MiB, heaps %8.2f MiB, heaps tracked %8.2f MiB\n", "Null, regular MSAA",
+                        ToMiB(stats.physicalBytes), ToMiB(stats.heapBytes), ToMiB(tracker.GetTagUsage("RenderGraph").bytes));
+        }
+
+        RenderGraph graph(device.get());
+        ok &= RunFrame(device.get(), graph, backBuffer.get(), 4, true, frame, stats);
+        MemoryUsage msaa = tracker.GetTagUsage("MSAA");
+        ok &= msaa.bytes == 0 && msaa.count == 2;
+        ok &= stats.lazilyAllocatedBytes == msaaBytes;
+        ok &= stats.physicalBytes == EstimateTextureDataSize(MakeTarget(Format::RGBA16_FLOAT, 1,
+            TextureUsage::RenderTarget, MemoryTag()));
+        ok &= stats.heapBytes >= stats.physicalBytes && stats.heapBytes < stats.physicalBytes + msaaBytes;
+        ok &= graph.GetPlacement(frame.msaaColor).heap == kRenderGraphInvalidIndex &&
+            graph.GetPlacement(frame.msaaDepth).heap == kRenderGraphInvalidIndex &&
+            graph.GetPlacement(frame.sceneColor).heap != kRenderGraphInvalidIndex;
+        std::printf("%-28s physical %8.2f MiB, heaps %8.2f MiB, MSAA tracked %8.2f MiB (%.2f MiB lazily allocated)\n",
+                    "Null, transient MSAA", ToMiB(stats.physicalBytes), ToMiB(stats.heapBytes), ToMiB(msaa.bytes),
+                    ToMiB(stats.lazilyAllocatedBytes));
+
+        // 直接创建的瞬态附件同样不计入用量
+        uint64_t totalBefore = tracker.GetTotalUsage().bytes;
+        std::unique_ptr<ITexture> gbuffer(device->CreateTexture(MakeTarget(Format::RGBA8_UNORM, 1,
+            TextureUsage::RenderTarget | TextureUsage::Transient, RHI_MEMORY_TAG("GBuffer"))).GetValue());
+        ok &= tracker.GetTotalUsage().bytes == totalBefore && tracker.GetTagUsage("GBuffer").count == 1;
+
+        // 3. 用法检查：在其他通道中使用或采样瞬态附件使Compile失败
+        graph.Reset();
+        Frame misuse = BuildFrame(graph, backBuffer.get(), 4, true);
+        graph.AddPass("DepthTest", nullptr)
+            .Read(misuse.msaaDepth, ResourceState::DepthRead)
+            .SideEffect();
+        ok &= !graph.Compile().IsSuccess();
+        graph.Reset();
+        misuse = BuildFrame(graph, backBuffer.get(), 4, true);
+        graph.AddPass("Sample", nullptr)
+            .Read(misuse.msaaColor, ResourceState::ShaderResource)
+            .SideEffect();
+        ok &= !graph.Compile().IsSuccess();
+
+#if RHI_VALIDATION_LEVEL != RHI_VALIDATION_LEVEL_OFF
+        ok &= !device->CreateTexture(MakeTarget(Format::RGBA8_UNORM, 1,
+            TextureUsage::RenderTarget | TextureUsage::ShaderResource | TextureUsage::Transient, MemoryTag())).IsSuccess();
+        ok &= !device->CreateTexture(MakeTarget(Format::RGBA8_UNORM, 1, TextureUsage::Transient, MemoryTag())).IsSuccess();
+        uint32_t texel = 0;
+        ok &= !gbuffer->UpdateData(&texel, TextureDataLayout{}, TextureSubresourceRange()).IsSuccess();
+#endif
+    }
+
+    // 2. CPU后端：不支持延迟分配，瞬态附件有后备存储
+    {
+        CPUAdapter adapter(1);
+        std::unique_ptr<IDevice> device(adapter.CreateDevice(DeviceDesc()).GetValue());
+        MemoryTracker& tracker = device->GetMemoryTracker();
+        std::unique_ptr<ITexture> backBuffer(device->CreateTexture(backBufferDesc).GetValue());
+        ok &= !device->SupportsLazilyAllocatedMemory();
+
+        RenderGraph graph(device.get());
+        Frame frame;
+        RenderGraphStats stats;
+        ok &= RunFrame(device.get(), graph, backBuffer.get(), 1, true, frame, stats);
+        uint64_t fallbackBytes = EstimateTextureDataSize(MakeTarget(Format::RGBA16_FLOAT, 1,
+            TextureUsage::RenderTarget, MemoryTag())) +
+            EstimateTextureDataSize(MakeTarget(Format::D32_FLOAT, 1, TextureUsage::DepthStencil, MemoryTag()));
+        // 物理资源为两个回退的附件与SceneColor（与颜色附件格式相同）
+        ok &= stats.lazilyAllocatedBytes == 0 && stats.physicalBytes == fallbackBytes +
+            EstimateTextureDataSize(MakeTarget(Format::RGBA16_FLOAT, 1, TextureUsage::RenderTarget, MemoryTag()));
+        ok &= tracker.GetTagUsage("MSAA").bytes == 0 && tracker.GetTagUsage("RenderGraph").bytes == stats.heapBytes;
+        ok &= static_cast<CPUTexture*>(graph.GetTexture(frame.msaaColor))->GetStorage() != nullptr;
+        ok &= graph.GetPlacement(frame.msaaColor).heap != kRenderGraphInvalidIndex;
+        // 第二帧复用物理资源
+        ok &= RunFrame(device.get(), graph, backBuffer.get(), 1, true, frame, stats);
+        ok &= stats.createdResourceCount == 0;
+        std::printf("%-28s physical %8.2f MiB, heaps %8.2f MiB, heaps tracked %6.2f MiB\n",
+                    "CPU, transient (fallback)", ToMiB(stats.physicalBytes), ToMiB(stats.heapBytes),
+                    ToMiB(tracker.GetTagUsage("RenderGraph").bytes));
+    }
+
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
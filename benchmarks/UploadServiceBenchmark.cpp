@@ -0,0 +1,232 @@
+// 异步暂存上传服务与逐次上传的对比（CPU后端）
+// 把10000个小块数据（64~1024字节）上传到64个顶点缓冲区，再上传若干纹理的各个mip：
+// 1. 逐次上传：每块数据写入暂存缓冲区，录制一条CopyBuffer，在传输队列上提交并等待完成
+// 2. UploadService：数据写入批次的暂存缓冲区，写满或Flush时一次提交，每个目标一条复制命令
+// 检查目标内容、提交次数与复制命令数、在途暂存字节数不超过上限，以及在图形队列上录制的获取屏障。
+// CPU后端在提交时同步执行，批次提交后即完成，因此不会触发在途字节数的阻塞等待；其提交几乎没有开销，
+// 逐次上传的暂存数据始终在缓存中，两者耗时接近，GPU后端上的差别主要来自提交与等待次数。
+// 任一检查不通过时返回非零退出码。
+#include "CPUBackend.h"
+#include "UploadService.h"
+#include "BenchUtil.h"
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+namespace {
+
+constexpr uint32_t kUploads = 10000;
+constexpr uint32_t kDstBuffers = 64;
+constexpr size_t kDstBufferSize = 256 * 1024;
+constexpr uint32_t kTextures = 4;
+constexpr uint32_t kTextureSize = 256;
+constexpr uint32_t kTextureMips = 4;
+
+struct UploadItem {
+    uint32_t buffer;
+    size_t offset;
+    size_t size;
+};
+
+// 每个目标缓冲区内的上传依次排列，不重叠
+std::vector<UploadItem> MakeUploads() {
+    std::vector<UploadItem> uploads;
+    std::vector<size_t> cursors(kDstBuffers, 0);
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < kUploads; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t buffer = (seed >> 8) % kDstBuffers;
+        size_t size = 64 + ((seed >> 16) % 16) * 64;
+        uploads.push_back(UploadItem{buffer, cursors[buffer], size});
+        cursors[buffer] += size;
+    }
+    return uploads;
+}
+
+uint8_t SourceByte(size_t index) {
+    return static_cast<uint8_t>(index * 31 + 7);
+}
+
+std::vector<std::unique_ptr<IBuffer>> CreateDstBuffers(IDevice* device) {
+    BufferDesc desc;
+    desc.type = BufferType::Vertex;
+    desc.usage = BufferUsage::VertexBuffer | BufferUsage::TransferDst;
+    desc.size = kDstBufferSize;
+    std::vector<std::unique_ptr<IBuffer>> buffers;
+    for (uint32_t i = 0; i < kDstBuffers; ++i) {
+        buffers.emplace_back(device->CreateBuffer(desc).GetValue());
+    }
+    return buffers;
+}
+
+bool CheckBuffers(const std::vector<std::unique_ptr<IBuffer>>& buffers, const std::vector<UploadItem>& uploads,
+                  const std::vector<uint8_t>& source) {
+    size_t sourceOffset = 0;
+    for (const UploadItem& upload : uploads) {
+        const uint8_t* data = static_cast<CPUBuffer*>(buffers[upload.buffer].get())->GetStorage() + upload.offset;
+        if (std::memcmp(data, source.data() + sourceOffset, upload.size) != 0) {
+            return false;
+        }
+        sourceOffset += upload.size;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    CPUAdapter adapter(1);
+    std::unique_ptr<IDevice> device(adapter.CreateDevice(DeviceDesc()).GetValue());
+
+    std::vector<UploadItem> uploads = MakeUploads();
+    size_t totalBytes = 0;
+    for (const UploadItem& upload : uploads) {
+        totalBytes += upload.size;
+    }
+    std::vector<uint8_t> source(totalBytes);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = SourceByte(i);
+    }
+    std::printf("%u uploads, %.2f MB to %u buffers\n", kUploads, totalBytes / 1048576.0, kDstBuffers);
+
+    // 1. 逐次上传
+    double naiveMs = 0.0;
+    uint64_t naiveSubmits = 0;
+    {
+        std::vector<std::unique_ptr<IBuffer>> dst = CreateDstBuffers(device.get());
+        IQueue* queue = device->GetQueue(QueueType::Transfer, 0).GetValue();
+        BufferDesc stagingDesc;
+        stagingDesc.type = BufferType::Staging;
+        stagingDesc.usage = BufferUsage::TransferSrc;
+        stagingDesc.memoryType = MemoryType::Upload;
+        stagingDesc.size = 1024;
+        stagingDesc.allowCPUAccess = true;
+        std::unique_ptr<IBuffer> staging(device->CreateBuffer(stagingDesc).GetValue());
+        std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Transfer, true).GetValue());
+        CommandBufferAllocateInfo allocateInfo;
+        allocateInfo.level = CommandBufferType::Transfer;
+        ICommandBuffer* commandBuffer = pool->AllocateCommandBuffers(allocateInfo).GetValue()[0];
+        SemaphoreDesc semaphoreDesc;
+        semaphoreDesc.binary = false;
+        std::unique_ptr<ISemaphore> timeline(device->CreateSemaphore(semaphoreDesc).GetValue());
+
+        auto begin = std::chrono::steady_clock::now();
+        size_t sourceOffset = 0;
+        for (const UploadItem& upload : uploads) {
+            // 暂存缓冲区只有等上一次复制完成后才能覆盖
+            std::memcpy(staging->GetMappedData(), source.data() + sourceOffset, upload.size);
+            sourceOffset += upload.size;
+            ok &= pool->Reset().IsSuccess();
+            ok &= commandBuffer->Begin().IsSuccess();
+            BufferCopyRegion region{0, upload.offset, upload.size};
+            ok &= commandBuffer->CopyBuffer(staging.get(), dst[upload.buffer].get(), 1, &region).IsSuccess();
+            ok &= commandBuffer->End().IsSuccess();
+            ICommandBuffer* commandBuffers[] = {commandBuffer};
+            SemaphoreSignalInfo signal(timeline.get(), ++naiveSubmits);
+            SubmitDesc submit;
+            submit.commandBuffers = commandBuffers;
+            submit.signalSemaphores = Span<const SemaphoreSignalInfo>(&signal, 1);
+            ok &= queue->SubmitBatch(Span<const SubmitDesc>(&submit, 1), nullptr).IsSuccess();
+            ok &= timeline->Wait(naiveSubmits, UINT64_MAX).IsSuccess();
+        }
+        naiveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        ok &= CheckBuffers(dst, uploads, source);
+    }
+    std::printf("%-40s %8.3f ms, %6llu submits\n", "Per-upload staging + submit + wait",
+                naiveMs, static_cast<unsigned long long>(naiveSubmits));
+
+    // 2. UploadService
+    UploadServiceDesc desc;
+    desc.stagingBufferSize = 1024 * 1024;
+    desc.maxBytesInFlight = 4 * 1024 * 1024;
+    UploadService service(device.get(), desc);
+    ok &= service.Initialize().IsSuccess();
+    std::vector<std::unique_ptr<IBuffer>> dst = CreateDstBuffers(device.get());
+
+    auto begin = std::chrono::steady_clock::now();
+    size_t sourceOffset = 0;
+    uint64_t lastToken = 0;
+    for (const UploadItem& upload : uploads) {
+        auto token = service.UploadBuffer(dst[upload.buffer].get(), upload.offset, source.data() + sourceOffset,
+                                          upload.size, ResourceState::VertexBuffer);
+        ok &= token.IsSuccess();
+        lastToken = token.IsSuccess() ? token.GetValue() : lastToken;
+        sourceOffset += upload.size;
+    }
+    ok &= !service.IsComplete(lastToken);
+    ok &= service.Wait(lastToken).IsSuccess();
+    double serviceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    ok &= service.IsComplete(lastToken);
+    ok &= CheckBuffers(dst, uploads, source);
+    const UploadServiceStats& bufferStats = service.GetStats();
+    std::printf("%-40s %8.3f ms, %6llu submits, %llu copy commands (%.1fx)\n", "UploadService",
+                serviceMs, static_cast<unsigned long long>(bufferStats.batches),
+                static_cast<unsigned long long>(bufferStats.copyCommands), naiveMs / serviceMs);
+    ok &= bufferStats.uploads == kUploads && bufferStats.bytesUploaded == totalBytes;
+    ok &= bufferStats.batches < naiveSubmits / 100 && bufferStats.copyCommands <= bufferStats.batches * kDstBuffers;
+
+    // 纹理：每个mip以非紧密的行间距上传，每个批次内每个纹理一条复制命令
+    TextureDesc textureDesc;
+    textureDesc.format = Format::RGBA8_UNORM;
+    textureDesc.width = kTextureSize;
+    textureDesc.height = kTextureSize;
+    textureDesc.mipLevels = kTextureMips;
+    textureDesc.usage = TextureUsage::ShaderResource | TextureUsage::TransferDst;
+    std::vector<std::unique_ptr<ITexture>> textures;
+    size_t srcPitch = kTextureSize * 4 + 64;
+    std::vector<uint8_t> texels(srcPitch * kTextureSize);
+    for (size_t i = 0; i < texels.size(); ++i) {
+        texels[i] = SourceByte(i * 3);
+    }
+    uint64_t commandsBefore = bufferStats.copyCommands;
+    for (uint32_t i = 0; i < kTextures; ++i) {
+        textures.emplace_back(device->CreateTexture(textureDesc).GetValue());
+        for (uint32_t mip = 0; mip < kTextureMips; ++mip) {
+            ok &= service.UploadTexture(textures.back().get(), mip, 0, texels.data(), srcPitch).IsSuccess();
+        }
+    }
+    // 越界的mip与数组层在任何构建下都被拒绝，不进入批次
+    ok &= !service.UploadTexture(textures.back().get(), kTextureMips, 0, texels.data(), srcPitch).IsSuccess();
+    ok &= !service.UploadTexture(textures.back().get(), 0, 7, texels.data(), srcPitch).IsSuccess();
+    auto textureToken = service.Flush();
+    ok &= textureToken.IsSuccess() && service.IsComplete(textureToken.GetValue());
+    ok &= service.GetStats().copyCommands - commandsBefore < kTextures * kTextureMips;
+    for (const auto& texture : textures) {
+        CPUTexture* cpuTexture = static_cast<CPUTexture*>(texture.get());
+        for (uint32_t mip = 0; mip < kTextureMips; ++mip) {
+            TextureDataLayout layout = texture->GetSubresourceLayout(mip, 0).GetValue();
+            size_t width = kTextureSize >> mip;
+            for (size_t row = 0; row < (kTextureSize >> mip); ++row) {
+                ok &= std::memcmp(cpuTexture->GetStorage() + layout.offset + row * layout.rowPitch,
+                                  texels.data() + row * srcPitch, width * 4) == 0;
+            }
+        }
+    }
+
+    // 传输队列与图形队列不同：使用方在图形队列上录制获取屏障并等待返回的时间线值
+    std::unique_ptr<ICommandPool> graphicsPool(device->CreateCommandPool(QueueType::Graphics, true).GetValue());
+    ICommandBuffer* graphics = graphicsPool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+    ok &= service.HasOwnershipTransfer();
+    ok &= graphics->Begin().IsSuccess();
+    auto acquireValue = service.RecordAcquireBarriers(graphics);
+    ok &= acquireValue.IsSuccess() && acquireValue.GetValue() == service.GetSubmittedValue();
+    auto again = service.RecordAcquireBarriers(graphics);
+    ok &= again.IsSuccess() && again.GetValue() == 0;
+    ok &= graphics->End().IsSuccess();
+
+    const UploadServiceStats& stats = service.GetStats();
+    ok &= stats.peakBytesInFlight <= desc.maxBytesInFlight;
+    std::printf("Batches %llu, copy commands %llu, staging buffers %llu, peak in flight %.2f MB (budget %.2f MB), "
+                "throttle waits %llu\n",
+                static_cast<unsigned long long>(stats.batches), static_cast<unsigned long long>(stats.copyCommands),
+                static_cast<unsigned long long>(stats.stagingBuffersCreated),
+                stats.peakBytesInFlight / 1048576.0, desc.maxBytesInFlight / 1048576.0,
+                static_cast<unsigned long long>(stats.throttleWaits));
+
+    std::printf("%s\n", ok ? "OK" : "FAILED");
+    return ok ? 0 : 1;
+}
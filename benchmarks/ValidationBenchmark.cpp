@@ -0,0 +1,98 @@
+// 不同参数验证级别下提交密集型代码的开销
+// 同一份源文件以RHI_VALIDATION_LEVEL为Off/Cheap/Full分别编译为三个可执行文件
+#ifdef RHI_BENCH_VALIDATION_LEVEL
+#undef RHI_VALIDATION_LEVEL
+#define RHI_VALIDATION_LEVEL RHI_BENCH_VALIDATION_LEVEL
+#endif
+
+#include "CommandBuffer.h"
+#include "ErrorUtil.h"
+#include "BenchUtil.h"
+#include <string>
+
+namespace {
+
+using namespace RHI;
+
+// 模拟后端在录制命令时执行的参数验证
+class ValidatingCommands {
+public:
+    RHI_BENCH_NOINLINE Result<void> SetViewport(const Viewport& viewport) {
+        RHI_VALIDATE(viewport.width > 0.0f && viewport.height > 0.0f,
+            ErrorCode::InvalidArgument,
+            "视口尺寸必须大于0: " + std::to_string(viewport.width) + "x" + std::to_string(viewport.height));
+        RHI_VALIDATE_FULL(viewport.minDepth >= 0.0f && viewport.maxDepth <= 1.0f &&
+            viewport.minDepth <= viewport.maxDepth,
+            ErrorCode::InvalidArgument,
+            "无效的深度范围: [" + std::to_string(viewport.minDepth) + ", " + std::to_string(viewport.maxDepth) + "]");
+        m_viewport = viewport;
+        return MakeSuccessResult();
+    }
+
+    RHI_BENCH_NOINLINE Result<void> SetVertexBuffer(uint32_t slot, void* vertexBufferView) {
+        RHI_VALIDATE(vertexBufferView != nullptr,
+            ErrorCode::InvalidArgument,
+            "顶点缓冲区视图不能为空");
+        RHI_VALIDATE(slot < kMaxVertexBuffers,
+            ErrorCode::InvalidArgument,
+            "顶点缓冲区槽位越界: " + std::to_string(slot));
+        m_vertexBuffers[slot] = vertexBufferView;
+        return MakeSuccessResult();
+    }
+
+    RHI_BENCH_NOINLINE Result<void> Draw(
+        uint32_t vertexCount,
+        uint32_t instanceCount,
+        uint32_t firstVertex,
+        uint32_t firstInstance) {
+        RHI_VALIDATE(vertexCount > 0 && instanceCount > 0,
+            ErrorCode::InvalidArgument,
+            "绘制数量必须大于0");
+        RHI_VALIDATE_FULL(ValidateBindings(),
+            ErrorCode::InvalidOperation,
+            "绘制前未绑定全部顶点缓冲区");
+        m_drawCount += vertexCount * instanceCount + firstVertex + firstInstance;
+        return MakeSuccessResult();
+    }
+
+    uint64_t m_drawCount = 0;
+
+private:
+    static constexpr uint32_t kMaxVertexBuffers = 16;
+
+    bool ValidateBindings() const {
+        for (uint32_t i = 0; i < m_boundSlots; ++i) {
+            if (m_vertexBuffers[i] == nullptr) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Viewport m_viewport = {};
+    void* m_vertexBuffers[kMaxVertexBuffers] = {};
+    uint32_t m_boundSlots = 2;
+};
+
+} // namespace
+
+int main() {
+    constexpr uint64_t kDrawsPerFrame = 50000;
+    constexpr uint64_t kFrames = 100;
+
+    ValidatingCommands commands;
+    int vertexData[2] = {};
+    Viewport viewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+
+    std::string name = std::string("Submit loop, validation ") + RHI_BENCH_VALIDATION_NAME;
+    Bench::Run(name.c_str(), kDrawsPerFrame * kFrames, [&](uint64_t i) {
+        bool ok = commands.SetViewport(viewport).IsSuccess();
+        ok &= commands.SetVertexBuffer(0, &vertexData[0]).IsSuccess();
+        ok &= commands.SetVertexBuffer(1, &vertexData[1]).IsSuccess();
+        ok &= commands.Draw(static_cast<uint32_t>(i & 0x3F) + 3, 1, 0, 0).IsSuccess();
+        Bench::DoNotOptimize(ok);
+    });
+    Bench::DoNotOptimize(commands.m_drawCount);
+
+    return 0;
+}
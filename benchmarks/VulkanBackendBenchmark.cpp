@@ -0,0 +1,133 @@
+// Vulkan后端的录制开销与端到端提交
+// 优先选择CPU/软件适配器（如lavapipe），因此可以在没有GPU的CI上运行。
+// 先测量录制期命令的每次调用耗时，再提交一次上传->复制->回读并校验数据，校验失败或找不到适配器时返回非零退出码。
+// 可选参数：每次SetVertexBuffer+CopyBuffer允许的最大纳秒数，超出时返回非零退出码。
+#include "VulkanBackend.h"
+#include "BenchUtil.h"
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace RHI;
+
+int main(int argc, char** argv) {
+    constexpr uint64_t kCommandsPerFrame = 20000;
+    constexpr uint64_t kFrames = 20;
+    constexpr size_t kBufferSize = 65536;
+
+    auto adapters = EnumerateVulkanAdapters();
+    if (!adapters.IsSuccess()) {
+        std::printf("no Vulkan adapter: %s\n", adapters.GetErrorMessage());
+        return 1;
+    }
+    std::vector<std::unique_ptr<IAdapter>> ownedAdapters;
+    IAdapter* adapter = nullptr;
+    for (IAdapter* candidate : adapters.GetValue()) {
+        ownedAdapters.emplace_back(candidate);
+        AdapterType type = candidate->GetAdapterInfo().type;
+        if (adapter == nullptr || type == AdapterType::CPU || type == AdapterType::Software) {
+            adapter = candidate;
+        }
+    }
+    std::printf("adapter: %s\n", adapter->GetAdapterInfo().name.c_str());
+
+    auto deviceResult = adapter->CreateDevice(DeviceDesc());
+    if (!deviceResult.IsSuccess()) {
+        std::printf("device creation failed: %s\n", deviceResult.GetErrorMessage());
+        return 1;
+    }
+    std::unique_ptr<IDevice> device(deviceResult.GetValue());
+    IQueue* queue = device->GetQueue(QueueType::Graphics, 0).GetValue();
+    std::unique_ptr<ICommandPool> pool(device->CreateCommandPool(QueueType::Graphics, true).GetValue());
+    ICommandBuffer* commandBuffer = pool->AllocateCommandBuffers(CommandBufferAllocateInfo()).GetValue()[0];
+
+    BufferDesc bufferDesc;
+    bufferDesc.size = kBufferSize;
+    bufferDesc.usage = BufferUsage::VertexBuffer | BufferUsage::TransferSrc;
+    bufferDesc.memoryType = MemoryType::Upload;
+    bufferDesc.allowCPUAccess = true;
+    std::unique_ptr<IBuffer> uploadBuffer(device->CreateBuffer(bufferDesc).GetValue());
+    bufferDesc.usage = BufferUsage::TransferSrc | BufferUsage::TransferDst;
+    bufferDesc.memoryType = MemoryType::Default;
+    bufferDesc.allowCPUAccess = false;
+    std::unique_ptr<IBuffer> deviceBuffer(device->CreateBuffer(bufferDesc).GetValue());
+    bufferDesc.usage = BufferUsage::TransferDst;
+    bufferDesc.memoryType = MemoryType::Readback;
+    bufferDesc.allowCPUAccess = true;
+    std::unique_ptr<IBuffer> readbackBuffer(device->CreateBuffer(bufferDesc).GetValue());
+    BufferViewDesc viewDesc = {0, kBufferSize, 16};
+    void* vertexBufferView = uploadBuffer->GetVertexBufferView(viewDesc).GetValue();
+
+    FenceDesc fenceDesc = {};
+    std::unique_ptr<IFence> fence(device->CreateFence(fenceDesc).GetValue());
+
+    Viewport viewport = {0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+    Scissor scissor = {0, 0, 1920, 1080};
+    BufferCopyRegion region = {0, 0, 256};
+    BarrierDesc barrier = {};
+    barrier.type = BarrierType::Transition;
+    barrier.resource = static_cast<IBuffer*>(deviceBuffer.get());
+    barrier.resourceType = BarrierResourceType::Buffer;
+    barrier.stateBefore = ResourceState::CopyDest;
+    barrier.stateAfter = ResourceState::CopyDest;
+
+    bool ok = commandBuffer->Begin().IsSuccess();
+
+    // 重复的视口/裁剪/顶点缓冲区设置在录制时被过滤，不产生驱动调用
+    Bench::Run("SetViewport (redundant)", kCommandsPerFrame * kFrames, [&](uint64_t) {
+        Bench::DoNotOptimize(commandBuffer->SetViewport(viewport).IsSuccess());
+    });
+    Bench::Run("SetScissor (redundant)", kCommandsPerFrame * kFrames, [&](uint64_t) {
+        Bench::DoNotOptimize(commandBuffer->SetScissor(scissor).IsSuccess());
+    });
+    double copyNs = Bench::Run("SetVertexBuffer + CopyBuffer", kCommandsPerFrame * kFrames, [&](uint64_t i) {
+        Bench::DoNotOptimize(commandBuffer->SetVertexBuffer(static_cast<uint32_t>(i & 7), vertexBufferView).IsSuccess());
+        Bench::DoNotOptimize(commandBuffer->CopyBuffer(uploadBuffer.get(), deviceBuffer.get(), 1, &region).IsSuccess());
+    });
+    Bench::Run("ResourceBarrier (buffer)", kCommandsPerFrame, [&](uint64_t) {
+        Bench::DoNotOptimize(commandBuffer->ResourceBarrier(1, &barrier).IsSuccess());
+    });
+    ok &= commandBuffer->End().IsSuccess();
+    ok &= pool->Reset().IsSuccess();
+
+    // 端到端：上传缓冲区 -> 设备本地缓冲区 -> 回读缓冲区
+    std::vector<uint32_t> pattern(kBufferSize / sizeof(uint32_t));
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        pattern[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+    ok &= uploadBuffer->UpdateData(pattern.data(), kBufferSize, 0).IsSuccess();
+
+    BufferCopyRegion fullRegion = {0, 0, kBufferSize};
+    BarrierDesc copyBarrier = barrier;
+    copyBarrier.stateBefore = ResourceState::CopyDest;
+    copyBarrier.stateAfter = ResourceState::CopySource;
+    std::vector<ICommandBuffer*> commandBuffers = { commandBuffer };
+    std::vector<ISemaphore*> noSemaphores;
+
+    uint64_t submitIndex = 0;
+    Bench::Run("record + Submit + Wait (64KB round trip)", 100, [&](uint64_t) {
+        ok &= commandBuffer->Begin().IsSuccess();
+        ok &= commandBuffer->CopyBuffer(uploadBuffer.get(), deviceBuffer.get(), 1, &fullRegion).IsSuccess();
+        ok &= commandBuffer->ResourceBarrier(1, &copyBarrier).IsSuccess();
+        ok &= commandBuffer->CopyBuffer(deviceBuffer.get(), readbackBuffer.get(), 1, &fullRegion).IsSuccess();
+        ok &= commandBuffer->End().IsSuccess();
+        ok &= queue->Submit(commandBuffers, noSemaphores, noSemaphores, fence.get()).IsSuccess();
+        ok &= fence->Wait(++submitIndex, UINT64_MAX).IsSuccess();
+        ok &= pool->Reset().IsSuccess();
+    });
+
+    auto mapped = readbackBuffer->Map();
+    ok &= mapped.IsSuccess() && std::memcmp(mapped.GetValue(), pattern.data(), kBufferSize) == 0;
+    ok &= readbackBuffer->Unmap().IsSuccess();
+
+    if (!ok) {
+        std::printf("Vulkan backend validation failed\n");
+        return 1;
+    }
+    if (argc > 1 && copyNs > std::atof(argv[1])) {
+        std::printf("SetVertexBuffer + CopyBuffer overhead %.2f ns exceeds budget %s ns\n", copyNs, argv[1]);
+        return 1;
+    }
+    return 0;
+}